@@ -30,21 +30,63 @@
 #include <OpenHLX/Client/ApplicationController.hpp>
 
 #import "ApplicationControllerPointer.hpp"
+#import "CommandCoalescer.hpp"
+#import "CommandPipeline.hpp"
+#import "PhaseTimingRecorder.hpp"
+#import "RefreshStageTracker.hpp"
+#import "SessionRecorder.hpp"
+#import "SessionResumer.hpp"
+#import "StateChangeBus.hpp"
+#import "VolumeFader.hpp"
 
 
+extern NSString * const kStagedRefreshKey;
+extern NSString * const kPipelineDepthKey;
+extern NSString * const kParallelConnectKey;
+extern NSString * const kPreconnectKey;
+extern NSString * const kResumeSessionsKey;
+extern NSString * const kRecordSessionsKey;
+
+extern NSString * const kCommandDidRollBackNotification;
+
 @interface AppDelegate : UIResponder <UIApplicationDelegate>
 {
     MutableApplicationControllerPointer  mApplicationController;
+    RefreshStageTracker                  mRefreshStageTracker;
+    PhaseTimingRecorder                  mPhaseTimingRecorder;
+    CommandPipeline                      mCommandPipeline;
+    CommandCoalescer                     mCommandCoalescer;
+    SessionResumer                       mSessionResumer;
+    SessionRecorder                      mSessionRecorder;
+    StateChangeBus                       mStateChangeBus;
+    VolumeFader                          mVolumeFader;
+    NSString *                           mPreconnectLocation;
+    NSString *                           mConnectedLocation;
 }
 
 // MARK: Properties
 
 @property (strong, nonatomic) UIWindow *window;
 
+// MARK: Type Methods
+
++ (AppDelegate *) sharedDelegate;
+
 // MARK: Instance Methods
 
 // MARK: Getters
 
 - (MutableApplicationControllerPointer) hlxClientController;
+- (RefreshStageTracker &) refreshStageTracker;
+- (PhaseTimingRecorder &) phaseTimingRecorder;
+- (CommandPipeline &) commandPipeline;
+- (CommandCoalescer &) commandCoalescer;
+- (StateChangeBus &) stateChangeBus;
+- (VolumeFader &) volumeFader;
+- (NSString *) takePreconnectLocation;
+
+// MARK: Setters
+
+- (void) setConnectedLocation: (NSString *)aLocation;
 
 @end
@@ -25,12 +25,20 @@
 
 #import "AppDelegate.h"
 
+#include <errno.h>
+
+#include <dispatch/dispatch.h>
+
 #include <LogUtilities/LogUtilities.hpp>
 
 #include <OpenHLX/Common/Errors.hpp>
 #include <OpenHLX/Utilities/Assert.hpp>
 
+#import "ConnectHistoryController.h"
+#import "ConnectRacer.hpp"
 #import "ConnectViewController.h"
+#import "NSURLComponents+NetworkAddressOrName.h"
+#import "StateCacheController.h"
 #import "UIViewController+TopViewController.h"
 
 
@@ -40,15 +48,55 @@ using namespace HLX::Model;
 using namespace Nuovations;
 
 
+NSString * const kStagedRefreshKey = @"Staged Refresh";
+NSString * const kPipelineDepthKey = @"Pipeline Depth";
+NSString * const kParallelConnectKey = @"Parallel Connect";
+NSString * const kPreconnectKey = @"Pre-connect at Launch";
+NSString * const kResumeSessionsKey = @"Resume Sessions";
+NSString * const kRecordSessionsKey = @"Record Sessions";
+
+NSString * const kCommandDidRollBackNotification = @"Command Did Roll Back";
+
+// The interval at which the command coalescer is serviced, such that
+// unanswered commands time out, and roll back, even when nothing
+// else is happening.
+
+static const NSTimeInterval kCommandCoalescerServiceInterval = 0.5;
+
+// The interval at which the volume fader is serviced while a fade is
+// in progress. This is finer than the fade step interval such that
+// steps are sent close to when they become due.
+
+static const NSTimeInterval kVolumeFaderServiceInterval = 0.025;
+
 @interface AppDelegate ()
 {
     UIBackgroundTaskIdentifier mBackgroundTaskIdentifier;
+    NSTimer *                  mCommandCoalescerTimer;
+    NSTimer *                  mVolumeFaderTimer;
 }
 
 @end
 
 @implementation AppDelegate
 
+// MARK: Type Methods
+
+/**
+ *  @brief
+ *    Return the shared instance of the app delegate.
+ *
+ *  @returns
+ *    A pointer to the shared instance of the app delegate.
+ *
+ */
++ (AppDelegate *) sharedDelegate
+{
+    return (static_cast<AppDelegate *>([[UIApplication sharedApplication] delegate]));
+}
+
+// MARK: Application Delegation
+
 /**
  *  @brief
  *    Tells the delegate that the launch process is almost done and
@@ -70,6 +118,9 @@ using namespace Nuovations;
 {
     NSString *                      lVersion;
     NSUserDefaults *                lUserDefaults;
+    NSFileManager *                 lFileManager = [NSFileManager defaultManager];
+    NSURL *                         lSupportURL;
+    NSURL *                         lDocumentsURL;
     HLX::Common::RunLoopParameters  lRunLoopParameters;
     Status                          lStatus = kStatus_Success;
 
@@ -80,14 +131,27 @@ using namespace Nuovations;
 
     lVersion = [[[NSBundle mainBundle] infoDictionary] objectForKey: @"CFBundleShortVersionString"];
 
-    if (lVersion != nullptr)
-    {
-        lUserDefaults = [NSUserDefaults standardUserDefaults];
+    lUserDefaults = [NSUserDefaults standardUserDefaults];
 
-        if (lUserDefaults != nullptr)
+    if (lUserDefaults != nullptr)
+    {
+        if (lVersion != nullptr)
         {
             [lUserDefaults setObject: lVersion forKey: @"Version"];
         }
+
+        // The app settings bundle default values are only for
+        // display; register the same defaults here such that they
+        // are in effect before the user ever visits the settings.
+
+        [lUserDefaults registerDefaults: [NSDictionary dictionaryWithObjectsAndKeys:
+                                                           [NSNumber numberWithBool: YES], kStagedRefreshKey,
+                                                           [NSNumber numberWithInteger: 0], kPipelineDepthKey,
+                                                           [NSNumber numberWithBool: YES], kParallelConnectKey,
+                                                           [NSNumber numberWithBool: NO], kPreconnectKey,
+                                                           [NSNumber numberWithBool: YES], kResumeSessionsKey,
+                                                           [NSNumber numberWithBool: NO], kRecordSessionsKey,
+                                                           nullptr]];
     }
 
     // Simply allocate and initialize a global, shared HLX client
@@ -102,6 +166,132 @@ using namespace Nuovations;
     lStatus = mApplicationController->Init(lRunLoopParameters);
     nlREQUIRE_SUCCESS(lStatus, done);
 
+    // The state change bus is the client controller delegate for the
+    // life of the app; views swap their delegates on it instead, such
+    // that state change subscribers see every state change, even
+    // while no view is the delegate. The bus likewise feeds the
+    // app-wide objects below that must see every delegation.
+    //
+    // Ahead of it, the session recorder sees every delegation as it
+    // arrives and, when recording, logs it for later replay.
+
+    lStatus = mSessionRecorder.SetDelegate(&mStateChangeBus);
+    nlREQUIRE_SUCCESS(lStatus, done);
+
+    lStatus = mApplicationController->SetDelegate(&mSessionRecorder);
+    nlREQUIRE_SUCCESS(lStatus, done);
+
+    // Track the stages of each client controller refresh, whichever
+    // view, if any, is the bus delegate.
+
+    lStatus = mRefreshStageTracker.Init(*mApplicationController);
+    nlREQUIRE_SUCCESS(lStatus, done);
+
+    mStateChangeBus.SetRefreshStageTracker(&mRefreshStageTracker);
+
+    // Bound, and pace, the number of app-issued requests in flight at
+    // once. The depth, the most the pacing window may grow to, is
+    // established, on each connect, from the peer class or from the
+    // user setting.
+
+    lStatus = mCommandPipeline.Init(CommandPipeline::kDepthDefault, CommandPipeline::Duration(5000));
+    nlREQUIRE_SUCCESS(lStatus, done);
+
+    mStateChangeBus.SetCommandPipeline(&mCommandPipeline);
+
+    // Send only the latest of the values continuously-adjusted
+    // controls, such as sliders, set while a prior one is in flight,
+    // each through the pipeline.
+
+    lStatus = mCommandCoalescer.Init(CommandCoalescer::Duration(5000));
+    nlREQUIRE_SUCCESS(lStatus, done);
+
+    mCommandCoalescer.SetCommandPipeline(&mCommandPipeline);
+
+    mStateChangeBus.SetCommandCoalescer(&mCommandCoalescer);
+
+    // Views render the values the coalescer has yet to have answered
+    // in place of the model values; let them know when one is rolled
+    // back such that they may render the model value again.
+
+    mCommandCoalescer.SetRollbackHandler([](const CommandCoalescer::Key &) {
+        [[NSNotificationCenter defaultCenter] postNotificationName: kCommandDidRollBackNotification
+                                                            object: nullptr];
+    });
+
+    mCommandCoalescerTimer = [NSTimer scheduledTimerWithTimeInterval: kCommandCoalescerServiceInterval
+                                                              target: self
+                                                            selector: @selector(serviceCommandCoalescer:)
+                                                            userInfo: nullptr
+                                                             repeats: YES];
+    mCommandCoalescerTimer.tolerance = kCommandCoalescerServiceInterval / 2;
+
+    // Fade volumes through the coalescer and, so, the pipeline,
+    // servicing the fader only while a fade is in progress.
+
+    lStatus = mVolumeFader.Init(mCommandCoalescer, VolumeFader::kStepIntervalDefault);
+    nlREQUIRE_SUCCESS(lStatus, done);
+
+    mStateChangeBus.SetVolumeFader(&mVolumeFader);
+
+    mVolumeFader.SetActivityHandler([self](const bool &aActive) {
+        [self volumeFaderDidChangeActivity: aActive];
+    });
+
+    // Suspend, rather than end, sessions when the app is backgrounded
+    // such that they may be resumed without a full refresh.
+
+    lStatus = mSessionResumer.Init(SessionResumer::kWindowDefault);
+    nlREQUIRE_SUCCESS(lStatus, done);
+
+    mStateChangeBus.SetSessionResumer(&mSessionResumer);
+
+    // Time the resolve, connect, and refresh phases of each session,
+    // accumulating per-site histograms that persist across launches
+    // in application support and that are dumped, in human-readable
+    // form, to documents where they may be retrieved from the device.
+
+    lSupportURL = [[lFileManager URLsForDirectory: NSApplicationSupportDirectory
+                                        inDomains: NSUserDomainMask] firstObject];
+    nlREQUIRE(lSupportURL != nullptr, done);
+
+    [lFileManager createDirectoryAtURL: lSupportURL
+           withIntermediateDirectories: YES
+                            attributes: nullptr
+                                 error: nullptr];
+
+    lDocumentsURL = [[lFileManager URLsForDirectory: NSDocumentDirectory
+                                          inDomains: NSUserDomainMask] firstObject];
+    nlREQUIRE(lDocumentsURL != nullptr, done);
+
+    lStatus = mPhaseTimingRecorder.Init([[lSupportURL URLByAppendingPathComponent: @"Phase Timing.tsv"] fileSystemRepresentation],
+                                        [[lDocumentsURL URLByAppendingPathComponent: @"Refresh Timing.txt"] fileSystemRepresentation]);
+    nlREQUIRE_SUCCESS(lStatus, done);
+
+    mStateChangeBus.SetPhaseTimingRecorder(&mPhaseTimingRecorder);
+
+    // Save a snapshot of the client data on completion of every
+    // refresh, whichever view, if any, is the bus delegate, such that
+    // the next connection to the same location may start warm.
+
+    mStateChangeBus.SetRefreshHandler([self](HLX::Client::Application::ControllerBasis &aController) {
+        [self controllerDidRefresh];
+    });
+
+    // Sessions, where the user has asked for them to be recorded, are
+    // appended to a log in documents where they may be retrieved from
+    // the device and replayed off of it.
+
+    lStatus = mSessionRecorder.Init([[lDocumentsURL URLByAppendingPathComponent: @"Sessions.hlxlog"] fileSystemRepresentation]);
+    nlREQUIRE_SUCCESS(lStatus, done);
+
+    [self updateSessionRecording];
+
+    // Most launches end in a connection to the most recent location;
+    // get a head start on it while the connect view loads.
+
+    [self prepareToConnectToMostRecentLocation];
+
  done:
     return ((lStatus == kStatus_Success) ? YES : NO);
 }
@@ -141,6 +331,11 @@ using namespace Nuovations;
  *  application and the user is presented with some more
  *  ominous-sounding error.
  *
+ *  If the user has enabled resuming sessions, the session is
+ *  suspended instead such that, when the app becomes active again,
+ *  it may be resumed without the user ever having seen the
+ *  disconnection.
+ *
  *  @note
  *    In the future, the Disconnect client controller method might be
  *    augmented to take a user-supplied reason or error argument to
@@ -151,9 +346,18 @@ using namespace Nuovations;
 - (void) onBackgroundTaskExpired
 {
     UIApplication *lApplication = [UIApplication sharedApplication];
+    Status         lStatus = -ENOTCONN;
 
 
-    mApplicationController->Disconnect();
+    if ([[NSUserDefaults standardUserDefaults] boolForKey: kResumeSessionsKey])
+    {
+        lStatus = mSessionResumer.Suspend(*mApplicationController);
+    }
+
+    if (lStatus != kStatus_Success)
+    {
+        mApplicationController->Disconnect();
+    }
 
     [lApplication endBackgroundTask: mBackgroundTaskIdentifier];
 
@@ -214,6 +418,7 @@ using namespace Nuovations;
 - (void) applicationDidBecomeActive: (UIApplication *)aApplication
 {
     UIApplication *lApplication = [UIApplication sharedApplication];
+    Status         lStatus;
 
     // Ensure that the previously-started background task has truly
     // ended.
@@ -221,6 +426,22 @@ using namespace Nuovations;
     [lApplication endBackgroundTask: mBackgroundTaskIdentifier];
 
     mBackgroundTaskIdentifier = UIBackgroundTaskInvalid;
+
+    // If the session was suspended while the app was in the
+    // background, resume it. Through the bus, such that a session
+    // that cannot be resumed is reported to the showing view as
+    // disconnected.
+
+    if (mSessionResumer.IsSuspended())
+    {
+        lStatus = mStateChangeBus.ResumeSession(*mApplicationController);
+        nlVERIFY_SUCCESS(lStatus);
+    }
+
+    // The user may have changed whether sessions are recorded while
+    // the app was in the background.
+
+    [self updateSessionRecording];
 }
 
 /**
@@ -238,7 +459,10 @@ using namespace Nuovations;
  */
 - (void)applicationWillTerminate: (UIApplication *)aApplication
 {
-    return;
+    Status lStatus;
+
+    lStatus = mSessionRecorder.Stop();
+    nlVERIFY_SUCCESS(lStatus);
 }
 
 /**
@@ -284,6 +508,11 @@ using namespace Nuovations;
         UIViewController * lViewController;
 
 
+        // The URL supersedes any pre-connection to the most recent
+        // location that has yet to start.
+
+        mPreconnectLocation = nullptr;
+
         // Load the connect view controller programmatically.
 
         lStoryboard = [UIStoryboard storyboardWithName: lStoryboardName
@@ -314,6 +543,173 @@ done:
 
 // MARK: Instance Methods
 
+// MARK: Workers
+
+/**
+ *  @brief
+ *    Service the command coalescer and pipeline, timing out any
+ *    commands that have gone unanswered.
+ *
+ *  The pipeline is otherwise only serviced as requests are enqueued
+ *  and answered; without this, paced requests waiting behind one
+ *  that will never be answered would wait for the next of either.
+ *
+ *  @param[in]  aTimer  The timer that fired.
+ *
+ */
+- (void) serviceCommandCoalescer: (NSTimer *)aTimer
+{
+    mCommandCoalescer.Service();
+    mCommandPipeline.Service();
+}
+
+/**
+ *  @brief
+ *    Service the volume fader, stepping any fades in progress.
+ *
+ *  @param[in]  aTimer  The timer that fired.
+ *
+ */
+- (void) serviceVolumeFader: (NSTimer *)aTimer
+{
+    mVolumeFader.Service();
+}
+
+/**
+ *  @brief
+ *    Start or stop servicing the volume fader as fades start and
+ *    finish.
+ *
+ *  @param[in]  aActive  Whether any fade is in progress.
+ *
+ */
+- (void) volumeFaderDidChangeActivity: (bool)aActive
+{
+    if (aActive && (mVolumeFaderTimer == nullptr))
+    {
+        mVolumeFaderTimer = [NSTimer scheduledTimerWithTimeInterval: kVolumeFaderServiceInterval
+                                                             target: self
+                                                           selector: @selector(serviceVolumeFader:)
+                                                           userInfo: nullptr
+                                                            repeats: YES];
+        mVolumeFaderTimer.tolerance = kVolumeFaderServiceInterval / 2;
+    }
+    else if (!aActive && (mVolumeFaderTimer != nullptr))
+    {
+        [mVolumeFaderTimer invalidate];
+        mVolumeFaderTimer = nullptr;
+    }
+}
+
+/**
+ *  @brief
+ *    Save a snapshot of the client data for the connected location,
+ *    if any, and record how long the refresh took in its connect
+ *    history entry, on completion of a client controller refresh.
+ *
+ */
+- (void) controllerDidRefresh
+{
+    StateCacheController *         lSharedStateCacheController;
+    PhaseTimingRecorder::Duration  lDuration;
+    Status                         lPhaseStatus;
+    bool                           lStatus;
+
+
+    nlEXPECT(mConnectedLocation != nullptr, done);
+
+    lSharedStateCacheController = [StateCacheController sharedController];
+    nlREQUIRE(lSharedStateCacheController != nullptr, done);
+
+    lStatus = [lSharedStateCacheController saveStateFromController: mApplicationController
+                                                       forLocation: mConnectedLocation];
+    nlVERIFY(lStatus == true);
+
+    // Remember how long the refresh took for this same location,
+    // whichever view it completed in.
+
+    lPhaseStatus = mPhaseTimingRecorder.GetLastDuration(PhaseTimingRecorder::kPhaseRefreshComplete, lDuration);
+    nlEXPECT_SUCCESS(lPhaseStatus, done);
+
+    [[ConnectHistoryController sharedController] addDuration: static_cast<NSUInteger>(lDuration.count())
+                                                      forKey: kConnectHistoryRefreshDurationsKey
+                                                 forLocation: mConnectedLocation];
+
+ done:
+    return;
+}
+
+/**
+ *  @brief
+ *    Start or stop recording sessions according to the user setting.
+ *
+ */
+- (void) updateSessionRecording
+{
+    const bool  lRecord = [[NSUserDefaults standardUserDefaults] boolForKey: kRecordSessionsKey];
+    Status      lStatus = kStatus_Success;
+
+
+    if (lRecord && !mSessionRecorder.IsRecording())
+    {
+        lStatus = mSessionRecorder.Start();
+    }
+    else if (!lRecord && mSessionRecorder.IsRecording())
+    {
+        lStatus = mSessionRecorder.Stop();
+    }
+
+    nlVERIFY_SUCCESS(lStatus);
+}
+
+/**
+ *  @brief
+ *    Prepare to connect to the most recent location in the connect
+ *    history, if any.
+ *
+ *  The location is resolved, off of the main thread, such that the
+ *  system resolver cache is warm by the time the user connects. If
+ *  the user has enabled pre-connecting at launch, the location is
+ *  also set aside for the connect view controller to pre-connect to
+ *  once it is the client controller delegate.
+ *
+ */
+- (void) prepareToConnectToMostRecentLocation
+{
+    NSDictionary *     lMostRecentEntry;
+    NSString *         lLocation;
+    NSURLComponents *  lURLComponents;
+    NSString *         lHost;
+    NSString *         lPort;
+
+    lMostRecentEntry = [[ConnectHistoryController sharedController] mostRecentEntry];
+    nlEXPECT(lMostRecentEntry != nullptr, done);
+
+    lLocation = [lMostRecentEntry objectForKey: kConnectHistoryLocationKey];
+    nlEXPECT(lLocation != nullptr, done);
+
+    lURLComponents = [NSURLComponents componentsWithNetworkAddressOrName: lLocation];
+    nlEXPECT(lURLComponents != nullptr, preconnect);
+
+    lHost = [lURLComponents unbracketedHost];
+    lPort = [lURLComponents portOrDefault];
+
+    dispatch_async(dispatch_get_global_queue(QOS_CLASS_UTILITY, 0), ^(void) {
+        ConnectRacer lConnectRacer;
+
+        lConnectRacer.Resolve([lHost UTF8String], [lPort UTF8String]);
+    });
+
+ preconnect:
+    if ([[NSUserDefaults standardUserDefaults] boolForKey: kPreconnectKey])
+    {
+        mPreconnectLocation = lLocation;
+    }
+
+ done:
+    return;
+}
+
 // MARK: Getters
 
 /**
@@ -331,4 +727,129 @@ done:
     return (mApplicationController);
 }
 
+/**
+ *  @brief
+ *    Get a reference to the global app HLX client controller refresh
+ *    stage tracker.
+ *
+ *  @returns
+ *    A reference to the global app HLX client controller refresh
+ *    stage tracker.
+ *
+ */
+- (RefreshStageTracker &) refreshStageTracker
+{
+    return (mRefreshStageTracker);
+}
+
+/**
+ *  @brief
+ *    Get a reference to the global app HLX client controller phase
+ *    timing recorder.
+ *
+ *  @returns
+ *    A reference to the global app HLX client controller phase
+ *    timing recorder.
+ *
+ */
+- (PhaseTimingRecorder &) phaseTimingRecorder
+{
+    return (mPhaseTimingRecorder);
+}
+
+/**
+ *  @brief
+ *    Get a reference to the global app HLX client controller command
+ *    pipeline.
+ *
+ *  @returns
+ *    A reference to the global app HLX client controller command
+ *    pipeline.
+ *
+ */
+- (CommandPipeline &) commandPipeline
+{
+    return (mCommandPipeline);
+}
+
+/**
+ *  @brief
+ *    Get a reference to the global app HLX client controller command
+ *    coalescer.
+ *
+ *  @returns
+ *    A reference to the global app HLX client controller command
+ *    coalescer.
+ *
+ */
+- (CommandCoalescer &) commandCoalescer
+{
+    return (mCommandCoalescer);
+}
+
+/**
+ *  @brief
+ *    Get a reference to the global app HLX client controller state
+ *    change bus.
+ *
+ *  @returns
+ *    A reference to the global app HLX client controller state
+ *    change bus.
+ *
+ */
+- (StateChangeBus &) stateChangeBus
+{
+    return (mStateChangeBus);
+}
+
+/**
+ *  @brief
+ *    Get a reference to the global app HLX group and zone volume
+ *    fader.
+ *
+ *  @returns
+ *    A reference to the global app HLX group and zone volume fader.
+ *
+ */
+- (VolumeFader &) volumeFader
+{
+    return (mVolumeFader);
+}
+
+/**
+ *  @brief
+ *    Get, and give up, the location to pre-connect to at launch.
+ *
+ *  @returns
+ *    A pointer to the location to pre-connect to, if pre-connecting
+ *    at launch is enabled and the location has not already been
+ *    taken or superseded; otherwise, null.
+ *
+ */
+- (NSString *) takePreconnectLocation
+{
+    NSString * lRetval = mPreconnectLocation;
+
+    mPreconnectLocation = nullptr;
+
+    return (lRetval);
+}
+
+// MARK: Setters
+
+/**
+ *  @brief
+ *    Set the location the client controller is connected to, for
+ *    which client data snapshots are saved.
+ *
+ *  @param[in]  aLocation  A pointer to the network address, name, or
+ *                         URL location connected to, as the user
+ *                         entered it, or null for none.
+ *
+ */
+- (void) setConnectedLocation: (NSString *)aLocation
+{
+    mConnectedLocation = aLocation;
+}
+
 @end
@@ -30,6 +30,8 @@
 #include <CoreFoundation/CFURL.h>
 #include <Foundation/Foundation.h>
 
+#include <stdint.h>
+
 #include <OpenHLX/Client/ApplicationControllerDelegate.hpp>
 #include <OpenHLX/Common/Errors.hpp>
 #include <OpenHLX/Common/Timeout.hpp>
@@ -371,8 +373,42 @@ class ApplicationControllerDelegate :
 
     void ControllerError(HLX::Common::Application::ControllerBasis &aController, const HLX::Common::Error &aError) final;
 
+ private:
+    /**
+     *  A bit for each optional protocol method, set where the
+     *  delegate object responds to it.
+     *
+     */
+    enum : uint32_t
+    {
+        kRespondsNone             = 0,
+
+        kRespondsWillResolve      = 1 << 0,
+        kRespondsIsResolving      = 1 << 1,
+        kRespondsDidResolve       = 1 << 2,
+        kRespondsDidNotResolve    = 1 << 3,
+        kRespondsWillConnect      = 1 << 4,
+        kRespondsIsConnecting     = 1 << 5,
+        kRespondsDidConnect       = 1 << 6,
+        kRespondsDidNotConnect    = 1 << 7,
+        kRespondsWillDisconnect   = 1 << 8,
+        kRespondsDidDisconnect    = 1 << 9,
+        kRespondsDidNotDisconnect = 1 << 10,
+        kRespondsWillRefresh      = 1 << 11,
+        kRespondsIsRefreshing     = 1 << 12,
+        kRespondsDidRefresh       = 1 << 13,
+        kRespondsDidNotRefresh    = 1 << 14,
+        kRespondsStateDidChange   = 1 << 15,
+        kRespondsError            = 1 << 16
+    };
+
+    typedef uint32_t Responds;
+
+    static Responds GetResponds(id<ApplicationControllerDelegate> aObject);
+
  private:
     id<ApplicationControllerDelegate> mObject;
+    Responds                          mResponds;
 };
 
 #endif // OBJC_APPLICATIONCONTROLLERDELEGATE_HPP
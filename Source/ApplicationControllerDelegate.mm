@@ -39,7 +39,8 @@
  */
 ApplicationControllerDelegate :: ApplicationControllerDelegate(id<ApplicationControllerDelegate> aObject) :
     HLX::Client::Application::ControllerDelegate(),
-    mObject(aObject)
+    mObject(aObject),
+    mResponds(GetResponds(aObject))
 {
     return;
 }
@@ -71,9 +72,7 @@ ApplicationControllerDelegate :: ~ApplicationControllerDelegate(void)
 void
 ApplicationControllerDelegate :: ControllerWillResolve(HLX::Client::Application::Controller &aController, const char *aHost)
 {
-    const SEL lSelector = @selector(controllerWillResolve:withHost:);
-
-    if ([mObject respondsToSelector: lSelector])
+    if (mResponds & kRespondsWillResolve)
     {
         [mObject controllerWillResolve: aController
                               withHost: aHost];
@@ -95,9 +94,7 @@ ApplicationControllerDelegate :: ControllerWillResolve(HLX::Client::Application:
 void
 ApplicationControllerDelegate :: ControllerIsResolving(HLX::Client::Application::Controller &aController, const char *aHost)
 {
-    const SEL lSelector = @selector(controllerIsResolving:withHost:);
-
-    if ([mObject respondsToSelector: lSelector])
+    if (mResponds & kRespondsIsResolving)
     {
         [mObject controllerIsResolving: aController
                               withHost: aHost];
@@ -127,9 +124,7 @@ ApplicationControllerDelegate :: ControllerIsResolving(HLX::Client::Application:
 void
 ApplicationControllerDelegate :: ControllerDidResolve(HLX::Client::Application::Controller &aController, const char *aHost, const HLX::Common::IPAddress &aIPAddress)
 {
-    const SEL lSelector = @selector(controllerDidResolve:withHost:andAddress:);
-
-    if ([mObject respondsToSelector: lSelector])
+    if (mResponds & kRespondsDidResolve)
     {
         [mObject controllerDidResolve: aController
                              withHost: aHost
@@ -157,9 +152,7 @@ ApplicationControllerDelegate :: ControllerDidNotResolve(HLX::Client::Applicatio
                                                             const char *aHost,
                                                             const HLX::Common::Error &aError)
 {
-    const SEL lSelector = @selector(controllerDidNotResolve:withHost:andError:);
-
-    if ([mObject respondsToSelector: lSelector])
+    if (mResponds & kRespondsDidNotResolve)
     {
         [mObject controllerDidNotResolve: aController
                                 withHost: aHost
@@ -183,9 +176,7 @@ ApplicationControllerDelegate :: ControllerDidNotResolve(HLX::Client::Applicatio
 void
 ApplicationControllerDelegate :: ControllerWillConnect(HLX::Client::Application::Controller &aController, CFURLRef aURLRef, const HLX::Common::Timeout &aTimeout)
 {
-    const SEL lSelector = @selector(controllerWillConnect:withURL:andTimeout:);
-
-    if ([mObject respondsToSelector: lSelector])
+    if (mResponds & kRespondsWillConnect)
     {
         [mObject controllerWillConnect: aController
                                withURL: (__bridge NSURL *)aURLRef
@@ -207,9 +198,7 @@ ApplicationControllerDelegate :: ControllerWillConnect(HLX::Client::Application:
 void
 ApplicationControllerDelegate :: ControllerIsConnecting(HLX::Client::Application::Controller &aController, CFURLRef aURLRef, const HLX::Common::Timeout &aTimeout)
 {
-    const SEL lSelector = @selector(controllerIsConnecting:withURL:andTimeout:);
-
-    if ([mObject respondsToSelector: lSelector])
+    if (mResponds & kRespondsIsConnecting)
     {
         [mObject controllerIsConnecting: aController
                                 withURL: (__bridge NSURL *)aURLRef
@@ -230,9 +219,7 @@ ApplicationControllerDelegate :: ControllerIsConnecting(HLX::Client::Application
 void
 ApplicationControllerDelegate :: ControllerDidConnect(HLX::Client::Application::Controller &aController, CFURLRef aURLRef)
 {
-    const SEL lSelector = @selector(controllerDidConnect:withURL:);
-
-    if ([mObject respondsToSelector: lSelector])
+    if (mResponds & kRespondsDidConnect)
     {
         [mObject controllerDidConnect: aController
                               withURL: (__bridge NSURL *)aURLRef];
@@ -254,9 +241,7 @@ ApplicationControllerDelegate :: ControllerDidConnect(HLX::Client::Application::
 void
 ApplicationControllerDelegate :: ControllerDidNotConnect(HLX::Client::Application::Controller &aController, CFURLRef aURLRef, const HLX::Common::Error &aError)
 {
-    const SEL lSelector = @selector(controllerDidNotConnect:withURL:andError:);
-
-    if ([mObject respondsToSelector: lSelector])
+    if (mResponds & kRespondsDidNotConnect)
     {
         [mObject controllerDidNotConnect: aController
                                  withURL: (__bridge NSURL *)aURLRef
@@ -279,9 +264,7 @@ ApplicationControllerDelegate :: ControllerDidNotConnect(HLX::Client::Applicatio
 void
 ApplicationControllerDelegate :: ControllerWillDisconnect(HLX::Client::Application::Controller &aController, CFURLRef aURLRef)
 {
-    const SEL lSelector = @selector(controllerWillDisconnect:withURL:);
-
-    if ([mObject respondsToSelector: lSelector])
+    if (mResponds & kRespondsWillDisconnect)
     {
         [mObject controllerWillDisconnect: aController
                                   withURL: (__bridge NSURL *)aURLRef];
@@ -303,9 +286,7 @@ ApplicationControllerDelegate :: ControllerWillDisconnect(HLX::Client::Applicati
 void
 ApplicationControllerDelegate :: ControllerDidDisconnect(HLX::Client::Application::Controller &aController, CFURLRef aURLRef, const HLX::Common::Error &aError)
 {
-    const SEL lSelector = @selector(controllerDidDisconnect:withURL:andError:);
-
-    if ([mObject respondsToSelector: lSelector])
+    if (mResponds & kRespondsDidDisconnect)
     {
         [mObject controllerDidDisconnect: aController
                                  withURL: (__bridge NSURL *)aURLRef
@@ -329,9 +310,7 @@ ApplicationControllerDelegate :: ControllerDidDisconnect(HLX::Client::Applicatio
 void
 ApplicationControllerDelegate :: ControllerDidNotDisconnect(HLX::Client::Application::Controller &aController, CFURLRef aURLRef, const HLX::Common::Error &aError)
 {
-    const SEL lSelector = @selector(controllerDidNotDisconnect:withURL:andError:);
-
-    if ([mObject respondsToSelector: lSelector])
+    if (mResponds & kRespondsDidNotDisconnect)
     {
         [mObject controllerDidNotDisconnect: aController
                                     withURL: (__bridge NSURL *)aURLRef
@@ -353,9 +332,7 @@ ApplicationControllerDelegate :: ControllerDidNotDisconnect(HLX::Client::Applica
 void
 ApplicationControllerDelegate :: ControllerWillRefresh(HLX::Client::Application::ControllerBasis &aController)
 {
-    const SEL lSelector = @selector(controllerWillRefresh:);
-
-    if ([mObject respondsToSelector: lSelector])
+    if (mResponds & kRespondsWillRefresh)
     {
         [mObject controllerWillRefresh: aController];
     }
@@ -376,9 +353,7 @@ ApplicationControllerDelegate :: ControllerWillRefresh(HLX::Client::Application:
 void
 ApplicationControllerDelegate :: ControllerIsRefreshing(HLX::Client::Application::ControllerBasis &aController, const uint8_t &aPercentComplete)
 {
-    const SEL lSelector = @selector(controllerIsRefreshing:withProgress:);
-
-    if ([mObject respondsToSelector: lSelector])
+    if (mResponds & kRespondsIsRefreshing)
     {
         [mObject controllerIsRefreshing: aController
                            withProgress: aPercentComplete];
@@ -397,9 +372,7 @@ ApplicationControllerDelegate :: ControllerIsRefreshing(HLX::Client::Application
 void
 ApplicationControllerDelegate :: ControllerDidRefresh(HLX::Client::Application::ControllerBasis &aController)
 {
-    const SEL lSelector = @selector(controllerDidRefresh:);
-
-    if ([mObject respondsToSelector: lSelector])
+    if (mResponds & kRespondsDidRefresh)
     {
         [mObject controllerDidRefresh: aController];
     }
@@ -419,9 +392,7 @@ ApplicationControllerDelegate :: ControllerDidRefresh(HLX::Client::Application::
 void
 ApplicationControllerDelegate :: ControllerDidNotRefresh(HLX::Client::Application::ControllerBasis &aController, const HLX::Common::Error &aError)
 {
-    const SEL lSelector = @selector(controllerDidNotRefresh:withError:);
-
-    if ([mObject respondsToSelector: lSelector])
+    if (mResponds & kRespondsDidNotRefresh)
     {
         [mObject controllerDidNotRefresh: aController
                                withError: aError];
@@ -448,9 +419,7 @@ ApplicationControllerDelegate :: ControllerDidNotRefresh(HLX::Client::Applicatio
 void
 ApplicationControllerDelegate :: ControllerStateDidChange(HLX::Client::Application::ControllerBasis &aController, const HLX::Client::StateChange::NotificationBasis &aStateChangeNotification)
 {
-    const SEL lSelector = @selector(controllerStateDidChange:withNotification:);
-
-    if ([mObject respondsToSelector: lSelector])
+    if (mResponds & kRespondsStateDidChange)
     {
         [mObject controllerStateDidChange: aController
                          withNotification: aStateChangeNotification];
@@ -477,11 +446,66 @@ ApplicationControllerDelegate :: ControllerStateDidChange(HLX::Client::Applicati
 void
 ApplicationControllerDelegate :: ControllerError(HLX::Common::Application::ControllerBasis &aController, const HLX::Common::Error &aError)
 {
-    const SEL lSelector = @selector(controllerError:withError:);
-
-    if ([mObject respondsToSelector: lSelector])
+    if (mResponds & kRespondsError)
     {
         [mObject controllerError: aController
                        withError: aError];
     }
 }
+
+/**
+ *  @brief
+ *    Resolve which optional protocol methods an object responds to.
+ *
+ *  This is done once, when the delegate object is bound, rather than
+ *  asking the Objective C runtime on each delegation, since state
+ *  change delegations, in particular, arrive for each property of
+ *  each group and zone on every refresh.
+ *
+ *  @param[in]  aObject  A pointer to the object, observing the
+ *                       #ApplicationControllerDelegate protocol, to
+ *                       resolve.
+ *
+ *  @returns
+ *    The bitwise OR of the responds bit for each optional protocol
+ *    method the object responds to.
+ *
+ */
+ApplicationControllerDelegate :: Responds
+ApplicationControllerDelegate :: GetResponds(id<ApplicationControllerDelegate> aObject)
+{
+    const struct
+    {
+        SEL       mSelector;
+        Responds  mResponds;
+    } lMethods[] = {
+        { @selector(controllerWillResolve:withHost:),              kRespondsWillResolve },
+        { @selector(controllerIsResolving:withHost:),              kRespondsIsResolving },
+        { @selector(controllerDidResolve:withHost:andAddress:),    kRespondsDidResolve },
+        { @selector(controllerDidNotResolve:withHost:andError:),   kRespondsDidNotResolve },
+        { @selector(controllerWillConnect:withURL:andTimeout:),    kRespondsWillConnect },
+        { @selector(controllerIsConnecting:withURL:andTimeout:),   kRespondsIsConnecting },
+        { @selector(controllerDidConnect:withURL:),                kRespondsDidConnect },
+        { @selector(controllerDidNotConnect:withURL:andError:),    kRespondsDidNotConnect },
+        { @selector(controllerWillDisconnect:withURL:),            kRespondsWillDisconnect },
+        { @selector(controllerDidDisconnect:withURL:andError:),    kRespondsDidDisconnect },
+        { @selector(controllerDidNotDisconnect:withURL:andError:), kRespondsDidNotDisconnect },
+        { @selector(controllerWillRefresh:),                       kRespondsWillRefresh },
+        { @selector(controllerIsRefreshing:withProgress:),         kRespondsIsRefreshing },
+        { @selector(controllerDidRefresh:),                        kRespondsDidRefresh },
+        { @selector(controllerDidNotRefresh:withError:),           kRespondsDidNotRefresh },
+        { @selector(controllerStateDidChange:withNotification:),   kRespondsStateDidChange },
+        { @selector(controllerError:withError:),                   kRespondsError },
+    };
+    Responds lRetval = kRespondsNone;
+
+    for (const auto &lMethod : lMethods)
+    {
+        if ([aObject respondsToSelector: lMethod.mSelector])
+        {
+            lRetval |= lMethod.mResponds;
+        }
+    }
+
+    return (lRetval);
+}
@@ -0,0 +1,756 @@
+/*
+ *    Copyright (c) 2026 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *  @file
+ *    This file implements an object for coalescing
+ *    continuously-adjusted HLX client controller set commands, such
+ *    as those driven by sliders, such that only the latest value is
+ *    sent.
+ *
+ */
+
+#include "CommandCoalescer.hpp"
+
+#include <vector>
+
+#include <errno.h>
+
+#include <LogUtilities/LogUtilities.hpp>
+
+#include <OpenHLX/Client/EqualizerPresetsStateChangeNotifications.hpp>
+#include <OpenHLX/Client/GroupsStateChangeNotifications.hpp>
+#include <OpenHLX/Client/ZonesStateChangeNotifications.hpp>
+#include <OpenHLX/Utilities/Assert.hpp>
+
+
+using namespace HLX::Client;
+using namespace HLX::Common;
+using namespace Nuovations;
+
+
+// The default time after which an in-flight command that has not
+// been answered is retired anyway.
+
+static const CommandCoalescer::Duration kResponseTimeoutDefault(5000);
+
+/*
+ *  Return the command pipeline lane a command waits in: mutes, which
+ *  the user expects to take effect at once, in the interactive lane
+ *  and all else in the user lane.
+ */
+static CommandScheduler::Lane
+GetPipelineLane(const CommandCoalescer::Property &aProperty)
+{
+    return ((aProperty == CommandCoalescer::kPropertyMute) ? CommandScheduler::kLaneInteractive : CommandScheduler::kLaneUser);
+}
+
+/*
+ *  Return the property, as the command pipeline knows it, whose state
+ *  change answers a command.
+ */
+static CommandPipeline::Answers
+GetPipelineAnswers(const CommandCoalescer::Property &aProperty)
+{
+    CommandPipeline::Answers  lRetval;
+
+
+    switch (aProperty)
+    {
+
+    case CommandCoalescer::kPropertyMute:
+        lRetval = CommandPipeline::kAnswerMute;
+        break;
+
+    case CommandCoalescer::kPropertyBalance:
+        lRetval = CommandPipeline::kAnswerBalance;
+        break;
+
+    case CommandCoalescer::kPropertyEqualizerBand:
+        lRetval = CommandPipeline::kAnswerEqualizerBand;
+        break;
+
+    case CommandCoalescer::kPropertyBass:
+    case CommandCoalescer::kPropertyTreble:
+        lRetval = CommandPipeline::kAnswerTone;
+        break;
+
+    case CommandCoalescer::kPropertyHighpassCrossover:
+        lRetval = CommandPipeline::kAnswerHighpassCrossover;
+        break;
+
+    case CommandCoalescer::kPropertyLowpassCrossover:
+        lRetval = CommandPipeline::kAnswerLowpassCrossover;
+        break;
+
+    case CommandCoalescer::kPropertyVolume:
+    default:
+        lRetval = CommandPipeline::kAnswerVolume;
+        break;
+
+    }
+
+    return (lRetval);
+}
+
+/*
+ *  Return the kind of entity, as the command pipeline knows it, that
+ *  a command is about.
+ */
+static CommandPipeline::Kind
+GetPipelineKind(const CommandCoalescer::Kind &aKind)
+{
+    CommandPipeline::Kind  lRetval;
+
+
+    switch (aKind)
+    {
+
+    case CommandCoalescer::kKindGroup:
+        lRetval = CommandPipeline::kKindGroup;
+        break;
+
+    case CommandCoalescer::kKindEqualizerPreset:
+        lRetval = CommandPipeline::kKindEqualizerPreset;
+        break;
+
+    case CommandCoalescer::kKindZone:
+    default:
+        lRetval = CommandPipeline::kKindZone;
+        break;
+
+    }
+
+    return (lRetval);
+}
+
+// MARK: Key
+
+/**
+ *  @brief
+ *    This is the class constructor.
+ *
+ *  @param[in]  aKind        The kind of entity.
+ *  @param[in]  aIdentifier  The entity identifier.
+ *  @param[in]  aProperty    The property.
+ *  @param[in]  aBand        For kPropertyEqualizerBand, the band
+ *                           identifier; otherwise, ignored.
+ *
+ */
+CommandCoalescer :: Key :: Key(const Kind &aKind, const IdentifierType &aIdentifier, const Property &aProperty, const IdentifierType &aBand) :
+    mKind(aKind),
+    mIdentifier(aIdentifier),
+    mProperty(aProperty),
+    mBand((aProperty == kPropertyEqualizerBand) ? aBand : 0)
+{
+    return;
+}
+
+bool
+CommandCoalescer :: Key :: operator <(const Key &aKey) const
+{
+    bool  lRetval;
+
+    if (mKind != aKey.mKind)
+    {
+        lRetval = (mKind < aKey.mKind);
+    }
+    else if (mIdentifier != aKey.mIdentifier)
+    {
+        lRetval = (mIdentifier < aKey.mIdentifier);
+    }
+    else if (mProperty != aKey.mProperty)
+    {
+        lRetval = (mProperty < aKey.mProperty);
+    }
+    else
+    {
+        lRetval = (mBand < aKey.mBand);
+    }
+
+    return (lRetval);
+}
+
+// MARK: Coalescer
+
+/**
+ *  @brief
+ *    This is the class default constructor.
+ *
+ */
+CommandCoalescer :: CommandCoalescer(void) :
+    mResponseTimeout(kResponseTimeoutDefault),
+    mEntries(),
+    mRollbackHandler(),
+    mCommandPipeline(nullptr)
+{
+    return;
+}
+
+/**
+ *  @brief
+ *    This is the class destructor.
+ *
+ */
+CommandCoalescer :: ~CommandCoalescer(void)
+{
+    return;
+}
+
+/**
+ *  @brief
+ *    This is the class initializer.
+ *
+ *  @param[in]  aResponseTimeout  The time after which an in-flight
+ *                                command that has not been answered
+ *                                is retired anyway.
+ *
+ *  @retval  kStatus_Success  If successful.
+ *
+ */
+Status
+CommandCoalescer :: Init(const Duration &aResponseTimeout)
+{
+    mResponseTimeout = aResponseTimeout;
+
+    return (kStatus_Success);
+}
+
+/**
+ *  @brief
+ *    Set the function that is told of a property whose optimistic
+ *    value was rolled back to the model value.
+ *
+ *  @param[in]  aRollbackHandler  The rollback handler, or an empty
+ *                                function for none.
+ *
+ */
+void
+CommandCoalescer :: SetRollbackHandler(const RollbackHandler &aRollbackHandler)
+{
+    mRollbackHandler = aRollbackHandler;
+}
+
+/**
+ *  @brief
+ *    Set the command pipeline through which commands are sent.
+ *
+ *  With a pipeline, commands are enqueued to it, in the interactive
+ *  lane for mutes and the user lane otherwise, and their response
+ *  timeouts run from when it issues them; without one, their setters
+ *  are called directly.
+ *
+ *  @param[in]  aCommandPipeline  A pointer to the command pipeline,
+ *                                or null for none.
+ *
+ */
+void
+CommandCoalescer :: SetCommandPipeline(CommandPipeline *aCommandPipeline)
+{
+    mCommandPipeline = aCommandPipeline;
+}
+
+// MARK: Commands
+
+/**
+ *  @brief
+ *    Submit a set command for a property the client controller model
+ *    does not yet hold a value for, sending it immediately if none is
+ *    in flight for the same property or, otherwise, keeping it in
+ *    place of any already waiting.
+ *
+ *  @param[in]  aKey         The property the command sets.
+ *  @param[in]  aValue       The value to set.
+ *  @param[in]  aSetter      The function that sends the command.
+ *
+ *  @retval  kStatus_Success          If successful.
+ *  @retval  kStatus_ValueAlreadySet  If @a aValue was equal to what
+ *                                    is in flight and was not sent.
+ *  @retval  -EINVAL                  If @a aSetter was empty.
+ *  @retval  -ERANGE                  If @a aKey was invalid.
+ *
+ */
+Status
+CommandCoalescer :: Submit(const Key &aKey, const ValueType &aValue, const Setter &aSetter)
+{
+    return (Submit(aKey, aValue, nullptr, aSetter));
+}
+
+/**
+ *  @brief
+ *    Submit a set command, sending it immediately if none is in
+ *    flight for the same property or, otherwise, keeping it in place
+ *    of any already waiting.
+ *
+ *  @param[in]  aKey         The property the command sets.
+ *  @param[in]  aValue       The value to set.
+ *  @param[in]  aModelValue  The value the client controller model
+ *                           currently holds for the property.
+ *  @param[in]  aSetter      The function that sends the command.
+ *
+ *  @retval  kStatus_Success          If successful.
+ *  @retval  kStatus_ValueAlreadySet  If @a aValue was equal to what
+ *                                    is in flight or, with nothing
+ *                                    in flight, to @a aModelValue
+ *                                    and was not sent.
+ *  @retval  -EINVAL                  If @a aSetter was empty.
+ *  @retval  -ERANGE                  If @a aKey was invalid.
+ *
+ */
+Status
+CommandCoalescer :: Submit(const Key &aKey, const ValueType &aValue, const ValueType &aModelValue, const Setter &aSetter)
+{
+    return (Submit(aKey, aValue, &aModelValue, aSetter));
+}
+
+/**
+ *  @brief
+ *    Return whether a command for the specified property is in
+ *    flight.
+ *
+ */
+bool
+CommandCoalescer :: IsInFlight(const Key &aKey) const
+{
+    Entries::const_iterator  lEntry = mEntries.find(aKey);
+
+    return ((lEntry != mEntries.end()) && lEntry->second.mInFlight);
+}
+
+/**
+ *  @brief
+ *    Return the value the specified property is expected to hold once
+ *    its in-flight and waiting commands, if any, are answered.
+ *
+ *  This is the optimistic overlay on the client controller model;
+ *  where it has a value, views render it in place of the model
+ *  value.
+ *
+ *  @param[in]   aKey    The property.
+ *  @param[out]  aValue  A reference to storage for the value.
+ *
+ *  @retval  kStatus_Success  If successful.
+ *  @retval  -ENOENT          If there is no command in flight for
+ *                            @a aKey and the model value stands.
+ *
+ */
+Status
+CommandCoalescer :: GetValue(const Key &aKey, ValueType &aValue) const
+{
+    Entries::const_iterator  lEntry = mEntries.find(aKey);
+    Status                   lRetval = kStatus_Success;
+
+
+    nlEXPECT_ACTION(lEntry != mEntries.end(), done, lRetval = -ENOENT);
+
+    aValue = (lEntry->second.mPending ? lEntry->second.mPendingValue : lEntry->second.mInFlightValue);
+
+ done:
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Discard all in-flight and waiting commands.
+ *
+ *  This is typically used when the client controller disconnects,
+ *  after which no in-flight command will be answered.
+ *
+ */
+void
+CommandCoalescer :: Clear(void)
+{
+    mEntries.clear();
+}
+
+// MARK: Responses
+
+/**
+ *  @brief
+ *    Observe a client controller state change, retiring the
+ *    in-flight command it answers, if any, and sending the command
+ *    waiting behind it.
+ *
+ *  @param[in]  aStateChangeNotification  An immutable reference
+ *                                        to a notification
+ *                                        describing the state
+ *                                        change.
+ *
+ */
+void
+CommandCoalescer :: StateDidChange(const StateChange::NotificationBasis &aStateChangeNotification)
+{
+    nlEXPECT(!mEntries.empty(), done);
+
+    switch (aStateChangeNotification.GetType())
+    {
+
+    case StateChange::kStateChangeType_EqualizerPresetBand:
+        {
+            const StateChange::EqualizerPresetsBandNotification &lSCN = static_cast<const StateChange::EqualizerPresetsBandNotification &>(aStateChangeNotification);
+
+            Retire(Key(kKindEqualizerPreset, lSCN.GetIdentifier(), kPropertyEqualizerBand, lSCN.GetBand()), true);
+        }
+        break;
+
+    case StateChange::kStateChangeType_GroupMute:
+        {
+            const StateChange::GroupsNotificationBasis &lSCN = static_cast<const StateChange::GroupsNotificationBasis &>(aStateChangeNotification);
+
+            Retire(Key(kKindGroup, lSCN.GetIdentifier(), kPropertyMute), true);
+        }
+        break;
+
+    case StateChange::kStateChangeType_GroupVolume:
+        {
+            const StateChange::GroupsNotificationBasis &lSCN = static_cast<const StateChange::GroupsNotificationBasis &>(aStateChangeNotification);
+
+            Retire(Key(kKindGroup, lSCN.GetIdentifier(), kPropertyVolume), true);
+        }
+        break;
+
+    case StateChange::kStateChangeType_ZoneBalance:
+        {
+            const StateChange::ZonesNotificationBasis &lSCN = static_cast<const StateChange::ZonesNotificationBasis &>(aStateChangeNotification);
+
+            Retire(Key(kKindZone, lSCN.GetIdentifier(), kPropertyBalance), true);
+        }
+        break;
+
+    case StateChange::kStateChangeType_ZoneEqualizerBand:
+        {
+            const StateChange::ZonesEqualizerBandNotification &lSCN = static_cast<const StateChange::ZonesEqualizerBandNotification &>(aStateChangeNotification);
+
+            Retire(Key(kKindZone, lSCN.GetIdentifier(), kPropertyEqualizerBand, lSCN.GetBand()), true);
+        }
+        break;
+
+    case StateChange::kStateChangeType_ZoneHighpassCrossover:
+        {
+            const StateChange::ZonesNotificationBasis &lSCN = static_cast<const StateChange::ZonesNotificationBasis &>(aStateChangeNotification);
+
+            Retire(Key(kKindZone, lSCN.GetIdentifier(), kPropertyHighpassCrossover), true);
+        }
+        break;
+
+    case StateChange::kStateChangeType_ZoneLowpassCrossover:
+        {
+            const StateChange::ZonesNotificationBasis &lSCN = static_cast<const StateChange::ZonesNotificationBasis &>(aStateChangeNotification);
+
+            Retire(Key(kKindZone, lSCN.GetIdentifier(), kPropertyLowpassCrossover), true);
+        }
+        break;
+
+    case StateChange::kStateChangeType_ZoneMute:
+        {
+            const StateChange::ZonesNotificationBasis &lSCN = static_cast<const StateChange::ZonesNotificationBasis &>(aStateChangeNotification);
+
+            Retire(Key(kKindZone, lSCN.GetIdentifier(), kPropertyMute), true);
+        }
+        break;
+
+    case StateChange::kStateChangeType_ZoneTone:
+        {
+            const StateChange::ZonesToneNotification &lSCN = static_cast<const StateChange::ZonesToneNotification &>(aStateChangeNotification);
+
+            // Bass and treble are set separately but reported
+            // together; the report answers only the one whose
+            // in-flight value it now holds, leaving the other, if
+            // also in flight, to its own report.
+
+            Retire(Key(kKindZone, lSCN.GetIdentifier(), kPropertyBass), static_cast<ValueType>(lSCN.GetBass()));
+            Retire(Key(kKindZone, lSCN.GetIdentifier(), kPropertyTreble), static_cast<ValueType>(lSCN.GetTreble()));
+        }
+        break;
+
+    case StateChange::kStateChangeType_ZoneVolume:
+        {
+            const StateChange::ZonesNotificationBasis &lSCN = static_cast<const StateChange::ZonesNotificationBasis &>(aStateChangeNotification);
+
+            Retire(Key(kKindZone, lSCN.GetIdentifier(), kPropertyVolume), true);
+        }
+        break;
+
+    default:
+        break;
+
+    }
+
+    Service();
+
+ done:
+    return;
+}
+
+/**
+ *  @brief
+ *    Retire any in-flight commands that have timed out, sending the
+ *    commands waiting behind them.
+ *
+ */
+void
+CommandCoalescer :: Service(void)
+{
+    Expire(Clock::now());
+}
+
+// MARK: Implementation
+
+Status
+CommandCoalescer :: Submit(const Key &aKey, const ValueType &aValue, const ValueType *aModelValue, const Setter &aSetter)
+{
+    Entries::iterator  lEntry;
+    Status             lRetval = kStatus_Success;
+
+
+    nlREQUIRE_ACTION(aKey.mKind < kKindMax, done, lRetval = -ERANGE);
+    nlREQUIRE_ACTION(aKey.mProperty < kPropertyMax, done, lRetval = -ERANGE);
+    nlREQUIRE_ACTION(aSetter != nullptr, done, lRetval = -EINVAL);
+
+    Expire(Clock::now());
+
+    lEntry = mEntries.find(aKey);
+
+    if ((lEntry != mEntries.end()) && lEntry->second.mInFlight)
+    {
+        // Whatever was waiting is now stale; the latest value, if it
+        // is not what is already in flight, takes its place.
+
+        lEntry->second.mPending      = (aValue != lEntry->second.mInFlightValue);
+        lEntry->second.mPendingValue = aValue;
+        lEntry->second.mSetter       = aSetter;
+
+        if (!lEntry->second.mPending)
+        {
+            lRetval = kStatus_ValueAlreadySet;
+        }
+    }
+    else if ((aModelValue != nullptr) && (aValue == *aModelValue))
+    {
+        lRetval = kStatus_ValueAlreadySet;
+    }
+    else
+    {
+        Entry &lNewEntry = mEntries[aKey];
+
+        lNewEntry.mPending = false;
+        lNewEntry.mSetter  = aSetter;
+
+        lRetval = Issue(aKey, lNewEntry, aValue, (aModelValue != nullptr));
+
+        if (!lNewEntry.mInFlight)
+        {
+            mEntries.erase(aKey);
+        }
+    }
+
+ done:
+    return (lRetval);
+}
+
+Status
+CommandCoalescer :: Issue(const Key &aKey, Entry &aEntry, const ValueType &aValue, const bool &aModelValueKnown)
+{
+    Status  lRetval;
+
+
+    aEntry.mInFlightValue = aValue;
+
+    if (mCommandPipeline == nullptr)
+    {
+        lRetval = aEntry.mSetter(aValue);
+
+        aEntry.mInFlight = (lRetval == kStatus_Success);
+        aEntry.mQueued   = false;
+        aEntry.mIssued   = Clock::now();
+    }
+    else
+    {
+        CommandCoalescer * const  lCoalescer = this;
+        const Key                 lKey       = aKey;
+        const ValueType           lValue     = aValue;
+        const Setter              lSetter    = aEntry.mSetter;
+
+        // The entry is queued ahead of enqueueing, since the pipeline
+        // may issue the command, and so report it issued, before
+        // returning.
+        //
+        // Where the model value is not known, the command may change
+        // nothing and so may not be answered.
+
+        aEntry.mInFlight = true;
+        aEntry.mQueued   = true;
+
+        lRetval = mCommandPipeline->Enqueue(GetPipelineKind(aKey.mKind),
+                                            aKey.mIdentifier,
+                                            GetPipelineAnswers(aKey.mProperty),
+                                            GetPipelineLane(aKey.mProperty),
+                                            (aModelValueKnown ? CommandPipeline::kResponseExpected : CommandPipeline::kResponseOptional),
+                                            [lCoalescer, lKey, lValue, lSetter]() { return (lCoalescer->DidIssue(lKey, lValue, lSetter(lValue))); });
+
+        if (lRetval != kStatus_Success)
+        {
+            aEntry.mInFlight = false;
+            aEntry.mQueued   = false;
+        }
+    }
+
+    // A command that could not be sent will not be answered; leave
+    // the property idle rather than waiting out the timeout on it.
+
+    if (!aEntry.mInFlight)
+    {
+        Log::Error().Write("Could not send command for value %d: %d\n", aValue, lRetval);
+    }
+
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Observe the command pipeline issuing a command, starting its
+ *    response timeout.
+ *
+ *  A command the pipeline could not issue is retired, rolling it
+ *  back, the next time the coalescer is serviced rather than here,
+ *  since retiring it may enqueue the command waiting behind it while
+ *  the pipeline is still issuing.
+ *
+ *  @param[in]  aKey     The property the command sets.
+ *  @param[in]  aValue   The value the command sets.
+ *  @param[in]  aStatus  The status the setter returned on issuing
+ *                       the command.
+ *
+ *  @returns
+ *    @a aStatus, for the pipeline.
+ *
+ */
+Status
+CommandCoalescer :: DidIssue(const Key &aKey, const ValueType &aValue, const Status &aStatus)
+{
+    Entries::iterator  lEntry = mEntries.find(aKey);
+
+
+    nlEXPECT(lEntry != mEntries.end(), done);
+    nlEXPECT(lEntry->second.mQueued && (lEntry->second.mInFlightValue == aValue), done);
+
+    lEntry->second.mQueued = false;
+
+    if (aStatus == kStatus_Success)
+    {
+        lEntry->second.mIssued = Clock::now();
+    }
+    else
+    {
+        Log::Error().Write("Could not send command for value %d: %d\n", aValue, aStatus);
+
+        lEntry->second.mIssued = Clock::time_point();
+    }
+
+ done:
+    return (aStatus);
+}
+
+void
+CommandCoalescer :: Retire(const Key &aKey, const bool &aAnswered)
+{
+    Entries::iterator  lEntry = mEntries.find(aKey);
+    bool               lRolledBack;
+
+
+    nlEXPECT(lEntry != mEntries.end(), done);
+
+    // A command still waiting in the command pipeline has not been
+    // sent and so cannot yet have been answered.
+
+    nlEXPECT(!(aAnswered && lEntry->second.mQueued), done);
+
+    lEntry->second.mInFlight = false;
+
+    // An answered command confirms its value into the model. Any
+    // other leaves the model as it was, rolling the optimistic value
+    // back, unless a waiting command takes over from it.
+
+    lRolledBack = !aAnswered;
+
+    if (lEntry->second.mPending)
+    {
+        lEntry->second.mPending = false;
+
+        Issue(aKey, lEntry->second, lEntry->second.mPendingValue, aAnswered);
+
+        lRolledBack = !lEntry->second.mInFlight;
+    }
+
+    if (!lEntry->second.mInFlight)
+    {
+        mEntries.erase(lEntry);
+    }
+
+    if (lRolledBack && (mRollbackHandler != nullptr))
+    {
+        mRollbackHandler(aKey);
+    }
+
+ done:
+    return;
+}
+
+void
+CommandCoalescer :: Retire(const Key &aKey, const ValueType &aValue)
+{
+    Entries::const_iterator  lEntry = mEntries.find(aKey);
+
+
+    nlEXPECT(lEntry != mEntries.end(), done);
+    nlEXPECT(lEntry->second.mInFlightValue == aValue, done);
+
+    Retire(aKey, true);
+
+ done:
+    return;
+}
+
+void
+CommandCoalescer :: Expire(const Clock::time_point &aNow)
+{
+    std::vector<Key>  lExpired;
+
+
+    // Collect the timed out commands first; retiring them sends
+    // those waiting and tells the rollback handler, either of which
+    // may change the entries.
+
+    for (const auto &lEntry : mEntries)
+    {
+        if (!lEntry.second.mQueued && ((aNow - lEntry.second.mIssued) >= mResponseTimeout))
+        {
+            Log::Debug().Write("Command for kind %u identifier %u property %u timed out.\n",
+                               lEntry.first.mKind,
+                               lEntry.first.mIdentifier,
+                               lEntry.first.mProperty);
+
+            lExpired.push_back(lEntry.first);
+        }
+    }
+
+    for (const auto &lKey : lExpired)
+    {
+        Retire(lKey, false);
+    }
+}
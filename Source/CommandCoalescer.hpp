@@ -0,0 +1,214 @@
+/*
+ *    Copyright (c) 2026 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *  @file
+ *    This file defines an object for coalescing continuously-adjusted
+ *    HLX client controller set commands, such as those driven by
+ *    sliders, such that only the latest value is sent.
+ *
+ */
+
+#ifndef COMMANDCOALESCER_HPP
+#define COMMANDCOALESCER_HPP
+
+#include <chrono>
+#include <functional>
+#include <map>
+
+#include <stdint.h>
+
+#include <OpenHLX/Client/ApplicationControllerDelegate.hpp>
+#include <OpenHLX/Common/Errors.hpp>
+#include <OpenHLX/Model/IdentifierModel.hpp>
+
+#include "CommandPipeline.hpp"
+
+
+/**
+ *  @brief
+ *    An object for coalescing HLX client controller set commands.
+ *
+ *  Set commands are submitted for a property of a group, zone, or
+ *  equalizer preset along with a function that sends them. For each
+ *  such property, at most one command is in flight at once; while it
+ *  is, only the latest value submitted is kept, replacing any that
+ *  came before it, and is sent once the in-flight command is
+ *  answered. A value equal to what the model already holds, with
+ *  nothing in flight, or to what is already in flight, is not sent
+ *  at all.
+ *
+ *  With a command pipeline, each command is sent by enqueueing it to
+ *  the pipeline, in the interactive lane for mutes and the user lane
+ *  otherwise, rather than by calling its setter directly; it is in
+ *  flight, for the purposes of coalescing, from when it is enqueued,
+ *  but its response timeout runs only from when the pipeline actually
+ *  issues it, such that a command waiting behind others in the
+ *  pipeline neither times out nor has another for the same property
+ *  enqueued behind it.
+ *
+ *  A command is answered when the client controller reports a state
+ *  change for the same property. Since a peer may report no state
+ *  change, for example, where it clamps a value to what it already
+ *  holds, a command not answered within the response timeout is
+ *  retired anyway, the next time the coalescer is serviced.
+ *
+ *  The effect is that a slider dragged across its range sends as
+ *  many commands as the peer can answer in that time, ending with
+ *  the value the slider was released at, rather than one for every
+ *  value it passed through.
+ *
+ *  The values submitted but not yet answered also form an optimistic
+ *  overlay on the client controller model: #GetValue returns the
+ *  value a property will hold once its commands are answered, such
+ *  that views may render it immediately rather than a round trip
+ *  later. A command that is answered confirms its value into the
+ *  model; one that times out, with nothing waiting behind it, or
+ *  that cannot be sent, rolls the property back to the model value,
+ *  of which the rollback handler, if any, is told.
+ *
+ */
+class CommandCoalescer
+{
+public:
+    /**
+     *  The kind of entity a command is about.
+     *
+     */
+    enum Kind
+    {
+        kKindGroup = 0,         //!< A group.
+        kKindZone,              //!< A zone.
+        kKindEqualizerPreset,   //!< An equalizer preset.
+
+        kKindMax
+    };
+
+    /**
+     *  The property of the entity a command sets.
+     *
+     */
+    enum Property
+    {
+        kPropertyVolume = 0,         //!< Volume level.
+        kPropertyMute,               //!< Volume mute state.
+        kPropertyBalance,            //!< Stereophonic channel balance.
+        kPropertyEqualizerBand,      //!< Equalizer band level.
+        kPropertyBass,               //!< Tone bass level.
+        kPropertyTreble,             //!< Tone treble level.
+        kPropertyHighpassCrossover,  //!< Highpass crossover frequency.
+        kPropertyLowpassCrossover,   //!< Lowpass crossover frequency.
+
+        kPropertyMax
+    };
+
+    typedef HLX::Model::IdentifierModel::IdentifierType IdentifierType;
+
+    /**
+     *  The type for property values, wide enough for any of the
+     *  levels, balances, and frequencies that are set.
+     *
+     */
+    typedef int32_t ValueType;
+
+    /**
+     *  A function that sends a set command for a value to the client
+     *  controller.
+     *
+     */
+    typedef std::function<HLX::Common::Status (const ValueType &aValue)> Setter;
+
+    typedef std::chrono::steady_clock Clock;
+    typedef std::chrono::milliseconds Duration;
+
+    struct Key;
+
+    /**
+     *  A function that is told of a property whose optimistic value
+     *  was rolled back to the model value.
+     *
+     */
+    typedef std::function<void (const Key &aKey)> RollbackHandler;
+
+    /**
+     *  The property of an entity a command sets.
+     *
+     */
+    struct Key
+    {
+        Key(const Kind &aKind, const IdentifierType &aIdentifier, const Property &aProperty, const IdentifierType &aBand = 0);
+
+        bool operator <(const Key &aKey) const;
+
+        Kind            mKind;        //!< The kind of entity.
+        IdentifierType  mIdentifier;  //!< The entity identifier.
+        Property        mProperty;    //!< The property.
+        IdentifierType  mBand;        //!< For kPropertyEqualizerBand, the band identifier.
+    };
+
+public:
+    CommandCoalescer(void);
+    ~CommandCoalescer(void);
+
+    HLX::Common::Status Init(const Duration &aResponseTimeout);
+
+    void                SetRollbackHandler(const RollbackHandler &aRollbackHandler);
+    void                SetCommandPipeline(CommandPipeline *aCommandPipeline);
+
+    // Commands
+
+    HLX::Common::Status Submit(const Key &aKey, const ValueType &aValue, const Setter &aSetter);
+    HLX::Common::Status Submit(const Key &aKey, const ValueType &aValue, const ValueType &aModelValue, const Setter &aSetter);
+    bool                IsInFlight(const Key &aKey) const;
+    HLX::Common::Status GetValue(const Key &aKey, ValueType &aValue) const;
+    void                Clear(void);
+
+    // Responses
+
+    void                StateDidChange(const HLX::Client::StateChange::NotificationBasis &aStateChangeNotification);
+    void                Service(void);
+
+private:
+    struct Entry
+    {
+        bool               mInFlight;
+        ValueType          mInFlightValue;
+        bool               mQueued;
+        Clock::time_point  mIssued;
+        bool               mPending;
+        ValueType          mPendingValue;
+        Setter             mSetter;
+    };
+
+    typedef std::map<Key, Entry> Entries;
+
+    HLX::Common::Status Submit(const Key &aKey, const ValueType &aValue, const ValueType *aModelValue, const Setter &aSetter);
+    HLX::Common::Status Issue(const Key &aKey, Entry &aEntry, const ValueType &aValue, const bool &aModelValueKnown);
+    HLX::Common::Status DidIssue(const Key &aKey, const ValueType &aValue, const HLX::Common::Status &aStatus);
+    void                Retire(const Key &aKey, const bool &aAnswered);
+    void                Retire(const Key &aKey, const ValueType &aValue);
+    void                Expire(const Clock::time_point &aNow);
+
+private:
+    Duration          mResponseTimeout;
+    Entries           mEntries;
+    RollbackHandler   mRollbackHandler;
+    CommandPipeline * mCommandPipeline;
+};
+
+#endif // COMMANDCOALESCER_HPP
@@ -0,0 +1,1047 @@
+/*
+ *    Copyright (c) 2026 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *  @file
+ *    This file implements an object for bounding the number of HLX
+ *    client controller requests the app has in flight at once and
+ *    for matching their responses back to them.
+ *
+ */
+
+#include "CommandPipeline.hpp"
+
+#include <algorithm>
+
+#include <errno.h>
+
+#include <LogUtilities/LogUtilities.hpp>
+
+#include <OpenHLX/Client/EqualizerPresetsStateChangeNotifications.hpp>
+#include <OpenHLX/Client/GroupsStateChangeNotifications.hpp>
+#include <OpenHLX/Client/SourcesStateChangeNotifications.hpp>
+#include <OpenHLX/Client/ZonesStateChangeNotifications.hpp>
+#include <OpenHLX/Utilities/Assert.hpp>
+
+
+using namespace HLX::Client;
+using namespace HLX::Common;
+using namespace Nuovations;
+
+
+const size_t CommandPipeline::kDepthMinimum;
+const size_t CommandPipeline::kDepthDefault;
+const size_t CommandPipeline::kDepthMaximum;
+
+// The default time after which an in-flight request that has not
+// been matched to a response is retired anyway.
+
+static const CommandPipeline::Duration kResponseTimeoutDefault(5000);
+
+// The time after which an in-flight request not expected to be
+// answered is retired, before there is a round trip time estimate
+// from which to derive it, and the least such time thereafter.
+
+static const CommandPipeline::Duration kOptionalResponseTimeoutInitial(1000);
+static const CommandPipeline::Duration kOptionalResponseTimeoutMinimum(250);
+
+// The initial, and least, AIMD window, in requests.
+
+static const double kWindowMinimum = 1.0;
+
+// The factor by which the AIMD window is decreased on a sign of
+// congestion.
+
+static const double kWindowDecreaseFactor = 0.5;
+
+// The gains and the variation multiplier for the round trip time
+// estimator, after those of TCP (see RFC 6298).
+
+static const int kRoundTripTimeGainShift          = 3;  // 1 / 8
+static const int kRoundTripTimeVariationGainShift = 2;  // 1 / 4
+static const int kRoundTripTimeVariationFactor    = 4;
+
+// The properties of which a query may be answered by more than one
+// state change, one for each equalizer band.
+
+static const CommandPipeline::Answers kAnswersRepeated = CommandPipeline::kAnswerEqualizerBand;
+
+/*
+ *  Return the property, as the command pipeline knows it, that a
+ *  state change is about.
+ */
+static CommandPipeline::Answers
+GetAnswer(const StateChange::Type &aType)
+{
+    CommandPipeline::Answers  lRetval;
+
+
+    switch (aType)
+    {
+
+    case StateChange::kStateChangeType_ZoneBalance:
+        lRetval = CommandPipeline::kAnswerBalance;
+        break;
+
+    case StateChange::kStateChangeType_EqualizerPresetBand:
+    case StateChange::kStateChangeType_ZoneEqualizerBand:
+        lRetval = CommandPipeline::kAnswerEqualizerBand;
+        break;
+
+    case StateChange::kStateChangeType_ZoneEqualizerPreset:
+        lRetval = CommandPipeline::kAnswerEqualizerPreset;
+        break;
+
+    case StateChange::kStateChangeType_ZoneHighpassCrossover:
+        lRetval = CommandPipeline::kAnswerHighpassCrossover;
+        break;
+
+    case StateChange::kStateChangeType_ZoneLowpassCrossover:
+        lRetval = CommandPipeline::kAnswerLowpassCrossover;
+        break;
+
+    case StateChange::kStateChangeType_GroupMute:
+    case StateChange::kStateChangeType_ZoneMute:
+        lRetval = CommandPipeline::kAnswerMute;
+        break;
+
+    case StateChange::kStateChangeType_EqualizerPresetName:
+    case StateChange::kStateChangeType_GroupName:
+    case StateChange::kStateChangeType_SourceName:
+    case StateChange::kStateChangeType_ZoneName:
+        lRetval = CommandPipeline::kAnswerName;
+        break;
+
+    case StateChange::kStateChangeType_ZoneSoundMode:
+        lRetval = CommandPipeline::kAnswerSoundMode;
+        break;
+
+    case StateChange::kStateChangeType_GroupSource:
+    case StateChange::kStateChangeType_ZoneSource:
+        lRetval = CommandPipeline::kAnswerSource;
+        break;
+
+    case StateChange::kStateChangeType_ZoneTone:
+        lRetval = CommandPipeline::kAnswerTone;
+        break;
+
+    case StateChange::kStateChangeType_GroupVolume:
+    case StateChange::kStateChangeType_ZoneVolume:
+        lRetval = CommandPipeline::kAnswerVolume;
+        break;
+
+    default:
+        lRetval = CommandPipeline::kAnswerNone;
+        break;
+
+    }
+
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    This is the class default constructor.
+ *
+ */
+CommandPipeline :: CommandPipeline(void) :
+    mDepth(kDepthDefault),
+    mResponseTimeout(kResponseTimeoutDefault),
+    mPending(),
+    mInFlight(),
+    mExpiries(),
+    mWindow(kWindowMinimum),
+    mHasRoundTripTime(false),
+    mSmoothedRoundTripTime(Clock::duration::zero()),
+    mRoundTripTimeVariation(Clock::duration::zero()),
+    mRecoveryEnd()
+{
+    return;
+}
+
+/**
+ *  @brief
+ *    This is the class destructor.
+ *
+ */
+CommandPipeline :: ~CommandPipeline(void)
+{
+    return;
+}
+
+/**
+ *  @brief
+ *    This is the class initializer.
+ *
+ *  @param[in]  aDepth            The maximum number of requests to
+ *                                have in flight at once.
+ *  @param[in]  aResponseTimeout  The time after which an in-flight
+ *                                request that has not been matched
+ *                                to a response is retired anyway.
+ *
+ *  @retval  kStatus_Success  If successful.
+ *  @retval  -ERANGE          If @a aDepth was out of range.
+ *
+ */
+Status
+CommandPipeline :: Init(const size_t &aDepth, const Duration &aResponseTimeout)
+{
+    Status  lRetval;
+
+
+    lRetval = SetDepth(aDepth);
+    nlREQUIRE_SUCCESS(lRetval, done);
+
+    mResponseTimeout = aResponseTimeout;
+
+ done:
+    return (lRetval);
+}
+
+// MARK: Configuration
+
+size_t
+CommandPipeline :: GetDepth(void) const
+{
+    return (mDepth);
+}
+
+/**
+ *  @brief
+ *    Set the maximum number of requests to have in flight at once.
+ *
+ *  Requests already in flight beyond a reduced depth are left to
+ *  complete; no further requests are issued until the number in
+ *  flight falls below the new depth. The AIMD window is capped at
+ *  the new depth.
+ *
+ *  @param[in]  aDepth  The maximum number of requests to have in
+ *                      flight at once.
+ *
+ *  @retval  kStatus_Success  If successful.
+ *  @retval  -ERANGE          If @a aDepth was out of range.
+ *
+ */
+Status
+CommandPipeline :: SetDepth(const size_t &aDepth)
+{
+    Status  lRetval = kStatus_Success;
+
+
+    nlREQUIRE_ACTION(aDepth >= kDepthMinimum, done, lRetval = -ERANGE);
+    nlREQUIRE_ACTION(aDepth <= kDepthMaximum, done, lRetval = -ERANGE);
+
+    mDepth = aDepth;
+
+    mWindow = std::min(mWindow, static_cast<double>(mDepth));
+
+    Issue();
+
+ done:
+    return (lRetval);
+}
+
+CommandPipeline::Duration
+CommandPipeline :: GetResponseTimeout(void) const
+{
+    return (mResponseTimeout);
+}
+
+/**
+ *  @brief
+ *    Set the time after which an in-flight request that has not been
+ *    matched to a response is retired anyway.
+ *
+ *  @param[in]  aResponseTimeout  The response timeout.
+ *
+ */
+void
+CommandPipeline :: SetResponseTimeout(const Duration &aResponseTimeout)
+{
+    mResponseTimeout = aResponseTimeout;
+}
+
+// MARK: Requests
+
+/**
+ *  @brief
+ *    Enqueue a user-initiated request, issuing it immediately if
+ *    there is room in the pipeline.
+ *
+ *  @param[in]  aKind        The kind of entity the request is about.
+ *  @param[in]  aIdentifier  The identifier of the entity the request
+ *                           is about.
+ *  @param[in]  aAnswers     The properties whose state changes answer
+ *                           the request.
+ *  @param[in]  aIssuer      The function that issues the request.
+ *
+ *  @retval  kStatus_Success  If successful.
+ *  @retval  -EINVAL          If @a aIssuer or @a aAnswers was empty.
+ *  @retval  -ERANGE          If @a aKind was invalid.
+ *
+ */
+Status
+CommandPipeline :: Enqueue(const Kind &aKind, const IdentifierType &aIdentifier, const Answers &aAnswers, const Issuer &aIssuer)
+{
+    return (Enqueue(aKind, aIdentifier, aAnswers, CommandScheduler::kLaneUser, aIssuer));
+}
+
+/**
+ *  @brief
+ *    Enqueue a request to the specified lane, issuing it immediately
+ *    if there is room in the pipeline.
+ *
+ *  @param[in]  aKind        The kind of entity the request is about.
+ *  @param[in]  aIdentifier  The identifier of the entity the request
+ *                           is about.
+ *  @param[in]  aAnswers     The properties whose state changes answer
+ *                           the request.
+ *  @param[in]  aLane        The command scheduler lane the request
+ *                           is to wait in.
+ *  @param[in]  aIssuer      The function that issues the request.
+ *
+ *  @retval  kStatus_Success  If successful.
+ *  @retval  -EINVAL          If @a aIssuer or @a aAnswers was empty.
+ *  @retval  -ERANGE          If @a aKind or @a aLane was invalid.
+ *
+ */
+Status
+CommandPipeline :: Enqueue(const Kind &aKind, const IdentifierType &aIdentifier, const Answers &aAnswers, const CommandScheduler::Lane &aLane, const Issuer &aIssuer)
+{
+    return (Enqueue(aKind, aIdentifier, aAnswers, aLane, kResponseExpected, aIssuer));
+}
+
+/**
+ *  @brief
+ *    Enqueue a request to the specified lane, issuing it immediately
+ *    if there is room in the pipeline.
+ *
+ *  A request not expected to be answered, such as a command that may
+ *  change nothing, or a query, for which the client controller
+ *  reports only the properties that differ from its model, is
+ *  retired when it times out without being taken as a sign of
+ *  congestion.
+ *
+ *  @param[in]  aKind        The kind of entity the request is about.
+ *  @param[in]  aIdentifier  The identifier of the entity the request
+ *                           is about.
+ *  @param[in]  aAnswers     The properties whose state changes answer
+ *                           the request; for a query, typically
+ *                           #kAnswerAll.
+ *  @param[in]  aLane        The command scheduler lane the request
+ *                           is to wait in.
+ *  @param[in]  aResponse    Whether the peer is expected to answer
+ *                           the request.
+ *  @param[in]  aIssuer      The function that issues the request.
+ *
+ *  @retval  kStatus_Success  If successful.
+ *  @retval  -EINVAL          If @a aIssuer or @a aAnswers was empty.
+ *  @retval  -ERANGE          If @a aKind, @a aLane, or @a aResponse
+ *                            was invalid.
+ *
+ */
+Status
+CommandPipeline :: Enqueue(const Kind &aKind, const IdentifierType &aIdentifier, const Answers &aAnswers, const CommandScheduler::Lane &aLane, const Response &aResponse, const Issuer &aIssuer)
+{
+    Request  lRequest;
+    Status   lRetval = kStatus_Success;
+
+
+    nlREQUIRE_ACTION(aKind < kKindMax, done, lRetval = -ERANGE);
+    nlREQUIRE_ACTION(aLane < CommandScheduler::kLaneMax, done, lRetval = -ERANGE);
+    nlREQUIRE_ACTION(aResponse < kResponseMax, done, lRetval = -ERANGE);
+    nlREQUIRE_ACTION((aAnswers & kAnswerAll) != kAnswerNone, done, lRetval = -EINVAL);
+    nlREQUIRE_ACTION(aIssuer != nullptr, done, lRetval = -EINVAL);
+
+    lRequest.mKind       = aKind;
+    lRequest.mIdentifier = aIdentifier;
+    lRequest.mAnswers    = (aAnswers & kAnswerAll);
+    lRequest.mLane       = aLane;
+    lRequest.mResponse   = aResponse;
+    lRequest.mIssuer     = aIssuer;
+    lRequest.mTaken      = kAnswerNone;
+    lRequest.mShadowed   = false;
+    lRequest.mSampled    = false;
+
+    mPending[aLane].push_back(lRequest);
+
+    Service();
+
+ done:
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Return whether a request enqueued now to the specified lane
+ *    would be issued immediately.
+ *
+ *  @param[in]  aLane  The command scheduler lane.
+ *
+ */
+bool
+CommandPipeline :: HasCapacity(const CommandScheduler::Lane &aLane) const
+{
+    size_t  lPending[CommandScheduler::kLaneMax];
+
+
+    GetPendingCounts(lPending);
+
+    return (CommandScheduler::HasCapacity(aLane, lPending, mInFlight.size(), GetWindow()));
+}
+
+size_t
+CommandPipeline :: GetPendingCount(void) const
+{
+    size_t  lRetval = 0;
+    int     lLane;
+
+
+    for (lLane = CommandScheduler::kLaneInteractive; lLane < CommandScheduler::kLaneMax; lLane++)
+    {
+        lRetval += mPending[lLane].size();
+    }
+
+    return (lRetval);
+}
+
+size_t
+CommandPipeline :: GetPendingCount(const CommandScheduler::Lane &aLane) const
+{
+    return ((aLane < CommandScheduler::kLaneMax) ? mPending[aLane].size() : 0);
+}
+
+size_t
+CommandPipeline :: GetInFlightCount(void) const
+{
+    return (mInFlight.size());
+}
+
+/**
+ *  @brief
+ *    Discard all pending and in-flight requests and reset the AIMD
+ *    window and round trip time estimate.
+ *
+ *  This is typically used when the client controller disconnects,
+ *  after which no in-flight request will be responded to and the
+ *  next peer may pace differently.
+ *
+ */
+void
+CommandPipeline :: Clear(void)
+{
+    int  lLane;
+
+
+    for (lLane = CommandScheduler::kLaneInteractive; lLane < CommandScheduler::kLaneMax; lLane++)
+    {
+        mPending[lLane].clear();
+    }
+
+    mInFlight.clear();
+    mExpiries.clear();
+
+    ResetWindow();
+}
+
+// MARK: Pacing
+
+/**
+ *  @brief
+ *    Return the number of requests that may currently be in flight
+ *    at once.
+ *
+ *  This is the whole part of the AIMD window, which is at least one
+ *  and at most the pipeline depth.
+ *
+ */
+size_t
+CommandPipeline :: GetWindow(void) const
+{
+    return (std::min(std::max(static_cast<size_t>(mWindow), kDepthMinimum), mDepth));
+}
+
+/**
+ *  @brief
+ *    Return the smoothed request and response round trip time, or
+ *    zero if no request has yet been answered.
+ *
+ */
+CommandPipeline::Duration
+CommandPipeline :: GetRoundTripTime(void) const
+{
+    return (std::chrono::duration_cast<Duration>(mSmoothedRoundTripTime));
+}
+
+// MARK: Responses
+
+/**
+ *  @brief
+ *    Observe a client controller state change, matching it to an
+ *    in-flight request, if any.
+ *
+ *  @param[in]  aStateChangeNotification  An immutable reference
+ *                                        to a notification
+ *                                        describing the state
+ *                                        change.
+ *
+ */
+void
+CommandPipeline :: StateDidChange(const StateChange::NotificationBasis &aStateChangeNotification)
+{
+    nlEXPECT(!mInFlight.empty(), done);
+
+    switch (aStateChangeNotification.GetType())
+    {
+
+    case StateChange::kStateChangeType_EqualizerPresetBand:
+    case StateChange::kStateChangeType_EqualizerPresetName:
+        {
+            const StateChange::EqualizerPresetsNotificationBasis &lSCN = static_cast<const StateChange::EqualizerPresetsNotificationBasis &>(aStateChangeNotification);
+
+            DidReceiveResponse(kKindEqualizerPreset, lSCN.GetIdentifier(), GetAnswer(aStateChangeNotification.GetType()));
+        }
+        break;
+
+    case StateChange::kStateChangeType_GroupMute:
+    case StateChange::kStateChangeType_GroupName:
+    case StateChange::kStateChangeType_GroupSource:
+    case StateChange::kStateChangeType_GroupVolume:
+        {
+            const StateChange::GroupsNotificationBasis &lSCN = static_cast<const StateChange::GroupsNotificationBasis &>(aStateChangeNotification);
+
+            DidReceiveResponse(kKindGroup, lSCN.GetIdentifier(), GetAnswer(aStateChangeNotification.GetType()));
+        }
+        break;
+
+    case StateChange::kStateChangeType_SourceName:
+        {
+            const StateChange::SourcesNameNotification &lSCN = static_cast<const StateChange::SourcesNameNotification &>(aStateChangeNotification);
+
+            DidReceiveResponse(kKindSource, lSCN.GetIdentifier(), GetAnswer(aStateChangeNotification.GetType()));
+        }
+        break;
+
+    case StateChange::kStateChangeType_ZoneBalance:
+    case StateChange::kStateChangeType_ZoneEqualizerBand:
+    case StateChange::kStateChangeType_ZoneEqualizerPreset:
+    case StateChange::kStateChangeType_ZoneHighpassCrossover:
+    case StateChange::kStateChangeType_ZoneLowpassCrossover:
+    case StateChange::kStateChangeType_ZoneMute:
+    case StateChange::kStateChangeType_ZoneName:
+    case StateChange::kStateChangeType_ZoneSoundMode:
+    case StateChange::kStateChangeType_ZoneSource:
+    case StateChange::kStateChangeType_ZoneTone:
+    case StateChange::kStateChangeType_ZoneVolume:
+        {
+            const StateChange::ZonesNotificationBasis &lSCN = static_cast<const StateChange::ZonesNotificationBasis &>(aStateChangeNotification);
+
+            DidReceiveResponse(kKindZone, lSCN.GetIdentifier(), GetAnswer(aStateChangeNotification.GetType()));
+        }
+        break;
+
+    default:
+        Service();
+        break;
+
+    }
+
+ done:
+    return;
+}
+
+/**
+ *  @brief
+ *    Match a response about the specified property of an entity to
+ *    the in-flight request it answers, if any, and issue pending
+ *    requests into any room that leaves in the pipeline.
+ *
+ *  @param[in]  aKind        An immutable reference to the kind of
+ *                           entity the response is about.
+ *  @param[in]  aIdentifier  An immutable reference to the identifier
+ *                           of the entity the response is about.
+ *  @param[in]  aAnswer      An immutable reference to the property
+ *                           the response is about.
+ *
+ */
+void
+CommandPipeline :: DidReceiveResponse(const Kind &aKind, const IdentifierType &aIdentifier, const Answers &aAnswer)
+{
+    Match(aKind, aIdentifier, aAnswer, Clock::now());
+
+    Service();
+}
+
+/**
+ *  @brief
+ *    Retire the oldest in-flight query about the specified entity as
+ *    answered in full, and issue pending requests into any room that
+ *    leaves in the pipeline.
+ *
+ *  This is for a caller that sees the end of the answer to a query,
+ *  such as one reading the peer's responses itself, rather than
+ *  leaving the query to go quiet. Requests for the entity issued
+ *  behind the query remain in flight; any state change the query
+ *  took was its own.
+ *
+ *  @param[in]  aKind        An immutable reference to the kind of
+ *                           entity the query is about.
+ *  @param[in]  aIdentifier  An immutable reference to the identifier
+ *                           of the entity the query is about.
+ *
+ */
+void
+CommandPipeline :: DidCompleteResponse(const Kind &aKind, const IdentifierType &aIdentifier)
+{
+    const Clock::time_point  lNow = Clock::now();
+    Requests::iterator       lRequest;
+    Requests::iterator       lLater;
+
+
+    lRequest = std::find_if(mInFlight.begin(),
+                            mInFlight.end(),
+                            [&aKind, &aIdentifier](const Request &aRequest) {
+                                return (IsAbout(aRequest, aKind, aIdentifier) && (aRequest.mResponse == kResponseQuery));
+                            });
+    nlEXPECT(lRequest != mInFlight.end(), done);
+
+    if (lRequest->mSampled)
+    {
+        DidRespond(lNow - lRequest->mIssued, lNow);
+    }
+
+    for (lLater = lRequest + 1; lLater != mInFlight.end(); lLater++)
+    {
+        if (IsAbout(*lLater, aKind, aIdentifier))
+        {
+            lLater->mShadowed = false;
+        }
+    }
+
+    mInFlight.erase(lRequest);
+
+ done:
+    Service();
+}
+
+/**
+ *  @brief
+ *    Retire any in-flight requests that have timed out and issue
+ *    pending requests into any room in the pipeline.
+ *
+ */
+void
+CommandPipeline :: Service(void)
+{
+    Expire(Clock::now());
+
+    Issue();
+}
+
+// MARK: Implementation
+
+/**
+ *  @brief
+ *    Return whether the specified request is about the specified
+ *    entity.
+ *
+ */
+bool
+CommandPipeline :: IsAbout(const Request &aRequest, const Kind &aKind, const IdentifierType &aIdentifier)
+{
+    return ((aRequest.mKind == aKind) && (aRequest.mIdentifier == aIdentifier));
+}
+
+/**
+ *  @brief
+ *    Match a response about the specified property of an entity to
+ *    the oldest in-flight request it answers, if any.
+ *
+ *  A request other than a query is retired; its round trip time is
+ *  measured unless its answer is ambiguous. A query takes the
+ *  response and stays in flight, marking any request for the entity
+ *  behind it that the response could have answered as shadowed.
+ *
+ *  @param[in]  aKind        An immutable reference to the kind of
+ *                           entity the response is about.
+ *  @param[in]  aIdentifier  An immutable reference to the identifier
+ *                           of the entity the response is about.
+ *  @param[in]  aAnswer      An immutable reference to the property
+ *                           the response is about.
+ *  @param[in]  aNow         The time at which the response arrived.
+ *
+ */
+void
+CommandPipeline :: Match(const Kind &aKind, const IdentifierType &aIdentifier, const Answers &aAnswer, const Clock::time_point &aNow)
+{
+    Requests::iterator  lRequest;
+    Requests::iterator  lLater;
+
+
+    lRequest = std::find_if(mInFlight.begin(),
+                            mInFlight.end(),
+                            [&aKind, &aIdentifier, &aAnswer](const Request &aRequest) {
+                                return (IsAbout(aRequest, aKind, aIdentifier) &&
+                                        ((aRequest.mAnswers & aAnswer) != kAnswerNone) &&
+                                        ((aRequest.mResponse != kResponseQuery) ||
+                                         ((aRequest.mTaken & aAnswer) == kAnswerNone) ||
+                                         ((aAnswer & kAnswersRepeated) != kAnswerNone)));
+                            });
+    nlEXPECT(lRequest != mInFlight.end(), done);
+
+    if (lRequest->mResponse == kResponseQuery)
+    {
+        lRequest->mTaken        |= aAnswer;
+        lRequest->mLastAnswered  = aNow;
+
+        // The response may instead have been the answer to a request
+        // for the same property issued behind the query, which cannot
+        // be told apart until the query is seen to end.
+
+        for (lLater = lRequest + 1; lLater != mInFlight.end(); lLater++)
+        {
+            if (IsAbout(*lLater, aKind, aIdentifier) && ((lLater->mAnswers & aAnswer) != kAnswerNone))
+            {
+                lLater->mShadowed = true;
+                lLater->mSampled  = false;
+            }
+        }
+    }
+    else
+    {
+        if (lRequest->mSampled)
+        {
+            DidRespond(aNow - lRequest->mIssued, aNow);
+        }
+
+        mInFlight.erase(lRequest);
+    }
+
+ done:
+    return;
+}
+
+void
+CommandPipeline :: Expire(const Clock::time_point &aNow)
+{
+    size_t  lIndex = 0;
+
+
+    mExpiries.erase(std::remove_if(mExpiries.begin(),
+                                   mExpiries.end(),
+                                   [&aNow](const Expiry &aExpiry) {
+                                       return (aNow >= aExpiry.mUntil);
+                                   }),
+                    mExpiries.end());
+
+    // Requests not expected to be answered time out sooner than
+    // those that are and a query times out from when it last took a
+    // response, so requests may not time out in the order they were
+    // issued; all must be checked.
+
+    while (lIndex < mInFlight.size())
+    {
+        const Request  lRequest = mInFlight[lIndex];
+
+        if ((aNow - lRequest.mLastAnswered) < GetTimeout(lRequest))
+        {
+            lIndex++;
+        }
+        else if (lRequest.mResponse == kResponseQuery)
+        {
+            // A query that has gone quiet is taken as answered in
+            // full. Any request for the entity behind it whose answer
+            // it may have taken is retired with it, rather than being
+            // left to time out as though unanswered.
+
+            mInFlight.erase(mInFlight.begin() + lIndex);
+
+            mInFlight.erase(std::remove_if(mInFlight.begin() + lIndex,
+                                           mInFlight.end(),
+                                           [&lRequest](const Request &aRequest) {
+                                               return (IsAbout(aRequest, lRequest.mKind, lRequest.mIdentifier) && aRequest.mShadowed);
+                                           }),
+                            mInFlight.end());
+        }
+        else
+        {
+            Log::Debug().Write("Request for kind %u identifier %u timed out.\n",
+                               lRequest.mKind,
+                               lRequest.mIdentifier);
+
+            mInFlight.erase(mInFlight.begin() + lIndex);
+
+            DidExpire(lRequest, aNow);
+
+            // A request the peer need not have answered is simply
+            // retired; its timing out says nothing of congestion.
+
+            if (lRequest.mResponse == kResponseExpected)
+            {
+                DidTimeOut(aNow);
+            }
+        }
+    }
+}
+
+/**
+ *  @brief
+ *    Note that a request timed out, such that no round trip time is
+ *    measured for a request that its late answer may be matched to.
+ *
+ *  @param[in]  aRequest  An immutable reference to the request that
+ *                        timed out.
+ *  @param[in]  aNow      The time at which it timed out.
+ *
+ */
+void
+CommandPipeline :: DidExpire(const Request &aRequest, const Clock::time_point &aNow)
+{
+    Expiry              lExpiry;
+    Requests::iterator  lRequest;
+
+
+    lExpiry.mKind       = aRequest.mKind;
+    lExpiry.mIdentifier = aRequest.mIdentifier;
+    lExpiry.mAnswers    = aRequest.mAnswers;
+    lExpiry.mUntil      = aNow + mResponseTimeout;
+
+    mExpiries.push_back(lExpiry);
+
+    for (lRequest = mInFlight.begin(); lRequest != mInFlight.end(); lRequest++)
+    {
+        if (IsAmbiguous(*lRequest))
+        {
+            lRequest->mSampled = false;
+        }
+    }
+}
+
+/**
+ *  @brief
+ *    Return whether a state change answering the specified request
+ *    may instead be the late answer to one that timed out.
+ *
+ *  @param[in]  aRequest  An immutable reference to the request.
+ *
+ */
+bool
+CommandPipeline :: IsAmbiguous(const Request &aRequest) const
+{
+    return (std::any_of(mExpiries.begin(),
+                        mExpiries.end(),
+                        [&aRequest](const Expiry &aExpiry) {
+                            return (IsAbout(aRequest, aExpiry.mKind, aExpiry.mIdentifier) &&
+                                    ((aRequest.mAnswers & aExpiry.mAnswers) != kAnswerNone));
+                        }));
+}
+
+/**
+ *  @brief
+ *    Return the time after which an in-flight request that has not
+ *    been matched to a response is retired anyway.
+ *
+ *  A request expected to be answered is given the response timeout.
+ *  One not expected to be answered, such as a command that changed
+ *  nothing, would otherwise hold its slot, and those waiting behind
+ *  it, for the full response timeout, too; it is instead given the
+ *  time by which an answer would have been taken as late, the
+ *  smoothed round trip time plus four times its variation, with a
+ *  floor, but no longer than the response timeout. A query is given
+ *  the same time from when it last took a response, such that it
+ *  stays in flight for as long as its answer keeps arriving.
+ *
+ *  @param[in]  aRequest  An immutable reference to the in-flight
+ *                        request.
+ *
+ */
+CommandPipeline::Clock::duration
+CommandPipeline :: GetTimeout(const Request &aRequest) const
+{
+    Clock::duration  lRetval = mResponseTimeout;
+
+
+    if (aRequest.mResponse != kResponseExpected)
+    {
+        if (mHasRoundTripTime)
+        {
+            lRetval = std::max(mSmoothedRoundTripTime + (mRoundTripTimeVariation * kRoundTripTimeVariationFactor),
+                               Clock::duration(kOptionalResponseTimeoutMinimum));
+        }
+        else
+        {
+            lRetval = kOptionalResponseTimeoutInitial;
+        }
+
+        lRetval = std::min(lRetval, Clock::duration(mResponseTimeout));
+    }
+
+    return (lRetval);
+}
+
+void
+CommandPipeline :: Issue(void)
+{
+    size_t                  lPending[CommandScheduler::kLaneMax];
+    CommandScheduler::Lane  lLane;
+    Status                  lStatus;
+
+
+    GetPendingCounts(lPending);
+
+    while ((lLane = CommandScheduler::Select(lPending, mInFlight.size(), GetWindow())) != CommandScheduler::kLaneMax)
+    {
+        Request lRequest = mPending[lLane].front();
+
+        mPending[lLane].pop_front();
+        lPending[lLane]--;
+
+        lStatus = lRequest.mIssuer();
+
+        // A request that could not be issued will not be responded
+        // to; drop it rather than letting it occupy a slot until it
+        // times out.
+
+        if (lStatus == kStatus_Success)
+        {
+            lRequest.mIssued       = Clock::now();
+            lRequest.mLastAnswered = lRequest.mIssued;
+            lRequest.mSampled      = !IsAmbiguous(lRequest);
+
+            mInFlight.push_back(lRequest);
+        }
+        else
+        {
+            Log::Error().Write("Could not issue %s request for kind %u identifier %u: %d\n",
+                               CommandScheduler::GetLaneName(lRequest.mLane),
+                               lRequest.mKind,
+                               lRequest.mIdentifier,
+                               lStatus);
+        }
+    }
+}
+
+void
+CommandPipeline :: GetPendingCounts(size_t aPending[CommandScheduler::kLaneMax]) const
+{
+    int  lLane;
+
+
+    for (lLane = CommandScheduler::kLaneInteractive; lLane < CommandScheduler::kLaneMax; lLane++)
+    {
+        aPending[lLane] = mPending[lLane].size();
+    }
+}
+
+/**
+ *  @brief
+ *    Update the round trip time estimate and the AIMD window for a
+ *    request that was answered.
+ *
+ *  An answer later than the smoothed round trip time plus four times
+ *  its variation is taken as a sign that the peer is falling behind
+ *  and the window is decreased; otherwise, the window is increased by
+ *  the reciprocal of its size, or by about one request for each
+ *  window of requests answered.
+ *
+ *  @param[in]  aRoundTripTime  The time from when the request was
+ *                              issued to when it was answered.
+ *  @param[in]  aNow            The time at which it was answered.
+ *
+ */
+void
+CommandPipeline :: DidRespond(const Clock::duration &aRoundTripTime, const Clock::time_point &aNow)
+{
+    if (!mHasRoundTripTime)
+    {
+        mSmoothedRoundTripTime  = aRoundTripTime;
+        mRoundTripTimeVariation = aRoundTripTime / 2;
+        mHasRoundTripTime       = true;
+
+        mWindow = std::min(mWindow + (1.0 / mWindow), static_cast<double>(mDepth));
+    }
+    else
+    {
+        const Clock::duration  lThreshold = mSmoothedRoundTripTime + (mRoundTripTimeVariation * kRoundTripTimeVariationFactor);
+        const Clock::duration  lError     = aRoundTripTime - mSmoothedRoundTripTime;
+
+        mRoundTripTimeVariation += ((((lError < Clock::duration::zero()) ? -lError : lError) - mRoundTripTimeVariation) / (1 << kRoundTripTimeVariationGainShift));
+        mSmoothedRoundTripTime  += (lError / (1 << kRoundTripTimeGainShift));
+
+        if (aRoundTripTime > lThreshold)
+        {
+            DecreaseWindow(aNow);
+        }
+        else
+        {
+            mWindow = std::min(mWindow + (1.0 / mWindow), static_cast<double>(mDepth));
+        }
+    }
+}
+
+/**
+ *  @brief
+ *    Update the AIMD window for a request, expected to be answered,
+ *    that timed out.
+ *
+ *  @param[in]  aNow  The time at which the request timed out.
+ *
+ */
+void
+CommandPipeline :: DidTimeOut(const Clock::time_point &aNow)
+{
+    DecreaseWindow(aNow);
+}
+
+/**
+ *  @brief
+ *    Multiplicatively decrease the AIMD window, at most once for
+ *    each round trip.
+ *
+ *  Requests already in flight when the window is decreased are
+ *  likely to answer late as well; without waiting out a round trip,
+ *  a single burst would collapse the window to its minimum.
+ *
+ *  @param[in]  aNow  The time of the sign of congestion.
+ *
+ */
+void
+CommandPipeline :: DecreaseWindow(const Clock::time_point &aNow)
+{
+    nlEXPECT(aNow >= mRecoveryEnd, done);
+
+    mWindow      = std::max(mWindow * kWindowDecreaseFactor, kWindowMinimum);
+    mRecoveryEnd = aNow + mSmoothedRoundTripTime;
+
+    Log::Debug().Write("Pipeline window decreased to %zu (srtt %lld ms).\n",
+                       GetWindow(),
+                       static_cast<long long>(GetRoundTripTime().count()));
+
+ done:
+    return;
+}
+
+void
+CommandPipeline :: ResetWindow(void)
+{
+    mWindow                 = kWindowMinimum;
+    mHasRoundTripTime       = false;
+    mSmoothedRoundTripTime  = Clock::duration::zero();
+    mRoundTripTimeVariation = Clock::duration::zero();
+    mRecoveryEnd            = Clock::time_point();
+}
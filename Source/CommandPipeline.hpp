@@ -0,0 +1,288 @@
+/*
+ *    Copyright (c) 2026 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *  @file
+ *    This file defines an object for bounding the number of HLX
+ *    client controller requests the app has in flight at once and
+ *    for matching their responses back to them.
+ *
+ */
+
+#ifndef COMMANDPIPELINE_HPP
+#define COMMANDPIPELINE_HPP
+
+#include <chrono>
+#include <deque>
+#include <functional>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <OpenHLX/Client/ApplicationControllerDelegate.hpp>
+#include <OpenHLX/Common/Errors.hpp>
+#include <OpenHLX/Model/IdentifierModel.hpp>
+
+#include "CommandScheduler.hpp"
+
+
+/**
+ *  @brief
+ *    An object for pipelining HLX client controller requests.
+ *
+ *  Requests are enqueued along with the kind and identifier of the
+ *  group, source, or zone they are about, the command scheduler lane
+ *  they wait in, and a function that issues them. Up to the pipeline
+ *  depth of requests are issued and in flight at once; the remainder
+ *  wait, in order within their lane, for a slot, which the command
+ *  scheduler gives to the highest priority lane first. Interactive
+ *  requests may exceed the depth by one, such that one need never
+ *  wait on a pipeline full of background queries.
+ *
+ *  Each request is enqueued with the properties whose state changes
+ *  answer it, such as the volume for a volume set. A state change
+ *  from the client controller is matched to the oldest in-flight
+ *  request for the same kind and identifier that it answers, in
+ *  keeping with the in-order responses of HLX peers, and never to
+ *  one it does not answer; one that answers no request in flight,
+ *  such as a change made by another controller, is ignored.
+ *
+ *  A query is answered by the HLX in full; however, the client
+ *  controller reports a state change only for each property that
+ *  differs from its model, which may be none, and nothing at the
+ *  end of the answer. A query is thus its own unit: it takes each
+ *  state change about its entity that it may still be answered
+ *  by, at most one for each property, but for equalizer bands, and
+ *  stays in flight until its answer goes quiet for the time by which
+ *  an answer would have been taken as late or, where the caller
+ *  sees the end of the answer, until that is reported. A request for
+ *  the same entity issued behind a query, whose own answer the
+ *  query may have taken, is retired along with a query that goes
+ *  quiet.
+ *
+ *  Since the client controller reports no state change for a command
+ *  that changes nothing, a request not matched within the response
+ *  timeout is retired anyway, the next time the pipeline is serviced.
+ *  Commands are enqueued as either expected to be answered, such as
+ *  a command known to change state, or not, such as a command that
+ *  may change nothing; only the former are taken as lost, and as a
+ *  sign of congestion, when they time out. The latter are instead
+ *  retired once an answer would have been late, going by the
+ *  measured round trip time, rather than only at the response
+ *  timeout.
+ *
+ *  A depth of one is strict one-at-a-time request and response, as
+ *  suits HLX hardware with its character-at-a-time I/O. Greater
+ *  depths suit a line-buffered proxy peer, where a request and
+ *  response round trip, rather than the peer itself, dominates.
+ *
+ *  The depth is a ceiling rather than a fixed number of requests in
+ *  flight. The pipeline measures the round trip time of each request
+ *  it matches to a complete answer, from when it is issued to when
+ *  it is answered, and paces requests with an additive-increase,
+ *  multiplicative-decrease (AIMD) window: starting from one, the
+ *  window grows by about one request for each window of requests
+ *  answered and is halved when a request expected to be answered
+ *  times out or is answered well behind the smoothed round trip
+ *  time, at most once for each round trip, as a peer whose input
+ *  buffer is filling answers late before it answers out of order or
+ *  not at all. Bursts of requests thus settle at the most the peer
+ *  sustains without being overrun.
+ *
+ *  After Karn, no round trip time is measured for a request whose
+ *  answer is ambiguous: a query that went quiet, rather than being
+ *  seen to end, a request whose answer a query ahead of it may have
+ *  taken, or a request for the same properties of an entity as one
+ *  that timed out recently, whose late answer it may be matched to.
+ *  The pipeline itself never reissues a request.
+ *
+ */
+class CommandPipeline
+{
+public:
+    /**
+     *  The kind of entity a request is about.
+     *
+     */
+    enum Kind
+    {
+        kKindEqualizerPreset = 0, //!< An equalizer preset.
+        kKindGroup,               //!< A group.
+        kKindSource,              //!< A source.
+        kKindZone,                //!< A zone.
+
+        kKindMax
+    };
+
+    /**
+     *  How the client controller is expected to report the answer to
+     *  a request.
+     *
+     */
+    enum Response
+    {
+        kResponseExpected = 0, //!< A command known to change state,
+                               //!< reported as one state change.
+        kResponseOptional,     //!< A command that may change nothing,
+                               //!< reported as one state change only
+                               //!< if state changed.
+        kResponseQuery,        //!< A query, reported as a state change
+                               //!< for each property that differed
+                               //!< from the model, if any.
+
+        kResponseMax
+    };
+
+    /**
+     *  The properties whose state changes answer a request.
+     *
+     */
+    enum : uint32_t
+    {
+        kAnswerNone              = 0,
+
+        kAnswerBalance           = 1 << 0,  //!< Zone balance.
+        kAnswerEqualizerBand     = 1 << 1,  //!< Equalizer preset or zone
+                                            //!< equalizer band.
+        kAnswerEqualizerPreset   = 1 << 2,  //!< Zone equalizer preset.
+        kAnswerHighpassCrossover = 1 << 3,  //!< Zone highpass crossover.
+        kAnswerLowpassCrossover  = 1 << 4,  //!< Zone lowpass crossover.
+        kAnswerMute              = 1 << 5,  //!< Group or zone mute.
+        kAnswerName              = 1 << 6,  //!< Name.
+        kAnswerSoundMode         = 1 << 7,  //!< Zone sound mode.
+        kAnswerSource            = 1 << 8,  //!< Group or zone source.
+        kAnswerTone              = 1 << 9,  //!< Zone bass and treble.
+        kAnswerVolume            = 1 << 10, //!< Group or zone volume.
+
+        kAnswerAll               = (1 << 11) - 1 //!< Any property, as
+                                                 //!< for a query.
+    };
+
+    typedef uint32_t Answers;
+
+    typedef HLX::Model::IdentifierModel::IdentifierType IdentifierType;
+
+    /**
+     *  A function that issues a request to the client controller.
+     *
+     */
+    typedef std::function<HLX::Common::Status (void)> Issuer;
+
+    typedef std::chrono::steady_clock Clock;
+    typedef std::chrono::milliseconds Duration;
+
+    static const size_t kDepthMinimum = 1;  //!< Strict request / response.
+    static const size_t kDepthDefault = 2;
+    static const size_t kDepthMaximum = 16;
+
+public:
+    CommandPipeline(void);
+    ~CommandPipeline(void);
+
+    HLX::Common::Status Init(const size_t &aDepth, const Duration &aResponseTimeout);
+
+    // Configuration
+
+    size_t              GetDepth(void) const;
+    HLX::Common::Status SetDepth(const size_t &aDepth);
+    Duration            GetResponseTimeout(void) const;
+    void                SetResponseTimeout(const Duration &aResponseTimeout);
+
+    // Requests
+
+    HLX::Common::Status Enqueue(const Kind &aKind, const IdentifierType &aIdentifier, const Answers &aAnswers, const Issuer &aIssuer);
+    HLX::Common::Status Enqueue(const Kind &aKind, const IdentifierType &aIdentifier, const Answers &aAnswers, const CommandScheduler::Lane &aLane, const Issuer &aIssuer);
+    HLX::Common::Status Enqueue(const Kind &aKind, const IdentifierType &aIdentifier, const Answers &aAnswers, const CommandScheduler::Lane &aLane, const Response &aResponse, const Issuer &aIssuer);
+    bool                HasCapacity(const CommandScheduler::Lane &aLane) const;
+    size_t              GetPendingCount(void) const;
+    size_t              GetPendingCount(const CommandScheduler::Lane &aLane) const;
+    size_t              GetInFlightCount(void) const;
+    void                Clear(void);
+
+    // Pacing
+
+    size_t              GetWindow(void) const;
+    Duration            GetRoundTripTime(void) const;
+
+    // Responses
+
+    void                StateDidChange(const HLX::Client::StateChange::NotificationBasis &aStateChangeNotification);
+    void                DidReceiveResponse(const Kind &aKind, const IdentifierType &aIdentifier, const Answers &aAnswer);
+    void                DidCompleteResponse(const Kind &aKind, const IdentifierType &aIdentifier);
+    void                Service(void);
+
+private:
+    struct Request
+    {
+        Kind                    mKind;
+        IdentifierType          mIdentifier;
+        Answers                 mAnswers;
+        CommandScheduler::Lane  mLane;
+        Response                mResponse;
+        Issuer                  mIssuer;
+        Clock::time_point       mIssued;
+        Clock::time_point       mLastAnswered; //!< For a query, when it last took a state change.
+        Answers                 mTaken;        //!< For a query, the properties it has taken.
+        bool                    mShadowed;     //!< Whether a query ahead of it may have taken its answer.
+        bool                    mSampled;      //!< Whether its round trip time may be measured.
+    };
+
+    /**
+     *  The properties of an entity for which a request timed out
+     *  and until when a state change for them may be its late answer.
+     *
+     */
+    struct Expiry
+    {
+        Kind                    mKind;
+        IdentifierType          mIdentifier;
+        Answers                 mAnswers;
+        Clock::time_point       mUntil;
+    };
+
+    typedef std::deque<Request> Requests;
+    typedef std::deque<Expiry>  Expiries;
+
+    static bool IsAbout(const Request &aRequest, const Kind &aKind, const IdentifierType &aIdentifier);
+
+    void Match(const Kind &aKind, const IdentifierType &aIdentifier, const Answers &aAnswer, const Clock::time_point &aNow);
+    void Expire(const Clock::time_point &aNow);
+    void DidExpire(const Request &aRequest, const Clock::time_point &aNow);
+    bool IsAmbiguous(const Request &aRequest) const;
+    Clock::duration GetTimeout(const Request &aRequest) const;
+    void Issue(void);
+    void GetPendingCounts(size_t aPending[CommandScheduler::kLaneMax]) const;
+    void DidRespond(const Clock::duration &aRoundTripTime, const Clock::time_point &aNow);
+    void DidTimeOut(const Clock::time_point &aNow);
+    void DecreaseWindow(const Clock::time_point &aNow);
+    void ResetWindow(void);
+
+private:
+    size_t              mDepth;
+    Duration            mResponseTimeout;
+    Requests            mPending[CommandScheduler::kLaneMax];
+    Requests            mInFlight;
+    Expiries            mExpiries;
+    double              mWindow;
+    bool                mHasRoundTripTime;
+    Clock::duration     mSmoothedRoundTripTime;
+    Clock::duration     mRoundTripTimeVariation;
+    Clock::time_point   mRecoveryEnd;
+};
+
+#endif // COMMANDPIPELINE_HPP
@@ -0,0 +1,664 @@
+/*
+ *    Copyright (c) 2026 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *  @file
+ *    This file implements an object for planning the HLX commands
+ *    that move a set of zones from their current to their target
+ *    state in the fewest bytes on the wire.
+ *
+ */
+
+#include "CommandPlanner.hpp"
+
+#include <algorithm>
+#include <map>
+#include <set>
+
+#include <stdarg.h>
+#include <stdio.h>
+
+
+// The length of a formatted protocol frame.
+
+static size_t
+FrameLength(const char *aFormat, ...)
+{
+    va_list  lArguments;
+    int      lLength;
+
+
+    va_start(lArguments, aFormat);
+
+    lLength = vsnprintf(nullptr, 0, aFormat, lArguments);
+
+    va_end(lArguments);
+
+    return ((lLength > 0) ? static_cast<size_t>(lLength) : 0);
+}
+
+// The order in which a command is to be issued: mutes first, unmutes
+// last, and all else in between.
+
+static int
+CommandPhase(const CommandPlanner::Command &aCommand)
+{
+    int  lRetval = 1;
+
+
+    if (aCommand.mProperty == CommandPlanner::kPropertyMute)
+    {
+        lRetval = ((aCommand.mValue != 0) ? 0 : 2);
+    }
+
+    return (lRetval);
+}
+
+static bool
+CommandPhaseLess(const CommandPlanner::Command &aFirst, const CommandPlanner::Command &aSecond)
+{
+    return (CommandPhase(aFirst) < CommandPhase(aSecond));
+}
+
+// MARK: Cost Model
+
+const size_t CommandPlanner::CostModel::kResponseTerminatorLengthDefault;
+
+/**
+ *  @brief
+ *    This is the class default constructor.
+ *
+ */
+CommandPlanner :: CostModel :: CostModel(void) :
+    mResponseTerminatorLength(kResponseTerminatorLengthDefault),
+    mGroupEchoesZones(true)
+{
+    return;
+}
+
+/**
+ *  @brief
+ *    This is the class destructor.
+ *
+ */
+CommandPlanner :: CostModel :: ~CostModel(void)
+{
+    return;
+}
+
+/**
+ *  @brief
+ *    This is the class initializer.
+ *
+ *  @param[in]  aResponseTerminatorLength  The length, in bytes, of
+ *                                         the line terminator of each
+ *                                         response.
+ *  @param[in]  aGroupEchoesZones          Whether a group command
+ *                                         is answered with a response
+ *                                         for each of its zones, as
+ *                                         well as for the group.
+ *
+ */
+void
+CommandPlanner :: CostModel :: Init(const size_t &aResponseTerminatorLength, const bool &aGroupEchoesZones)
+{
+    mResponseTerminatorLength = aResponseTerminatorLength;
+    mGroupEchoesZones         = aGroupEchoesZones;
+}
+
+/**
+ *  @brief
+ *    Return the cost, in bytes, of a command request and its
+ *    response.
+ *
+ *  @param[in]  aKind        The kind of entity the command is about.
+ *  @param[in]  aIdentifier  The identifier of the entity the command
+ *                           is about.
+ *  @param[in]  aProperty    The property the command sets.
+ *  @param[in]  aEncoding    How the command encodes its value.
+ *  @param[in]  aValue       The value the property holds once the
+ *                           command is answered.
+ *  @param[in]  aZones       For a group command, the zones in the
+ *                           group; otherwise, ignored.
+ *
+ *  @returns
+ *    The cost, in bytes, of the command request and its response.
+ *
+ */
+size_t
+CommandPlanner :: CostModel :: GetCost(const Kind &aKind,
+                                       const IdentifierType &aIdentifier,
+                                       const Property &aProperty,
+                                       const Encoding &aEncoding,
+                                       const ValueType &aValue,
+                                       const Identifiers &aZones) const
+{
+    const bool                   lIsGroup = (aKind == kKindGroup);
+    const char                   lEntity = (lIsGroup ? 'G' : 'O');
+    const unsigned int           lIdentifier = aIdentifier;
+    const int                    lValue = aValue;
+    const char                   lStep = ((aEncoding == kEncodingIncrease) ? 'U' : 'D');
+    Identifiers::const_iterator  lZone;
+    size_t                       lRetval = 0;
+
+
+    // The request
+
+    switch (aProperty)
+    {
+
+    case kPropertyVolume:
+        lRetval = ((aEncoding == kEncodingSet) ?
+                   FrameLength("[V%c%uR%d]", lEntity, lIdentifier, lValue) :
+                   FrameLength("[V%c%u%c]", lEntity, lIdentifier, lStep));
+        break;
+
+    case kPropertyMute:
+        lRetval = FrameLength("[V%sM%c%u]", ((lValue != 0) ? "" : "U"), lEntity, lIdentifier);
+        break;
+
+    case kPropertySource:
+        lRetval = FrameLength("[C%c%uI%d]", lEntity, lIdentifier, lValue);
+        break;
+
+    case kPropertyBass:
+    case kPropertyTreble:
+        {
+            const char lBand = ((aProperty == kPropertyBass) ? 'B' : 'T');
+
+            lRetval = ((aEncoding == kEncodingSet) ?
+                       FrameLength("[TO%u%c%d]", lIdentifier, lBand, lValue) :
+                       FrameLength("[TO%u%c%c]", lIdentifier, lBand, lStep));
+        }
+        break;
+
+    default:
+        break;
+
+    }
+
+    // The response or responses
+
+    lRetval += GetResponseCost(aKind, aIdentifier, aProperty, aValue);
+
+    if (lIsGroup && mGroupEchoesZones)
+    {
+        for (lZone = aZones.begin(); lZone != aZones.end(); lZone++)
+        {
+            lRetval += GetResponseCost(kKindZone, *lZone, aProperty, aValue);
+        }
+    }
+
+    return (lRetval);
+}
+
+size_t
+CommandPlanner :: CostModel :: GetResponseCost(const Kind &aKind,
+                                               const IdentifierType &aIdentifier,
+                                               const Property &aProperty,
+                                               const ValueType &aValue) const
+{
+    const char          lEntity = ((aKind == kKindGroup) ? 'G' : 'O');
+    const unsigned int  lIdentifier = aIdentifier;
+    const int           lValue = aValue;
+    size_t              lRetval = 0;
+
+
+    switch (aProperty)
+    {
+
+    case kPropertyVolume:
+        lRetval = FrameLength("(V%c%uR%d)", lEntity, lIdentifier, lValue);
+        break;
+
+    case kPropertyMute:
+        lRetval = FrameLength("(V%sM%c%u)", ((lValue != 0) ? "" : "U"), lEntity, lIdentifier);
+        break;
+
+    case kPropertySource:
+        lRetval = FrameLength("(C%c%uI%d)", lEntity, lIdentifier, lValue);
+        break;
+
+    case kPropertyBass:
+    case kPropertyTreble:
+        // A tone response carries both the bass and treble levels;
+        // the level not being set is assumed to be as wide as the
+        // one being set.
+
+        lRetval = FrameLength("(TO%uB%dT%d)", lIdentifier, lValue, lValue);
+        break;
+
+    default:
+        break;
+
+    }
+
+    lRetval += mResponseTerminatorLength;
+
+    return (lRetval);
+}
+
+// MARK: Planner
+
+/**
+ *  @brief
+ *    This is the class default constructor.
+ *
+ */
+CommandPlanner :: CommandPlanner(void) :
+    mCostModel()
+{
+    return;
+}
+
+/**
+ *  @brief
+ *    This is the class destructor.
+ *
+ */
+CommandPlanner :: ~CommandPlanner(void)
+{
+    return;
+}
+
+/**
+ *  @brief
+ *    This is the class initializer.
+ *
+ *  @param[in]  aCostModel  The cost model by which to plan.
+ *
+ */
+void
+CommandPlanner :: Init(const CostModel &aCostModel)
+{
+    mCostModel = aCostModel;
+}
+
+const CommandPlanner::CostModel &
+CommandPlanner :: GetCostModel(void) const
+{
+    return (mCostModel);
+}
+
+/**
+ *  @brief
+ *    Return whether a change is not already at its target value.
+ *
+ */
+bool
+CommandPlanner :: NeedsChange(const Change &aChange)
+{
+    return (!aChange.mHasCurrent || (aChange.mCurrent != aChange.mTarget));
+}
+
+/**
+ *  @brief
+ *    Return whether a property may be set by a group command.
+ *
+ */
+bool
+CommandPlanner :: IsGroupable(const Property &aProperty)
+{
+    return ((aProperty == kPropertyVolume) ||
+            (aProperty == kPropertyMute)   ||
+            (aProperty == kPropertySource));
+}
+
+/**
+ *  @brief
+ *    Return whether a property may be stepped by relative increase
+ *    and decrease commands.
+ *
+ */
+bool
+CommandPlanner :: IsRelative(const Property &aProperty)
+{
+    return ((aProperty == kPropertyVolume) ||
+            (aProperty == kPropertyBass)   ||
+            (aProperty == kPropertyTreble));
+}
+
+/**
+ *  @brief
+ *    Plan the least costly commands that move the zones from their
+ *    current to their target values.
+ *
+ *  @param[in]   aChanges   The changes, including those already at
+ *                          their target value, to plan commands for.
+ *  @param[in]   aGroups    The groups, and the zones in each, that
+ *                          may be commanded in place of their zones.
+ *  @param[out]  aCommands  The planned commands, in the order they
+ *                          are to be issued.
+ *
+ *  @returns
+ *    The total cost, in bytes, of the planned commands.
+ *
+ */
+size_t
+CommandPlanner :: Plan(const Changes &aChanges, const Groups &aGroups, Commands &aCommands) const
+{
+    const Identifiers  lNoZones;
+    size_t             lRetval = 0;
+
+
+    aCommands.clear();
+
+    for (int lProperty = kPropertyVolume; lProperty < kPropertyMax; lProperty++)
+    {
+        ChangePointers            lChanges;
+        Changes::const_iterator   lChange;
+        ChangePointers::iterator  lRemaining;
+
+        for (lChange = aChanges.begin(); lChange != aChanges.end(); lChange++)
+        {
+            if (lChange->mProperty == lProperty)
+            {
+                lChanges.push_back(&*lChange);
+            }
+        }
+
+        if (IsGroupable(static_cast<Property>(lProperty)))
+        {
+            lRetval += PlanGroups(static_cast<Property>(lProperty), lChanges, aGroups, aCommands);
+        }
+
+        for (lRemaining = lChanges.begin(); lRemaining != lChanges.end(); lRemaining++)
+        {
+            const Change &lRemainingChange = **lRemaining;
+
+            if (NeedsChange(lRemainingChange))
+            {
+                lRetval += PlanOne(kKindZone,
+                                   lRemainingChange.mZone,
+                                   lRemainingChange.mProperty,
+                                   lRemainingChange.mHasCurrent,
+                                   lRemainingChange.mCurrent,
+                                   lRemainingChange.mTarget,
+                                   lNoZones,
+                                   &aCommands);
+            }
+        }
+    }
+
+    std::stable_sort(aCommands.begin(), aCommands.end(), CommandPhaseLess);
+
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Return the cost, in bytes, of an absolute set for each zone
+ *    property not already at its target value.
+ *
+ *  This is the cost of the changes without planning, against which
+ *  the cost of a plan may be compared.
+ *
+ *  @param[in]  aChanges  The changes to cost.
+ *
+ *  @returns
+ *    The total cost, in bytes, of the absolute sets.
+ *
+ */
+size_t
+CommandPlanner :: GetAbsoluteCost(const Changes &aChanges) const
+{
+    const Identifiers        lNoZones;
+    Changes::const_iterator  lChange;
+    size_t                   lRetval = 0;
+
+
+    for (lChange = aChanges.begin(); lChange != aChanges.end(); lChange++)
+    {
+        if (NeedsChange(*lChange))
+        {
+            lRetval += mCostModel.GetCost(kKindZone,
+                                          lChange->mZone,
+                                          lChange->mProperty,
+                                          kEncodingSet,
+                                          lChange->mTarget,
+                                          lNoZones);
+        }
+    }
+
+    return (lRetval);
+}
+
+// MARK: Implementation
+
+/*
+ *  Plan group commands for the property, in place of zone commands,
+ *  wherever that costs less, removing the changes each covers.
+ *
+ *  A group is a candidate where each of its zones has a change to
+ *  the same target value and at least one of them needs it. Groups
+ *  may share zones; the candidate that saves the most is taken first
+ *  and the others reconsidered without the zones it covered.
+ */
+size_t
+CommandPlanner :: PlanGroups(const Property &aProperty,
+                             ChangePointers &aChanges,
+                             const Groups &aGroups,
+                             Commands &aCommands) const
+{
+    const Identifiers  lNoZones;
+    bool               lPlanned = true;
+    size_t             lRetval = 0;
+
+
+    while (lPlanned)
+    {
+        std::map<IdentifierType, const Change *>  lByZone;
+        ChangePointers::const_iterator            lChange;
+        Groups::const_iterator                    lGroup;
+        Groups::const_iterator                    lBestGroup = aGroups.end();
+        const Change *                            lBestFirst = nullptr;
+        bool                                      lBestCurrentShared = false;
+        size_t                                    lBestSaving = 0;
+
+        lPlanned = false;
+
+        for (lChange = aChanges.begin(); lChange != aChanges.end(); lChange++)
+        {
+            lByZone[(*lChange)->mZone] = *lChange;
+        }
+
+        for (lGroup = aGroups.begin(); lGroup != aGroups.end(); lGroup++)
+        {
+            Identifiers::const_iterator  lZone;
+            const Change *               lFirst = nullptr;
+            bool                         lEligible = !lGroup->mZones.empty();
+            bool                         lNeeded = false;
+            bool                         lCurrentShared = true;
+            size_t                       lZonesCost = 0;
+
+            for (lZone = lGroup->mZones.begin(); lEligible && (lZone != lGroup->mZones.end()); lZone++)
+            {
+                std::map<IdentifierType, const Change *>::const_iterator lFound = lByZone.find(*lZone);
+
+                if (lFound == lByZone.end())
+                {
+                    lEligible = false;
+                }
+                else
+                {
+                    const Change &lZoneChange = *lFound->second;
+
+                    if (lFirst == nullptr)
+                    {
+                        lFirst = &lZoneChange;
+                    }
+
+                    lEligible      = (lZoneChange.mTarget == lFirst->mTarget);
+                    lCurrentShared = (lCurrentShared &&
+                                      lZoneChange.mHasCurrent &&
+                                      (lZoneChange.mCurrent == lFirst->mCurrent));
+
+                    if (NeedsChange(lZoneChange))
+                    {
+                        lNeeded = true;
+
+                        lZonesCost += PlanOne(kKindZone,
+                                              lZoneChange.mZone,
+                                              aProperty,
+                                              lZoneChange.mHasCurrent,
+                                              lZoneChange.mCurrent,
+                                              lZoneChange.mTarget,
+                                              lNoZones,
+                                              nullptr);
+                    }
+                }
+            }
+
+            if (lEligible && lNeeded)
+            {
+                // Relative group steps are only considered where every
+                // zone in the group shares the same current value.
+
+                const size_t lGroupCost = PlanOne(kKindGroup,
+                                                  lGroup->mIdentifier,
+                                                  aProperty,
+                                                  lCurrentShared,
+                                                  lFirst->mCurrent,
+                                                  lFirst->mTarget,
+                                                  lGroup->mZones,
+                                                  nullptr);
+
+                if ((lGroupCost < lZonesCost) && ((lZonesCost - lGroupCost) > lBestSaving))
+                {
+                    lBestGroup         = lGroup;
+                    lBestFirst         = lFirst;
+                    lBestCurrentShared = lCurrentShared;
+                    lBestSaving        = lZonesCost - lGroupCost;
+                }
+            }
+        }
+
+        if (lBestGroup != aGroups.end())
+        {
+            const std::set<IdentifierType>  lCovered(lBestGroup->mZones.begin(), lBestGroup->mZones.end());
+            ChangePointers::iterator        lRemaining;
+
+            lRetval += PlanOne(kKindGroup,
+                               lBestGroup->mIdentifier,
+                               aProperty,
+                               lBestCurrentShared,
+                               lBestFirst->mCurrent,
+                               lBestFirst->mTarget,
+                               lBestGroup->mZones,
+                               &aCommands);
+
+            lRemaining = aChanges.begin();
+
+            while (lRemaining != aChanges.end())
+            {
+                if (lCovered.count((*lRemaining)->mZone) != 0)
+                {
+                    lRemaining = aChanges.erase(lRemaining);
+                }
+                else
+                {
+                    lRemaining++;
+                }
+            }
+
+            lPlanned = true;
+        }
+    }
+
+    return (lRetval);
+}
+
+/*
+ *  Plan the least costly encoding that moves one property of one
+ *  group or zone to its target value, returning its cost and, if
+ *  aCommands is non-null, appending its commands.
+ */
+size_t
+CommandPlanner :: PlanOne(const Kind &aKind,
+                          const IdentifierType &aIdentifier,
+                          const Property &aProperty,
+                          const bool &aHasCurrent,
+                          const ValueType &aCurrent,
+                          const ValueType &aTarget,
+                          const Identifiers &aZones,
+                          Commands *aCommands) const
+{
+    const size_t  lSetCost = mCostModel.GetCost(aKind, aIdentifier, aProperty, kEncodingSet, aTarget, aZones);
+    size_t        lStepCost = 0;
+    bool          lStep = false;
+    Encoding      lStepEncoding = kEncodingIncrease;
+    ValueType     lValue;
+    Command       lCommand;
+    size_t        lRetval = lSetCost;
+
+
+    if (IsRelative(aProperty) && aHasCurrent && (aCurrent != aTarget))
+    {
+        lStepEncoding = ((aTarget > aCurrent) ? kEncodingIncrease : kEncodingDecrease);
+
+        // Step only while doing so remains cheaper than the set.
+
+        lValue = aCurrent;
+
+        while ((lValue != aTarget) && (lStepCost < lSetCost))
+        {
+            lValue    += ((lStepEncoding == kEncodingIncrease) ? 1 : -1);
+            lStepCost += mCostModel.GetCost(aKind, aIdentifier, aProperty, lStepEncoding, lValue, aZones);
+        }
+
+        lStep = ((lValue == aTarget) && (lStepCost < lSetCost));
+    }
+
+    if (lStep)
+    {
+        lRetval = lStepCost;
+    }
+
+    if (aCommands != nullptr)
+    {
+        lCommand.mKind       = aKind;
+        lCommand.mIdentifier = aIdentifier;
+        lCommand.mProperty   = aProperty;
+
+        if (lStep)
+        {
+            lValue = aCurrent;
+
+            while (lValue != aTarget)
+            {
+                lValue += ((lStepEncoding == kEncodingIncrease) ? 1 : -1);
+
+                lCommand.mEncoding = lStepEncoding;
+                lCommand.mValue    = lValue;
+                lCommand.mCost     = mCostModel.GetCost(aKind, aIdentifier, aProperty, lStepEncoding, lValue, aZones);
+
+                aCommands->push_back(lCommand);
+            }
+        }
+        else
+        {
+            lCommand.mEncoding = kEncodingSet;
+            lCommand.mValue    = aTarget;
+            lCommand.mCost     = lSetCost;
+
+            aCommands->push_back(lCommand);
+        }
+    }
+
+    return (lRetval);
+}
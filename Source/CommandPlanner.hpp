@@ -0,0 +1,244 @@
+/*
+ *    Copyright (c) 2026 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *  @file
+ *    This file defines an object for planning the HLX commands that
+ *    move a set of zones from their current to their target state in
+ *    the fewest bytes on the wire.
+ *
+ *  This depends only on the C++ Standard Library such that it may be
+ *  built and benchmarked off of the target (see
+ *  Tools/hlxplanbench).
+ *
+ */
+
+#ifndef COMMANDPLANNER_HPP
+#define COMMANDPLANNER_HPP
+
+#include <vector>
+
+#include <stddef.h>
+#include <stdint.h>
+
+
+/**
+ *  @brief
+ *    An object for planning HLX commands by their cost in bytes.
+ *
+ *  HLX hardware consumes and emits a character at a time, such that
+ *  the bytes of a command request and of its response, rather than
+ *  the number of commands, are what a change costs in time. The
+ *  planner is given the current and target value of properties of
+ *  zones, along with the groups and their zones, and picks, by the
+ *  bytes of each according to its cost model, among:
+ *
+ *    - One group command versus a command for each zone in the
+ *      group, where every zone in the group has a change to the same
+ *      target value for the property.
+ *
+ *    - One or more relative increase or decrease steps versus an
+ *      absolute set, where the current value is known.
+ *
+ *  Changes already at their target value are planned no command;
+ *  they may, however, let a group command cover the zones of a group
+ *  that do need a change.
+ *
+ *  Mutes are ordered ahead of all other commands and unmutes behind
+ *  them, such that no other change is heard on the way to a muted
+ *  target and an unmuted target is heard only once it is reached.
+ *
+ */
+class CommandPlanner
+{
+public:
+    /**
+     *  The kind of entity a command is about.
+     *
+     */
+    enum Kind
+    {
+        kKindGroup = 0, //!< A group.
+        kKindZone,      //!< A zone.
+
+        kKindMax
+    };
+
+    /**
+     *  The property a change or command is for.
+     *
+     */
+    enum Property
+    {
+        kPropertyVolume = 0, //!< Volume level.
+        kPropertyMute,       //!< Volume mute state.
+        kPropertySource,     //!< Source (input).
+        kPropertyBass,       //!< Tone bass level.
+        kPropertyTreble,     //!< Tone treble level.
+
+        kPropertyMax
+    };
+
+    /**
+     *  How a command encodes its value.
+     *
+     */
+    enum Encoding
+    {
+        kEncodingSet = 0,  //!< An absolute set to the value.
+        kEncodingIncrease, //!< A one step increase to the value.
+        kEncodingDecrease, //!< A one step decrease to the value.
+
+        kEncodingMax
+    };
+
+    typedef uint8_t                      IdentifierType;
+    typedef std::vector<IdentifierType>  Identifiers;
+
+    /**
+     *  The type for property values, wide enough for any of the
+     *  levels, mute states, and source identifiers that are set.
+     *
+     */
+    typedef int32_t ValueType;
+
+    /**
+     *  A change of a property of a zone from its current value, where
+     *  known, to its target value.
+     *
+     */
+    struct Change
+    {
+        IdentifierType  mZone;
+        Property        mProperty;
+        bool            mHasCurrent;
+        ValueType       mCurrent;
+        ValueType       mTarget;
+    };
+
+    typedef std::vector<Change> Changes;
+
+    /**
+     *  A group and the zones in it.
+     *
+     */
+    struct Group
+    {
+        IdentifierType  mIdentifier;
+        Identifiers     mZones;
+    };
+
+    typedef std::vector<Group> Groups;
+
+    /**
+     *  A planned command: the entity and property it is for, how it
+     *  is encoded, the value the property holds once it is answered,
+     *  and its cost in bytes.
+     *
+     */
+    struct Command
+    {
+        Kind            mKind;
+        IdentifierType  mIdentifier;
+        Property        mProperty;
+        Encoding        mEncoding;
+        ValueType       mValue;
+        size_t          mCost;
+    };
+
+    typedef std::vector<Command> Commands;
+
+    /**
+     *  @brief
+     *    An object for estimating the bytes on the wire of a command
+     *    request and its response.
+     *
+     *  Requests and responses are costed from the HLX protocol frame
+     *  for each, for example, "[VO12R-25]" to set the volume of zone
+     *  12 and "(VO12R-25)" in answer, with the response line
+     *  terminator added to each response.
+     *
+     *  Where groups echo the change to each of their zones, a group
+     *  command also costs a response for each of its zones.
+     *
+     */
+    class CostModel
+    {
+    public:
+        static const size_t kResponseTerminatorLengthDefault = 2;  //!< CR LF
+
+    public:
+        CostModel(void);
+        ~CostModel(void);
+
+        void   Init(const size_t &aResponseTerminatorLength, const bool &aGroupEchoesZones);
+
+        size_t GetCost(const Kind &aKind,
+                       const IdentifierType &aIdentifier,
+                       const Property &aProperty,
+                       const Encoding &aEncoding,
+                       const ValueType &aValue,
+                       const Identifiers &aZones) const;
+
+    private:
+        size_t GetResponseCost(const Kind &aKind,
+                               const IdentifierType &aIdentifier,
+                               const Property &aProperty,
+                               const ValueType &aValue) const;
+
+    private:
+        size_t  mResponseTerminatorLength;
+        bool    mGroupEchoesZones;
+    };
+
+public:
+    CommandPlanner(void);
+    ~CommandPlanner(void);
+
+    void                Init(const CostModel &aCostModel);
+
+    const CostModel &   GetCostModel(void) const;
+
+    static bool         NeedsChange(const Change &aChange);
+    static bool         IsGroupable(const Property &aProperty);
+    static bool         IsRelative(const Property &aProperty);
+
+    size_t              Plan(const Changes &aChanges, const Groups &aGroups, Commands &aCommands) const;
+    size_t              GetAbsoluteCost(const Changes &aChanges) const;
+
+private:
+    typedef std::vector<const Change *> ChangePointers;
+
+    size_t PlanGroups(const Property &aProperty,
+                      ChangePointers &aChanges,
+                      const Groups &aGroups,
+                      Commands &aCommands) const;
+    size_t PlanOne(const Kind &aKind,
+                   const IdentifierType &aIdentifier,
+                   const Property &aProperty,
+                   const bool &aHasCurrent,
+                   const ValueType &aCurrent,
+                   const ValueType &aTarget,
+                   const Identifiers &aZones,
+                   Commands *aCommands) const;
+
+private:
+    CostModel  mCostModel;
+};
+
+#endif // COMMANDPLANNER_HPP
@@ -0,0 +1,154 @@
+/*
+ *    Copyright (c) 2026 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *  @file
+ *    This file implements an object for choosing, among lanes of
+ *    pending HLX commands of differing priority, which is issued
+ *    next.
+ *
+ */
+
+#include "CommandScheduler.hpp"
+
+
+const size_t CommandScheduler::kInteractiveReserve;
+
+/**
+ *  @brief
+ *    Return the most commands that may be in flight for a command in
+ *    the specified lane to be issued.
+ *
+ *  @param[in]  aLane    The lane of the command.
+ *  @param[in]  aWindow  The window of commands that may be in flight
+ *                       at once.
+ *
+ *  @returns
+ *    The number of commands that may be in flight.
+ *
+ */
+size_t
+CommandScheduler :: GetLimit(const Lane &aLane, const size_t &aWindow)
+{
+    size_t  lRetval;
+
+
+    switch (aLane)
+    {
+
+    case kLaneInteractive:
+        lRetval = aWindow + kInteractiveReserve;
+        break;
+
+    case kLaneBackground:
+        lRetval = ((aWindow > 1) ? (aWindow - 1) : aWindow);
+        break;
+
+    case kLaneUser:
+    default:
+        lRetval = aWindow;
+        break;
+
+    }
+
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Return whether a command enqueued now to the specified lane
+ *    would be issued immediately.
+ *
+ *  @param[in]  aLane      The lane of the command.
+ *  @param[in]  aPending   The number of commands waiting in each
+ *                         lane.
+ *  @param[in]  aInFlight  The number of commands in flight.
+ *  @param[in]  aWindow    The window of commands that may be in
+ *                         flight at once.
+ *
+ */
+bool
+CommandScheduler :: HasCapacity(const Lane &aLane,
+                                const size_t aPending[kLaneMax],
+                                const size_t &aInFlight,
+                                const size_t &aWindow)
+{
+    bool  lRetval = (aInFlight < GetLimit(aLane, aWindow));
+    int   lLane;
+
+
+    for (lLane = kLaneInteractive; lRetval && (lLane <= aLane); lLane++)
+    {
+        lRetval = (aPending[lLane] == 0);
+    }
+
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Select the lane from which the next command is to be issued.
+ *
+ *  @param[in]  aPending   The number of commands waiting in each
+ *                         lane.
+ *  @param[in]  aInFlight  The number of commands in flight.
+ *  @param[in]  aWindow    The window of commands that may be in
+ *                         flight at once.
+ *
+ *  @returns
+ *    The highest priority lane with a command waiting, if there is
+ *    room in flight for it; otherwise, kLaneMax.
+ *
+ */
+CommandScheduler::Lane
+CommandScheduler :: Select(const size_t aPending[kLaneMax],
+                           const size_t &aInFlight,
+                           const size_t &aWindow)
+{
+    int  lLane = kLaneInteractive;
+
+
+    while ((lLane < kLaneMax) && (aPending[lLane] == 0))
+    {
+        lLane++;
+    }
+
+    // Lower priority lanes have no greater limit; where the highest
+    // lane with a command waiting has no room, neither does any other.
+
+    if ((lLane < kLaneMax) && (aInFlight >= GetLimit(static_cast<Lane>(lLane), aWindow)))
+    {
+        lLane = kLaneMax;
+    }
+
+    return (static_cast<Lane>(lLane));
+}
+
+/**
+ *  @brief
+ *    Return the name of the specified lane, for logging.
+ *
+ */
+const char *
+CommandScheduler :: GetLaneName(const Lane &aLane)
+{
+    static const char * const  sNames[kLaneMax] = { "interactive", "user", "background" };
+
+
+    return ((aLane < kLaneMax) ? sNames[aLane] : "unknown");
+}
@@ -0,0 +1,101 @@
+/*
+ *    Copyright (c) 2026 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *  @file
+ *    This file defines an object for choosing, among lanes of
+ *    pending HLX commands of differing priority, which is issued
+ *    next.
+ *
+ *  This depends only on the C++ Standard Library such that it may be
+ *  built and benchmarked off of the target (see
+ *  Tools/hlxlanebench).
+ *
+ */
+
+#ifndef COMMANDSCHEDULER_HPP
+#define COMMANDSCHEDULER_HPP
+
+#include <stddef.h>
+
+
+/**
+ *  @brief
+ *    An object for scheduling HLX commands across priority lanes.
+ *
+ *  Commands wait to be issued in one of three lanes:
+ *
+ *    - Interactive, for commands that must take effect as soon as
+ *      possible, such as a mute.
+ *
+ *    - User, for other user-initiated commands, such as volume steps
+ *      and sets.
+ *
+ *    - Background, for refresh and verification queries, of which
+ *      there may be hundreds waiting.
+ *
+ *  The next command is always taken from the highest priority lane
+ *  with a command waiting, in order within the lane, such that a
+ *  command in a higher lane waits only on commands already in
+ *  flight, never on those waiting in a lower lane.
+ *
+ *  Each lane may fill the window of commands in flight to a different
+ *  limit. User commands may fill the window. Background commands,
+ *  where the window allows more than one, leave one slot of it free,
+ *  such that a user or interactive command arriving during a refresh
+ *  is issued at once. Interactive commands may exceed the window by
+ *  one, such that one is issued at once even where the window is a
+ *  single command and that command is a background query.
+ *
+ */
+class CommandScheduler
+{
+public:
+    /**
+     *  A command lane, highest priority first.
+     *
+     */
+    enum Lane
+    {
+        kLaneInteractive = 0, //!< Emergency and interactive commands.
+        kLaneUser,            //!< Other user-initiated commands.
+        kLaneBackground,      //!< Refresh and verification queries.
+
+        kLaneMax
+    };
+
+    /**
+     *  The number of commands, beyond the window, interactive
+     *  commands may have in flight.
+     *
+     */
+    static const size_t kInteractiveReserve = 1;
+
+public:
+    static size_t       GetLimit(const Lane &aLane, const size_t &aWindow);
+    static bool         HasCapacity(const Lane &aLane,
+                                    const size_t aPending[kLaneMax],
+                                    const size_t &aInFlight,
+                                    const size_t &aWindow);
+    static Lane         Select(const size_t aPending[kLaneMax],
+                               const size_t &aInFlight,
+                               const size_t &aWindow);
+    static const char * GetLaneName(const Lane &aLane);
+};
+
+#endif // COMMANDSCHEDULER_HPP
@@ -29,6 +29,11 @@
 
 extern NSString * const kConnectHistoryLocationKey;
 extern NSString * const kConnectHistoryLastConnectedKey;
+extern NSString * const kConnectHistoryPeerClassKey;
+extern NSString * const kConnectHistoryPeerProbeTimeKey;
+extern NSString * const kConnectHistoryResolveDurationsKey;
+extern NSString * const kConnectHistoryConnectDurationsKey;
+extern NSString * const kConnectHistoryRefreshDurationsKey;
 
 @interface ConnectHistoryController : NSObject
 
@@ -50,10 +55,14 @@ extern NSString * const kConnectHistoryLastConnectedKey;
 - (bool) empty;
 - (NSDictionary *) entryAtIndex: (NSUInteger)aIndex;
 - (NSDictionary *) mostRecentEntry;
+- (id) objectForKey: (NSString *)aKey forLocation: (NSString *)aLocation;
+- (NSUInteger) timeoutForKey: (NSString *)aKey forLocation: (NSString *)aLocation;
 
 // MARK: Mutation
 
 - (bool) addOrUpdateEntry: (NSString *)aLocation andDate: (NSDate *)aDate;
+- (bool) setObject: (id)aObject forKey: (NSString *)aKey forLocation: (NSString *)aLocation;
+- (bool) addDuration: (NSUInteger)aDuration forKey: (NSString *)aKey forLocation: (NSString *)aLocation;
 - (void) removeEntryAtIndex: (NSUInteger)aIndex;
 
 @end
@@ -33,14 +33,40 @@
 #include <OpenHLX/Common/Errors.hpp>
 #include <OpenHLX/Utilities/Assert.hpp>
 
+#import "StateCacheController.h"
+
 
 using namespace Nuovations;
 
 
-NSString * const kConnectHistoryLocationKey      = @"Location";
-NSString * const kConnectHistoryLastConnectedKey = @"Last Connected";
+NSString * const kConnectHistoryLocationKey         = @"Location";
+NSString * const kConnectHistoryLastConnectedKey    = @"Last Connected";
+NSString * const kConnectHistoryPeerClassKey        = @"Peer Class";
+NSString * const kConnectHistoryPeerProbeTimeKey    = @"Peer Probe Time";
+NSString * const kConnectHistoryResolveDurationsKey = @"Resolve Durations";
+NSString * const kConnectHistoryConnectDurationsKey = @"Connect Durations";
+NSString * const kConnectHistoryRefreshDurationsKey = @"Refresh Durations";
+
+static NSString * const kConnectHistoryKey          = @"Connect History";
+
+// The number of most-recent durations, in milliseconds, kept per
+// location for each of the durations keys.
+
+static const NSUInteger kConnectHistoryDurationsMax = 16;
+
+// The fewest durations from which a timeout is derived; with fewer,
+// a single outlier would set the timeout.
+
+static const NSUInteger kTimeoutDurationsMin        = 3;
+
+// The percentile of the durations a derived timeout is a multiple
+// of, that multiple, and the bounds on the derived timeout, in
+// milliseconds.
 
-static NSString * const kConnectHistoryKey       = @"Connect History";
+static const NSUInteger kTimeoutPercentile          = 95;
+static const NSUInteger kTimeoutMultiplier          = 3;
+static const NSUInteger kTimeoutMinimum             = 1000;
+static const NSUInteger kTimeoutMaximum             = 30000;
 
 static NSInteger
 connectHistorySortFunction(id aFirst, id aSecond, void *aContext)
@@ -239,6 +265,90 @@ done:
     return (lRetval);
 }
 
+/**
+ *  @brief
+ *    Return the object for the specified key from the connect
+ *    history entry for the specified network location.
+ *
+ *  @param[in]  aKey       A pointer to the key of the object to
+ *                         return.
+ *  @param[in]  aLocation  A pointer to the string representation of
+ *                         the network address, name, or URL of the
+ *                         entry.
+ *
+ *  @returns
+ *    A pointer to the requested object, if the location is in the
+ *    connect history and its entry has the key; otherwise, null.
+ *
+ */
+- (id) objectForKey: (NSString *)aKey forLocation: (NSString *)aLocation
+{
+    NSUInteger  lIndex;
+    id          lRetval = nullptr;
+
+
+    nlEXPECT(mConnectHistory != nullptr, done);
+
+    lIndex = [mConnectHistory indexOfObjectPassingTest: ^(id aDictionary, NSUInteger aIndex, BOOL *aStop) {
+        return [ConnectHistoryController dictionary: aDictionary containsLocation: aLocation];
+    }];
+    nlEXPECT(lIndex != NSNotFound, done);
+
+    lRetval = [[mConnectHistory objectAtIndex: lIndex] objectForKey: aKey];
+
+ done:
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Return a timeout derived from the durations for the specified
+ *    key from the connect history entry for the specified network
+ *    location.
+ *
+ *  The timeout is a multiple of the 95th percentile of the most
+ *  recent durations, bounded such that a healthy peer is never cut
+ *  short and an unresponsive one is given up on quickly, in
+ *  proportion to how quickly it has answered before.
+ *
+ *  @param[in]  aKey       A pointer to the key of the durations,
+ *                         for example,
+ *                         #kConnectHistoryConnectDurationsKey.
+ *  @param[in]  aLocation  A pointer to the string representation of
+ *                         the network address, name, or URL of the
+ *                         entry.
+ *
+ *  @returns
+ *    The timeout, in milliseconds, if the location is in the connect
+ *    history with enough durations for the key to derive one from;
+ *    otherwise, zero.
+ *
+ */
+- (NSUInteger) timeoutForKey: (NSString *)aKey forLocation: (NSString *)aLocation
+{
+    NSArray *   lDurations;
+    NSUInteger  lRank;
+    NSUInteger  lRetval = 0;
+
+
+    lDurations = [self objectForKey: aKey forLocation: aLocation];
+    nlEXPECT(lDurations != nullptr, done);
+    nlEXPECT([lDurations count] >= kTimeoutDurationsMin, done);
+
+    lDurations = [lDurations sortedArrayUsingSelector: @selector(compare:)];
+
+    // Nearest rank: the smallest duration no fewer than the
+    // percentile of all durations are at or below.
+
+    lRank = (([lDurations count] * kTimeoutPercentile) + 99) / 100;
+
+    lRetval = [[lDurations objectAtIndex: (lRank - 1)] unsignedIntegerValue] * kTimeoutMultiplier;
+    lRetval = MIN(MAX(lRetval, kTimeoutMinimum), kTimeoutMaximum);
+
+ done:
+    return (lRetval);
+}
+
 // MARK: Mutation
 
 /**
@@ -355,6 +465,114 @@ done:
     return (lRetval);
 }
 
+/**
+ *  @brief
+ *    Set the object for the specified key in the connect history
+ *    entry for the specified network location.
+ *
+ *  This is used to remember per-location attributes, discovered
+ *  while connected, across connections to that location.
+ *
+ *  @param[in]  aObject    A pointer to the property list object to
+ *                         set.
+ *  @param[in]  aKey       A pointer to the key of the object to set.
+ *  @param[in]  aLocation  A pointer to the string representation of
+ *                         the network address, name, or URL of the
+ *                         entry.
+ *
+ *  @returns
+ *    True if the location was in the connect history and the object
+ *    was set; otherwise, false.
+ *
+ */
+- (bool) setObject: (id)aObject forKey: (NSString *)aKey forLocation: (NSString *)aLocation
+{
+    NSMutableArray *       lMutableConnectHistory;
+    NSMutableDictionary *  lMutableConnectHistoryEntry;
+    NSUInteger             lIndex;
+    bool                   lRetval = false;
+
+
+    nlREQUIRE(aObject != nullptr, done);
+    nlREQUIRE(aKey != nullptr, done);
+    nlEXPECT(mConnectHistory != nullptr, done);
+
+    lMutableConnectHistory = [mConnectHistory mutableCopy];
+    nlREQUIRE(lMutableConnectHistory != nullptr, done);
+
+    lIndex = [lMutableConnectHistory indexOfObjectPassingTest: ^(id aDictionary, NSUInteger aIndex, BOOL *aStop) {
+        return [ConnectHistoryController dictionary: aDictionary containsLocation: aLocation];
+    }];
+    nlEXPECT(lIndex != NSNotFound, done);
+
+    lMutableConnectHistoryEntry = [[lMutableConnectHistory objectAtIndex: lIndex] mutableCopy];
+    nlREQUIRE(lMutableConnectHistoryEntry != nullptr, done);
+
+    [lMutableConnectHistoryEntry setObject: aObject
+                                    forKey: aKey];
+
+    [lMutableConnectHistory replaceObjectAtIndex: lIndex
+                                      withObject: lMutableConnectHistoryEntry];
+
+    [[NSUserDefaults standardUserDefaults] setObject: lMutableConnectHistory
+                                              forKey: kConnectHistoryKey];
+
+    mConnectHistory = [[NSUserDefaults standardUserDefaults] arrayForKey: kConnectHistoryKey];
+
+    lRetval = true;
+
+ done:
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Add a duration to those for the specified key in the connect
+ *    history entry for the specified network location.
+ *
+ *  Only the most recent durations are kept, such that timeouts
+ *  derived from them track the location as it is now.
+ *
+ *  @param[in]  aDuration  The duration, in milliseconds, to add.
+ *  @param[in]  aKey       A pointer to the key of the durations,
+ *                         for example,
+ *                         #kConnectHistoryConnectDurationsKey.
+ *  @param[in]  aLocation  A pointer to the string representation of
+ *                         the network address, name, or URL of the
+ *                         entry.
+ *
+ *  @returns
+ *    True if the location was in the connect history and the
+ *    duration was added; otherwise, false.
+ *
+ */
+- (bool) addDuration: (NSUInteger)aDuration forKey: (NSString *)aKey forLocation: (NSString *)aLocation
+{
+    NSArray *         lDurations;
+    NSMutableArray *  lMutableDurations;
+    bool              lRetval = false;
+
+
+    lDurations = [self objectForKey: aKey forLocation: aLocation];
+
+    lMutableDurations = ((lDurations != nullptr) ? [lDurations mutableCopy] : [NSMutableArray array]);
+    nlREQUIRE(lMutableDurations != nullptr, done);
+
+    [lMutableDurations addObject: [NSNumber numberWithUnsignedInteger: aDuration]];
+
+    if ([lMutableDurations count] > kConnectHistoryDurationsMax)
+    {
+        [lMutableDurations removeObjectsInRange: NSMakeRange(0, [lMutableDurations count] - kConnectHistoryDurationsMax)];
+    }
+
+    lRetval = [self setObject: lMutableDurations
+                       forKey: aKey
+                  forLocation: aLocation];
+
+ done:
+    return (lRetval);
+}
+
 /**
  *  @brief
  *    Remove the specified connect history entry.
@@ -369,6 +587,7 @@ done:
 - (void) removeEntryAtIndex: (NSUInteger)aIndex
 {
     NSMutableArray *       lMutableConnectHistory;
+    NSDictionary *         lEntry;
 
 
     // First make a mutable copy of the connect history from which to delete.
@@ -376,6 +595,13 @@ done:
     lMutableConnectHistory = [mConnectHistory mutableCopy];
     nlREQUIRE(lMutableConnectHistory != nullptr, done);
 
+    // Any state snapshot saved for the entry location is no longer
+    // reachable from the history; remove it as well.
+
+    lEntry = [lMutableConnectHistory objectAtIndex: aIndex];
+
+    [[StateCacheController sharedController] removeStateForLocation: [lEntry objectForKey: kConnectHistoryLocationKey]];
+
     // Delete the requested entry.
 
     [lMutableConnectHistory removeObjectAtIndex: aIndex];
@@ -0,0 +1,522 @@
+/*
+ *    Copyright (c) 2026 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *  @file
+ *    This file implements an object for racing staggered connection
+ *    attempts across all of the addresses a HLX server host name
+ *    resolves to.
+ *
+ */
+
+#include "ConnectRacer.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <LogUtilities/LogUtilities.hpp>
+
+#include <OpenHLX/Utilities/Assert.hpp>
+
+
+using namespace HLX::Common;
+using namespace Nuovations;
+
+
+namespace
+{
+
+/**
+ *  An in-progress connection attempt.
+ *
+ */
+struct Attempt
+{
+    int                      mDescriptor;
+    const struct addrinfo *  mAddress;
+};
+
+typedef std::vector<const struct addrinfo *> Addresses;
+typedef std::vector<Attempt>                 Attempts;
+
+};
+
+// The longest a single poll waits, such that a cancellation is
+// noticed promptly.
+
+static const ConnectRacer::Duration kPollInterval(50);
+
+const ConnectRacer::Duration ConnectRacer::kAttemptDelayDefault(250);
+const ConnectRacer::Duration ConnectRacer::kTimeoutDefault(10000);
+
+/**
+ *  @brief
+ *    Order resolved addresses for racing, interleaving them by
+ *    family, starting with the family of the first, and otherwise
+ *    preserving the resolver order.
+ *
+ */
+static void
+OrderAddresses(const struct addrinfo *aResults, Addresses &aAddresses)
+{
+    Addresses                lFirst;
+    Addresses                lSecond;
+    const struct addrinfo *  lResult;
+    size_t                   lIndex;
+
+
+    for (lResult = aResults; lResult != nullptr; lResult = lResult->ai_next)
+    {
+        if (lFirst.empty() || (lResult->ai_family == lFirst.front()->ai_family))
+        {
+            lFirst.push_back(lResult);
+        }
+        else
+        {
+            lSecond.push_back(lResult);
+        }
+    }
+
+    for (lIndex = 0; lIndex < std::max(lFirst.size(), lSecond.size()); lIndex++)
+    {
+        if (lIndex < lFirst.size())
+        {
+            aAddresses.push_back(lFirst[lIndex]);
+        }
+
+        if (lIndex < lSecond.size())
+        {
+            aAddresses.push_back(lSecond[lIndex]);
+        }
+    }
+}
+
+/**
+ *  @brief
+ *    Resolve the specified host and port to its stream addresses.
+ *
+ *  @param[in]   aHost     A pointer to the null-terminated host name
+ *                         or numeric address to resolve.
+ *  @param[in]   aPort     A pointer to the null-terminated port or
+ *                         service to resolve.
+ *  @param[out]  aResults  A reference to storage for the resolved
+ *                         addresses, to be freed with freeaddrinfo.
+ *
+ *  @retval  kStatus_Success  If successful.
+ *  @retval  -EINVAL          If @a aHost or @a aPort was null.
+ *  @retval  -EHOSTUNREACH    If @a aHost could not be resolved.
+ *
+ */
+static Status
+ResolveAddresses(const char *aHost, const char *aPort, struct addrinfo *&aResults)
+{
+    struct addrinfo  lHints;
+    int              lStatus;
+    Status           lRetval = kStatus_Success;
+
+
+    nlREQUIRE_ACTION(aHost != nullptr, done, lRetval = -EINVAL);
+    nlREQUIRE_ACTION(aPort != nullptr, done, lRetval = -EINVAL);
+
+    memset(&lHints, 0, sizeof (lHints));
+
+    lHints.ai_family   = AF_UNSPEC;
+    lHints.ai_socktype = SOCK_STREAM;
+    lHints.ai_flags    = AI_ADDRCONFIG;
+
+    lStatus = getaddrinfo(aHost, aPort, &lHints, &aResults);
+    if (lStatus != 0)
+    {
+        Log::Error().Write("Could not resolve \"%s\": %s\n", aHost, gai_strerror(lStatus));
+
+        aResults = nullptr;
+        lRetval  = -EHOSTUNREACH;
+    }
+
+ done:
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Start a non-blocking connection attempt to the specified
+ *    address.
+ *
+ *  @param[in]   aAddress     The address to connect to.
+ *  @param[out]  aDescriptor  A reference to storage for the socket
+ *                            descriptor of the attempt, or -1 on
+ *                            failure.
+ *
+ *  @retval  kStatus_Success  If the attempt completed immediately.
+ *  @retval  -EINPROGRESS     If the attempt is in progress.
+ *  @retval  -errno           If the attempt failed.
+ *
+ */
+static Status
+StartAttempt(const struct addrinfo *aAddress, int &aDescriptor)
+{
+    int     lFlags;
+    int     lStatus;
+    Status  lRetval = kStatus_Success;
+
+
+    aDescriptor = socket(aAddress->ai_family, aAddress->ai_socktype, aAddress->ai_protocol);
+    nlREQUIRE_ACTION(aDescriptor >= 0, done, lRetval = -errno);
+
+    lFlags = fcntl(aDescriptor, F_GETFL, 0);
+    nlREQUIRE_ACTION(lFlags >= 0, done, lRetval = -errno);
+
+    lStatus = fcntl(aDescriptor, F_SETFL, lFlags | O_NONBLOCK);
+    nlREQUIRE_ACTION(lStatus == 0, done, lRetval = -errno);
+
+    lStatus = connect(aDescriptor, aAddress->ai_addr, aAddress->ai_addrlen);
+    nlEXPECT_ACTION(lStatus == 0, done, lRetval = -errno);
+
+ done:
+    if ((lRetval != kStatus_Success) && (lRetval != -EINPROGRESS) && (aDescriptor >= 0))
+    {
+        close(aDescriptor);
+
+        aDescriptor = -1;
+    }
+
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    This is the class default constructor.
+ *
+ */
+ConnectRacer :: ConnectRacer(void) :
+    mAttemptDelay(kAttemptDelayDefault),
+    mTimeout(kTimeoutDefault),
+    mCancelled(false)
+{
+    return;
+}
+
+/**
+ *  @brief
+ *    This is the class destructor.
+ *
+ */
+ConnectRacer :: ~ConnectRacer(void)
+{
+    return;
+}
+
+/**
+ *  @brief
+ *    This is the class initializer.
+ *
+ *  This must be called before each race.
+ *
+ *  @param[in]  aAttemptDelay  The delay between the start of one
+ *                             connection attempt and the next.
+ *  @param[in]  aTimeout       The time after which, if no attempt
+ *                             has completed, the race is abandoned.
+ *
+ *  @retval  kStatus_Success  If successful.
+ *  @retval  -EINVAL          If @a aTimeout was not positive.
+ *
+ */
+Status
+ConnectRacer :: Init(const Duration &aAttemptDelay, const Duration &aTimeout)
+{
+    Status  lRetval = kStatus_Success;
+
+
+    nlREQUIRE_ACTION(aTimeout.count() > 0, done, lRetval = -EINVAL);
+
+    mAttemptDelay = aAttemptDelay;
+    mTimeout      = aTimeout;
+
+    // Clear any cancellation here rather than in #Race, such that a
+    // cancellation arriving after initialization but before the race
+    // starts, off of the main thread, is not lost.
+
+    mCancelled    = false;
+
+ done:
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Resolve the specified host and race connection attempts across
+ *    its addresses.
+ *
+ *  Where the host resolves to a single address, there is nothing to
+ *  race and that address is returned without attempting a
+ *  connection, leaving that to the client controller alone.
+ *
+ *  @param[in]   aHost      A pointer to the null-terminated host
+ *                          name or numeric address to resolve.
+ *  @param[in]   aPort      A pointer to the null-terminated port or
+ *                          service to connect to.
+ *  @param[out]  aAddress   A reference to storage for the numeric
+ *                          address, without port, of the winner.
+ *  @param[out]  aDuration  A reference to storage for the time, from
+ *                          the start of resolution, until the winner
+ *                          answered or, where there was nothing to
+ *                          race, zero.
+ *
+ *  @retval  kStatus_Success  If successful.
+ *  @retval  -EINVAL          If @a aHost or @a aPort was null.
+ *  @retval  -EHOSTUNREACH    If @a aHost could not be resolved.
+ *  @retval  -ECANCELED       If the race was cancelled.
+ *  @retval  -ETIMEDOUT       If no attempt completed in time.
+ *  @retval  -errno           The error from the last attempt, if all
+ *                            attempts failed.
+ *
+ */
+Status
+ConnectRacer :: Race(const char *aHost, const char *aPort, std::string &aAddress, Duration &aDuration)
+{
+    struct addrinfo *        lResults = nullptr;
+    Addresses                lAddresses;
+    Attempts                 lAttempts;
+    std::vector<pollfd>      lDescriptors;
+    const struct addrinfo *  lWinner = nullptr;
+    size_t                   lNext = 0;
+    Status                   lLastError = -ECONNREFUSED;
+    Clock::time_point        lStart;
+    Clock::time_point        lNow;
+    Clock::time_point        lNextStart;
+    Clock::time_point        lDeadline;
+    char                     lBuffer[NI_MAXHOST];
+    int                      lStatus;
+    Status                   lRetval = kStatus_Success;
+
+
+    lStart = Clock::now();
+
+    aDuration = Duration::zero();
+
+    lRetval = ResolveAddresses(aHost, aPort, lResults);
+    nlREQUIRE_SUCCESS(lRetval, done);
+
+    OrderAddresses(lResults, lAddresses);
+    nlREQUIRE_ACTION(!lAddresses.empty(), done, lRetval = -EHOSTUNREACH);
+
+    if (lAddresses.size() == 1)
+    {
+        lWinner = lAddresses.front();
+    }
+
+    lNextStart = Clock::now();
+    lDeadline  = lStart + mTimeout;
+
+    while ((lWinner == nullptr) && (lRetval == kStatus_Success))
+    {
+        lNow = Clock::now();
+
+        if (mCancelled)
+        {
+            lRetval = -ECANCELED;
+        }
+        else if (lNow >= lDeadline)
+        {
+            lRetval = -ETIMEDOUT;
+        }
+        else if ((lNext == lAddresses.size()) && lAttempts.empty())
+        {
+            lRetval = lLastError;
+        }
+        else if ((lNext < lAddresses.size()) && ((lNow >= lNextStart) || lAttempts.empty()))
+        {
+            // Start the next attempt, either because the attempt
+            // delay has elapsed or because there are no other
+            // attempts left in progress.
+
+            Attempt lAttempt;
+
+            lAttempt.mAddress = lAddresses[lNext++];
+
+            lStatus = StartAttempt(lAttempt.mAddress, lAttempt.mDescriptor);
+
+            if ((lStatus == kStatus_Success) || (lStatus == -EINPROGRESS))
+            {
+                lAttempts.push_back(lAttempt);
+
+                lNextStart = lNow + mAttemptDelay;
+
+                if (lStatus == kStatus_Success)
+                {
+                    lWinner = lAttempt.mAddress;
+                }
+            }
+            else
+            {
+                lLastError = lStatus;
+            }
+        }
+        else
+        {
+            // Wait for an attempt to complete, the next attempt to
+            // be due, or the deadline, whichever is first.
+
+            Clock::time_point  lWake = ((lNext < lAddresses.size()) ? std::min(lNextStart, lDeadline) : lDeadline);
+            Duration           lWait = std::min(std::chrono::duration_cast<Duration>(lWake - lNow), kPollInterval);
+            size_t             lIndex;
+
+            lDescriptors.clear();
+
+            for (lIndex = 0; lIndex < lAttempts.size(); lIndex++)
+            {
+                pollfd lDescriptor;
+
+                lDescriptor.fd      = lAttempts[lIndex].mDescriptor;
+                lDescriptor.events  = POLLOUT;
+                lDescriptor.revents = 0;
+
+                lDescriptors.push_back(lDescriptor);
+            }
+
+            lStatus = poll(lDescriptors.data(), lDescriptors.size(), std::max(static_cast<int>(lWait.count()), 0));
+            nlREQUIRE_ACTION((lStatus >= 0) || (errno == EINTR), done, lRetval = -errno);
+
+            // Walk the attempts in reverse such that failed ones may
+            // be erased in place.
+
+            for (lIndex = lDescriptors.size(); (lIndex > 0) && (lWinner == nullptr); lIndex--)
+            {
+                const pollfd &lDescriptor = lDescriptors[lIndex - 1];
+
+                if (lDescriptor.revents != 0)
+                {
+                    int        lError = 0;
+                    socklen_t  lErrorSize = sizeof (lError);
+
+                    lStatus = getsockopt(lDescriptor.fd, SOL_SOCKET, SO_ERROR, &lError, &lErrorSize);
+
+                    if ((lStatus == 0) && (lError == 0))
+                    {
+                        lWinner = lAttempts[lIndex - 1].mAddress;
+                    }
+                    else
+                    {
+                        lLastError = ((lStatus == 0) ? -lError : -errno);
+
+                        close(lDescriptor.fd);
+
+                        lAttempts.erase(lAttempts.begin() + static_cast<ssize_t>(lIndex - 1));
+
+                        // Failed outright; do not wait out the
+                        // attempt delay to start the next attempt.
+
+                        lNextStart = lNow;
+                    }
+                }
+            }
+        }
+    }
+
+    nlEXPECT(lWinner != nullptr, done);
+
+    lStatus = getnameinfo(lWinner->ai_addr, lWinner->ai_addrlen, lBuffer, sizeof (lBuffer), nullptr, 0, NI_NUMERICHOST);
+    nlREQUIRE_ACTION(lStatus == 0, done, lRetval = -EHOSTUNREACH);
+
+    aAddress = lBuffer;
+
+    if (lNext > 0)
+    {
+        aDuration = std::chrono::duration_cast<Duration>(Clock::now() - lStart);
+    }
+
+    Log::Info().Write("Raced %zu of %zu addresses for \"%s\"; '%s' answered first in %lld ms.\n",
+                      lNext,
+                      lAddresses.size(),
+                      aHost,
+                      lBuffer,
+                      static_cast<long long>(std::chrono::duration_cast<Duration>(Clock::now() - lStart).count()));
+
+ done:
+    for (const Attempt &lAttempt : lAttempts)
+    {
+        close(lAttempt.mDescriptor);
+    }
+
+    if (lResults != nullptr)
+    {
+        freeaddrinfo(lResults);
+    }
+
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Resolve the specified host without racing connection attempts.
+ *
+ *  This is intended to be used ahead of an anticipated connection
+ *  such that the system resolver cache is warm by the time of the
+ *  connection.
+ *
+ *  @param[in]  aHost  A pointer to the null-terminated host name or
+ *                     numeric address to resolve.
+ *  @param[in]  aPort  A pointer to the null-terminated port or
+ *                     service to resolve.
+ *
+ *  @retval  kStatus_Success  If successful.
+ *  @retval  -EINVAL          If @a aHost or @a aPort was null.
+ *  @retval  -EHOSTUNREACH    If @a aHost could not be resolved.
+ *
+ */
+Status
+ConnectRacer :: Resolve(const char *aHost, const char *aPort)
+{
+    struct addrinfo *  lResults = nullptr;
+    Status             lRetval;
+
+
+    lRetval = ResolveAddresses(aHost, aPort, lResults);
+    nlREQUIRE_SUCCESS(lRetval, done);
+
+    Log::Info().Write("Resolved \"%s\" ahead of connecting.\n", aHost);
+
+ done:
+    if (lResults != nullptr)
+    {
+        freeaddrinfo(lResults);
+    }
+
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Cancel a race in progress.
+ *
+ *  The race returns -ECANCELED shortly thereafter.
+ *
+ */
+void
+ConnectRacer :: Cancel(void)
+{
+    mCancelled = true;
+}
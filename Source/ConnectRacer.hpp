@@ -0,0 +1,101 @@
+/*
+ *    Copyright (c) 2026 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *  @file
+ *    This file defines an object for racing staggered connection
+ *    attempts across all of the addresses a HLX server host name
+ *    resolves to.
+ *
+ */
+
+#ifndef CONNECTRACER_HPP
+#define CONNECTRACER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <string>
+
+#include <OpenHLX/Common/Errors.hpp>
+
+
+/**
+ *  @brief
+ *    An object for racing connection attempts across resolved
+ *    addresses.
+ *
+ *  A host name is resolved to all of its IPv6 and IPv4 addresses,
+ *  which are then interleaved by family, starting with the family of
+ *  the first address. A connection attempt is started to each in
+ *  turn, with each start staggered by the attempt delay or, where the
+ *  prior attempt failed outright, started immediately. The first
+ *  attempt to complete wins and all others are abandoned.
+ *
+ *  Since the HLX client controller makes its own connection and
+ *  cannot adopt one already made, the winning connection is only used
+ *  to find an address that answers; it is closed and the numeric
+ *  address returned such that the client controller may connect to it
+ *  directly, without waiting out the connection timeout on addresses
+ *  that do not answer. This costs a second TCP handshake with the
+ *  winner and, since HLX hardware accepts only two connections at
+ *  once, briefly holds one of those two until the closed connection
+ *  is reaped.
+ *
+ *  #Init must be called before each race. #Race blocks and is
+ *  intended to be run off of the main thread; #Cancel may be called
+ *  from any thread, once #Init has been, including before #Race
+ *  starts.
+ *
+ */
+class ConnectRacer
+{
+public:
+    typedef std::chrono::steady_clock Clock;
+    typedef std::chrono::milliseconds Duration;
+
+    /**
+     *  The default delay between the start of one connection attempt
+     *  and the next, per RFC 8305.
+     *
+     */
+    static const Duration kAttemptDelayDefault;
+
+    /**
+     *  The default time after which, if no attempt has completed, the
+     *  race is abandoned.
+     *
+     */
+    static const Duration kTimeoutDefault;
+
+public:
+    ConnectRacer(void);
+    ~ConnectRacer(void);
+
+    HLX::Common::Status Init(const Duration &aAttemptDelay, const Duration &aTimeout);
+
+    HLX::Common::Status Race(const char *aHost, const char *aPort, std::string &aAddress, Duration &aDuration);
+    HLX::Common::Status Resolve(const char *aHost, const char *aPort);
+    void                Cancel(void);
+
+private:
+    Duration           mAttemptDelay;
+    Duration           mTimeout;
+    std::atomic<bool>  mCancelled;
+};
+
+#endif // CONNECTRACER_HPP
@@ -0,0 +1,47 @@
+/*
+ *    Copyright (c) 2026 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+
+/**
+ *  @file
+ *    This file declares extension instance methods to
+ *    ConnectViewController for classifying a HLX server peer,
+ *    from a prior connection or by probing it, and for applying the
+ *    client settings suited to it.
+ *
+ */
+
+#ifndef CONNECTVIEWCONTROLLER_EXTENDED_BY_PEERPROBE_H
+#define CONNECTVIEWCONTROLLER_EXTENDED_BY_PEERPROBE_H
+
+#include <OpenHLX/Client/ApplicationControllerDelegate.hpp>
+
+#import "ConnectViewController.h"
+
+
+@interface ConnectViewController (PeerProbe)
+
+// MARK: Workers
+
+- (void) classifyPeerForLocation: (NSString *)aLocation;
+- (bool) peerProbeStateDidChange: (const HLX::Client::StateChange::NotificationBasis &)aStateChangeNotification;
+- (bool) cancelPeerProbe;
+
+@end
+
+#endif // CONNECTVIEWCONTROLLER_EXTENDED_BY_PEERPROBE_H
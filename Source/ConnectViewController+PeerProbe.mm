@@ -0,0 +1,266 @@
+/*
+ *    Copyright (c) 2026 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+
+/**
+ *  @file
+ *    This file implements extension instance methods to
+ *    ConnectViewController for classifying a HLX server peer, from a
+ *    prior connection or by probing it, and for applying the client
+ *    settings suited to it.
+ *
+ */
+
+#import "ConnectViewController+PeerProbe.h"
+
+#include <Foundation/Foundation.h>
+
+#include <LogUtilities/LogUtilities.hpp>
+
+#include <OpenHLX/Utilities/Assert.hpp>
+
+#import "AppDelegate.h"
+#import "CommandPipeline.hpp"
+#import "ConnectHistoryController.h"
+#import "ConnectViewController+Private.h"
+
+
+using namespace HLX::Client;
+using namespace HLX::Common;
+using namespace Nuovations;
+
+
+@implementation ConnectViewController (PeerProbe)
+
+// MARK: Workers
+
+/**
+ *  @brief
+ *    Classify the peer at the specified location, apply the client
+ *    settings suited to it, and move on.
+ *
+ *  If the location has been classified before, from an answered
+ *  probe, that classification is applied immediately. Otherwise,
+ *  including where a prior probe timed out, the peer is probed to
+ *  classify it first, giving up after PeerProbe::kTimeout.
+ *
+ *  @param[in]  aLocation  A pointer to the string representation of
+ *                         the network address, name, or URL.
+ *
+ */
+- (void) classifyPeerForLocation: (NSString *)aLocation
+{
+    PeerProbe::Class  lPeerClass;
+    Status            lStatus;
+
+
+    lPeerClass = [self peerClassForLocation: aLocation];
+
+    nlEXPECT_ACTION(lPeerClass == PeerProbe::kClassUnknown,
+                    done,
+                    [self didClassifyPeer: lPeerClass]);
+
+    lStatus = mPeerProbe.Start(*mApplicationController);
+    nlREQUIRE_ACTION(lStatus == kStatus_Success,
+                     done,
+                     [self didClassifyPeer: PeerProbe::kClassUnknown]);
+
+    [self performSelector: @selector(peerProbeDidTimeout)
+               withObject: nullptr
+               afterDelay: (PeerProbe::kTimeout.count() / 1000.0)];
+
+ done:
+    return;
+}
+
+/**
+ *  @brief
+ *    Offer a client controller state change to the peer probe, if
+ *    one is in progress, moving on if it answers the probe.
+ *
+ *  @param[in]  aStateChangeNotification  A reference to the state
+ *                                        change notification.
+ *
+ *  @returns
+ *    True if the state change answered the probe; otherwise, false.
+ *
+ */
+- (bool) peerProbeStateDidChange: (const StateChange::NotificationBasis &)aStateChangeNotification
+{
+    bool  lRetval = false;
+
+
+    nlEXPECT(mPeerProbe.IsActive(), done);
+
+    lRetval = mPeerProbe.StateDidChange(aStateChangeNotification);
+    nlEXPECT(lRetval, done);
+
+    [self didProbePeer];
+
+ done:
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Abandon the peer probe, if one is in progress, without
+ *    classifying the peer.
+ *
+ *  @returns
+ *    True if a probe was in progress; otherwise, false.
+ *
+ */
+- (bool) cancelPeerProbe
+{
+    bool  lRetval = mPeerProbe.IsActive();
+
+
+    nlEXPECT(lRetval, done);
+
+    [NSObject cancelPreviousPerformRequestsWithTarget: self
+                                             selector: @selector(peerProbeDidTimeout)
+                                               object: nullptr];
+
+    mPeerProbe.Stop();
+
+ done:
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Return the peer class remembered, from a prior connection, for
+ *    the specified location.
+ *
+ *  Only a peer class remembered along with the time its probe was
+ *  answered in is returned; one without, as remembered from a probe
+ *  that timed out, is not.
+ *
+ *  @param[in]  aLocation  A pointer to the string representation of
+ *                         the network address, name, or URL.
+ *
+ *  @returns
+ *    The remembered peer class, if any; otherwise, kClassUnknown.
+ *
+ */
+- (PeerProbe::Class) peerClassForLocation: (NSString *)aLocation
+{
+    ConnectHistoryController *  lSharedConnectHistoryController = [ConnectHistoryController sharedController];
+    NSString *                  lPeerClassName = nullptr;
+    NSNumber *                  lPeerProbeTime;
+
+
+    lPeerProbeTime = [lSharedConnectHistoryController objectForKey: kConnectHistoryPeerProbeTimeKey
+                                                       forLocation: aLocation];
+    nlEXPECT(lPeerProbeTime != nullptr, done);
+
+    lPeerClassName = [lSharedConnectHistoryController objectForKey: kConnectHistoryPeerClassKey
+                                                       forLocation: aLocation];
+
+ done:
+    return (PeerProbe::GetClass([lPeerClassName UTF8String]));
+}
+
+/**
+ *  @brief
+ *    Apply the client settings suited to the specified peer class
+ *    and move on.
+ *
+ *  A pipeline depth explicitly chosen in the app settings overrides
+ *  the one suited to the peer class.
+ *
+ *  @param[in]  aPeerClass  The peer class.
+ *
+ */
+- (void) didClassifyPeer: (PeerProbe::Class)aPeerClass
+{
+    const PeerProbe::Profile &  lProfile = PeerProbe::GetProfile(aPeerClass);
+    const NSInteger             lPipelineDepth = [[NSUserDefaults standardUserDefaults] integerForKey: kPipelineDepthKey];
+    Status                      lStatus;
+
+
+    nlREQUIRE(mCommandPipeline != nullptr, done);
+
+    lStatus = mCommandPipeline->SetDepth((lPipelineDepth > 0) ? static_cast<size_t>(lPipelineDepth) : lProfile.mPipelineDepth);
+    nlVERIFY_SUCCESS(lStatus);
+
+    mCommandPipeline->SetResponseTimeout(lProfile.mResponseTimeout);
+
+    Log::Info().Write("Peer class %s: pipeline depth %zu, response timeout %lld ms.\n",
+                      PeerProbe::GetClassName(aPeerClass),
+                      mCommandPipeline->GetDepth(),
+                      static_cast<long long>(mCommandPipeline->GetResponseTimeout().count()));
+
+ done:
+    [self dismissConnectAlertAndSegue];
+}
+
+/**
+ *  @brief
+ *    Classify the peer from the probe, remember the classification
+ *    for this location if the probe was answered, apply it, and move
+ *    on.
+ *
+ *  A classification from a probe that timed out is applied but not
+ *  remembered, such that the next connection to this same location
+ *  probes again.
+ *
+ */
+- (void) didProbePeer
+{
+    ConnectHistoryController *  lSharedConnectHistoryController = [ConnectHistoryController sharedController];
+    NSString *                  lLocation = self.mNetworkAddressOrNameTextField.text;
+    PeerProbe::Class            lPeerClass;
+
+
+    [NSObject cancelPreviousPerformRequestsWithTarget: self
+                                             selector: @selector(peerProbeDidTimeout)
+                                               object: nullptr];
+
+    lPeerClass = mPeerProbe.Stop();
+
+    nlEXPECT(mPeerProbe.IsAnswered(), done);
+
+    [lSharedConnectHistoryController setObject: [NSString stringWithUTF8String: PeerProbe::GetClassName(lPeerClass)]
+                                        forKey: kConnectHistoryPeerClassKey
+                                   forLocation: lLocation];
+    [lSharedConnectHistoryController setObject: [NSNumber numberWithLongLong: mPeerProbe.GetElapsed().count()]
+                                        forKey: kConnectHistoryPeerProbeTimeKey
+                                   forLocation: lLocation];
+
+ done:
+    [self didClassifyPeer: lPeerClass];
+}
+
+/**
+ *  @brief
+ *    Classify the peer, for this connection only, once it has not
+ *    answered the probe in full in time.
+ *
+ */
+- (void) peerProbeDidTimeout
+{
+    nlEXPECT(mPeerProbe.IsActive(), done);
+
+    [self didProbePeer];
+
+ done:
+    return;
+}
+
+@end
@@ -0,0 +1,47 @@
+/*
+ *    Copyright (c) 2026 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+
+/**
+ *  @file
+ *    This file declares extension instance methods to
+ *    ConnectViewController for quietly connecting to a HLX
+ *    server ahead of the user asking to.
+ *
+ */
+
+#ifndef CONNECTVIEWCONTROLLER_EXTENDED_BY_PRECONNECT_H
+#define CONNECTVIEWCONTROLLER_EXTENDED_BY_PRECONNECT_H
+
+#import "ConnectViewController.h"
+
+
+@interface ConnectViewController (Preconnect)
+
+// MARK: Workers
+
+- (void) preconnectLocation: (NSString *)aLocation;
+- (bool) isPreconnecting;
+- (void) preconnectDidConnectWithURL: (NSURL *)aURLRef;
+- (bool) claimOrCancelPreconnectForLocation: (NSString *)aLocation;
+- (void) cancelPreconnect;
+- (void) clearPreconnect;
+
+@end
+
+#endif // CONNECTVIEWCONTROLLER_EXTENDED_BY_PRECONNECT_H
@@ -0,0 +1,239 @@
+/*
+ *    Copyright (c) 2026 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+
+/**
+ *  @file
+ *    This file implements extension instance methods to
+ *    ConnectViewController for quietly connecting to a HLX server
+ *    ahead of the user asking to.
+ *
+ */
+
+#import "ConnectViewController+Preconnect.h"
+
+#include <Foundation/Foundation.h>
+
+#include <LogUtilities/LogUtilities.hpp>
+
+#include <OpenHLX/Utilities/Assert.hpp>
+
+#import "ConnectViewController+Private.h"
+#import "ConnectViewController+Race.h"
+#import "PhaseTimingRecorder.hpp"
+
+
+using namespace HLX::Common;
+using namespace Nuovations;
+
+
+// The time after which a pre-connection that the user has not
+// claimed by connecting to the same location is released.
+
+static const NSTimeInterval kPreconnectIdleTimeout = 30.0;
+
+@implementation ConnectViewController (Preconnect)
+
+// MARK: Workers
+
+/**
+ *  @brief
+ *    Quietly connect to the specified location ahead of the user
+ *    asking to.
+ *
+ *  Until the user claims the pre-connection by connecting to the
+ *  same location, no connection progress is presented and nothing
+ *  beyond the connection itself is done. An unclaimed pre-connection
+ *  is released after #kPreconnectIdleTimeout such that it does not
+ *  hold one of the HLX's two connections indefinitely.
+ *
+ *  @param[in]  aLocation  A pointer to the IP address, host name, IP
+ *                         address and port, host name and port, or
+ *                         URL of the HLX server to pre-connect to.
+ *
+ */
+- (void) preconnectLocation: (NSString *)aLocation
+{
+    Status lStatus;
+
+    Log::Info().Write("Pre-connecting to \"%s\".\n", [aLocation UTF8String]);
+
+    mPreconnectLocation = aLocation;
+    mPreconnectURL      = nullptr;
+
+    [self cancelRace];
+
+    if (mPhaseTimingRecorder != nullptr)
+    {
+        mPhaseTimingRecorder->SetSite([aLocation UTF8String]);
+    }
+
+    lStatus = [self connectTo: aLocation
+                  forLocation: aLocation];
+    nlREQUIRE_ACTION(lStatus == kStatus_Success, done, mPreconnectLocation = nullptr);
+
+    [self performSelector: @selector(preconnectDidTimeout)
+               withObject: nullptr
+               afterDelay: kPreconnectIdleTimeout];
+
+ done:
+    return;
+}
+
+/**
+ *  @brief
+ *    Return whether there is a pre-connection that the user has not
+ *    yet claimed.
+ *
+ *  @returns
+ *    True if there is an unclaimed pre-connection; otherwise, false.
+ *
+ */
+- (bool) isPreconnecting
+{
+    return (mPreconnectLocation != nullptr);
+}
+
+/**
+ *  @brief
+ *    Remember that the pre-connection completed, such that claiming
+ *    it continues on from the connection.
+ *
+ *  @param[in]  aURLRef  A pointer to the URL that was connected to.
+ *
+ */
+- (void) preconnectDidConnectWithURL: (NSURL *)aURLRef
+{
+    mPreconnectURL = aURLRef;
+}
+
+/**
+ *  @brief
+ *    Claim the pre-connection, if it is to the specified location,
+ *    or release it, along with the HLX connection it holds, if not.
+ *
+ *  @param[in]  aLocation  A pointer to the IP address, host name, IP
+ *                         address and port, host name and port, or
+ *                         URL of the HLX server the user is
+ *                         connecting to.
+ *
+ *  @returns
+ *    True if the pre-connection was claimed; otherwise, false, if
+ *    there was none or it was released.
+ *
+ */
+- (bool) claimOrCancelPreconnectForLocation: (NSString *)aLocation
+{
+    bool  lRetval = false;
+
+
+    nlEXPECT(mPreconnectLocation != nullptr, done);
+
+    if ([mPreconnectLocation isEqualToString: aLocation])
+    {
+        [self claimPreconnect];
+
+        lRetval = true;
+    }
+    else
+    {
+        [self cancelPreconnect];
+    }
+
+ done:
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Claim the pre-connection on behalf of the user, continuing from
+ *    wherever it is in connecting as though the user had initiated
+ *    it.
+ *
+ */
+- (void) claimPreconnect
+{
+    NSURL *    lURL = mPreconnectURL;
+    NSString * lLocation = mPreconnectLocation;
+
+    [self clearPreconnect];
+
+    Log::Info().Write("Claiming pre-connection to \"%s\" (%s).\n",
+                      [lLocation UTF8String],
+                      ((lURL != nullptr) ? "connected" : "connecting"));
+
+    [self presentConnectAlertWithMessage: ((lURL != nullptr) ? [lURL absoluteString] : lLocation)
+                              completion: ^(void) {
+        // If the pre-connection has already completed, continue on
+        // from the connection as though it had just now
+        // completed. Otherwise, controllerDidConnect will when it
+        // does.
+
+        if (lURL != nullptr)
+        {
+            [self didConnectWithURL: lURL];
+        }
+    }];
+}
+
+/**
+ *  @brief
+ *    Release the pre-connection, if any, along with the HLX connection
+ *    it holds.
+ *
+ */
+- (void) cancelPreconnect
+{
+    nlEXPECT(mPreconnectLocation != nullptr, done);
+
+    Log::Info().Write("Releasing pre-connection to \"%s\".\n", [mPreconnectLocation UTF8String]);
+
+    [self clearPreconnect];
+
+    mApplicationController->Disconnect();
+
+ done:
+    return;
+}
+
+/**
+ *  @brief
+ *    Forget the pre-connection, if any, without disconnecting.
+ *
+ */
+- (void) clearPreconnect
+{
+    [NSObject cancelPreviousPerformRequestsWithTarget: self
+                                             selector: @selector(preconnectDidTimeout)
+                                               object: nullptr];
+
+    mPreconnectLocation = nullptr;
+    mPreconnectURL      = nullptr;
+}
+
+/**
+ *  @brief
+ *    Release a pre-connection the user has not claimed in time.
+ *
+ */
+- (void) preconnectDidTimeout
+{
+    [self cancelPreconnect];
+}
+
+@end
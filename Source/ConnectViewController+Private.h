@@ -0,0 +1,73 @@
+/*
+ *    Copyright (c) 2026 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+
+/**
+ *  @file
+ *    This file declares the instance data and the workers of the
+ *    view controller for connecting to a HLX server shared by its
+ *    implementation and by the extensions to it for racing,
+ *    pre-connecting, and probing the peer.
+ *
+ */
+
+#ifndef CONNECTVIEWCONTROLLER_PRIVATE_H
+#define CONNECTVIEWCONTROLLER_PRIVATE_H
+
+#include <memory>
+
+#import <UIKit/UIKit.h>
+
+#include <OpenHLX/Common/Errors.hpp>
+
+#import "ConnectRacer.hpp"
+#import "ConnectViewController.h"
+#import "PeerProbe.hpp"
+#import "RefreshViewController.h"
+
+
+class CommandPipeline;
+class PhaseTimingRecorder;
+class RefreshStageTracker;
+
+@interface ConnectViewController ()
+{
+    UIAlertController *            mAlertController;
+    RefreshViewController *        mRefreshController;
+    NSDictionary *                 mCachedState;
+    RefreshStageTracker *          mRefreshStageTracker;
+    PhaseTimingRecorder *          mPhaseTimingRecorder;
+    CommandPipeline *              mCommandPipeline;
+    PeerProbe                      mPeerProbe;
+    std::shared_ptr<ConnectRacer>  mConnectRacer;
+    ConnectRacer::Duration         mRaceDuration;
+    NSString *                     mPreconnectLocation;
+    NSURL *                        mPreconnectURL;
+}
+
+// MARK: Workers
+
+- (void) presentConnectAlertWithMessage: (NSString *)aMessage completion: (void (^)(void))aCompletion;
+- (HLX::Common::Status) connectTo: (NSString *)aConnectString forLocation: (NSString *)aLocation;
+- (void) didConnectWithURL: (NSURL *)aURLRef;
+- (void) dismissConnectAlertAndSegue;
+- (void) didNotConnectWithURL: (NSURL *)aURLRef andError: (const HLX::Common::Error &)aError withDescription: (NSString *)aDescription;
+
+@end
+
+#endif // CONNECTVIEWCONTROLLER_PRIVATE_H
@@ -0,0 +1,45 @@
+/*
+ *    Copyright (c) 2026 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+
+/**
+ *  @file
+ *    This file declares extension instance methods to
+ *    ConnectViewController for racing connection attempts
+ *    across all of the addresses a HLX server host name resolves to.
+ *
+ */
+
+#ifndef CONNECTVIEWCONTROLLER_EXTENDED_BY_RACE_H
+#define CONNECTVIEWCONTROLLER_EXTENDED_BY_RACE_H
+
+#import "ConnectRacer.hpp"
+#import "ConnectViewController.h"
+
+
+@interface ConnectViewController (Race)
+
+// MARK: Workers
+
+- (bool) raceNetworkAddressOrName: (NSString *)aNetworkAddressOrName;
+- (void) cancelRace;
+- (ConnectRacer::Duration) raceDuration;
+
+@end
+
+#endif // CONNECTVIEWCONTROLLER_EXTENDED_BY_RACE_H
@@ -0,0 +1,220 @@
+/*
+ *    Copyright (c) 2026 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+
+/**
+ *  @file
+ *    This file implements extension instance methods to
+ *    ConnectViewController for racing connection attempts across all
+ *    of the addresses a HLX server host name resolves to.
+ *
+ */
+
+#import "ConnectViewController+Race.h"
+
+#include <memory>
+#include <string>
+
+#include <errno.h>
+#include <string.h>
+
+#include <dispatch/dispatch.h>
+
+#include <Foundation/Foundation.h>
+
+#include <OpenHLX/Utilities/Assert.hpp>
+
+#import "ConnectHistoryController.h"
+#import "ConnectViewController+Private.h"
+#import "NSURLComponents+NetworkAddressOrName.h"
+
+
+using namespace HLX::Common;
+
+
+@implementation ConnectViewController (Race)
+
+// MARK: Workers
+
+/**
+ *  @brief
+ *    Attempt to start a race of connection attempts across all of
+ *    the addresses the host in the specified IP address, host name,
+ *    IP address and port, host name and port, or URL resolves to.
+ *
+ *  The race runs off of the main thread and, when it completes,
+ *  continues on the main thread with
+ *  #didRaceURLComponents:toAddress:withStatus:.
+ *
+ *  @param[in]  aNetworkAddressOrName  A pointer to a string containing
+ *                                     the IP address, host name, IP
+ *                                     address and port, host name
+ *                                     and port, or URL of the HLX
+ *                                     server to race.
+ *
+ *  @returns
+ *    True if the race was started; otherwise, false, if the host
+ *    could not be parsed from @a aNetworkAddressOrName.
+ *
+ */
+- (bool) raceNetworkAddressOrName: (NSString *)aNetworkAddressOrName
+{
+    NSURLComponents *              lURLComponents;
+    NSString *                     lHost;
+    NSString *                     lPort;
+    std::shared_ptr<ConnectRacer>  lConnectRacer;
+    NSUInteger                     lTimeout;
+    Status                         lStatus;
+    bool                           lRetval = false;
+
+    lURLComponents = [NSURLComponents componentsWithNetworkAddressOrName: aNetworkAddressOrName];
+    nlEXPECT(lURLComponents != nullptr, done);
+
+    lHost = [lURLComponents unbracketedHost];
+    lPort = [lURLComponents portOrDefault];
+
+    lConnectRacer.reset(new ConnectRacer());
+    nlREQUIRE(lConnectRacer != nullptr, done);
+
+    // Give up on the race as soon as the location's connect history
+    // says it should have been won, if there is enough history to
+    // say.
+
+    lTimeout = [[ConnectHistoryController sharedController] timeoutForKey: kConnectHistoryConnectDurationsKey
+                                                              forLocation: aNetworkAddressOrName];
+
+    lStatus = lConnectRacer->Init(ConnectRacer::kAttemptDelayDefault,
+                                  ((lTimeout > 0) ? ConnectRacer::Duration(lTimeout) : ConnectRacer::kTimeoutDefault));
+    nlREQUIRE_SUCCESS(lStatus, done);
+
+    mConnectRacer = lConnectRacer;
+
+    dispatch_async(dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^(void) {
+        std::string             lAddress;
+        ConnectRacer::Duration  lDuration;
+        Status                  lStatus;
+
+        lStatus = lConnectRacer->Race([lHost UTF8String], [lPort UTF8String], lAddress, lDuration);
+
+        dispatch_async(dispatch_get_main_queue(), ^(void) {
+            // Ignore a race that was superseded while it ran.
+
+            if (self->mConnectRacer == lConnectRacer)
+            {
+                self->mConnectRacer.reset();
+                self->mRaceDuration = lDuration;
+
+                [self didRaceURLComponents: lURLComponents
+                                 toAddress: [NSString stringWithUTF8String: lAddress.c_str()]
+                                withStatus: lStatus];
+            }
+        });
+    });
+
+    lRetval = true;
+
+ done:
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Cancel any connection race in progress.
+ *
+ */
+- (void) cancelRace
+{
+    if (mConnectRacer != nullptr)
+    {
+        mConnectRacer->Cancel();
+        mConnectRacer.reset();
+    }
+
+    mRaceDuration = ConnectRacer::Duration::zero();
+}
+
+/**
+ *  @brief
+ *    Return how long the most recent race took.
+ *
+ *  @returns
+ *    The time, from the start of resolution, until the winner of the
+ *    most recent race answered or, if there was no race or nothing
+ *    to race, zero.
+ *
+ */
+- (ConnectRacer::Duration) raceDuration
+{
+    return (mRaceDuration);
+}
+
+/**
+ *  @brief
+ *    Connect to the winner of a connection race or, if there was no
+ *    winner, present the reason to the user.
+ *
+ *  @param[in]  aURLComponents  A pointer to the parsed URL of the HLX
+ *                              server that was raced.
+ *  @param[in]  aAddress        A pointer to the numeric address of
+ *                              the winner, if any.
+ *  @param[in]  aStatus         The race status.
+ *
+ */
+- (void) didRaceURLComponents: (NSURLComponents *)aURLComponents toAddress: (NSString *)aAddress withStatus: (const Status &)aStatus
+{
+    NSString *  lHost;
+    NSString *  lConnectString;
+    Status      lStatus;
+
+    if (aStatus != kStatus_Success)
+    {
+        if (aStatus != -ECANCELED)
+        {
+            [self didNotConnectWithURL: aURLComponents.URL
+                              andError: aStatus
+                       withDescription: [NSString stringWithUTF8String: strerror(-aStatus)]];
+        }
+
+        self.mConnectButton.enabled = YES;
+    }
+    nlEXPECT(aStatus == kStatus_Success, done);
+
+    // Connect to the winning address directly, bracketing it if it is
+    // an IPv6 address, such that the client controller does not
+    // re-resolve the name and try addresses that do not answer.
+    //
+    // The client controller cannot adopt the race's connection, so
+    // this is a second handshake with the winner, and the closed race
+    // connection briefly holds one of the two connections HLX
+    // hardware accepts.
+
+    lHost = ([aAddress containsString: @":"] ? [NSString stringWithFormat: @"[%@]", aAddress] : aAddress);
+
+    lConnectString = ((aURLComponents.port != nullptr) ?
+                      [NSString stringWithFormat: @"%@://%@:%@", aURLComponents.scheme, lHost, aURLComponents.port] :
+                      [NSString stringWithFormat: @"%@://%@", aURLComponents.scheme, lHost]);
+
+    lStatus = [self connectTo: lConnectString
+                  forLocation: self.mNetworkAddressOrNameTextField.text];
+    nlREQUIRE_SUCCESS(lStatus, done);
+
+ done:
+    return;
+}
+
+@end
@@ -39,8 +39,13 @@
 #import "AppDelegate.h"
 #import "ConnectHistoryController.h"
 #import "ConnectHistoryViewController.h"
+#import "ConnectViewController+PeerProbe.h"
+#import "ConnectViewController+Preconnect.h"
+#import "ConnectViewController+Private.h"
+#import "ConnectViewController+Race.h"
 #import "GroupsAndZonesTableViewController.h"
 #import "RefreshViewController.h"
+#import "StateCacheController.h"
 #import "UIViewController+HLXClientDidDisconnectDelegateDefaultImplementations.h"
 #import "UIViewController+TopViewController.h"
 
@@ -63,21 +68,13 @@ class Controller;
 
 };
 
-@interface ConnectViewController ()
-{
-    UIAlertController *      mAlertController;
-    RefreshViewController *  mRefreshController;
-}
-
-@end
-
 @implementation ConnectViewController
 
 // MARK: View Delegation
 
 - (void) viewDidLoad
 {
-    AppDelegate *lDelegate = static_cast<AppDelegate *>([[UIApplication sharedApplication] delegate]);
+    AppDelegate *lDelegate = [AppDelegate sharedDelegate];
 
     [super viewDidLoad];
 
@@ -88,6 +85,10 @@ class Controller;
     mApplicationController = [lDelegate hlxClientController];
     nlREQUIRE(mApplicationController != nullptr, done);
 
+    mRefreshStageTracker = &[lDelegate refreshStageTracker];
+    mPhaseTimingRecorder = &[lDelegate phaseTimingRecorder];
+    mCommandPipeline = &[lDelegate commandPipeline];
+
     // Set ourselves as the delegate for the network address or name
     // text field such that we can respond to a return / go keyboard
     // event.
@@ -100,7 +101,9 @@ class Controller;
 
 - (void) viewWillAppear: (BOOL)aAnimated
 {
+    AppDelegate *               lDelegate = [AppDelegate sharedDelegate];
     ConnectHistoryController *  lSharedConnectHistoryController;
+    NSString *                  lPreconnectLocation;
 
 
     [super viewWillAppear: aAnimated];
@@ -190,7 +193,31 @@ class Controller;
         self.mConnectButton.enabled = YES;
     }
 
-    mApplicationController->SetDelegate(mApplicationControllerDelegate.get());
+    [lDelegate stateChangeBus].SetDelegate(mApplicationControllerDelegate.get());
+
+    // If the app was launched with a pre-connection to the most
+    // recent location in mind, start it now that we are the client
+    // controller delegate. This happens at most once per launch.
+
+    lPreconnectLocation = [[AppDelegate sharedDelegate] takePreconnectLocation];
+
+    if ((lPreconnectLocation != nullptr) && !mApplicationController->IsConnected())
+    {
+        [self preconnectLocation: lPreconnectLocation];
+    }
+
+    return;
+}
+
+- (void) viewWillDisappear: (BOOL)aAnimated
+{
+    [super viewWillDisappear: aAnimated];
+
+    // Once we are no longer the client controller delegate, we can
+    // no longer track a pre-connection; release it rather than
+    // leaving it to hold a HLX connection unclaimed.
+
+    [self cancelPreconnect];
 
     return;
 }
@@ -258,6 +285,12 @@ class Controller;
 
     mAlertController = nullptr;
     mRefreshController = nullptr;
+    mCachedState = nullptr;
+    mRefreshStageTracker = nullptr;
+    mPhaseTimingRecorder = nullptr;
+    mCommandPipeline = nullptr;
+    mPreconnectLocation = nullptr;
+    mPreconnectURL = nullptr;
 
  done:
     return;
@@ -294,6 +327,11 @@ done:
             GroupsAndZonesTableViewController *  lGroupsAndZonesTableViewController = static_cast<GroupsAndZonesTableViewController *>(lNavigationController.topViewController);
 
             [lGroupsAndZonesTableViewController setApplicationController: mApplicationController];
+
+            [lGroupsAndZonesTableViewController setCachedState: mCachedState
+                                                   forLocation: self.mNetworkAddressOrNameTextField.text];
+
+            mCachedState = nullptr;
         }
     }
 
@@ -452,6 +490,256 @@ done:
     mApplicationController->Disconnect();
 }
 
+// MARK: Controller Delegations
+
+- (void) controllerWillResolve: (HLX::Client::Application::Controller &)aController withHost: (const char *)aHost
+{
+    Log::Info().Write("Will resolve \"%s\".\n", aHost);
+}
+
+- (void) controllerIsResolving: (HLX::Client::Application::Controller &)aController withHost: (const char *)aHost
+{
+    Log::Info().Write("Is resolving \"%s\".\n", aHost);
+}
+
+- (void) controllerDidResolve: (HLX::Client::Application::Controller &)aController withHost: (const char *)aHost andAddress: (const HLX::Common::IPAddress &)aIPAddress
+{
+    char   lBuffer[INET6_ADDRSTRLEN];
+    Status lStatus;
+
+    lStatus = aIPAddress.ToString(lBuffer, sizeof (lBuffer));
+    nlREQUIRE_SUCCESS(lStatus, done);
+
+    Log::Info().Write("Did resolve \"%s\" to '%s'.\n", aHost, lBuffer);
+
+ done:
+    return;
+}
+
+- (void) controllerDidNotResolve: (HLX::Client::Application::Controller &)aController withHost: (const char *)aHost andError: (const HLX::Common::Error &)aError
+{
+    Log::Error().Write("Did not resolve \"%s\": %d (%s).\n", aHost, aError, strerror(-aError));
+}
+
+- (void) controllerWillConnect: (HLX::Client::Application::Controller &)aController withURL: (NSURL *)aURLRef andTimeout: (const HLX::Common::Timeout &)aTimeout
+{
+    Log::Info().Write("Will connect to %s with %u ms timeout.\n",
+                      [[aURLRef absoluteString] UTF8String],
+                      aTimeout.GetMilliseconds());
+
+    // A pre-connection proceeds quietly until the user claims it.
+
+    nlEXPECT(![self isPreconnecting], done);
+
+    // If we are here, then there was something in the network
+    // address or name text field that the user wants the app to
+    // try to connect to. Start the connection process.
+
+    [self presentConnectAlertWithMessage: [aURLRef absoluteString]
+                              completion: nullptr];
+
+ done:
+    return;
+}
+
+- (void) controllerIsConnecting: (HLX::Client::Application::Controller &)aController withURL: (NSURL *)aURLRef andTimeout: (const HLX::Common::Timeout &)aTimeout
+{
+    Log::Info().Write("Connecting to %s with %u ms timeout.\n",
+                      [[aURLRef absoluteString] UTF8String],
+                      aTimeout.GetMilliseconds());
+}
+
+- (void) controllerDidConnect: (HLX::Client::Application::Controller &)aController withURL: (NSURL *)aURLRef
+{
+    Log::Info().Write("Connected to %s.\n", [[aURLRef absoluteString] UTF8String]);
+
+    // A pre-connection waits, connected, for the user to claim it.
+
+    if ([self isPreconnecting])
+    {
+        [self preconnectDidConnectWithURL: aURLRef];
+    }
+    else
+    {
+        [self didConnectWithURL: aURLRef];
+    }
+}
+
+- (void) controllerDidNotConnect: (HLX::Client::Application::Controller &)aController withURL: (NSURL *)aURLRef andError: (const HLX::Common::Error &)aError
+{
+    NSString *    lDescription;
+    bool          lPreconnecting;
+
+    lDescription = [NSString stringWithUTF8String: strerror(-aError)];
+
+    Log::Error().Write("Did not connect to %s: %d (%s).\n",
+                       [[aURLRef absoluteString] UTF8String],
+                       aError,
+                       [lDescription UTF8String]);
+
+    // A pre-connection that fails does so quietly; the user may yet
+    // connect explicitly.
+
+    lPreconnecting = [self isPreconnecting];
+
+    [self clearPreconnect];
+
+    nlEXPECT(!lPreconnecting, done);
+
+    // At this point, the modal connection progress alert controller
+    // posted in controllerWillConnect is still up and needs to be
+    // dismissed before another alert controller describing the
+    // connect failure can be presented. Dismiss the prior alert
+    // controller, triggering presentation of the new alert controller
+    // on the completion.
+
+    [mAlertController dismissViewControllerAnimated: NO
+                                         completion: ^(void) {
+        [self didNotConnectWithURL: aURLRef
+              andError: aError
+              withDescription: lDescription];
+
+        // At this point, the connect button was disabled to handle
+        // the connect; re-enable it.
+
+        self.mConnectButton.enabled = YES;
+    }];
+
+ done:
+    return;
+}
+
+- (void) controllerWillRefresh: (HLX::Client::Application::ControllerBasis &)aController
+{
+    DeclareLogIndentWithValue(lLogIndent, 0);
+    DeclareLogLevelWithValue(lLogLevel, 1);
+
+    LogDebug(lLogIndent,
+             lLogLevel,
+             "Waiting for client data...\n");
+}
+
+- (void) controllerIsRefreshing: (HLX::Client::Application::ControllerBasis &)aController withProgress: (const uint8_t &)aPercentComplete
+{
+    DeclareLogIndentWithValue(lLogIndent, 0);
+    DeclareLogLevelWithValue(lLogLevel, 1);
+    const float lPercentComplete = aPercentComplete / 100.0f;
+
+    LogDebug(lLogIndent,
+             lLogLevel,
+             "%hhu%% of client data received.\n", aPercentComplete);
+
+    [mRefreshController updateRefreshProgress: lPercentComplete];
+}
+
+- (void) controllerDidRefresh: (HLX::Client::Application::ControllerBasis &)aController
+{
+    DeclareLogIndentWithValue(lLogIndent, 0);
+    DeclareLogLevelWithValue(lLogLevel, 1);
+
+    LogDebug(lLogIndent,
+             lLogLevel,
+             "Client data received...\n");
+
+    [self dismissRefreshControllerAndSegue];
+}
+
+- (void) controllerStateDidChange: (HLX::Client::Application::ControllerBasis &)aController withNotification: (const StateChange::NotificationBasis &)aStateChangeNotification
+{
+    // While the peer is being probed, the only state changes expected
+    // are the probe answer.
+
+    [self peerProbeStateDidChange: aStateChangeNotification];
+
+    // In the staged refresh mode, as soon as enough client data has
+    // been received for the groups and zones view to be usable, skip
+    // ahead to it rather than waiting for the remainder of the
+    // refresh. The remainder, which is everything else the client
+    // controller refresh fetches, continues in the background and is
+    // delivered to whichever view is the client controller delegate
+    // as it arrives.
+
+    nlEXPECT(mRefreshController != nullptr, done);
+    nlEXPECT(mRefreshStageTracker != nullptr, done);
+    nlEXPECT(mRefreshStageTracker->GetStage() == RefreshStageTracker::kStageUsable, done);
+    nlEXPECT([[NSUserDefaults standardUserDefaults] boolForKey: kStagedRefreshKey], done);
+
+    [self dismissRefreshControllerAndSegue];
+
+ done:
+    return;
+}
+
+- (void) controllerWillDisconnect: (HLX::Client::Application::Controller &)aController withURL: (NSURL *)aURLRef
+{
+    Log::Info().Write("Will disconnect from %s.\n", [[aURLRef absoluteString] UTF8String]);
+}
+
+- (void) controllerDidDisconnect: (HLX::Client::Application::Controller &)aController withURL: (NSURL *)aURLRef andError: (const HLX::Common::Error &)aError
+{
+    // If the peer disconnected an unclaimed pre-connection, there is
+    // nothing left to claim.
+
+    [self clearPreconnect];
+
+    // If the peer disconnected while being probed, abandon the probe
+    // and the modal connection progress alert along with it.
+
+    if ([self cancelPeerProbe])
+    {
+        [mAlertController dismissViewControllerAnimated: NO
+                                             completion: nullptr];
+    }
+
+    if (self->mRefreshController != nullptr)
+    {
+        [RefreshViewController viewPresentDidDisconnectAlert: self->mRefreshController
+                                withURL: aURLRef
+                               andError: aError
+                             andHandler: ^(UIAlertAction * aAction) {
+            // Stop the refresh view controller activity.
+
+            [self->mRefreshController stopRefreshActivity];
+
+            // Dismiss the refreshing view controller
+
+            [self->mRefreshController dismissViewControllerAnimated: NO
+                                                   completion: ^(void) {
+                self->mRefreshController.mDelegate = nullptr;
+                self->mRefreshController           = nullptr;
+            }];
+        }];
+    }
+
+    // We are now disconnected; re-enable the connect button.
+    
+    self.mConnectButton.enabled = YES;
+}
+
+// MARK: Refresh View Controller Delegations
+
+- (void) controllerDidAppear: (RefreshViewController *)aController
+{
+    Status lStatus;
+
+    [self->mRefreshController startRefreshActivity];
+
+    lStatus = self->mApplicationController->Refresh();
+    nlREQUIRE_SUCCESS(lStatus, done);
+
+ done:
+    return;
+}
+
+- (void) controllerShouldDisconnect: (RefreshViewController *)aController
+{
+    // Stop the refresh view controller activity.
+
+    [aController stopRefreshActivity];
+
+    mApplicationController->Disconnect();
+}
+
 // MARK: Workers
 
 /**
@@ -470,6 +758,8 @@ done:
  */
 - (void) openNetworkAddressOrName: (NSString *)aNetworkAddressOrName
 {
+    bool   lClaimed;
+    bool   lRacing;
     Status lStatus;
 
     nlREQUIRE(aNetworkAddressOrName != nullptr, done);
@@ -479,7 +769,34 @@ done:
 
     self.mConnectButton.enabled = NO;
 
-    lStatus = mApplicationController->Connect([aNetworkAddressOrName UTF8String]);
+    // If there is a pre-connection, either claim it, if it is to this
+    // same location, or release it and the HLX connection it holds
+    // such that this connection can be made in its place.
+
+    lClaimed = [self claimOrCancelPreconnectForLocation: aNetworkAddressOrName];
+    nlEXPECT(!lClaimed, done);
+
+    // Attribute this session's phase timings to the site being
+    // connected to.
+
+    if (mPhaseTimingRecorder != nullptr)
+    {
+        mPhaseTimingRecorder->SetSite([aNetworkAddressOrName UTF8String]);
+    }
+
+    // In the parallel connect mode, race connections across all of
+    // the addresses the name resolves to first, connecting to
+    // whichever answers first once the race completes. Abandon any
+    // earlier race, along with its duration, first.
+
+    [self cancelRace];
+
+    lRacing = ([[NSUserDefaults standardUserDefaults] boolForKey: kParallelConnectKey] &&
+               [self raceNetworkAddressOrName: aNetworkAddressOrName]);
+    nlEXPECT(!lRacing, done);
+
+    lStatus = [self connectTo: aNetworkAddressOrName
+                  forLocation: aNetworkAddressOrName];
     nlREQUIRE_SUCCESS(lStatus, done);
 
 done:
@@ -504,9 +821,13 @@ done:
 {
     NSString *lNetworkAddressOrNameString = [aURL absoluteString];
 
-    // Disconnect from any existing HLX server that might currently be
+    // Abandon any connection race or pre-connection in progress and
+    // disconnect from any existing HLX server that might currently be
     // connected.
 
+    [self cancelRace];
+    [self clearPreconnect];
+
     mApplicationController->Disconnect();
 
     // Populate the network address or name text field such that the
@@ -521,51 +842,24 @@ done:
     [self openNetworkAddressOrName: lNetworkAddressOrNameString];
 }
 
-- (void) controllerWillResolve: (HLX::Client::Application::Controller &)aController withHost: (const char *)aHost
-{
-    Log::Info().Write("Will resolve \"%s\".\n", aHost);
-}
-
-- (void) controllerIsResolving: (HLX::Client::Application::Controller &)aController withHost: (const char *)aHost
-{
-    Log::Info().Write("Is resolving \"%s\".\n", aHost);
-}
-
-- (void) controllerDidResolve: (HLX::Client::Application::Controller &)aController withHost: (const char *)aHost andAddress: (const HLX::Common::IPAddress &)aIPAddress
-{
-    char   lBuffer[INET6_ADDRSTRLEN];
-    Status lStatus;
-
-    lStatus = aIPAddress.ToString(lBuffer, sizeof (lBuffer));
-    nlREQUIRE_SUCCESS(lStatus, done);
-
-    Log::Info().Write("Did resolve \"%s\" to '%s'.\n", aHost, lBuffer);
-
- done:
-    return;
-}
-
-- (void) controllerDidNotResolve: (HLX::Client::Application::Controller &)aController withHost: (const char *)aHost andError: (const HLX::Common::Error &)aError
-{
-    Log::Error().Write("Did not resolve \"%s\": %d (%s).\n", aHost, aError, strerror(-aError));
-}
-
-- (void) controllerWillConnect: (HLX::Client::Application::Controller &)aController withURL: (NSURL *)aURLRef andTimeout: (const HLX::Common::Timeout &)aTimeout
+/**
+ *  @brief
+ *    Present the modal connection progress alert, with a "Cancel"
+ *    button to abandon the connection.
+ *
+ *  @param[in]  aMessage     A pointer to the alert message, typically
+ *                           the URL being connected to.
+ *  @param[in]  aCompletion  An optional block to invoke once the
+ *                           alert has been presented.
+ *
+ */
+- (void) presentConnectAlertWithMessage: (NSString *)aMessage completion: (void (^)(void))aCompletion
 {
     UIAlertController *lAlertController;
     UIAlertAction     *lCancelAction;
 
-
-    Log::Info().Write("Will connect to %s with %u ms timeout.\n",
-                      [[aURLRef absoluteString] UTF8String],
-                      aTimeout.GetMilliseconds());
-
-    // If we are here, then there was something in the network
-    // address or name text field that the user wants the app to
-    // try to connect to. Start the connection process.
-
     lAlertController = [UIAlertController alertControllerWithTitle: NSLocalizedString(@"Connecting", @"")
-                                          message: [aURLRef absoluteString]
+                                          message: aMessage
                                           preferredStyle: UIAlertControllerStyleAlert];
 
     lCancelAction = [UIAlertAction actionWithTitle: NSLocalizedString(@"Cancel", @"")
@@ -580,31 +874,112 @@ done:
 
     [self.topViewController presentViewController: mAlertController
                                          animated: true
-                                       completion: nullptr];
+                                       completion: aCompletion];
+}
 
-    return;
+/**
+ *  @brief
+ *    Connect to the specified HLX server, timing out in keeping with
+ *    the connect history of the specified location.
+ *
+ *  Where the location has enough connect history, the connection
+ *  times out after a multiple of how long it has taken before rather
+ *  than after the client controller default, such that a location
+ *  that is powered off or no longer present fails fast.
+ *
+ *  @param[in]  aConnectString  A pointer to the IP address, host
+ *                              name, IP address and port, host name
+ *                              and port, or URL to connect to.
+ *  @param[in]  aLocation       A pointer to the location, as the user
+ *                              entered it, that @a aConnectString
+ *                              was derived from.
+ *
+ *  @retval  kStatus_Success  If successful.
+ *
+ */
+- (Status) connectTo: (NSString *)aConnectString forLocation: (NSString *)aLocation
+{
+    NSUInteger  lTimeout;
+    Status      lRetval;
+
+    lTimeout = [[ConnectHistoryController sharedController] timeoutForKey: kConnectHistoryConnectDurationsKey
+                                                              forLocation: aLocation];
+
+    if (lTimeout > 0)
+    {
+        Log::Info().Write("Connecting to \"%s\" with a %lu ms timeout from history.\n",
+                          [aConnectString UTF8String],
+                          static_cast<unsigned long>(lTimeout));
+
+        lRetval = mApplicationController->Connect([aConnectString UTF8String],
+                                                  HLX::Common::Timeout(static_cast<uint32_t>(lTimeout)));
+    }
+    else
+    {
+        lRetval = mApplicationController->Connect([aConnectString UTF8String]);
+    }
+
+    return (lRetval);
 }
 
-- (void) controllerIsConnecting: (HLX::Client::Application::Controller &)aController withURL: (NSURL *)aURLRef andTimeout: (const HLX::Common::Timeout &)aTimeout
+/**
+ *  @brief
+ *    Record the duration of the specified phase, as most recently
+ *    timed, in the connect history entry for the current location.
+ *
+ *  @param[in]  aPhase  The phase whose duration to record.
+ *  @param[in]  aKey    A pointer to the key of the durations to
+ *                      record it to.
+ *
+ */
+- (void) recordPhase: (PhaseTimingRecorder::Phase)aPhase forKey: (NSString *)aKey
 {
-    Log::Info().Write("Connecting to %s with %u ms timeout.\n",
-                      [[aURLRef absoluteString] UTF8String],
-                      aTimeout.GetMilliseconds());
+    PhaseTimingRecorder::Duration  lDuration;
+    Status                         lStatus;
+
+    nlEXPECT(mPhaseTimingRecorder != nullptr, done);
+
+    lStatus = mPhaseTimingRecorder->GetLastDuration(aPhase, lDuration);
+    nlEXPECT_SUCCESS(lStatus, done);
+
+    [[ConnectHistoryController sharedController] addDuration: static_cast<NSUInteger>(lDuration.count())
+                                                      forKey: aKey
+                                                 forLocation: self.mNetworkAddressOrNameTextField.text];
+
+ done:
+    return;
 }
 
-- (void) controllerDidConnect: (HLX::Client::Application::Controller &)aController withURL: (NSURL *)aURLRef
+/**
+ *  @brief
+ *    Continue on from a connection that the user initiated or
+ *    claimed, recording it in the connect history and classifying
+ *    the peer ahead of the refresh.
+ *
+ *  @param[in]  aURLRef  A pointer to the URL that was connected to.
+ *
+ */
+- (void) didConnectWithURL: (NSURL *)aURLRef
 {
+    DeclareLogIndentWithValue(lLogIndent, 0);
+    DeclareLogLevelWithValue(lLogLevel, 1);
+    AppDelegate *               lDelegate = [AppDelegate sharedDelegate];
     NSDate *                    lDateNow = [NSDate date];
     ConnectHistoryController *  lSharedConnectHistoryController;
+    StateCacheController *      lSharedStateCacheController;
+    ConnectRacer::Duration      lRaceDuration;
     bool                        lStatus;
 
 
-    Log::Info().Write("Connected to %s.\n", [[aURLRef absoluteString] UTF8String]);
+    // Client data snapshots, saved on completion of each refresh,
+    // are for this location from here on.
+
+    [lDelegate setConnectedLocation: self.mNetworkAddressOrNameTextField.text];
 
     // Attempt to retrieve the shared connect history controller.
 
     lSharedConnectHistoryController = [ConnectHistoryController sharedController];
-    nlEXPECT(lSharedConnectHistoryController != nullptr, segue);
+    nlEXPECT(lSharedConnectHistoryController != nullptr, snapshot);
 
     // If there is no connect history, then this will be the first
     // entry. Otherwise, if this location is in the history, update
@@ -618,9 +993,68 @@ done:
 
     lStatus = [lSharedConnectHistoryController addOrUpdateEntry: self.mNetworkAddressOrNameTextField.text
                                                         andDate: lDateNow];
-    nlREQUIRE(lStatus == true, segue);
+
+    if (lStatus)
+    {
+        // Remember how long resolving and connecting took, such that
+        // the next connection to this same location may time out in
+        // keeping with them. Where addresses were raced, connecting
+        // is the race, from resolution until the winner answered,
+        // rather than the client controller connection to the winner
+        // that followed.
+
+        [self recordPhase: PhaseTimingRecorder::kPhaseResolve
+                   forKey: kConnectHistoryResolveDurationsKey];
+
+        lRaceDuration = [self raceDuration];
+
+        if (lRaceDuration > ConnectRacer::Duration::zero())
+        {
+            [lSharedConnectHistoryController addDuration: static_cast<NSUInteger>(lRaceDuration.count())
+                                                  forKey: kConnectHistoryConnectDurationsKey
+                                             forLocation: self.mNetworkAddressOrNameTextField.text];
+        }
+        else
+        {
+            [self recordPhase: PhaseTimingRecorder::kPhaseConnect
+                       forKey: kConnectHistoryConnectDurationsKey];
+        }
+    }
+    else
+    {
+        LogDebug(lLogIndent,
+                 lLogLevel,
+                 "Could not add %s to the connect history; not recording its durations.\n",
+                 [self.mNetworkAddressOrNameTextField.text UTF8String]);
+    }
+
+ snapshot:
+    // Attempt to retrieve a state snapshot saved from a prior
+    // connection to this same location, if any.
+
+    lSharedStateCacheController = [StateCacheController sharedController];
+    nlEXPECT(lSharedStateCacheController != nullptr, segue);
+
+    mCachedState = [lSharedStateCacheController stateForLocation: self.mNetworkAddressOrNameTextField.text];
 
  segue:
+    // If this location has been classified before, apply the client
+    // settings for its peer class and move on. Otherwise, probe the
+    // peer to classify it first. Either way, this happens before the
+    // refresh such that the refresh, too, benefits.
+
+    [self classifyPeerForLocation: self.mNetworkAddressOrNameTextField.text];
+}
+
+/**
+ *  @brief
+ *    Dismiss the modal connection progress alert and segue onward,
+ *    either to the groups and zones view, for a location with a state
+ *    snapshot, or to the refresh view.
+ *
+ */
+- (void) dismissConnectAlertAndSegue
+{
     // The first thought implementation here might be to simply
     // dismiss the modal connection progress alert that may be present
     // and to initiate a client controller refresh in the completion
@@ -651,6 +1085,18 @@ done:
         UIViewController *lViewController;
 
 
+        // If there is a state snapshot for this location, then skip
+        // the refresh controller view entirely and render the groups
+        // and zones immediately from the snapshot. The groups and
+        // zones view controller starts the client controller refresh
+        // once it has appeared and replaces the snapshot with live
+        // data as it arrives.
+
+        nlEXPECT_ACTION(self->mCachedState == nullptr,
+                        done,
+                        [self performSegueWithIdentifier: @"DidRefresh"
+                                                  sender: self]);
+
         // Load the refreshing view controller programmatically.
 
         lStoryboard = [UIStoryboard storyboardWithName: lStoryboardName
@@ -678,144 +1124,44 @@ done:
     }];
 }
 
-- (void) controllerDidNotConnect: (HLX::Client::Application::Controller &)aController withURL: (NSURL *)aURLRef andError: (const HLX::Common::Error &)aError
-{
-    NSString *    lDescription;
-
-    lDescription = [NSString stringWithUTF8String: strerror(-aError)];
-
-    Log::Error().Write("Did not connect to %s: %d (%s).\n",
-                       [[aURLRef absoluteString] UTF8String],
-                       aError,
-                       [lDescription UTF8String]);
-
-    // At this point, the modal connection progress alert controller
-    // posted in controllerWillConnect is still up and needs to be
-    // dismissed before another alert controller describing the
-    // connect failure can be presented. Dismiss the prior alert
-    // controller, triggering presentation of the new alert controller
-    // on the completion.
-
-    [mAlertController dismissViewControllerAnimated: NO
-                                         completion: ^(void) {
-        [self didNotConnectWithURL: aURLRef
-              andError: aError
-              withDescription: lDescription];
-
-        // At this point, the connect button was disabled to handle
-        // the connect; re-enable it.
-
-        self.mConnectButton.enabled = YES;
-    }];
-}
-
-- (void) controllerWillRefresh: (HLX::Client::Application::ControllerBasis &)aController
-{
-    DeclareLogIndentWithValue(lLogIndent, 0);
-    DeclareLogLevelWithValue(lLogLevel, 1);
-
-    LogDebug(lLogIndent,
-             lLogLevel,
-             "Waiting for client data...\n");
-}
-
-- (void) controllerIsRefreshing: (HLX::Client::Application::ControllerBasis &)aController withProgress: (const uint8_t &)aPercentComplete
+/**
+ *  @brief
+ *    Dismiss the refresh view controller, if present, and segue to
+ *    the groups and zones view.
+ *
+ *  The refresh view controller is forgotten immediately, rather than
+ *  on completion of the dismissal, such that further client
+ *  controller delegations that arrive while the dismissal is in
+ *  progress do not trigger it again.
+ *
+ */
+- (void) dismissRefreshControllerAndSegue
 {
-    DeclareLogIndentWithValue(lLogIndent, 0);
-    DeclareLogLevelWithValue(lLogLevel, 1);
-    const float lPercentComplete = aPercentComplete / 100.0f;
+    RefreshViewController *  lRefreshController = mRefreshController;
 
-    LogDebug(lLogIndent,
-             lLogLevel,
-             "%hhu%% of client data received.\n", aPercentComplete);
-
-    [mRefreshController updateRefreshProgress: lPercentComplete];
-}
 
-- (void) controllerDidRefresh: (HLX::Client::Application::ControllerBasis &)aController
-{
-    DeclareLogIndentWithValue(lLogIndent, 0);
-    DeclareLogLevelWithValue(lLogLevel, 1);
+    nlEXPECT(lRefreshController != nullptr, done);
 
-    LogDebug(lLogIndent,
-             lLogLevel,
-             "Client data received...\n");
+    mRefreshController.mDelegate = nullptr;
+    mRefreshController = nullptr;
 
     // Stop the refresh view controller activity.
 
-    [mRefreshController stopRefreshActivity];
+    [lRefreshController stopRefreshActivity];
 
     // Dismiss the refreshing view controller and segue to the 'did
     // refresh' transition on completion of the dismissal.
 
-    [mRefreshController dismissViewControllerAnimated: NO
-                                         completion: ^(void) {
+    [lRefreshController dismissViewControllerAnimated: NO
+                                           completion: ^(void) {
         [self performSegueWithIdentifier: @"DidRefresh"
               sender: self];
-
-        self->mRefreshController.mDelegate = nullptr;
-        self->mRefreshController = nullptr;
     }];
-}
-
-- (void) controllerWillDisconnect: (HLX::Client::Application::Controller &)aController withURL: (NSURL *)aURLRef
-{
-    Log::Info().Write("Will disconnect from %s.\n", [[aURLRef absoluteString] UTF8String]);
-}
-
-- (void) controllerDidDisconnect: (HLX::Client::Application::Controller &)aController withURL: (NSURL *)aURLRef andError: (const HLX::Common::Error &)aError
-{
-    if (self->mRefreshController != nullptr)
-    {
-        [RefreshViewController viewPresentDidDisconnectAlert: self->mRefreshController
-                                withURL: aURLRef
-                               andError: aError
-                             andHandler: ^(UIAlertAction * aAction) {
-            // Stop the refresh view controller activity.
-
-            [self->mRefreshController stopRefreshActivity];
-
-            // Dismiss the refreshing view controller
-
-            [self->mRefreshController dismissViewControllerAnimated: NO
-                                                   completion: ^(void) {
-                self->mRefreshController.mDelegate = nullptr;
-                self->mRefreshController           = nullptr;
-            }];
-        }];
-    }
-
-    // We are now disconnected; re-enable the connect button.
-    
-    self.mConnectButton.enabled = YES;
-}
-
-// MARK: Refresh View Controller Delegations
-
-- (void) controllerDidAppear: (RefreshViewController *)aController
-{
-    Status lStatus;
-
-    [self->mRefreshController startRefreshActivity];
-
-    lStatus = self->mApplicationController->Refresh();
-    nlREQUIRE_SUCCESS(lStatus, done);
 
  done:
     return;
 }
 
-- (void) controllerShouldDisconnect: (RefreshViewController *)aController
-{
-    // Stop the refresh view controller activity.
-
-    [aController stopRefreshActivity];
-
-    mApplicationController->Disconnect();
-}
-
-// MARK: Workers
-
 - (void) didNotConnectWithURL: (NSURL *)aURLRef andError: (const HLX::Common::Error &)aError withDescription: (NSString *)aDescription
 {
     UIAlertController *lAlertController;
@@ -36,6 +36,7 @@
 #include <OpenHLX/Model/CrossoverModel.hpp>
 #include <OpenHLX/Utilities/Assert.hpp>
 
+#import "AppDelegate.h"
 #import "UIViewController+HLXClientDidDisconnectDelegateDefaultImplementations.h"
 #import "UIViewController+TopViewController.h"
 
@@ -101,12 +102,13 @@ class Controller;
 
 - (void) viewWillAppear: (BOOL)aAnimated
 {
+    AppDelegate *      lDelegate = [AppDelegate sharedDelegate];
     Status             lStatus;
 
 
     [super viewWillAppear: aAnimated];
 
-    lStatus = mApplicationController->SetDelegate(mApplicationControllerDelegate.get());
+    lStatus = [lDelegate stateChangeBus].SetDelegate(mApplicationControllerDelegate.get());
     nlREQUIRE_SUCCESS(lStatus, done);
 
     [self refreshCrossoverFrequency];
@@ -303,20 +305,35 @@ done:
 
 - (void) setCrossoverFrequency: (const CrossoverModel::FrequencyType &)aFrequency
 {
-    ZoneModel::IdentifierType  lIdentifier;
-    Status                     lStatus;
+    AppDelegate *                        lDelegate = [AppDelegate sharedDelegate];
+    MutableApplicationControllerPointer  lApplicationController = mApplicationController;
+    ZoneModel::IdentifierType            lIdentifier;
+    Status                               lStatus;
 
     lStatus = mZone->GetIdentifier(lIdentifier);
     nlREQUIRE_SUCCESS(lStatus, done);
 
+    // Slider value changes arrive far faster than the HLX can answer
+    // them; send only the latest.
+
     if (mIsHighpass)
     {
-        lStatus = mApplicationController->ZoneSetHighpassCrossover(lIdentifier, aFrequency);
+        lStatus = [lDelegate commandCoalescer].Submit(CommandCoalescer::Key(CommandCoalescer::kKindZone, lIdentifier, CommandCoalescer::kPropertyHighpassCrossover),
+                                                       aFrequency,
+                                                       mCurrentFrequency,
+                                                       [lApplicationController, lIdentifier](const CommandCoalescer::ValueType &aValue) {
+                                                           return (lApplicationController->ZoneSetHighpassCrossover(lIdentifier, static_cast<CrossoverModel::FrequencyType>(aValue)));
+                                                       });
         nlREQUIRE(lStatus >= kStatus_Success, done);
     }
     else
     {
-        lStatus = mApplicationController->ZoneSetLowpassCrossover(lIdentifier, aFrequency);
+        lStatus = [lDelegate commandCoalescer].Submit(CommandCoalescer::Key(CommandCoalescer::kKindZone, lIdentifier, CommandCoalescer::kPropertyLowpassCrossover),
+                                                       aFrequency,
+                                                       mCurrentFrequency,
+                                                       [lApplicationController, lIdentifier](const CommandCoalescer::ValueType &aValue) {
+                                                           return (lApplicationController->ZoneSetLowpassCrossover(lIdentifier, static_cast<CrossoverModel::FrequencyType>(aValue)));
+                                                       });
         nlREQUIRE(lStatus >= kStatus_Success, done);
     }
 
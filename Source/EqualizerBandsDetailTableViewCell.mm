@@ -33,6 +33,8 @@
 
 #include <OpenHLX/Utilities/Assert.hpp>
 
+#import "AppDelegate.h"
+
 
 using namespace HLX::Client;
 using namespace HLX::Common;
@@ -137,24 +139,36 @@ using namespace Nuovations;
         
         if (mIsPreset)
         {
-            EqualizerPresetModel::IdentifierType  lEqualizerPresetIdentifier;
+            AppDelegate *                            lDelegate = [AppDelegate sharedDelegate];
+            MutableApplicationControllerPointer      lApplicationController = mApplicationController;
+            const EqualizerBandModel::IdentifierType lEqualizerBandIdentifier = mEqualizerBandIdentifier;
+            EqualizerPresetModel::IdentifierType     lEqualizerPresetIdentifier;
             
 
             lStatus = mUnion.mEqualizerPresetModel->GetIdentifier(lEqualizerPresetIdentifier);
             nlREQUIRE_SUCCESS(lStatus, done);
 
-            lStatus = mApplicationController->EqualizerPresetDecreaseBand(lEqualizerPresetIdentifier, mEqualizerBandIdentifier);
+            lStatus = [lDelegate commandPipeline].Enqueue(CommandPipeline::kKindEqualizerPreset,
+                                                          lEqualizerPresetIdentifier,
+                                                          CommandPipeline::kAnswerEqualizerBand,
+                                                          [lApplicationController, lEqualizerPresetIdentifier, lEqualizerBandIdentifier]() { return (lApplicationController->EqualizerPresetDecreaseBand(lEqualizerPresetIdentifier, lEqualizerBandIdentifier)); });
             nlREQUIRE_SUCCESS(lStatus, done);
         }
         else
         {
-            ZoneModel::IdentifierType  lZoneIdentifier;
+            AppDelegate *                            lDelegate = [AppDelegate sharedDelegate];
+            MutableApplicationControllerPointer      lApplicationController = mApplicationController;
+            const EqualizerBandModel::IdentifierType lEqualizerBandIdentifier = mEqualizerBandIdentifier;
+            ZoneModel::IdentifierType                lZoneIdentifier;
 
 
             lStatus = mUnion.mZoneModel->GetIdentifier(lZoneIdentifier);
             nlREQUIRE_SUCCESS(lStatus, done);
 
-            lStatus = mApplicationController->ZoneDecreaseEqualizerBand(lZoneIdentifier, mEqualizerBandIdentifier);
+            lStatus = [lDelegate commandPipeline].Enqueue(CommandPipeline::kKindZone,
+                                                          lZoneIdentifier,
+                                                          CommandPipeline::kAnswerEqualizerBand,
+                                                          [lApplicationController, lZoneIdentifier, lEqualizerBandIdentifier]() { return (lApplicationController->ZoneDecreaseEqualizerBand(lZoneIdentifier, lEqualizerBandIdentifier)); });
             nlREQUIRE_SUCCESS(lStatus, done);
         }
     }
@@ -167,8 +181,16 @@ using namespace Nuovations;
 {
     if (aSender == self.mBandSlider)
     {
-        const EqualizerBandModel::LevelType  lLevel = static_cast<EqualizerBandModel::LevelType>(self.mBandSlider.value);
-        Status                               lStatus;
+        AppDelegate *                                   lDelegate = [AppDelegate sharedDelegate];
+        MutableApplicationControllerPointer             lApplicationController = mApplicationController;
+        const EqualizerBandModel::IdentifierType        lBandIdentifier = mEqualizerBandIdentifier;
+        const EqualizerBandModel::LevelType             lLevel = static_cast<EqualizerBandModel::LevelType>(self.mBandSlider.value);
+        const EqualizerBandModel *                      lEqualizerBandModel;
+        EqualizerBandModel::LevelType                   lModelLevel;
+        Status                                          lStatus;
+
+        // Slider value changes arrive far faster than the HLX can
+        // answer them; send only the latest.
 
         if (mIsPreset)
         {
@@ -178,8 +200,19 @@ using namespace Nuovations;
             lStatus = mUnion.mEqualizerPresetModel->GetIdentifier(lEqualizerPresetIdentifier);
             nlREQUIRE_SUCCESS(lStatus, done);
 
-            lStatus = mApplicationController->EqualizerPresetSetBand(lEqualizerPresetIdentifier, mEqualizerBandIdentifier, lLevel);
+            lStatus = mUnion.mEqualizerPresetModel->GetEqualizerBand(lBandIdentifier, lEqualizerBandModel);
+            nlREQUIRE_SUCCESS(lStatus, done);
+
+            lStatus = lEqualizerBandModel->GetLevel(lModelLevel);
             nlREQUIRE_SUCCESS(lStatus, done);
+
+            lStatus = [lDelegate commandCoalescer].Submit(CommandCoalescer::Key(CommandCoalescer::kKindEqualizerPreset, lEqualizerPresetIdentifier, CommandCoalescer::kPropertyEqualizerBand, lBandIdentifier),
+                                                           lLevel,
+                                                           lModelLevel,
+                                                           [lApplicationController, lEqualizerPresetIdentifier, lBandIdentifier](const CommandCoalescer::ValueType &aLevel) {
+                                                               return (lApplicationController->EqualizerPresetSetBand(lEqualizerPresetIdentifier, lBandIdentifier, static_cast<EqualizerBandModel::LevelType>(aLevel)));
+                                                           });
+            nlREQUIRE(lStatus >= kStatus_Success, done);
         }
         else
         {
@@ -189,8 +222,19 @@ using namespace Nuovations;
             lStatus = mUnion.mZoneModel->GetIdentifier(lZoneIdentifier);
             nlREQUIRE_SUCCESS(lStatus, done);
 
-            lStatus = mApplicationController->ZoneSetEqualizerBand(lZoneIdentifier, mEqualizerBandIdentifier, lLevel);
+            lStatus = mUnion.mZoneModel->GetEqualizerBand(lBandIdentifier, lEqualizerBandModel);
+            nlREQUIRE_SUCCESS(lStatus, done);
+
+            lStatus = lEqualizerBandModel->GetLevel(lModelLevel);
             nlREQUIRE_SUCCESS(lStatus, done);
+
+            lStatus = [lDelegate commandCoalescer].Submit(CommandCoalescer::Key(CommandCoalescer::kKindZone, lZoneIdentifier, CommandCoalescer::kPropertyEqualizerBand, lBandIdentifier),
+                                                           lLevel,
+                                                           lModelLevel,
+                                                           [lApplicationController, lZoneIdentifier, lBandIdentifier](const CommandCoalescer::ValueType &aLevel) {
+                                                               return (lApplicationController->ZoneSetEqualizerBand(lZoneIdentifier, lBandIdentifier, static_cast<EqualizerBandModel::LevelType>(aLevel)));
+                                                           });
+            nlREQUIRE(lStatus >= kStatus_Success, done);
         }
     }
 
@@ -206,24 +250,36 @@ using namespace Nuovations;
 
         if (mIsPreset)
         {
-            EqualizerPresetModel::IdentifierType  lEqualizerPresetIdentifier;
+            AppDelegate *                            lDelegate = [AppDelegate sharedDelegate];
+            MutableApplicationControllerPointer      lApplicationController = mApplicationController;
+            const EqualizerBandModel::IdentifierType lEqualizerBandIdentifier = mEqualizerBandIdentifier;
+            EqualizerPresetModel::IdentifierType     lEqualizerPresetIdentifier;
             
 
             lStatus = mUnion.mEqualizerPresetModel->GetIdentifier(lEqualizerPresetIdentifier);
             nlREQUIRE_SUCCESS(lStatus, done);
 
-            lStatus = mApplicationController->EqualizerPresetIncreaseBand(lEqualizerPresetIdentifier, mEqualizerBandIdentifier);
+            lStatus = [lDelegate commandPipeline].Enqueue(CommandPipeline::kKindEqualizerPreset,
+                                                          lEqualizerPresetIdentifier,
+                                                          CommandPipeline::kAnswerEqualizerBand,
+                                                          [lApplicationController, lEqualizerPresetIdentifier, lEqualizerBandIdentifier]() { return (lApplicationController->EqualizerPresetIncreaseBand(lEqualizerPresetIdentifier, lEqualizerBandIdentifier)); });
             nlREQUIRE_SUCCESS(lStatus, done);
         }
         else
         {
-            ZoneModel::IdentifierType  lZoneIdentifier;
+            AppDelegate *                            lDelegate = [AppDelegate sharedDelegate];
+            MutableApplicationControllerPointer      lApplicationController = mApplicationController;
+            const EqualizerBandModel::IdentifierType lEqualizerBandIdentifier = mEqualizerBandIdentifier;
+            ZoneModel::IdentifierType                lZoneIdentifier;
 
 
             lStatus = mUnion.mZoneModel->GetIdentifier(lZoneIdentifier);
             nlREQUIRE_SUCCESS(lStatus, done);
 
-            lStatus = mApplicationController->ZoneIncreaseEqualizerBand(lZoneIdentifier, mEqualizerBandIdentifier);
+            lStatus = [lDelegate commandPipeline].Enqueue(CommandPipeline::kKindZone,
+                                                          lZoneIdentifier,
+                                                          CommandPipeline::kAnswerEqualizerBand,
+                                                          [lApplicationController, lZoneIdentifier, lEqualizerBandIdentifier]() { return (lApplicationController->ZoneIncreaseEqualizerBand(lZoneIdentifier, lEqualizerBandIdentifier)); });
             nlREQUIRE_SUCCESS(lStatus, done);
         }
     }
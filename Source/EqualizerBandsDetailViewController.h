@@ -85,6 +85,8 @@ class ApplicationControllerDelegate;
 
 // MARK: Actions
 
+- (IBAction) onLoadButtonAction: (id)aSender;
+
 // MARK: Setters
 
 - (void) setApplicationController: (MutableApplicationControllerPointer &)aApplicationController
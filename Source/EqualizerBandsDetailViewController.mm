@@ -33,9 +33,12 @@
 #include <OpenHLX/Client/EqualizerPresetsStateChangeNotifications.hpp>
 #include <OpenHLX/Client/ZonesStateChangeNotifications.hpp>
 #include <OpenHLX/Model/EqualizerBandsModel.hpp>
+#include <OpenHLX/Model/EqualizerPresetModel.hpp>
 #include <OpenHLX/Utilities/Assert.hpp>
 
+#import "AppDelegate.h"
 #import "EqualizerBandsDetailTableViewCell.h"
+#import "EqualizerCurve.hpp"
 #import "UIViewController+HLXClientDidDisconnectDelegateDefaultImplementations.h"
 #import "UIViewController+TopViewController.h"
 
@@ -72,16 +75,22 @@ class Controller;
 - (void) viewDidLoad
 {
     [super viewDidLoad];
+
+    self.navigationItem.rightBarButtonItem = [[UIBarButtonItem alloc] initWithTitle: NSLocalizedString(@"Load", @"")
+                                                                              style: UIBarButtonItemStylePlain
+                                                                             target: self
+                                                                             action: @selector(onLoadButtonAction:)];
 }
 
 - (void) viewWillAppear: (BOOL)aAnimated
 {
-    Status  lStatus;
+    AppDelegate *  lDelegate = [AppDelegate sharedDelegate];
+    Status         lStatus;
 
 
     [super viewWillAppear: aAnimated];
 
-    lStatus = mApplicationController->SetDelegate(mApplicationControllerDelegate.get());
+    lStatus = [lDelegate stateChangeBus].SetDelegate(mApplicationControllerDelegate.get());
     nlREQUIRE_SUCCESS(lStatus, done);
 
     [self.tableView reloadData];
@@ -162,6 +171,72 @@ done:
 
 // MARK: Actions
 
+/**
+ *  @brief
+ *    This is the action handler for the load curve button.
+ *
+ *  This presents the equalizer presets, and a flat curve, any one of
+ *  which may be loaded, as a whole, into the zone equalizer.
+ *
+ *  @param[in]  aSender  The entity that triggered this action handler.
+ *
+ */
+- (IBAction) onLoadButtonAction: (id)aSender
+{
+    UIAlertController *              lAlertController;
+    IdentifierModel::IdentifierType  lEqualizerPresetsMax;
+    IdentifierModel::IdentifierType  lEqualizerPresetIdentifier;
+    Status                           lStatus;
+
+
+    lAlertController = [UIAlertController alertControllerWithTitle: NSLocalizedString(@"Load Equalizer", @"")
+                                          message: nullptr
+                                          preferredStyle: UIAlertControllerStyleActionSheet];
+
+    lStatus = mApplicationController->EqualizerPresetsGetMax(lEqualizerPresetsMax);
+    nlREQUIRE_SUCCESS(lStatus, done);
+
+    for (lEqualizerPresetIdentifier = IdentifierModel::kIdentifierMin; lEqualizerPresetIdentifier <= lEqualizerPresetsMax; lEqualizerPresetIdentifier++)
+    {
+        const IdentifierModel::IdentifierType  lIdentifier = lEqualizerPresetIdentifier;
+        const EqualizerPresetModel *           lEqualizerPreset;
+        const char *                           lUTF8StringName;
+
+        lStatus = mApplicationController->EqualizerPresetGet(lIdentifier, lEqualizerPreset);
+        nlREQUIRE_SUCCESS(lStatus, done);
+
+        lStatus = lEqualizerPreset->GetName(lUTF8StringName);
+        nlREQUIRE_SUCCESS(lStatus, done);
+
+        [lAlertController addAction: [UIAlertAction actionWithTitle: [NSString stringWithUTF8String: lUTF8StringName]
+                                                     style: UIAlertActionStyleDefault
+                                                     handler: ^(UIAlertAction * aAction) {
+            [self loadEqualizerPreset: lIdentifier];
+        }]];
+    }
+
+    [lAlertController addAction: [UIAlertAction actionWithTitle: NSLocalizedString(@"Flat", @"")
+                                                 style: UIAlertActionStyleDefault
+                                                 handler: ^(UIAlertAction * aAction) {
+        EqualizerCurve lEqualizerCurve;
+
+        [self loadEqualizerCurve: lEqualizerCurve];
+    }]];
+
+    [lAlertController addAction: [UIAlertAction actionWithTitle: NSLocalizedString(@"Cancel", @"")
+                                                 style: UIAlertActionStyleCancel
+                                                 handler: nullptr]];
+
+    lAlertController.popoverPresentationController.barButtonItem = self.navigationItem.rightBarButtonItem;
+
+    [self presentViewController: lAlertController
+                       animated: true
+                     completion: nullptr];
+
+ done:
+    return;
+}
+
 // MARK: Setters
 
 /**
@@ -228,6 +303,61 @@ done:
 
 // MARK: Workers
 
+/**
+ *  @brief
+ *    Load the curve of the specified equalizer preset into the zone
+ *    equalizer.
+ *
+ *  @param[in]  aEqualizerPresetIdentifier  The identifier of the
+ *                                          equalizer preset.
+ *
+ */
+- (void) loadEqualizerPreset: (const IdentifierModel::IdentifierType &)aEqualizerPresetIdentifier
+{
+    EqualizerCurve  lEqualizerCurve;
+    Status          lStatus;
+
+
+    lStatus = lEqualizerCurve.CaptureEqualizerPreset(mApplicationController, aEqualizerPresetIdentifier);
+    nlREQUIRE_SUCCESS(lStatus, done);
+
+    [self loadEqualizerCurve: lEqualizerCurve];
+
+ done:
+    return;
+}
+
+/**
+ *  @brief
+ *    Load the specified curve into the zone equalizer, sending only
+ *    the bands that differ from it.
+ *
+ *  @param[in]  aEqualizerCurve  The curve to load.
+ *
+ */
+- (void) loadEqualizerCurve: (const EqualizerCurve &)aEqualizerCurve
+{
+    AppDelegate *              lDelegate = [AppDelegate sharedDelegate];
+    ZoneModel::IdentifierType  lZoneIdentifier;
+    size_t                     lCount;
+    Status                     lStatus;
+
+
+    lStatus = mZone->GetIdentifier(lZoneIdentifier);
+    nlREQUIRE_SUCCESS(lStatus, done);
+
+    lStatus = aEqualizerCurve.ApplyToZone(mApplicationController,
+                                          lZoneIdentifier,
+                                          [lDelegate commandCoalescer],
+                                          lCount);
+    nlREQUIRE_SUCCESS(lStatus, done);
+
+    Log::Info().Write("Loaded equalizer curve into zone %u with %zu band(s).\n", lZoneIdentifier, lCount);
+
+ done:
+    return;
+}
+
 - (void) configureReusableCell: (EqualizerBandsDetailTableViewCell *)aCell forIndexPath: (NSIndexPath *)aIndexPath
 {
     const NSUInteger                          lSection = aIndexPath.section;
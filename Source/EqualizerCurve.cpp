@@ -0,0 +1,417 @@
+/*
+ *    Copyright (c) 2026 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *  @file
+ *    This file implements an object for capturing the ten-band level
+ *    curve of an HLX zone or equalizer preset equalizer and for
+ *    applying it to another, sending only the bands that differ.
+ *
+ */
+
+#include "EqualizerCurve.hpp"
+
+#include <functional>
+
+#include <errno.h>
+
+#include <LogUtilities/LogUtilities.hpp>
+
+#include <OpenHLX/Model/EqualizerPresetModel.hpp>
+#include <OpenHLX/Model/ZoneModel.hpp>
+#include <OpenHLX/Utilities/Assert.hpp>
+
+
+using namespace HLX::Common;
+using namespace HLX::Model;
+using namespace Nuovations;
+
+
+/**
+ *  A function that sends a set command for the level of a band of
+ *  the zone or equalizer preset being applied to.
+ *
+ */
+typedef std::function<Status (const EqualizerCurve::BandIdentifierType &aBand, const EqualizerCurve::LevelType &aLevel)> BandSetter;
+
+const size_t EqualizerCurve::kBandsMax;
+
+static bool
+IsValidBand(const EqualizerCurve::BandIdentifierType &aBand)
+{
+    return ((aBand >= IdentifierModel::kIdentifierMin) && (aBand < (IdentifierModel::kIdentifierMin + EqualizerCurve::kBandsMax)));
+}
+
+/*
+ *  Return the level of each band of a zone or equalizer preset, both
+ *  of which hold their bands alike.
+ */
+template <typename T>
+static Status
+GetLevels(const T &aModel, EqualizerCurve::LevelType aLevels[EqualizerCurve::kBandsMax])
+{
+    const EqualizerBandModel *          lEqualizerBand;
+    EqualizerCurve::BandIdentifierType  lBand;
+    Status                              lRetval = kStatus_Success;
+
+
+    for (lBand = IdentifierModel::kIdentifierMin; lBand < (IdentifierModel::kIdentifierMin + EqualizerCurve::kBandsMax); lBand++)
+    {
+        lRetval = aModel.GetEqualizerBand(lBand, lEqualizerBand);
+        nlREQUIRE_SUCCESS(lRetval, done);
+
+        lRetval = lEqualizerBand->GetLevel(aLevels[lBand - IdentifierModel::kIdentifierMin]);
+        nlREQUIRE_SUCCESS(lRetval, done);
+    }
+
+ done:
+    return (lRetval);
+}
+
+/*
+ *  Submit a set command, to be sent through the command pipeline,
+ *  for each band whose target level differs from what it will hold
+ *  once the commands already submitted for it are answered or,
+ *  otherwise, from its model level.
+ */
+static Status
+ApplyLevels(const EqualizerCurve::LevelType aTargets[EqualizerCurve::kBandsMax],
+            const EqualizerCurve::LevelType aModelLevels[EqualizerCurve::kBandsMax],
+            const CommandCoalescer::Kind &aCoalescerKind,
+            const EqualizerCurve::IdentifierType &aIdentifier,
+            const BandSetter &aSetter,
+            CommandCoalescer &aCommandCoalescer,
+            size_t &aCount)
+{
+    EqualizerCurve::BandIdentifierType  lBand;
+    Status                              lRetval = kStatus_Success;
+
+
+    aCount = 0;
+
+    for (lBand = IdentifierModel::kIdentifierMin; lBand < (IdentifierModel::kIdentifierMin + EqualizerCurve::kBandsMax); lBand++)
+    {
+        const CommandCoalescer::Key               lKey(aCoalescerKind, aIdentifier, CommandCoalescer::kPropertyEqualizerBand, lBand);
+        const EqualizerCurve::BandIdentifierType  lSetBand = lBand;
+        const size_t                              lIndex = (lBand - IdentifierModel::kIdentifierMin);
+        CommandCoalescer::ValueType               lCurrent;
+
+        if (aCommandCoalescer.GetValue(lKey, lCurrent) != kStatus_Success)
+        {
+            lCurrent = aModelLevels[lIndex];
+        }
+
+        if (lCurrent != aTargets[lIndex])
+        {
+            lRetval = aCommandCoalescer.Submit(lKey,
+                                               aTargets[lIndex],
+                                               aModelLevels[lIndex],
+                                               [lSetBand, aSetter](const CommandCoalescer::ValueType &aLevel) {
+                                                   return (aSetter(lSetBand, static_cast<EqualizerCurve::LevelType>(aLevel)));
+                                               });
+            nlREQUIRE_SUCCESS(lRetval, done);
+
+            aCount++;
+        }
+    }
+
+ done:
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    This is the class default constructor.
+ *
+ *  The curve is initially flat.
+ *
+ */
+EqualizerCurve :: EqualizerCurve(void)
+{
+    SetFlat();
+
+    return;
+}
+
+/**
+ *  @brief
+ *    This is the class destructor.
+ *
+ */
+EqualizerCurve :: ~EqualizerCurve(void)
+{
+    return;
+}
+
+// MARK: Capture
+
+/**
+ *  @brief
+ *    Capture the curve of the specified zone from the client
+ *    controller model.
+ *
+ *  @param[in]  aApplicationController  A reference to a shared
+ *                                      pointer to the client
+ *                                      controller.
+ *  @param[in]  aZoneIdentifier         The identifier of the zone.
+ *
+ *  @retval  kStatus_Success  If successful.
+ *  @retval  -ERANGE          If @a aZoneIdentifier was out of range.
+ *  @retval  -ENODATA         If a band level has not yet been
+ *                            refreshed.
+ *
+ */
+Status
+EqualizerCurve :: CaptureZone(const MutableApplicationControllerPointer &aApplicationController,
+                              const IdentifierType &aZoneIdentifier)
+{
+    const ZoneModel *  lZone;
+    Status             lRetval;
+
+
+    lRetval = aApplicationController->ZoneGet(aZoneIdentifier, lZone);
+    nlREQUIRE_SUCCESS(lRetval, done);
+
+    lRetval = GetLevels(*lZone, mLevels);
+    nlREQUIRE_SUCCESS(lRetval, done);
+
+ done:
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Capture the curve of the specified equalizer preset from the
+ *    client controller model.
+ *
+ *  @param[in]  aApplicationController      A reference to a shared
+ *                                          pointer to the client
+ *                                          controller.
+ *  @param[in]  aEqualizerPresetIdentifier  The identifier of the
+ *                                          equalizer preset.
+ *
+ *  @retval  kStatus_Success  If successful.
+ *  @retval  -ERANGE          If @a aEqualizerPresetIdentifier was
+ *                            out of range.
+ *  @retval  -ENODATA         If a band level has not yet been
+ *                            refreshed.
+ *
+ */
+Status
+EqualizerCurve :: CaptureEqualizerPreset(const MutableApplicationControllerPointer &aApplicationController,
+                                         const IdentifierType &aEqualizerPresetIdentifier)
+{
+    const EqualizerPresetModel *  lEqualizerPreset;
+    Status                        lRetval;
+
+
+    lRetval = aApplicationController->EqualizerPresetGet(aEqualizerPresetIdentifier, lEqualizerPreset);
+    nlREQUIRE_SUCCESS(lRetval, done);
+
+    lRetval = GetLevels(*lEqualizerPreset, mLevels);
+    nlREQUIRE_SUCCESS(lRetval, done);
+
+ done:
+    return (lRetval);
+}
+
+// MARK: Introspection
+
+/**
+ *  @brief
+ *    Return the level of the specified band.
+ *
+ *  @param[in]   aBand   The one-based band identifier.
+ *  @param[out]  aLevel  A reference to storage for the level.
+ *
+ *  @retval  kStatus_Success  If successful.
+ *  @retval  -ERANGE          If @a aBand was out of range.
+ *
+ */
+Status
+EqualizerCurve :: GetLevel(const BandIdentifierType &aBand, LevelType &aLevel) const
+{
+    Status  lRetval = kStatus_Success;
+
+
+    nlREQUIRE_ACTION(IsValidBand(aBand), done, lRetval = -ERANGE);
+
+    aLevel = mLevels[aBand - IdentifierModel::kIdentifierMin];
+
+ done:
+    return (lRetval);
+}
+
+// MARK: Mutation
+
+/**
+ *  @brief
+ *    Set the level of the specified band.
+ *
+ *  @param[in]  aBand   The one-based band identifier.
+ *  @param[in]  aLevel  The level.
+ *
+ *  @retval  kStatus_Success  If successful.
+ *  @retval  -ERANGE          If @a aBand or @a aLevel was out of
+ *                            range.
+ *
+ */
+Status
+EqualizerCurve :: SetLevel(const BandIdentifierType &aBand, const LevelType &aLevel)
+{
+    Status  lRetval = kStatus_Success;
+
+
+    nlREQUIRE_ACTION(IsValidBand(aBand), done, lRetval = -ERANGE);
+    nlREQUIRE_ACTION(aLevel >= EqualizerBandModel::kLevelMin, done, lRetval = -ERANGE);
+    nlREQUIRE_ACTION(aLevel <= EqualizerBandModel::kLevelMax, done, lRetval = -ERANGE);
+
+    mLevels[aBand - IdentifierModel::kIdentifierMin] = aLevel;
+
+ done:
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Set every band to the flat level.
+ *
+ */
+void
+EqualizerCurve :: SetFlat(void)
+{
+    for (size_t lIndex = 0; lIndex < kBandsMax; lIndex++)
+    {
+        mLevels[lIndex] = EqualizerBandModel::kLevelFlat;
+    }
+}
+
+// MARK: Application
+
+/**
+ *  @brief
+ *    Apply the curve to the specified zone.
+ *
+ *  @param[in]   aApplicationController  A reference to a shared
+ *                                       pointer to the client
+ *                                       controller.
+ *  @param[in]   aZoneIdentifier         The identifier of the zone.
+ *  @param[in]   aCommandCoalescer       The command coalescer to
+ *                                       submit band set commands to.
+ *  @param[out]  aCount                  The number of bands
+ *                                       submitted.
+ *
+ *  @retval  kStatus_Success  If successful.
+ *  @retval  -ERANGE          If @a aZoneIdentifier was out of range.
+ *  @retval  -ENODATA         If a band level has not yet been
+ *                            refreshed.
+ *
+ */
+Status
+EqualizerCurve :: ApplyToZone(const MutableApplicationControllerPointer &aApplicationController,
+                              const IdentifierType &aZoneIdentifier,
+                              CommandCoalescer &aCommandCoalescer,
+                              size_t &aCount) const
+{
+    MutableApplicationControllerPointer  lApplicationController = aApplicationController;
+    const IdentifierType                 lZoneIdentifier = aZoneIdentifier;
+    LevelType                            lModelLevels[kBandsMax];
+    const ZoneModel *                    lZone;
+    Status                               lRetval;
+
+
+    lRetval = aApplicationController->ZoneGet(aZoneIdentifier, lZone);
+    nlREQUIRE_SUCCESS(lRetval, done);
+
+    lRetval = GetLevels(*lZone, lModelLevels);
+    nlREQUIRE_SUCCESS(lRetval, done);
+
+    lRetval = ApplyLevels(mLevels,
+                          lModelLevels,
+                          CommandCoalescer::kKindZone,
+                          aZoneIdentifier,
+                          [lApplicationController, lZoneIdentifier](const BandIdentifierType &aBand, const LevelType &aLevel) {
+                              return (lApplicationController->ZoneSetEqualizerBand(lZoneIdentifier, aBand, aLevel));
+                          },
+                          aCommandCoalescer,
+                          aCount);
+    nlREQUIRE_SUCCESS(lRetval, done);
+
+    Log::Debug().Write("Equalizer curve applied to zone %u with %zu band(s).\n", aZoneIdentifier, aCount);
+
+ done:
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Apply the curve to the specified equalizer preset.
+ *
+ *  @param[in]   aApplicationController      A reference to a shared
+ *                                           pointer to the client
+ *                                           controller.
+ *  @param[in]   aEqualizerPresetIdentifier  The identifier of the
+ *                                           equalizer preset.
+ *  @param[in]   aCommandCoalescer           The command coalescer to
+ *                                           submit band set commands
+ *                                           to.
+ *  @param[out]  aCount                      The number of bands
+ *                                           submitted.
+ *
+ *  @retval  kStatus_Success  If successful.
+ *  @retval  -ERANGE          If @a aEqualizerPresetIdentifier was
+ *                            out of range.
+ *  @retval  -ENODATA         If a band level has not yet been
+ *                            refreshed.
+ *
+ */
+Status
+EqualizerCurve :: ApplyToEqualizerPreset(const MutableApplicationControllerPointer &aApplicationController,
+                                         const IdentifierType &aEqualizerPresetIdentifier,
+                                         CommandCoalescer &aCommandCoalescer,
+                                         size_t &aCount) const
+{
+    MutableApplicationControllerPointer  lApplicationController = aApplicationController;
+    const IdentifierType                 lEqualizerPresetIdentifier = aEqualizerPresetIdentifier;
+    LevelType                            lModelLevels[kBandsMax];
+    const EqualizerPresetModel *         lEqualizerPreset;
+    Status                               lRetval;
+
+
+    lRetval = aApplicationController->EqualizerPresetGet(aEqualizerPresetIdentifier, lEqualizerPreset);
+    nlREQUIRE_SUCCESS(lRetval, done);
+
+    lRetval = GetLevels(*lEqualizerPreset, lModelLevels);
+    nlREQUIRE_SUCCESS(lRetval, done);
+
+    lRetval = ApplyLevels(mLevels,
+                          lModelLevels,
+                          CommandCoalescer::kKindEqualizerPreset,
+                          aEqualizerPresetIdentifier,
+                          [lApplicationController, lEqualizerPresetIdentifier](const BandIdentifierType &aBand, const LevelType &aLevel) {
+                              return (lApplicationController->EqualizerPresetSetBand(lEqualizerPresetIdentifier, aBand, aLevel));
+                          },
+                          aCommandCoalescer,
+                          aCount);
+    nlREQUIRE_SUCCESS(lRetval, done);
+
+    Log::Debug().Write("Equalizer curve applied to equalizer preset %u with %zu band(s).\n", aEqualizerPresetIdentifier, aCount);
+
+ done:
+    return (lRetval);
+}
@@ -0,0 +1,105 @@
+/*
+ *    Copyright (c) 2026 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *  @file
+ *    This file defines an object for capturing the ten-band level
+ *    curve of an HLX zone or equalizer preset equalizer and for
+ *    applying it to another, sending only the bands that differ.
+ *
+ */
+
+#ifndef EQUALIZERCURVE_HPP
+#define EQUALIZERCURVE_HPP
+
+#include <stddef.h>
+
+#include <OpenHLX/Common/Errors.hpp>
+#include <OpenHLX/Model/EqualizerBandModel.hpp>
+#include <OpenHLX/Model/EqualizerBandsModel.hpp>
+#include <OpenHLX/Model/IdentifierModel.hpp>
+
+#include "ApplicationControllerPointer.hpp"
+#include "CommandCoalescer.hpp"
+
+
+/**
+ *  @brief
+ *    An object for capturing and applying an HLX equalizer curve.
+ *
+ *  A curve is the level of each of the equalizer bands. It may be
+ *  captured from a zone or an equalizer preset in the client
+ *  controller model, or set band by band, for example, from a curve
+ *  an installer saved earlier.
+ *
+ *  Applying a curve to a zone or an equalizer preset compares each
+ *  band against what it will hold once any commands already
+ *  submitted for it are answered or, otherwise, against the model,
+ *  and sends a set command for only those bands that differ. Each is
+ *  submitted to the command coalescer, such that a band still in
+ *  flight from an earlier edit or apply is sent only its latest
+ *  level, and the coalescer sends each through the command pipeline,
+ *  such that the bands are paced to what the peer answers rather
+ *  than written to it all at once.
+ *
+ */
+class EqualizerCurve
+{
+public:
+    typedef HLX::Model::IdentifierModel::IdentifierType     IdentifierType;
+    typedef HLX::Model::EqualizerBandModel::IdentifierType  BandIdentifierType;
+    typedef HLX::Model::EqualizerBandModel::LevelType       LevelType;
+
+    static const size_t kBandsMax = HLX::Model::EqualizerBandsModel::kEqualizerBandsMax;
+
+public:
+    EqualizerCurve(void);
+    ~EqualizerCurve(void);
+
+    // Capture
+
+    HLX::Common::Status CaptureZone(const MutableApplicationControllerPointer &aApplicationController,
+                                    const IdentifierType &aZoneIdentifier);
+    HLX::Common::Status CaptureEqualizerPreset(const MutableApplicationControllerPointer &aApplicationController,
+                                               const IdentifierType &aEqualizerPresetIdentifier);
+
+    // Introspection
+
+    HLX::Common::Status GetLevel(const BandIdentifierType &aBand, LevelType &aLevel) const;
+
+    // Mutation
+
+    HLX::Common::Status SetLevel(const BandIdentifierType &aBand, const LevelType &aLevel);
+    void                SetFlat(void);
+
+    // Application
+
+    HLX::Common::Status ApplyToZone(const MutableApplicationControllerPointer &aApplicationController,
+                                    const IdentifierType &aZoneIdentifier,
+                                    CommandCoalescer &aCommandCoalescer,
+                                    size_t &aCount) const;
+    HLX::Common::Status ApplyToEqualizerPreset(const MutableApplicationControllerPointer &aApplicationController,
+                                               const IdentifierType &aEqualizerPresetIdentifier,
+                                               CommandCoalescer &aCommandCoalescer,
+                                               size_t &aCount) const;
+
+private:
+    LevelType  mLevels[kBandsMax];
+};
+
+#endif // EQUALIZERCURVE_HPP
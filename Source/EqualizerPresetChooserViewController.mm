@@ -35,6 +35,7 @@
 #include <OpenHLX/Model/EqualizerBandsModel.hpp>
 #include <OpenHLX/Utilities/Assert.hpp>
 
+#import "AppDelegate.h"
 #import "EqualizerPresetChooserTableViewCell.h"
 #import "UIViewController+HLXClientDidDisconnectDelegateDefaultImplementations.h"
 #import "UIViewController+TopViewController.h"
@@ -114,12 +115,13 @@ static NSArray *indexPathsForEqualizerPreset(const SoundModel::SoundMode &aEqual
 
 - (void) viewWillAppear: (BOOL)aAnimated
 {
-    Status  lStatus;
+    AppDelegate *  lDelegate = [AppDelegate sharedDelegate];
+    Status         lStatus;
 
 
     [super viewWillAppear: aAnimated];
 
-    lStatus = mApplicationController->SetDelegate(mApplicationControllerDelegate.get());
+    lStatus = [lDelegate stateChangeBus].SetDelegate(mApplicationControllerDelegate.get());
     nlREQUIRE_SUCCESS(lStatus, done);
 
 done:
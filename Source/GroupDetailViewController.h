@@ -124,6 +124,7 @@ class ApplicationControllerDelegate;
 
 // MARK: Actions
 
+- (IBAction) onFadeButtonAction: (id)aSender;
 - (IBAction) onMuteSwitchAction: (id)aSender;
 - (IBAction) onVolumeDecreaseButtonAction: (id)aSender;
 - (IBAction) onVolumeSliderAction: (id)aSender;
@@ -32,10 +32,11 @@
 
 #include <OpenHLX/Client/ApplicationControllerDelegate.hpp>
 #include <OpenHLX/Client/GroupsStateChangeNotifications.hpp>
-#include <OpenHLX/Client/GroupsStateChangeNotifications.hpp>
+#include <OpenHLX/Client/SourcesStateChangeNotifications.hpp>
 #include <OpenHLX/Model/VolumeModel.hpp>
 #include <OpenHLX/Utilities/Assert.hpp>
 
+#import "AppDelegate.h"
 #import "ApplicationControllerDelegate.hpp"
 #import "GroupsAndZonesTableViewCell.h"
 #import "SourceChooserViewController.h"
@@ -79,17 +80,23 @@ class Controller;
     self.mVolumeSlider.minimumValue = static_cast<float>(VolumeModel::kLevelMin);
     self.mVolumeSlider.maximumValue = static_cast<float>(VolumeModel::kLevelMax);
 
+    self.navigationItem.rightBarButtonItem = [[UIBarButtonItem alloc] initWithTitle: NSLocalizedString(@"Fade", @"")
+                                                                              style: UIBarButtonItemStylePlain
+                                                                             target: self
+                                                                             action: @selector(onFadeButtonAction:)];
+
     return;
 }
 
 - (void) viewWillAppear: (BOOL)aAnimated
 {
+    AppDelegate *      lDelegate = [AppDelegate sharedDelegate];
     Status             lStatus;
 
 
     [super viewWillAppear: aAnimated];
 
-    lStatus = mApplicationController->SetDelegate(mApplicationControllerDelegate.get());
+    lStatus = [lDelegate stateChangeBus].SetDelegate(mApplicationControllerDelegate.get());
     nlREQUIRE_SUCCESS(lStatus, done);
 
     [self refreshGroupMute];
@@ -170,6 +177,8 @@ done:
 
 - (void)prepareForSegue: (UIStoryboardSegue *)aSegue sender: (id)aSender
 {
+    AppDelegate *lDelegate = [AppDelegate sharedDelegate];
+
     if ([aSender isKindOfClass: [UITableViewCell class]])
     {
         SourceChooserViewController *  lSourceChooserViewController = [aSegue destinationViewController];
@@ -179,7 +188,7 @@ done:
         [lSourceChooserViewController setApplicationController: mApplicationController
                                                     forGroup: mGroup];
 
-        lStatus = mApplicationController->SetDelegate(nullptr);
+        lStatus = [lDelegate stateChangeBus].SetDelegate(nullptr);
         nlREQUIRE_SUCCESS(lStatus, done);
     }
 
@@ -189,6 +198,58 @@ done:
 
 // MARK: Actions
 
+/**
+ *  @brief
+ *    This is the action handler for the volume fade button.
+ *
+ *  This prompts for the volume level to fade the group to and the
+ *  number of seconds over which to do so.
+ *
+ *  @param[in]  aSender  The entity that triggered this action handler.
+ *
+ */
+- (IBAction) onFadeButtonAction: (id)aSender
+{
+    UIAlertController *           lAlertController;
+    __weak UIAlertController *    lWeakAlertController;
+
+
+    lAlertController = [UIAlertController alertControllerWithTitle: NSLocalizedString(@"Fade Volume", @"")
+                                          message: [NSString stringWithFormat: NSLocalizedString(@"Fade to a level from %d to %d over a number of seconds.", @""),
+                                                    VolumeModel::kLevelMin,
+                                                    VolumeModel::kLevelMax]
+                                          preferredStyle: UIAlertControllerStyleAlert];
+
+    lWeakAlertController = lAlertController;
+
+    [lAlertController addTextFieldWithConfigurationHandler: ^(UITextField * aTextField) {
+        aTextField.placeholder = NSLocalizedString(@"Level", @"");
+        aTextField.keyboardType = UIKeyboardTypeNumbersAndPunctuation;
+    }];
+
+    [lAlertController addTextFieldWithConfigurationHandler: ^(UITextField * aTextField) {
+        aTextField.placeholder = NSLocalizedString(@"Seconds", @"");
+        aTextField.keyboardType = UIKeyboardTypeDecimalPad;
+    }];
+
+    [lAlertController addAction: [UIAlertAction actionWithTitle: NSLocalizedString(@"Cancel", @"")
+                                                 style: UIAlertActionStyleCancel
+                                                 handler: nullptr]];
+
+    [lAlertController addAction: [UIAlertAction actionWithTitle: NSLocalizedString(@"Fade", @"")
+                                                 style: UIAlertActionStyleDefault
+                                                 handler: ^(UIAlertAction * aAction) {
+        NSArray<UITextField *> * lTextFields = [lWeakAlertController textFields];
+
+        [self fadeVolumeToLevel: [[lTextFields objectAtIndex: 0] text]
+                    overSeconds: [[lTextFields objectAtIndex: 1] text]];
+    }]];
+
+    [self presentViewController: lAlertController
+                       animated: true
+                     completion: nullptr];
+}
+
 /**
  *  @brief
  *    This is the action handler for the volume mute state switch.
@@ -200,14 +261,22 @@ done:
 {
     if (aSender == self.mMuteSwitch)
     {
-        const VolumeModel::MuteType lMute = static_cast<VolumeModel::MuteType>(self.mMuteSwitch.on);
-        GroupModel::IdentifierType  lIdentifier;
-        Status                      lStatus;
+        AppDelegate *                       lDelegate = [AppDelegate sharedDelegate];
+        MutableApplicationControllerPointer lApplicationController = mApplicationController;
+        const VolumeModel::MuteType         lMute = static_cast<VolumeModel::MuteType>(self.mMuteSwitch.on);
+        GroupModel::IdentifierType          lIdentifier;
+        Status                              lStatus;
 
         lStatus = mGroup->GetIdentifier(lIdentifier);
         nlREQUIRE_SUCCESS(lStatus, done);
 
-        lStatus = mApplicationController->GroupSetMute(lIdentifier, lMute);
+        // A mute must not wait behind queued background queries.
+
+        lStatus = [lDelegate commandPipeline].Enqueue(CommandPipeline::kKindGroup,
+                                                      lIdentifier,
+                                                      CommandPipeline::kAnswerMute,
+                                                      CommandScheduler::kLaneInteractive,
+                                                      [lApplicationController, lIdentifier, lMute]() { return (lApplicationController->GroupSetMute(lIdentifier, lMute)); });
         nlEXPECT(lStatus >= 0, done);
     }
 
@@ -227,13 +296,22 @@ done:
 {
     if (aSender == self.mVolumeDecreaseButton)
     {
-        GroupModel::IdentifierType  lIdentifier;
-        Status                      lStatus;
+        AppDelegate *                       lDelegate = [AppDelegate sharedDelegate];
+        MutableApplicationControllerPointer lApplicationController = mApplicationController;
+        GroupModel::IdentifierType          lIdentifier;
+        Status                              lStatus;
 
         lStatus = mGroup->GetIdentifier(lIdentifier);
         nlREQUIRE_SUCCESS(lStatus, done);
 
-        lStatus = mApplicationController->GroupDecreaseVolume(lIdentifier);
+        // Any manual change takes over from a fade in progress.
+
+        [lDelegate volumeFader].Cancel(VolumeFader::kKindGroup, lIdentifier);
+
+        lStatus = [lDelegate commandPipeline].Enqueue(CommandPipeline::kKindGroup,
+                                                      lIdentifier,
+                                                      CommandPipeline::kAnswerVolume,
+                                                      [lApplicationController, lIdentifier]() { return (lApplicationController->GroupDecreaseVolume(lIdentifier)); });
         nlEXPECT(lStatus >= 0, done);
     }
 
@@ -253,14 +331,32 @@ done:
 {
     if (aSender == self.mVolumeSlider)
     {
-        const VolumeModel::LevelType lVolume = static_cast<VolumeModel::LevelType>(self.mVolumeSlider.value);
-        GroupModel::IdentifierType   lIdentifier;
-        Status                       lStatus;
+        AppDelegate *                       lDelegate = [AppDelegate sharedDelegate];
+        MutableApplicationControllerPointer lApplicationController = mApplicationController;
+        const VolumeModel::LevelType        lVolume = static_cast<VolumeModel::LevelType>(self.mVolumeSlider.value);
+        VolumeModel::LevelType              lModelVolume;
+        GroupModel::IdentifierType          lIdentifier;
+        Status                              lStatus;
 
         lStatus = mGroup->GetIdentifier(lIdentifier);
         nlREQUIRE_SUCCESS(lStatus, done);
 
-        lStatus = mApplicationController->GroupSetVolume(lIdentifier, lVolume);
+        // Any manual change takes over from a fade in progress.
+
+        [lDelegate volumeFader].Cancel(VolumeFader::kKindGroup, lIdentifier);
+
+        lStatus = mGroup->GetVolume(lModelVolume);
+        nlREQUIRE_SUCCESS(lStatus, done);
+
+        // Slider value changes arrive far faster than the HLX can
+        // answer them; send only the latest.
+
+        lStatus = [lDelegate commandCoalescer].Submit(CommandCoalescer::Key(CommandCoalescer::kKindGroup, lIdentifier, CommandCoalescer::kPropertyVolume),
+                                                       lVolume,
+                                                       lModelVolume,
+                                                       [lApplicationController, lIdentifier](const CommandCoalescer::ValueType &aVolume) {
+                                                           return (lApplicationController->GroupSetVolume(lIdentifier, static_cast<VolumeModel::LevelType>(aVolume)));
+                                                       });
         nlEXPECT(lStatus >= 0, done);
     }
 
@@ -280,13 +376,22 @@ done:
 {
     if (aSender == self.mVolumeIncreaseButton)
     {
-        GroupModel::IdentifierType lIdentifier;
-        Status                     lStatus;
+        AppDelegate *                       lDelegate = [AppDelegate sharedDelegate];
+        MutableApplicationControllerPointer lApplicationController = mApplicationController;
+        GroupModel::IdentifierType          lIdentifier;
+        Status                              lStatus;
 
         lStatus = mGroup->GetIdentifier(lIdentifier);
         nlREQUIRE_SUCCESS(lStatus, done);
 
-        lStatus = mApplicationController->GroupIncreaseVolume(lIdentifier);
+        // Any manual change takes over from a fade in progress.
+
+        [lDelegate volumeFader].Cancel(VolumeFader::kKindGroup, lIdentifier);
+
+        lStatus = [lDelegate commandPipeline].Enqueue(CommandPipeline::kKindGroup,
+                                                      lIdentifier,
+                                                      CommandPipeline::kAnswerVolume,
+                                                      [lApplicationController, lIdentifier]() { return (lApplicationController->GroupIncreaseVolume(lIdentifier)); });
         nlEXPECT(lStatus >= 0, done);
     }
 
@@ -322,6 +427,64 @@ done:
 
 // MARK: Workers
 
+/**
+ *  @brief
+ *    Fade the group volume from its current level to the specified
+ *    level over the specified number of seconds.
+ *
+ *  The current level is the one most recently submitted to the
+ *  command coalescer, if any, such that a fade started during or just
+ *  after a slider drag starts from where the slider was left.
+ *
+ *  @param[in]  aLevel    A pointer to the text of the volume level
+ *                        to fade to.
+ *  @param[in]  aSeconds  A pointer to the text of the number of
+ *                        seconds over which to fade.
+ *
+ */
+- (void) fadeVolumeToLevel: (NSString *)aLevel overSeconds: (NSString *)aSeconds
+{
+    AppDelegate *                       lDelegate = [AppDelegate sharedDelegate];
+    MutableApplicationControllerPointer lApplicationController = mApplicationController;
+    const NSInteger                     lTarget = [aLevel integerValue];
+    const double                        lSeconds = [aSeconds doubleValue];
+    GroupModel::IdentifierType          lIdentifier;
+    VolumeModel::LevelType              lCurrent;
+    CommandCoalescer::ValueType         lCoalescedVolume;
+    Status                              lStatus;
+
+
+    nlEXPECT([aLevel length] > 0, done);
+    nlEXPECT((lTarget >= VolumeModel::kLevelMin) && (lTarget <= VolumeModel::kLevelMax), done);
+    nlEXPECT(lSeconds >= 0, done);
+
+    lStatus = mGroup->GetIdentifier(lIdentifier);
+    nlREQUIRE_SUCCESS(lStatus, done);
+
+    lStatus = mGroup->GetVolume(lCurrent);
+    nlREQUIRE_SUCCESS(lStatus, done);
+
+    lStatus = [lDelegate commandCoalescer].GetValue(CommandCoalescer::Key(CommandCoalescer::kKindGroup, lIdentifier, CommandCoalescer::kPropertyVolume),
+                                                     lCoalescedVolume);
+    if (lStatus == kStatus_Success)
+    {
+        lCurrent = static_cast<VolumeModel::LevelType>(lCoalescedVolume);
+    }
+
+    lStatus = [lDelegate volumeFader].Start(VolumeFader::kKindGroup,
+                                            lIdentifier,
+                                            lCurrent,
+                                            static_cast<VolumeModel::LevelType>(lTarget),
+                                            VolumeFader::Duration(static_cast<VolumeFader::Duration::rep>(lSeconds * 1000)),
+                                            [lApplicationController, lIdentifier](const VolumeFader::LevelType &aLevel) {
+                                                return (lApplicationController->GroupSetVolume(lIdentifier, aLevel));
+                                            });
+    nlREQUIRE_SUCCESS(lStatus, done);
+
+ done:
+    return;
+}
+
 - (void) refreshGroupMute
 {
     VolumeModel::MuteType        lMute = true;
@@ -441,9 +604,28 @@ done:
     {
 
     case StateChange::kStateChangeType_SourceName:
-        // Refresh on any group source name change
+        {
+            const StateChange::SourcesNameNotification &lSCN = static_cast<const StateChange::SourcesNameNotification &>(aStateChangeNotification);
+            SourceModel::IdentifierType lOurSourceIdentifier;
+            size_t lSourceCount;
+            Status lStatus;
 
-        [self refreshGroupSourceName];
+            // Refresh only on a name change to the group's own
+            // source. A group with more than one source shows no
+            // source name to refresh.
+
+            lStatus = mGroup->GetSources(lSourceCount);
+            nlREQUIRE_SUCCESS(lStatus, done);
+
+            nlEXPECT(lSourceCount == 1, done);
+
+            lStatus = mGroup->GetSources(&lOurSourceIdentifier, lSourceCount);
+            nlREQUIRE_SUCCESS(lStatus, done);
+
+            nlEXPECT(lSCN.GetIdentifier() == lOurSourceIdentifier, done);
+
+            [self refreshGroupSourceName];
+        }
         break;
 
     case StateChange::kStateChangeType_GroupMute:
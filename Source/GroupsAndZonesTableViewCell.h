@@ -159,6 +159,10 @@ class ZoneModel;
 - (HLX::Common::Status) configureCellForIdentifier: (const HLX::Model::IdentifierModel::IdentifierType &)aIdentifier
                                     withController: (MutableApplicationControllerPointer &)aApplicationController
                                            asGroup: (bool)aIsGroup;
+- (HLX::Common::Status) configureCellForIdentifier: (const HLX::Model::IdentifierModel::IdentifierType &)aIdentifier
+                                    withController: (MutableApplicationControllerPointer &)aApplicationController
+                                           asGroup: (bool)aIsGroup
+                                    andCachedState: (NSDictionary *)aCachedState;
 
 @end
 
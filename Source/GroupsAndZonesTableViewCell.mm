@@ -35,6 +35,9 @@
 #include <OpenHLX/Model/VolumeModel.hpp>
 #include <OpenHLX/Utilities/Assert.hpp>
 
+#import "AppDelegate.h"
+#import "StateCacheController.h"
+
 
 using namespace HLX::Client;
 using namespace HLX::Common;
@@ -140,9 +143,18 @@ using namespace Nuovations;
 {
     if (aSender == self.mMuteSwitch)
     {
+        AppDelegate *lDelegate = [AppDelegate sharedDelegate];
+        MutableApplicationControllerPointer lApplicationController = mApplicationController;
         const VolumeModel::MuteType lMute = static_cast<VolumeModel::MuteType>(self.mMuteSwitch.on);
+        VolumeModel::MuteType lModelMute;
         Status lStatus;
 
+        // Submit through the coalescer such that the new mute state
+        // is rendered optimistically, should the row be reloaded,
+        // until it is answered. The coalescer sends it through the
+        // command pipeline, in the interactive lane, ahead of any
+        // queued queries.
+
         if (mIsGroup)
         {
             GroupModel::IdentifierType lIdentifier;
@@ -150,7 +162,15 @@ using namespace Nuovations;
             lStatus = mUnion.mGroup->GetIdentifier(lIdentifier);
             nlREQUIRE_SUCCESS(lStatus, done);
 
-            lStatus = mApplicationController->GroupSetMute(lIdentifier, lMute);
+            lStatus = mUnion.mGroup->GetMute(lModelMute);
+            nlREQUIRE_SUCCESS(lStatus, done);
+
+            lStatus = [lDelegate commandCoalescer].Submit(CommandCoalescer::Key(CommandCoalescer::kKindGroup, lIdentifier, CommandCoalescer::kPropertyMute),
+                                                           lMute,
+                                                           lModelMute,
+                                                           [lApplicationController, lIdentifier](const CommandCoalescer::ValueType &aMute) {
+                                                               return (lApplicationController->GroupSetMute(lIdentifier, static_cast<VolumeModel::MuteType>(aMute)));
+                                                           });
             nlEXPECT(lStatus >= 0, done);
         }
         else
@@ -160,7 +180,15 @@ using namespace Nuovations;
             lStatus = mUnion.mZone->GetIdentifier(lIdentifier);
             nlREQUIRE_SUCCESS(lStatus, done);
 
-            lStatus = mApplicationController->ZoneSetMute(lIdentifier, lMute);
+            lStatus = mUnion.mZone->GetMute(lModelMute);
+            nlREQUIRE_SUCCESS(lStatus, done);
+
+            lStatus = [lDelegate commandCoalescer].Submit(CommandCoalescer::Key(CommandCoalescer::kKindZone, lIdentifier, CommandCoalescer::kPropertyMute),
+                                                           lMute,
+                                                           lModelMute,
+                                                           [lApplicationController, lIdentifier](const CommandCoalescer::ValueType &aMute) {
+                                                               return (lApplicationController->ZoneSetMute(lIdentifier, static_cast<VolumeModel::MuteType>(aMute)));
+                                                           });
             nlEXPECT(lStatus >= 0, done);
         }
     }
@@ -185,22 +213,32 @@ using namespace Nuovations;
 
         if (mIsGroup)
         {
-            GroupModel::IdentifierType lIdentifier;
+            AppDelegate *                       lDelegate = [AppDelegate sharedDelegate];
+            MutableApplicationControllerPointer lApplicationController = mApplicationController;
+            GroupModel::IdentifierType          lIdentifier;
 
             lStatus = mUnion.mGroup->GetIdentifier(lIdentifier);
             nlREQUIRE_SUCCESS(lStatus, done);
 
-            lStatus = mApplicationController->GroupDecreaseVolume(lIdentifier);
+            lStatus = [lDelegate commandPipeline].Enqueue(CommandPipeline::kKindGroup,
+                                                          lIdentifier,
+                                                          CommandPipeline::kAnswerVolume,
+                                                          [lApplicationController, lIdentifier]() { return (lApplicationController->GroupDecreaseVolume(lIdentifier)); });
             nlEXPECT(lStatus >= 0, done);
         }
         else
         {
-            ZoneModel::IdentifierType lIdentifier;
+            AppDelegate *                       lDelegate = [AppDelegate sharedDelegate];
+            MutableApplicationControllerPointer lApplicationController = mApplicationController;
+            ZoneModel::IdentifierType           lIdentifier;
 
             lStatus = mUnion.mZone->GetIdentifier(lIdentifier);
             nlREQUIRE_SUCCESS(lStatus, done);
 
-            lStatus = mApplicationController->ZoneDecreaseVolume(lIdentifier);
+            lStatus = [lDelegate commandPipeline].Enqueue(CommandPipeline::kKindZone,
+                                                          lIdentifier,
+                                                          CommandPipeline::kAnswerVolume,
+                                                          [lApplicationController, lIdentifier]() { return (lApplicationController->ZoneDecreaseVolume(lIdentifier)); });
             nlEXPECT(lStatus >= 0, done);
         }
     }
@@ -221,29 +259,58 @@ using namespace Nuovations;
 {
     if (aSender == self.mVolumeSlider)
     {
+        AppDelegate *lDelegate = [AppDelegate sharedDelegate];
+        MutableApplicationControllerPointer lApplicationController = mApplicationController;
         const VolumeModel::LevelType lVolume = static_cast<VolumeModel::LevelType>(self.mVolumeSlider.value);
+        VolumeModel::LevelType lModelVolume;
+        CommandCoalescer::Setter lSetter;
+        IdentifierModel::IdentifierType lIdentifier;
+        Status lModelStatus;
         Status lStatus;
 
         if (mIsGroup)
         {
-            GroupModel::IdentifierType lIdentifier;
-
             lStatus = mUnion.mGroup->GetIdentifier(lIdentifier);
             nlREQUIRE_SUCCESS(lStatus, done);
 
-            lStatus = mApplicationController->GroupSetVolume(lIdentifier, lVolume);
-            nlEXPECT(lStatus >= 0, done);
+            lModelStatus = mUnion.mGroup->GetVolume(lModelVolume);
+
+            lSetter = [lApplicationController, lIdentifier](const CommandCoalescer::ValueType &aVolume) {
+                return (lApplicationController->GroupSetVolume(lIdentifier, static_cast<VolumeModel::LevelType>(aVolume)));
+            };
         }
         else
         {
-            ZoneModel::IdentifierType lIdentifier;
-
             lStatus = mUnion.mZone->GetIdentifier(lIdentifier);
             nlREQUIRE_SUCCESS(lStatus, done);
 
-            lStatus = mApplicationController->ZoneSetVolume(lIdentifier, lVolume);
-            nlEXPECT(lStatus >= 0, done);
+            lModelStatus = mUnion.mZone->GetVolume(lModelVolume);
+
+            lSetter = [lApplicationController, lIdentifier](const CommandCoalescer::ValueType &aVolume) {
+                return (lApplicationController->ZoneSetVolume(lIdentifier, static_cast<VolumeModel::LevelType>(aVolume)));
+            };
         }
+
+        // Slider value changes arrive far faster than the HLX can
+        // answer them; send only the latest. While the refresh is
+        // still in progress, the model may not yet hold a volume to
+        // compare against.
+
+        {
+            const CommandCoalescer::Key lKey((mIsGroup ? CommandCoalescer::kKindGroup : CommandCoalescer::kKindZone),
+                                             lIdentifier,
+                                             CommandCoalescer::kPropertyVolume);
+
+            if (lModelStatus == kStatus_Success)
+            {
+                lStatus = [lDelegate commandCoalescer].Submit(lKey, lVolume, lModelVolume, lSetter);
+            }
+            else
+            {
+                lStatus = [lDelegate commandCoalescer].Submit(lKey, lVolume, lSetter);
+            }
+        }
+        nlEXPECT(lStatus >= 0, done);
     }
 
  done:
@@ -266,22 +333,32 @@ using namespace Nuovations;
 
         if (mIsGroup)
         {
-            GroupModel::IdentifierType lIdentifier;
+            AppDelegate *                       lDelegate = [AppDelegate sharedDelegate];
+            MutableApplicationControllerPointer lApplicationController = mApplicationController;
+            GroupModel::IdentifierType          lIdentifier;
 
             lStatus = mUnion.mGroup->GetIdentifier(lIdentifier);
             nlREQUIRE_SUCCESS(lStatus, done);
 
-            lStatus = mApplicationController->GroupIncreaseVolume(lIdentifier);
+            lStatus = [lDelegate commandPipeline].Enqueue(CommandPipeline::kKindGroup,
+                                                          lIdentifier,
+                                                          CommandPipeline::kAnswerVolume,
+                                                          [lApplicationController, lIdentifier]() { return (lApplicationController->GroupIncreaseVolume(lIdentifier)); });
             nlEXPECT(lStatus >= 0, done);
         }
         else
         {
-            ZoneModel::IdentifierType lIdentifier;
+            AppDelegate *                       lDelegate = [AppDelegate sharedDelegate];
+            MutableApplicationControllerPointer lApplicationController = mApplicationController;
+            ZoneModel::IdentifierType           lIdentifier;
 
             lStatus = mUnion.mZone->GetIdentifier(lIdentifier);
             nlREQUIRE_SUCCESS(lStatus, done);
 
-            lStatus = mApplicationController->ZoneIncreaseVolume(lIdentifier);
+            lStatus = [lDelegate commandPipeline].Enqueue(CommandPipeline::kKindZone,
+                                                          lIdentifier,
+                                                          CommandPipeline::kAnswerVolume,
+                                                          [lApplicationController, lIdentifier]() { return (lApplicationController->ZoneIncreaseVolume(lIdentifier)); });
             nlEXPECT(lStatus >= 0, done);
         }
     }
@@ -463,17 +540,200 @@ using namespace Nuovations;
         nlREQUIRE_SUCCESS(lRetval, done);
     }
 
-    self.mGroupOrZoneName.text = lNSStringGroupOrZoneName;
-    self.mSourceName.text      = lNSStringSourceName;
-    self.mVolumeSlider.value   = static_cast<float>(lVolume);
-    self.mMuteSwitch.on        = lMute;
+    // Render any volume or mute state submitted but not yet answered
+    // in place of the model state.
+
+    [self overlayVolume: lVolume
+                andMute: lMute
+          forIdentifier: aIdentifier];
+
+    [self configureCellWithName: lNSStringGroupOrZoneName
+                  andSourceName: lNSStringSourceName
+                      andVolume: lVolume
+                        andMute: lMute];
+
+done:
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Configure this table view cell based on the specified group or
+ *    zone identifier from a cached state snapshot.
+ *
+ *  This configures the cell from the name, source (input), and
+ *  volume (including level and mute state) in the specified state
+ *  snapshot, for use where the client controller data model has not
+ *  yet been refreshed, as is the case immediately after a warm
+ *  start. The cell is nonetheless bound to the data model group or
+ *  zone such that it may be acted on.
+ *
+ *  @param[in]  aIdentifier           An immutable reference to the
+ *                                    identifier for the group or
+ *                                    zone.
+ *  @param[in]  aApplicationController  A reference to a shared
+ *                                    pointer to a mutable HLX
+ *                                    client controller instance
+ *                                    to use for this table view
+ *                                    cell.
+ *  @param[in]  aIsGroup              A Boolean indicating whether
+ *                                    or not this table view cell is
+ *                                    for a group.
+ *  @param[in]  aCachedState          A pointer to the state
+ *                                    snapshot to configure from.
+ *
+ *  @retval  kStatus_Success  If successful.
+ *  @retval  -ERANGE          If the group or zone identifier
+ *                            is smaller or larger than supported.
+ *  @retval  -ENOENT          If the snapshot does not have the
+ *                            group or zone.
+ *  @retval  -ENOMEM          Memory could not be allocated for the
+ *                            group, source, or zone names.
+ *
+ */
+- (Status) configureCellForIdentifier: (const IdentifierModel::IdentifierType &)aIdentifier
+                       withController: (MutableApplicationControllerPointer &)aApplicationController
+                              asGroup: (bool)aIsGroup
+                       andCachedState: (NSDictionary *)aCachedState
+{
+    NSDictionary *               lEntity;
+    NSString *                   lNSStringGroupOrZoneName;
+    NSString *                   lNSStringSourceName = nullptr;
+    NSArray *                    lSources;
+    NSNumber *                   lVolume;
+    NSNumber *                   lMute;
+    Status                       lRetval = kStatus_Success;
+
 
-    if (lVolume == static_cast<const VolumeModel::LevelType>(self.mVolumeSlider.minimumValue))
+    mIsGroup = aIsGroup;
+
+    mApplicationController = aApplicationController;
+
+    self.mVolumeSlider.minimumValue = static_cast<float>(VolumeModel::kLevelMin);
+    self.mVolumeSlider.maximumValue = static_cast<float>(VolumeModel::kLevelMax);
+
+    // Only the presentation comes from the snapshot; the group or
+    // zone itself, if not yet its properties, is always present in
+    // the data model.
+
+    if (aIsGroup)
+    {
+        lRetval = mApplicationController->GroupGet(aIdentifier, mUnion.mGroup);
+        nlREQUIRE_SUCCESS(lRetval, done);
+    }
+    else
+    {
+        lRetval = mApplicationController->ZoneGet(aIdentifier, mUnion.mZone);
+        nlREQUIRE_SUCCESS(lRetval, done);
+    }
+
+    nlREQUIRE_ACTION(aCachedState != nullptr, done, lRetval = -ENOENT);
+
+    lEntity = [StateCacheController entity: aIdentifier
+                                    forKey: (aIsGroup ? kStateCacheGroupsKey : kStateCacheZonesKey)
+                                   inState: aCachedState];
+    nlEXPECT_ACTION(lEntity != nullptr, done, lRetval = -ENOENT);
+
+    lNSStringGroupOrZoneName = [lEntity objectForKey: kStateCacheNameKey];
+    nlEXPECT_ACTION(lNSStringGroupOrZoneName != nullptr, done, lRetval = -ENOENT);
+
+    if (aIsGroup)
+    {
+        lSources = [lEntity objectForKey: kStateCacheGroupSourcesKey];
+    }
+    else
+    {
+        NSNumber *lSource = [lEntity objectForKey: kStateCacheSourceKey];
+
+        lSources = ((lSource != nullptr) ? [NSArray arrayWithObject: lSource] : nullptr);
+    }
+
+    if ([lSources count] == 1)
+    {
+        NSNumber *                         lSourceIdentifier = [lSources firstObject];
+        const SourceModel::IdentifierType  lIdentifier = [lSourceIdentifier unsignedIntValue];
+        NSDictionary *                     lSource;
+
+        lSource = [StateCacheController entity: lIdentifier
+                                        forKey: kStateCacheSourcesKey
+                                       inState: aCachedState];
+
+        lNSStringSourceName = [lSource objectForKey: kStateCacheNameKey];
+    }
+    else if ([lSources count] > 1)
+    {
+        lNSStringSourceName = NSLocalizedString(@"MultipleGroupSourceSummaryKey", @"");
+    }
+
+    lVolume = [lEntity objectForKey: kStateCacheVolumeKey];
+    lMute   = [lEntity objectForKey: kStateCacheMuteKey];
+
+    [self configureCellWithName: lNSStringGroupOrZoneName
+                  andSourceName: lNSStringSourceName
+                      andVolume: ((lVolume != nullptr) ? [lVolume intValue] : VolumeModel::kLevelMin)
+                        andMute: ((lMute != nullptr) ? [lMute boolValue] : true)];
+
+done:
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Replace the specified volume level and mute state with those
+ *    submitted, but not yet answered, for the specified group or
+ *    zone, if any.
+ *
+ *  @param[in,out]  aVolume      A reference to the model volume
+ *                               level, replaced with the submitted
+ *                               level, if any.
+ *  @param[in,out]  aMute        A reference to the model mute state,
+ *                               replaced with the submitted state, if
+ *                               any.
+ *  @param[in]      aIdentifier  An immutable reference to the
+ *                               identifier for the group or zone.
+ *
+ */
+- (void) overlayVolume: (VolumeModel::LevelType &)aVolume
+               andMute: (VolumeModel::MuteType &)aMute
+         forIdentifier: (const IdentifierModel::IdentifierType &)aIdentifier
+{
+    AppDelegate *                     lDelegate = [AppDelegate sharedDelegate];
+    const CommandCoalescer &          lCommandCoalescer = [lDelegate commandCoalescer];
+    const CommandCoalescer::Kind      lKind = (mIsGroup ? CommandCoalescer::kKindGroup : CommandCoalescer::kKindZone);
+    CommandCoalescer::ValueType       lValue;
+    Status                            lStatus;
+
+    lStatus = lCommandCoalescer.GetValue(CommandCoalescer::Key(lKind, aIdentifier, CommandCoalescer::kPropertyVolume), lValue);
+
+    if (lStatus == kStatus_Success)
+    {
+        aVolume = static_cast<VolumeModel::LevelType>(lValue);
+    }
+
+    lStatus = lCommandCoalescer.GetValue(CommandCoalescer::Key(lKind, aIdentifier, CommandCoalescer::kPropertyMute), lValue);
+
+    if (lStatus == kStatus_Success)
+    {
+        aMute = static_cast<VolumeModel::MuteType>(lValue);
+    }
+}
+
+- (void) configureCellWithName: (NSString *)aGroupOrZoneName
+                 andSourceName: (NSString *)aSourceName
+                     andVolume: (const VolumeModel::LevelType &)aVolume
+                       andMute: (const VolumeModel::MuteType &)aMute
+{
+    self.mGroupOrZoneName.text = aGroupOrZoneName;
+    self.mSourceName.text      = aSourceName;
+    self.mVolumeSlider.value   = static_cast<float>(aVolume);
+    self.mMuteSwitch.on        = aMute;
+
+    if (aVolume == static_cast<const VolumeModel::LevelType>(self.mVolumeSlider.minimumValue))
     {
         self.mVolumeDecreaseButton.enabled = false;
         self.mVolumeIncreaseButton.enabled = true;
     }
-    else if (lVolume == static_cast<const VolumeModel::LevelType>(self.mVolumeSlider.maximumValue))
+    else if (aVolume == static_cast<const VolumeModel::LevelType>(self.mVolumeSlider.maximumValue))
     {
         self.mVolumeDecreaseButton.enabled = true;
         self.mVolumeIncreaseButton.enabled = false;
@@ -483,9 +743,6 @@ using namespace Nuovations;
         self.mVolumeDecreaseButton.enabled = true;
         self.mVolumeIncreaseButton.enabled = true;
     }
-
-done:
-    return (lRetval);
 }
 
 @end
@@ -28,6 +28,7 @@
 #define GROUPSANDZONESTABLEVIEWCONTROLLER_H
 
 #include <memory>
+#include <vector>
 
 #import <UIKit/UIKit.h>
 
@@ -36,6 +37,10 @@
 
 #import "ApplicationControllerDelegate.hpp"
 #import "ApplicationControllerPointer.hpp"
+#import "RefreshQueryScheduler.hpp"
+#import "RowReloadCoalescer.hpp"
+#import "SourceRowIndex.hpp"
+#import "StateChangeBus.hpp"
 
 
 namespace HLX
@@ -51,6 +56,8 @@ class Controller;
 };
 
 class ApplicationControllerDelegate;
+class CommandPipeline;
+class RefreshStageTracker;
 
 /**
  *  Enumeration for indicating whether to render the table view as
@@ -91,6 +98,74 @@ typedef NSInteger ShowStyle NS_TYPED_ENUM;
      *
      */
     ShowStyle                                     mShowStyle;
+
+    /**
+     *  An optional pointer to the state snapshot, saved from a prior
+     *  connection to the same location, from which the table view is
+     *  rendered until the client controller refresh completes.
+     *
+     */
+    NSDictionary *                                mCachedState;
+
+    /**
+     *  An optional pointer to the network address, name, or URL
+     *  location connected to, for which scenes are saved and
+     *  applied. Without one, the scenes button is disabled.
+     *
+     */
+    NSString *                                    mLocation;
+
+    /**
+     *  A Boolean indicating whether a client controller refresh is to
+     *  be started once the view has appeared.
+     *
+     */
+    bool                                          mRefreshPending;
+
+    /**
+     *  A pointer to the global HLX client controller refresh stage
+     *  tracker.
+     *
+     */
+    RefreshStageTracker *                         mRefreshStageTracker;
+
+    /**
+     *  A pointer to the global HLX client controller command
+     *  pipeline.
+     *
+     */
+    CommandPipeline *                             mCommandPipeline;
+
+    /**
+     *  The scheduler for ordering, by visibility, the zone queries
+     *  issued while a client controller refresh is in progress.
+     *
+     */
+    RefreshQueryScheduler                         mRefreshQueryScheduler;
+
+    /**
+     *  The tokens of the state change subscriptions with which the
+     *  rows are kept current, including while another view is pushed
+     *  over this one.
+     *
+     */
+    std::vector<StateChangeBus::Token>            mStateChangeTokens;
+
+    /**
+     *  The coalescer for the rows that state changes have left dirty,
+     *  such that each is reloaded once at the end of the run loop
+     *  turn in which the changes arrived.
+     *
+     */
+    RowReloadCoalescer                            mRowReloadCoalescer;
+
+    /**
+     *  The index of the group and zone rows by the source whose name
+     *  each renders, such that a source rename reloads only those
+     *  rows.
+     *
+     */
+    SourceRowIndex                                mSourceRowIndex;
 }
 
 // MARK: Properties
@@ -112,10 +187,13 @@ typedef NSInteger ShowStyle NS_TYPED_ENUM;
 // MARK: Actions
 
 - (IBAction) onGroupZoneSegmentedControlAction: (id)aSender;
+- (IBAction) onScenesButtonAction: (id)aSender;
 
 // MARK: Setters
 
 - (void) setApplicationController: (MutableApplicationControllerPointer &)aApplicationController; 
+- (void) setCachedState: (NSDictionary *)aCachedState
+            forLocation: (NSString *)aLocation;
 
 @end
 
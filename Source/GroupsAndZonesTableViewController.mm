@@ -32,13 +32,17 @@
 
 #include <OpenHLX/Client/ApplicationControllerDelegate.hpp>
 #include <OpenHLX/Client/GroupsStateChangeNotifications.hpp>
+#include <OpenHLX/Client/SourcesStateChangeNotifications.hpp>
 #include <OpenHLX/Client/ZonesStateChangeNotifications.hpp>
 #include <OpenHLX/Model/VolumeModel.hpp>
 #include <OpenHLX/Utilities/Assert.hpp>
 
+#import "AppDelegate.h"
 #import "ApplicationControllerDelegate.hpp"
 #import "GroupsAndZonesTableViewCell.h"
 #import "GroupDetailViewController.h"
+#import "Scene.hpp"
+#import "SceneController.h"
 #import "UIViewController+HLXClientDidDisconnectDelegateDefaultImplementations.h"
 #import "UIViewController+TopViewController.h"
 #import "ZoneDetailViewController.h"
@@ -75,22 +79,107 @@ class Controller;
 
 - (void) viewDidLoad
 {
+    AppDelegate *lDelegate = [AppDelegate sharedDelegate];
+
     [super viewDidLoad];
+
+    mRefreshStageTracker = &[lDelegate refreshStageTracker];
+    mCommandPipeline = &[lDelegate commandPipeline];
+
+    self.navigationItem.rightBarButtonItem = [[UIBarButtonItem alloc] initWithTitle: NSLocalizedString(@"Scenes", @"")
+                                                                              style: UIBarButtonItemStylePlain
+                                                                             target: self
+                                                                             action: @selector(onScenesButtonAction:)];
+
+    // Scenes are saved per location; without one, there are none to
+    // offer and nowhere to save one.
+
+    self.navigationItem.rightBarButtonItem.enabled = (mLocation != nullptr);
+
+    [self subscribeToStateChanges: [lDelegate stateChangeBus]];
+
+    // Some, or all, of the group and zone sources may have arrived
+    // before the subscriptions were in place; index those now.
+
+    [self indexSourceRows];
+}
+
+- (void) dealloc
+{
+    AppDelegate *lDelegate = [AppDelegate sharedDelegate];
+
+    [self unsubscribeFromStateChanges: [lDelegate stateChangeBus]];
 }
 
 - (void) viewWillAppear: (BOOL)aAnimated
 {
-    Status  lStatus;
+    AppDelegate *  lDelegate = [AppDelegate sharedDelegate];
+    Status         lStatus;
 
 
     [super viewWillAppear: aAnimated];
 
     mShowStyle = self.mGroupZoneSegmentedControl.selectedSegmentIndex;
 
-    lStatus = mApplicationController->SetDelegate(mApplicationControllerDelegate.get());
+    lStatus = [lDelegate stateChangeBus].SetDelegate(mApplicationControllerDelegate.get());
     nlREQUIRE_SUCCESS(lStatus, done);
 
-    [self.tableView reloadData];
+    // Rows render volume and mute changes optimistically; when one
+    // is rolled back, render the rows from the model again.
+
+    [[NSNotificationCenter defaultCenter] addObserver: self
+                                             selector: @selector(commandDidRollBack:)
+                                                 name: kCommandDidRollBackNotification
+                                               object: nullptr];
+
+    // The rows are kept current by state change subscriptions, even
+    // while another view is pushed over this one. Only rows still
+    // rendered from a state snapshot, which a refresh completing
+    // under another view leaves behind, need rendering again.
+
+    if (mCachedState != nullptr)
+    {
+        [self.tableView reloadData];
+    }
+
+done:
+    return;
+}
+
+- (void) viewWillDisappear: (BOOL)aAnimated
+{
+    [super viewWillDisappear: aAnimated];
+
+    [[NSNotificationCenter defaultCenter] removeObserver: self
+                                                    name: kCommandDidRollBackNotification
+                                                  object: nullptr];
+}
+
+- (void) viewDidAppear: (BOOL)aAnimated
+{
+    Status  lStatus;
+
+
+    [super viewDidAppear: aAnimated];
+
+    // If the view was rendered from a state snapshot, the client
+    // controller has connected but has not yet been refreshed. Now
+    // that this view is the client controller delegate, start the
+    // refresh in the background.
+
+    if (mRefreshPending)
+    {
+        mRefreshPending = false;
+
+        lStatus = mApplicationController->Refresh();
+        nlREQUIRE_SUCCESS(lStatus, done);
+    }
+
+    // If a refresh is in progress, whether started above or still
+    // running in the background from the staged refresh, start
+    // querying what is visible ahead of it.
+
+    [self startRefreshQueries];
 
 done:
     return;
@@ -159,12 +248,20 @@ done:
 
     mShowStyle = self.mGroupZoneSegmentedControl.selectedSegmentIndex;
 
+    mCachedState         = nullptr;
+    mLocation            = nullptr;
+    mRefreshPending      = false;
+    mRefreshStageTracker = nullptr;
+    mCommandPipeline = nullptr;
+
  done:
     return;
 }
 
 - (void)prepareForSegue: (UIStoryboardSegue *)aSegue sender: (id)aSender
 {
+    AppDelegate *lDelegate = [AppDelegate sharedDelegate];
+
     if ([aSender isKindOfClass: [GroupsAndZonesTableViewCell class]])
     {
         GroupsAndZonesTableViewCell *  lGroupsAndZonesCell = aSender;
@@ -174,6 +271,18 @@ done:
         if (lIsGroup)
         {
             GroupDetailViewController *  lGroupDetailViewController = [aSegue destinationViewController];
+            GroupModel::IdentifierType   lGroupIdentifier;
+
+            // If the group being navigated to has not yet arrived,
+            // have its query jump ahead of any others still pending.
+
+            if ([lGroupsAndZonesCell group]->GetIdentifier(lGroupIdentifier) == kStatus_Success)
+            {
+                if (mRefreshQueryScheduler.SetNavigation(RefreshQueryScheduler::kKindGroup, lGroupIdentifier) == kStatus_Success)
+                {
+                    [self issueRefreshQueries];
+                }
+            }
 
             [lGroupDetailViewController setApplicationController: mApplicationController
                                         forGroup: [lGroupsAndZonesCell group]];
@@ -181,12 +290,24 @@ done:
         else
         {
             ZoneDetailViewController *   lZoneDetailViewController = [aSegue destinationViewController];
+            ZoneModel::IdentifierType    lZoneIdentifier;
+
+            // If the zone being navigated to has not yet arrived, have
+            // its query jump ahead of any others still pending.
+
+            if ([lGroupsAndZonesCell zone]->GetIdentifier(lZoneIdentifier) == kStatus_Success)
+            {
+                if (mRefreshQueryScheduler.SetNavigation(RefreshQueryScheduler::kKindZone, lZoneIdentifier) == kStatus_Success)
+                {
+                    [self issueRefreshQueries];
+                }
+            }
 
             [lZoneDetailViewController setApplicationController: mApplicationController
                                        forZone: [lGroupsAndZonesCell zone]];
         }
 
-        lStatus = mApplicationController->SetDelegate(nullptr);
+        lStatus = [lDelegate stateChangeBus].SetDelegate(nullptr);
         nlREQUIRE_SUCCESS(lStatus, done);
     }
 
@@ -210,9 +331,69 @@ done:
     {
         mShowStyle = self.mGroupZoneSegmentedControl.selectedSegmentIndex;
 
+        mRowReloadCoalescer.Clear();
+
         [self.tableView reloadData];
+
+        [self updateRefreshQueries];
+    }
+
+    return;
+}
+
+/**
+ *  @brief
+ *    This is the action handler for the scenes button.
+ *
+ *  This offers to apply any of the scenes saved for the location or
+ *  to save the groups or zones shown as a new scene. The button is
+ *  disabled where there is no location.
+ *
+ *  @param[in]  aSender  The entity that triggered this action handler.
+ *
+ */
+- (IBAction) onScenesButtonAction: (id)aSender
+{
+    UIAlertController *  lAlertController;
+    NSArray *            lSceneNames;
+
+
+    nlEXPECT(mLocation != nullptr, done);
+
+    lSceneNames = [[SceneController sharedController] sceneNamesForLocation: mLocation];
+
+    lAlertController = [UIAlertController alertControllerWithTitle: NSLocalizedString(@"Scenes", @"")
+                                          message: nullptr
+                                          preferredStyle: UIAlertControllerStyleActionSheet];
+
+    for (NSString *lSceneName in lSceneNames)
+    {
+        [lAlertController addAction: [UIAlertAction actionWithTitle: lSceneName
+                                                     style: UIAlertActionStyleDefault
+                                                     handler: ^(UIAlertAction * aAction) {
+            [self applySceneNamed: lSceneName];
+        }]];
     }
 
+    [lAlertController addAction: [UIAlertAction actionWithTitle: ((mShowStyle == kShowStyleGroups) ?
+                                                                  NSLocalizedString(@"Save Groups as Scene...", @"") :
+                                                                  NSLocalizedString(@"Save Zones as Scene...", @""))
+                                                 style: UIAlertActionStyleDefault
+                                                 handler: ^(UIAlertAction * aAction) {
+        [self presentSaveSceneAlert];
+    }]];
+
+    [lAlertController addAction: [UIAlertAction actionWithTitle: NSLocalizedString(@"Cancel", @"")
+                                                 style: UIAlertActionStyleCancel
+                                                 handler: nullptr]];
+
+    lAlertController.popoverPresentationController.barButtonItem = self.navigationItem.rightBarButtonItem;
+
+    [self presentViewController: lAlertController
+                       animated: true
+                     completion: nullptr];
+
+ done:
     return;
 }
 
@@ -233,6 +414,35 @@ done:
     mApplicationController = aApplicationController;
 }
 
+/**
+ *  @brief
+ *    Set the state snapshot and location for the view.
+ *
+ *  When a state snapshot is set, the table view is rendered from it,
+ *  where the client controller data model is not yet available, and
+ *  a client controller refresh is started once the view has
+ *  appeared.
+ *
+ *  @param[in]  aCachedState  An optional pointer to the state
+ *                            snapshot to render from until the
+ *                            client controller is refreshed. If
+ *                            null, the client controller is assumed
+ *                            to already be refreshed.
+ *  @param[in]  aLocation     A pointer to the network address, name,
+ *                            or URL location connected to, for
+ *                            which scenes are saved and applied.
+ *
+ */
+- (void) setCachedState: (NSDictionary *)aCachedState
+            forLocation: (NSString *)aLocation
+{
+    mCachedState    = aCachedState;
+    mLocation       = aLocation;
+    mRefreshPending = (aCachedState != nullptr);
+
+    self.navigationItem.rightBarButtonItem.enabled = (mLocation != nullptr);
+}
+
 // MARK: Table View Data Source Delegation
 
 - (NSInteger) numberOfSectionsInTableView: (UITableView *)aTableView
@@ -294,8 +504,196 @@ done:
     return (lRetval);
 }
 
+// MARK: Scroll View Delegation
+
+- (void) scrollViewDidEndDragging: (UIScrollView *)aScrollView willDecelerate: (BOOL)aDecelerate
+{
+    if (!aDecelerate)
+    {
+        [self updateRefreshQueries];
+    }
+}
+
+- (void) scrollViewDidEndDecelerating: (UIScrollView *)aScrollView
+{
+    [self updateRefreshQueries];
+}
+
 // MARK: Workers
 
+/**
+ *  @brief
+ *    Start ordering and issuing group and zone queries, by
+ *    visibility, ahead of an in-progress client controller refresh.
+ *
+ *  On systems with many groups and zones, the client controller
+ *  refresh may deliver the rows the user is actually looking at
+ *  last. While a refresh is in progress, this view issues its own
+ *  queries for the groups and zones that have not yet arrived,
+ *  visible rows first, such that they arrive sooner.
+ *
+ *  The view appears again each time the user navigates back to it;
+ *  queries already started for this refresh are only reordered for
+ *  the rows now visible rather than started over, which would query
+ *  again those still in flight.
+ *
+ */
+- (void) startRefreshQueries
+{
+    IdentifierModel::IdentifierType  lGroupsMax;
+    IdentifierModel::IdentifierType  lZonesMax;
+    Status                           lStatus;
+
+
+    nlEXPECT(mRefreshStageTracker != nullptr, done);
+    nlEXPECT(mRefreshStageTracker->GetStage() != RefreshStageTracker::kStageIdle, done);
+    nlEXPECT(!mRefreshStageTracker->IsComplete(), done);
+
+    if (mRefreshQueryScheduler.IsEmpty() && (mRefreshQueryScheduler.GetInFlightCount() == 0))
+    {
+        lStatus = mApplicationController->GroupsGetMax(lGroupsMax);
+        nlREQUIRE_SUCCESS(lStatus, done);
+
+        lStatus = mApplicationController->ZonesGetMax(lZonesMax);
+        nlREQUIRE_SUCCESS(lStatus, done);
+
+        lStatus = mRefreshQueryScheduler.Init(lGroupsMax, lZonesMax);
+        nlREQUIRE_SUCCESS(lStatus, done);
+    }
+
+    [self updateRefreshQueries];
+
+ done:
+    return;
+}
+
+/**
+ *  @brief
+ *    Update the group and zone query order from the current show
+ *    style and visible rows and issue any queries that may now be
+ *    issued.
+ *
+ */
+- (void) updateRefreshQueries
+{
+    const RefreshQueryScheduler::Kind  lKind = ((mShowStyle == kShowStyleGroups) ?
+                                                RefreshQueryScheduler::kKindGroup :
+                                                RefreshQueryScheduler::kKindZone);
+    NSArray *                          lVisibleRows;
+    NSInteger                          lFirst = NSIntegerMax;
+    NSInteger                          lLast = -1;
+    Status                             lStatus;
+
+
+    nlEXPECT(!mRefreshQueryScheduler.IsEmpty(), done);
+
+    lStatus = mRefreshQueryScheduler.SetShown(lKind);
+    nlREQUIRE_SUCCESS(lStatus, done);
+
+    lVisibleRows = [self.tableView indexPathsForVisibleRows];
+
+    for (NSIndexPath *lIndexPath in lVisibleRows)
+    {
+        lFirst = MIN(lFirst, lIndexPath.row);
+        lLast  = MAX(lLast,  lIndexPath.row);
+    }
+
+    if (lLast >= 0)
+    {
+        // HLX identifiers are one rather than zero based; however,
+        // UIKit table rows are zero based. Consequently, increment
+        // the rows by one to account for this.
+
+        lStatus = mRefreshQueryScheduler.SetVisible(lKind,
+                                                    static_cast<RefreshQueryScheduler::IdentifierType>(lFirst + 1),
+                                                    static_cast<RefreshQueryScheduler::IdentifierType>(lLast + 1));
+        nlVERIFY_SUCCESS(lStatus);
+    }
+
+    [self issueRefreshQueries];
+
+ done:
+    return;
+}
+
+/**
+ *  @brief
+ *    Issue scheduled group and zone queries, while there is room for
+ *    them in the command pipeline.
+ *
+ *  The pipeline is kept full, rather than over-filled, such that the
+ *  queries for what the user is looking at are not themselves queued
+ *  behind a long run of queries for what the user has since scrolled
+ *  away from.
+ *
+ *  Groups and zones that have already arrived through the client
+ *  controller refresh are retired without being queried.
+ *
+ *  Only the visible and navigated-to groups and zones are queried;
+ *  the client controller refresh itself queries every group and zone,
+ *  so querying the rest, too, would only answer each twice and
+ *  lengthen the refresh.
+ *
+ */
+- (void) issueRefreshQueries
+{
+    RefreshQueryScheduler::Query  lQuery;
+    Status                        lStatus;
+
+
+    nlEXPECT(mRefreshStageTracker != nullptr, done);
+    nlEXPECT(mCommandPipeline != nullptr, done);
+
+    if (mRefreshStageTracker->IsComplete())
+    {
+        mRefreshQueryScheduler.Clear();
+    }
+
+    mCommandPipeline->Service();
+
+    while (mCommandPipeline->HasCapacity(CommandScheduler::kLaneBackground))
+    {
+        lStatus = mRefreshQueryScheduler.Pop(RefreshQueryScheduler::kPriorityVisible, lQuery);
+        nlEXPECT_SUCCESS(lStatus, done);
+
+        if ((lQuery.mKind == RefreshQueryScheduler::kKindGroup) &&
+            !mRefreshStageTracker->IsGroupUsable(lQuery.mIdentifier))
+        {
+            MutableApplicationControllerPointer    lController = mApplicationController;
+            const IdentifierModel::IdentifierType  lIdentifier = lQuery.mIdentifier;
+
+            lStatus = mCommandPipeline->Enqueue(CommandPipeline::kKindGroup,
+                                                lIdentifier,
+                                                CommandPipeline::kAnswerAll,
+                                                CommandScheduler::kLaneBackground,
+                                                CommandPipeline::kResponseQuery,
+                                                [lController, lIdentifier]() { return (lController->GroupQuery(lIdentifier)); });
+            nlREQUIRE_SUCCESS(lStatus, done);
+        }
+        else if ((lQuery.mKind == RefreshQueryScheduler::kKindZone) &&
+                 !mRefreshStageTracker->IsZoneUsable(lQuery.mIdentifier))
+        {
+            MutableApplicationControllerPointer    lController = mApplicationController;
+            const IdentifierModel::IdentifierType  lIdentifier = lQuery.mIdentifier;
+
+            lStatus = mCommandPipeline->Enqueue(CommandPipeline::kKindZone,
+                                                lIdentifier,
+                                                CommandPipeline::kAnswerAll,
+                                                CommandScheduler::kLaneBackground,
+                                                CommandPipeline::kResponseQuery,
+                                                [lController, lIdentifier]() { return (lController->ZoneQuery(lIdentifier)); });
+            nlREQUIRE_SUCCESS(lStatus, done);
+        }
+        else
+        {
+            mRefreshQueryScheduler.Complete(lQuery.mKind, lQuery.mIdentifier);
+        }
+    }
+
+ done:
+    return;
+}
+
 - (void) configureReusableCell: (GroupsAndZonesTableViewCell *)aCell
                   forIndexPath: (NSIndexPath *)aIndexPath
 {
@@ -307,16 +705,32 @@ done:
 
     if ((mShowStyle == kShowStyleGroups) || (mShowStyle == kShowStyleZones))
     {
-        const bool  lAsGroup = (mShowStyle == kShowStyleGroups);
-        Status      lStatus;
-
         // HLX identifiers are one rather than zero based; however,
         // UIKit table rows are zero based. Consequently, increment
         // the row by one to account for this.
 
-        lStatus = [aCell configureCellForIdentifier: (lRow + 1)
-                                     withController: mApplicationController
-                                            asGroup: lAsGroup];
+        const IdentifierModel::IdentifierType  lIdentifier = static_cast<IdentifierModel::IdentifierType>(lRow + 1);
+        const bool                             lAsGroup = (mShowStyle == kShowStyleGroups);
+        Status                                 lStatus;
+
+        // Render from the state snapshot, if any, until the group or
+        // zone has arrived, rather than attempting the data model
+        // first and failing for every row.
+
+        if ((mCachedState != nullptr) && ![self isUsableIdentifier: lIdentifier asGroup: lAsGroup])
+        {
+            lStatus = [aCell configureCellForIdentifier: lIdentifier
+                                         withController: mApplicationController
+                                                asGroup: lAsGroup
+                                         andCachedState: mCachedState];
+        }
+        else
+        {
+            lStatus = [aCell configureCellForIdentifier: lIdentifier
+                                         withController: mApplicationController
+                                                asGroup: lAsGroup];
+        }
+
         nlVERIFY_SUCCESS(lStatus);
     }
 
@@ -324,6 +738,170 @@ done:
     return;
 }
 
+/**
+ *  @brief
+ *    Return whether the client controller data model has everything
+ *    a row needs for the specified group or zone.
+ *
+ *  @param[in]  aIdentifier  An immutable reference to the identifier
+ *                           for the group or zone.
+ *  @param[in]  aIsGroup     A Boolean indicating whether or not the
+ *                           identifier is for a group.
+ *
+ *  @returns
+ *    False if the refresh has yet to start or the group or zone has
+ *    yet to arrive; otherwise, true.
+ *
+ */
+- (bool) isUsableIdentifier: (const IdentifierModel::IdentifierType &)aIdentifier
+                    asGroup: (bool)aIsGroup
+{
+    bool  lRetval = !mRefreshPending;
+
+
+    if (lRetval && (mRefreshStageTracker != nullptr))
+    {
+        lRetval = (aIsGroup ?
+                   mRefreshStageTracker->IsGroupUsable(aIdentifier) :
+                   mRefreshStageTracker->IsZoneUsable(aIdentifier));
+    }
+
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Present an alert asking for the name under which to save the
+ *    groups or zones shown as a scene.
+ *
+ */
+- (void) presentSaveSceneAlert
+{
+    UIAlertController *           lAlertController;
+    __weak UIAlertController *    lWeakAlertController;
+
+
+    lAlertController = [UIAlertController alertControllerWithTitle: NSLocalizedString(@"Save Scene", @"")
+                                          message: NSLocalizedString(@"A scene saved under the name of an existing scene replaces it.", @"")
+                                          preferredStyle: UIAlertControllerStyleAlert];
+
+    lWeakAlertController = lAlertController;
+
+    [lAlertController addTextFieldWithConfigurationHandler: ^(UITextField * aTextField) {
+        aTextField.placeholder = NSLocalizedString(@"Name", @"");
+    }];
+
+    [lAlertController addAction: [UIAlertAction actionWithTitle: NSLocalizedString(@"Cancel", @"")
+                                                 style: UIAlertActionStyleCancel
+                                                 handler: nullptr]];
+
+    [lAlertController addAction: [UIAlertAction actionWithTitle: NSLocalizedString(@"Save", @"")
+                                                 style: UIAlertActionStyleDefault
+                                                 handler: ^(UIAlertAction * aAction) {
+        [self saveSceneNamed: [[[lWeakAlertController textFields] firstObject] text]];
+    }]];
+
+    [self presentViewController: lAlertController
+                       animated: true
+                     completion: nullptr];
+}
+
+/**
+ *  @brief
+ *    Capture the groups or zones shown from the client controller
+ *    model and save them, for the location, as the named scene.
+ *
+ *  @param[in]  aSceneName  A pointer to the name of the scene.
+ *
+ */
+- (void) saveSceneNamed: (NSString *)aSceneName
+{
+    const bool                       lAsGroup = (mShowStyle == kShowStyleGroups);
+    IdentifierModel::IdentifierType  lMax;
+    IdentifierModel::IdentifierType  lIdentifier;
+    Scene::Identifiers               lIdentifiers;
+    Scene                            lScene;
+    bool                             lSaved;
+    Status                           lStatus;
+
+
+    nlEXPECT([aSceneName length] > 0, done);
+
+    lStatus = (lAsGroup ?
+               mApplicationController->GroupsGetMax(lMax) :
+               mApplicationController->ZonesGetMax(lMax));
+    nlREQUIRE_SUCCESS(lStatus, done);
+
+    for (lIdentifier = IdentifierModel::kIdentifierMin; lIdentifier <= lMax; lIdentifier++)
+    {
+        lIdentifiers.push_back(lIdentifier);
+    }
+
+    lStatus = lScene.Capture(mApplicationController,
+                             (lAsGroup ? lIdentifiers : Scene::Identifiers()),
+                             (lAsGroup ? Scene::Identifiers() : lIdentifiers));
+    nlREQUIRE_SUCCESS(lStatus, done);
+
+    lSaved = [[SceneController sharedController] saveScene: lScene
+                                                      named: aSceneName
+                                                forLocation: mLocation];
+    nlVERIFY(lSaved);
+
+ done:
+    return;
+}
+
+/**
+ *  @brief
+ *    Apply the named scene saved for the location, sending only
+ *    those commands that change something.
+ *
+ *  @param[in]  aSceneName  A pointer to the name of the scene.
+ *
+ */
+- (void) applySceneNamed: (NSString *)aSceneName
+{
+    Scene   lScene;
+    size_t  lCount;
+    bool    lRestored;
+    Status  lStatus;
+
+
+    nlREQUIRE(mCommandPipeline != nullptr, done);
+
+    lRestored = [[SceneController sharedController] getScene: lScene
+                                                        named: aSceneName
+                                                  forLocation: mLocation];
+    nlREQUIRE(lRestored, done);
+
+    lStatus = lScene.Apply(mApplicationController, *mCommandPipeline, lCount);
+    nlREQUIRE_SUCCESS(lStatus, done);
+
+    Log::Info().Write("Scene \"%s\" applied with %zu command(s).\n", [aSceneName UTF8String], lCount);
+
+ done:
+    return;
+}
+
+/**
+ *  @brief
+ *    Render the visible rows from the model again after a command,
+ *    the value of which they may have rendered, was rolled back.
+ *
+ *  @param[in]  aNotification  The rollback notification.
+ *
+ */
+- (void) commandDidRollBack: (NSNotification *)aNotification
+{
+    NSArray *  lIndexPaths = [self.tableView indexPathsForVisibleRows];
+
+    if ([lIndexPaths count] > 0)
+    {
+        [self.tableView reloadRowsAtIndexPaths: lIndexPaths
+                              withRowAnimation: UITableViewRowAnimationNone];
+    }
+}
+
 // MARK: Controller Delegations
 
 - (void) controllerDidDisconnect: (HLX::Client::Application::Controller &)aController withURL: (NSURL *)aURLRef andError: (const HLX::Common::Error &)aError
@@ -333,10 +911,38 @@ done:
                       andNamedSegue: @"DidDisconnect"];
 }
 
+- (void) controllerDidRefresh: (HLX::Client::Application::ControllerBasis &)aController
+{
+    // The client controller data model is now complete; the state
+    // snapshot, if any, is no longer needed for rendering.
+
+    mCachedState = nullptr;
+
+    mRefreshQueryScheduler.Clear();
+
+    mRowReloadCoalescer.Clear();
+
+    [self indexSourceRows];
+
+    [self.tableView reloadData];
+
+    {
+        const RowReloadCoalescer::Counters &lCounters = mRowReloadCoalescer.GetCounters();
+
+        Log::Debug().Write("Coalesced %llu state change(s) into %llu reload(s) of %llu row(s) and %llu of all rows.\n",
+                           static_cast<unsigned long long>(lCounters.mNotifications),
+                           static_cast<unsigned long long>(lCounters.mReloads),
+                           static_cast<unsigned long long>(lCounters.mRows),
+                           static_cast<unsigned long long>(lCounters.mAllRows));
+    }
+}
+
 - (void) controllerStateDidChange: (HLX::Client::Application::ControllerBasis &)aController withNotification: (const StateChange::NotificationBasis &)aStateChangeNotification
 {
     const StateChange::Type  lType = aStateChangeNotification.GetType();
-    NSIndexPath *            lIndexPath;
+
+    // Rows are reloaded by the state change subscriptions; all that
+    // remains here is pacing the refresh queries this view issues.
 
     switch (lType)
     {
@@ -346,22 +952,179 @@ done:
     case StateChange::kStateChangeType_GroupSource:
     case StateChange::kStateChangeType_GroupVolume:
         {
-            if (mShowStyle == kShowStyleGroups)
+            const StateChange::GroupsNotificationBasis &lSCN = static_cast<const StateChange::GroupsNotificationBasis &>(aStateChangeNotification);
+
+            // If this group has now arrived, whether from a query
+            // this view issued or from the client controller refresh,
+            // retire its query and issue the next.
+
+            if (!mRefreshQueryScheduler.IsEmpty() || (mRefreshQueryScheduler.GetInFlightCount() > 0))
+            {
+                if (mRefreshStageTracker->IsGroupUsable(lSCN.GetIdentifier()))
+                {
+                    mRefreshQueryScheduler.Complete(RefreshQueryScheduler::kKindGroup, lSCN.GetIdentifier());
+
+                    [self issueRefreshQueries];
+                }
+            }
+        }
+        break;
+
+    case StateChange::kStateChangeType_ZoneMute:
+    case StateChange::kStateChangeType_ZoneName:
+    case StateChange::kStateChangeType_ZoneSource:
+    case StateChange::kStateChangeType_ZoneVolume:
+        {
+            const StateChange::ZonesNotificationBasis &lSCN = static_cast<const StateChange::ZonesNotificationBasis &>(aStateChangeNotification);
+
+            // If this zone has now arrived, whether from a query this
+            // view issued or from the client controller refresh,
+            // retire its query and issue the next.
+
+            if (!mRefreshQueryScheduler.IsEmpty() || (mRefreshQueryScheduler.GetInFlightCount() > 0))
             {
-                const StateChange::GroupsNotificationBasis &lSCN = static_cast<const StateChange::GroupsNotificationBasis &>(aStateChangeNotification);
-                const NSUInteger lRow = (lSCN.GetIdentifier() - 1);
+                if (mRefreshStageTracker->IsZoneUsable(lSCN.GetIdentifier()))
+                {
+                    mRefreshQueryScheduler.Complete(RefreshQueryScheduler::kKindZone, lSCN.GetIdentifier());
+
+                    [self issueRefreshQueries];
+                }
+            }
+        }
+        break;
+
+    default:
+        break;
+
+    }
+}
+
+// MARK: State Change Subscriptions
+
+/**
+ *  @brief
+ *    Subscribe to the state changes that the rows render.
+ *
+ *  Unlike the client controller delegate, which is swapped as views
+ *  come and go, the subscriptions last for the life of the view, such
+ *  that its rows are current whenever it reappears.
+ *
+ *  @param[in]  aStateChangeBus  A reference to the state change bus
+ *                               to subscribe to.
+ *
+ */
+- (void) subscribeToStateChanges: (StateChangeBus &)aStateChangeBus
+{
+    static const StateChange::Type kTypes[] = {
+        StateChange::kStateChangeType_GroupMute,
+        StateChange::kStateChangeType_GroupName,
+        StateChange::kStateChangeType_GroupSource,
+        StateChange::kStateChangeType_GroupVolume,
+        StateChange::kStateChangeType_SourceName,
+        StateChange::kStateChangeType_ZoneMute,
+        StateChange::kStateChangeType_ZoneName,
+        StateChange::kStateChangeType_ZoneSource,
+        StateChange::kStateChangeType_ZoneVolume
+    };
+    __weak GroupsAndZonesTableViewController *  lWeakSelf = self;
+    StateChangeBus::Token                       lToken;
+    Status                                      lStatus;
+
+
+    for (const StateChange::Type &lType : kTypes)
+    {
+        lStatus = aStateChangeBus.Subscribe(lType,
+                                            StateChangeBus::kIdentifierAny,
+                                            [lWeakSelf](const StateChange::NotificationBasis &aStateChangeNotification) {
+                                                [lWeakSelf reloadRowsForStateChange: aStateChangeNotification];
+                                            },
+                                            lToken);
+        nlREQUIRE_SUCCESS(lStatus, done);
+
+        mStateChangeTokens.push_back(lToken);
+    }
+
+ done:
+    return;
+}
+
+/**
+ *  @brief
+ *    Unsubscribe from the state changes that the rows render.
+ *
+ *  @param[in]  aStateChangeBus  A reference to the state change bus
+ *                               to unsubscribe from.
+ *
+ */
+- (void) unsubscribeFromStateChanges: (StateChangeBus &)aStateChangeBus
+{
+    for (const StateChangeBus::Token &lToken : mStateChangeTokens)
+    {
+        aStateChangeBus.Unsubscribe(lToken);
+    }
+
+    mStateChangeTokens.clear();
+}
+
+/**
+ *  @brief
+ *    Mark the row, or rows, for the group, source, or zone that a
+ *    state change is for dirty.
+ *
+ *  Rather than reloading the rows at once, they are reloaded
+ *  together at the end of the run loop turn, such that the many
+ *  state changes of a refresh or of a group volume change reload
+ *  each row once.
+ *
+ *  @param[in]  aStateChangeNotification  An immutable reference
+ *                                        to a notification
+ *                                        describing the state
+ *                                        change.
+ *
+ */
+- (void) reloadRowsForStateChange: (const StateChange::NotificationBasis &)aStateChangeNotification
+{
+    const StateChange::Type  lType = aStateChangeNotification.GetType();
+    bool                     lSchedule = false;
 
-                lIndexPath = [NSIndexPath indexPathForRow: lRow
-                                          inSection: 0];
+    switch (lType)
+    {
 
-                [self.tableView reloadRowsAtIndexPaths: [NSArray arrayWithObject: lIndexPath]
-                                withRowAnimation: UITableViewRowAnimationNone];
+    case StateChange::kStateChangeType_GroupMute:
+    case StateChange::kStateChangeType_GroupName:
+    case StateChange::kStateChangeType_GroupSource:
+    case StateChange::kStateChangeType_GroupVolume:
+        {
+            const StateChange::GroupsNotificationBasis &lSCN = static_cast<const StateChange::GroupsNotificationBasis &>(aStateChangeNotification);
+
+            if (lType == StateChange::kStateChangeType_GroupSource)
+            {
+                [self indexSourceRowForGroup: lSCN.GetIdentifier()];
+            }
+
+            if (mShowStyle == kShowStyleGroups)
+            {
+                lSchedule = mRowReloadCoalescer.Mark(RowReloadCoalescer::kKindGroup, lSCN.GetIdentifier());
             }
         }
         break;
 
     case StateChange::kStateChangeType_SourceName:
-        [self.tableView reloadData];
+        {
+            const StateChange::SourcesNameNotification &lSCN = static_cast<const StateChange::SourcesNameNotification &>(aStateChangeNotification);
+            const bool                                  lAsGroup = (mShowStyle == kShowStyleGroups);
+            const SourceRowIndex::Identifiers &         lRows = mSourceRowIndex.GetRows((lAsGroup ? SourceRowIndex::kKindGroup : SourceRowIndex::kKindZone), lSCN.GetIdentifier());
+
+            // Only the rows rendering the renamed source need
+            // rendering again; all others are unaffected.
+
+            for (const SourceRowIndex::IdentifierType &lRow : lRows)
+            {
+                const bool lFirst = mRowReloadCoalescer.Mark((lAsGroup ? RowReloadCoalescer::kKindGroup : RowReloadCoalescer::kKindZone), lRow);
+
+                lSchedule = (lSchedule || lFirst);
+            }
+        }
         break;
 
     case StateChange::kStateChangeType_ZoneMute:
@@ -369,16 +1132,18 @@ done:
     case StateChange::kStateChangeType_ZoneSource:
     case StateChange::kStateChangeType_ZoneVolume:
         {
-            if (mShowStyle == kShowStyleZones)
+            const StateChange::ZonesNotificationBasis &lSCN = static_cast<const StateChange::ZonesNotificationBasis &>(aStateChangeNotification);
+
+            if (lType == StateChange::kStateChangeType_ZoneSource)
             {
-                const StateChange::ZonesNotificationBasis &lSCN = static_cast<const StateChange::ZonesNotificationBasis &>(aStateChangeNotification);
-                const NSUInteger lRow = (lSCN.GetIdentifier() - 1);
+                const StateChange::ZonesSourceNotification &lSourceSCN = static_cast<const StateChange::ZonesSourceNotification &>(aStateChangeNotification);
 
-                lIndexPath = [NSIndexPath indexPathForRow: lRow
-                                          inSection: 0];
+                mSourceRowIndex.SetSource(SourceRowIndex::kKindZone, lSourceSCN.GetIdentifier(), lSourceSCN.GetSource());
+            }
 
-                [self.tableView reloadRowsAtIndexPaths: [NSArray arrayWithObject: lIndexPath]
-                                withRowAnimation: UITableViewRowAnimationNone];
+            if (mShowStyle == kShowStyleZones)
+            {
+                lSchedule = mRowReloadCoalescer.Mark(RowReloadCoalescer::kKindZone, lSCN.GetIdentifier());
             }
         }
         break;
@@ -388,8 +1153,169 @@ done:
 
     }
 
+    // If these are the first rows dirtied since the last reload,
+    // reload them, and any others dirtied in the meantime, once the
+    // main queue has finished with the current run loop turn.
+
+    if (lSchedule)
+    {
+        __weak GroupsAndZonesTableViewController *  lWeakSelf = self;
+
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [lWeakSelf reloadDirtyRows];
+        });
+    }
+}
+
+/**
+ *  @brief
+ *    Reload, together, the rows that state changes have left dirty.
+ *
+ */
+- (void) reloadDirtyRows
+{
+    const RowReloadCoalescer::Kind  lKind = ((mShowStyle == kShowStyleGroups) ?
+                                             RowReloadCoalescer::kKindGroup :
+                                             RowReloadCoalescer::kKindZone);
+    RowReloadCoalescer::Batch       lBatch;
+    NSMutableArray *                lIndexPaths;
+
+
+    // The rows may have already been reloaded in full, for example,
+    // by a change in show style, since this reload was scheduled.
+
+    nlEXPECT(mRowReloadCoalescer.IsPending(), done);
+
+    mRowReloadCoalescer.Take(lBatch);
+
+    if (lBatch.mAll)
+    {
+        [self.tableView reloadData];
+    }
+    else if (!lBatch.mIdentifiers[lKind].empty())
+    {
+        lIndexPaths = [NSMutableArray arrayWithCapacity: lBatch.mIdentifiers[lKind].size()];
+        nlREQUIRE(lIndexPaths != nullptr, done);
+
+        for (const RowReloadCoalescer::IdentifierType &lIdentifier : lBatch.mIdentifiers[lKind])
+        {
+            const NSUInteger lRow = (lIdentifier - 1);
+
+            [lIndexPaths addObject: [NSIndexPath indexPathForRow: lRow
+                                                  inSection: 0]];
+        }
+
+        [self.tableView reloadRowsAtIndexPaths: lIndexPaths
+                        withRowAnimation: UITableViewRowAnimationNone];
+    }
+
+ done:
+    return;
+}
+
+// MARK: Source Row Index
+
+/**
+ *  @brief
+ *    Index every group and zone row by the source whose name it
+ *    renders, as the client controller data model stands.
+ *
+ */
+- (void) indexSourceRows
+{
+    IdentifierModel::IdentifierType  lGroups = 0;
+    IdentifierModel::IdentifierType  lZones = 0;
+    Status                           lStatus;
+
+
+    nlEXPECT(mApplicationController != nullptr, done);
+
+    mSourceRowIndex.Clear();
+
+    lStatus = mApplicationController->GroupsGetMax(lGroups);
+    nlREQUIRE_SUCCESS(lStatus, done);
+
+    for (IdentifierModel::IdentifierType lGroup = IdentifierModel::kIdentifierMin; lGroup <= lGroups; lGroup++)
+    {
+        [self indexSourceRowForGroup: lGroup];
+    }
+
+    lStatus = mApplicationController->ZonesGetMax(lZones);
+    nlREQUIRE_SUCCESS(lStatus, done);
+
+    for (IdentifierModel::IdentifierType lZone = IdentifierModel::kIdentifierMin; lZone <= lZones; lZone++)
+    {
+        [self indexSourceRowForZone: lZone];
+    }
+
  done:
     return;
 }
 
+/**
+ *  @brief
+ *    Index the row for the specified group by the source whose name
+ *    it renders: its source, if it has only one; otherwise, none.
+ *
+ *  @param[in]  aIdentifier  The identifier of the group.
+ *
+ */
+- (void) indexSourceRowForGroup: (const GroupModel::IdentifierType &)aIdentifier
+{
+    const GroupModel *           lGroup;
+    size_t                       lSourceCount;
+    SourceModel::IdentifierType  lSourceIdentifier;
+    SourceModel::IdentifierType  lIndexedSourceIdentifier = SourceRowIndex::kSourceNone;
+    Status                       lStatus;
+
+
+    lStatus = mApplicationController->GroupGet(aIdentifier, lGroup);
+    nlEXPECT_SUCCESS(lStatus, done);
+
+    lStatus = lGroup->GetSources(lSourceCount);
+    nlEXPECT_SUCCESS(lStatus, done);
+
+    if (lSourceCount == 1)
+    {
+        lStatus = lGroup->GetSources(&lSourceIdentifier, lSourceCount);
+        nlEXPECT_SUCCESS(lStatus, done);
+
+        lIndexedSourceIdentifier = lSourceIdentifier;
+    }
+
+ done:
+    mSourceRowIndex.SetSource(SourceRowIndex::kKindGroup, aIdentifier, lIndexedSourceIdentifier);
+
+    return;
+}
+
+/**
+ *  @brief
+ *    Index the row for the specified zone by its source.
+ *
+ *  @param[in]  aIdentifier  The identifier of the zone.
+ *
+ */
+- (void) indexSourceRowForZone: (const ZoneModel::IdentifierType &)aIdentifier
+{
+    const ZoneModel *            lZone;
+    SourceModel::IdentifierType  lSourceIdentifier;
+    SourceModel::IdentifierType  lIndexedSourceIdentifier = SourceRowIndex::kSourceNone;
+    Status                       lStatus;
+
+
+    lStatus = mApplicationController->ZoneGet(aIdentifier, lZone);
+    nlEXPECT_SUCCESS(lStatus, done);
+
+    lStatus = lZone->GetSource(lSourceIdentifier);
+    nlEXPECT_SUCCESS(lStatus, done);
+
+    lIndexedSourceIdentifier = lSourceIdentifier;
+
+ done:
+    mSourceRowIndex.SetSource(SourceRowIndex::kKindZone, aIdentifier, lIndexedSourceIdentifier);
+
+    return;
+}
+
 @end
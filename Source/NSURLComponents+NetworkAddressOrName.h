@@ -0,0 +1,46 @@
+/*
+ *    Copyright (c) 2026 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *  @file
+ *    This file declares extension class and instance methods to
+ *    NSURLComponents for parsing the IP address, host name, IP
+ *    address and port, host name and port, or URL of a HLX server
+ *    as entered by the user.
+ *
+ */
+
+#ifndef NSURLCOMPONENTS_EXTENDED_BY_NETWORKADDRESSORNAME_H
+#define NSURLCOMPONENTS_EXTENDED_BY_NETWORKADDRESSORNAME_H
+
+#import <Foundation/NSURL.h>
+
+@interface NSURLComponents (NetworkAddressOrName)
+
+// MARK: Class Methods
+
++ (NSURLComponents *) componentsWithNetworkAddressOrName: (NSString *)aNetworkAddressOrName;
+
+// MARK: Instance Methods
+
+- (NSString *) unbracketedHost;
+- (NSString *) portOrDefault;
+
+@end
+
+#endif // NSURLCOMPONENTS_EXTENDED_BY_NETWORKADDRESSORNAME_H
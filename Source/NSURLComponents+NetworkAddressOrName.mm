@@ -0,0 +1,103 @@
+/*
+ *    Copyright (c) 2026 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *  @file
+ *    This file implements extension class and instance methods to
+ *    NSURLComponents for parsing the IP address, host name, IP
+ *    address and port, host name and port, or URL of a HLX server
+ *    as entered by the user.
+ *
+ */
+
+#import "NSURLComponents+NetworkAddressOrName.h"
+
+#import <Foundation/NSCharacterSet.h>
+#import <Foundation/NSString.h>
+
+
+@implementation NSURLComponents (NetworkAddressOrName)
+
+// MARK: Class Methods
+
+/**
+ *  @brief
+ *    Parse the specified IP address, host name, IP address and port,
+ *    host name and port, or URL of a HLX server.
+ *
+ *  Everything short of a URL is parsed as the host and port of a
+ *  telnet URL, the scheme that the HLX client controller assumes for
+ *  them.
+ *
+ *  @param[in]  aNetworkAddressOrName  A pointer to a string containing
+ *                                     the IP address, host name, IP
+ *                                     address and port, host name
+ *                                     and port, or URL to parse.
+ *
+ *  @returns
+ *    A pointer to the parsed URL components, if successful and a
+ *    host was present; otherwise, null.
+ *
+ */
++ (NSURLComponents *) componentsWithNetworkAddressOrName: (NSString *)aNetworkAddressOrName
+{
+    NSString *         lURLString;
+    NSURLComponents *  lRetval = nullptr;
+
+    if (aNetworkAddressOrName != nullptr)
+    {
+        lURLString = ([aNetworkAddressOrName containsString: @"://"] ?
+                      aNetworkAddressOrName :
+                      [@"telnet://" stringByAppendingString: aNetworkAddressOrName]);
+
+        lRetval = [NSURLComponents componentsWithString: lURLString];
+
+        if ((lRetval != nullptr) && ([[lRetval unbracketedHost] length] == 0))
+        {
+            lRetval = nullptr;
+        }
+    }
+
+    return (lRetval);
+}
+
+// MARK: Instance Methods
+
+/**
+ *  @brief
+ *    Return the host, stripped of any brackets around an IPv6
+ *    address, suitable for resolving.
+ *
+ */
+- (NSString *) unbracketedHost
+{
+    return ([self.host stringByTrimmingCharactersInSet: [NSCharacterSet characterSetWithCharactersInString: @"[]"]]);
+}
+
+/**
+ *  @brief
+ *    Return the port, or the telnet port if there is none, suitable
+ *    for resolving.
+ *
+ */
+- (NSString *) portOrDefault
+{
+    return ((self.port != nullptr) ? [self.port stringValue] : @"23");
+}
+
+@end
@@ -0,0 +1,315 @@
+/*
+ *    Copyright (c) 2026 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *  @file
+ *    This file implements an object for classifying a connected HLX
+ *    peer as either character-at-a-time HLX hardware or a
+ *    line-buffered proxy.
+ *
+ */
+
+#include "PeerProbe.hpp"
+
+#include <string.h>
+
+#include <LogUtilities/LogUtilities.hpp>
+
+#include <OpenHLX/Client/ZonesStateChangeNotifications.hpp>
+#include <OpenHLX/Utilities/Assert.hpp>
+
+
+using namespace HLX::Client;
+using namespace HLX::Common;
+using namespace HLX::Model;
+using namespace Nuovations;
+
+
+// The zone queried by the probe. Every HLX has at least one zone.
+
+static const IdentifierModel::IdentifierType kZoneIdentifier = 1;
+
+// Zone properties that, once all have arrived, complete the probe.
+
+enum
+{
+    kPropertyName   = 0x01,
+    kPropertySource = 0x02,
+    kPropertyVolume = 0x04,
+    kPropertyMute   = 0x08,
+
+    kPropertiesAll  = (kPropertyName   |
+                       kPropertySource |
+                       kPropertyVolume |
+                       kPropertyMute)
+};
+
+const PeerProbe::Duration PeerProbe::kTimeout(2000);
+const PeerProbe::Duration PeerProbe::kHardwareThreshold(150);
+
+/**
+ *  @brief
+ *    This is the class default constructor.
+ *
+ */
+PeerProbe :: PeerProbe(void) :
+    mActive(false),
+    mAnswered(false),
+    mProperties(0),
+    mStart(),
+    mStop()
+{
+    return;
+}
+
+/**
+ *  @brief
+ *    This is the class destructor.
+ *
+ */
+PeerProbe :: ~PeerProbe(void)
+{
+    return;
+}
+
+/**
+ *  @brief
+ *    Start the probe by issuing a zone query.
+ *
+ *  The caller is expected to forward state changes to
+ *  #StateDidChange and, once that returns true or #kTimeout has
+ *  elapsed, whichever is first, to call #Stop for the
+ *  classification.
+ *
+ *  @param[in]  aController  A reference to the connected client
+ *                           controller to probe through.
+ *
+ *  @retval  kStatus_Success  If successful.
+ *
+ */
+Status
+PeerProbe :: Start(HLX::Client::Application::Controller &aController)
+{
+    Status  lRetval;
+
+
+    mAnswered   = false;
+    mProperties = 0;
+    mStart      = Clock::now();
+
+    lRetval = aController.ZoneQuery(kZoneIdentifier);
+    nlREQUIRE_SUCCESS(lRetval, done);
+
+    mActive = true;
+
+ done:
+    return (lRetval);
+}
+
+bool
+PeerProbe :: IsActive(void) const
+{
+    return (mActive);
+}
+
+/**
+ *  @brief
+ *    Observe a client controller state change.
+ *
+ *  @param[in]  aStateChangeNotification  An immutable reference
+ *                                        to a notification
+ *                                        describing the state
+ *                                        change.
+ *
+ *  @returns
+ *    True if the probe has been answered; otherwise, false.
+ *
+ */
+bool
+PeerProbe :: StateDidChange(const StateChange::NotificationBasis &aStateChangeNotification)
+{
+    const StateChange::Type  lType = aStateChangeNotification.GetType();
+
+
+    nlEXPECT(mActive && !mAnswered, done);
+
+    switch (lType)
+    {
+
+    case StateChange::kStateChangeType_ZoneMute:
+    case StateChange::kStateChangeType_ZoneName:
+    case StateChange::kStateChangeType_ZoneSource:
+    case StateChange::kStateChangeType_ZoneVolume:
+        {
+            const StateChange::ZonesNotificationBasis &lSCN = static_cast<const StateChange::ZonesNotificationBasis &>(aStateChangeNotification);
+
+            if (lSCN.GetIdentifier() == kZoneIdentifier)
+            {
+                mProperties |= ((lType == StateChange::kStateChangeType_ZoneMute)   ? kPropertyMute   :
+                                (lType == StateChange::kStateChangeType_ZoneName)   ? kPropertyName   :
+                                (lType == StateChange::kStateChangeType_ZoneSource) ? kPropertySource :
+                                                                                      kPropertyVolume);
+            }
+        }
+        break;
+
+    default:
+        break;
+
+    }
+
+    if (mProperties == kPropertiesAll)
+    {
+        mAnswered = true;
+        mStop     = Clock::now();
+    }
+
+ done:
+    return (mAnswered);
+}
+
+/**
+ *  @brief
+ *    Stop the probe and classify the peer.
+ *
+ *  A probe that was not answered, by the time it is stopped, is
+ *  classified as hardware since, of the two, hardware is the one
+ *  that is both slow to answer and not to be overrun. Since it may
+ *  instead not have been answered because the client controller
+ *  model already matched the answer, that classification is not to
+ *  be persisted; see #IsAnswered.
+ *
+ *  @returns
+ *    The peer class, or kClassUnknown if the probe was not active.
+ *
+ */
+PeerProbe::Class
+PeerProbe :: Stop(void)
+{
+    Class  lRetval = kClassUnknown;
+
+
+    nlEXPECT(mActive, done);
+
+    mActive = false;
+
+    if (!mAnswered)
+    {
+        mStop = Clock::now();
+    }
+
+    lRetval = ((mAnswered && (GetElapsed() < kHardwareThreshold)) ? kClassProxy : kClassHardware);
+
+    Log::Info().Write("Peer %s in %lld ms; classified as %s.\n",
+                      (mAnswered ? "answered" : "did not answer"),
+                      static_cast<long long>(GetElapsed().count()),
+                      GetClassName(lRetval));
+
+ done:
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Return whether the probe was answered in full, rather than
+ *    stopped or timed out before it was.
+ *
+ */
+bool
+PeerProbe :: IsAnswered(void) const
+{
+    return (mAnswered);
+}
+
+/**
+ *  @brief
+ *    Return the time the probe took, or has taken so far.
+ *
+ */
+PeerProbe::Duration
+PeerProbe :: GetElapsed(void) const
+{
+    const Clock::time_point lStop = ((mActive && !mAnswered) ? Clock::now() : mStop);
+
+    return (std::chrono::duration_cast<Duration>(lStop - mStart));
+}
+
+/**
+ *  @brief
+ *    Return the persistable name for the specified peer class.
+ *
+ */
+const char *
+PeerProbe :: GetClassName(const Class &aClass)
+{
+    return ((aClass == kClassHardware) ? "Hardware" :
+            (aClass == kClassProxy)    ? "Proxy"    :
+                                         "Unknown");
+}
+
+/**
+ *  @brief
+ *    Return the peer class for the specified persisted name.
+ *
+ *  @returns
+ *    The peer class, or kClassUnknown if @a aClassName was null or
+ *    not recognized.
+ *
+ */
+PeerProbe::Class
+PeerProbe :: GetClass(const char *aClassName)
+{
+    Class  lRetval = kClassUnknown;
+
+
+    nlEXPECT(aClassName != nullptr, done);
+
+    if (strcmp(aClassName, GetClassName(kClassHardware)) == 0)
+    {
+        lRetval = kClassHardware;
+    }
+    else if (strcmp(aClassName, GetClassName(kClassProxy)) == 0)
+    {
+        lRetval = kClassProxy;
+    }
+
+ done:
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Return the client settings suited to the specified peer class.
+ *
+ *  Hardware gets strict one-at-a-time requests and a generous
+ *  response timeout such that it is never overrun; a proxy gets a
+ *  deep pipeline and a short response timeout such that its link is
+ *  kept busy. An unknown peer gets a conservative middle ground.
+ *
+ */
+const PeerProbe::Profile &
+PeerProbe :: GetProfile(const Class &aClass)
+{
+    static const Profile kProfileUnknown  = { 2,  Duration(5000) };
+    static const Profile kProfileHardware = { 1,  Duration(5000) };
+    static const Profile kProfileProxy    = { 8,  Duration(1000) };
+
+    return ((aClass == kClassHardware) ? kProfileHardware :
+            (aClass == kClassProxy)    ? kProfileProxy    :
+                                         kProfileUnknown);
+}
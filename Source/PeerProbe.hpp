@@ -0,0 +1,128 @@
+/*
+ *    Copyright (c) 2026 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *  @file
+ *    This file defines an object for classifying a connected HLX peer
+ *    as either character-at-a-time HLX hardware or a line-buffered
+ *    proxy.
+ *
+ */
+
+#ifndef PEERPROBE_HPP
+#define PEERPROBE_HPP
+
+#include <chrono>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <OpenHLX/Client/ApplicationController.hpp>
+#include <OpenHLX/Client/ApplicationControllerDelegate.hpp>
+#include <OpenHLX/Common/Errors.hpp>
+#include <OpenHLX/Model/IdentifierModel.hpp>
+
+
+/**
+ *  @brief
+ *    An object for classifying a connected HLX peer.
+ *
+ *  The probe times a single zone query, from when it is issued to
+ *  when the zone name, source, volume, and mute have all arrived. HLX
+ *  hardware, with its character-at-a-time I/O, takes hundreds of
+ *  milliseconds to answer; a line-buffered proxy answers in tens.
+ *
+ *  Since the client controller reports a state change only for a
+ *  property that differs from its model, and nothing at the end of
+ *  a query, a probe of a zone whose name, source, volume, and mute
+ *  the model already has, as on a reconnect, is never answered and
+ *  times out. Such a classification is only a safe guess for the
+ *  connection at hand.
+ *
+ *  Each peer class has a profile of the client settings that suit
+ *  it. The class name of an answered probe is suitable for
+ *  persisting, such that later connections to the same location may
+ *  skip the probe.
+ *
+ */
+class PeerProbe
+{
+public:
+    /**
+     *  The peer class.
+     *
+     */
+    enum Class
+    {
+        kClassUnknown = 0, //!< Not yet, or not able to be, classified.
+        kClassHardware,    //!< Character-at-a-time HLX hardware.
+        kClassProxy        //!< A line- or buffer-at-a-time proxy.
+    };
+
+    typedef std::chrono::steady_clock Clock;
+    typedef std::chrono::milliseconds Duration;
+
+    /**
+     *  The client settings suited to a peer class.
+     *
+     */
+    struct Profile
+    {
+        size_t    mPipelineDepth;   //!< The command pipeline depth.
+        Duration  mResponseTimeout; //!< The command response timeout.
+    };
+
+    /**
+     *  The time after which an unanswered probe is abandoned and the
+     *  peer classified as hardware.
+     *
+     */
+    static const Duration kTimeout;
+
+    /**
+     *  The probe response time at and above which the peer is
+     *  classified as hardware.
+     *
+     */
+    static const Duration kHardwareThreshold;
+
+public:
+    PeerProbe(void);
+    ~PeerProbe(void);
+
+    HLX::Common::Status Start(HLX::Client::Application::Controller &aController);
+    bool                IsActive(void) const;
+    bool                StateDidChange(const HLX::Client::StateChange::NotificationBasis &aStateChangeNotification);
+    Class               Stop(void);
+
+    bool                IsAnswered(void) const;
+    Duration            GetElapsed(void) const;
+
+    static const char *    GetClassName(const Class &aClass);
+    static Class           GetClass(const char *aClassName);
+    static const Profile & GetProfile(const Class &aClass);
+
+private:
+    bool               mActive;
+    bool               mAnswered;
+    uint8_t            mProperties;
+    Clock::time_point  mStart;
+    Clock::time_point  mStop;
+};
+
+#endif // PEERPROBE_HPP
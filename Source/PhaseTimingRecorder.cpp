@@ -0,0 +1,840 @@
+/*
+ *    Copyright (c) 2026 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *  @file
+ *    This file implements an object for timing the resolve, connect,
+ *    and refresh phases of a HLX client controller session and for
+ *    accumulating those timings into persistent, per-site histograms.
+ *
+ */
+
+#include "PhaseTimingRecorder.hpp"
+
+#include <errno.h>
+#include <inttypes.h>
+#include <string.h>
+
+#include <LogUtilities/LogUtilities.hpp>
+
+#include <OpenHLX/Utilities/Assert.hpp>
+
+
+using namespace HLX::Client;
+using namespace HLX::Common;
+using namespace Nuovations;
+
+
+// The first line of, and format version for, the state file.
+
+static const char * const kStateFileHeader = "# PhaseTimingRecorder 1\n";
+
+// The site used for timings recorded before any site is set.
+
+static const char * const kSiteUnknown     = "(unknown)";
+
+// The upper limit, in milliseconds, of each histogram bucket. The
+// last bucket is unbounded.
+
+static const uint64_t     kBucketLimits[PhaseTimingRecorder::Histogram::kBucketsMax] =
+{
+    10, 25, 50, 100, 250, 500, 1000, 2500, 5000, 10000, 25000, 60000, 120000, UINT64_MAX
+};
+
+// MARK: Histogram
+
+/**
+ *  @brief
+ *    This is the class default constructor.
+ *
+ */
+PhaseTimingRecorder :: Histogram :: Histogram(void) :
+    mBuckets(),
+    mCount(0),
+    mSum(0),
+    mMinimum(0),
+    mMaximum(0)
+{
+    return;
+}
+
+/**
+ *  @brief
+ *    Add a duration to the histogram.
+ *
+ *  @param[in]  aDuration  The duration to add.
+ *
+ */
+void
+PhaseTimingRecorder :: Histogram :: Add(const Duration &aDuration)
+{
+    const uint64_t  lMilliseconds = ((aDuration.count() < 0) ? 0 : static_cast<uint64_t>(aDuration.count()));
+    size_t          lBucket;
+
+
+    for (lBucket = 0; lBucket < (kBucketsMax - 1); lBucket++)
+    {
+        if (lMilliseconds <= kBucketLimits[lBucket])
+        {
+            break;
+        }
+    }
+
+    mBuckets[lBucket]++;
+
+    mMinimum = ((mCount == 0) ? lMilliseconds : std::min(mMinimum, lMilliseconds));
+    mMaximum = ((mCount == 0) ? lMilliseconds : std::max(mMaximum, lMilliseconds));
+
+    mCount++;
+    mSum += lMilliseconds;
+}
+
+uint32_t
+PhaseTimingRecorder :: Histogram :: GetCount(void) const
+{
+    return (mCount);
+}
+
+uint32_t
+PhaseTimingRecorder :: Histogram :: GetBucketCount(const size_t &aBucket) const
+{
+    return ((aBucket < kBucketsMax) ? mBuckets[aBucket] : 0);
+}
+
+PhaseTimingRecorder::Duration
+PhaseTimingRecorder :: Histogram :: GetMinimum(void) const
+{
+    return (Duration(mMinimum));
+}
+
+PhaseTimingRecorder::Duration
+PhaseTimingRecorder :: Histogram :: GetMaximum(void) const
+{
+    return (Duration(mMaximum));
+}
+
+PhaseTimingRecorder::Duration
+PhaseTimingRecorder :: Histogram :: GetMean(void) const
+{
+    return (Duration((mCount == 0) ? 0 : (mSum / mCount)));
+}
+
+/**
+ *  @brief
+ *    Return an estimate of the specified percentile duration.
+ *
+ *  The estimate is the upper limit of the bucket containing the
+ *  percentile, clamped to the maximum duration observed.
+ *
+ *  @param[in]  aPercentile  The percentile, from 0 to 100, to
+ *                           estimate.
+ *
+ *  @returns
+ *    The estimated percentile duration, or zero if the histogram is
+ *    empty.
+ *
+ */
+PhaseTimingRecorder::Duration
+PhaseTimingRecorder :: Histogram :: GetPercentile(const unsigned int &aPercentile) const
+{
+    const uint64_t  lRank = ((static_cast<uint64_t>(mCount) * std::min(aPercentile, 100U)) + 99) / 100;
+    uint64_t        lCumulative = 0;
+    uint64_t        lRetval = 0;
+    size_t          lBucket;
+
+
+    nlEXPECT(mCount > 0, done);
+
+    for (lBucket = 0; lBucket < kBucketsMax; lBucket++)
+    {
+        lCumulative += mBuckets[lBucket];
+
+        if ((lCumulative >= lRank) && (lCumulative > 0))
+        {
+            break;
+        }
+    }
+
+    lRetval = std::min(kBucketLimits[std::min(lBucket, kBucketsMax - 1)], mMaximum);
+
+ done:
+    return (Duration(lRetval));
+}
+
+/**
+ *  @brief
+ *    Return the upper limit of the specified bucket.
+ *
+ *  @param[in]  aBucket  The bucket for which to return the limit.
+ *
+ *  @returns
+ *    The bucket upper limit, or Duration::max() for the last,
+ *    unbounded bucket.
+ *
+ */
+PhaseTimingRecorder::Duration
+PhaseTimingRecorder :: Histogram :: GetBucketLimit(const size_t &aBucket)
+{
+    return (((aBucket + 1) < kBucketsMax) ? Duration(kBucketLimits[aBucket]) : Duration::max());
+}
+
+// MARK: Recorder
+
+/**
+ *  @brief
+ *    This is the class default constructor.
+ *
+ */
+PhaseTimingRecorder :: PhaseTimingRecorder(void) :
+    mStatePath(),
+    mDumpPath(),
+    mSite(kSiteUnknown),
+    mSites(),
+    mStartTimes(),
+    mStarted(),
+    mLastArrivals(),
+    mArrived(),
+    mLastDurations(),
+    mRecorded()
+{
+    return;
+}
+
+/**
+ *  @brief
+ *    This is the class destructor.
+ *
+ */
+PhaseTimingRecorder :: ~PhaseTimingRecorder(void)
+{
+    return;
+}
+
+/**
+ *  @brief
+ *    This is the class initializer.
+ *
+ *  This initializes the recorder and loads any histograms previously
+ *  saved to the state file.
+ *
+ *  @param[in]  aStatePath  A pointer to a null-terminated C string
+ *                          containing the path of the file to save
+ *                          and load histograms to and from.
+ *  @param[in]  aDumpPath   A pointer to a null-terminated C string
+ *                          containing the path of the file to dump
+ *                          human-readable histograms to.
+ *
+ *  @retval  kStatus_Success  If successful.
+ *  @retval  -EINVAL          If either path was null.
+ *
+ */
+Status
+PhaseTimingRecorder :: Init(const char *aStatePath, const char *aDumpPath)
+{
+    Status  lRetval = kStatus_Success;
+
+
+    nlREQUIRE_ACTION(aStatePath != nullptr, done, lRetval = -EINVAL);
+    nlREQUIRE_ACTION(aDumpPath != nullptr, done, lRetval = -EINVAL);
+
+    mStatePath = aStatePath;
+    mDumpPath  = aDumpPath;
+
+    // A missing or unreadable state file is not an error; it simply
+    // means there is no history yet.
+
+    lRetval = Load();
+    nlEXPECT_ACTION(lRetval == kStatus_Success, done, lRetval = kStatus_Success);
+
+ done:
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Set the site against which subsequent timings are recorded.
+ *
+ *  @param[in]  aSite  A pointer to a null-terminated C string
+ *                     containing the network address, name, or URL
+ *                     of the site.
+ *
+ */
+void
+PhaseTimingRecorder :: SetSite(const char *aSite)
+{
+    mSite = (((aSite != nullptr) && (*aSite != '\0')) ? aSite : kSiteUnknown);
+
+    // Tabs and newlines delimit the state file; they have no place
+    // in a network address, name, or URL anyway.
+
+    for (auto &lCharacter : mSite)
+    {
+        if ((lCharacter == '\t') || (lCharacter == '\n'))
+        {
+            lCharacter = ' ';
+        }
+    }
+
+    // Durations recorded against the prior site say nothing of this
+    // one.
+
+    for (size_t lPhase = 0; lPhase < kPhaseMax; lPhase++)
+    {
+        mRecorded[lPhase] = false;
+    }
+}
+
+// MARK: Observation
+
+void
+PhaseTimingRecorder :: WillResolve(void)
+{
+    Start(kPhaseResolve);
+}
+
+/**
+ *  @brief
+ *    Observe that the host name did resolve.
+ *
+ *  Since a host name may resolve to more than one address, only the
+ *  first resolution stops the phase.
+ *
+ */
+void
+PhaseTimingRecorder :: DidResolve(void)
+{
+    Stop(kPhaseResolve);
+}
+
+void
+PhaseTimingRecorder :: WillConnect(void)
+{
+    Start(kPhaseConnect);
+}
+
+void
+PhaseTimingRecorder :: DidConnect(void)
+{
+    Stop(kPhaseConnect);
+}
+
+/**
+ *  @brief
+ *    Observe that the client controller will refresh.
+ *
+ *  This starts all of the refresh phases.
+ *
+ */
+void
+PhaseTimingRecorder :: WillRefresh(void)
+{
+    size_t  lPhase;
+
+    for (lPhase = kPhaseRefreshSources; lPhase <= kPhaseRefreshComplete; lPhase++)
+    {
+        Start(static_cast<Phase>(lPhase));
+
+        mArrived[lPhase] = false;
+    }
+}
+
+/**
+ *  @brief
+ *    Observe a client controller state change.
+ *
+ *  While a refresh is in progress, this notes the arrival time of
+ *  the state change against its entity class.
+ *
+ *  @param[in]  aStateChangeNotification  An immutable reference
+ *                                        to a notification
+ *                                        describing the state
+ *                                        change.
+ *
+ */
+void
+PhaseTimingRecorder :: StateDidChange(const StateChange::NotificationBasis &aStateChangeNotification)
+{
+    Phase  lPhase;
+
+
+    nlEXPECT(mStarted[kPhaseRefreshComplete], done);
+
+    switch (aStateChangeNotification.GetType())
+    {
+
+    case StateChange::kStateChangeType_EqualizerPresetBand:
+    case StateChange::kStateChangeType_EqualizerPresetName:
+        lPhase = kPhaseRefreshEqualizerPresets;
+        break;
+
+    case StateChange::kStateChangeType_GroupMute:
+    case StateChange::kStateChangeType_GroupName:
+    case StateChange::kStateChangeType_GroupSource:
+    case StateChange::kStateChangeType_GroupVolume:
+        lPhase = kPhaseRefreshGroups;
+        break;
+
+    case StateChange::kStateChangeType_SourceName:
+        lPhase = kPhaseRefreshSources;
+        break;
+
+    case StateChange::kStateChangeType_ZoneBalance:
+    case StateChange::kStateChangeType_ZoneEqualizerBand:
+    case StateChange::kStateChangeType_ZoneEqualizerPreset:
+    case StateChange::kStateChangeType_ZoneHighpassCrossover:
+    case StateChange::kStateChangeType_ZoneLowpassCrossover:
+    case StateChange::kStateChangeType_ZoneMute:
+    case StateChange::kStateChangeType_ZoneName:
+    case StateChange::kStateChangeType_ZoneSoundMode:
+    case StateChange::kStateChangeType_ZoneSource:
+    case StateChange::kStateChangeType_ZoneTone:
+    case StateChange::kStateChangeType_ZoneVolume:
+        lPhase = kPhaseRefreshZones;
+        break;
+
+    default:
+        lPhase = kPhaseMax;
+        break;
+
+    }
+
+    nlEXPECT(lPhase != kPhaseMax, done);
+
+    mLastArrivals[lPhase] = Clock::now();
+    mArrived[lPhase]      = true;
+
+ done:
+    return;
+}
+
+/**
+ *  @brief
+ *    Observe that the client controller did refresh.
+ *
+ *  This records the refresh entity class phases, through the last
+ *  arrival in each class, and the refresh complete phase, and then
+ *  saves and dumps the histograms.
+ *
+ */
+void
+PhaseTimingRecorder :: DidRefresh(void)
+{
+    size_t  lPhase;
+    Status  lStatus;
+
+
+    nlEXPECT(mStarted[kPhaseRefreshComplete], done);
+
+    for (lPhase = kPhaseRefreshSources; lPhase <= kPhaseRefreshEqualizerPresets; lPhase++)
+    {
+        if (mArrived[lPhase])
+        {
+            Record(static_cast<Phase>(lPhase),
+                   std::chrono::duration_cast<Duration>(mLastArrivals[lPhase] - mStartTimes[lPhase]));
+        }
+
+        mStarted[lPhase] = false;
+    }
+
+    Stop(kPhaseRefreshComplete);
+
+    lStatus = Save();
+    nlVERIFY_SUCCESS(lStatus);
+
+    lStatus = Dump();
+    nlVERIFY_SUCCESS(lStatus);
+
+ done:
+    return;
+}
+
+/**
+ *  @brief
+ *    Record a phase duration against the current site.
+ *
+ *  @param[in]  aPhase     The phase to record.
+ *  @param[in]  aDuration  The phase duration.
+ *
+ */
+void
+PhaseTimingRecorder :: Record(const Phase &aPhase, const Duration &aDuration)
+{
+    nlREQUIRE(aPhase < kPhaseMax, done);
+
+    mSites[mSite].mPhases[aPhase].Add(aDuration);
+
+    mLastDurations[aPhase] = aDuration;
+    mRecorded[aPhase]      = true;
+
+    Log::Debug().Write("%s %s: %lld ms\n",
+                       mSite.c_str(),
+                       GetPhaseName(aPhase),
+                       static_cast<long long>(aDuration.count()));
+
+ done:
+    return;
+}
+
+// MARK: Introspection
+
+/**
+ *  @brief
+ *    Return the histogram for the specified site and phase.
+ *
+ *  @param[in]   aSite       A pointer to a null-terminated C string
+ *                           containing the site.
+ *  @param[in]   aPhase      The phase.
+ *  @param[out]  aHistogram  A reference to an immutable pointer to
+ *                           be set to the histogram.
+ *
+ *  @retval  kStatus_Success  If successful.
+ *  @retval  -EINVAL          If @a aSite was null.
+ *  @retval  -ERANGE          If @a aPhase was invalid.
+ *  @retval  -ENOENT          If there are no timings for @a aSite.
+ *
+ */
+Status
+PhaseTimingRecorder :: GetHistogram(const char *aSite, const Phase &aPhase, const Histogram *&aHistogram) const
+{
+    Sites::const_iterator  lSite;
+    Status                 lRetval = kStatus_Success;
+
+
+    nlREQUIRE_ACTION(aSite != nullptr, done, lRetval = -EINVAL);
+    nlREQUIRE_ACTION(aPhase < kPhaseMax, done, lRetval = -ERANGE);
+
+    lSite = mSites.find(aSite);
+    nlEXPECT_ACTION(lSite != mSites.end(), done, lRetval = -ENOENT);
+
+    aHistogram = &lSite->second.mPhases[aPhase];
+
+ done:
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Return the duration most recently recorded for the specified
+ *    phase at the current site.
+ *
+ *  @param[in]   aPhase     The phase for which to return the duration.
+ *  @param[out]  aDuration  A reference to storage for the duration.
+ *
+ *  @retval  kStatus_Success  If successful.
+ *  @retval  -ERANGE          If @a aPhase was out of range.
+ *  @retval  -ENOENT          If no duration has been recorded for
+ *                            @a aPhase since the site was last set.
+ *
+ */
+Status
+PhaseTimingRecorder :: GetLastDuration(const Phase &aPhase, Duration &aDuration) const
+{
+    Status  lRetval = kStatus_Success;
+
+
+    nlREQUIRE_ACTION(aPhase < kPhaseMax, done, lRetval = -ERANGE);
+    nlEXPECT_ACTION(mRecorded[aPhase], done, lRetval = -ENOENT);
+
+    aDuration = mLastDurations[aPhase];
+
+ done:
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Return a human-readable name for the specified phase.
+ *
+ *  @param[in]  aPhase  The phase.
+ *
+ *  @returns
+ *    A pointer to a null-terminated C string containing the phase
+ *    name.
+ *
+ */
+const char *
+PhaseTimingRecorder :: GetPhaseName(const Phase &aPhase)
+{
+    static const char * const kPhaseNames[kPhaseMax] =
+    {
+        "resolve",
+        "connect",
+        "refresh sources",
+        "refresh zones",
+        "refresh groups",
+        "refresh equalizer presets",
+        "refresh usable",
+        "refresh complete"
+    };
+
+    return ((aPhase < kPhaseMax) ? kPhaseNames[aPhase] : "unknown");
+}
+
+// MARK: Persistence
+
+/**
+ *  @brief
+ *    Load the histograms from the state file.
+ *
+ *  Any histograms in the state file replace those currently in
+ *  memory for the same site.
+ *
+ *  @retval  kStatus_Success  If successful.
+ *  @retval  -EINVAL          If the state file is not in the expected
+ *                            format.
+ *  @retval  -errno           If the state file could not be opened.
+ *
+ */
+Status
+PhaseTimingRecorder :: Load(void)
+{
+    FILE *  lStream;
+    char    lLine[1024];
+    Status  lRetval = kStatus_Success;
+
+
+    lStream = fopen(mStatePath.c_str(), "r");
+    nlEXPECT_ACTION(lStream != nullptr, done, lRetval = -errno);
+
+    nlEXPECT_ACTION(fgets(lLine, sizeof (lLine), lStream) != nullptr, close, lRetval = -EINVAL);
+    nlEXPECT_ACTION(strcmp(lLine, kStateFileHeader) == 0, close, lRetval = -EINVAL);
+
+    while (fgets(lLine, sizeof (lLine), lStream) != nullptr)
+    {
+        char *        lTab = strchr(lLine, '\t');
+        unsigned int  lPhase;
+        Histogram     lHistogram;
+        int           lOffset;
+        int           lConsumed;
+        size_t        lBucket = 0;
+        int           lConversions = 0;
+
+        // Silently skip any malformed lines rather than discarding the
+        // entire file.
+
+        if (lTab != nullptr)
+        {
+            *lTab = '\0';
+
+            lConversions = sscanf(lTab + 1,
+                                  "%u\t%" SCNu32 "\t%" SCNu64 "\t%" SCNu64 "\t%" SCNu64 "%n",
+                                  &lPhase,
+                                  &lHistogram.mCount,
+                                  &lHistogram.mSum,
+                                  &lHistogram.mMinimum,
+                                  &lHistogram.mMaximum,
+                                  &lOffset);
+        }
+
+        if ((lConversions == 5) && (lPhase < kPhaseMax))
+        {
+            lOffset += 1;
+
+            for (lBucket = 0; lBucket < Histogram::kBucketsMax; lBucket++)
+            {
+                if (sscanf(lTab + lOffset, "%" SCNu32 "%n", &lHistogram.mBuckets[lBucket], &lConsumed) != 1)
+                {
+                    break;
+                }
+
+                lOffset += lConsumed;
+            }
+        }
+
+        if (lBucket == Histogram::kBucketsMax)
+        {
+            mSites[lLine].mPhases[lPhase] = lHistogram;
+        }
+    }
+
+ close:
+    fclose(lStream);
+
+ done:
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Save the histograms to the state file.
+ *
+ *  @retval  kStatus_Success  If successful.
+ *  @retval  -errno           If the state file could not be written.
+ *
+ */
+Status
+PhaseTimingRecorder :: Save(void) const
+{
+    FILE *  lStream;
+    size_t  lPhase;
+    size_t  lBucket;
+    Status  lRetval = kStatus_Success;
+
+
+    lStream = fopen(mStatePath.c_str(), "w");
+    nlREQUIRE_ACTION(lStream != nullptr, done, lRetval = -errno);
+
+    fputs(kStateFileHeader, lStream);
+
+    for (const auto &lSite : mSites)
+    {
+        for (lPhase = 0; lPhase < kPhaseMax; lPhase++)
+        {
+            const Histogram &lHistogram = lSite.second.mPhases[lPhase];
+
+            if (lHistogram.mCount > 0)
+            {
+                fprintf(lStream, "%s\t%zu\t%" PRIu32 "\t%" PRIu64 "\t%" PRIu64 "\t%" PRIu64,
+                        lSite.first.c_str(),
+                        lPhase,
+                        lHistogram.mCount,
+                        lHistogram.mSum,
+                        lHistogram.mMinimum,
+                        lHistogram.mMaximum);
+
+                for (lBucket = 0; lBucket < Histogram::kBucketsMax; lBucket++)
+                {
+                    fprintf(lStream, " %" PRIu32, lHistogram.mBuckets[lBucket]);
+                }
+
+                fputc('\n', lStream);
+            }
+        }
+    }
+
+    nlREQUIRE_ACTION(fclose(lStream) == 0, done, lRetval = -errno);
+
+ done:
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Dump the histograms, in human-readable form, to the dump file.
+ *
+ *  @retval  kStatus_Success  If successful.
+ *  @retval  -errno           If the dump file could not be written.
+ *
+ */
+Status
+PhaseTimingRecorder :: Dump(void) const
+{
+    FILE *  lStream;
+    Status  lRetval;
+
+
+    lStream = fopen(mDumpPath.c_str(), "w");
+    nlREQUIRE_ACTION(lStream != nullptr, done, lRetval = -errno);
+
+    lRetval = Dump(lStream);
+
+    nlREQUIRE_ACTION(fclose(lStream) == 0, done, lRetval = -errno);
+
+ done:
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Dump the histograms, in human-readable form, to the specified
+ *    stream.
+ *
+ *  @param[in]  aStream  A pointer to the stream to dump to.
+ *
+ *  @retval  kStatus_Success  If successful.
+ *  @retval  -EINVAL          If @a aStream was null.
+ *
+ */
+Status
+PhaseTimingRecorder :: Dump(FILE *aStream) const
+{
+    size_t  lPhase;
+    size_t  lBucket;
+    Status  lRetval = kStatus_Success;
+
+
+    nlREQUIRE_ACTION(aStream != nullptr, done, lRetval = -EINVAL);
+
+    for (const auto &lSite : mSites)
+    {
+        fprintf(aStream, "%s\n", lSite.first.c_str());
+
+        for (lPhase = 0; lPhase < kPhaseMax; lPhase++)
+        {
+            const Histogram &lHistogram = lSite.second.mPhases[lPhase];
+
+            if (lHistogram.GetCount() > 0)
+            {
+                fprintf(aStream,
+                        "  %-26s n=%-5" PRIu32 " min=%-7lld mean=%-7lld p50=%-7lld p90=%-7lld p99=%-7lld max=%lld ms\n",
+                        GetPhaseName(static_cast<Phase>(lPhase)),
+                        lHistogram.GetCount(),
+                        static_cast<long long>(lHistogram.GetMinimum().count()),
+                        static_cast<long long>(lHistogram.GetMean().count()),
+                        static_cast<long long>(lHistogram.GetPercentile(50).count()),
+                        static_cast<long long>(lHistogram.GetPercentile(90).count()),
+                        static_cast<long long>(lHistogram.GetPercentile(99).count()),
+                        static_cast<long long>(lHistogram.GetMaximum().count()));
+
+                for (lBucket = 0; lBucket < Histogram::kBucketsMax; lBucket++)
+                {
+                    if (lHistogram.GetBucketCount(lBucket) > 0)
+                    {
+                        if ((lBucket + 1) < Histogram::kBucketsMax)
+                        {
+                            fprintf(aStream, "    <= %6" PRIu64 " ms: %" PRIu32 "\n",
+                                    kBucketLimits[lBucket],
+                                    lHistogram.GetBucketCount(lBucket));
+                        }
+                        else
+                        {
+                            fprintf(aStream, "     > %6" PRIu64 " ms: %" PRIu32 "\n",
+                                    kBucketLimits[lBucket - 1],
+                                    lHistogram.GetBucketCount(lBucket));
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+ done:
+    return (lRetval);
+}
+
+// MARK: Implementation
+
+void
+PhaseTimingRecorder :: Start(const Phase &aPhase)
+{
+    mStartTimes[aPhase] = Clock::now();
+    mStarted[aPhase]    = true;
+}
+
+void
+PhaseTimingRecorder :: Stop(const Phase &aPhase)
+{
+    nlEXPECT(mStarted[aPhase], done);
+
+    Record(aPhase, std::chrono::duration_cast<Duration>(Clock::now() - mStartTimes[aPhase]));
+
+    mStarted[aPhase] = false;
+
+ done:
+    return;
+}
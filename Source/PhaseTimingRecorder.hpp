@@ -0,0 +1,190 @@
+/*
+ *    Copyright (c) 2026 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *  @file
+ *    This file defines an object for timing the resolve, connect, and
+ *    refresh phases of a HLX client controller session and for
+ *    accumulating those timings into persistent, per-site histograms.
+ *
+ */
+
+#ifndef PHASETIMINGRECORDER_HPP
+#define PHASETIMINGRECORDER_HPP
+
+#include <chrono>
+#include <map>
+#include <string>
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include <OpenHLX/Client/ApplicationControllerDelegate.hpp>
+#include <OpenHLX/Common/Errors.hpp>
+
+
+/**
+ *  @brief
+ *    An object for timing the phases of a HLX client controller
+ *    session.
+ *
+ *  The recorder times host name resolution, connection, and, for the
+ *  refresh, how long after the refresh started the last of the
+ *  sources, zones, groups, and equalizer presets arrived, as well as
+ *  when the refresh became usable and complete. Each completed
+ *  timing is added to a histogram for the current site (the network
+ *  address, name, or URL connected to) and phase.
+ *
+ *  The histograms are saved to and loaded from a state file and may
+ *  be dumped in human-readable form to a separate file.
+ *
+ */
+class PhaseTimingRecorder
+{
+public:
+    /**
+     *  The session phase.
+     *
+     */
+    enum Phase
+    {
+        kPhaseResolve = 0,               //!< Host name resolution.
+        kPhaseConnect,                   //!< Connection.
+        kPhaseRefreshSources,            //!< Refresh, through the last source.
+        kPhaseRefreshZones,              //!< Refresh, through the last zone.
+        kPhaseRefreshGroups,             //!< Refresh, through the last group.
+        kPhaseRefreshEqualizerPresets,   //!< Refresh, through the last equalizer preset.
+        kPhaseRefreshUsable,             //!< Refresh, through usable.
+        kPhaseRefreshComplete,           //!< Refresh, through complete.
+
+        kPhaseMax
+    };
+
+    /**
+     *  The clock against which phases are timed.
+     *
+     */
+    typedef std::chrono::steady_clock Clock;
+
+    /**
+     *  The type for phase durations.
+     *
+     */
+    typedef std::chrono::milliseconds Duration;
+
+    /**
+     *  A histogram of phase durations.
+     *
+     */
+    class Histogram
+    {
+    public:
+        /**
+         *  The number of histogram buckets.
+         *
+         */
+        static const size_t kBucketsMax = 14;
+
+    public:
+        Histogram(void);
+
+        void     Add(const Duration &aDuration);
+
+        uint32_t GetCount(void) const;
+        uint32_t GetBucketCount(const size_t &aBucket) const;
+        Duration GetMinimum(void) const;
+        Duration GetMaximum(void) const;
+        Duration GetMean(void) const;
+        Duration GetPercentile(const unsigned int &aPercentile) const;
+
+        static Duration GetBucketLimit(const size_t &aBucket);
+
+    private:
+        friend class PhaseTimingRecorder;
+
+        uint32_t  mBuckets[kBucketsMax];
+        uint32_t  mCount;
+        uint64_t  mSum;
+        uint64_t  mMinimum;
+        uint64_t  mMaximum;
+    };
+
+public:
+    PhaseTimingRecorder(void);
+    ~PhaseTimingRecorder(void);
+
+    HLX::Common::Status Init(const char *aStatePath, const char *aDumpPath);
+
+    void SetSite(const char *aSite);
+
+    // Observation
+
+    void WillResolve(void);
+    void DidResolve(void);
+    void WillConnect(void);
+    void DidConnect(void);
+    void WillRefresh(void);
+    void StateDidChange(const HLX::Client::StateChange::NotificationBasis &aStateChangeNotification);
+    void DidRefresh(void);
+
+    void Record(const Phase &aPhase, const Duration &aDuration);
+
+    // Introspection
+
+    HLX::Common::Status GetHistogram(const char *aSite, const Phase &aPhase, const Histogram *&aHistogram) const;
+    HLX::Common::Status GetLastDuration(const Phase &aPhase, Duration &aDuration) const;
+
+    static const char * GetPhaseName(const Phase &aPhase);
+
+    // Persistence
+
+    HLX::Common::Status Load(void);
+    HLX::Common::Status Save(void) const;
+    HLX::Common::Status Dump(void) const;
+    HLX::Common::Status Dump(FILE *aStream) const;
+
+private:
+    /**
+     *  The set of phase histograms for a single site.
+     *
+     */
+    struct Histograms
+    {
+        Histogram  mPhases[kPhaseMax];
+    };
+
+    typedef std::map<std::string, Histograms> Sites;
+
+    void Start(const Phase &aPhase);
+    void Stop(const Phase &aPhase);
+
+private:
+    std::string        mStatePath;
+    std::string        mDumpPath;
+    std::string        mSite;
+    Sites              mSites;
+    Clock::time_point  mStartTimes[kPhaseMax];
+    bool               mStarted[kPhaseMax];
+    Clock::time_point  mLastArrivals[kPhaseMax];
+    bool               mArrived[kPhaseMax];
+    Duration           mLastDurations[kPhaseMax];
+    bool               mRecorded[kPhaseMax];
+};
+
+#endif // PHASETIMINGRECORDER_HPP
@@ -0,0 +1,533 @@
+/*
+ *    Copyright (c) 2026 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *  @file
+ *    This file implements an object for ordering pending HLX group
+ *    and zone refresh queries such that those the user is looking at,
+ *    or navigating to, are issued first.
+ *
+ */
+
+#include "RefreshQueryScheduler.hpp"
+
+#include <errno.h>
+
+#include <OpenHLX/Utilities/Assert.hpp>
+
+
+using namespace HLX::Common;
+using namespace HLX::Model;
+
+
+// An identifier value indicating no visible range or navigation.
+
+static const RefreshQueryScheduler::IdentifierType kIdentifierNone = 0;
+
+/**
+ *  @brief
+ *    Order two pending query keys.
+ *
+ *  @returns
+ *    True if this key is to be issued before @a aKey; otherwise,
+ *    false.
+ *
+ */
+bool
+RefreshQueryScheduler :: Key :: operator <(const Key &aKey) const
+{
+    if (mPriority != aKey.mPriority)
+    {
+        return (mPriority > aKey.mPriority);
+    }
+
+    if (mIdentifier != aKey.mIdentifier)
+    {
+        return (mIdentifier < aKey.mIdentifier);
+    }
+
+    return (mKind < aKey.mKind);
+}
+
+/**
+ *  @brief
+ *    This is the class default constructor.
+ *
+ */
+RefreshQueryScheduler :: RefreshQueryScheduler(void) :
+    mPending(),
+    mInFlight(0),
+    mShownKind(kKindZone),
+    mVisibleKind(kKindZone),
+    mVisibleFirst(kIdentifierNone),
+    mVisibleLast(kIdentifierNone),
+    mNavigationKind(kKindZone),
+    mNavigationIdentifier(kIdentifierNone)
+{
+    return;
+}
+
+/**
+ *  @brief
+ *    This is the class destructor.
+ *
+ */
+RefreshQueryScheduler :: ~RefreshQueryScheduler(void)
+{
+    return;
+}
+
+/**
+ *  @brief
+ *    This is the class initializer.
+ *
+ *  This initializes the scheduler with every group and zone pending,
+ *  discarding any prior pending, in-flight, visible, and navigation
+ *  state. The shown kind, if previously set, is retained.
+ *
+ *  @param[in]  aGroupsMax  The maximum group identifier.
+ *  @param[in]  aZonesMax   The maximum zone identifier.
+ *
+ *  @retval  kStatus_Success  If successful.
+ *
+ */
+Status
+RefreshQueryScheduler :: Init(const IdentifierType &aGroupsMax, const IdentifierType &aZonesMax)
+{
+    const IdentifierType  lMaxima[kKindMax] = { aGroupsMax, aZonesMax };
+    size_t                lKind;
+    IdentifierType        lIdentifier;
+
+
+    Clear();
+
+    mVisibleFirst         = kIdentifierNone;
+    mVisibleLast          = kIdentifierNone;
+    mNavigationIdentifier = kIdentifierNone;
+
+    for (lKind = kKindGroup; lKind < kKindMax; lKind++)
+    {
+        const Kind lKindValue = static_cast<Kind>(lKind);
+
+        mEntries[lKind].resize(lMaxima[lKind]);
+
+        for (lIdentifier = IdentifierModel::kIdentifierMin; lIdentifier <= lMaxima[lKind]; lIdentifier++)
+        {
+            Entry &    lEntry = mEntries[lKind][lIdentifier - 1];
+            const Key  lKey   = { GetBasePriority(lKindValue, lIdentifier), lIdentifier, lKindValue };
+
+            lEntry.mState    = kStatePending;
+            lEntry.mPriority = lKey.mPriority;
+
+            mPending.insert(lKey);
+        }
+    }
+
+    return (kStatus_Success);
+}
+
+// MARK: Prioritization
+
+/**
+ *  @brief
+ *    Set the kind of entity currently shown.
+ *
+ *  Pending queries of the shown kind are raised above background
+ *  priority.
+ *
+ *  @param[in]  aKind  The kind of entity currently shown.
+ *
+ *  @retval  kStatus_Success  If successful.
+ *  @retval  -EINVAL          If @a aKind is invalid.
+ *
+ */
+Status
+RefreshQueryScheduler :: SetShown(const Kind &aKind)
+{
+    const Kind      lPriorKind = mShownKind;
+    IdentifierType  lIdentifier;
+    Status          lRetval = kStatus_Success;
+
+
+    nlREQUIRE_ACTION(aKind < kKindMax, done, lRetval = -EINVAL);
+
+    mShownKind = aKind;
+
+    for (lIdentifier = IdentifierModel::kIdentifierMin; lIdentifier <= mEntries[lPriorKind].size(); lIdentifier++)
+    {
+        Reprioritize(lPriorKind, lIdentifier);
+    }
+
+    for (lIdentifier = IdentifierModel::kIdentifierMin; lIdentifier <= mEntries[aKind].size(); lIdentifier++)
+    {
+        Reprioritize(aKind, lIdentifier);
+    }
+
+ done:
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Set the range of visible entities.
+ *
+ *  Pending queries in the range are raised to visible priority;
+ *  those in any prior range fall back to their shown or background
+ *  priority.
+ *
+ *  @param[in]  aKind   The kind of entity visible.
+ *  @param[in]  aFirst  The first visible identifier.
+ *  @param[in]  aLast   The last visible identifier, inclusive.
+ *
+ *  @retval  kStatus_Success  If successful.
+ *  @retval  -EINVAL          If @a aKind is invalid.
+ *  @retval  -ERANGE          If the range is empty or exceeds the
+ *                            maximum identifier for @a aKind.
+ *
+ */
+Status
+RefreshQueryScheduler :: SetVisible(const Kind &aKind, const IdentifierType &aFirst, const IdentifierType &aLast)
+{
+    const Kind            lPriorKind  = mVisibleKind;
+    const IdentifierType  lPriorFirst = mVisibleFirst;
+    const IdentifierType  lPriorLast  = mVisibleLast;
+    IdentifierType        lIdentifier;
+    Status                lRetval = kStatus_Success;
+
+
+    nlREQUIRE_ACTION(aKind < kKindMax, done, lRetval = -EINVAL);
+    nlREQUIRE_ACTION(aFirst >= IdentifierModel::kIdentifierMin, done, lRetval = -ERANGE);
+    nlREQUIRE_ACTION(aFirst <= aLast, done, lRetval = -ERANGE);
+    nlREQUIRE_ACTION(aLast <= mEntries[aKind].size(), done, lRetval = -ERANGE);
+
+    mVisibleKind  = aKind;
+    mVisibleFirst = aFirst;
+    mVisibleLast  = aLast;
+
+    if (lPriorFirst != kIdentifierNone)
+    {
+        for (lIdentifier = lPriorFirst; lIdentifier <= lPriorLast; lIdentifier++)
+        {
+            Reprioritize(lPriorKind, lIdentifier);
+        }
+    }
+
+    for (lIdentifier = aFirst; lIdentifier <= aLast; lIdentifier++)
+    {
+        Reprioritize(aKind, lIdentifier);
+    }
+
+ done:
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Set the entity being navigated to.
+ *
+ *  A pending query for the entity jumps ahead of all others. If the
+ *  query is already in flight or complete, or if there are no pending
+ *  queries at all, for example, once the refresh they were ahead of
+ *  has completed, this has no effect on the order.
+ *
+ *  @param[in]  aKind        The kind of entity being navigated to.
+ *  @param[in]  aIdentifier  The identifier of the entity being
+ *                           navigated to.
+ *
+ *  @retval  kStatus_Success  If successful.
+ *  @retval  -ENOENT          If there are no pending queries.
+ *  @retval  -EINVAL          If @a aKind is invalid.
+ *  @retval  -ERANGE          If @a aIdentifier is smaller or larger
+ *                            than supported.
+ *
+ */
+Status
+RefreshQueryScheduler :: SetNavigation(const Kind &aKind, const IdentifierType &aIdentifier)
+{
+    const Kind            lPriorKind       = mNavigationKind;
+    const IdentifierType  lPriorIdentifier = mNavigationIdentifier;
+    Entry *               lEntry;
+    Status                lRetval = kStatus_Success;
+
+
+    nlEXPECT_ACTION(!IsEmpty(), done, lRetval = -ENOENT);
+
+    lRetval = GetEntry(aKind, aIdentifier, lEntry);
+    nlREQUIRE_SUCCESS(lRetval, done);
+
+    mNavigationKind       = aKind;
+    mNavigationIdentifier = aIdentifier;
+
+    if (lPriorIdentifier != kIdentifierNone)
+    {
+        Reprioritize(lPriorKind, lPriorIdentifier);
+    }
+
+    Reprioritize(aKind, aIdentifier);
+
+ done:
+    return (lRetval);
+}
+
+// MARK: Scheduling
+
+/**
+ *  @brief
+ *    Return whether there are no pending queries.
+ *
+ *  @returns
+ *    True if there are no pending queries; otherwise, false.
+ *
+ */
+bool
+RefreshQueryScheduler :: IsEmpty(void) const
+{
+    return (mPending.empty());
+}
+
+/**
+ *  @brief
+ *    Return the number of pending queries.
+ *
+ *  @returns
+ *    The number of pending queries.
+ *
+ */
+size_t
+RefreshQueryScheduler :: GetPendingCount(void) const
+{
+    return (mPending.size());
+}
+
+/**
+ *  @brief
+ *    Return the number of in-flight queries.
+ *
+ *  @returns
+ *    The number of queries popped but not yet marked complete.
+ *
+ */
+size_t
+RefreshQueryScheduler :: GetInFlightCount(void) const
+{
+    return (mInFlight);
+}
+
+/**
+ *  @brief
+ *    Remove and return the highest priority pending query.
+ *
+ *  The returned query is considered in flight until it is marked
+ *  complete.
+ *
+ *  @param[out]  aQuery  A reference to storage for the query.
+ *
+ *  @retval  kStatus_Success  If successful.
+ *  @retval  -ENOENT          If there are no pending queries.
+ *
+ */
+Status
+RefreshQueryScheduler :: Pop(Query &aQuery)
+{
+    return (Pop(kPriorityBackground, aQuery));
+}
+
+/**
+ *  @brief
+ *    Remove and return the highest priority pending query, if it is
+ *    of at least the specified priority.
+ *
+ *  The returned query is considered in flight until it is marked
+ *  complete.
+ *
+ *  @param[in]   aMinimum  A reference to the lowest priority to
+ *                         return.
+ *  @param[out]  aQuery    A reference to storage for the query.
+ *
+ *  @retval  kStatus_Success  If successful.
+ *  @retval  -ENOENT          If there are no pending queries of at
+ *                            least @a aMinimum priority.
+ *
+ */
+Status
+RefreshQueryScheduler :: Pop(const Priority &aMinimum, Query &aQuery)
+{
+    Pending::iterator  lFirst;
+    Status             lRetval = kStatus_Success;
+
+
+    nlEXPECT_ACTION(!mPending.empty(), done, lRetval = -ENOENT);
+
+    lFirst = mPending.begin();
+
+    nlEXPECT_ACTION(lFirst->mPriority >= aMinimum, done, lRetval = -ENOENT);
+
+    aQuery.mKind       = lFirst->mKind;
+    aQuery.mIdentifier = lFirst->mIdentifier;
+
+    mEntries[aQuery.mKind][aQuery.mIdentifier - 1].mState = kStateInFlight;
+
+    mPending.erase(lFirst);
+
+    mInFlight++;
+
+ done:
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Mark the query for the specified entity complete.
+ *
+ *  This may be used both for in-flight queries and for pending
+ *  queries made unnecessary because the entity data arrived by other
+ *  means.
+ *
+ *  @param[in]  aKind        The kind of entity completed.
+ *  @param[in]  aIdentifier  The identifier of the entity completed.
+ *
+ *  @retval  kStatus_Success  If successful.
+ *  @retval  -EINVAL          If @a aKind is invalid.
+ *  @retval  -ERANGE          If @a aIdentifier is smaller or larger
+ *                            than supported.
+ *
+ */
+Status
+RefreshQueryScheduler :: Complete(const Kind &aKind, const IdentifierType &aIdentifier)
+{
+    Entry *  lEntry;
+    Status   lRetval;
+
+
+    lRetval = GetEntry(aKind, aIdentifier, lEntry);
+    nlREQUIRE_SUCCESS(lRetval, done);
+
+    if (lEntry->mState == kStatePending)
+    {
+        const Key lKey = { lEntry->mPriority, aIdentifier, aKind };
+
+        mPending.erase(lKey);
+    }
+    else if (lEntry->mState == kStateInFlight)
+    {
+        mInFlight--;
+    }
+
+    lEntry->mState = kStateComplete;
+
+ done:
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Discard all pending and in-flight queries.
+ *
+ */
+void
+RefreshQueryScheduler :: Clear(void)
+{
+    size_t  lKind;
+
+    mPending.clear();
+
+    mInFlight = 0;
+
+    for (lKind = kKindGroup; lKind < kKindMax; lKind++)
+    {
+        mEntries[lKind].clear();
+    }
+}
+
+// MARK: Implementation
+
+Status
+RefreshQueryScheduler :: GetEntry(const Kind &aKind, const IdentifierType &aIdentifier, Entry *&aEntry)
+{
+    Status  lRetval = kStatus_Success;
+
+    nlREQUIRE_ACTION(aKind < kKindMax, done, lRetval = -EINVAL);
+    nlREQUIRE_ACTION(aIdentifier >= IdentifierModel::kIdentifierMin, done, lRetval = -ERANGE);
+    nlREQUIRE_ACTION(aIdentifier <= mEntries[aKind].size(), done, lRetval = -ERANGE);
+
+    // HLX identifiers are one rather than zero based; however, the
+    // entries vector is zero based.
+
+    aEntry = &mEntries[aKind][aIdentifier - 1];
+
+ done:
+    return (lRetval);
+}
+
+RefreshQueryScheduler::Priority
+RefreshQueryScheduler :: GetBasePriority(const Kind &aKind, const IdentifierType &aIdentifier) const
+{
+    Priority  lRetval;
+
+    if ((aKind == mNavigationKind) && (aIdentifier == mNavigationIdentifier))
+    {
+        lRetval = kPriorityNavigation;
+    }
+    else if ((aKind == mVisibleKind) && (aIdentifier >= mVisibleFirst) && (aIdentifier <= mVisibleLast))
+    {
+        lRetval = kPriorityVisible;
+    }
+    else if (aKind == mShownKind)
+    {
+        lRetval = kPriorityShown;
+    }
+    else
+    {
+        lRetval = kPriorityBackground;
+    }
+
+    return (lRetval);
+}
+
+void
+RefreshQueryScheduler :: Reprioritize(const Kind &aKind, const IdentifierType &aIdentifier)
+{
+    Entry *   lEntry;
+    Priority  lPriority;
+    Status    lStatus;
+
+
+    lStatus = GetEntry(aKind, aIdentifier, lEntry);
+    nlREQUIRE_SUCCESS(lStatus, done);
+
+    // Only pending queries are ordered; in-flight and completed
+    // queries retain whatever priority they last had.
+
+    nlEXPECT(lEntry->mState == kStatePending, done);
+
+    lPriority = GetBasePriority(aKind, aIdentifier);
+    nlEXPECT(lPriority != lEntry->mPriority, done);
+
+    {
+        const Key lOldKey = { lEntry->mPriority, aIdentifier, aKind };
+        const Key lNewKey = { lPriority,         aIdentifier, aKind };
+
+        mPending.erase(lOldKey);
+        mPending.insert(lNewKey);
+    }
+
+    lEntry->mPriority = lPriority;
+
+ done:
+    return;
+}
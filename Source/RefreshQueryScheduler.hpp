@@ -0,0 +1,169 @@
+/*
+ *    Copyright (c) 2026 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *  @file
+ *    This file defines an object for ordering pending HLX group and
+ *    zone refresh queries such that those the user is looking at, or
+ *    navigating to, are issued first.
+ *
+ */
+
+#ifndef REFRESHQUERYSCHEDULER_HPP
+#define REFRESHQUERYSCHEDULER_HPP
+
+#include <set>
+#include <vector>
+
+#include <stdint.h>
+
+#include <OpenHLX/Common/Errors.hpp>
+#include <OpenHLX/Model/IdentifierModel.hpp>
+
+
+/**
+ *  @brief
+ *    An object for ordering pending HLX group and zone refresh
+ *    queries by visibility.
+ *
+ *  Every group and zone starts out pending at background
+ *  priority. Those of the kind currently shown are raised above
+ *  background, those in the visible range are raised above that, and
+ *  one navigated-to group or zone is raised above everything
+ *  else. Among equal priorities, lower identifiers are first.
+ *
+ *  The scheduler only orders; it is up to the caller to issue the
+ *  query returned by #Pop and to mark it complete with #Complete once
+ *  it has arrived. Popped queries that have not yet been marked
+ *  complete are in flight and are no longer ordered.
+ *
+ */
+class RefreshQueryScheduler
+{
+public:
+    /**
+     *  The kind of entity to query.
+     *
+     */
+    enum Kind
+    {
+        kKindGroup = 0, //!< A group.
+        kKindZone,      //!< A zone.
+
+        kKindMax
+    };
+
+    /**
+     *  The query priority, in increasing order.
+     *
+     */
+    enum Priority
+    {
+        kPriorityBackground = 0, //!< Not shown.
+        kPriorityShown,          //!< Of the kind shown, but not visible.
+        kPriorityVisible,        //!< In the visible range.
+        kPriorityNavigation      //!< Being navigated to.
+    };
+
+    typedef HLX::Model::IdentifierModel::IdentifierType IdentifierType;
+
+    /**
+     *  A query for a particular group or zone.
+     *
+     */
+    struct Query
+    {
+        Kind            mKind;
+        IdentifierType  mIdentifier;
+    };
+
+public:
+    RefreshQueryScheduler(void);
+    ~RefreshQueryScheduler(void);
+
+    HLX::Common::Status Init(const IdentifierType &aGroupsMax, const IdentifierType &aZonesMax);
+
+    // Prioritization
+
+    HLX::Common::Status SetShown(const Kind &aKind);
+    HLX::Common::Status SetVisible(const Kind &aKind, const IdentifierType &aFirst, const IdentifierType &aLast);
+    HLX::Common::Status SetNavigation(const Kind &aKind, const IdentifierType &aIdentifier);
+
+    // Scheduling
+
+    bool                IsEmpty(void) const;
+    size_t              GetPendingCount(void) const;
+    size_t              GetInFlightCount(void) const;
+    HLX::Common::Status Pop(Query &aQuery);
+    HLX::Common::Status Pop(const Priority &aMinimum, Query &aQuery);
+    HLX::Common::Status Complete(const Kind &aKind, const IdentifierType &aIdentifier);
+    void                Clear(void);
+
+private:
+    /**
+     *  The scheduling state of a group or zone.
+     *
+     */
+    enum State
+    {
+        kStatePending = 0,
+        kStateInFlight,
+        kStateComplete
+    };
+
+    struct Entry
+    {
+        State     mState;
+        Priority  mPriority;
+    };
+
+    typedef std::vector<Entry> Entries;
+
+    /**
+     *  The ordering key for pending queries: priority first,
+     *  descending, then identifier, ascending, then kind.
+     *
+     */
+    struct Key
+    {
+        Priority        mPriority;
+        IdentifierType  mIdentifier;
+        Kind            mKind;
+
+        bool operator <(const Key &aKey) const;
+    };
+
+    typedef std::set<Key> Pending;
+
+    HLX::Common::Status GetEntry(const Kind &aKind, const IdentifierType &aIdentifier, Entry *&aEntry);
+    Priority            GetBasePriority(const Kind &aKind, const IdentifierType &aIdentifier) const;
+    void                Reprioritize(const Kind &aKind, const IdentifierType &aIdentifier);
+
+private:
+    Entries         mEntries[kKindMax];
+    Pending         mPending;
+    size_t          mInFlight;
+    Kind            mShownKind;
+    Kind            mVisibleKind;
+    IdentifierType  mVisibleFirst;
+    IdentifierType  mVisibleLast;
+    Kind            mNavigationKind;
+    IdentifierType  mNavigationIdentifier;
+};
+
+#endif // REFRESHQUERYSCHEDULER_HPP
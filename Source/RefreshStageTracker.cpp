@@ -0,0 +1,492 @@
+/*
+ *    Copyright (c) 2026 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *  @file
+ *    This file implements an object for tracking the stages of a HLX
+ *    client controller refresh: from when the refresh starts, to when
+ *    enough data has arrived for the groups and zones view to be
+ *    usable, to when the refresh completes.
+ *
+ */
+
+#include "RefreshStageTracker.hpp"
+
+#include <errno.h>
+
+#include <LogUtilities/LogUtilities.hpp>
+
+#include <OpenHLX/Client/GroupsStateChangeNotifications.hpp>
+#include <OpenHLX/Client/SourcesStateChangeNotifications.hpp>
+#include <OpenHLX/Client/ZonesStateChangeNotifications.hpp>
+#include <OpenHLX/Utilities/Assert.hpp>
+
+
+using namespace HLX::Client;
+using namespace HLX::Common;
+using namespace HLX::Model;
+using namespace Nuovations;
+
+
+// Per-entity properties required for the groups and zones view to be
+// usable.
+
+enum
+{
+    kPropertyName   = 0x01,
+    kPropertySource = 0x02,
+    kPropertyVolume = 0x04,
+    kPropertyMute   = 0x08
+};
+
+static const uint8_t kGroupPropertiesRequired  = (kPropertyName   |
+                                                  kPropertySource |
+                                                  kPropertyVolume |
+                                                  kPropertyMute);
+static const uint8_t kSourcePropertiesRequired = (kPropertyName);
+static const uint8_t kZonePropertiesRequired   = (kPropertyName   |
+                                                  kPropertySource |
+                                                  kPropertyVolume |
+                                                  kPropertyMute);
+
+/**
+ *  @brief
+ *    This is the class default constructor.
+ *
+ */
+RefreshStageTracker :: RefreshStageTracker(void) :
+    mController(nullptr),
+    mStage(kStageIdle),
+    mGroups(),
+    mSources(),
+    mZones(),
+    mOutstanding(0),
+    mWillRefreshTime(),
+    mUsableTime(),
+    mCompleteTime()
+{
+    return;
+}
+
+/**
+ *  @brief
+ *    This is the class destructor.
+ *
+ */
+RefreshStageTracker :: ~RefreshStageTracker(void)
+{
+    return;
+}
+
+/**
+ *  @brief
+ *    This is the class initializer.
+ *
+ *  @param[in]  aController  A reference to the client controller
+ *                           whose refreshes are to be tracked.
+ *
+ *  @retval  kStatus_Success  Unconditionally.
+ *
+ */
+Status
+RefreshStageTracker :: Init(HLX::Client::Application::Controller &aController)
+{
+    mController = &aController;
+
+    return (kStatus_Success);
+}
+
+// MARK: Observation
+
+/**
+ *  @brief
+ *    Observe that the client controller will refresh.
+ *
+ *  This resets all tracked state and starts the refresh clock.
+ *
+ */
+void
+RefreshStageTracker :: WillRefresh(void)
+{
+    IdentifierType  lMaximum;
+    Status          lStatus;
+
+
+    mStage           = kStageRefreshing;
+    mOutstanding     = 0;
+    mWillRefreshTime = Clock::now();
+
+    nlREQUIRE(mController != nullptr, done);
+
+    lStatus = mController->GroupsGetMax(lMaximum);
+    nlREQUIRE_SUCCESS(lStatus, done);
+
+    lStatus = InitProperties(mGroups, lMaximum);
+    nlREQUIRE_SUCCESS(lStatus, done);
+
+    mOutstanding += lMaximum;
+
+    lStatus = mController->SourcesGetMax(lMaximum);
+    nlREQUIRE_SUCCESS(lStatus, done);
+
+    lStatus = InitProperties(mSources, lMaximum);
+    nlREQUIRE_SUCCESS(lStatus, done);
+
+    mOutstanding += lMaximum;
+
+    lStatus = mController->ZonesGetMax(lMaximum);
+    nlREQUIRE_SUCCESS(lStatus, done);
+
+    lStatus = InitProperties(mZones, lMaximum);
+    nlREQUIRE_SUCCESS(lStatus, done);
+
+    mOutstanding += lMaximum;
+
+ done:
+    return;
+}
+
+/**
+ *  @brief
+ *    Observe a client controller state change.
+ *
+ *  @param[in]  aStateChangeNotification  An immutable reference
+ *                                        to a notification
+ *                                        describing the state
+ *                                        change.
+ *
+ *  @returns
+ *    The refresh stage after observing the state change.
+ *
+ */
+RefreshStageTracker::Stage
+RefreshStageTracker :: StateDidChange(const StateChange::NotificationBasis &aStateChangeNotification)
+{
+    const StateChange::Type  lType = aStateChangeNotification.GetType();
+    uint8_t                  lProperty = 0;
+
+
+    nlEXPECT(mStage == kStageRefreshing, done);
+
+    switch (lType)
+    {
+
+    case StateChange::kStateChangeType_GroupMute:
+    case StateChange::kStateChangeType_GroupName:
+    case StateChange::kStateChangeType_GroupSource:
+    case StateChange::kStateChangeType_GroupVolume:
+        {
+            const StateChange::GroupsNotificationBasis &lSCN = static_cast<const StateChange::GroupsNotificationBasis &>(aStateChangeNotification);
+
+            lProperty = ((lType == StateChange::kStateChangeType_GroupMute)   ? kPropertyMute   :
+                         (lType == StateChange::kStateChangeType_GroupName)   ? kPropertyName   :
+                         (lType == StateChange::kStateChangeType_GroupSource) ? kPropertySource :
+                                                                                kPropertyVolume);
+
+            SetProperty(mGroups, lSCN.GetIdentifier(), lProperty, kGroupPropertiesRequired);
+        }
+        break;
+
+    case StateChange::kStateChangeType_SourceName:
+        {
+            const StateChange::SourcesNameNotification &lSCN = static_cast<const StateChange::SourcesNameNotification &>(aStateChangeNotification);
+
+            SetProperty(mSources, lSCN.GetIdentifier(), kPropertyName, kSourcePropertiesRequired);
+        }
+        break;
+
+    case StateChange::kStateChangeType_ZoneMute:
+    case StateChange::kStateChangeType_ZoneName:
+    case StateChange::kStateChangeType_ZoneSource:
+    case StateChange::kStateChangeType_ZoneVolume:
+        {
+            const StateChange::ZonesNotificationBasis &lSCN = static_cast<const StateChange::ZonesNotificationBasis &>(aStateChangeNotification);
+
+            lProperty = ((lType == StateChange::kStateChangeType_ZoneMute)   ? kPropertyMute   :
+                         (lType == StateChange::kStateChangeType_ZoneName)   ? kPropertyName   :
+                         (lType == StateChange::kStateChangeType_ZoneSource) ? kPropertySource :
+                                                                               kPropertyVolume);
+
+            SetProperty(mZones, lSCN.GetIdentifier(), lProperty, kZonePropertiesRequired);
+        }
+        break;
+
+    default:
+        break;
+
+    }
+
+ done:
+    return (mStage);
+}
+
+/**
+ *  @brief
+ *    Observe that the client controller did refresh.
+ *
+ *  A completed refresh is, by definition, also usable. If the
+ *  refresh never became usable on its own, for example, because a
+ *  group without any zones never reported a source, then it becomes
+ *  usable at the same time it completes.
+ *
+ */
+void
+RefreshStageTracker :: DidRefresh(void)
+{
+    Duration  lDuration;
+
+
+    nlEXPECT(mStage != kStageIdle, done);
+
+    if (mStage == kStageRefreshing)
+    {
+        SetUsable();
+    }
+
+    mStage        = kStageComplete;
+    mCompleteTime = Clock::now();
+
+    lDuration = std::chrono::duration_cast<Duration>(mCompleteTime - mWillRefreshTime);
+
+    Log::Info().Write("Refresh complete in %lld ms.\n",
+                      static_cast<long long>(lDuration.count()));
+
+ done:
+    return;
+}
+
+/**
+ *  @brief
+ *    Observe that the client controller did not refresh.
+ *
+ *  This returns the tracker to the idle stage.
+ *
+ */
+void
+RefreshStageTracker :: DidNotRefresh(void)
+{
+    mStage       = kStageIdle;
+    mOutstanding = 0;
+}
+
+// MARK: Introspection
+
+/**
+ *  @brief
+ *    Return the current refresh stage.
+ *
+ *  @returns
+ *    The current refresh stage.
+ *
+ */
+RefreshStageTracker::Stage
+RefreshStageTracker :: GetStage(void) const
+{
+    return (mStage);
+}
+
+/**
+ *  @brief
+ *    Return whether enough of the refresh has arrived for the groups
+ *    and zones view to be usable.
+ *
+ *  @returns
+ *    True if the refresh is usable or complete; otherwise, false.
+ *
+ */
+bool
+RefreshStageTracker :: IsUsable(void) const
+{
+    return ((mStage == kStageUsable) || (mStage == kStageComplete));
+}
+
+/**
+ *  @brief
+ *    Return whether the refresh is complete.
+ *
+ *  @returns
+ *    True if the refresh is complete; otherwise, false.
+ *
+ */
+bool
+RefreshStageTracker :: IsComplete(void) const
+{
+    return (mStage == kStageComplete);
+}
+
+/**
+ *  @brief
+ *    Return whether the specified group has everything the groups
+ *    and zones view needs.
+ *
+ *  @param[in]  aIdentifier  The identifier of the group.
+ *
+ *  @returns
+ *    True if the refresh is complete or the group name, source,
+ *    volume, and mute have arrived; otherwise, false.
+ *
+ */
+bool
+RefreshStageTracker :: IsGroupUsable(const IdentifierType &aIdentifier) const
+{
+    return (IsComplete() || HasProperties(mGroups, aIdentifier, kGroupPropertiesRequired));
+}
+
+/**
+ *  @brief
+ *    Return whether the specified zone has everything the groups
+ *    and zones view needs.
+ *
+ *  @param[in]  aIdentifier  The identifier of the zone.
+ *
+ *  @returns
+ *    True if the refresh is complete or the zone name, source,
+ *    volume, and mute have arrived; otherwise, false.
+ *
+ */
+bool
+RefreshStageTracker :: IsZoneUsable(const IdentifierType &aIdentifier) const
+{
+    return (IsComplete() || HasProperties(mZones, aIdentifier, kZonePropertiesRequired));
+}
+
+/**
+ *  @brief
+ *    Return the time from the start of the refresh to when it became
+ *    usable.
+ *
+ *  @param[out]  aDuration  A reference to storage for the duration.
+ *
+ *  @retval  kStatus_Success  If successful.
+ *  @retval  -ENODATA         If the refresh is not yet usable.
+ *
+ */
+Status
+RefreshStageTracker :: GetTimeToUsable(Duration &aDuration) const
+{
+    Status  lRetval = kStatus_Success;
+
+    nlEXPECT_ACTION(IsUsable(), done, lRetval = -ENODATA);
+
+    aDuration = std::chrono::duration_cast<Duration>(mUsableTime - mWillRefreshTime);
+
+ done:
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Return the time from the start of the refresh to when it
+ *    completed.
+ *
+ *  @param[out]  aDuration  A reference to storage for the duration.
+ *
+ *  @retval  kStatus_Success  If successful.
+ *  @retval  -ENODATA         If the refresh is not yet complete.
+ *
+ */
+Status
+RefreshStageTracker :: GetTimeToComplete(Duration &aDuration) const
+{
+    Status  lRetval = kStatus_Success;
+
+    nlEXPECT_ACTION(IsComplete(), done, lRetval = -ENODATA);
+
+    aDuration = std::chrono::duration_cast<Duration>(mCompleteTime - mWillRefreshTime);
+
+ done:
+    return (lRetval);
+}
+
+// MARK: Implementation
+
+Status
+RefreshStageTracker :: InitProperties(Properties &aProperties, const IdentifierType &aMaximum)
+{
+    Status  lRetval = kStatus_Success;
+
+    nlREQUIRE_ACTION(aMaximum >= IdentifierModel::kIdentifierMin, done, lRetval = -ERANGE);
+
+    aProperties.assign(aMaximum, 0);
+
+ done:
+    return (lRetval);
+}
+
+bool
+RefreshStageTracker :: HasProperties(const Properties &aProperties, const IdentifierType &aIdentifier, const uint8_t &aRequired)
+{
+    bool  lRetval = false;
+
+    nlEXPECT(aIdentifier >= IdentifierModel::kIdentifierMin, done);
+    nlEXPECT(aIdentifier <= aProperties.size(), done);
+
+    lRetval = ((aProperties[aIdentifier - 1] & aRequired) == aRequired);
+
+ done:
+    return (lRetval);
+}
+
+void
+RefreshStageTracker :: SetProperty(Properties &aProperties, const IdentifierType &aIdentifier, const uint8_t &aProperty, const uint8_t &aRequired)
+{
+    uint8_t *  lProperties;
+
+
+    nlREQUIRE(aIdentifier >= IdentifierModel::kIdentifierMin, done);
+    nlREQUIRE(aIdentifier <= aProperties.size(), done);
+
+    // HLX identifiers are one rather than zero based; however, the
+    // properties vector is zero based.
+
+    lProperties = &aProperties[aIdentifier - 1];
+
+    // If this entity already had everything required, there is
+    // nothing further to account for.
+
+    nlEXPECT((*lProperties & aRequired) != aRequired, done);
+
+    *lProperties |= aProperty;
+
+    nlEXPECT((*lProperties & aRequired) == aRequired, done);
+
+    mOutstanding--;
+
+    if (mOutstanding == 0)
+    {
+        SetUsable();
+    }
+
+ done:
+    return;
+}
+
+void
+RefreshStageTracker :: SetUsable(void)
+{
+    Duration  lDuration;
+
+
+    mStage      = kStageUsable;
+    mUsableTime = Clock::now();
+
+    lDuration = std::chrono::duration_cast<Duration>(mUsableTime - mWillRefreshTime);
+
+    Log::Info().Write("Refresh usable in %lld ms.\n",
+                      static_cast<long long>(lDuration.count()));
+}
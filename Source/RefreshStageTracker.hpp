@@ -0,0 +1,135 @@
+/*
+ *    Copyright (c) 2026 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *  @file
+ *    This file defines an object for tracking the stages of a HLX
+ *    client controller refresh: from when the refresh starts, to when
+ *    enough data has arrived for the groups and zones view to be
+ *    usable, to when the refresh completes.
+ *
+ */
+
+#ifndef REFRESHSTAGETRACKER_HPP
+#define REFRESHSTAGETRACKER_HPP
+
+#include <chrono>
+#include <vector>
+
+#include <stdint.h>
+
+#include <OpenHLX/Client/ApplicationController.hpp>
+#include <OpenHLX/Client/ApplicationControllerDelegate.hpp>
+#include <OpenHLX/Common/Errors.hpp>
+
+
+/**
+ *  @brief
+ *    An object for tracking the stages of a HLX client controller
+ *    refresh.
+ *
+ *  A refresh is considered usable once the name, source (input),
+ *  volume level, and volume mute state of every group and zone and
+ *  the name of every source have arrived, since that is all that
+ *  the groups and zones view needs to render and act upon. The
+ *  remainder of the refresh (equalizer presets, zone sound mode,
+ *  tone, equalizer bands, crossovers, and so on) is only needed by
+ *  the installer detail views.
+ *
+ *  Tracking the stages only changes when the app acts on the refresh,
+ *  not what is fetched: the client controller refresh still requests
+ *  everything, in its own order, whether or not any view needs it.
+ *
+ *  The time from the start of the refresh to when it is usable and
+ *  to when it completes are tracked separately.
+ *
+ */
+class RefreshStageTracker
+{
+public:
+    /**
+     *  The refresh stage.
+     *
+     */
+    enum Stage
+    {
+        kStageIdle       = 0, //!< No refresh has been started.
+        kStageRefreshing,     //!< A refresh is in progress.
+        kStageUsable,         //!< A refresh is in progress and the
+                              //!< groups and zones are usable.
+        kStageComplete        //!< The refresh completed.
+    };
+
+    /**
+     *  The clock against which stage times are measured.
+     *
+     */
+    typedef std::chrono::steady_clock Clock;
+
+    /**
+     *  The type for stage durations.
+     *
+     */
+    typedef std::chrono::milliseconds Duration;
+
+public:
+    RefreshStageTracker(void);
+    ~RefreshStageTracker(void);
+
+    HLX::Common::Status Init(HLX::Client::Application::Controller &aController);
+
+    // Observation
+
+    void  WillRefresh(void);
+    Stage StateDidChange(const HLX::Client::StateChange::NotificationBasis &aStateChangeNotification);
+    void  DidRefresh(void);
+    void  DidNotRefresh(void);
+
+    // Introspection
+
+    Stage GetStage(void) const;
+    bool  IsUsable(void) const;
+    bool  IsComplete(void) const;
+    bool  IsGroupUsable(const HLX::Model::IdentifierModel::IdentifierType &aIdentifier) const;
+    bool  IsZoneUsable(const HLX::Model::IdentifierModel::IdentifierType &aIdentifier) const;
+
+    HLX::Common::Status GetTimeToUsable(Duration &aDuration) const;
+    HLX::Common::Status GetTimeToComplete(Duration &aDuration) const;
+
+private:
+    typedef HLX::Model::IdentifierModel::IdentifierType IdentifierType;
+    typedef std::vector<uint8_t>                        Properties;
+
+    static HLX::Common::Status InitProperties(Properties &aProperties, const IdentifierType &aMaximum);
+    static bool                HasProperties(const Properties &aProperties, const IdentifierType &aIdentifier, const uint8_t &aRequired);
+    void                       SetProperty(Properties &aProperties, const IdentifierType &aIdentifier, const uint8_t &aProperty, const uint8_t &aRequired);
+    void                       SetUsable(void);
+
+private:
+    HLX::Client::Application::Controller *  mController;
+    Stage                                   mStage;
+    Properties                              mGroups;
+    Properties                              mSources;
+    Properties                              mZones;
+    size_t                                  mOutstanding;
+    Clock::time_point                       mWillRefreshTime;
+    Clock::time_point                       mUsableTime;
+    Clock::time_point                       mCompleteTime;
+};
+
+#endif // REFRESHSTAGETRACKER_HPP
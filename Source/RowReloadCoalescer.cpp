@@ -0,0 +1,235 @@
+/*
+ *    Copyright (c) 2026 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *  @file
+ *    This file implements an object for coalescing the table view row
+ *    reloads that HLX client controller state changes call for.
+ *
+ */
+
+#include "RowReloadCoalescer.hpp"
+
+#include <algorithm>
+
+
+/**
+ *  @brief
+ *    This is a class constructor.
+ *
+ */
+RowReloadCoalescer :: RowReloadCoalescer(void) :
+    mPending(false),
+    mAll(false),
+    mDirty(),
+    mDirtyIdentifiers(),
+    mCounters()
+{
+    ResetCounters();
+
+    return;
+}
+
+/**
+ *  @brief
+ *    This is the class destructor.
+ *
+ */
+RowReloadCoalescer :: ~RowReloadCoalescer(void)
+{
+    return;
+}
+
+// MARK: Marking
+
+/**
+ *  @brief
+ *    Mark the row for the specified group, source, or zone dirty.
+ *
+ *  @param[in]  aKind        The kind of entity the row is for.
+ *  @param[in]  aIdentifier  The identifier of the entity the row is
+ *                           for.
+ *
+ *  @returns
+ *    True if this is the first mark since rows were last taken, in
+ *    which case the caller is to schedule a reload; otherwise, false.
+ *
+ */
+bool
+RowReloadCoalescer :: Mark(const Kind &aKind, const IdentifierType &aIdentifier)
+{
+    if ((aKind < kKindMax) && !mAll && !mDirty[aKind].test(aIdentifier))
+    {
+        mDirty[aKind].set(aIdentifier);
+        mDirtyIdentifiers[aKind].push_back(aIdentifier);
+    }
+
+    return (DidMark());
+}
+
+/**
+ *  @brief
+ *    Mark every row dirty.
+ *
+ *  @returns
+ *    True if this is the first mark since rows were last taken, in
+ *    which case the caller is to schedule a reload; otherwise, false.
+ *
+ */
+bool
+RowReloadCoalescer :: MarkAll(void)
+{
+    mAll = true;
+
+    return (DidMark());
+}
+
+/**
+ *  @brief
+ *    Return whether any rows are dirty and a reload is pending.
+ *
+ */
+bool
+RowReloadCoalescer :: IsPending(void) const
+{
+    return (mPending);
+}
+
+// MARK: Reloading
+
+/**
+ *  @brief
+ *    Take the dirty rows, leaving none dirty.
+ *
+ *  @param[out]  aBatch  A reference to storage for the rows to
+ *                       reload.
+ *
+ *  @returns
+ *    The number of rows to reload, which is zero where there are
+ *    none or where all are to be reloaded.
+ *
+ */
+size_t
+RowReloadCoalescer :: Take(Batch &aBatch)
+{
+    size_t lRetval = 0;
+
+    aBatch.mAll = mAll;
+
+    for (size_t lKind = kKindGroup; lKind < kKindMax; lKind++)
+    {
+        Identifiers &lIdentifiers = mDirtyIdentifiers[lKind];
+
+        // Unmark the rows one at a time, rather than resetting all of
+        // them, such that taking them costs only as much as there
+        // were dirty.
+
+        for (const IdentifierType &lIdentifier : lIdentifiers)
+        {
+            mDirty[lKind].reset(lIdentifier);
+        }
+
+        aBatch.mIdentifiers[lKind].clear();
+
+        if (!mAll)
+        {
+            std::sort(lIdentifiers.begin(), lIdentifiers.end());
+
+            aBatch.mIdentifiers[lKind].swap(lIdentifiers);
+
+            lRetval += aBatch.mIdentifiers[lKind].size();
+        }
+
+        lIdentifiers.clear();
+    }
+
+    if (mPending)
+    {
+        mCounters.mReloads++;
+
+        if (mAll)
+        {
+            mCounters.mAllRows++;
+        }
+        else
+        {
+            mCounters.mRows += lRetval;
+        }
+    }
+
+    mPending = false;
+    mAll     = false;
+
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Leave no rows dirty and no reload pending, without counting a
+ *    reload.
+ *
+ */
+void
+RowReloadCoalescer :: Clear(void)
+{
+    for (size_t lKind = kKindGroup; lKind < kKindMax; lKind++)
+    {
+        mDirty[lKind].reset();
+        mDirtyIdentifiers[lKind].clear();
+    }
+
+    mPending = false;
+    mAll     = false;
+}
+
+// MARK: Counters
+
+/**
+ *  @brief
+ *    Return the counts of state changes marked and of reloads and
+ *    rows taken.
+ *
+ */
+const RowReloadCoalescer::Counters &
+RowReloadCoalescer :: GetCounters(void) const
+{
+    return (mCounters);
+}
+
+void
+RowReloadCoalescer :: ResetCounters(void)
+{
+    mCounters.mNotifications = 0;
+    mCounters.mReloads       = 0;
+    mCounters.mRows          = 0;
+    mCounters.mAllRows       = 0;
+}
+
+// MARK: Workers
+
+bool
+RowReloadCoalescer :: DidMark(void)
+{
+    const bool lRetval = !mPending;
+
+    mCounters.mNotifications++;
+
+    mPending = true;
+
+    return (lRetval);
+}
@@ -0,0 +1,137 @@
+/*
+ *    Copyright (c) 2026 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *  @file
+ *    This file defines an object for coalescing the table view row
+ *    reloads that HLX client controller state changes call for.
+ *
+ *  This depends only on the C++ Standard Library such that it may be
+ *  built and benchmarked off of the target (see
+ *  Tools/hlxreloadbench).
+ *
+ */
+
+#ifndef ROWRELOADCOALESCER_HPP
+#define ROWRELOADCOALESCER_HPP
+
+#include <bitset>
+#include <vector>
+
+#include <stddef.h>
+#include <stdint.h>
+
+
+/**
+ *  @brief
+ *    An object for coalescing table view row reloads.
+ *
+ *  State changes arrive one at a time, yet many may arrive in a
+ *  single run loop turn: a refresh reports several properties of
+ *  every group and zone, and a group volume change reports the group
+ *  and each of its zones. Reloading a row for each is a storm of
+ *  reloads, most of them of rows reloaded moments before.
+ *
+ *  Instead, each state change marks the group, source, or zone it is
+ *  for dirty and, where it is the first since the last reload, the
+ *  caller schedules a reload for the end of the run loop turn. The
+ *  reload then takes the dirty rows, each once and in order, and
+ *  reloads them all together. A change, such as a source name, that
+ *  affects every row marks all of them dirty.
+ *
+ *  Counters of the state changes marked against the reloads and rows
+ *  taken measure how much coalescing saves.
+ *
+ */
+class RowReloadCoalescer
+{
+public:
+    /**
+     *  The kind of entity a row is for.
+     *
+     */
+    enum Kind
+    {
+        kKindGroup = 0, //!< A group.
+        kKindSource,    //!< A source.
+        kKindZone,      //!< A zone.
+
+        kKindMax
+    };
+
+    typedef uint8_t                      IdentifierType;
+    typedef std::vector<IdentifierType>  Identifiers;
+
+    /**
+     *  The rows to reload, taken at once: either all of them or the
+     *  identifiers, by kind, in ascending order, of those dirty.
+     *
+     */
+    struct Batch
+    {
+        bool         mAll;
+        Identifiers  mIdentifiers[kKindMax];
+    };
+
+    /**
+     *  Counts of the state changes marked, the reloads taken, and the
+     *  rows, or all rows, those reloaded.
+     *
+     */
+    struct Counters
+    {
+        uint64_t  mNotifications;
+        uint64_t  mReloads;
+        uint64_t  mRows;
+        uint64_t  mAllRows;
+    };
+
+public:
+    RowReloadCoalescer(void);
+    ~RowReloadCoalescer(void);
+
+    // Marking
+
+    bool             Mark(const Kind &aKind, const IdentifierType &aIdentifier);
+    bool             MarkAll(void);
+    bool             IsPending(void) const;
+
+    // Reloading
+
+    size_t           Take(Batch &aBatch);
+    void             Clear(void);
+
+    // Counters
+
+    const Counters & GetCounters(void) const;
+    void             ResetCounters(void);
+
+private:
+    bool             DidMark(void);
+
+private:
+    typedef std::bitset<256> Dirty;
+
+    bool         mPending;
+    bool         mAll;
+    Dirty        mDirty[kKindMax];
+    Identifiers  mDirtyIdentifiers[kKindMax];
+    Counters     mCounters;
+};
+
+#endif // ROWRELOADCOALESCER_HPP
@@ -0,0 +1,748 @@
+/*
+ *    Copyright (c) 2026 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *  @file
+ *    This file implements an object for capturing the volume, mute,
+ *    source, and sound mode state of a set of HLX groups and zones
+ *    and for applying it later with as few commands as possible.
+ *
+ */
+
+#include "Scene.hpp"
+
+#include <map>
+
+#include <errno.h>
+
+#include <LogUtilities/LogUtilities.hpp>
+
+#include <OpenHLX/Model/GroupModel.hpp>
+#include <OpenHLX/Model/ZoneModel.hpp>
+#include <OpenHLX/Utilities/Assert.hpp>
+
+
+using namespace HLX::Common;
+using namespace HLX::Model;
+using namespace Nuovations;
+
+
+typedef std::map<Scene::IdentifierType, Scene::State> PredictedStates;
+
+template <typename T>
+static bool
+NeedsSet(const bool &aHasTarget, const T &aTarget, const bool &aHasCurrent, const T &aCurrent)
+{
+    return (aHasTarget && (!aHasCurrent || (aTarget != aCurrent)));
+}
+
+static Status
+GetGroupState(const MutableApplicationControllerPointer &aApplicationController,
+              const Scene::IdentifierType &aIdentifier,
+              Scene::State &aState)
+{
+    const GroupModel *  lGroup;
+    size_t              lSourceCount;
+    Status              lRetval;
+
+
+    lRetval = aApplicationController->GroupGet(aIdentifier, lGroup);
+    nlREQUIRE_SUCCESS(lRetval, done);
+
+    aState = Scene::State();
+
+    aState.mIdentifier = aIdentifier;
+    aState.mHasVolume  = (lGroup->GetVolume(aState.mVolume) == kStatus_Success);
+    aState.mHasMute    = (lGroup->GetMute(aState.mMute) == kStatus_Success);
+
+    // A group whose zones are set to differing sources has no one
+    // source to capture or compare against.
+
+    if ((lGroup->GetSources(lSourceCount) == kStatus_Success) && (lSourceCount == 1))
+    {
+        aState.mHasSource = (lGroup->GetSources(&aState.mSource, lSourceCount) == kStatus_Success);
+    }
+
+ done:
+    return (lRetval);
+}
+
+static Status
+GetZoneState(const MutableApplicationControllerPointer &aApplicationController,
+             const Scene::IdentifierType &aIdentifier,
+             Scene::State &aState)
+{
+    const ZoneModel *  lZone;
+    Status             lRetval;
+
+
+    lRetval = aApplicationController->ZoneGet(aIdentifier, lZone);
+    nlREQUIRE_SUCCESS(lRetval, done);
+
+    aState = Scene::State();
+
+    aState.mIdentifier = aIdentifier;
+    aState.mHasVolume  = (lZone->GetVolume(aState.mVolume) == kStatus_Success);
+    aState.mHasMute    = (lZone->GetMute(aState.mMute) == kStatus_Success);
+    aState.mHasSource  = (lZone->GetSource(aState.mSource) == kStatus_Success);
+
+#if OPENHLX_INSTALLER
+    aState.mHasSoundMode = (lZone->GetSoundMode(aState.mSoundMode) == kStatus_Success);
+#endif
+
+ done:
+    return (lRetval);
+}
+
+/*
+ *  Plan the commands, if any, that move a group from its current
+ *  state to its target state, returning in @a aPlanned the
+ *  properties, and values, that they set.
+ */
+static void
+PlanGroupState(const MutableApplicationControllerPointer &aApplicationController,
+               const Scene::State &aTarget,
+               const Scene::State &aCurrent,
+               Scene::Commands &aCommands,
+               Scene::State &aPlanned)
+{
+    const MutableApplicationControllerPointer  lApplicationController = aApplicationController;
+    const Scene::IdentifierType                lIdentifier = aTarget.mIdentifier;
+    Scene::Command                             lCommand;
+    Scene::Command                             lMuteCommand;
+
+
+    aPlanned = Scene::State();
+
+    aPlanned.mIdentifier = lIdentifier;
+
+    lCommand.mKind       = CommandPipeline::kKindGroup;
+    lCommand.mIdentifier = lIdentifier;
+
+    lMuteCommand = lCommand;
+
+    lMuteCommand.mAnswers = CommandPipeline::kAnswerMute;
+
+    if (NeedsSet(aTarget.mHasMute, aTarget.mMute, aCurrent.mHasMute, aCurrent.mMute))
+    {
+        const VolumeModel::MuteType lMute = aTarget.mMute;
+
+        lMuteCommand.mIssuer = [lApplicationController, lIdentifier, lMute]() {
+            return (lApplicationController->GroupSetMute(lIdentifier, lMute));
+        };
+
+        aPlanned.mHasMute = true;
+        aPlanned.mMute    = lMute;
+
+        // Mute ahead of any other change, such that it is not heard.
+
+        if (lMute)
+        {
+            aCommands.push_back(lMuteCommand);
+        }
+    }
+
+    if (NeedsSet(aTarget.mHasVolume, aTarget.mVolume, aCurrent.mHasVolume, aCurrent.mVolume))
+    {
+        const VolumeModel::LevelType lVolume = aTarget.mVolume;
+
+        lCommand.mAnswers = CommandPipeline::kAnswerVolume;
+        lCommand.mIssuer  = [lApplicationController, lIdentifier, lVolume]() {
+            return (lApplicationController->GroupSetVolume(lIdentifier, lVolume));
+        };
+
+        aCommands.push_back(lCommand);
+
+        aPlanned.mHasVolume = true;
+        aPlanned.mVolume    = lVolume;
+    }
+
+    if (NeedsSet(aTarget.mHasSource, aTarget.mSource, aCurrent.mHasSource, aCurrent.mSource))
+    {
+        const SourceModel::IdentifierType lSource = aTarget.mSource;
+
+        lCommand.mAnswers = CommandPipeline::kAnswerSource;
+        lCommand.mIssuer  = [lApplicationController, lIdentifier, lSource]() {
+            return (lApplicationController->GroupSetSource(lIdentifier, lSource));
+        };
+
+        aCommands.push_back(lCommand);
+
+        aPlanned.mHasSource = true;
+        aPlanned.mSource    = lSource;
+    }
+
+    // Unmute behind any other change, such that it is heard only at
+    // its target volume and source.
+
+    if (aPlanned.mHasMute && !aPlanned.mMute)
+    {
+        aCommands.push_back(lMuteCommand);
+    }
+}
+
+/*
+ *  Add the change, if the target has the property, of one zone
+ *  property to those to be planned.
+ */
+static void
+AddChange(const Scene::IdentifierType &aZone,
+          const CommandPlanner::Property &aProperty,
+          const bool &aHasTarget,
+          const CommandPlanner::ValueType &aTarget,
+          const bool &aHasCurrent,
+          const CommandPlanner::ValueType &aCurrent,
+          CommandPlanner::Changes &aChanges)
+{
+    CommandPlanner::Change  lChange;
+
+
+    nlEXPECT(aHasTarget, done);
+
+    lChange.mZone       = aZone;
+    lChange.mProperty   = aProperty;
+    lChange.mHasCurrent = aHasCurrent;
+    lChange.mCurrent    = aCurrent;
+    lChange.mTarget     = aTarget;
+
+    aChanges.push_back(lChange);
+
+ done:
+    return;
+}
+
+/*
+ *  Get the zones in each group from the client controller model, such
+ *  that the command planner may command a group in place of its
+ *  zones.
+ */
+static void
+GetPlannerGroups(const MutableApplicationControllerPointer &aApplicationController,
+                 CommandPlanner::Groups &aGroups)
+{
+    IdentifierModel::IdentifierType  lGroupsMax;
+    IdentifierModel::IdentifierType  lIdentifier;
+    Status                           lStatus;
+
+
+    aGroups.clear();
+
+    lStatus = aApplicationController->GroupsGetMax(lGroupsMax);
+    nlREQUIRE_SUCCESS(lStatus, done);
+
+    for (lIdentifier = IdentifierModel::kIdentifierMin; lIdentifier <= lGroupsMax; lIdentifier++)
+    {
+        const GroupModel *      lGroup;
+        size_t                  lZoneCount;
+        CommandPlanner::Group   lPlannerGroup;
+
+        if ((aApplicationController->GroupGet(lIdentifier, lGroup) == kStatus_Success) &&
+            (lGroup->GetZones(lZoneCount) == kStatus_Success) &&
+            (lZoneCount > 0))
+        {
+            lPlannerGroup.mIdentifier = lIdentifier;
+            lPlannerGroup.mZones.resize(lZoneCount);
+
+            if (lGroup->GetZones(&lPlannerGroup.mZones[0], lZoneCount) == kStatus_Success)
+            {
+                lPlannerGroup.mZones.resize(lZoneCount);
+
+                aGroups.push_back(lPlannerGroup);
+            }
+        }
+    }
+
+ done:
+    return;
+}
+
+/*
+ *  Return the scene command that issues a planned command.
+ */
+static Scene::Command
+MakeCommand(const MutableApplicationControllerPointer &aApplicationController,
+            const CommandPlanner::Command &aPlanned)
+{
+    const MutableApplicationControllerPointer  lApplicationController = aApplicationController;
+    const CommandPlanner::Command              lPlanned = aPlanned;
+    Scene::Command                             lRetval;
+
+
+    lRetval.mKind       = ((aPlanned.mKind == CommandPlanner::kKindGroup) ? CommandPipeline::kKindGroup : CommandPipeline::kKindZone);
+    lRetval.mIdentifier = aPlanned.mIdentifier;
+    lRetval.mAnswers    = ((aPlanned.mProperty == CommandPlanner::kPropertyVolume) ? CommandPipeline::kAnswerVolume :
+                           (aPlanned.mProperty == CommandPlanner::kPropertyMute)   ? CommandPipeline::kAnswerMute   :
+                           (aPlanned.mProperty == CommandPlanner::kPropertySource) ? CommandPipeline::kAnswerSource :
+                                                                                     CommandPipeline::kAnswerTone);
+    lRetval.mIssuer     = [lApplicationController, lPlanned]() {
+        const bool  lIsGroup = (lPlanned.mKind == CommandPlanner::kKindGroup);
+        Status      lStatus = -EINVAL;
+
+        switch (lPlanned.mProperty)
+        {
+
+        case CommandPlanner::kPropertyVolume:
+            if (lPlanned.mEncoding == CommandPlanner::kEncodingIncrease)
+                lStatus = (lIsGroup ?
+                           lApplicationController->GroupIncreaseVolume(lPlanned.mIdentifier) :
+                           lApplicationController->ZoneIncreaseVolume(lPlanned.mIdentifier));
+            else if (lPlanned.mEncoding == CommandPlanner::kEncodingDecrease)
+                lStatus = (lIsGroup ?
+                           lApplicationController->GroupDecreaseVolume(lPlanned.mIdentifier) :
+                           lApplicationController->ZoneDecreaseVolume(lPlanned.mIdentifier));
+            else
+                lStatus = (lIsGroup ?
+                           lApplicationController->GroupSetVolume(lPlanned.mIdentifier, static_cast<VolumeModel::LevelType>(lPlanned.mValue)) :
+                           lApplicationController->ZoneSetVolume(lPlanned.mIdentifier, static_cast<VolumeModel::LevelType>(lPlanned.mValue)));
+            break;
+
+        case CommandPlanner::kPropertyMute:
+            lStatus = (lIsGroup ?
+                       lApplicationController->GroupSetMute(lPlanned.mIdentifier, (lPlanned.mValue != 0)) :
+                       lApplicationController->ZoneSetMute(lPlanned.mIdentifier, (lPlanned.mValue != 0)));
+            break;
+
+        case CommandPlanner::kPropertySource:
+            lStatus = (lIsGroup ?
+                       lApplicationController->GroupSetSource(lPlanned.mIdentifier, static_cast<SourceModel::IdentifierType>(lPlanned.mValue)) :
+                       lApplicationController->ZoneSetSource(lPlanned.mIdentifier, static_cast<SourceModel::IdentifierType>(lPlanned.mValue)));
+            break;
+
+        default:
+            break;
+
+        }
+
+        return (lStatus);
+    };
+
+    return (lRetval);
+}
+
+/*
+ *  Overlay the properties a group command will set onto the
+ *  predicted state of each of the zones in the group.
+ */
+static void
+PredictGroupZones(const MutableApplicationControllerPointer &aApplicationController,
+                  const Scene::State &aPlanned,
+                  PredictedStates &aPredicted)
+{
+    const GroupModel *                  lGroup;
+    size_t                              lZoneCount;
+    Scene::Identifiers                  lZoneIdentifiers;
+    Scene::Identifiers::const_iterator  lZoneIdentifier;
+    Status                              lStatus;
+
+
+    nlEXPECT(aPlanned.mHasVolume || aPlanned.mHasMute || aPlanned.mHasSource, done);
+
+    lStatus = aApplicationController->GroupGet(aPlanned.mIdentifier, lGroup);
+    nlREQUIRE_SUCCESS(lStatus, done);
+
+    lStatus = lGroup->GetZones(lZoneCount);
+    nlREQUIRE_SUCCESS(lStatus, done);
+
+    nlEXPECT(lZoneCount > 0, done);
+
+    lZoneIdentifiers.resize(lZoneCount);
+
+    lStatus = lGroup->GetZones(&lZoneIdentifiers[0], lZoneCount);
+    nlREQUIRE_SUCCESS(lStatus, done);
+
+    lZoneIdentifiers.resize(lZoneCount);
+
+    for (lZoneIdentifier = lZoneIdentifiers.begin(); lZoneIdentifier != lZoneIdentifiers.end(); lZoneIdentifier++)
+    {
+        PredictedStates::const_iterator lPredicted = aPredicted.find(*lZoneIdentifier);
+        Scene::State                    lState;
+
+        // Seed the prediction for a zone from the model the first
+        // time a group command sets it.
+
+        if (lPredicted != aPredicted.end())
+        {
+            lState  = lPredicted->second;
+            lStatus = kStatus_Success;
+        }
+        else
+        {
+            lStatus = GetZoneState(aApplicationController, *lZoneIdentifier, lState);
+        }
+
+        if (lStatus == kStatus_Success)
+        {
+            if (aPlanned.mHasVolume)
+            {
+                lState.mHasVolume = true;
+                lState.mVolume    = aPlanned.mVolume;
+            }
+
+            if (aPlanned.mHasMute)
+            {
+                lState.mHasMute = true;
+                lState.mMute    = aPlanned.mMute;
+            }
+
+            if (aPlanned.mHasSource)
+            {
+                lState.mHasSource = true;
+                lState.mSource    = aPlanned.mSource;
+            }
+
+            aPredicted[*lZoneIdentifier] = lState;
+        }
+    }
+
+ done:
+    return;
+}
+
+/**
+ *  @brief
+ *    This is the class default constructor.
+ *
+ */
+Scene :: State :: State(void) :
+    mIdentifier(IdentifierModel::kIdentifierMin),
+    mHasVolume(false),
+    mVolume(VolumeModel::kLevelMin),
+    mHasMute(false),
+    mMute(false),
+    mHasSource(false),
+    mSource(IdentifierModel::kIdentifierMin),
+    mHasSoundMode(false),
+    mSoundMode(SoundModel::kSoundModeDisabled)
+{
+    return;
+}
+
+/**
+ *  @brief
+ *    This is the class default constructor.
+ *
+ */
+Scene :: Scene(void) :
+    mGroups(),
+    mZones(),
+    mCommandPlanner()
+{
+    return;
+}
+
+/**
+ *  @brief
+ *    This is the class destructor.
+ *
+ */
+Scene :: ~Scene(void)
+{
+    return;
+}
+
+// MARK: Capture
+
+/**
+ *  @brief
+ *    Capture the scene from the client controller model.
+ *
+ *  Any previously-captured state is replaced.
+ *
+ *  @param[in]  aApplicationController  A reference to a shared
+ *                                      pointer to the client
+ *                                      controller from whose model
+ *                                      to capture.
+ *  @param[in]  aGroupIdentifiers       The identifiers of the groups
+ *                                      to capture.
+ *  @param[in]  aZoneIdentifiers        The identifiers of the zones
+ *                                      to capture.
+ *
+ *  @retval  kStatus_Success  If successful.
+ *  @retval  -ERANGE          If a group or zone identifier was out
+ *                            of range.
+ *
+ */
+Status
+Scene :: Capture(const MutableApplicationControllerPointer &aApplicationController,
+                 const Identifiers &aGroupIdentifiers,
+                 const Identifiers &aZoneIdentifiers)
+{
+    Identifiers::const_iterator  lIdentifier;
+    State                        lState;
+    Status                       lRetval = kStatus_Success;
+
+
+    Clear();
+
+    for (lIdentifier = aGroupIdentifiers.begin(); lIdentifier != aGroupIdentifiers.end(); lIdentifier++)
+    {
+        lRetval = GetGroupState(aApplicationController, *lIdentifier, lState);
+        nlREQUIRE_SUCCESS(lRetval, done);
+
+        AddGroup(lState);
+    }
+
+    for (lIdentifier = aZoneIdentifiers.begin(); lIdentifier != aZoneIdentifiers.end(); lIdentifier++)
+    {
+        lRetval = GetZoneState(aApplicationController, *lIdentifier, lState);
+        nlREQUIRE_SUCCESS(lRetval, done);
+
+        AddZone(lState);
+    }
+
+ done:
+    if (lRetval != kStatus_Success)
+    {
+        Clear();
+    }
+
+    return (lRetval);
+}
+
+// MARK: Introspection
+
+const Scene::States &
+Scene :: GetGroups(void) const
+{
+    return (mGroups);
+}
+
+const Scene::States &
+Scene :: GetZones(void) const
+{
+    return (mZones);
+}
+
+bool
+Scene :: IsEmpty(void) const
+{
+    return (mGroups.empty() && mZones.empty());
+}
+
+// MARK: Mutation
+
+void
+Scene :: AddGroup(const State &aState)
+{
+    mGroups.push_back(aState);
+}
+
+void
+Scene :: AddZone(const State &aState)
+{
+    mZones.push_back(aState);
+}
+
+void
+Scene :: Clear(void)
+{
+    mGroups.clear();
+    mZones.clear();
+}
+
+// MARK: Application
+
+/**
+ *  @brief
+ *    Plan the fewest commands that move the client controller model
+ *    from its current state to the scene.
+ *
+ *  @param[in]   aApplicationController  A reference to a shared
+ *                                       pointer to the client
+ *                                       controller against whose
+ *                                       model to plan and to which
+ *                                       the commands are to be
+ *                                       issued.
+ *  @param[out]  aCommands               The planned commands, in the
+ *                                       order they are to be issued.
+ *
+ *  @retval  kStatus_Success  If successful.
+ *  @retval  -ERANGE          If a group or zone identifier was out
+ *                            of range.
+ *
+ */
+Status
+Scene :: Plan(const MutableApplicationControllerPointer &aApplicationController,
+              Commands &aCommands) const
+{
+    States::const_iterator                    lTarget;
+    PredictedStates                           lPredicted;
+    State                                     lCurrent;
+    State                                     lPlanned;
+    CommandPlanner::Changes                   lChanges;
+    CommandPlanner::Groups                    lGroups;
+    CommandPlanner::Commands                  lPlannedCommands;
+    CommandPlanner::Commands::const_iterator  lPlannedCommand;
+    Commands                                  lSoundModeCommands;
+    size_t                                    lCost;
+    Status                                    lRetval = kStatus_Success;
+
+
+    aCommands.clear();
+
+    for (lTarget = mGroups.begin(); lTarget != mGroups.end(); lTarget++)
+    {
+        lRetval = GetGroupState(aApplicationController, lTarget->mIdentifier, lCurrent);
+        nlREQUIRE_SUCCESS(lRetval, done);
+
+        PlanGroupState(aApplicationController, *lTarget, lCurrent, aCommands, lPlanned);
+
+        PredictGroupZones(aApplicationController, lPlanned, lPredicted);
+    }
+
+    // Zone volume, mute, and source changes are planned together, by
+    // cost, such that a group or relative step command may be used
+    // where it is cheaper than a zone set. Sound mode changes have
+    // no such alternatives and are planned directly.
+
+    for (lTarget = mZones.begin(); lTarget != mZones.end(); lTarget++)
+    {
+        PredictedStates::const_iterator lPrediction = lPredicted.find(lTarget->mIdentifier);
+
+        if (lPrediction != lPredicted.end())
+        {
+            lCurrent = lPrediction->second;
+        }
+        else
+        {
+            lRetval = GetZoneState(aApplicationController, lTarget->mIdentifier, lCurrent);
+            nlREQUIRE_SUCCESS(lRetval, done);
+        }
+
+        AddChange(lTarget->mIdentifier, CommandPlanner::kPropertyVolume,
+                  lTarget->mHasVolume, lTarget->mVolume,
+                  lCurrent.mHasVolume, lCurrent.mVolume,
+                  lChanges);
+        AddChange(lTarget->mIdentifier, CommandPlanner::kPropertyMute,
+                  lTarget->mHasMute, lTarget->mMute,
+                  lCurrent.mHasMute, lCurrent.mMute,
+                  lChanges);
+        AddChange(lTarget->mIdentifier, CommandPlanner::kPropertySource,
+                  lTarget->mHasSource, lTarget->mSource,
+                  lCurrent.mHasSource, lCurrent.mSource,
+                  lChanges);
+
+#if OPENHLX_INSTALLER
+        if (NeedsSet(lTarget->mHasSoundMode, lTarget->mSoundMode, lCurrent.mHasSoundMode, lCurrent.mSoundMode))
+        {
+            const MutableApplicationControllerPointer  lApplicationController = aApplicationController;
+            const IdentifierType                       lIdentifier = lTarget->mIdentifier;
+            const SoundModel::SoundMode                lSoundMode = lTarget->mSoundMode;
+            Command                                    lCommand;
+
+            lCommand.mKind       = CommandPipeline::kKindZone;
+            lCommand.mIdentifier = lIdentifier;
+            lCommand.mAnswers    = CommandPipeline::kAnswerSoundMode;
+            lCommand.mIssuer     = [lApplicationController, lIdentifier, lSoundMode]() {
+                return (lApplicationController->ZoneSetSoundMode(lIdentifier, lSoundMode));
+            };
+
+            lSoundModeCommands.push_back(lCommand);
+        }
+#endif
+    }
+
+    GetPlannerGroups(aApplicationController, lGroups);
+
+    lCost = mCommandPlanner.Plan(lChanges, lGroups, lPlannedCommands);
+
+    Log::Debug().Write("Zone changes planned as %zu command(s) of %zu bytes, rather than %zu bytes.\n",
+                       lPlannedCommands.size(),
+                       lCost,
+                       mCommandPlanner.GetAbsoluteCost(lChanges));
+
+    // The planner orders unmutes last; keep them behind the sound mode
+    // changes as well.
+
+    for (lPlannedCommand = lPlannedCommands.begin(); lPlannedCommand != lPlannedCommands.end(); lPlannedCommand++)
+    {
+        if ((lPlannedCommand->mProperty == CommandPlanner::kPropertyMute) && (lPlannedCommand->mValue == 0))
+        {
+            aCommands.insert(aCommands.end(), lSoundModeCommands.begin(), lSoundModeCommands.end());
+
+            lSoundModeCommands.clear();
+        }
+
+        aCommands.push_back(MakeCommand(aApplicationController, *lPlannedCommand));
+    }
+
+    aCommands.insert(aCommands.end(), lSoundModeCommands.begin(), lSoundModeCommands.end());
+
+ done:
+    if (lRetval != kStatus_Success)
+    {
+        aCommands.clear();
+    }
+
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Apply the scene, enqueuing the fewest commands that move the
+ *    client controller model from its current state to the scene.
+ *
+ *  @param[in]   aApplicationController  A reference to a shared
+ *                                       pointer to the client
+ *                                       controller against whose
+ *                                       model to plan and to which
+ *                                       the commands are to be
+ *                                       issued.
+ *  @param[in]   aCommandPipeline        A reference to the command
+ *                                       pipeline to enqueue the
+ *                                       commands to.
+ *  @param[out]  aCount                  The number of commands
+ *                                       enqueued, zero if the model
+ *                                       already matched the scene.
+ *
+ *  @retval  kStatus_Success  If successful.
+ *  @retval  -ERANGE          If a group or zone identifier was out
+ *                            of range.
+ *
+ */
+Status
+Scene :: Apply(const MutableApplicationControllerPointer &aApplicationController,
+               CommandPipeline &aCommandPipeline,
+               size_t &aCount) const
+{
+    Commands                  lCommands;
+    Commands::const_iterator  lCommand;
+    Status                    lRetval;
+
+
+    aCount = 0;
+
+    lRetval = Plan(aApplicationController, lCommands);
+    nlREQUIRE_SUCCESS(lRetval, done);
+
+    Log::Debug().Write("Scene of %zu group(s) and %zu zone(s) planned as %zu command(s).\n",
+                       mGroups.size(),
+                       mZones.size(),
+                       lCommands.size());
+
+    for (lCommand = lCommands.begin(); lCommand != lCommands.end(); lCommand++)
+    {
+        lRetval = aCommandPipeline.Enqueue(lCommand->mKind, lCommand->mIdentifier, lCommand->mAnswers, lCommand->mIssuer);
+        nlREQUIRE_SUCCESS(lRetval, done);
+
+        aCount++;
+    }
+
+ done:
+    return (lRetval);
+}
@@ -0,0 +1,153 @@
+/*
+ *    Copyright (c) 2026 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *  @file
+ *    This file defines an object for capturing the volume, mute,
+ *    source, and sound mode state of a set of HLX groups and zones
+ *    and for applying it later with as few commands as possible.
+ *
+ */
+
+#ifndef SCENE_HPP
+#define SCENE_HPP
+
+#include <vector>
+
+#include <stddef.h>
+
+#include <OpenHLX/Common/Errors.hpp>
+#include <OpenHLX/Model/IdentifierModel.hpp>
+#include <OpenHLX/Model/SoundModel.hpp>
+#include <OpenHLX/Model/SourceModel.hpp>
+#include <OpenHLX/Model/VolumeModel.hpp>
+
+#include "ApplicationControllerPointer.hpp"
+#include "CommandPipeline.hpp"
+#include "CommandPlanner.hpp"
+
+
+/**
+ *  @brief
+ *    An object for capturing and applying HLX group and zone state.
+ *
+ *  A scene is captured from the client controller model for a chosen
+ *  set of groups and zones: the volume level, volume mute state, and
+ *  source of each and, on installer builds, the sound mode of each
+ *  zone. A property that the model does not yet hold, or a group
+ *  with more than one source, is not captured and is left as is when
+ *  the scene is applied.
+ *
+ *  Applying a scene plans, against the current model, only those
+ *  commands that change something: a property already at its target
+ *  value is skipped. Groups are planned first and, since a group
+ *  command sets every zone in the group, a zone property that a
+ *  group command will have already set to its target is skipped as
+ *  well. Zone changes are then planned by the command planner, which
+ *  uses a group command in place of zone commands, or relative steps
+ *  in place of a set, wherever that costs fewer bytes on the wire.
+ *  Mutes are planned ahead of other commands and unmutes after them,
+ *  such that a volume or source change is never briefly audible on
+ *  the way to a muted target.
+ *
+ *  The commands are enqueued, in order, to the command pipeline.
+ *
+ */
+class Scene
+{
+public:
+    typedef HLX::Model::IdentifierModel::IdentifierType IdentifierType;
+    typedef std::vector<IdentifierType>                  Identifiers;
+
+    /**
+     *  The captured state of a group or zone.
+     *
+     *  Each property is only captured, and only applied, where its
+     *  corresponding has flag is set.
+     *
+     */
+    struct State
+    {
+        State(void);
+
+        IdentifierType                           mIdentifier;
+        bool                                     mHasVolume;
+        HLX::Model::VolumeModel::LevelType       mVolume;
+        bool                                     mHasMute;
+        HLX::Model::VolumeModel::MuteType        mMute;
+        bool                                     mHasSource;
+        HLX::Model::SourceModel::IdentifierType  mSource;
+        bool                                     mHasSoundMode;
+        HLX::Model::SoundModel::SoundMode        mSoundMode;
+    };
+
+    typedef std::vector<State> States;
+
+    /**
+     *  A planned command: the kind and identifier of the entity it is
+     *  about, the property whose state change answers it, and the
+     *  function that issues it.
+     *
+     */
+    struct Command
+    {
+        CommandPipeline::Kind     mKind;
+        IdentifierType            mIdentifier;
+        CommandPipeline::Answers  mAnswers;
+        CommandPipeline::Issuer   mIssuer;
+    };
+
+    typedef std::vector<Command> Commands;
+
+public:
+    Scene(void);
+    ~Scene(void);
+
+    // Capture
+
+    HLX::Common::Status Capture(const MutableApplicationControllerPointer &aApplicationController,
+                                const Identifiers &aGroupIdentifiers,
+                                const Identifiers &aZoneIdentifiers);
+
+    // Introspection
+
+    const States &      GetGroups(void) const;
+    const States &      GetZones(void) const;
+    bool                IsEmpty(void) const;
+
+    // Mutation
+
+    void                AddGroup(const State &aState);
+    void                AddZone(const State &aState);
+    void                Clear(void);
+
+    // Application
+
+    HLX::Common::Status Plan(const MutableApplicationControllerPointer &aApplicationController,
+                             Commands &aCommands) const;
+    HLX::Common::Status Apply(const MutableApplicationControllerPointer &aApplicationController,
+                              CommandPipeline &aCommandPipeline,
+                              size_t &aCount) const;
+
+private:
+    States          mGroups;
+    States          mZones;
+    CommandPlanner  mCommandPlanner;
+};
+
+#endif // SCENE_HPP
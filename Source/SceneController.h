@@ -0,0 +1,66 @@
+/*
+ *    Copyright (c) 2026 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *  @file
+ *    This file defines a data controller for saving, restoring, and
+ *    removing named scenes, keyed by the same network address, name,
+ *    or URL location used for the connect history.
+ *
+ */
+
+#ifndef SCENECONTROLLER_H
+#define SCENECONTROLLER_H
+
+#import <Foundation/Foundation.h>
+
+#import "Scene.hpp"
+
+
+@interface SceneController : NSObject
+
+// MARK: Properties
+
+// MARK: Type Methods
+
++ (SceneController *)sharedController;
+
+// MARK: Instance Methods
+
+// MARK: Initialization
+
+- (SceneController *)init;
+
+// MARK: Introspection
+
+- (NSArray *) sceneNamesForLocation: (NSString *)aLocation;
+- (bool) getScene: (Scene &)aScene
+            named: (NSString *)aName
+      forLocation: (NSString *)aLocation;
+
+// MARK: Mutation
+
+- (bool) saveScene: (const Scene &)aScene
+             named: (NSString *)aName
+       forLocation: (NSString *)aLocation;
+- (bool) removeSceneNamed: (NSString *)aName
+              forLocation: (NSString *)aLocation;
+
+@end
+
+#endif // SCENECONTROLLER_H
@@ -0,0 +1,403 @@
+/*
+ *    Copyright (c) 2026 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *  @file
+ *    This file implements a data controller for saving, restoring,
+ *    and removing named scenes, keyed by the same network address,
+ *    name, or URL location used for the connect history.
+ *
+ */
+
+#import "SceneController.h"
+
+#import <Foundation/Foundation.h>
+
+#include <LogUtilities/LogUtilities.hpp>
+
+#include <OpenHLX/Common/Errors.hpp>
+#include <OpenHLX/Utilities/Assert.hpp>
+
+#import "ConnectHistoryController.h"
+
+
+using namespace HLX::Model;
+using namespace Nuovations;
+
+
+// Scenes are saved, by name, in the connect history entry for their
+// location such that they go when it does.
+
+static NSString * const kSceneScenesKey      = @"Scenes";
+
+// Scene Keys
+
+static NSString * const kSceneGroupsKey      = @"Groups";
+static NSString * const kSceneZonesKey       = @"Zones";
+
+// Scene Entity Keys
+
+static NSString * const kSceneIdentifierKey  = @"Identifier";
+static NSString * const kSceneVolumeKey      = @"Volume";
+static NSString * const kSceneMuteKey        = @"Mute";
+static NSString * const kSceneSourceKey      = @"Source";
+static NSString * const kSceneSoundModeKey   = @"Sound Mode";
+
+static NSArray *
+serializeStates(const Scene::States &aStates)
+{
+    NSMutableArray *                lRetval = [NSMutableArray arrayWithCapacity: aStates.size()];
+    Scene::States::const_iterator   lState;
+
+
+    nlREQUIRE(lRetval != nullptr, done);
+
+    for (lState = aStates.begin(); lState != aStates.end(); lState++)
+    {
+        NSMutableDictionary *lEntity = [NSMutableDictionary dictionary];
+
+        [lEntity setObject: [NSNumber numberWithUnsignedInt: lState->mIdentifier]
+                    forKey: kSceneIdentifierKey];
+
+        if (lState->mHasVolume)
+        {
+            [lEntity setObject: [NSNumber numberWithInt: lState->mVolume]
+                        forKey: kSceneVolumeKey];
+        }
+
+        if (lState->mHasMute)
+        {
+            [lEntity setObject: [NSNumber numberWithBool: lState->mMute]
+                        forKey: kSceneMuteKey];
+        }
+
+        if (lState->mHasSource)
+        {
+            [lEntity setObject: [NSNumber numberWithUnsignedInt: lState->mSource]
+                        forKey: kSceneSourceKey];
+        }
+
+        if (lState->mHasSoundMode)
+        {
+            [lEntity setObject: [NSNumber numberWithInt: lState->mSoundMode]
+                        forKey: kSceneSoundModeKey];
+        }
+
+        [lRetval addObject: lEntity];
+    }
+
+ done:
+    return (lRetval);
+}
+
+static bool
+deserializeState(NSDictionary *aEntity, Scene::State &aState)
+{
+    NSNumber *  lNumber;
+    bool        lRetval = false;
+
+
+    nlREQUIRE([aEntity isKindOfClass: [NSDictionary class]], done);
+
+    lNumber = [aEntity objectForKey: kSceneIdentifierKey];
+    nlREQUIRE(lNumber != nullptr, done);
+
+    aState = Scene::State();
+
+    aState.mIdentifier = static_cast<Scene::IdentifierType>([lNumber unsignedIntValue]);
+
+    if ((lNumber = [aEntity objectForKey: kSceneVolumeKey]) != nullptr)
+    {
+        aState.mHasVolume = true;
+        aState.mVolume    = static_cast<VolumeModel::LevelType>([lNumber intValue]);
+    }
+
+    if ((lNumber = [aEntity objectForKey: kSceneMuteKey]) != nullptr)
+    {
+        aState.mHasMute = true;
+        aState.mMute    = [lNumber boolValue];
+    }
+
+    if ((lNumber = [aEntity objectForKey: kSceneSourceKey]) != nullptr)
+    {
+        aState.mHasSource = true;
+        aState.mSource    = static_cast<SourceModel::IdentifierType>([lNumber unsignedIntValue]);
+    }
+
+    if ((lNumber = [aEntity objectForKey: kSceneSoundModeKey]) != nullptr)
+    {
+        aState.mHasSoundMode = true;
+        aState.mSoundMode    = static_cast<SoundModel::SoundMode>([lNumber intValue]);
+    }
+
+    lRetval = true;
+
+ done:
+    return (lRetval);
+}
+
+@interface SceneController ()
+{
+
+}
+
+@end
+
+@implementation SceneController
+
+// MARK: Type Methods
+
+/**
+ *  @brief
+ *    Return a shared instance of the scene controller.
+ *
+ *  @returns
+ *    A pointer to the shared instance of the scene controller, if
+ *    successful; otherwise null.
+ *
+ */
++ (SceneController *)sharedController
+{
+    SceneController *lRetval = nullptr;
+
+    lRetval = [[self alloc] init];
+    nlREQUIRE(lRetval != nullptr, done);
+
+ done:
+    return (lRetval);
+}
+
+// MARK: Instance Methods
+
+// MARK: Initialization
+
+/**
+ *  @brief
+ *    Initializes a scene controller object.
+ *
+ *  @returns
+ *    An initialized scene controller object.
+ *
+ */
+- (SceneController *)init
+{
+    return (self);
+}
+
+// MARK: Introspection
+
+/**
+ *  @brief
+ *    Return the names of the scenes saved for the specified network
+ *    location.
+ *
+ *  @param[in]  aLocation  A pointer to the string representation of
+ *                         the network address, name, or URL of the
+ *                         location.
+ *
+ *  @returns
+ *    The names, in case-insensitive order, of the scenes saved for
+ *    the location, which may be empty.
+ *
+ */
+- (NSArray *) sceneNamesForLocation: (NSString *)aLocation
+{
+    NSDictionary *  lScenes;
+    NSArray *       lRetval = [NSArray array];
+
+
+    lScenes = [[ConnectHistoryController sharedController] objectForKey: kSceneScenesKey
+                                                             forLocation: aLocation];
+    nlEXPECT(lScenes != nullptr, done);
+
+    lRetval = [[lScenes allKeys] sortedArrayUsingSelector: @selector(caseInsensitiveCompare:)];
+
+ done:
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Restore the named scene saved for the specified network
+ *    location.
+ *
+ *  @param[out]  aScene     A reference to the scene to restore to.
+ *  @param[in]   aName      A pointer to the name of the scene.
+ *  @param[in]   aLocation  A pointer to the string representation of
+ *                          the network address, name, or URL of the
+ *                          location.
+ *
+ *  @returns
+ *    True if the scene was saved for the location and was restored;
+ *    otherwise, false.
+ *
+ */
+- (bool) getScene: (Scene &)aScene
+            named: (NSString *)aName
+      forLocation: (NSString *)aLocation
+{
+    NSDictionary *  lScenes;
+    NSDictionary *  lScene;
+    Scene::State    lState;
+    bool            lRetval = false;
+
+
+    aScene.Clear();
+
+    lScenes = [[ConnectHistoryController sharedController] objectForKey: kSceneScenesKey
+                                                             forLocation: aLocation];
+    nlEXPECT(lScenes != nullptr, done);
+
+    lScene = [lScenes objectForKey: aName];
+    nlEXPECT(lScene != nullptr, done);
+
+    for (NSDictionary *lEntity in [lScene objectForKey: kSceneGroupsKey])
+    {
+        lRetval = deserializeState(lEntity, lState);
+        nlREQUIRE(lRetval, done);
+
+        aScene.AddGroup(lState);
+    }
+
+    for (NSDictionary *lEntity in [lScene objectForKey: kSceneZonesKey])
+    {
+        lRetval = deserializeState(lEntity, lState);
+        nlREQUIRE(lRetval, done);
+
+        aScene.AddZone(lState);
+    }
+
+    lRetval = true;
+
+ done:
+    if (!lRetval)
+    {
+        aScene.Clear();
+    }
+
+    return (lRetval);
+}
+
+// MARK: Mutation
+
+/**
+ *  @brief
+ *    Save the scene, by name, for the specified network location,
+ *    replacing any scene of the same name.
+ *
+ *  @param[in]  aScene     An immutable reference to the scene to
+ *                         save.
+ *  @param[in]  aName      A pointer to the name of the scene.
+ *  @param[in]  aLocation  A pointer to the string representation of
+ *                         the network address, name, or URL of the
+ *                         location.
+ *
+ *  @returns
+ *    True if the location was in the connect history and the scene
+ *    was saved; otherwise, false.
+ *
+ */
+- (bool) saveScene: (const Scene &)aScene
+             named: (NSString *)aName
+       forLocation: (NSString *)aLocation
+{
+    ConnectHistoryController *  lConnectHistoryController;
+    NSDictionary *              lScenes;
+    NSMutableDictionary *       lMutableScenes;
+    NSArray *                   lGroups;
+    NSArray *                   lZones;
+    bool                        lRetval = false;
+
+
+    nlREQUIRE([aName length] > 0, done);
+    nlREQUIRE(!aScene.IsEmpty(), done);
+
+    lConnectHistoryController = [ConnectHistoryController sharedController];
+    nlREQUIRE(lConnectHistoryController != nullptr, done);
+
+    lGroups = serializeStates(aScene.GetGroups());
+    nlREQUIRE(lGroups != nullptr, done);
+
+    lZones = serializeStates(aScene.GetZones());
+    nlREQUIRE(lZones != nullptr, done);
+
+    lScenes = [lConnectHistoryController objectForKey: kSceneScenesKey
+                                          forLocation: aLocation];
+
+    lMutableScenes = ((lScenes != nullptr) ? [lScenes mutableCopy] : [NSMutableDictionary dictionary]);
+    nlREQUIRE(lMutableScenes != nullptr, done);
+
+    [lMutableScenes setObject: [NSDictionary dictionaryWithObjectsAndKeys:
+                                                 lGroups, kSceneGroupsKey,
+                                                 lZones,  kSceneZonesKey,
+                                                 nullptr]
+                       forKey: aName];
+
+    lRetval = [lConnectHistoryController setObject: lMutableScenes
+                                            forKey: kSceneScenesKey
+                                       forLocation: aLocation];
+
+ done:
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Remove the named scene saved for the specified network location.
+ *
+ *  @param[in]  aName      A pointer to the name of the scene.
+ *  @param[in]  aLocation  A pointer to the string representation of
+ *                         the network address, name, or URL of the
+ *                         location.
+ *
+ *  @returns
+ *    True if the scene was saved for the location and was removed;
+ *    otherwise, false.
+ *
+ */
+- (bool) removeSceneNamed: (NSString *)aName
+              forLocation: (NSString *)aLocation
+{
+    ConnectHistoryController *  lConnectHistoryController;
+    NSDictionary *              lScenes;
+    NSMutableDictionary *       lMutableScenes;
+    bool                        lRetval = false;
+
+
+    lConnectHistoryController = [ConnectHistoryController sharedController];
+    nlREQUIRE(lConnectHistoryController != nullptr, done);
+
+    lScenes = [lConnectHistoryController objectForKey: kSceneScenesKey
+                                          forLocation: aLocation];
+    nlEXPECT(lScenes != nullptr, done);
+    nlEXPECT([lScenes objectForKey: aName] != nullptr, done);
+
+    lMutableScenes = [lScenes mutableCopy];
+    nlREQUIRE(lMutableScenes != nullptr, done);
+
+    [lMutableScenes removeObjectForKey: aName];
+
+    lRetval = [lConnectHistoryController setObject: lMutableScenes
+                                            forKey: kSceneScenesKey
+                                       forLocation: aLocation];
+
+ done:
+    return (lRetval);
+}
+
+@end
@@ -0,0 +1,834 @@
+/*
+ *    Copyright (c) 2026 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *  @file
+ *    This file implements objects for writing and reading a compact,
+ *    streamable, append-only binary log of the HLX client controller
+ *    delegations of one or more sessions.
+ *
+ */
+
+#include "SessionLog.hpp"
+
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+
+
+const uint8_t SessionLog::kVersion;
+
+namespace
+{
+
+const char    kMagic[]       = { 'H', 'L', 'X', 'S' };
+const size_t  kHeaderLength  = sizeof (kMagic) + 1;
+
+// No record comes close to this; anything longer is taken to be
+// corruption rather than a record to buffer.
+
+const size_t  kRecordLengthMax = 64 * 1024;
+
+void
+PutUnsigned(std::string &aBuffer, uint64_t aValue)
+{
+    while (aValue >= 0x80)
+    {
+        aBuffer.push_back(static_cast<char>((aValue & 0x7F) | 0x80));
+        aValue >>= 7;
+    }
+
+    aBuffer.push_back(static_cast<char>(aValue));
+}
+
+void
+PutSigned(std::string &aBuffer, const int64_t &aValue)
+{
+    // Zigzag encode, such that values of small magnitude, negative
+    // or positive, take few bytes.
+
+    PutUnsigned(aBuffer, ((static_cast<uint64_t>(aValue) << 1) ^ static_cast<uint64_t>(aValue >> 63)));
+}
+
+bool
+GetUnsigned(const std::string &aBuffer, size_t &aOffset, uint64_t &aValue)
+{
+    unsigned int  lShift = 0;
+    bool          lRetval = false;
+
+    aValue = 0;
+
+    while ((aOffset < aBuffer.size()) && (lShift < 64))
+    {
+        const uint8_t lByte = static_cast<uint8_t>(aBuffer[aOffset++]);
+
+        aValue |= (static_cast<uint64_t>(lByte & 0x7F) << lShift);
+
+        if ((lByte & 0x80) == 0)
+        {
+            lRetval = true;
+            break;
+        }
+
+        lShift += 7;
+    }
+
+    return (lRetval);
+}
+
+bool
+GetSigned(const std::string &aBuffer, size_t &aOffset, int64_t &aValue)
+{
+    uint64_t  lValue;
+    bool      lRetval;
+
+    lRetval = GetUnsigned(aBuffer, aOffset, lValue);
+
+    aValue = static_cast<int64_t>((lValue >> 1) ^ (~(lValue & 1) + 1));
+
+    return (lRetval);
+}
+
+/**
+ *  Read a record length from a stream.
+ *
+ *  @returns
+ *    0 if successful; -ENOENT if the stream is at its end; -EAGAIN if
+ *    the stream ends partway through the length; or -EBADMSG if the
+ *    length is not valid.
+ *
+ */
+int
+ReadLength(FILE *aStream, size_t &aLength)
+{
+    uint64_t      lLength = 0;
+    unsigned int  lShift = 0;
+    int           lByte;
+    int           lRetval = -EBADMSG;
+
+    while (lShift < 64)
+    {
+        lByte = fgetc(aStream);
+
+        if (lByte == EOF)
+        {
+            lRetval = ((lShift == 0) ? -ENOENT : -EAGAIN);
+            break;
+        }
+
+        lLength |= (static_cast<uint64_t>(lByte & 0x7F) << lShift);
+
+        if ((lByte & 0x80) == 0)
+        {
+            lRetval = (((lLength > 0) && (lLength <= kRecordLengthMax)) ? 0 : -EBADMSG);
+            break;
+        }
+
+        lShift += 7;
+    }
+
+    aLength = static_cast<size_t>(lLength);
+
+    return (lRetval);
+}
+
+const char * const sTypeNames[SessionLog::kTypeMax] =
+{
+    "SessionStart",
+    "WillResolve",
+    "IsResolving",
+    "DidResolve",
+    "DidNotResolve",
+    "WillConnect",
+    "IsConnecting",
+    "DidConnect",
+    "DidNotConnect",
+    "WillDisconnect",
+    "DidDisconnect",
+    "DidNotDisconnect",
+    "WillRefresh",
+    "IsRefreshing",
+    "DidRefresh",
+    "DidNotRefresh",
+    "StateDidChange",
+    "Error"
+};
+
+const char * const sStateChangeNames[SessionLog::kStateChangeMax] =
+{
+    "Unknown",
+    "EqualizerPresetBand",
+    "EqualizerPresetName",
+    "GroupMute",
+    "GroupName",
+    "GroupSource",
+    "GroupVolume",
+    "SourceName",
+    "ZoneBalance",
+    "ZoneEqualizerBand",
+    "ZoneEqualizerPreset",
+    "ZoneHighpassCrossover",
+    "ZoneLowpassCrossover",
+    "ZoneMute",
+    "ZoneName",
+    "ZoneSoundMode",
+    "ZoneSource",
+    "ZoneTone",
+    "ZoneVolume"
+};
+
+}; // namespace
+
+// MARK: Event
+
+SessionLog::Event :: Event(void) :
+    mType(kTypeSessionStart),
+    mTime(0),
+    mStateChange(kStateChangeUnknown),
+    mValues(),
+    mStrings()
+{
+    return;
+}
+
+void
+SessionLog::Event :: Clear(void)
+{
+    mType        = kTypeSessionStart;
+    mTime        = Duration(0);
+    mStateChange = kStateChangeUnknown;
+
+    mValues.clear();
+    mStrings.clear();
+}
+
+// MARK: Writer
+
+/**
+ *  @brief
+ *    This is a class constructor.
+ *
+ */
+SessionLog::Writer :: Writer(void) :
+    mStream(nullptr),
+    mLastTime(0),
+    mBuffer()
+{
+    return;
+}
+
+/**
+ *  @brief
+ *    This is the class destructor.
+ *
+ */
+SessionLog::Writer :: ~Writer(void)
+{
+    Close();
+
+    return;
+}
+
+/**
+ *  @brief
+ *    Open the log at the specified path for appending, creating it if
+ *    it does not exist.
+ *
+ *  Any record at the end of an existing log cut short by a prior
+ *  writer is discarded.
+ *
+ *  @param[in]  aPath  A pointer to the null-terminated path of the
+ *                     log.
+ *
+ *  @retval  0         If successful.
+ *  @retval  -EBUSY    If the writer is already open.
+ *  @retval  -EBADMSG  If the existing file is not a log of a version
+ *                     this can append to.
+ *  @retval  -errno    If the log could not be opened or written.
+ *
+ */
+int
+SessionLog::Writer :: Open(const char *aPath)
+{
+    char  lHeader[kHeaderLength];
+    long  lSize;
+    int   lRetval = 0;
+
+    if (mStream != nullptr)
+    {
+        lRetval = -EBUSY;
+        goto done;
+    }
+
+    mStream = fopen(aPath, "a+b");
+
+    if (mStream == nullptr)
+    {
+        lRetval = -errno;
+        goto done;
+    }
+
+    if ((fseek(mStream, 0, SEEK_END) != 0) || ((lSize = ftell(mStream)) < 0))
+    {
+        lRetval = -errno;
+        goto done;
+    }
+
+    if (lSize == 0)
+    {
+        if ((fwrite(kMagic, sizeof (kMagic), 1, mStream) != 1) || (fputc(kVersion, mStream) == EOF))
+        {
+            lRetval = -errno;
+            goto done;
+        }
+    }
+    else
+    {
+        rewind(mStream);
+
+        if ((fread(lHeader, sizeof (lHeader), 1, mStream) != 1) ||
+            (memcmp(lHeader, kMagic, sizeof (kMagic)) != 0) ||
+            (static_cast<uint8_t>(lHeader[sizeof (kMagic)]) != kVersion))
+        {
+            lRetval = -EBADMSG;
+            goto done;
+        }
+
+        lRetval = Recover();
+
+        if (lRetval != 0)
+        {
+            goto done;
+        }
+
+        // The stream has been read from; it must be repositioned
+        // before it is written to.
+
+        if (fseek(mStream, 0, SEEK_END) != 0)
+        {
+            lRetval = -errno;
+            goto done;
+        }
+    }
+
+    mLastTime = Duration(0);
+
+ done:
+    if ((lRetval != 0) && (mStream != nullptr))
+    {
+        fclose(mStream);
+        mStream = nullptr;
+    }
+
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Flush and close the log.
+ *
+ *  @retval  0       If successful or if the log was not open.
+ *  @retval  -errno  If the log could not be flushed.
+ *
+ */
+int
+SessionLog::Writer :: Close(void)
+{
+    int lRetval = 0;
+
+    if (mStream != nullptr)
+    {
+        if (fclose(mStream) != 0)
+        {
+            lRetval = -errno;
+        }
+
+        mStream = nullptr;
+    }
+
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Return whether the log is open.
+ *
+ */
+bool
+SessionLog::Writer :: IsOpen(void) const
+{
+    return (mStream != nullptr);
+}
+
+/**
+ *  @brief
+ *    Append an event to the log.
+ *
+ *  The record is written whole, in a single write, such that a
+ *  reader following the log sees either all of it or, for a time,
+ *  none or a prefix of it. It reaches the log no later than the next
+ *  flush.
+ *
+ *  A session start resets the session time; each other event is
+ *  stored as the time since the prior one, where it is later.
+ *
+ *  @param[in]  aEvent  An immutable reference to the event to
+ *                      append.
+ *
+ *  @retval  0        If successful.
+ *  @retval  -EBADF   If the log is not open.
+ *  @retval  -errno   If the log could not be written.
+ *
+ */
+int
+SessionLog::Writer :: Write(const Event &aEvent)
+{
+    Duration  lDelta(0);
+    int       lRetval = 0;
+
+    if (mStream == nullptr)
+    {
+        lRetval = -EBADF;
+        goto done;
+    }
+
+    if (aEvent.mType == kTypeSessionStart)
+    {
+        mLastTime = Duration(0);
+    }
+    else if (aEvent.mTime > mLastTime)
+    {
+        lDelta    = (aEvent.mTime - mLastTime);
+        mLastTime = aEvent.mTime;
+    }
+
+    Encode(aEvent, lDelta, mBuffer);
+
+    if (fwrite(mBuffer.data(), mBuffer.size(), 1, mStream) != 1)
+    {
+        lRetval = -errno;
+        goto done;
+    }
+
+ done:
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Flush any events buffered to the log.
+ *
+ *  @retval  0       If successful.
+ *  @retval  -EBADF  If the log is not open.
+ *  @retval  -errno  If the log could not be flushed.
+ *
+ */
+int
+SessionLog::Writer :: Flush(void)
+{
+    int lRetval = 0;
+
+    if (mStream == nullptr)
+    {
+        lRetval = -EBADF;
+    }
+    else if (fflush(mStream) != 0)
+    {
+        lRetval = -errno;
+    }
+
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Discard any record at the end of the log cut short by a prior
+ *    writer.
+ *
+ *  The stream must be positioned just past the header.
+ *
+ */
+int
+SessionLog::Writer :: Recover(void)
+{
+    long    lGood = static_cast<long>(kHeaderLength);
+    size_t  lLength;
+    int     lStatus;
+    int     lRetval = 0;
+
+    while (true)
+    {
+        lStatus = ReadLength(mStream, lLength);
+
+        if (lStatus == -ENOENT)
+        {
+            break;
+        }
+
+        // A partial or an invalid length, or a record that runs past
+        // the end of the log, ends the last good record.
+
+        if ((lStatus != 0) || (fseek(mStream, static_cast<long>(lLength) - 1, SEEK_CUR) != 0) || (fgetc(mStream) == EOF))
+        {
+            fflush(mStream);
+
+            if (ftruncate(fileno(mStream), lGood) != 0)
+            {
+                lRetval = -errno;
+            }
+
+            break;
+        }
+
+        lGood = ftell(mStream);
+    }
+
+    clearerr(mStream);
+
+    return (lRetval);
+}
+
+// MARK: Reader
+
+/**
+ *  @brief
+ *    This is a class constructor.
+ *
+ */
+SessionLog::Reader :: Reader(void) :
+    mStream(nullptr),
+    mTime(0),
+    mBuffer()
+{
+    return;
+}
+
+/**
+ *  @brief
+ *    This is the class destructor.
+ *
+ */
+SessionLog::Reader :: ~Reader(void)
+{
+    Close();
+
+    return;
+}
+
+/**
+ *  @brief
+ *    Open the log at the specified path for reading.
+ *
+ *  @param[in]  aPath  A pointer to the null-terminated path of the
+ *                     log.
+ *
+ *  @retval  0         If successful.
+ *  @retval  -EBUSY    If the reader is already open.
+ *  @retval  -EBADMSG  If the file is not a log of a version this can
+ *                     read.
+ *  @retval  -errno    If the log could not be opened or read.
+ *
+ */
+int
+SessionLog::Reader :: Open(const char *aPath)
+{
+    char  lHeader[kHeaderLength];
+    int   lRetval = 0;
+
+    if (mStream != nullptr)
+    {
+        lRetval = -EBUSY;
+        goto done;
+    }
+
+    mStream = fopen(aPath, "rb");
+
+    if (mStream == nullptr)
+    {
+        lRetval = -errno;
+        goto done;
+    }
+
+    if ((fread(lHeader, sizeof (lHeader), 1, mStream) != 1) ||
+        (memcmp(lHeader, kMagic, sizeof (kMagic)) != 0) ||
+        (static_cast<uint8_t>(lHeader[sizeof (kMagic)]) != kVersion))
+    {
+        lRetval = -EBADMSG;
+        goto done;
+    }
+
+    mTime = Duration(0);
+
+ done:
+    if ((lRetval != 0) && (mStream != nullptr))
+    {
+        fclose(mStream);
+        mStream = nullptr;
+    }
+
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Close the log.
+ *
+ */
+int
+SessionLog::Reader :: Close(void)
+{
+    int lRetval = 0;
+
+    if (mStream != nullptr)
+    {
+        if (fclose(mStream) != 0)
+        {
+            lRetval = -errno;
+        }
+
+        mStream = nullptr;
+    }
+
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Read the next event from the log.
+ *
+ *  The event time is that since the start of its session.
+ *
+ *  @param[out]  aEvent  A reference to storage for the event.
+ *
+ *  @retval  0         If successful.
+ *  @retval  -ENOENT   If there are no more events.
+ *  @retval  -EAGAIN   If the next event has only partly been
+ *                     written; it may be read again once the
+ *                     writer has written the rest of it.
+ *  @retval  -EBADMSG  If the next record is not valid.
+ *  @retval  -EBADF    If the log is not open.
+ *
+ */
+int
+SessionLog::Reader :: Read(Event &aEvent)
+{
+    long      lStart;
+    size_t    lLength;
+    Duration  lDelta;
+    int       lRetval;
+
+    if (mStream == nullptr)
+    {
+        lRetval = -EBADF;
+        goto done;
+    }
+
+    lStart = ftell(mStream);
+
+    lRetval = ReadLength(mStream, lLength);
+
+    if (lRetval == 0)
+    {
+        mBuffer.resize(lLength);
+
+        if (fread(&mBuffer[0], lLength, 1, mStream) != 1)
+        {
+            lRetval = -EAGAIN;
+        }
+        else if (!Decode(mBuffer, lDelta, aEvent))
+        {
+            lRetval = -EBADMSG;
+        }
+    }
+
+    // Leave a record that has only partly been written to be read
+    // again from its start.
+
+    if ((lRetval == -ENOENT) || (lRetval == -EAGAIN))
+    {
+        clearerr(mStream);
+        fseek(mStream, lStart, SEEK_SET);
+    }
+
+    if (lRetval == 0)
+    {
+        mTime = ((aEvent.mType == kTypeSessionStart) ? Duration(0) : (mTime + lDelta));
+
+        aEvent.mTime = mTime;
+    }
+
+ done:
+    return (lRetval);
+}
+
+// MARK: Introspection
+
+/**
+ *  @brief
+ *    Return a name for the specified event type.
+ *
+ */
+const char *
+SessionLog :: GetTypeName(const Type &aType)
+{
+    return (((aType >= kTypeSessionStart) && (aType < kTypeMax)) ? sTypeNames[aType] : "Unknown");
+}
+
+/**
+ *  @brief
+ *    Return a name for the specified state change type.
+ *
+ */
+const char *
+SessionLog :: GetStateChangeName(const StateChange &aStateChange)
+{
+    return (((aStateChange >= kStateChangeUnknown) && (aStateChange < kStateChangeMax)) ? sStateChangeNames[aStateChange] : "Unknown");
+}
+
+// MARK: Encoding
+
+/**
+ *  @brief
+ *    Encode an event as a length-prefixed record.
+ *
+ *  @param[in]   aEvent   An immutable reference to the event to
+ *                        encode.
+ *  @param[in]   aDelta   The time since the prior event of the
+ *                        session.
+ *  @param[out]  aRecord  A reference to storage for the record.
+ *
+ */
+void
+SessionLog :: Encode(const Event &aEvent, const Duration &aDelta, std::string &aRecord)
+{
+    std::string lBody;
+
+    lBody.push_back(static_cast<char>(aEvent.mType));
+
+    PutUnsigned(lBody, static_cast<uint64_t>(aDelta.count()));
+    PutUnsigned(lBody, static_cast<uint64_t>((aEvent.mType == kTypeStateDidChange) ? aEvent.mStateChange : 0));
+
+    PutUnsigned(lBody, aEvent.mValues.size());
+
+    for (const ValueType &lValue : aEvent.mValues)
+    {
+        PutSigned(lBody, lValue);
+    }
+
+    PutUnsigned(lBody, aEvent.mStrings.size());
+
+    for (const std::string &lString : aEvent.mStrings)
+    {
+        PutUnsigned(lBody, lString.size());
+
+        lBody.append(lString);
+    }
+
+    aRecord.clear();
+
+    PutUnsigned(aRecord, lBody.size());
+
+    aRecord.append(lBody);
+}
+
+/**
+ *  @brief
+ *    Decode an event from a record, less its length prefix.
+ *
+ *  @param[in]   aRecord  An immutable reference to the record to
+ *                        decode.
+ *  @param[out]  aDelta   A reference to storage for the time since
+ *                        the prior event of the session.
+ *  @param[out]  aEvent   A reference to storage for the event.
+ *
+ *  @returns
+ *    True if the record was valid; otherwise, false.
+ *
+ */
+bool
+SessionLog :: Decode(const std::string &aRecord, Duration &aDelta, Event &aEvent)
+{
+    size_t    lOffset = 0;
+    uint64_t  lValue;
+    uint64_t  lCount;
+    int64_t   lSigned;
+    bool      lRetval = false;
+
+    aEvent.Clear();
+
+    if (aRecord.empty())
+    {
+        goto done;
+    }
+
+    aEvent.mType = static_cast<Type>(static_cast<uint8_t>(aRecord[lOffset++]));
+
+    if (!GetUnsigned(aRecord, lOffset, lValue))
+    {
+        goto done;
+    }
+
+    aDelta = Duration(static_cast<Duration::rep>(lValue));
+
+    if (!GetUnsigned(aRecord, lOffset, lValue))
+    {
+        goto done;
+    }
+
+    aEvent.mStateChange = static_cast<StateChange>(lValue);
+
+    if (!GetUnsigned(aRecord, lOffset, lCount) || (lCount > aRecord.size()))
+    {
+        goto done;
+    }
+
+    for (uint64_t lIndex = 0; lIndex < lCount; lIndex++)
+    {
+        if (!GetSigned(aRecord, lOffset, lSigned))
+        {
+            goto done;
+        }
+
+        aEvent.mValues.push_back(static_cast<ValueType>(lSigned));
+    }
+
+    if (!GetUnsigned(aRecord, lOffset, lCount) || (lCount > aRecord.size()))
+    {
+        goto done;
+    }
+
+    for (uint64_t lIndex = 0; lIndex < lCount; lIndex++)
+    {
+        if (!GetUnsigned(aRecord, lOffset, lValue) || (lValue > (aRecord.size() - lOffset)))
+        {
+            goto done;
+        }
+
+        aEvent.mStrings.push_back(aRecord.substr(lOffset, static_cast<size_t>(lValue)));
+
+        lOffset += static_cast<size_t>(lValue);
+    }
+
+    // Anything past the strings was added by a later version of the
+    // format and is skipped.
+
+    lRetval = true;
+
+ done:
+    return (lRetval);
+}
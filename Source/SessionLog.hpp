@@ -0,0 +1,232 @@
+/*
+ *    Copyright (c) 2026 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *  @file
+ *    This file defines objects for writing and reading a compact,
+ *    streamable, append-only binary log of the HLX client controller
+ *    delegations of one or more sessions.
+ *
+ *  This depends only on POSIX and the C++ Standard Library such that
+ *  logs recorded on the target may be read and replayed off of it
+ *  (see Tools/hlxreplay).
+ *
+ */
+
+#ifndef SESSIONLOG_HPP
+#define SESSIONLOG_HPP
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+
+/**
+ *  @brief
+ *    Definitions for a log of HLX client controller delegations.
+ *
+ *  A log starts with a five byte header, the characters "HLXS" and a
+ *  format version, followed by records, each of one event: the start
+ *  of a session or a client controller delegation. Each record is
+ *  its length, as a variable-length unsigned integer, followed by:
+ *
+ *    - The event type, as one byte.
+ *    - The time since the prior record of the session, in
+ *      microseconds, as a variable-length unsigned integer.
+ *    - For a state change, its type; otherwise, zero, as a
+ *      variable-length unsigned integer.
+ *    - The number of values and each value, as a variable-length,
+ *      zigzag-encoded, signed integer.
+ *    - The number of strings and each string, as its length, as a
+ *      variable-length unsigned integer, followed by its bytes.
+ *
+ *  A log may be read while it is being written, a record at a time,
+ *  and sessions are only ever appended to it. Since each record is
+ *  prefixed by its length, a reader may skip records of types it does
+ *  not know, and a record cut short, by the app being suspended or
+ *  killed mid-write, is discarded when the log is next opened for
+ *  writing.
+ *
+ */
+class SessionLog
+{
+public:
+    /**
+     *  The type of an event.
+     *
+     *  These are stored in logs and must never be renumbered.
+     *
+     */
+    enum Type
+    {
+        kTypeSessionStart     = 0,   //!< A session started.
+
+        kTypeWillResolve      = 1,   //!< Strings: host.
+        kTypeIsResolving      = 2,   //!< Strings: host.
+        kTypeDidResolve       = 3,   //!< Strings: host, address.
+        kTypeDidNotResolve    = 4,   //!< Strings: host; values: error.
+
+        kTypeWillConnect      = 5,   //!< Strings: URL; values: timeout (ms).
+        kTypeIsConnecting     = 6,   //!< Strings: URL; values: timeout (ms).
+        kTypeDidConnect       = 7,   //!< Strings: URL.
+        kTypeDidNotConnect    = 8,   //!< Strings: URL; values: error.
+
+        kTypeWillDisconnect   = 9,   //!< Strings: URL.
+        kTypeDidDisconnect    = 10,  //!< Strings: URL; values: error.
+        kTypeDidNotDisconnect = 11,  //!< Strings: URL; values: error.
+
+        kTypeWillRefresh      = 12,  //!< No values.
+        kTypeIsRefreshing     = 13,  //!< Values: percent complete.
+        kTypeDidRefresh       = 14,  //!< No values.
+        kTypeDidNotRefresh    = 15,  //!< Values: error.
+
+        kTypeStateDidChange   = 16,  //!< See StateChange.
+
+        kTypeError            = 17,  //!< Values: error.
+
+        kTypeMax
+    };
+
+    /**
+     *  The type of a state change event, independent of the client
+     *  controller library's own numbering.
+     *
+     *  The first value of each is the identifier of the group, source,
+     *  zone, or equalizer preset it is for; the remainder are as
+     *  noted. Names are the only string.
+     *
+     *  These are stored in logs and must never be renumbered.
+     *
+     */
+    enum StateChange
+    {
+        kStateChangeUnknown               = 0,   //!< Values: the library's type alone.
+
+        kStateChangeEqualizerPresetBand   = 1,   //!< Values: band, level.
+        kStateChangeEqualizerPresetName   = 2,   //!< Strings: name.
+
+        kStateChangeGroupMute             = 3,   //!< Values: mute.
+        kStateChangeGroupName             = 4,   //!< Strings: name.
+        kStateChangeGroupSource           = 5,   //!< Values: each source.
+        kStateChangeGroupVolume           = 6,   //!< Values: level.
+
+        kStateChangeSourceName            = 7,   //!< Strings: name.
+
+        kStateChangeZoneBalance           = 8,   //!< Values: balance.
+        kStateChangeZoneEqualizerBand     = 9,   //!< Values: band, level.
+        kStateChangeZoneEqualizerPreset   = 10,  //!< Values: preset.
+        kStateChangeZoneHighpassCrossover = 11,  //!< Values: frequency.
+        kStateChangeZoneLowpassCrossover  = 12,  //!< Values: frequency.
+        kStateChangeZoneMute              = 13,  //!< Values: mute.
+        kStateChangeZoneName              = 14,  //!< Strings: name.
+        kStateChangeZoneSoundMode         = 15,  //!< Values: sound mode.
+        kStateChangeZoneSource            = 16,  //!< Values: source.
+        kStateChangeZoneTone              = 17,  //!< Values: bass, treble.
+        kStateChangeZoneVolume            = 18,  //!< Values: level.
+
+        kStateChangeMax
+    };
+
+    typedef std::chrono::microseconds  Duration;
+    typedef int32_t                    ValueType;
+    typedef std::vector<ValueType>     Values;
+    typedef std::vector<std::string>   Strings;
+
+    /**
+     *  An event: its type, when it happened, relative to the start of
+     *  its session, and its values and strings, as noted for its
+     *  type.
+     *
+     */
+    struct Event
+    {
+        Event(void);
+
+        void        Clear(void);
+
+        Type         mType;
+        Duration     mTime;
+        StateChange  mStateChange;
+        Values       mValues;
+        Strings      mStrings;
+    };
+
+    static const uint8_t kVersion = 1;
+
+    /**
+     *  @brief
+     *    An object for appending events to a log.
+     *
+     */
+    class Writer
+    {
+    public:
+        Writer(void);
+        ~Writer(void);
+
+        int   Open(const char *aPath);
+        int   Close(void);
+        bool  IsOpen(void) const;
+
+        int   Write(const Event &aEvent);
+        int   Flush(void);
+
+    private:
+        int   Recover(void);
+
+    private:
+        FILE *       mStream;
+        Duration     mLastTime;
+        std::string  mBuffer;
+    };
+
+    /**
+     *  @brief
+     *    An object for reading events from a log, a record at a time.
+     *
+     */
+    class Reader
+    {
+    public:
+        Reader(void);
+        ~Reader(void);
+
+        int   Open(const char *aPath);
+        int   Close(void);
+
+        int   Read(Event &aEvent);
+
+    private:
+        FILE *       mStream;
+        Duration     mTime;
+        std::string  mBuffer;
+    };
+
+public:
+    static const char * GetTypeName(const Type &aType);
+    static const char * GetStateChangeName(const StateChange &aStateChange);
+
+    static void         Encode(const Event &aEvent, const Duration &aDelta, std::string &aRecord);
+    static bool         Decode(const std::string &aRecord, Duration &aDelta, Event &aEvent);
+};
+
+#endif // SESSIONLOG_HPP
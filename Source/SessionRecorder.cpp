@@ -0,0 +1,823 @@
+/*
+ *    Copyright (c) 2026 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *  @file
+ *    This file implements an object for recording the HLX client
+ *    controller delegations of each session to a log while forwarding
+ *    them to a delegate.
+ *
+ */
+
+#include "SessionRecorder.hpp"
+
+#include <vector>
+
+#include <errno.h>
+#include <string.h>
+
+#include <netinet/in.h>
+
+#include <LogUtilities/LogUtilities.hpp>
+
+#include <OpenHLX/Client/EqualizerPresetsStateChangeNotifications.hpp>
+#include <OpenHLX/Client/GroupsStateChangeNotifications.hpp>
+#include <OpenHLX/Client/SourcesStateChangeNotifications.hpp>
+#include <OpenHLX/Client/ZonesStateChangeNotifications.hpp>
+#include <OpenHLX/Model/IdentifierModel.hpp>
+#include <OpenHLX/Utilities/Assert.hpp>
+
+#include "URLString.hpp"
+
+
+using namespace HLX::Client;
+using namespace HLX::Common;
+using namespace Nuovations;
+
+
+/**
+ *  @brief
+ *    This is a class constructor.
+ *
+ */
+SessionRecorder :: SessionRecorder(void) :
+    HLX::Client::Application::ControllerDelegate(),
+    mDelegate(nullptr),
+    mPath(),
+    mWriter(),
+    mEvent(),
+    mStart()
+{
+    return;
+}
+
+/**
+ *  @brief
+ *    This is the class destructor.
+ *
+ */
+SessionRecorder :: ~SessionRecorder(void)
+{
+    Stop();
+
+    return;
+}
+
+/**
+ *  @brief
+ *    This is the class initializer.
+ *
+ *  @param[in]  aPath  A pointer to a null-terminated C string
+ *                     containing the path of the log to append
+ *                     sessions to.
+ *
+ *  @retval  kStatus_Success  If successful.
+ *  @retval  -EINVAL          If the path was null.
+ *
+ */
+Status
+SessionRecorder :: Init(const char *aPath)
+{
+    Status  lRetval = kStatus_Success;
+
+
+    nlREQUIRE_ACTION(aPath != nullptr, done, lRetval = -EINVAL);
+
+    mPath = aPath;
+
+ done:
+    return (lRetval);
+}
+
+// MARK: Delegation
+
+/**
+ *  @brief
+ *    Set the delegate to which all delegations are forwarded.
+ *
+ *  @param[in]  aDelegate  A pointer to the delegate, or null to
+ *                         forward delegations to no delegate.
+ *
+ *  @retval  kStatus_Success  If successful.
+ *
+ */
+Status
+SessionRecorder :: SetDelegate(HLX::Client::Application::ControllerDelegate *aDelegate)
+{
+    mDelegate = aDelegate;
+
+    return (kStatus_Success);
+}
+
+/**
+ *  @brief
+ *    Return the delegate to which all delegations are forwarded.
+ *
+ *  @returns
+ *    A pointer to the delegate, if any; otherwise, null.
+ *
+ */
+HLX::Client::Application::ControllerDelegate *
+SessionRecorder :: GetDelegate(void) const
+{
+    return (mDelegate);
+}
+
+// MARK: Recording
+
+/**
+ *  @brief
+ *    Start recording a new session to the log.
+ *
+ *  @retval  kStatus_Success  If successful.
+ *  @retval  -EBUSY           If already recording.
+ *  @retval  -ENOENT          If the recorder has not been
+ *                            initialized with a log path.
+ *  @retval  -EBADMSG         If the file at the log path is not a log
+ *                            of a version that may be appended to.
+ *  @retval  -errno           If the log could not be opened or
+ *                            written.
+ *
+ */
+Status
+SessionRecorder :: Start(void)
+{
+    Status  lRetval = kStatus_Success;
+
+
+    nlREQUIRE_ACTION(!mWriter.IsOpen(), done, lRetval = -EBUSY);
+    nlREQUIRE_ACTION(!mPath.empty(), done, lRetval = -ENOENT);
+
+    lRetval = mWriter.Open(mPath.c_str());
+    nlREQUIRE_SUCCESS(lRetval, done);
+
+    mStart = Clock::now();
+
+    mEvent.Clear();
+    mEvent.mType = SessionLog::kTypeSessionStart;
+
+    lRetval = mWriter.Write(mEvent);
+    nlREQUIRE_SUCCESS_ACTION(lRetval, done, mWriter.Close());
+
+    Log::Info().Write("Recording session to \"%s\".\n", mPath.c_str());
+
+ done:
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Stop recording, flushing and closing the log.
+ *
+ *  @retval  kStatus_Success  If successful or if not recording.
+ *  @retval  -errno           If the log could not be flushed.
+ *
+ */
+Status
+SessionRecorder :: Stop(void)
+{
+    return (mWriter.Close());
+}
+
+/**
+ *  @brief
+ *    Return whether the recorder is recording.
+ *
+ */
+bool
+SessionRecorder :: IsRecording(void) const
+{
+    return (mWriter.IsOpen());
+}
+
+// MARK: Resolve Delegation Methods
+
+void
+SessionRecorder :: ControllerWillResolve(HLX::Client::Application::Controller &aController, const char *aHost)
+{
+    Record(SessionLog::kTypeWillResolve, aHost);
+
+    if (mDelegate != nullptr)
+    {
+        mDelegate->ControllerWillResolve(aController, aHost);
+    }
+}
+
+void
+SessionRecorder :: ControllerIsResolving(HLX::Client::Application::Controller &aController, const char *aHost)
+{
+    Record(SessionLog::kTypeIsResolving, aHost);
+
+    if (mDelegate != nullptr)
+    {
+        mDelegate->ControllerIsResolving(aController, aHost);
+    }
+}
+
+void
+SessionRecorder :: ControllerDidResolve(HLX::Client::Application::Controller &aController, const char *aHost, const IPAddress &aIPAddress)
+{
+    if (IsRecording())
+    {
+        char  lBuffer[INET6_ADDRSTRLEN];
+
+        mEvent.Clear();
+        mEvent.mType = SessionLog::kTypeDidResolve;
+        mEvent.mStrings.push_back(aHost);
+
+        if (aIPAddress.ToString(lBuffer, sizeof (lBuffer)) == kStatus_Success)
+        {
+            mEvent.mStrings.push_back(lBuffer);
+        }
+
+        Write();
+    }
+
+    if (mDelegate != nullptr)
+    {
+        mDelegate->ControllerDidResolve(aController, aHost, aIPAddress);
+    }
+}
+
+void
+SessionRecorder :: ControllerDidNotResolve(HLX::Client::Application::Controller &aController, const char *aHost, const Error &aError)
+{
+    Record(SessionLog::kTypeDidNotResolve, aHost, aError);
+
+    if (mDelegate != nullptr)
+    {
+        mDelegate->ControllerDidNotResolve(aController, aHost, aError);
+    }
+}
+
+// MARK: Connect Delegation Methods
+
+void
+SessionRecorder :: ControllerWillConnect(HLX::Client::Application::Controller &aController, CFURLRef aURLRef, const Timeout &aTimeout)
+{
+    Record(SessionLog::kTypeWillConnect, aURLRef, static_cast<SessionLog::ValueType>(aTimeout.GetMilliseconds()));
+
+    if (mDelegate != nullptr)
+    {
+        mDelegate->ControllerWillConnect(aController, aURLRef, aTimeout);
+    }
+}
+
+void
+SessionRecorder :: ControllerIsConnecting(HLX::Client::Application::Controller &aController, CFURLRef aURLRef, const Timeout &aTimeout)
+{
+    Record(SessionLog::kTypeIsConnecting, aURLRef, static_cast<SessionLog::ValueType>(aTimeout.GetMilliseconds()));
+
+    if (mDelegate != nullptr)
+    {
+        mDelegate->ControllerIsConnecting(aController, aURLRef, aTimeout);
+    }
+}
+
+void
+SessionRecorder :: ControllerDidConnect(HLX::Client::Application::Controller &aController, CFURLRef aURLRef)
+{
+    Record(SessionLog::kTypeDidConnect, aURLRef);
+
+    if (mDelegate != nullptr)
+    {
+        mDelegate->ControllerDidConnect(aController, aURLRef);
+    }
+}
+
+void
+SessionRecorder :: ControllerDidNotConnect(HLX::Client::Application::Controller &aController, CFURLRef aURLRef, const Error &aError)
+{
+    Record(SessionLog::kTypeDidNotConnect, aURLRef, aError);
+
+    if (mDelegate != nullptr)
+    {
+        mDelegate->ControllerDidNotConnect(aController, aURLRef, aError);
+    }
+}
+
+// MARK: Disconnect Delegation Methods
+
+void
+SessionRecorder :: ControllerWillDisconnect(HLX::Client::Application::Controller &aController, CFURLRef aURLRef)
+{
+    Record(SessionLog::kTypeWillDisconnect, aURLRef);
+
+    if (mDelegate != nullptr)
+    {
+        mDelegate->ControllerWillDisconnect(aController, aURLRef);
+    }
+}
+
+void
+SessionRecorder :: ControllerDidDisconnect(HLX::Client::Application::Controller &aController, CFURLRef aURLRef, const Error &aError)
+{
+    Record(SessionLog::kTypeDidDisconnect, aURLRef, aError);
+
+    if (mDelegate != nullptr)
+    {
+        mDelegate->ControllerDidDisconnect(aController, aURLRef, aError);
+    }
+}
+
+void
+SessionRecorder :: ControllerDidNotDisconnect(HLX::Client::Application::Controller &aController, CFURLRef aURLRef, const Error &aError)
+{
+    Record(SessionLog::kTypeDidNotDisconnect, aURLRef, aError);
+
+    if (mDelegate != nullptr)
+    {
+        mDelegate->ControllerDidNotDisconnect(aController, aURLRef, aError);
+    }
+}
+
+// MARK: Refresh Delegation Methods
+
+void
+SessionRecorder :: ControllerWillRefresh(HLX::Client::Application::ControllerBasis &aController)
+{
+    Record(SessionLog::kTypeWillRefresh);
+
+    if (mDelegate != nullptr)
+    {
+        mDelegate->ControllerWillRefresh(aController);
+    }
+}
+
+void
+SessionRecorder :: ControllerIsRefreshing(HLX::Client::Application::ControllerBasis &aController, const uint8_t &aPercentComplete)
+{
+    Record(SessionLog::kTypeIsRefreshing, aPercentComplete);
+
+    if (mDelegate != nullptr)
+    {
+        mDelegate->ControllerIsRefreshing(aController, aPercentComplete);
+    }
+}
+
+void
+SessionRecorder :: ControllerDidRefresh(HLX::Client::Application::ControllerBasis &aController)
+{
+    Record(SessionLog::kTypeDidRefresh);
+
+    if (mDelegate != nullptr)
+    {
+        mDelegate->ControllerDidRefresh(aController);
+    }
+}
+
+void
+SessionRecorder :: ControllerDidNotRefresh(HLX::Client::Application::ControllerBasis &aController, const Error &aError)
+{
+    Record(SessionLog::kTypeDidNotRefresh, aError);
+
+    if (mDelegate != nullptr)
+    {
+        mDelegate->ControllerDidNotRefresh(aController, aError);
+    }
+}
+
+// MARK: State Change Delegation Method
+
+/**
+ *  @brief
+ *    Delegation from the client controller that the controller
+ *    state has changed in response to a change from the peer
+ *    server controller.
+ *
+ *  The state change is recorded, with its values, before it is
+ *  forwarded, such that its time is that of its arrival rather than
+ *  that of its handling.
+ *
+ *  @param[in]  aController               A reference to the
+ *                                        client controller that
+ *                                        issued the delegation.
+ *  @param[in]  aStateChangeNotification  An immutable reference
+ *                                        to a notification
+ *                                        describing the state
+ *                                        change.
+ *
+ */
+void
+SessionRecorder :: ControllerStateDidChange(HLX::Client::Application::ControllerBasis &aController, const StateChange::NotificationBasis &aStateChangeNotification)
+{
+    if (IsRecording())
+    {
+        mEvent.Clear();
+        mEvent.mType = SessionLog::kTypeStateDidChange;
+
+        if (!Encode(aStateChangeNotification, mEvent))
+        {
+            mEvent.mStateChange = SessionLog::kStateChangeUnknown;
+
+            mEvent.mValues.clear();
+            mEvent.mValues.push_back(static_cast<SessionLog::ValueType>(aStateChangeNotification.GetType()));
+        }
+
+        Write();
+    }
+
+    if (mDelegate != nullptr)
+    {
+        mDelegate->ControllerStateDidChange(aController, aStateChangeNotification);
+    }
+}
+
+// MARK: Error Delegation Method
+
+void
+SessionRecorder :: ControllerError(HLX::Common::Application::ControllerBasis &aController, const Error &aError)
+{
+    Record(SessionLog::kTypeError, aError);
+
+    if (mDelegate != nullptr)
+    {
+        mDelegate->ControllerError(aController, aError);
+    }
+}
+
+// MARK: Workers
+
+void
+SessionRecorder :: Record(const SessionLog::Type &aType)
+{
+    nlEXPECT(IsRecording(), done);
+
+    mEvent.Clear();
+    mEvent.mType = aType;
+
+    Write();
+
+ done:
+    return;
+}
+
+void
+SessionRecorder :: Record(const SessionLog::Type &aType, const SessionLog::ValueType &aValue)
+{
+    nlEXPECT(IsRecording(), done);
+
+    mEvent.Clear();
+    mEvent.mType = aType;
+    mEvent.mValues.push_back(aValue);
+
+    Write();
+
+ done:
+    return;
+}
+
+void
+SessionRecorder :: Record(const SessionLog::Type &aType, const char *aString)
+{
+    nlEXPECT(IsRecording(), done);
+
+    mEvent.Clear();
+    mEvent.mType = aType;
+    mEvent.mStrings.push_back((aString != nullptr) ? aString : "");
+
+    Write();
+
+ done:
+    return;
+}
+
+void
+SessionRecorder :: Record(const SessionLog::Type &aType, const char *aString, const SessionLog::ValueType &aValue)
+{
+    nlEXPECT(IsRecording(), done);
+
+    mEvent.Clear();
+    mEvent.mType = aType;
+    mEvent.mStrings.push_back((aString != nullptr) ? aString : "");
+    mEvent.mValues.push_back(aValue);
+
+    Write();
+
+ done:
+    return;
+}
+
+void
+SessionRecorder :: Record(const SessionLog::Type &aType, CFURLRef aURLRef)
+{
+    nlEXPECT(IsRecording(), done);
+
+    mEvent.Clear();
+    mEvent.mType = aType;
+    mEvent.mStrings.resize(1);
+
+    URLString::Get(aURLRef, mEvent.mStrings[0]);
+
+    Write();
+
+ done:
+    return;
+}
+
+void
+SessionRecorder :: Record(const SessionLog::Type &aType, CFURLRef aURLRef, const SessionLog::ValueType &aValue)
+{
+    nlEXPECT(IsRecording(), done);
+
+    mEvent.Clear();
+    mEvent.mType = aType;
+    mEvent.mStrings.resize(1);
+    mEvent.mValues.push_back(aValue);
+
+    URLString::Get(aURLRef, mEvent.mStrings[0]);
+
+    Write();
+
+ done:
+    return;
+}
+
+/**
+ *  @brief
+ *    Stamp the pending event with the time since the session started
+ *    and append it to the log.
+ *
+ *  Events that end a stretch of activity, a completed or failed
+ *  refresh, the end of a connection, or an error, flush the log,
+ *  such that it is current whenever the app is likely to be idle.
+ *
+ *  Should the log not be writable, for example, with the device out
+ *  of storage, recording stops rather than the failure recurring on
+ *  every event.
+ *
+ */
+void
+SessionRecorder :: Write(void)
+{
+    Status  lStatus;
+
+
+    mEvent.mTime = std::chrono::duration_cast<SessionLog::Duration>(Clock::now() - mStart);
+
+    lStatus = mWriter.Write(mEvent);
+    nlEXPECT_SUCCESS(lStatus, done);
+
+    switch (mEvent.mType)
+    {
+
+    case SessionLog::kTypeDidNotConnect:
+    case SessionLog::kTypeDidDisconnect:
+    case SessionLog::kTypeDidNotDisconnect:
+    case SessionLog::kTypeDidRefresh:
+    case SessionLog::kTypeDidNotRefresh:
+    case SessionLog::kTypeError:
+        lStatus = mWriter.Flush();
+        break;
+
+    default:
+        break;
+
+    }
+
+ done:
+    if (lStatus != kStatus_Success)
+    {
+        Log::Error().Write("Could not record session to \"%s\": %d (%s); recording stopped.\n",
+                           mPath.c_str(), lStatus, strerror(-lStatus));
+
+        mWriter.Close();
+    }
+
+    return;
+}
+
+/**
+ *  @brief
+ *    Encode the type and values of a state change into an event.
+ *
+ *  @param[in]   aStateChangeNotification  An immutable reference to
+ *                                         the state change to
+ *                                         encode.
+ *  @param[out]  aEvent                    A reference to the event
+ *                                         to encode into.
+ *
+ *  @returns
+ *    True if the state change is of a type the log knows; otherwise,
+ *    false.
+ *
+ */
+bool
+SessionRecorder :: Encode(const StateChange::NotificationBasis &aStateChangeNotification, SessionLog::Event &aEvent)
+{
+    SessionLog::Values &  lValues = aEvent.mValues;
+    bool                  lRetval = true;
+
+    switch (aStateChangeNotification.GetType())
+    {
+
+    case StateChange::kStateChangeType_EqualizerPresetBand:
+        {
+            const StateChange::EqualizerPresetsBandNotification &lSCN = static_cast<const StateChange::EqualizerPresetsBandNotification &>(aStateChangeNotification);
+
+            aEvent.mStateChange = SessionLog::kStateChangeEqualizerPresetBand;
+            lValues.push_back(lSCN.GetIdentifier());
+            lValues.push_back(lSCN.GetBand());
+            lValues.push_back(lSCN.GetLevel());
+        }
+        break;
+
+    case StateChange::kStateChangeType_EqualizerPresetName:
+        {
+            const StateChange::EqualizerPresetsNameNotification &lSCN = static_cast<const StateChange::EqualizerPresetsNameNotification &>(aStateChangeNotification);
+
+            aEvent.mStateChange = SessionLog::kStateChangeEqualizerPresetName;
+            lValues.push_back(lSCN.GetIdentifier());
+            aEvent.mStrings.push_back(lSCN.GetName());
+        }
+        break;
+
+    case StateChange::kStateChangeType_GroupMute:
+        {
+            const StateChange::GroupsMuteNotification &lSCN = static_cast<const StateChange::GroupsMuteNotification &>(aStateChangeNotification);
+
+            aEvent.mStateChange = SessionLog::kStateChangeGroupMute;
+            lValues.push_back(lSCN.GetIdentifier());
+            lValues.push_back(lSCN.GetMute());
+        }
+        break;
+
+    case StateChange::kStateChangeType_GroupName:
+        {
+            const StateChange::GroupsNameNotification &lSCN = static_cast<const StateChange::GroupsNameNotification &>(aStateChangeNotification);
+
+            aEvent.mStateChange = SessionLog::kStateChangeGroupName;
+            lValues.push_back(lSCN.GetIdentifier());
+            aEvent.mStrings.push_back(lSCN.GetName());
+        }
+        break;
+
+    case StateChange::kStateChangeType_GroupSource:
+        {
+            const StateChange::GroupsSourceNotification &lSCN = static_cast<const StateChange::GroupsSourceNotification &>(aStateChangeNotification);
+            std::vector<HLX::Model::IdentifierModel::IdentifierType>  lSources;
+            size_t                                                    lCount;
+
+            aEvent.mStateChange = SessionLog::kStateChangeGroupSource;
+            lValues.push_back(lSCN.GetIdentifier());
+
+            if ((lSCN.GetSources().GetCount(lCount) == kStatus_Success) && (lCount > 0))
+            {
+                lSources.resize(lCount);
+
+                if (lSCN.GetSources().GetIdentifiers(&lSources[0], lCount) == kStatus_Success)
+                {
+                    lValues.insert(lValues.end(), lSources.begin(), lSources.begin() + lCount);
+                }
+            }
+        }
+        break;
+
+    case StateChange::kStateChangeType_GroupVolume:
+        {
+            const StateChange::GroupsVolumeNotification &lSCN = static_cast<const StateChange::GroupsVolumeNotification &>(aStateChangeNotification);
+
+            aEvent.mStateChange = SessionLog::kStateChangeGroupVolume;
+            lValues.push_back(lSCN.GetIdentifier());
+            lValues.push_back(lSCN.GetVolume());
+        }
+        break;
+
+    case StateChange::kStateChangeType_SourceName:
+        {
+            const StateChange::SourcesNameNotification &lSCN = static_cast<const StateChange::SourcesNameNotification &>(aStateChangeNotification);
+
+            aEvent.mStateChange = SessionLog::kStateChangeSourceName;
+            lValues.push_back(lSCN.GetIdentifier());
+            aEvent.mStrings.push_back(lSCN.GetName());
+        }
+        break;
+
+    case StateChange::kStateChangeType_ZoneBalance:
+        {
+            const StateChange::ZonesBalanceNotification &lSCN = static_cast<const StateChange::ZonesBalanceNotification &>(aStateChangeNotification);
+
+            aEvent.mStateChange = SessionLog::kStateChangeZoneBalance;
+            lValues.push_back(lSCN.GetIdentifier());
+            lValues.push_back(lSCN.GetBalance());
+        }
+        break;
+
+    case StateChange::kStateChangeType_ZoneEqualizerBand:
+        {
+            const StateChange::ZonesEqualizerBandNotification &lSCN = static_cast<const StateChange::ZonesEqualizerBandNotification &>(aStateChangeNotification);
+
+            aEvent.mStateChange = SessionLog::kStateChangeZoneEqualizerBand;
+            lValues.push_back(lSCN.GetIdentifier());
+            lValues.push_back(lSCN.GetBand());
+            lValues.push_back(lSCN.GetLevel());
+        }
+        break;
+
+    case StateChange::kStateChangeType_ZoneEqualizerPreset:
+        {
+            const StateChange::ZonesEqualizerPresetNotification &lSCN = static_cast<const StateChange::ZonesEqualizerPresetNotification &>(aStateChangeNotification);
+
+            aEvent.mStateChange = SessionLog::kStateChangeZoneEqualizerPreset;
+            lValues.push_back(lSCN.GetIdentifier());
+            lValues.push_back(lSCN.GetEqualizerPreset());
+        }
+        break;
+
+    case StateChange::kStateChangeType_ZoneHighpassCrossover:
+    case StateChange::kStateChangeType_ZoneLowpassCrossover:
+        {
+            const StateChange::ZonesCrossoverNotificationBasis &lSCN = static_cast<const StateChange::ZonesCrossoverNotificationBasis &>(aStateChangeNotification);
+
+            aEvent.mStateChange = ((aStateChangeNotification.GetType() == StateChange::kStateChangeType_ZoneHighpassCrossover) ?
+                                   SessionLog::kStateChangeZoneHighpassCrossover :
+                                   SessionLog::kStateChangeZoneLowpassCrossover);
+            lValues.push_back(lSCN.GetIdentifier());
+            lValues.push_back(lSCN.GetFrequency());
+        }
+        break;
+
+    case StateChange::kStateChangeType_ZoneMute:
+        {
+            const StateChange::ZonesMuteNotification &lSCN = static_cast<const StateChange::ZonesMuteNotification &>(aStateChangeNotification);
+
+            aEvent.mStateChange = SessionLog::kStateChangeZoneMute;
+            lValues.push_back(lSCN.GetIdentifier());
+            lValues.push_back(lSCN.GetMute());
+        }
+        break;
+
+    case StateChange::kStateChangeType_ZoneName:
+        {
+            const StateChange::ZonesNameNotification &lSCN = static_cast<const StateChange::ZonesNameNotification &>(aStateChangeNotification);
+
+            aEvent.mStateChange = SessionLog::kStateChangeZoneName;
+            lValues.push_back(lSCN.GetIdentifier());
+            aEvent.mStrings.push_back(lSCN.GetName());
+        }
+        break;
+
+    case StateChange::kStateChangeType_ZoneSoundMode:
+        {
+            const StateChange::ZonesSoundModeNotification &lSCN = static_cast<const StateChange::ZonesSoundModeNotification &>(aStateChangeNotification);
+
+            aEvent.mStateChange = SessionLog::kStateChangeZoneSoundMode;
+            lValues.push_back(lSCN.GetIdentifier());
+            lValues.push_back(lSCN.GetSoundMode());
+        }
+        break;
+
+    case StateChange::kStateChangeType_ZoneSource:
+        {
+            const StateChange::ZonesSourceNotification &lSCN = static_cast<const StateChange::ZonesSourceNotification &>(aStateChangeNotification);
+
+            aEvent.mStateChange = SessionLog::kStateChangeZoneSource;
+            lValues.push_back(lSCN.GetIdentifier());
+            lValues.push_back(lSCN.GetSource());
+        }
+        break;
+
+    case StateChange::kStateChangeType_ZoneTone:
+        {
+            const StateChange::ZonesToneNotification &lSCN = static_cast<const StateChange::ZonesToneNotification &>(aStateChangeNotification);
+
+            aEvent.mStateChange = SessionLog::kStateChangeZoneTone;
+            lValues.push_back(lSCN.GetIdentifier());
+            lValues.push_back(lSCN.GetBass());
+            lValues.push_back(lSCN.GetTreble());
+        }
+        break;
+
+    case StateChange::kStateChangeType_ZoneVolume:
+        {
+            const StateChange::ZonesVolumeNotification &lSCN = static_cast<const StateChange::ZonesVolumeNotification &>(aStateChangeNotification);
+
+            aEvent.mStateChange = SessionLog::kStateChangeZoneVolume;
+            lValues.push_back(lSCN.GetIdentifier());
+            lValues.push_back(lSCN.GetVolume());
+        }
+        break;
+
+    default:
+        lRetval = false;
+        break;
+
+    }
+
+    return (lRetval);
+}
@@ -0,0 +1,138 @@
+/*
+ *    Copyright (c) 2026 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *  @file
+ *    This file defines an object for recording the HLX client
+ *    controller delegations of each session to a log while forwarding
+ *    them to a delegate.
+ *
+ */
+
+#ifndef SESSIONRECORDER_HPP
+#define SESSIONRECORDER_HPP
+
+#include <chrono>
+#include <string>
+
+#include <stdint.h>
+
+#include <CoreFoundation/CFURL.h>
+
+#include <OpenHLX/Client/ApplicationControllerDelegate.hpp>
+#include <OpenHLX/Common/Errors.hpp>
+#include <OpenHLX/Common/Timeout.hpp>
+
+#include "SessionLog.hpp"
+
+
+/**
+ *  @brief
+ *    An object for recording HLX client controller delegations.
+ *
+ *  The recorder sits between the client controller and its delegate,
+ *  forwarding every delegation on. While recording, each is first
+ *  appended, with the time since the session started, to a log: the
+ *  resolve, connect, disconnect, and refresh progress delegations
+ *  and every state change, with its values, such that the session
+ *  may later be replayed, off of the target and without hardware,
+ *  against the handlers and models that consume it (see
+ *  SessionReplayer and Tools/hlxreplay).
+ *
+ *  Each time recording starts, a new session is appended to the
+ *  log. The log is flushed when a refresh completes or fails, when
+ *  the connection ends, and when recording stops.
+ *
+ */
+class SessionRecorder :
+    public HLX::Client::Application::ControllerDelegate
+{
+public:
+    SessionRecorder(void);
+    virtual ~SessionRecorder(void);
+
+    HLX::Common::Status Init(const char *aPath);
+
+    // Delegation
+
+    HLX::Common::Status SetDelegate(HLX::Client::Application::ControllerDelegate *aDelegate);
+    HLX::Client::Application::ControllerDelegate * GetDelegate(void) const;
+
+    // Recording
+
+    HLX::Common::Status Start(void);
+    HLX::Common::Status Stop(void);
+    bool                IsRecording(void) const;
+
+    // Resolve
+
+    void ControllerWillResolve(HLX::Client::Application::Controller &aController, const char *aHost) final;
+    void ControllerIsResolving(HLX::Client::Application::Controller &aController, const char *aHost) final;
+    void ControllerDidResolve(HLX::Client::Application::Controller &aController, const char *aHost, const HLX::Common::IPAddress &aIPAddress) final;
+    void ControllerDidNotResolve(HLX::Client::Application::Controller &aController, const char *aHost, const HLX::Common::Error &aError) final;
+
+    // Connect
+
+    void ControllerWillConnect(HLX::Client::Application::Controller &aController, CFURLRef aURLRef, const HLX::Common::Timeout &aTimeout) final;
+    void ControllerIsConnecting(HLX::Client::Application::Controller &aController, CFURLRef aURLRef, const HLX::Common::Timeout &aTimeout) final;
+    void ControllerDidConnect(HLX::Client::Application::Controller &aController, CFURLRef aURLRef) final;
+    void ControllerDidNotConnect(HLX::Client::Application::Controller &aController, CFURLRef aURLRef, const HLX::Common::Error &aError) final;
+
+    // Disconnect
+
+    void ControllerWillDisconnect(HLX::Client::Application::Controller &aController, CFURLRef aURLRef) final;
+    void ControllerDidDisconnect(HLX::Client::Application::Controller &aController, CFURLRef aURLRef, const HLX::Common::Error &aError) final;
+    void ControllerDidNotDisconnect(HLX::Client::Application::Controller &aController, CFURLRef aURLRef, const HLX::Common::Error &aError) final;
+
+    // Refresh / Reload
+
+    void ControllerWillRefresh(HLX::Client::Application::ControllerBasis &aController) final;
+    void ControllerIsRefreshing(HLX::Client::Application::ControllerBasis &aController, const uint8_t &aPercentComplete) final;
+    void ControllerDidRefresh(HLX::Client::Application::ControllerBasis &aController) final;
+    void ControllerDidNotRefresh(HLX::Client::Application::ControllerBasis &aController, const HLX::Common::Error &aError) final;
+
+    // State Change
+
+    void ControllerStateDidChange(HLX::Client::Application::ControllerBasis &aController, const HLX::Client::StateChange::NotificationBasis &aStateChangeNotification) final;
+
+    // Error
+
+    void ControllerError(HLX::Common::Application::ControllerBasis &aController, const HLX::Common::Error &aError) final;
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    void        Record(const SessionLog::Type &aType);
+    void        Record(const SessionLog::Type &aType, const SessionLog::ValueType &aValue);
+    void        Record(const SessionLog::Type &aType, const char *aString);
+    void        Record(const SessionLog::Type &aType, const char *aString, const SessionLog::ValueType &aValue);
+    void        Record(const SessionLog::Type &aType, CFURLRef aURLRef);
+    void        Record(const SessionLog::Type &aType, CFURLRef aURLRef, const SessionLog::ValueType &aValue);
+    void        Write(void);
+
+    static bool Encode(const HLX::Client::StateChange::NotificationBasis &aStateChangeNotification, SessionLog::Event &aEvent);
+
+private:
+    HLX::Client::Application::ControllerDelegate *  mDelegate;
+    std::string                                     mPath;
+    SessionLog::Writer                              mWriter;
+    SessionLog::Event                               mEvent;
+    Clock::time_point                               mStart;
+};
+
+#endif // SESSIONRECORDER_HPP
@@ -0,0 +1,406 @@
+/*
+ *    Copyright (c) 2026 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *  @file
+ *    This file implements an object for replaying a log of HLX client
+ *    controller delegations into a delegate.
+ *
+ */
+
+#include "SessionReplayer.hpp"
+
+#include <thread>
+
+#include <errno.h>
+
+
+namespace
+{
+
+typedef std::chrono::steady_clock Clock;
+
+const char *
+GetString(const SessionLog::Event &aEvent, const size_t &aIndex)
+{
+    return ((aIndex < aEvent.mStrings.size()) ? aEvent.mStrings[aIndex].c_str() : "");
+}
+
+SessionLog::ValueType
+GetValue(const SessionLog::Event &aEvent, const size_t &aIndex)
+{
+    return ((aIndex < aEvent.mValues.size()) ? aEvent.mValues[aIndex] : 0);
+}
+
+}; // namespace
+
+// MARK: Delegate
+
+SessionReplayer::Delegate :: ~Delegate(void)
+{
+    return;
+}
+
+void
+SessionReplayer::Delegate :: SessionDidStart(void)
+{
+    return;
+}
+
+void
+SessionReplayer::Delegate :: ControllerWillResolve(const char *)
+{
+    return;
+}
+
+void
+SessionReplayer::Delegate :: ControllerIsResolving(const char *)
+{
+    return;
+}
+
+void
+SessionReplayer::Delegate :: ControllerDidResolve(const char *, const char *)
+{
+    return;
+}
+
+void
+SessionReplayer::Delegate :: ControllerDidNotResolve(const char *, const int &)
+{
+    return;
+}
+
+void
+SessionReplayer::Delegate :: ControllerWillConnect(const char *, const uint32_t &)
+{
+    return;
+}
+
+void
+SessionReplayer::Delegate :: ControllerIsConnecting(const char *, const uint32_t &)
+{
+    return;
+}
+
+void
+SessionReplayer::Delegate :: ControllerDidConnect(const char *)
+{
+    return;
+}
+
+void
+SessionReplayer::Delegate :: ControllerDidNotConnect(const char *, const int &)
+{
+    return;
+}
+
+void
+SessionReplayer::Delegate :: ControllerWillDisconnect(const char *)
+{
+    return;
+}
+
+void
+SessionReplayer::Delegate :: ControllerDidDisconnect(const char *, const int &)
+{
+    return;
+}
+
+void
+SessionReplayer::Delegate :: ControllerDidNotDisconnect(const char *, const int &)
+{
+    return;
+}
+
+void
+SessionReplayer::Delegate :: ControllerWillRefresh(void)
+{
+    return;
+}
+
+void
+SessionReplayer::Delegate :: ControllerIsRefreshing(const uint8_t &)
+{
+    return;
+}
+
+void
+SessionReplayer::Delegate :: ControllerDidRefresh(void)
+{
+    return;
+}
+
+void
+SessionReplayer::Delegate :: ControllerDidNotRefresh(const int &)
+{
+    return;
+}
+
+void
+SessionReplayer::Delegate :: ControllerStateDidChange(const SessionLog::Event &)
+{
+    return;
+}
+
+void
+SessionReplayer::Delegate :: ControllerError(const int &)
+{
+    return;
+}
+
+
+// MARK: Replayer
+
+/**
+ *  @brief
+ *    This is a class constructor.
+ *
+ */
+SessionReplayer :: SessionReplayer(void) :
+    mPace(kPaceFastest),
+    mSpeed(1.0),
+    mCounters()
+{
+    return;
+}
+
+/**
+ *  @brief
+ *    This is the class destructor.
+ *
+ */
+SessionReplayer :: ~SessionReplayer(void)
+{
+    return;
+}
+
+/**
+ *  @brief
+ *    This is the class initializer.
+ *
+ *  @param[in]  aPace   How quickly events are to be replayed.
+ *  @param[in]  aSpeed  For a recorded pace, the factor by which to
+ *                      speed it up, where 1 is as recorded.
+ *
+ *  @retval  0        If successful.
+ *  @retval  -EINVAL  If the pace or speed is not valid.
+ *
+ */
+int
+SessionReplayer :: Init(const Pace &aPace, const double &aSpeed)
+{
+    int lRetval = 0;
+
+    if ((aPace >= kPaceMax) || !(aSpeed > 0.0))
+    {
+        lRetval = -EINVAL;
+        goto done;
+    }
+
+    mPace  = aPace;
+    mSpeed = aSpeed;
+
+    mCounters.mSessions = 0;
+    mCounters.mEvents   = 0;
+    mCounters.mSkipped  = 0;
+
+ done:
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Replay every event from the log into the specified delegate.
+ *
+ *  @param[in]  aReader    A reference to the log reader to replay
+ *                         from.
+ *  @param[in]  aDelegate  A reference to the delegate to replay
+ *                         into.
+ *
+ *  @retval  0         If successful, having replayed every event
+ *                     written to the log.
+ *  @retval  -EBADMSG  If the log has an invalid record.
+ *  @retval  -errno    If the log could not be read.
+ *
+ */
+int
+SessionReplayer :: Replay(SessionLog::Reader &aReader, Delegate &aDelegate)
+{
+    const Clock::time_point  lStart = Clock::now();
+    SessionLog::Event        lEvent;
+    SessionLog::Duration     lBase(0);
+    SessionLog::Duration     lLast(0);
+    int                      lRetval;
+
+    while ((lRetval = aReader.Read(lEvent)) == 0)
+    {
+        // Session times start from zero; replay each session after
+        // the last event of the one before it.
+
+        if (lEvent.mType == SessionLog::kTypeSessionStart)
+        {
+            lBase += lLast;
+
+            mCounters.mSessions++;
+        }
+
+        lLast = lEvent.mTime;
+
+        if (mPace == kPaceRecorded)
+        {
+            const std::chrono::duration<double, std::micro> lOffset((lBase + lEvent.mTime).count() / mSpeed);
+
+            std::this_thread::sleep_until(lStart + std::chrono::duration_cast<Clock::duration>(lOffset));
+        }
+
+        if (Dispatch(lEvent, aDelegate))
+        {
+            mCounters.mEvents++;
+        }
+        else
+        {
+            mCounters.mSkipped++;
+        }
+    }
+
+    // The end of the log, or of what has been written of it so far,
+    // is the end of the replay.
+
+    if ((lRetval == -ENOENT) || (lRetval == -EAGAIN))
+    {
+        lRetval = 0;
+    }
+
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Return the counts of sessions and events replayed and of events
+ *    skipped.
+ *
+ */
+const SessionReplayer::Counters &
+SessionReplayer :: GetCounters(void) const
+{
+    return (mCounters);
+}
+
+/**
+ *  @brief
+ *    Dispatch an event to the corresponding delegate method.
+ *
+ *  @param[in]  aEvent     An immutable reference to the event to
+ *                         dispatch.
+ *  @param[in]  aDelegate  A reference to the delegate to dispatch
+ *                         to.
+ *
+ *  @returns
+ *    True if the event was dispatched; otherwise, false, if it is of
+ *    a type this does not know.
+ *
+ */
+bool
+SessionReplayer :: Dispatch(const SessionLog::Event &aEvent, Delegate &aDelegate)
+{
+    bool lRetval = true;
+
+    switch (aEvent.mType)
+    {
+
+    case SessionLog::kTypeSessionStart:
+        aDelegate.SessionDidStart();
+        break;
+
+    case SessionLog::kTypeWillResolve:
+        aDelegate.ControllerWillResolve(GetString(aEvent, 0));
+        break;
+
+    case SessionLog::kTypeIsResolving:
+        aDelegate.ControllerIsResolving(GetString(aEvent, 0));
+        break;
+
+    case SessionLog::kTypeDidResolve:
+        aDelegate.ControllerDidResolve(GetString(aEvent, 0), GetString(aEvent, 1));
+        break;
+
+    case SessionLog::kTypeDidNotResolve:
+        aDelegate.ControllerDidNotResolve(GetString(aEvent, 0), GetValue(aEvent, 0));
+        break;
+
+    case SessionLog::kTypeWillConnect:
+        aDelegate.ControllerWillConnect(GetString(aEvent, 0), static_cast<uint32_t>(GetValue(aEvent, 0)));
+        break;
+
+    case SessionLog::kTypeIsConnecting:
+        aDelegate.ControllerIsConnecting(GetString(aEvent, 0), static_cast<uint32_t>(GetValue(aEvent, 0)));
+        break;
+
+    case SessionLog::kTypeDidConnect:
+        aDelegate.ControllerDidConnect(GetString(aEvent, 0));
+        break;
+
+    case SessionLog::kTypeDidNotConnect:
+        aDelegate.ControllerDidNotConnect(GetString(aEvent, 0), GetValue(aEvent, 0));
+        break;
+
+    case SessionLog::kTypeWillDisconnect:
+        aDelegate.ControllerWillDisconnect(GetString(aEvent, 0));
+        break;
+
+    case SessionLog::kTypeDidDisconnect:
+        aDelegate.ControllerDidDisconnect(GetString(aEvent, 0), GetValue(aEvent, 0));
+        break;
+
+    case SessionLog::kTypeDidNotDisconnect:
+        aDelegate.ControllerDidNotDisconnect(GetString(aEvent, 0), GetValue(aEvent, 0));
+        break;
+
+    case SessionLog::kTypeWillRefresh:
+        aDelegate.ControllerWillRefresh();
+        break;
+
+    case SessionLog::kTypeIsRefreshing:
+        aDelegate.ControllerIsRefreshing(static_cast<uint8_t>(GetValue(aEvent, 0)));
+        break;
+
+    case SessionLog::kTypeDidRefresh:
+        aDelegate.ControllerDidRefresh();
+        break;
+
+    case SessionLog::kTypeDidNotRefresh:
+        aDelegate.ControllerDidNotRefresh(GetValue(aEvent, 0));
+        break;
+
+    case SessionLog::kTypeStateDidChange:
+        aDelegate.ControllerStateDidChange(aEvent);
+        break;
+
+    case SessionLog::kTypeError:
+        aDelegate.ControllerError(GetValue(aEvent, 0));
+        break;
+
+    default:
+        lRetval = false;
+        break;
+
+    }
+
+    return (lRetval);
+}
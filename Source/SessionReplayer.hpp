@@ -0,0 +1,149 @@
+/*
+ *    Copyright (c) 2026 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *  @file
+ *    This file defines an object for replaying a log of HLX client
+ *    controller delegations into a delegate.
+ *
+ *  This depends only on POSIX and the C++ Standard Library such that
+ *  logs recorded on the target may be replayed off of it (see
+ *  Tools/hlxreplay).
+ *
+ */
+
+#ifndef SESSIONREPLAYER_HPP
+#define SESSIONREPLAYER_HPP
+
+#include <stdint.h>
+
+#include "SessionLog.hpp"
+
+
+/**
+ *  @brief
+ *    An object for replaying a log of HLX client controller
+ *    delegations.
+ *
+ *  Each event read from the log is dispatched to the replay delegate
+ *  method corresponding to the client controller delegate method it
+ *  was recorded from, less the controller itself, which is not
+ *  recorded. Events are replayed either at the pace they were
+ *  recorded, optionally sped up, or as fast as they can be read.
+ *  Consecutive sessions in the log are replayed back to back.
+ *
+ */
+class SessionReplayer
+{
+public:
+    /**
+     *  How quickly events are replayed.
+     *
+     */
+    enum Pace
+    {
+        kPaceRecorded = 0, //!< At the pace recorded, scaled by the speed.
+        kPaceFastest,      //!< As fast as they can be read.
+
+        kPaceMax
+    };
+
+    /**
+     *  @brief
+     *    A delegate for replayed events.
+     *
+     *  Each method does nothing by default, such that a delegate need
+     *  only override those for the events it is interested in.
+     *
+     */
+    class Delegate
+    {
+    public:
+        virtual ~Delegate(void);
+
+        // Session
+
+        virtual void SessionDidStart(void);
+
+        // Resolve
+
+        virtual void ControllerWillResolve(const char *aHost);
+        virtual void ControllerIsResolving(const char *aHost);
+        virtual void ControllerDidResolve(const char *aHost, const char *aAddress);
+        virtual void ControllerDidNotResolve(const char *aHost, const int &aError);
+
+        // Connect
+
+        virtual void ControllerWillConnect(const char *aURL, const uint32_t &aTimeout);
+        virtual void ControllerIsConnecting(const char *aURL, const uint32_t &aTimeout);
+        virtual void ControllerDidConnect(const char *aURL);
+        virtual void ControllerDidNotConnect(const char *aURL, const int &aError);
+
+        // Disconnect
+
+        virtual void ControllerWillDisconnect(const char *aURL);
+        virtual void ControllerDidDisconnect(const char *aURL, const int &aError);
+        virtual void ControllerDidNotDisconnect(const char *aURL, const int &aError);
+
+        // Refresh / Reload
+
+        virtual void ControllerWillRefresh(void);
+        virtual void ControllerIsRefreshing(const uint8_t &aPercentComplete);
+        virtual void ControllerDidRefresh(void);
+        virtual void ControllerDidNotRefresh(const int &aError);
+
+        // State Change
+
+        virtual void ControllerStateDidChange(const SessionLog::Event &aEvent);
+
+        // Error
+
+        virtual void ControllerError(const int &aError);
+    };
+
+    /**
+     *  Counts of the sessions and events replayed and of the events
+     *  skipped, being of a type this does not know.
+     *
+     */
+    struct Counters
+    {
+        uint64_t  mSessions;
+        uint64_t  mEvents;
+        uint64_t  mSkipped;
+    };
+
+public:
+    SessionReplayer(void);
+    ~SessionReplayer(void);
+
+    int               Init(const Pace &aPace, const double &aSpeed);
+
+    int               Replay(SessionLog::Reader &aReader, Delegate &aDelegate);
+
+    const Counters &  GetCounters(void) const;
+
+    static bool       Dispatch(const SessionLog::Event &aEvent, Delegate &aDelegate);
+
+private:
+    Pace      mPace;
+    double    mSpeed;
+    Counters  mCounters;
+};
+
+#endif // SESSIONREPLAYER_HPP
@@ -0,0 +1,369 @@
+/*
+ *    Copyright (c) 2026 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *  @file
+ *    This file implements an object for suspending an HLX client
+ *    controller session when the app is backgrounded and resuming it,
+ *    without a full refresh, when the app returns to the foreground.
+ *
+ */
+
+#include "SessionResumer.hpp"
+
+#include <errno.h>
+
+#include <LogUtilities/LogUtilities.hpp>
+
+#include <OpenHLX/Utilities/Assert.hpp>
+
+
+using namespace HLX::Client;
+using namespace HLX::Common;
+using namespace HLX::Model;
+using namespace Nuovations;
+
+
+const SessionResumer::Duration SessionResumer::kWindowDefault(10 * 60 * 1000);
+
+/**
+ *  @brief
+ *    This is the class default constructor.
+ *
+ */
+SessionResumer :: SessionResumer(void) :
+    mWindow(kWindowDefault),
+    mState(kStateIdle),
+    mURL(),
+    mSuspended()
+{
+    return;
+}
+
+/**
+ *  @brief
+ *    This is the class destructor.
+ *
+ */
+SessionResumer :: ~SessionResumer(void)
+{
+    return;
+}
+
+/**
+ *  @brief
+ *    This is the class initializer.
+ *
+ *  @param[in]  aWindow  The longest a session may be suspended and
+ *                       still be resumed without a full refresh.
+ *
+ *  @retval  kStatus_Success  Unconditionally.
+ *
+ */
+Status
+SessionResumer :: Init(const Duration &aWindow)
+{
+    mWindow = aWindow;
+    mState  = kStateIdle;
+
+    mURL.clear();
+
+    return (kStatus_Success);
+}
+
+SessionResumer::State
+SessionResumer :: GetState(void) const
+{
+    return (mState);
+}
+
+bool
+SessionResumer :: IsSuspended(void) const
+{
+    return (mState == kStateSuspended);
+}
+
+bool
+SessionResumer :: IsResuming(void) const
+{
+    return (mState == kStateResuming);
+}
+
+/**
+ *  @brief
+ *    Return the URL of the session, the one last connected to other
+ *    than to resume a session.
+ *
+ *  @returns
+ *    A pointer to the null-terminated URL, which is empty if none
+ *    has been connected to.
+ *
+ */
+const char *
+SessionResumer :: GetURL(void) const
+{
+    return (mURL.c_str());
+}
+
+/**
+ *  @brief
+ *    Observe a client controller connection, other than one made to
+ *    resume a session, such that the session may later be resumed
+ *    by reconnecting to the same URL.
+ *
+ *  @param[in]  aURL  A pointer to the null-terminated URL connected
+ *                    to.
+ *
+ */
+void
+SessionResumer :: DidConnect(const char *aURL)
+{
+    nlREQUIRE(aURL != nullptr, done);
+    nlEXPECT(mState == kStateIdle, done);
+
+    mURL = aURL;
+
+ done:
+    return;
+}
+
+/**
+ *  @brief
+ *    Suspend the session, disconnecting from the peer.
+ *
+ *  @param[in]  aController  A reference to the connected client
+ *                           controller to suspend.
+ *
+ *  @retval  kStatus_Success  If successful.
+ *  @retval  -EBUSY           If the session was already suspended
+ *                            or resuming.
+ *  @retval  -ENOTCONN        If the client controller was not
+ *                            connected.
+ *
+ */
+Status
+SessionResumer :: Suspend(HLX::Client::Application::Controller &aController)
+{
+    Status  lRetval = kStatus_Success;
+
+
+    nlREQUIRE_ACTION(mState == kStateIdle, done, lRetval = -EBUSY);
+    nlEXPECT_ACTION(aController.IsConnected() && !mURL.empty(), done, lRetval = -ENOTCONN);
+
+    // Enter the suspended state ahead of disconnecting such that the
+    // disconnection is recognized as part of the suspension.
+
+    mState     = kStateSuspended;
+    mSuspended = Clock::now();
+
+    lRetval = aController.Disconnect();
+    nlREQUIRE_ACTION(lRetval == kStatus_Success, done, mState = kStateIdle);
+
+    Log::Info().Write("Suspended session with %s.\n", mURL.c_str());
+
+ done:
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Resume the suspended session, reconnecting to the peer.
+ *
+ *  Once the client controller has reconnected, the caller is expected
+ *  to call #DidResume or, if it did not reconnect, #DidNotResume. The
+ *  same is true if this returns an error from the client controller,
+ *  since it may or may not also have reported the failure through a
+ *  delegation.
+ *
+ *  @param[in]  aController  A reference to the client controller to
+ *                           resume.
+ *
+ *  @retval  kStatus_Success  If successful.
+ *  @retval  -EINVAL          If the session was not suspended.
+ *  @retval  -errno           Any error the client controller returned
+ *                            on connecting.
+ *
+ */
+Status
+SessionResumer :: Resume(HLX::Client::Application::Controller &aController)
+{
+    Status  lRetval = kStatus_Success;
+
+
+    nlREQUIRE_ACTION(mState == kStateSuspended, done, lRetval = -EINVAL);
+
+    mState = kStateResuming;
+
+    Log::Info().Write("Resuming session with %s after %lld ms.\n",
+                      mURL.c_str(),
+                      static_cast<long long>(std::chrono::duration_cast<Duration>(Clock::now() - mSuspended).count()));
+
+    lRetval = aController.Connect(mURL.c_str());
+    nlREQUIRE_SUCCESS(lRetval, done);
+
+ done:
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Complete resuming the session, once the client controller has
+ *    reconnected, by bringing its data model up to date.
+ *
+ *  Within the resume window, only the zones and groups are queried,
+ *  in the background through the command pipeline; outside of it, or
+ *  without a command pipeline, the client controller is fully
+ *  refreshed.
+ *
+ *  @param[in]  aController       A reference to the reconnected
+ *                                client controller.
+ *  @param[in]  aCommandPipeline  A pointer to the command pipeline
+ *                                through which to query the zones,
+ *                                if any.
+ *
+ *  @retval  kStatus_Success  If successful.
+ *  @retval  -EINVAL          If the session was not resuming.
+ *
+ */
+Status
+SessionResumer :: DidResume(HLX::Client::Application::Controller &aController, CommandPipeline *aCommandPipeline)
+{
+    const Duration                   lSuspended = std::chrono::duration_cast<Duration>(Clock::now() - mSuspended);
+    IdentifierModel::IdentifierType  lZonesMax;
+    IdentifierModel::IdentifierType  lGroupsMax;
+    Status                           lRetval = kStatus_Success;
+
+
+    nlREQUIRE_ACTION(mState == kStateResuming, done, lRetval = -EINVAL);
+
+    mState = kStateIdle;
+
+    if ((lSuspended > mWindow) || (aCommandPipeline == nullptr))
+    {
+        Log::Info().Write("Session was suspended for %lld ms; refreshing.\n",
+                          static_cast<long long>(lSuspended.count()));
+
+        lRetval = aController.Refresh();
+        nlREQUIRE_SUCCESS(lRetval, done);
+    }
+    else
+    {
+        lRetval = aController.ZonesGetMax(lZonesMax);
+        nlREQUIRE_SUCCESS(lRetval, done);
+
+        lRetval = aController.GroupsGetMax(lGroupsMax);
+        nlREQUIRE_SUCCESS(lRetval, done);
+
+        Log::Info().Write("Session was suspended for %lld ms; querying %u zones and %u groups.\n",
+                          static_cast<long long>(lSuspended.count()),
+                          lZonesMax,
+                          lGroupsMax);
+
+        // Query the zones first since it is their state that group
+        // volume, mute, and source are derived from.
+
+        lRetval = Query(aController, *aCommandPipeline, CommandPipeline::kKindZone, lZonesMax);
+        nlREQUIRE_SUCCESS(lRetval, done);
+
+        lRetval = Query(aController, *aCommandPipeline, CommandPipeline::kKindGroup, lGroupsMax);
+        nlREQUIRE_SUCCESS(lRetval, done);
+    }
+
+ done:
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Abandon resuming the session, since the client controller did
+ *    not reconnect.
+ *
+ */
+void
+SessionResumer :: DidNotResume(void)
+{
+    if (mState == kStateResuming)
+    {
+        Log::Error().Write("Could not resume session with %s.\n", mURL.c_str());
+
+        mState = kStateIdle;
+    }
+}
+
+// MARK: Implementation
+
+/**
+ *  @brief
+ *    Query each of the groups or zones through the command pipeline.
+ *
+ *  The queries wait in the background lane, behind any user commands.
+ *  The peer answers each query in full; however, the client
+ *  controller reports a state change only for each property that
+ *  differs from its model, which may be none, and nothing at the end
+ *  of the answer. The queries are thus enqueued as queries, which
+ *  the pipeline retires once their answers go quiet, rather than as
+ *  expected to be answered.
+ *
+ *  @param[in]  aController       A reference to the client controller
+ *                                to query.
+ *  @param[in]  aCommandPipeline  A reference to the command pipeline
+ *                                through which to query.
+ *  @param[in]  aKind             The kind of entity, group or zone,
+ *                                to query.
+ *  @param[in]  aMax              The greatest identifier to query.
+ *
+ *  @retval  kStatus_Success  If successful.
+ *
+ */
+Status
+SessionResumer :: Query(HLX::Client::Application::Controller &aController,
+                        CommandPipeline &aCommandPipeline,
+                        const CommandPipeline::Kind &aKind,
+                        const IdentifierModel::IdentifierType &aMax)
+{
+    HLX::Client::Application::Controller * const  lController = &aController;
+    IdentifierModel::IdentifierType                lIdentifier;
+    CommandPipeline::Issuer                        lIssuer;
+    Status                                         lRetval = kStatus_Success;
+
+
+    for (lIdentifier = IdentifierModel::kIdentifierMin; lIdentifier <= aMax; lIdentifier++)
+    {
+        const IdentifierModel::IdentifierType  lQueried = lIdentifier;
+
+        if (aKind == CommandPipeline::kKindGroup)
+        {
+            lIssuer = [lController, lQueried]() { return (lController->GroupQuery(lQueried)); };
+        }
+        else
+        {
+            lIssuer = [lController, lQueried]() { return (lController->ZoneQuery(lQueried)); };
+        }
+
+        lRetval = aCommandPipeline.Enqueue(aKind,
+                                           lQueried,
+                                           CommandPipeline::kAnswerAll,
+                                           CommandScheduler::kLaneBackground,
+                                           CommandPipeline::kResponseQuery,
+                                           lIssuer);
+        nlREQUIRE_SUCCESS(lRetval, done);
+    }
+
+ done:
+    return (lRetval);
+}
@@ -0,0 +1,116 @@
+/*
+ *    Copyright (c) 2026 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *  @file
+ *    This file defines an object for suspending an HLX client
+ *    controller session when the app is backgrounded and resuming it,
+ *    without a full refresh, when the app returns to the foreground.
+ *
+ */
+
+#ifndef SESSIONRESUMER_HPP
+#define SESSIONRESUMER_HPP
+
+#include <chrono>
+#include <string>
+
+#include <OpenHLX/Client/ApplicationController.hpp>
+#include <OpenHLX/Common/Errors.hpp>
+
+#include "CommandPipeline.hpp"
+
+
+/**
+ *  @brief
+ *    An object for suspending and resuming an HLX client controller
+ *    session.
+ *
+ *  Suspending a session disconnects from the peer while keeping the
+ *  client controller data model, and the views rendered from it,
+ *  as they are. Resuming the session reconnects to the same peer
+ *  and, rather than refreshing all of the data model, queries only
+ *  the zones and groups, whose volume, mute, and source are the
+ *  properties most likely to have changed while the session was
+ *  suspended.
+ *
+ *  A session suspended for longer than the resume window is instead
+ *  fully refreshed on reconnection, since less volatile properties,
+ *  such as names, are then also reasonably likely to have changed.
+ *
+ *  While a session is suspended or resuming, the disconnection and
+ *  reconnection are internal to the session and are expected to be
+ *  hidden from the user.
+ *
+ */
+class SessionResumer
+{
+public:
+    /**
+     *  The session state.
+     *
+     */
+    enum State
+    {
+        kStateIdle = 0,  //!< Neither suspended nor resuming.
+        kStateSuspended, //!< Disconnected, awaiting resumption.
+        kStateResuming   //!< Reconnecting.
+    };
+
+    typedef std::chrono::steady_clock Clock;
+    typedef std::chrono::milliseconds Duration;
+
+    /**
+     *  The default longest a session may be suspended and still be
+     *  resumed without a full refresh.
+     *
+     */
+    static const Duration kWindowDefault;
+
+public:
+    SessionResumer(void);
+    ~SessionResumer(void);
+
+    HLX::Common::Status Init(const Duration &aWindow);
+
+    State               GetState(void) const;
+    bool                IsSuspended(void) const;
+    bool                IsResuming(void) const;
+    const char *        GetURL(void) const;
+
+    void                DidConnect(const char *aURL);
+
+    HLX::Common::Status Suspend(HLX::Client::Application::Controller &aController);
+    HLX::Common::Status Resume(HLX::Client::Application::Controller &aController);
+    HLX::Common::Status DidResume(HLX::Client::Application::Controller &aController, CommandPipeline *aCommandPipeline);
+    void                DidNotResume(void);
+
+private:
+    HLX::Common::Status Query(HLX::Client::Application::Controller &aController,
+                              CommandPipeline &aCommandPipeline,
+                              const CommandPipeline::Kind &aKind,
+                              const HLX::Model::IdentifierModel::IdentifierType &aMax);
+
+private:
+    Duration           mWindow;
+    State              mState;
+    std::string        mURL;
+    Clock::time_point  mSuspended;
+};
+
+#endif // SESSIONRESUMER_HPP
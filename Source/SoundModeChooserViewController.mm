@@ -34,6 +34,7 @@
 #include <OpenHLX/Model/SoundModel.hpp>
 #include <OpenHLX/Utilities/Assert.hpp>
 
+#import "AppDelegate.h"
 #import "SoundModeChooserTableViewCell.h"
 #import "UIViewController+HLXClientDidDisconnectDelegateDefaultImplementations.h"
 #import "UIViewController+TopViewController.h"
@@ -115,12 +116,13 @@ indexPathsForSoundMode(const SoundModel::SoundMode &aSoundMode)
 
 - (void) viewWillAppear: (BOOL)aAnimated
 {
-    Status  lStatus;
+    AppDelegate *  lDelegate = [AppDelegate sharedDelegate];
+    Status         lStatus;
 
 
     [super viewWillAppear: aAnimated];
 
-    lStatus = mApplicationController->SetDelegate(mApplicationControllerDelegate.get());
+    lStatus = [lDelegate stateChangeBus].SetDelegate(mApplicationControllerDelegate.get());
     nlREQUIRE_SUCCESS(lStatus, done);
 
 done:
@@ -294,11 +296,13 @@ done:
 
 - (void) tableView: (UITableView *)aTableView didSelectRowAtIndexPath: (NSIndexPath *)aIndexPath
 {
-    const NSUInteger                   lSection = aIndexPath.section;
-    const NSUInteger                   lRow = aIndexPath.row;
-    const SoundModel::SoundMode        lSelectedSoundMode = lRow;
-    ZoneModel::IdentifierType          lZoneIdentifier;
-    Status                             lStatus;
+    AppDelegate *                       lDelegate = [AppDelegate sharedDelegate];
+    MutableApplicationControllerPointer lApplicationController = mApplicationController;
+    const NSUInteger                    lSection = aIndexPath.section;
+    const NSUInteger                    lRow = aIndexPath.row;
+    const SoundModel::SoundMode         lSelectedSoundMode = lRow;
+    ZoneModel::IdentifierType           lZoneIdentifier;
+    Status                              lStatus;
 
 
     // Sanity check to ensure we are not in an out-of-bounds section.
@@ -316,12 +320,22 @@ done:
     // not result in a subsequent notification of the properties
     // associated with that sound mode. Consequently, we must follow
     // up the sound mode set with a query for the same zone to force a
-    // notification of the associated properties.
-
-    lStatus = mApplicationController->ZoneSetSoundMode(lZoneIdentifier, lSelectedSoundMode);
+    // notification of the associated properties. The query is only
+    // verification and waits behind any other user commands.
+
+    lStatus = [lDelegate commandPipeline].Enqueue(CommandPipeline::kKindZone,
+                                                  lZoneIdentifier,
+                                                  CommandPipeline::kAnswerSoundMode,
+                                                  CommandScheduler::kLaneUser,
+                                                  [lApplicationController, lZoneIdentifier, lSelectedSoundMode]() { return (lApplicationController->ZoneSetSoundMode(lZoneIdentifier, lSelectedSoundMode)); });
     nlREQUIRE_SUCCESS(lStatus, done);
 
-    lStatus = mApplicationController->ZoneQuery(lZoneIdentifier);
+    lStatus = [lDelegate commandPipeline].Enqueue(CommandPipeline::kKindZone,
+                                                  lZoneIdentifier,
+                                                  CommandPipeline::kAnswerAll,
+                                                  CommandScheduler::kLaneBackground,
+                                                  CommandPipeline::kResponseQuery,
+                                                  [lApplicationController, lZoneIdentifier]() { return (lApplicationController->ZoneQuery(lZoneIdentifier)); });
     nlREQUIRE_SUCCESS(lStatus, done);
 
  done:
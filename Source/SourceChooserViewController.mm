@@ -40,6 +40,7 @@
 #include <OpenHLX/Model/SourceModel.hpp>
 #include <OpenHLX/Utilities/Assert.hpp>
 
+#import "AppDelegate.h"
 #import "SourceChooserTableViewCell.h"
 #import "UIViewController+HLXClientDidDisconnectDelegateDefaultImplementations.h"
 #import "UIViewController+TopViewController.h"
@@ -155,12 +156,13 @@ indexPathsForIdentifiers(const IdentifiersCollection &aIdentifiers)
 
 - (void) viewWillAppear: (BOOL)aAnimated
 {
-    Status  lStatus;
+    AppDelegate *  lDelegate = [AppDelegate sharedDelegate];
+    Status         lStatus;
 
 
     [super viewWillAppear: aAnimated];
 
-    lStatus = mApplicationController->SetDelegate(mApplicationControllerDelegate.get());
+    lStatus = [lDelegate stateChangeBus].SetDelegate(mApplicationControllerDelegate.get());
     nlREQUIRE_SUCCESS(lStatus, done);
 
 done:
@@ -0,0 +1,192 @@
+/*
+ *    Copyright (c) 2026 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *  @file
+ *    This file implements an object for indexing, by source, the
+ *    groups and zones whose rows render that source's name.
+ *
+ */
+
+#include "SourceRowIndex.hpp"
+
+#include <algorithm>
+
+
+const SourceRowIndex::IdentifierType SourceRowIndex::kSourceNone;
+
+namespace
+{
+
+const SourceRowIndex::Identifiers  sNoRows;
+
+}; // namespace
+
+/**
+ *  @brief
+ *    This is a class constructor.
+ *
+ */
+SourceRowIndex :: SourceRowIndex(void) :
+    mSources(),
+    mRows()
+{
+    return;
+}
+
+/**
+ *  @brief
+ *    This is the class destructor.
+ *
+ */
+SourceRowIndex :: ~SourceRowIndex(void)
+{
+    return;
+}
+
+// MARK: Mutation
+
+/**
+ *  @brief
+ *    Set the source whose name the row for the specified group or
+ *    zone renders.
+ *
+ *  The row is removed from the rows for its prior source, if any,
+ *  and added, in order, to those for its new one.
+ *
+ *  @param[in]  aKind        The kind of entity the row is for.
+ *  @param[in]  aIdentifier  The identifier of the entity the row is
+ *                           for.
+ *  @param[in]  aSource      The identifier of the source the row
+ *                           renders or kSourceNone if it renders
+ *                           none.
+ *
+ *  @returns
+ *    True if the source for the row changed; otherwise, false.
+ *
+ */
+bool
+SourceRowIndex :: SetSource(const Kind &aKind,
+                            const IdentifierType &aIdentifier,
+                            const IdentifierType &aSource)
+{
+    IdentifierType  lPrior;
+    bool            lRetval = false;
+
+    if (aKind >= kKindMax)
+    {
+        goto done;
+    }
+
+    lPrior = GetSource(aKind, aIdentifier);
+
+    if (lPrior == aSource)
+    {
+        goto done;
+    }
+
+    if (lPrior != kSourceNone)
+    {
+        Identifiers &                lRows = mRows[aKind][lPrior];
+        Identifiers::iterator const  lRow  = std::lower_bound(lRows.begin(), lRows.end(), aIdentifier);
+
+        if ((lRow != lRows.end()) && (*lRow == aIdentifier))
+        {
+            lRows.erase(lRow);
+        }
+    }
+
+    if (aSource != kSourceNone)
+    {
+        if (mRows[aKind].size() <= aSource)
+        {
+            mRows[aKind].resize(aSource + 1);
+        }
+
+        {
+            Identifiers &                lRows = mRows[aKind][aSource];
+            Identifiers::iterator const  lRow  = std::lower_bound(lRows.begin(), lRows.end(), aIdentifier);
+
+            lRows.insert(lRow, aIdentifier);
+        }
+    }
+
+    if (mSources[aKind].size() <= aIdentifier)
+    {
+        mSources[aKind].resize(aIdentifier + 1, kSourceNone);
+    }
+
+    mSources[aKind][aIdentifier] = aSource;
+
+    lRetval = true;
+
+ done:
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Remove every row from the index.
+ *
+ */
+void
+SourceRowIndex :: Clear(void)
+{
+    for (size_t lKind = kKindGroup; lKind < kKindMax; lKind++)
+    {
+        mSources[lKind].clear();
+        mRows[lKind].clear();
+    }
+}
+
+// MARK: Introspection
+
+/**
+ *  @brief
+ *    Return the source whose name the row for the specified group or
+ *    zone renders or kSourceNone if it renders none.
+ *
+ *  @param[in]  aKind        The kind of entity the row is for.
+ *  @param[in]  aIdentifier  The identifier of the entity the row is
+ *                           for.
+ *
+ */
+SourceRowIndex::IdentifierType
+SourceRowIndex :: GetSource(const Kind &aKind, const IdentifierType &aIdentifier) const
+{
+    return (((aKind < kKindMax) && (aIdentifier < mSources[aKind].size())) ?
+            mSources[aKind][aIdentifier] :
+            kSourceNone);
+}
+
+/**
+ *  @brief
+ *    Return, in ascending order, the identifiers of the groups or
+ *    zones whose rows render the name of the specified source.
+ *
+ *  @param[in]  aKind    The kind of entity the rows are for.
+ *  @param[in]  aSource  The identifier of the source.
+ *
+ */
+const SourceRowIndex::Identifiers &
+SourceRowIndex :: GetRows(const Kind &aKind, const IdentifierType &aSource) const
+{
+    return (((aKind < kKindMax) && (aSource < mRows[aKind].size())) ?
+            mRows[aKind][aSource] :
+            sNoRows);
+}
@@ -0,0 +1,100 @@
+/*
+ *    Copyright (c) 2026 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *  @file
+ *    This file defines an object for indexing, by source, the groups
+ *    and zones whose rows render that source's name.
+ *
+ *  This depends only on the C++ Standard Library such that it may be
+ *  built off of the target.
+ *
+ */
+
+#ifndef SOURCEROWINDEX_HPP
+#define SOURCEROWINDEX_HPP
+
+#include <vector>
+
+#include <stddef.h>
+#include <stdint.h>
+
+
+/**
+ *  @brief
+ *    An object for indexing group and zone rows by source.
+ *
+ *  A group or zone row renders the name of its source and so must be
+ *  rendered again when that source is renamed; every other row is
+ *  unaffected. The index maps each source to the groups and zones
+ *  whose rows render it, such that a rename reloads only those.
+ *
+ *  The index is maintained incrementally: as a group or zone source
+ *  changes, it is moved from its prior source to its new one. A group
+ *  with more than one source renders no source name and so is
+ *  indexed against no source.
+ *
+ */
+class SourceRowIndex
+{
+public:
+    /**
+     *  The kind of entity a row is for.
+     *
+     */
+    enum Kind
+    {
+        kKindGroup = 0, //!< A group.
+        kKindZone,      //!< A zone.
+
+        kKindMax
+    };
+
+    typedef uint8_t                      IdentifierType;
+    typedef std::vector<IdentifierType>  Identifiers;
+
+    /**
+     *  The source identifier for a row that renders no source name,
+     *  whether because its source is not yet known or because it is
+     *  a group with more than one source.
+     *
+     */
+    static const IdentifierType kSourceNone = 0;
+
+public:
+    SourceRowIndex(void);
+    ~SourceRowIndex(void);
+
+    // Mutation
+
+    bool                  SetSource(const Kind &aKind,
+                                    const IdentifierType &aIdentifier,
+                                    const IdentifierType &aSource);
+    void                  Clear(void);
+
+    // Introspection
+
+    IdentifierType        GetSource(const Kind &aKind, const IdentifierType &aIdentifier) const;
+    const Identifiers &   GetRows(const Kind &aKind, const IdentifierType &aSource) const;
+
+private:
+    Identifiers               mSources[kKindMax];
+    std::vector<Identifiers>  mRows[kKindMax];
+};
+
+#endif // SOURCEROWINDEX_HPP
@@ -0,0 +1,97 @@
+/*
+ *    Copyright (c) 2026 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *  @file
+ *    This file defines a data controller for saving and restoring
+ *    versioned snapshots of the HLX client data model, keyed by the
+ *    same network address, name, or URL location used for the
+ *    connect history.
+ *
+ */
+
+#ifndef STATECACHECONTROLLER_H
+#define STATECACHECONTROLLER_H
+
+#import <Foundation/Foundation.h>
+
+#include <OpenHLX/Client/ApplicationController.hpp>
+
+#import "ApplicationControllerPointer.hpp"
+
+
+// Snapshot Keys
+
+extern NSString * const kStateCacheVersionKey;
+extern NSString * const kStateCacheLocationKey;
+extern NSString * const kStateCacheLastSavedKey;
+extern NSString * const kStateCacheEqualizerPresetsKey;
+extern NSString * const kStateCacheGroupsKey;
+extern NSString * const kStateCacheSourcesKey;
+extern NSString * const kStateCacheZonesKey;
+
+// Snapshot Entity Keys
+
+extern NSString * const kStateCacheNameKey;
+extern NSString * const kStateCacheSourceKey;
+extern NSString * const kStateCacheGroupSourcesKey;
+extern NSString * const kStateCacheVolumeKey;
+extern NSString * const kStateCacheMuteKey;
+extern NSString * const kStateCacheBalanceKey;
+extern NSString * const kStateCacheChannelModeKey;
+extern NSString * const kStateCacheSoundModeKey;
+extern NSString * const kStateCacheEqualizerPresetKey;
+extern NSString * const kStateCacheEqualizerBandsKey;
+extern NSString * const kStateCacheBassKey;
+extern NSString * const kStateCacheTrebleKey;
+extern NSString * const kStateCacheHighpassFrequencyKey;
+extern NSString * const kStateCacheLowpassFrequencyKey;
+
+@interface StateCacheController : NSObject
+
+// MARK: Properties
+
+// MARK: Type Methods
+
++ (StateCacheController *)sharedController;
+
+// MARK: Introspection
+
++ (NSDictionary *) entity: (const HLX::Model::IdentifierModel::IdentifierType &)aIdentifier
+                   forKey: (NSString *)aEntitiesKey
+                  inState: (NSDictionary *)aState;
+
+// MARK: Instance Methods
+
+// MARK: Initialization
+
+- (StateCacheController *)init;
+
+// MARK: Introspection
+
+- (NSDictionary *) stateForLocation: (NSString *)aLocation;
+
+// MARK: Mutation
+
+- (bool) saveStateFromController: (MutableApplicationControllerPointer &)aApplicationController
+                     forLocation: (NSString *)aLocation;
+- (void) removeStateForLocation: (NSString *)aLocation;
+
+@end
+
+#endif // STATECACHECONTROLLER_H
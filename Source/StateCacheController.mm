@@ -0,0 +1,690 @@
+/*
+ *    Copyright (c) 2026 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *  @file
+ *    This file implements a data controller for saving and restoring
+ *    versioned snapshots of the HLX client data model, keyed by the
+ *    same network address, name, or URL location used for the
+ *    connect history.
+ *
+ */
+
+#import "StateCacheController.h"
+
+#include <errno.h>
+
+#include <vector>
+
+#import <Foundation/Foundation.h>
+
+#include <LogUtilities/LogUtilities.hpp>
+
+#include <OpenHLX/Common/Errors.hpp>
+#include <OpenHLX/Model/EqualizerBandsModel.hpp>
+#include <OpenHLX/Model/VolumeModel.hpp>
+#include <OpenHLX/Utilities/Assert.hpp>
+
+
+using namespace HLX::Common;
+using namespace HLX::Model;
+using namespace Nuovations;
+
+
+NSString * const kStateCacheVersionKey            = @"Version";
+NSString * const kStateCacheLocationKey           = @"Location";
+NSString * const kStateCacheLastSavedKey          = @"Last Saved";
+NSString * const kStateCacheEqualizerPresetsKey   = @"Equalizer Presets";
+NSString * const kStateCacheGroupsKey             = @"Groups";
+NSString * const kStateCacheSourcesKey            = @"Sources";
+NSString * const kStateCacheZonesKey              = @"Zones";
+
+NSString * const kStateCacheNameKey               = @"Name";
+NSString * const kStateCacheSourceKey             = @"Source";
+NSString * const kStateCacheGroupSourcesKey       = @"Group Sources";
+NSString * const kStateCacheVolumeKey             = @"Volume";
+NSString * const kStateCacheMuteKey               = @"Mute";
+NSString * const kStateCacheBalanceKey            = @"Balance";
+NSString * const kStateCacheChannelModeKey        = @"Channel Mode";
+NSString * const kStateCacheSoundModeKey          = @"Sound Mode";
+NSString * const kStateCacheEqualizerPresetKey    = @"Equalizer Preset";
+NSString * const kStateCacheEqualizerBandsKey     = @"Equalizer Bands";
+NSString * const kStateCacheBassKey               = @"Bass";
+NSString * const kStateCacheTrebleKey             = @"Treble";
+NSString * const kStateCacheHighpassFrequencyKey  = @"Highpass Frequency";
+NSString * const kStateCacheLowpassFrequencyKey   = @"Lowpass Frequency";
+
+/**
+ *  The snapshot format version. This should be incremented whenever
+ *  the keys or the value types in a snapshot change such that older
+ *  snapshots are ignored rather than misinterpreted.
+ *
+ */
+static const NSInteger  kStateCacheVersion        = 1;
+
+static NSString * const kStateCacheDirectoryName  = @"State Cache";
+static NSString * const kStateCacheFileExtension  = @"plist";
+
+// MARK: Capture Utilities
+
+/**
+ *  @brief
+ *    Capture the equalizer band levels from the specified equalizer
+ *    model.
+ *
+ *  @param[in]  aModel  A reference to the zone or equalizer preset
+ *                      model from which to capture band levels.
+ *
+ *  @returns
+ *    An array of band levels, ordered by band identifier, if every
+ *    band level is known; otherwise, null.
+ *
+ */
+template <typename T>
+static NSArray *
+captureEqualizerBands(const T &aModel)
+{
+    NSMutableArray *                     lBands;
+    EqualizerBandModel::IdentifierType   lIdentifier;
+    NSArray *                            lRetval = nullptr;
+    Status                               lStatus;
+
+
+    lBands = [NSMutableArray arrayWithCapacity: EqualizerBandsModel::kEqualizerBandsMax];
+    nlREQUIRE(lBands != nullptr, done);
+
+    for (lIdentifier = IdentifierModel::kIdentifierMin; lIdentifier <= EqualizerBandsModel::kEqualizerBandsMax; lIdentifier++)
+    {
+        const EqualizerBandModel *     lBand;
+        EqualizerBandModel::LevelType  lLevel;
+
+        lStatus = aModel.GetEqualizerBand(lIdentifier, lBand);
+        nlEXPECT_SUCCESS(lStatus, done);
+
+        lStatus = lBand->GetLevel(lLevel);
+        nlEXPECT_SUCCESS(lStatus, done);
+
+        [lBands addObject: [NSNumber numberWithInt: lLevel]];
+    }
+
+    lRetval = lBands;
+
+ done:
+    return (lRetval);
+}
+
+static NSDictionary *
+captureEqualizerPreset(const EqualizerPresetModel &aEqualizerPreset)
+{
+    NSMutableDictionary *  lRetval = [NSMutableDictionary dictionary];
+    const char *           lName;
+    NSArray *              lBands;
+
+
+    if (aEqualizerPreset.GetName(lName) == kStatus_Success)
+    {
+        [lRetval setObject: [NSString stringWithUTF8String: lName]
+                    forKey: kStateCacheNameKey];
+    }
+
+    lBands = captureEqualizerBands(aEqualizerPreset);
+
+    if (lBands != nullptr)
+    {
+        [lRetval setObject: lBands
+                    forKey: kStateCacheEqualizerBandsKey];
+    }
+
+    return (lRetval);
+}
+
+static NSDictionary *
+captureGroup(const GroupModel &aGroup)
+{
+    NSMutableDictionary *   lRetval = [NSMutableDictionary dictionary];
+    const char *            lName;
+    size_t                  lSourceCount;
+    VolumeModel::LevelType  lVolume;
+    VolumeModel::MuteType   lMute;
+
+
+    if (aGroup.GetName(lName) == kStatus_Success)
+    {
+        [lRetval setObject: [NSString stringWithUTF8String: lName]
+                    forKey: kStateCacheNameKey];
+    }
+
+    if ((aGroup.GetSources(lSourceCount) == kStatus_Success) && (lSourceCount > 0))
+    {
+        std::vector<SourceModel::IdentifierType>  lSources(lSourceCount);
+
+        if (aGroup.GetSources(&lSources[0], lSourceCount) == kStatus_Success)
+        {
+            NSMutableArray *lSourceArray = [NSMutableArray arrayWithCapacity: lSourceCount];
+
+            for (const auto &lSource : lSources)
+            {
+                [lSourceArray addObject: [NSNumber numberWithUnsignedInt: lSource]];
+            }
+
+            [lRetval setObject: lSourceArray
+                        forKey: kStateCacheGroupSourcesKey];
+        }
+    }
+
+    if (aGroup.GetVolume(lVolume) == kStatus_Success)
+    {
+        [lRetval setObject: [NSNumber numberWithInt: lVolume]
+                    forKey: kStateCacheVolumeKey];
+    }
+
+    if (aGroup.GetMute(lMute) == kStatus_Success)
+    {
+        [lRetval setObject: [NSNumber numberWithBool: lMute]
+                    forKey: kStateCacheMuteKey];
+    }
+
+    return (lRetval);
+}
+
+static NSDictionary *
+captureSource(const SourceModel &aSource)
+{
+    NSMutableDictionary *  lRetval = [NSMutableDictionary dictionary];
+    const char *           lName;
+
+
+    if (aSource.GetName(lName) == kStatus_Success)
+    {
+        [lRetval setObject: [NSString stringWithUTF8String: lName]
+                    forKey: kStateCacheNameKey];
+    }
+
+    return (lRetval);
+}
+
+static NSDictionary *
+captureZone(const ZoneModel &aZone)
+{
+    NSMutableDictionary *                 lRetval = [NSMutableDictionary dictionary];
+    const char *                          lName;
+    SourceModel::IdentifierType           lSource;
+    VolumeModel::LevelType                lVolume;
+    VolumeModel::MuteType                 lMute;
+    BalanceModel::BalanceType             lBalance;
+    SoundModel::ChannelMode               lChannelMode;
+    SoundModel::SoundMode                 lSoundMode;
+    EqualizerPresetModel::IdentifierType  lEqualizerPreset;
+    ToneModel::LevelType                  lBass;
+    ToneModel::LevelType                  lTreble;
+    CrossoverModel::FrequencyType         lFrequency;
+    NSArray *                             lBands;
+
+
+    if (aZone.GetName(lName) == kStatus_Success)
+    {
+        [lRetval setObject: [NSString stringWithUTF8String: lName]
+                    forKey: kStateCacheNameKey];
+    }
+
+    if (aZone.GetSource(lSource) == kStatus_Success)
+    {
+        [lRetval setObject: [NSNumber numberWithUnsignedInt: lSource]
+                    forKey: kStateCacheSourceKey];
+    }
+
+    if (aZone.GetVolume(lVolume) == kStatus_Success)
+    {
+        [lRetval setObject: [NSNumber numberWithInt: lVolume]
+                    forKey: kStateCacheVolumeKey];
+    }
+
+    if (aZone.GetMute(lMute) == kStatus_Success)
+    {
+        [lRetval setObject: [NSNumber numberWithBool: lMute]
+                    forKey: kStateCacheMuteKey];
+    }
+
+    if (aZone.GetBalance(lBalance) == kStatus_Success)
+    {
+        [lRetval setObject: [NSNumber numberWithInt: lBalance]
+                    forKey: kStateCacheBalanceKey];
+    }
+
+    if (aZone.GetChannelMode(lChannelMode) == kStatus_Success)
+    {
+        [lRetval setObject: [NSNumber numberWithInt: lChannelMode]
+                    forKey: kStateCacheChannelModeKey];
+    }
+
+    if (aZone.GetSoundMode(lSoundMode) == kStatus_Success)
+    {
+        [lRetval setObject: [NSNumber numberWithInt: lSoundMode]
+                    forKey: kStateCacheSoundModeKey];
+    }
+
+    if (aZone.GetEqualizerPreset(lEqualizerPreset) == kStatus_Success)
+    {
+        [lRetval setObject: [NSNumber numberWithUnsignedInt: lEqualizerPreset]
+                    forKey: kStateCacheEqualizerPresetKey];
+    }
+
+    if (aZone.GetTone(lBass, lTreble) == kStatus_Success)
+    {
+        [lRetval setObject: [NSNumber numberWithInt: lBass]
+                    forKey: kStateCacheBassKey];
+        [lRetval setObject: [NSNumber numberWithInt: lTreble]
+                    forKey: kStateCacheTrebleKey];
+    }
+
+    if (aZone.GetHighpassFrequency(lFrequency) == kStatus_Success)
+    {
+        [lRetval setObject: [NSNumber numberWithUnsignedInt: lFrequency]
+                    forKey: kStateCacheHighpassFrequencyKey];
+    }
+
+    if (aZone.GetLowpassFrequency(lFrequency) == kStatus_Success)
+    {
+        [lRetval setObject: [NSNumber numberWithUnsignedInt: lFrequency]
+                    forKey: kStateCacheLowpassFrequencyKey];
+    }
+
+    lBands = captureEqualizerBands(aZone);
+
+    if (lBands != nullptr)
+    {
+        [lRetval setObject: lBands
+                    forKey: kStateCacheEqualizerBandsKey];
+    }
+
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Capture all of the entities of a particular class from the
+ *    client controller.
+ *
+ *  @param[in]  aMaximum  The maximum identifier of the entity class.
+ *  @param[in]  aGetter   A block that attempts to capture the entity
+ *                        with the specified identifier, returning
+ *                        null if it could not be captured.
+ *
+ *  @returns
+ *    An array of captured entities, ordered by identifier, on
+ *    success; otherwise, null.
+ *
+ */
+static NSArray *
+captureEntities(const IdentifierModel::IdentifierType &aMaximum,
+                NSDictionary *(^aGetter)(const IdentifierModel::IdentifierType &aIdentifier))
+{
+    NSMutableArray *                 lEntities;
+    IdentifierModel::IdentifierType  lIdentifier;
+    NSArray *                        lRetval = nullptr;
+
+
+    lEntities = [NSMutableArray arrayWithCapacity: aMaximum];
+    nlREQUIRE(lEntities != nullptr, done);
+
+    for (lIdentifier = IdentifierModel::kIdentifierMin; lIdentifier <= aMaximum; lIdentifier++)
+    {
+        NSDictionary *lEntity = aGetter(lIdentifier);
+        nlREQUIRE(lEntity != nullptr, done);
+
+        [lEntities addObject: lEntity];
+    }
+
+    lRetval = lEntities;
+
+ done:
+    return (lRetval);
+}
+
+@interface StateCacheController ()
+{
+    NSURL *     mCacheDirectoryURL;
+}
+
+@end
+
+@implementation StateCacheController
+
+// MARK: Type Methods
+
+/**
+ *  @brief
+ *    Return a shared instance of the state cache controller.
+ *
+ *  @returns
+ *    A pointer to the shared instance of the state cache controller,
+ *    if successful; otherwise null.
+ *
+ */
++ (StateCacheController *)sharedController
+{
+    StateCacheController *lRetval = nullptr;
+
+    lRetval = [[self alloc] init];
+    nlREQUIRE(lRetval != nullptr, done);
+
+ done:
+    return (lRetval);
+}
+
+// MARK: Introspection
+
+/**
+ *  @brief
+ *    Return the snapshot of the specified entity.
+ *
+ *  @param[in]  aIdentifier   An immutable reference to the identifier
+ *                            of the group, source, zone, or equalizer
+ *                            preset to return.
+ *  @param[in]  aEntitiesKey  A pointer to the key for the entity
+ *                            class (for example,
+ *                            kStateCacheZonesKey) in @a aState.
+ *  @param[in]  aState        A pointer to the snapshot from which to
+ *                            return the entity.
+ *
+ *  @returns
+ *    A pointer to the entity snapshot, if present; otherwise, null.
+ *
+ */
++ (NSDictionary *) entity: (const IdentifierModel::IdentifierType &)aIdentifier
+                   forKey: (NSString *)aEntitiesKey
+                  inState: (NSDictionary *)aState
+{
+    NSArray *       lEntities;
+    NSDictionary *  lRetval = nullptr;
+
+
+    nlEXPECT(aState != nullptr, done);
+    nlREQUIRE(aIdentifier >= IdentifierModel::kIdentifierMin, done);
+
+    lEntities = [aState objectForKey: aEntitiesKey];
+    nlEXPECT(lEntities != nullptr, done);
+    nlEXPECT(aIdentifier <= [lEntities count], done);
+
+    // HLX identifiers are one rather than zero based; however, the
+    // entity array is zero based.
+
+    lRetval = [lEntities objectAtIndex: (aIdentifier - 1)];
+
+ done:
+    return (lRetval);
+}
+
+// MARK: Utility
+
+/**
+ *  @brief
+ *    Return the snapshot file URL for the specified network
+ *    location.
+ *
+ *  @param[in]  aLocation  A pointer to the string representation of
+ *                         the network address, name, or URL for
+ *                         which to return the snapshot file URL.
+ *
+ *  @returns
+ *    A pointer to the snapshot file URL, if successful; otherwise,
+ *    null.
+ *
+ */
+- (NSURL *) URLForLocation: (NSString *)aLocation
+{
+    NSString *  lFileName;
+    NSURL *     lRetval = nullptr;
+
+
+    nlREQUIRE(mCacheDirectoryURL != nullptr, done);
+    nlREQUIRE(aLocation != nullptr, done);
+
+    // Locations may be URLs and, consequently, may contain path
+    // separators and other characters inappropriate for a file
+    // name. Percent-encode anything that is not alphanumeric.
+
+    lFileName = [aLocation stringByAddingPercentEncodingWithAllowedCharacters: [NSCharacterSet alphanumericCharacterSet]];
+    nlREQUIRE(lFileName != nullptr, done);
+
+    lRetval = [[mCacheDirectoryURL URLByAppendingPathComponent: lFileName] URLByAppendingPathExtension: kStateCacheFileExtension];
+
+ done:
+    return (lRetval);
+}
+
+// MARK: Instance Methods
+
+// MARK: Initialization
+
+/**
+ *  @brief
+ *    Initializes a state cache object.
+ *
+ *  @returns
+ *    An initialized state cache object.
+ *
+ */
+- (StateCacheController *)init
+{
+    NSFileManager *  lFileManager = [NSFileManager defaultManager];
+    NSURL *          lCachesURL;
+    BOOL             lStatus;
+
+
+    lCachesURL = [[lFileManager URLsForDirectory: NSCachesDirectory
+                                       inDomains: NSUserDomainMask] firstObject];
+    nlREQUIRE(lCachesURL != nullptr, done);
+
+    mCacheDirectoryURL = [lCachesURL URLByAppendingPathComponent: kStateCacheDirectoryName
+                                                     isDirectory: YES];
+    nlREQUIRE(mCacheDirectoryURL != nullptr, done);
+
+    lStatus = [lFileManager createDirectoryAtURL: mCacheDirectoryURL
+                     withIntermediateDirectories: YES
+                                      attributes: nullptr
+                                           error: nullptr];
+    nlREQUIRE_ACTION(lStatus == YES, done, mCacheDirectoryURL = nullptr);
+
+done:
+    return (self);
+}
+
+// MARK: Introspection
+
+/**
+ *  @brief
+ *    Return the most-recently saved snapshot for the specified
+ *    network location.
+ *
+ *  This attempts to return the most-recently saved snapshot for the
+ *  specified network location, if any, ignoring any snapshot that was
+ *  saved with a different snapshot format version.
+ *
+ *  @param[in]  aLocation  A pointer to the string representation of
+ *                         the network address, name, or URL for
+ *                         which to return the snapshot.
+ *
+ *  @returns
+ *    A pointer to the snapshot, if present and valid; otherwise,
+ *    null.
+ *
+ */
+- (NSDictionary *) stateForLocation: (NSString *)aLocation
+{
+    NSURL *         lURL;
+    NSDictionary *  lState;
+    NSNumber *      lVersion;
+    NSDictionary *  lRetval = nullptr;
+
+
+    lURL = [self URLForLocation: aLocation];
+    nlREQUIRE(lURL != nullptr, done);
+
+    lState = [NSDictionary dictionaryWithContentsOfURL: lURL];
+    nlEXPECT(lState != nullptr, done);
+
+    lVersion = [lState objectForKey: kStateCacheVersionKey];
+    nlEXPECT(lVersion != nullptr, done);
+    nlEXPECT([lVersion integerValue] == kStateCacheVersion, done);
+
+    nlEXPECT([[lState objectForKey: kStateCacheLocationKey] isEqual: aLocation], done);
+
+    lRetval = lState;
+
+ done:
+    return (lRetval);
+}
+
+// MARK: Mutation
+
+/**
+ *  @brief
+ *    Save a snapshot of the client controller data model for the
+ *    specified network location.
+ *
+ *  This attempts to capture the groups, sources, zones, and
+ *  equalizer presets, including zone tone, equalizer, and crossover
+ *  state, from the client controller and to save them, replacing any
+ *  existing snapshot for the network location.
+ *
+ *  @param[in]  aApplicationController  A reference to a shared
+ *                                      pointer to the HLX client
+ *                                      controller to capture the
+ *                                      data model from.
+ *  @param[in]  aLocation               A pointer to the string
+ *                                      representation of the
+ *                                      network address, name, or URL
+ *                                      to save the snapshot for.
+ *
+ *  @returns
+ *    True if the snapshot was successfully saved; otherwise, false.
+ *
+ */
+- (bool) saveStateFromController: (MutableApplicationControllerPointer &)aApplicationController
+                     forLocation: (NSString *)aLocation
+{
+    MutableApplicationControllerPointer          lApplicationController = aApplicationController;
+    IdentifierModel::IdentifierType              lMaximum;
+    NSArray *                                    lEqualizerPresets;
+    NSArray *                                    lGroups;
+    NSArray *                                    lSources;
+    NSArray *                                    lZones;
+    NSDictionary *                               lState;
+    NSURL *                                      lURL;
+    Status                                       lStatus;
+    bool                                         lRetval = false;
+
+
+    nlREQUIRE(aApplicationController != nullptr, done);
+
+    lURL = [self URLForLocation: aLocation];
+    nlREQUIRE(lURL != nullptr, done);
+
+    lStatus = aApplicationController->EqualizerPresetsGetMax(lMaximum);
+    nlREQUIRE_SUCCESS(lStatus, done);
+
+    lEqualizerPresets = captureEntities(lMaximum, ^NSDictionary *(const IdentifierModel::IdentifierType &aIdentifier) {
+        const EqualizerPresetModel *lEqualizerPreset;
+
+        return ((lApplicationController->EqualizerPresetGet(aIdentifier, lEqualizerPreset) == kStatus_Success) ?
+                captureEqualizerPreset(*lEqualizerPreset) :
+                nullptr);
+    });
+    nlREQUIRE(lEqualizerPresets != nullptr, done);
+
+    lStatus = aApplicationController->GroupsGetMax(lMaximum);
+    nlREQUIRE_SUCCESS(lStatus, done);
+
+    lGroups = captureEntities(lMaximum, ^NSDictionary *(const IdentifierModel::IdentifierType &aIdentifier) {
+        const GroupModel *lGroup;
+
+        return ((lApplicationController->GroupGet(aIdentifier, lGroup) == kStatus_Success) ?
+                captureGroup(*lGroup) :
+                nullptr);
+    });
+    nlREQUIRE(lGroups != nullptr, done);
+
+    lStatus = aApplicationController->SourcesGetMax(lMaximum);
+    nlREQUIRE_SUCCESS(lStatus, done);
+
+    lSources = captureEntities(lMaximum, ^NSDictionary *(const IdentifierModel::IdentifierType &aIdentifier) {
+        const SourceModel *lSource;
+
+        return ((lApplicationController->SourceGet(aIdentifier, lSource) == kStatus_Success) ?
+                captureSource(*lSource) :
+                nullptr);
+    });
+    nlREQUIRE(lSources != nullptr, done);
+
+    lStatus = aApplicationController->ZonesGetMax(lMaximum);
+    nlREQUIRE_SUCCESS(lStatus, done);
+
+    lZones = captureEntities(lMaximum, ^NSDictionary *(const IdentifierModel::IdentifierType &aIdentifier) {
+        const ZoneModel *lZone;
+
+        return ((lApplicationController->ZoneGet(aIdentifier, lZone) == kStatus_Success) ?
+                captureZone(*lZone) :
+                nullptr);
+    });
+    nlREQUIRE(lZones != nullptr, done);
+
+    lState = [NSDictionary dictionaryWithObjectsAndKeys:
+                               [NSNumber numberWithInteger: kStateCacheVersion], kStateCacheVersionKey,
+                               aLocation, kStateCacheLocationKey,
+                               [NSDate date], kStateCacheLastSavedKey,
+                               lEqualizerPresets, kStateCacheEqualizerPresetsKey,
+                               lGroups, kStateCacheGroupsKey,
+                               lSources, kStateCacheSourcesKey,
+                               lZones, kStateCacheZonesKey,
+                               nullptr];
+    nlREQUIRE(lState != nullptr, done);
+
+    lRetval = [lState writeToURL: lURL
+                      atomically: YES];
+    nlREQUIRE(lRetval == true, done);
+
+ done:
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Remove the snapshot for the specified network location.
+ *
+ *  @param[in]  aLocation  A pointer to the string representation of
+ *                         the network address, name, or URL for
+ *                         which to remove the snapshot.
+ *
+ */
+- (void) removeStateForLocation: (NSString *)aLocation
+{
+    NSURL *  lURL;
+
+
+    lURL = [self URLForLocation: aLocation];
+    nlREQUIRE(lURL != nullptr, done);
+
+    [[NSFileManager defaultManager] removeItemAtURL: lURL
+                                              error: nullptr];
+
+ done:
+    return;
+}
+
+@end
@@ -0,0 +1,927 @@
+/*
+ *    Copyright (c) 2026 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *  @file
+ *    This file implements an object for delivering HLX client
+ *    controller state changes to any number of subscribers, by type
+ *    and identifier, while forwarding all delegations to a single,
+ *    swappable delegate.
+ *
+ */
+
+#include "StateChangeBus.hpp"
+
+#include <errno.h>
+#include <string.h>
+
+#include <OpenHLX/Client/EqualizerPresetsStateChangeNotifications.hpp>
+#include <OpenHLX/Client/GroupsStateChangeNotifications.hpp>
+#include <OpenHLX/Client/SourcesStateChangeNotifications.hpp>
+#include <OpenHLX/Client/ZonesStateChangeNotifications.hpp>
+#include <OpenHLX/Utilities/Assert.hpp>
+
+#include "CommandCoalescer.hpp"
+#include "CommandPipeline.hpp"
+#include "PhaseTimingRecorder.hpp"
+#include "RefreshStageTracker.hpp"
+#include "SessionResumer.hpp"
+#include "URLString.hpp"
+#include "VolumeFader.hpp"
+
+
+using namespace HLX::Client;
+using namespace HLX::Common;
+
+
+const StateChangeBus::IdentifierType StateChangeBus::kIdentifierAny;
+const StateChangeBus::Token          StateChangeBus::kTokenInvalid;
+
+/**
+ *  @brief
+ *    This is a class constructor.
+ *
+ */
+StateChangeBus :: StateChangeBus(void) :
+    HLX::Client::Application::ControllerDelegate(),
+    mDelegate(nullptr),
+    mRefreshStageTracker(nullptr),
+    mPhaseTimingRecorder(nullptr),
+    mCommandPipeline(nullptr),
+    mCommandCoalescer(nullptr),
+    mSessionResumer(nullptr),
+    mVolumeFader(nullptr),
+    mRefreshHandler(),
+    mSubscriptions(),
+    mKeys(),
+    mLastToken(kTokenInvalid),
+    mDelivering(0),
+    mCompactPending(false)
+{
+    return;
+}
+
+/**
+ *  @brief
+ *    This is the class destructor.
+ *
+ */
+StateChangeBus :: ~StateChangeBus(void)
+{
+    return;
+}
+
+// MARK: Delegation
+
+/**
+ *  @brief
+ *    Set the delegate to which all delegations are forwarded.
+ *
+ *  @param[in]  aDelegate  A pointer to the delegate, or null to
+ *                         forward delegations to no delegate.
+ *
+ *  @retval  kStatus_Success  If successful.
+ *
+ */
+Status
+StateChangeBus :: SetDelegate(HLX::Client::Application::ControllerDelegate *aDelegate)
+{
+    mDelegate = aDelegate;
+
+    return (kStatus_Success);
+}
+
+/**
+ *  @brief
+ *    Return the delegate to which all delegations are forwarded.
+ *
+ *  @returns
+ *    A pointer to the delegate, if any; otherwise, null.
+ *
+ */
+HLX::Client::Application::ControllerDelegate *
+StateChangeBus :: GetDelegate(void) const
+{
+    return (mDelegate);
+}
+
+// MARK: Subscription
+
+/**
+ *  @brief
+ *    Subscribe a handler to state changes of the specified type and
+ *    for the specified identifier.
+ *
+ *  @param[in]   aType        The state change type to subscribe to.
+ *  @param[in]   aIdentifier  The group, source, zone, or equalizer
+ *                            preset identifier to subscribe to, or
+ *                            #kIdentifierAny for any.
+ *  @param[in]   aHandler     The function to handle each matching
+ *                            state change.
+ *  @param[out]  aToken       A reference to storage for the token
+ *                            with which to unsubscribe.
+ *
+ *  @retval  kStatus_Success  If successful.
+ *  @retval  -EINVAL          If @a aHandler was null.
+ *
+ */
+Status
+StateChangeBus :: Subscribe(const Type &aType,
+                            const IdentifierType &aIdentifier,
+                            const Handler &aHandler,
+                            Token &aToken)
+{
+    const Key     lKey = MakeKey(aType, aIdentifier);
+    Subscription  lSubscription;
+    Status        lRetval = kStatus_Success;
+
+
+    nlREQUIRE_ACTION(aHandler != nullptr, done, lRetval = -EINVAL);
+
+    // Tokens are never reused, short of the counter wrapping, and
+    // never the invalid token.
+
+    do {
+        mLastToken++;
+    } while ((mLastToken == kTokenInvalid) || (mKeys.count(mLastToken) != 0));
+
+    lSubscription.mToken   = mLastToken;
+    lSubscription.mActive  = true;
+    lSubscription.mHandler = aHandler;
+
+    mSubscriptions[lKey].push_back(lSubscription);
+    mKeys[mLastToken] = lKey;
+
+    aToken = mLastToken;
+
+ done:
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Unsubscribe the subscription identified by the specified token.
+ *
+ *  @param[in]  aToken  The token returned when subscribing.
+ *
+ *  @retval  kStatus_Success  If successful.
+ *  @retval  -ENOENT          If @a aToken identifies no subscription.
+ *
+ */
+Status
+StateChangeBus :: Unsubscribe(const Token &aToken)
+{
+    KeysByToken::iterator         lKey;
+    SubscriptionsByKey::iterator  lSubscriptions;
+    Subscriptions::iterator       lSubscription;
+    Status                        lRetval = kStatus_Success;
+
+
+    lKey = mKeys.find(aToken);
+    nlEXPECT_ACTION(lKey != mKeys.end(), done, lRetval = -ENOENT);
+
+    lSubscriptions = mSubscriptions.find(lKey->second);
+    nlREQUIRE_ACTION(lSubscriptions != mSubscriptions.end(), done, lRetval = -ENOENT);
+
+    for (lSubscription = lSubscriptions->second.begin(); lSubscription != lSubscriptions->second.end(); lSubscription++)
+    {
+        if (lSubscription->mToken == aToken)
+        {
+            break;
+        }
+    }
+
+    nlREQUIRE_ACTION(lSubscription != lSubscriptions->second.end(), done, lRetval = -ENOENT);
+
+    // While a state change is being delivered, the subscription may
+    // be the one whose handler is running; deactivate it such that it
+    // is not called again and erase it once delivery completes.
+
+    if (mDelivering > 0)
+    {
+        lSubscription->mActive = false;
+
+        mCompactPending = true;
+    }
+    else
+    {
+        lSubscriptions->second.erase(lSubscription);
+
+        if (lSubscriptions->second.empty())
+        {
+            mSubscriptions.erase(lSubscriptions);
+        }
+    }
+
+    mKeys.erase(lKey);
+
+ done:
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Return the number of subscriptions.
+ *
+ */
+size_t
+StateChangeBus :: GetSubscriptionCount(void) const
+{
+    return (mKeys.size());
+}
+
+// MARK: Observers
+
+/**
+ *  @brief
+ *    Set the refresh stage tracker fed by the bus.
+ *
+ *  Refresh delegations are fed to the tracker before being forwarded
+ *  to the delegate such that, by the time the delegate is notified,
+ *  the tracker reflects the current refresh stage.
+ *
+ *  @param[in]  aRefreshStageTracker  A pointer to the refresh stage
+ *                                    tracker, or null for none.
+ *
+ */
+void
+StateChangeBus :: SetRefreshStageTracker(RefreshStageTracker *aRefreshStageTracker)
+{
+    mRefreshStageTracker = aRefreshStageTracker;
+}
+
+/**
+ *  @brief
+ *    Set the phase timing recorder fed by the bus.
+ *
+ *  @param[in]  aPhaseTimingRecorder  A pointer to the phase timing
+ *                                    recorder, or null for none.
+ *
+ */
+void
+StateChangeBus :: SetPhaseTimingRecorder(PhaseTimingRecorder *aPhaseTimingRecorder)
+{
+    mPhaseTimingRecorder = aPhaseTimingRecorder;
+}
+
+/**
+ *  @brief
+ *    Set the command pipeline fed by the bus.
+ *
+ *  State changes are fed to the pipeline, to match them to in-flight
+ *  requests, before being forwarded to the delegate such that, by
+ *  the time the delegate is notified, there is room in the pipeline
+ *  for any follow-on requests.
+ *
+ *  @param[in]  aCommandPipeline  A pointer to the command pipeline,
+ *                                or null for none.
+ *
+ */
+void
+StateChangeBus :: SetCommandPipeline(CommandPipeline *aCommandPipeline)
+{
+    mCommandPipeline = aCommandPipeline;
+}
+
+/**
+ *  @brief
+ *    Set the command coalescer fed by the bus.
+ *
+ *  State changes are fed to the coalescer, to answer in-flight
+ *  commands and send those waiting behind them, before being
+ *  forwarded to the delegate.
+ *
+ *  @param[in]  aCommandCoalescer  A pointer to the command coalescer,
+ *                                 or null for none.
+ *
+ */
+void
+StateChangeBus :: SetCommandCoalescer(CommandCoalescer *aCommandCoalescer)
+{
+    mCommandCoalescer = aCommandCoalescer;
+}
+
+/**
+ *  @brief
+ *    Set the session resumer consulted by the bus.
+ *
+ *  While a session is suspended, disconnect delegations are not
+ *  forwarded to the delegate and, while it is resuming, neither are
+ *  resolve and connect delegations.
+ *
+ *  @param[in]  aSessionResumer  A pointer to the session resumer, or
+ *                               null to forward all delegations.
+ *
+ */
+void
+StateChangeBus :: SetSessionResumer(SessionResumer *aSessionResumer)
+{
+    mSessionResumer = aSessionResumer;
+}
+
+/**
+ *  @brief
+ *    Set the volume fader stopped by the bus on disconnect.
+ *
+ *  @param[in]  aVolumeFader  A pointer to the volume fader, or null
+ *                            for none.
+ *
+ */
+void
+StateChangeBus :: SetVolumeFader(VolumeFader *aVolumeFader)
+{
+    mVolumeFader = aVolumeFader;
+}
+
+/**
+ *  @brief
+ *    Set the function that is told, ahead of the delegate, of each
+ *    client controller refresh that completes.
+ *
+ *  @param[in]  aRefreshHandler  The refresh handler, or an empty
+ *                               function for none.
+ *
+ */
+void
+StateChangeBus :: SetRefreshHandler(const RefreshHandler &aRefreshHandler)
+{
+    mRefreshHandler = aRefreshHandler;
+}
+
+// MARK: Session
+
+/**
+ *  @brief
+ *    Resume the suspended session, reconnecting the client
+ *    controller to the peer.
+ *
+ *  To the delegate, which never saw the session suspended, a session
+ *  that could not even begin reconnecting was simply disconnected.
+ *
+ *  @param[in]  aController  A reference to the client controller to
+ *                           resume.
+ *
+ *  @retval  kStatus_Success  If successful.
+ *  @retval  -EINVAL          If there is no session resumer or the
+ *                            session was not suspended.
+ *
+ *  @sa SessionResumer::Resume
+ *
+ */
+Status
+StateChangeBus :: ResumeSession(HLX::Client::Application::Controller &aController)
+{
+    Status  lRetval = kStatus_Success;
+
+
+    nlREQUIRE_ACTION(IsSessionSuspended(), done, lRetval = -EINVAL);
+
+    lRetval = mSessionResumer->Resume(aController);
+
+    // The client controller may already have reported the failure,
+    // and the session not resumed, through a delegation.
+
+    if ((lRetval != kStatus_Success) && IsSessionResuming())
+    {
+        SessionDidNotResume(aController, lRetval);
+    }
+
+ done:
+    return (lRetval);
+}
+
+// MARK: Resolve Delegation Methods
+
+void
+StateChangeBus :: ControllerWillResolve(HLX::Client::Application::Controller &aController, const char *aHost)
+{
+    if (mPhaseTimingRecorder != nullptr)
+    {
+        mPhaseTimingRecorder->WillResolve();
+    }
+
+    if (!IsSessionResuming() && (mDelegate != nullptr))
+    {
+        mDelegate->ControllerWillResolve(aController, aHost);
+    }
+}
+
+void
+StateChangeBus :: ControllerIsResolving(HLX::Client::Application::Controller &aController, const char *aHost)
+{
+    if (!IsSessionResuming() && (mDelegate != nullptr))
+    {
+        mDelegate->ControllerIsResolving(aController, aHost);
+    }
+}
+
+void
+StateChangeBus :: ControllerDidResolve(HLX::Client::Application::Controller &aController, const char *aHost, const IPAddress &aIPAddress)
+{
+    if (mPhaseTimingRecorder != nullptr)
+    {
+        mPhaseTimingRecorder->DidResolve();
+    }
+
+    if (!IsSessionResuming() && (mDelegate != nullptr))
+    {
+        mDelegate->ControllerDidResolve(aController, aHost, aIPAddress);
+    }
+}
+
+void
+StateChangeBus :: ControllerDidNotResolve(HLX::Client::Application::Controller &aController, const char *aHost, const Error &aError)
+{
+    if (IsSessionResuming())
+    {
+        SessionDidNotResume(aController, aError);
+    }
+    else if (mDelegate != nullptr)
+    {
+        mDelegate->ControllerDidNotResolve(aController, aHost, aError);
+    }
+}
+
+// MARK: Connect Delegation Methods
+
+void
+StateChangeBus :: ControllerWillConnect(HLX::Client::Application::Controller &aController, CFURLRef aURLRef, const Timeout &aTimeout)
+{
+    if (mPhaseTimingRecorder != nullptr)
+    {
+        mPhaseTimingRecorder->WillConnect();
+    }
+
+    if (!IsSessionResuming() && (mDelegate != nullptr))
+    {
+        mDelegate->ControllerWillConnect(aController, aURLRef, aTimeout);
+    }
+}
+
+void
+StateChangeBus :: ControllerIsConnecting(HLX::Client::Application::Controller &aController, CFURLRef aURLRef, const Timeout &aTimeout)
+{
+    if (!IsSessionResuming() && (mDelegate != nullptr))
+    {
+        mDelegate->ControllerIsConnecting(aController, aURLRef, aTimeout);
+    }
+}
+
+void
+StateChangeBus :: ControllerDidConnect(HLX::Client::Application::Controller &aController, CFURLRef aURLRef)
+{
+    char  lURL[URLString::kLengthMax];
+
+
+    if (mPhaseTimingRecorder != nullptr)
+    {
+        mPhaseTimingRecorder->DidConnect();
+    }
+
+    // A connection that resumes a session completes the resumption
+    // and is otherwise hidden from the delegate; any other is
+    // remembered such that its session may later be resumed.
+
+    if (IsSessionResuming())
+    {
+        mSessionResumer->DidResume(aController, mCommandPipeline);
+    }
+    else
+    {
+        if ((mSessionResumer != nullptr) && URLString::Get(aURLRef, lURL, sizeof (lURL)))
+        {
+            mSessionResumer->DidConnect(lURL);
+        }
+
+        if (mDelegate != nullptr)
+        {
+            mDelegate->ControllerDidConnect(aController, aURLRef);
+        }
+    }
+}
+
+void
+StateChangeBus :: ControllerDidNotConnect(HLX::Client::Application::Controller &aController, CFURLRef aURLRef, const Error &aError)
+{
+    if (IsSessionResuming())
+    {
+        SessionDidNotResume(aController, aError);
+    }
+    else if (mDelegate != nullptr)
+    {
+        mDelegate->ControllerDidNotConnect(aController, aURLRef, aError);
+    }
+}
+
+// MARK: Disconnect Delegation Methods
+
+void
+StateChangeBus :: ControllerWillDisconnect(HLX::Client::Application::Controller &aController, CFURLRef aURLRef)
+{
+    if (!IsSessionSuspended() && (mDelegate != nullptr))
+    {
+        mDelegate->ControllerWillDisconnect(aController, aURLRef);
+    }
+}
+
+void
+StateChangeBus :: ControllerDidDisconnect(HLX::Client::Application::Controller &aController, CFURLRef aURLRef, const Error &aError)
+{
+    // Nothing in flight will be responded to on this connection.
+
+    if (mCommandPipeline != nullptr)
+    {
+        mCommandPipeline->Clear();
+    }
+
+    if (mCommandCoalescer != nullptr)
+    {
+        mCommandCoalescer->Clear();
+    }
+
+    if (mVolumeFader != nullptr)
+    {
+        mVolumeFader->Clear();
+    }
+
+    if (!IsSessionSuspended() && (mDelegate != nullptr))
+    {
+        mDelegate->ControllerDidDisconnect(aController, aURLRef, aError);
+    }
+}
+
+void
+StateChangeBus :: ControllerDidNotDisconnect(HLX::Client::Application::Controller &aController, CFURLRef aURLRef, const Error &aError)
+{
+    if (mDelegate != nullptr)
+    {
+        mDelegate->ControllerDidNotDisconnect(aController, aURLRef, aError);
+    }
+}
+
+// MARK: Refresh Delegation Methods
+
+void
+StateChangeBus :: ControllerWillRefresh(HLX::Client::Application::ControllerBasis &aController)
+{
+    if (mRefreshStageTracker != nullptr)
+    {
+        mRefreshStageTracker->WillRefresh();
+    }
+
+    if (mPhaseTimingRecorder != nullptr)
+    {
+        mPhaseTimingRecorder->WillRefresh();
+    }
+
+    if (mDelegate != nullptr)
+    {
+        mDelegate->ControllerWillRefresh(aController);
+    }
+}
+
+void
+StateChangeBus :: ControllerIsRefreshing(HLX::Client::Application::ControllerBasis &aController, const uint8_t &aPercentComplete)
+{
+    if (mDelegate != nullptr)
+    {
+        mDelegate->ControllerIsRefreshing(aController, aPercentComplete);
+    }
+}
+
+void
+StateChangeBus :: ControllerDidRefresh(HLX::Client::Application::ControllerBasis &aController)
+{
+    RefreshStageTracker::Duration  lTimeToUsable;
+    Status                         lStatus;
+
+
+    if (mRefreshStageTracker != nullptr)
+    {
+        mRefreshStageTracker->DidRefresh();
+    }
+
+    if (mPhaseTimingRecorder != nullptr)
+    {
+        if (mRefreshStageTracker != nullptr)
+        {
+            lStatus = mRefreshStageTracker->GetTimeToUsable(lTimeToUsable);
+
+            if (lStatus == kStatus_Success)
+            {
+                mPhaseTimingRecorder->Record(PhaseTimingRecorder::kPhaseRefreshUsable, lTimeToUsable);
+            }
+        }
+
+        mPhaseTimingRecorder->DidRefresh();
+    }
+
+    if (mRefreshHandler != nullptr)
+    {
+        mRefreshHandler(aController);
+    }
+
+    if (mDelegate != nullptr)
+    {
+        mDelegate->ControllerDidRefresh(aController);
+    }
+}
+
+void
+StateChangeBus :: ControllerDidNotRefresh(HLX::Client::Application::ControllerBasis &aController, const Error &aError)
+{
+    if (mRefreshStageTracker != nullptr)
+    {
+        mRefreshStageTracker->DidNotRefresh();
+    }
+
+    if (mDelegate != nullptr)
+    {
+        mDelegate->ControllerDidNotRefresh(aController, aError);
+    }
+}
+
+// MARK: State Change Delegation Method
+
+/**
+ *  @brief
+ *    Delegation from the client controller that the controller
+ *    state has changed in response to a change from the peer
+ *    server controller.
+ *
+ *  The state change is fed to the observers first, such that the
+ *  command pipeline and coalescer bookkeeping is current by the time
+ *  the delegate and subscribers are called, then forwarded to the
+ *  delegate, and then delivered to the subscribers for any
+ *  identifier and, where the state change has one, to those for its
+ *  identifier.
+ *
+ *  @param[in]  aController               A reference to the
+ *                                        client controller that
+ *                                        issued the delegation.
+ *  @param[in]  aStateChangeNotification  An immutable reference
+ *                                        to a notification
+ *                                        describing the state
+ *                                        change.
+ *
+ */
+void
+StateChangeBus :: ControllerStateDidChange(HLX::Client::Application::ControllerBasis &aController, const StateChange::NotificationBasis &aStateChangeNotification)
+{
+    const Type      lType = aStateChangeNotification.GetType();
+    IdentifierType  lIdentifier;
+
+
+    if (mRefreshStageTracker != nullptr)
+    {
+        mRefreshStageTracker->StateDidChange(aStateChangeNotification);
+    }
+
+    if (mPhaseTimingRecorder != nullptr)
+    {
+        mPhaseTimingRecorder->StateDidChange(aStateChangeNotification);
+    }
+
+    if (mCommandPipeline != nullptr)
+    {
+        mCommandPipeline->StateDidChange(aStateChangeNotification);
+    }
+
+    if (mCommandCoalescer != nullptr)
+    {
+        mCommandCoalescer->StateDidChange(aStateChangeNotification);
+    }
+
+    if (mDelegate != nullptr)
+    {
+        mDelegate->ControllerStateDidChange(aController, aStateChangeNotification);
+    }
+
+    nlEXPECT(!mSubscriptions.empty(), done);
+
+    Deliver(MakeKey(lType, kIdentifierAny), aStateChangeNotification);
+
+    if (GetIdentifier(aStateChangeNotification, lIdentifier))
+    {
+        Deliver(MakeKey(lType, lIdentifier), aStateChangeNotification);
+    }
+
+ done:
+    return;
+}
+
+// MARK: Error Delegation Method
+
+void
+StateChangeBus :: ControllerError(HLX::Common::Application::ControllerBasis &aController, const Error &aError)
+{
+    if (mDelegate != nullptr)
+    {
+        mDelegate->ControllerError(aController, aError);
+    }
+}
+
+// MARK: Workers
+
+StateChangeBus::Key
+StateChangeBus :: MakeKey(const Type &aType, const IdentifierType &aIdentifier)
+{
+    return ((static_cast<Key>(aType) << 8) | static_cast<Key>(aIdentifier));
+}
+
+/**
+ *  @brief
+ *    Get the group, source, zone, or equalizer preset identifier, if
+ *    any, a state change is for.
+ *
+ *  @returns
+ *    True if the state change has an identifier; otherwise, false.
+ *
+ */
+bool
+StateChangeBus :: GetIdentifier(const StateChange::NotificationBasis &aStateChangeNotification, IdentifierType &aIdentifier)
+{
+    bool lRetval = true;
+
+    switch (aStateChangeNotification.GetType())
+    {
+
+    case StateChange::kStateChangeType_EqualizerPresetBand:
+    case StateChange::kStateChangeType_EqualizerPresetName:
+        aIdentifier = static_cast<const StateChange::EqualizerPresetsNotificationBasis &>(aStateChangeNotification).GetIdentifier();
+        break;
+
+    case StateChange::kStateChangeType_GroupMute:
+    case StateChange::kStateChangeType_GroupName:
+    case StateChange::kStateChangeType_GroupSource:
+    case StateChange::kStateChangeType_GroupVolume:
+        aIdentifier = static_cast<const StateChange::GroupsNotificationBasis &>(aStateChangeNotification).GetIdentifier();
+        break;
+
+    case StateChange::kStateChangeType_SourceName:
+        aIdentifier = static_cast<const StateChange::SourcesNameNotification &>(aStateChangeNotification).GetIdentifier();
+        break;
+
+    case StateChange::kStateChangeType_ZoneBalance:
+    case StateChange::kStateChangeType_ZoneEqualizerBand:
+    case StateChange::kStateChangeType_ZoneEqualizerPreset:
+    case StateChange::kStateChangeType_ZoneHighpassCrossover:
+    case StateChange::kStateChangeType_ZoneLowpassCrossover:
+    case StateChange::kStateChangeType_ZoneMute:
+    case StateChange::kStateChangeType_ZoneName:
+    case StateChange::kStateChangeType_ZoneSoundMode:
+    case StateChange::kStateChangeType_ZoneSource:
+    case StateChange::kStateChangeType_ZoneTone:
+    case StateChange::kStateChangeType_ZoneVolume:
+        aIdentifier = static_cast<const StateChange::ZonesNotificationBasis &>(aStateChangeNotification).GetIdentifier();
+        break;
+
+    default:
+        lRetval = false;
+        break;
+
+    }
+
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Deliver a state change to the handlers subscribed under the
+ *    specified key.
+ *
+ *  Only those subscriptions present when delivery starts are called;
+ *  any a handler adds are appended to the list and not reached and
+ *  any a handler removes are deactivated rather than erased, such that
+ *  the list may be walked safely while handlers run.
+ *
+ */
+void
+StateChangeBus :: Deliver(const Key &aKey, const StateChange::NotificationBasis &aStateChangeNotification)
+{
+    SubscriptionsByKey::iterator  lSubscriptions;
+    Subscriptions::iterator       lSubscription;
+    size_t                        lRemaining;
+
+
+    lSubscriptions = mSubscriptions.find(aKey);
+    nlEXPECT(lSubscriptions != mSubscriptions.end(), done);
+
+    lSubscription = lSubscriptions->second.begin();
+    lRemaining    = lSubscriptions->second.size();
+
+    mDelivering++;
+
+    while (lRemaining > 0)
+    {
+        if (lSubscription->mActive)
+        {
+            lSubscription->mHandler(aStateChangeNotification);
+        }
+
+        lSubscription++;
+        lRemaining--;
+    }
+
+    mDelivering--;
+
+    if ((mDelivering == 0) && mCompactPending)
+    {
+        Compact();
+    }
+
+ done:
+    return;
+}
+
+/**
+ *  @brief
+ *    Erase the subscriptions unsubscribed while a state change was
+ *    being delivered.
+ *
+ */
+void
+StateChangeBus :: Compact(void)
+{
+    SubscriptionsByKey::iterator  lSubscriptions = mSubscriptions.begin();
+
+    while (lSubscriptions != mSubscriptions.end())
+    {
+        lSubscriptions->second.remove_if([](const Subscription &aSubscription) { return (!aSubscription.mActive); });
+
+        if (lSubscriptions->second.empty())
+        {
+            lSubscriptions = mSubscriptions.erase(lSubscriptions);
+        }
+        else
+        {
+            lSubscriptions++;
+        }
+    }
+
+    mCompactPending = false;
+}
+
+/**
+ *  @brief
+ *    Abandon resuming the session, reporting it, to the delegate, as
+ *    disconnected.
+ *
+ *  To the delegate, which never saw the session suspended, a session
+ *  that could not be resumed was simply disconnected, whether it
+ *  failed to resolve or to connect.
+ *
+ *  @param[in]  aController  A reference to the client controller
+ *                           that did not resume.
+ *  @param[in]  aError       The error that prevented resumption.
+ *
+ */
+void
+StateChangeBus :: SessionDidNotResume(HLX::Client::Application::Controller &aController, const Error &aError)
+{
+    CFURLRef  lURLRef;
+
+
+    mSessionResumer->DidNotResume();
+
+    nlEXPECT(mDelegate != nullptr, done);
+
+    lURLRef = URLString::Create(mSessionResumer->GetURL());
+
+    mDelegate->ControllerDidDisconnect(aController, lURLRef, aError);
+
+    if (lURLRef != nullptr)
+    {
+        CFRelease(lURLRef);
+    }
+
+ done:
+    return;
+}
+
+bool
+StateChangeBus :: IsSessionSuspended(void) const
+{
+    return ((mSessionResumer != nullptr) && mSessionResumer->IsSuspended());
+}
+
+bool
+StateChangeBus :: IsSessionResuming(void) const
+{
+    return ((mSessionResumer != nullptr) && mSessionResumer->IsResuming());
+}
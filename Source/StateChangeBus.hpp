@@ -0,0 +1,239 @@
+/*
+ *    Copyright (c) 2026 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *  @file
+ *    This file defines an object for delivering HLX client
+ *    controller state changes to any number of subscribers, by type
+ *    and identifier, while forwarding all delegations to a single,
+ *    swappable delegate.
+ *
+ */
+
+#ifndef STATECHANGEBUS_HPP
+#define STATECHANGEBUS_HPP
+
+#include <functional>
+#include <list>
+#include <unordered_map>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <CoreFoundation/CFURL.h>
+
+#include <OpenHLX/Client/ApplicationControllerDelegate.hpp>
+#include <OpenHLX/Common/Errors.hpp>
+#include <OpenHLX/Common/Timeout.hpp>
+#include <OpenHLX/Model/IdentifierModel.hpp>
+
+
+class CommandCoalescer;
+class CommandPipeline;
+class PhaseTimingRecorder;
+class RefreshStageTracker;
+class SessionResumer;
+class VolumeFader;
+
+/**
+ *  @brief
+ *    An object for subscribing to HLX client controller state
+ *    changes.
+ *
+ *  The bus is the client controller delegate for the life of the
+ *  app. It forwards every delegation to a delegate, typically that of
+ *  whichever view is showing, which may be swapped, or cleared, at
+ *  any time, as views come and go, without the client controller
+ *  itself ever being without a delegate.
+ *
+ *  State changes are, in addition, delivered to subscribers. Each
+ *  subscriber registers a handler for a state change type and either
+ *  a group, source, zone, or equalizer preset identifier or any
+ *  identifier. A state change is delivered, after it is forwarded to
+ *  the delegate, to the handlers of the subscriptions matching its
+ *  type and identifier and to those matching its type and any
+ *  identifier, such that delivery costs a lookup and a call for each
+ *  matching subscriber, irrespective of how many others there are.
+ *
+ *  The app-wide objects that must see every delegation, such as the
+ *  command pipeline, which matches responses to requests, and the
+ *  refresh stage tracker, are fed by the bus itself, ahead of the
+ *  delegate, rather than by the delegate, such that none is missed
+ *  while views swap, or clear, the delegate. The bus also hides the
+ *  disconnection and reconnection of a suspended and resumed session
+ *  from the delegate.
+ *
+ *  Since subscriptions, unlike the delegate, need not be swapped as
+ *  views come and go, a view that stays in the navigation stack while
+ *  another is pushed over it may subscribe to stay current, rather
+ *  than re-reading everything when it reappears.
+ *
+ *  A handler may subscribe or unsubscribe, including itself, while
+ *  a state change is being delivered; a handler unsubscribed is not
+ *  called again and one subscribed is first called for the next
+ *  state change.
+ *
+ */
+class StateChangeBus :
+    public HLX::Client::Application::ControllerDelegate
+{
+public:
+    typedef HLX::Client::StateChange::Type               Type;
+    typedef HLX::Model::IdentifierModel::IdentifierType  IdentifierType;
+
+    /**
+     *  A function that handles a state change.
+     *
+     */
+    typedef std::function<void (const HLX::Client::StateChange::NotificationBasis &aStateChangeNotification)> Handler;
+
+    /**
+     *  A function that is told of a client controller refresh that
+     *  completed.
+     *
+     */
+    typedef std::function<void (HLX::Client::Application::ControllerBasis &aController)> RefreshHandler;
+
+    /**
+     *  A token identifying a subscription, with which it may be
+     *  unsubscribed.
+     *
+     */
+    typedef size_t Token;
+
+    /**
+     *  The identifier with which to subscribe to a state change type
+     *  for any identifier. This is never a valid group, source, zone,
+     *  or equalizer preset identifier.
+     *
+     */
+    static const IdentifierType  kIdentifierAny = 0;
+
+    /**
+     *  A token that never identifies a subscription.
+     *
+     */
+    static const Token           kTokenInvalid = 0;
+
+public:
+    StateChangeBus(void);
+    virtual ~StateChangeBus(void);
+
+    // Delegation
+
+    HLX::Common::Status SetDelegate(HLX::Client::Application::ControllerDelegate *aDelegate);
+    HLX::Client::Application::ControllerDelegate * GetDelegate(void) const;
+
+    // Subscription
+
+    HLX::Common::Status Subscribe(const Type &aType,
+                                  const IdentifierType &aIdentifier,
+                                  const Handler &aHandler,
+                                  Token &aToken);
+    HLX::Common::Status Unsubscribe(const Token &aToken);
+    size_t              GetSubscriptionCount(void) const;
+
+    // Observers
+
+    void                SetRefreshStageTracker(RefreshStageTracker *aRefreshStageTracker);
+    void                SetPhaseTimingRecorder(PhaseTimingRecorder *aPhaseTimingRecorder);
+    void                SetCommandPipeline(CommandPipeline *aCommandPipeline);
+    void                SetCommandCoalescer(CommandCoalescer *aCommandCoalescer);
+    void                SetSessionResumer(SessionResumer *aSessionResumer);
+    void                SetVolumeFader(VolumeFader *aVolumeFader);
+    void                SetRefreshHandler(const RefreshHandler &aRefreshHandler);
+
+    // Session
+
+    HLX::Common::Status ResumeSession(HLX::Client::Application::Controller &aController);
+
+    // Resolve
+
+    void ControllerWillResolve(HLX::Client::Application::Controller &aController, const char *aHost) final;
+    void ControllerIsResolving(HLX::Client::Application::Controller &aController, const char *aHost) final;
+    void ControllerDidResolve(HLX::Client::Application::Controller &aController, const char *aHost, const HLX::Common::IPAddress &aIPAddress) final;
+    void ControllerDidNotResolve(HLX::Client::Application::Controller &aController, const char *aHost, const HLX::Common::Error &aError) final;
+
+    // Connect
+
+    void ControllerWillConnect(HLX::Client::Application::Controller &aController, CFURLRef aURLRef, const HLX::Common::Timeout &aTimeout) final;
+    void ControllerIsConnecting(HLX::Client::Application::Controller &aController, CFURLRef aURLRef, const HLX::Common::Timeout &aTimeout) final;
+    void ControllerDidConnect(HLX::Client::Application::Controller &aController, CFURLRef aURLRef) final;
+    void ControllerDidNotConnect(HLX::Client::Application::Controller &aController, CFURLRef aURLRef, const HLX::Common::Error &aError) final;
+
+    // Disconnect
+
+    void ControllerWillDisconnect(HLX::Client::Application::Controller &aController, CFURLRef aURLRef) final;
+    void ControllerDidDisconnect(HLX::Client::Application::Controller &aController, CFURLRef aURLRef, const HLX::Common::Error &aError) final;
+    void ControllerDidNotDisconnect(HLX::Client::Application::Controller &aController, CFURLRef aURLRef, const HLX::Common::Error &aError) final;
+
+    // Refresh / Reload
+
+    void ControllerWillRefresh(HLX::Client::Application::ControllerBasis &aController) final;
+    void ControllerIsRefreshing(HLX::Client::Application::ControllerBasis &aController, const uint8_t &aPercentComplete) final;
+    void ControllerDidRefresh(HLX::Client::Application::ControllerBasis &aController) final;
+    void ControllerDidNotRefresh(HLX::Client::Application::ControllerBasis &aController, const HLX::Common::Error &aError) final;
+
+    // State Change
+
+    void ControllerStateDidChange(HLX::Client::Application::ControllerBasis &aController, const HLX::Client::StateChange::NotificationBasis &aStateChangeNotification) final;
+
+    // Error
+
+    void ControllerError(HLX::Common::Application::ControllerBasis &aController, const HLX::Common::Error &aError) final;
+
+private:
+    typedef uint32_t Key;
+
+    struct Subscription
+    {
+        Token    mToken;
+        bool     mActive;
+        Handler  mHandler;
+    };
+
+    typedef std::list<Subscription>                   Subscriptions;
+    typedef std::unordered_map<Key, Subscriptions>    SubscriptionsByKey;
+    typedef std::unordered_map<Token, Key>            KeysByToken;
+
+    static Key  MakeKey(const Type &aType, const IdentifierType &aIdentifier);
+    static bool GetIdentifier(const HLX::Client::StateChange::NotificationBasis &aStateChangeNotification, IdentifierType &aIdentifier);
+
+    void        Deliver(const Key &aKey, const HLX::Client::StateChange::NotificationBasis &aStateChangeNotification);
+    void        Compact(void);
+    void        SessionDidNotResume(HLX::Client::Application::Controller &aController, const HLX::Common::Error &aError);
+    bool        IsSessionSuspended(void) const;
+    bool        IsSessionResuming(void) const;
+
+private:
+    HLX::Client::Application::ControllerDelegate *  mDelegate;
+    RefreshStageTracker *                           mRefreshStageTracker;
+    PhaseTimingRecorder *                           mPhaseTimingRecorder;
+    CommandPipeline *                               mCommandPipeline;
+    CommandCoalescer *                              mCommandCoalescer;
+    SessionResumer *                                mSessionResumer;
+    VolumeFader *                                   mVolumeFader;
+    RefreshHandler                                  mRefreshHandler;
+    SubscriptionsByKey                              mSubscriptions;
+    KeysByToken                                     mKeys;
+    Token                                           mLastToken;
+    unsigned int                                    mDelivering;
+    bool                                            mCompactPending;
+};
+
+#endif // STATECHANGEBUS_HPP
@@ -27,6 +27,8 @@
 
 #include <Foundation/Foundation.h>
 
+#include <errno.h>
+
 #include <LogUtilities/LogUtilities.hpp>
 
 #include <OpenHLX/Client/ApplicationControllerDelegate.hpp>
@@ -34,6 +36,8 @@
 #include <OpenHLX/Model/ToneModel.hpp>
 #include <OpenHLX/Utilities/Assert.hpp>
 
+#import "AppDelegate.h"
+#import "CommandPlanner.hpp"
 #import "UIViewController+HLXClientDidDisconnectDelegateDefaultImplementations.h"
 #import "UIViewController+TopViewController.h"
 
@@ -56,6 +60,84 @@ class Controller;
 
 };
 
+/**
+ *  @brief
+ *    Set the tone bass or treble level of a zone in the fewest bytes.
+ *
+ *  A slider dragged a step at a time sends levels one step from those
+ *  in the model; the command planner sends these as a relative step,
+ *  which is shorter on the wire than an absolute set.
+ *
+ *  @param[in]  aApplicationController  A reference to a shared
+ *                                      pointer to the client
+ *                                      controller.
+ *  @param[in]  aIdentifier             The identifier of the zone.
+ *  @param[in]  aProperty               The tone level to set, either
+ *                                      bass or treble.
+ *  @param[in]  aLevel                  The level to set.
+ *
+ *  @retval  kStatus_Success  If successful.
+ *  @retval  -EINVAL          If no command was planned.
+ *
+ */
+static Status
+setToneLevel(const MutableApplicationControllerPointer &aApplicationController,
+             const ZoneModel::IdentifierType &aIdentifier,
+             const CommandPlanner::Property &aProperty,
+             const CommandCoalescer::ValueType &aLevel)
+{
+    const ZoneModel *                         lZone;
+    ToneModel::LevelType                      lModelBass;
+    ToneModel::LevelType                      lModelTreble;
+    CommandPlanner                            lPlanner;
+    CommandPlanner::Change                    lChange;
+    CommandPlanner::Changes                   lChanges;
+    CommandPlanner::Commands                  lCommands;
+    CommandPlanner::Commands::const_iterator  lCommand;
+    Status                                    lRetval = -EINVAL;
+
+
+    lChange.mZone       = aIdentifier;
+    lChange.mProperty   = aProperty;
+    lChange.mHasCurrent = ((aApplicationController->ZoneGet(aIdentifier, lZone) == kStatus_Success) &&
+                           (lZone->GetTone(lModelBass, lModelTreble) == kStatus_Success));
+    lChange.mCurrent    = (lChange.mHasCurrent ? ((aProperty == CommandPlanner::kPropertyBass) ? lModelBass : lModelTreble) : 0);
+    lChange.mTarget     = aLevel;
+
+    lChanges.push_back(lChange);
+
+    lPlanner.Plan(lChanges, CommandPlanner::Groups(), lCommands);
+
+    for (lCommand = lCommands.begin(); lCommand != lCommands.end(); lCommand++)
+    {
+        const bool lIsBass = (lCommand->mProperty == CommandPlanner::kPropertyBass);
+
+        if (lCommand->mEncoding == CommandPlanner::kEncodingIncrease)
+        {
+            lRetval = (lIsBass ?
+                       aApplicationController->ZoneIncreaseBass(aIdentifier) :
+                       aApplicationController->ZoneIncreaseTreble(aIdentifier));
+        }
+        else if (lCommand->mEncoding == CommandPlanner::kEncodingDecrease)
+        {
+            lRetval = (lIsBass ?
+                       aApplicationController->ZoneDecreaseBass(aIdentifier) :
+                       aApplicationController->ZoneDecreaseTreble(aIdentifier));
+        }
+        else
+        {
+            lRetval = (lIsBass ?
+                       aApplicationController->ZoneSetBass(aIdentifier, static_cast<ToneModel::LevelType>(lCommand->mValue)) :
+                       aApplicationController->ZoneSetTreble(aIdentifier, static_cast<ToneModel::LevelType>(lCommand->mValue)));
+        }
+
+        nlREQUIRE_SUCCESS(lRetval, done);
+    }
+
+ done:
+    return (lRetval);
+}
+
 @interface ToneDetailViewController ()
 {
 
@@ -82,12 +164,13 @@ class Controller;
 
 - (void) viewWillAppear: (BOOL)aAnimated
 {
+    AppDelegate *      lDelegate = [AppDelegate sharedDelegate];
     Status             lStatus;
 
 
     [super viewWillAppear: aAnimated];
 
-    lStatus = mApplicationController->SetDelegate(mApplicationControllerDelegate.get());
+    lStatus = [lDelegate stateChangeBus].SetDelegate(mApplicationControllerDelegate.get());
     nlREQUIRE_SUCCESS(lStatus, done);
 
     [self refreshZoneTone];
@@ -209,13 +292,18 @@ done:
 {
     if (aSender == self.mBassDecreaseButton)
     {
-        ZoneModel::IdentifierType  lIdentifier;
-        Status                     lStatus;
+        AppDelegate *                       lDelegate = [AppDelegate sharedDelegate];
+        MutableApplicationControllerPointer lApplicationController = mApplicationController;
+        ZoneModel::IdentifierType           lIdentifier;
+        Status                              lStatus;
 
         lStatus = mZone->GetIdentifier(lIdentifier);
         nlREQUIRE_SUCCESS(lStatus, done);
 
-        lStatus = mApplicationController->ZoneDecreaseBass(lIdentifier);
+        lStatus = [lDelegate commandPipeline].Enqueue(CommandPipeline::kKindZone,
+                                                      lIdentifier,
+                                                      CommandPipeline::kAnswerTone,
+                                                      [lApplicationController, lIdentifier]() { return (lApplicationController->ZoneDecreaseBass(lIdentifier)); });
         nlEXPECT(lStatus >= 0, done);
     }
 
@@ -235,14 +323,29 @@ done:
 {
     if (aSender == self.mBassSlider)
     {
-        const ToneModel::LevelType  lBass = static_cast<ToneModel::LevelType>(self.mBassSlider.value);
-        ZoneModel::IdentifierType   lIdentifier;
-        Status                      lStatus;
+        AppDelegate *                        lDelegate = [AppDelegate sharedDelegate];
+        MutableApplicationControllerPointer  lApplicationController = mApplicationController;
+        const ToneModel::LevelType           lBass = static_cast<ToneModel::LevelType>(self.mBassSlider.value);
+        ToneModel::LevelType                 lModelBass;
+        ToneModel::LevelType                 lModelTreble;
+        ZoneModel::IdentifierType            lIdentifier;
+        Status                               lStatus;
 
         lStatus = mZone->GetIdentifier(lIdentifier);
         nlREQUIRE_SUCCESS(lStatus, done);
 
-        lStatus = mApplicationController->ZoneSetBass(lIdentifier, lBass);
+        lStatus = mZone->GetTone(lModelBass, lModelTreble);
+        nlREQUIRE_SUCCESS(lStatus, done);
+
+        // Slider value changes arrive far faster than the HLX can
+        // answer them; send only the latest.
+
+        lStatus = [lDelegate commandCoalescer].Submit(CommandCoalescer::Key(CommandCoalescer::kKindZone, lIdentifier, CommandCoalescer::kPropertyBass),
+                                                       lBass,
+                                                       lModelBass,
+                                                       [lApplicationController, lIdentifier](const CommandCoalescer::ValueType &aBass) {
+                                                           return (setToneLevel(lApplicationController, lIdentifier, CommandPlanner::kPropertyBass, aBass));
+                                                       });
         nlEXPECT(lStatus >= 0, done);
     }
 
@@ -262,13 +365,18 @@ done:
 {
     if (aSender == self.mBassIncreaseButton)
     {
-        ZoneModel::IdentifierType  lIdentifier;
-        Status                     lStatus;
+        AppDelegate *                       lDelegate = [AppDelegate sharedDelegate];
+        MutableApplicationControllerPointer lApplicationController = mApplicationController;
+        ZoneModel::IdentifierType           lIdentifier;
+        Status                              lStatus;
 
         lStatus = mZone->GetIdentifier(lIdentifier);
         nlREQUIRE_SUCCESS(lStatus, done);
 
-        lStatus = mApplicationController->ZoneIncreaseBass(lIdentifier);
+        lStatus = [lDelegate commandPipeline].Enqueue(CommandPipeline::kKindZone,
+                                                      lIdentifier,
+                                                      CommandPipeline::kAnswerTone,
+                                                      [lApplicationController, lIdentifier]() { return (lApplicationController->ZoneIncreaseBass(lIdentifier)); });
         nlEXPECT(lStatus >= 0, done);
     }
 
@@ -314,13 +422,18 @@ done:
 {
     if (aSender == self.mTrebleDecreaseButton)
     {
-        ZoneModel::IdentifierType  lIdentifier;
-        Status                     lStatus;
+        AppDelegate *                       lDelegate = [AppDelegate sharedDelegate];
+        MutableApplicationControllerPointer lApplicationController = mApplicationController;
+        ZoneModel::IdentifierType           lIdentifier;
+        Status                              lStatus;
 
         lStatus = mZone->GetIdentifier(lIdentifier);
         nlREQUIRE_SUCCESS(lStatus, done);
 
-        lStatus = mApplicationController->ZoneDecreaseTreble(lIdentifier);
+        lStatus = [lDelegate commandPipeline].Enqueue(CommandPipeline::kKindZone,
+                                                      lIdentifier,
+                                                      CommandPipeline::kAnswerTone,
+                                                      [lApplicationController, lIdentifier]() { return (lApplicationController->ZoneDecreaseTreble(lIdentifier)); });
         nlEXPECT(lStatus >= 0, done);
     }
 
@@ -340,14 +453,29 @@ done:
 {
     if (aSender == self.mTrebleSlider)
     {
-        const ToneModel::LevelType  lTreble = static_cast<ToneModel::LevelType>(self.mTrebleSlider.value);
-        ZoneModel::IdentifierType   lIdentifier;
-        Status                      lStatus;
+        AppDelegate *                        lDelegate = [AppDelegate sharedDelegate];
+        MutableApplicationControllerPointer  lApplicationController = mApplicationController;
+        const ToneModel::LevelType           lTreble = static_cast<ToneModel::LevelType>(self.mTrebleSlider.value);
+        ToneModel::LevelType                 lModelBass;
+        ToneModel::LevelType                 lModelTreble;
+        ZoneModel::IdentifierType            lIdentifier;
+        Status                               lStatus;
 
         lStatus = mZone->GetIdentifier(lIdentifier);
         nlREQUIRE_SUCCESS(lStatus, done);
 
-        lStatus = mApplicationController->ZoneSetTreble(lIdentifier, lTreble);
+        lStatus = mZone->GetTone(lModelBass, lModelTreble);
+        nlREQUIRE_SUCCESS(lStatus, done);
+
+        // Slider value changes arrive far faster than the HLX can
+        // answer them; send only the latest.
+
+        lStatus = [lDelegate commandCoalescer].Submit(CommandCoalescer::Key(CommandCoalescer::kKindZone, lIdentifier, CommandCoalescer::kPropertyTreble),
+                                                       lTreble,
+                                                       lModelTreble,
+                                                       [lApplicationController, lIdentifier](const CommandCoalescer::ValueType &aTreble) {
+                                                           return (setToneLevel(lApplicationController, lIdentifier, CommandPlanner::kPropertyTreble, aTreble));
+                                                       });
         nlEXPECT(lStatus >= 0, done);
     }
 
@@ -367,13 +495,18 @@ done:
 {
     if (aSender == self.mTrebleIncreaseButton)
     {
-        ZoneModel::IdentifierType  lIdentifier;
-        Status                     lStatus;
+        AppDelegate *                       lDelegate = [AppDelegate sharedDelegate];
+        MutableApplicationControllerPointer lApplicationController = mApplicationController;
+        ZoneModel::IdentifierType           lIdentifier;
+        Status                              lStatus;
 
         lStatus = mZone->GetIdentifier(lIdentifier);
         nlREQUIRE_SUCCESS(lStatus, done);
 
-        lStatus = mApplicationController->ZoneIncreaseTreble(lIdentifier);
+        lStatus = [lDelegate commandPipeline].Enqueue(CommandPipeline::kKindZone,
+                                                      lIdentifier,
+                                                      CommandPipeline::kAnswerTone,
+                                                      [lApplicationController, lIdentifier]() { return (lApplicationController->ZoneIncreaseTreble(lIdentifier)); });
         nlEXPECT(lStatus >= 0, done);
     }
 
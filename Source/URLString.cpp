@@ -0,0 +1,133 @@
+/*
+ *    Copyright (c) 2026 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+
+/**
+ *  @file
+ *    This file implements an object for converting between URLs and
+ *    their null-terminated strings.
+ *
+ */
+
+#include "URLString.hpp"
+
+#include <string.h>
+
+#include <CoreFoundation/CFString.h>
+
+#include <OpenHLX/Utilities/Assert.hpp>
+
+
+const size_t URLString::kLengthMax;
+
+/**
+ *  @brief
+ *    Create a URL from its string.
+ *
+ *  @param[in]  aURL  A pointer to the null-terminated URL string.
+ *
+ *  @returns
+ *    The URL, which the caller is responsible for releasing, if the
+ *    string was converted; otherwise, null.
+ *
+ */
+CFURLRef
+URLString :: Create(const char *aURL)
+{
+    CFURLRef  lRetval = nullptr;
+
+
+    nlREQUIRE(aURL != nullptr, done);
+
+    lRetval = CFURLCreateWithBytes(kCFAllocatorDefault,
+                                   reinterpret_cast<const UInt8 *>(aURL),
+                                   static_cast<CFIndex>(strlen(aURL)),
+                                   kCFStringEncodingUTF8,
+                                   nullptr);
+
+ done:
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Get the absolute string of a URL.
+ *
+ *  @param[in]   aURLRef  A reference to the URL.
+ *  @param[out]  aBuffer  A pointer to storage for the null-terminated
+ *                        string.
+ *  @param[in]   aSize    The size, in bytes, of @a aBuffer.
+ *
+ *  @returns
+ *    True if the URL was converted; otherwise, false.
+ *
+ */
+bool
+URLString :: Get(CFURLRef aURLRef, char *aBuffer, const size_t &aSize)
+{
+    CFURLRef  lAbsoluteURLRef = nullptr;
+    bool      lRetval = false;
+
+
+    nlEXPECT(aURLRef != nullptr, done);
+
+    lAbsoluteURLRef = CFURLCopyAbsoluteURL(aURLRef);
+    nlEXPECT(lAbsoluteURLRef != nullptr, done);
+
+    lRetval = CFStringGetCString(CFURLGetString(lAbsoluteURLRef), aBuffer, static_cast<CFIndex>(aSize), kCFStringEncodingUTF8);
+
+ done:
+    if (lAbsoluteURLRef != nullptr)
+    {
+        CFRelease(lAbsoluteURLRef);
+    }
+
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Get the absolute string of a URL.
+ *
+ *  @param[in]   aURLRef  A reference to the URL.
+ *  @param[out]  aString  A reference to storage for the string,
+ *                        which is empty if the URL is null or could
+ *                        not be converted.
+ *
+ *  @returns
+ *    True if the URL was converted; otherwise, false.
+ *
+ */
+bool
+URLString :: Get(CFURLRef aURLRef, std::string &aString)
+{
+    char  lBuffer[kLengthMax];
+    bool  lRetval;
+
+
+    aString.clear();
+
+    lRetval = Get(aURLRef, lBuffer, sizeof (lBuffer));
+
+    if (lRetval)
+    {
+        aString = lBuffer;
+    }
+
+    return (lRetval);
+}
@@ -0,0 +1,58 @@
+/*
+ *    Copyright (c) 2026 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+
+/**
+ *  @file
+ *    This file defines an object for converting between URLs and
+ *    their null-terminated strings.
+ *
+ */
+
+#ifndef URLSTRING_HPP
+#define URLSTRING_HPP
+
+#include <string>
+
+#include <stddef.h>
+
+#include <CoreFoundation/CFURL.h>
+
+
+/**
+ *  @brief
+ *    An object for converting between URLs and their strings.
+ *
+ *  The HLX client controller delegations carry URLs, while the
+ *  session resumer and the session log remember them as strings.
+ *  This keeps the conversions, and the Core Foundation string
+ *  handling they need, in one place.
+ *
+ */
+class URLString
+{
+public:
+    static const size_t kLengthMax = 1024;
+
+public:
+    static CFURLRef Create(const char *aURL);
+    static bool     Get(CFURLRef aURLRef, char *aBuffer, const size_t &aSize);
+    static bool     Get(CFURLRef aURLRef, std::string &aString);
+};
+
+#endif // URLSTRING_HPP
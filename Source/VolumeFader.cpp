@@ -0,0 +1,354 @@
+/*
+ *    Copyright (c) 2026 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *  @file
+ *    This file implements an object for fading the volume of HLX
+ *    groups and zones from their current level to a target level over
+ *    time.
+ *
+ */
+
+#include "VolumeFader.hpp"
+
+#include <errno.h>
+
+#include <LogUtilities/LogUtilities.hpp>
+
+#include <OpenHLX/Utilities/Assert.hpp>
+
+
+using namespace HLX::Common;
+using namespace HLX::Model;
+using namespace Nuovations;
+
+
+const VolumeFader::Duration VolumeFader::kStepIntervalDefault(100);
+
+/**
+ *  @brief
+ *    This is the class default constructor.
+ *
+ */
+VolumeFader :: VolumeFader(void) :
+    mCommandCoalescer(nullptr),
+    mStepInterval(kStepIntervalDefault),
+    mFades(),
+    mActivityHandler()
+{
+    return;
+}
+
+/**
+ *  @brief
+ *    This is the class destructor.
+ *
+ */
+VolumeFader :: ~VolumeFader(void)
+{
+    return;
+}
+
+/**
+ *  @brief
+ *    This is the class initializer.
+ *
+ *  @param[in]  aCommandCoalescer  The command coalescer to submit
+ *                                 fade steps to.
+ *  @param[in]  aStepInterval      The least time between the steps
+ *                                 of a fade.
+ *
+ *  @retval  kStatus_Success  If successful.
+ *  @retval  -EINVAL          If @a aStepInterval was negative.
+ *
+ */
+Status
+VolumeFader :: Init(CommandCoalescer &aCommandCoalescer,
+                    const Duration &aStepInterval)
+{
+    Status  lRetval = kStatus_Success;
+
+
+    nlREQUIRE_ACTION(aStepInterval >= Duration::zero(), done, lRetval = -EINVAL);
+
+    mCommandCoalescer = &aCommandCoalescer;
+    mStepInterval     = aStepInterval;
+
+ done:
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Set the function told when the fader goes from having no fades
+ *    in progress to having one, and back again.
+ *
+ *  @param[in]  aActivityHandler  The activity handler, or an empty
+ *                                function for none.
+ *
+ */
+void
+VolumeFader :: SetActivityHandler(const ActivityHandler &aActivityHandler)
+{
+    mActivityHandler = aActivityHandler;
+}
+
+// MARK: Fades
+
+/**
+ *  @brief
+ *    Start fading the volume of a group or zone to a target level.
+ *
+ *  Any fade already in progress for the group or zone is replaced. A
+ *  fade of no duration sets the target level at once.
+ *
+ *  @param[in]  aKind        The kind of entity to fade.
+ *  @param[in]  aIdentifier  The identifier of the entity to fade.
+ *  @param[in]  aCurrent     The current volume level of the entity.
+ *  @param[in]  aTarget      The volume level to fade to.
+ *  @param[in]  aDuration    The time over which to fade.
+ *  @param[in]  aSetter      The function that sends a volume level
+ *                           set command for the entity.
+ *
+ *  @retval  kStatus_Success  If successful.
+ *  @retval  -EINVAL          If @a aSetter was empty, if @a aDuration
+ *                            was negative, or if the fader was not
+ *                            initialized.
+ *  @retval  -ERANGE          If @a aKind, @a aCurrent, or @a aTarget
+ *                            was out of range.
+ *
+ */
+Status
+VolumeFader :: Start(const Kind &aKind,
+                     const IdentifierType &aIdentifier,
+                     const LevelType &aCurrent,
+                     const LevelType &aTarget,
+                     const Duration &aDuration,
+                     const Setter &aSetter)
+{
+    const Key                lKey(aKind, aIdentifier);
+    const Clock::time_point  lNow = Clock::now();
+    const size_t             lPriorCount = mFades.size();
+    Fade                     lFade;
+    Status                   lRetval = kStatus_Success;
+
+
+    nlREQUIRE_ACTION(mCommandCoalescer != nullptr, done, lRetval = -EINVAL);
+    nlREQUIRE_ACTION(aKind < kKindMax, done, lRetval = -ERANGE);
+    nlREQUIRE_ACTION((aCurrent >= VolumeModel::kLevelMin) && (aCurrent <= VolumeModel::kLevelMax), done, lRetval = -ERANGE);
+    nlREQUIRE_ACTION((aTarget >= VolumeModel::kLevelMin) && (aTarget <= VolumeModel::kLevelMax), done, lRetval = -ERANGE);
+    nlREQUIRE_ACTION(aDuration >= Duration::zero(), done, lRetval = -EINVAL);
+    nlREQUIRE_ACTION(aSetter != nullptr, done, lRetval = -EINVAL);
+
+    lFade.mStarted  = lNow;
+    lFade.mDuration = aDuration;
+    lFade.mFrom     = aCurrent;
+    lFade.mTarget   = aTarget;
+    lFade.mLevel    = aCurrent;
+    lFade.mStepped  = Clock::time_point();
+    lFade.mSetter   = aSetter;
+
+    mFades[lKey] = lFade;
+
+    Log::Debug().Write("Fading kind %u identifier %u from %d to %d over %lld ms.\n",
+                       aKind,
+                       aIdentifier,
+                       aCurrent,
+                       aTarget,
+                       static_cast<long long>(aDuration.count()));
+
+    DidChangeCount(lPriorCount);
+
+    Service();
+
+ done:
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Stop fading the volume of a group or zone, leaving it at the
+ *    level of the last step sent, for example, because the user has
+ *    taken over the volume.
+ *
+ *  @param[in]  aKind        The kind of entity.
+ *  @param[in]  aIdentifier  The identifier of the entity.
+ *
+ */
+void
+VolumeFader :: Cancel(const Kind &aKind, const IdentifierType &aIdentifier)
+{
+    const size_t  lPriorCount = mFades.size();
+
+
+    mFades.erase(Key(aKind, aIdentifier));
+
+    DidChangeCount(lPriorCount);
+}
+
+bool
+VolumeFader :: IsFading(const Kind &aKind, const IdentifierType &aIdentifier) const
+{
+    return (mFades.count(Key(aKind, aIdentifier)) != 0);
+}
+
+size_t
+VolumeFader :: GetCount(void) const
+{
+    return (mFades.size());
+}
+
+/**
+ *  @brief
+ *    Stop all fades.
+ *
+ *  This is typically used when the client controller disconnects,
+ *  after which no step may be sent.
+ *
+ */
+void
+VolumeFader :: Clear(void)
+{
+    const size_t  lPriorCount = mFades.size();
+
+
+    mFades.clear();
+
+    DidChangeCount(lPriorCount);
+}
+
+/**
+ *  @brief
+ *    Step each fade in progress to the level it should have reached
+ *    by now, where its step interval has passed and its prior step
+ *    has been answered, retiring those that have reached their target.
+ *
+ */
+void
+VolumeFader :: Service(void)
+{
+    const Clock::time_point  lNow = Clock::now();
+    const size_t             lPriorCount = mFades.size();
+    Fades::iterator          lFade = mFades.begin();
+    Status                   lStatus;
+
+
+    while (lFade != mFades.end())
+    {
+        const Clock::duration  lElapsed = (lNow - lFade->second.mStarted);
+        const bool             lIsFinished = (lElapsed >= lFade->second.mDuration);
+        LevelType              lLevel = lFade->second.mTarget;
+
+        if (!lIsFinished)
+        {
+            const double lFraction = (std::chrono::duration<double>(lElapsed).count() /
+                                      std::chrono::duration<double>(lFade->second.mDuration).count());
+            const double lDelta    = ((lFade->second.mTarget - lFade->second.mFrom) * lFraction);
+
+            lLevel = static_cast<LevelType>(lFade->second.mFrom + ((lDelta < 0) ? (lDelta - 0.5) : (lDelta + 0.5)));
+        }
+
+        if (lIsFinished)
+        {
+            // Always send the final step, even behind one still in
+            // flight, such that the fade ends on its target.
+
+            lStatus = Step(lFade->first, lFade->second, lLevel, lNow);
+
+            if (lStatus != kStatus_Success)
+            {
+                Log::Error().Write("Could not finish fade of kind %u identifier %u: %d\n",
+                                   lFade->first.first,
+                                   lFade->first.second,
+                                   lStatus);
+            }
+
+            lFade = mFades.erase(lFade);
+        }
+        else
+        {
+            const CommandCoalescer::Kind  lKind = ((lFade->first.first == kKindGroup) ? CommandCoalescer::kKindGroup : CommandCoalescer::kKindZone);
+            const CommandCoalescer::Key   lKey(lKind, lFade->first.second, CommandCoalescer::kPropertyVolume);
+
+            if ((lLevel != lFade->second.mLevel) &&
+                ((lNow - lFade->second.mStepped) >= mStepInterval) &&
+                !mCommandCoalescer->IsInFlight(lKey))
+            {
+                lStatus = Step(lFade->first, lFade->second, lLevel, lNow);
+
+                if (lStatus != kStatus_Success)
+                {
+                    Log::Error().Write("Could not step fade of kind %u identifier %u: %d\n",
+                                       lFade->first.first,
+                                       lFade->first.second,
+                                       lStatus);
+
+                    lFade = mFades.erase(lFade);
+                }
+                else
+                {
+                    lFade++;
+                }
+            }
+            else
+            {
+                lFade++;
+            }
+        }
+    }
+
+    DidChangeCount(lPriorCount);
+}
+
+// MARK: Implementation
+
+Status
+VolumeFader :: Step(const Key &aKey, Fade &aFade, const LevelType &aLevel, const Clock::time_point &aNow)
+{
+    const CommandCoalescer::Kind  lCoalescerKind = ((aKey.first == kKindGroup) ? CommandCoalescer::kKindGroup : CommandCoalescer::kKindZone);
+    const IdentifierType          lIdentifier    = aKey.second;
+    const Setter                  lSetter        = aFade.mSetter;
+    Status                        lRetval;
+
+
+    lRetval = mCommandCoalescer->Submit(CommandCoalescer::Key(lCoalescerKind, lIdentifier, CommandCoalescer::kPropertyVolume),
+                                        aLevel,
+                                        [lSetter](const CommandCoalescer::ValueType &aValue) {
+                                            return (lSetter(static_cast<LevelType>(aValue)));
+                                        });
+    nlREQUIRE_SUCCESS(lRetval, done);
+
+    aFade.mLevel   = aLevel;
+    aFade.mStepped = aNow;
+
+ done:
+    return (lRetval);
+}
+
+void
+VolumeFader :: DidChangeCount(const size_t &aPriorCount)
+{
+    const bool  lWasActive = (aPriorCount != 0);
+    const bool  lIsActive  = !mFades.empty();
+
+
+    if ((lWasActive != lIsActive) && mActivityHandler)
+    {
+        mActivityHandler(lIsActive);
+    }
+}
@@ -0,0 +1,158 @@
+/*
+ *    Copyright (c) 2026 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *  @file
+ *    This file defines an object for fading the volume of HLX groups
+ *    and zones from their current level to a target level over time.
+ *
+ */
+
+#ifndef VOLUMEFADER_HPP
+#define VOLUMEFADER_HPP
+
+#include <chrono>
+#include <functional>
+#include <map>
+#include <utility>
+
+#include <stddef.h>
+
+#include <OpenHLX/Common/Errors.hpp>
+#include <OpenHLX/Model/IdentifierModel.hpp>
+#include <OpenHLX/Model/VolumeModel.hpp>
+
+#include "CommandCoalescer.hpp"
+
+
+/**
+ *  @brief
+ *    An object for timed HLX group and zone volume fades.
+ *
+ *  A fade moves the volume level of a group or zone linearly from its
+ *  current level to a target level over a duration. Each time the
+ *  fader is serviced, each fade steps to the level it should have
+ *  reached by then, sending an absolute set rather than relative
+ *  increase or decrease commands.
+ *
+ *  The command rate of each fade is bounded in two ways. First, a fade
+ *  steps no more often than the step interval. Second, a fade does not
+ *  step while its prior step is still unanswered. Each step is
+ *  submitted to the command coalescer, which sends it through the
+ *  command pipeline, such that a slow link sees fewer, larger steps
+ *  and a fast link more, smaller ones, and every fade still arrives
+ *  at its target on time: the final step is always sent, waiting
+ *  behind any step still in flight.
+ *
+ *  Since steps are submitted to the coalescer, views render the
+ *  level of a fade in progress as they do that of a slider drag.
+ *
+ */
+class VolumeFader
+{
+public:
+    /**
+     *  The kind of entity a fade is for.
+     *
+     */
+    enum Kind
+    {
+        kKindGroup = 0, //!< A group.
+        kKindZone,      //!< A zone.
+
+        kKindMax
+    };
+
+    typedef HLX::Model::IdentifierModel::IdentifierType IdentifierType;
+    typedef HLX::Model::VolumeModel::LevelType          LevelType;
+
+    /**
+     *  A function that sends a volume level set command to the client
+     *  controller.
+     *
+     */
+    typedef std::function<HLX::Common::Status (const LevelType &aLevel)> Setter;
+
+    /**
+     *  A function that is told when the fader goes from having no
+     *  fades in progress to having one, and back again, such that it
+     *  need only be serviced while it does.
+     *
+     */
+    typedef std::function<void (const bool &aActive)> ActivityHandler;
+
+    typedef std::chrono::steady_clock Clock;
+    typedef std::chrono::milliseconds Duration;
+
+    /**
+     *  The default least time between the steps of a fade.
+     *
+     */
+    static const Duration kStepIntervalDefault;
+
+public:
+    VolumeFader(void);
+    ~VolumeFader(void);
+
+    HLX::Common::Status Init(CommandCoalescer &aCommandCoalescer,
+                             const Duration &aStepInterval);
+
+    void                SetActivityHandler(const ActivityHandler &aActivityHandler);
+
+    // Fades
+
+    HLX::Common::Status Start(const Kind &aKind,
+                              const IdentifierType &aIdentifier,
+                              const LevelType &aCurrent,
+                              const LevelType &aTarget,
+                              const Duration &aDuration,
+                              const Setter &aSetter);
+    void                Cancel(const Kind &aKind, const IdentifierType &aIdentifier);
+    bool                IsFading(const Kind &aKind, const IdentifierType &aIdentifier) const;
+    size_t              GetCount(void) const;
+    void                Clear(void);
+
+    void                Service(void);
+
+private:
+    typedef std::pair<Kind, IdentifierType> Key;
+
+    struct Fade
+    {
+        Clock::time_point  mStarted;
+        Duration           mDuration;
+        LevelType          mFrom;
+        LevelType          mTarget;
+        LevelType          mLevel;
+        Clock::time_point  mStepped;
+        Setter             mSetter;
+    };
+
+    typedef std::map<Key, Fade> Fades;
+
+    HLX::Common::Status Step(const Key &aKey, Fade &aFade, const LevelType &aLevel, const Clock::time_point &aNow);
+    void                DidChangeCount(const size_t &aPriorCount);
+
+private:
+    CommandCoalescer *  mCommandCoalescer;
+    Duration            mStepInterval;
+    Fades               mFades;
+    ActivityHandler     mActivityHandler;
+};
+
+#endif // VOLUMEFADER_HPP
@@ -179,6 +179,7 @@ class ApplicationControllerDelegate;
 - (IBAction) onBalanceLeftButtonAction: (id)aSender;
 - (IBAction) onBalanceSliderAction: (id)aSender;
 - (IBAction) onBalanceRightButtonAction: (id)aSender;
+- (IBAction) onFadeButtonAction: (id)aSender;
 - (IBAction) onMonoSwitchAction: (id)aSender;
 - (IBAction) onMuteSwitchAction: (id)aSender;
 - (IBAction) onVolumeDecreaseButtonAction: (id)aSender;
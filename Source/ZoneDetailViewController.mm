@@ -34,10 +34,12 @@
 
 #include <OpenHLX/Client/ApplicationControllerDelegate.hpp>
 #include <OpenHLX/Client/GroupsStateChangeNotifications.hpp>
+#include <OpenHLX/Client/SourcesStateChangeNotifications.hpp>
 #include <OpenHLX/Client/ZonesStateChangeNotifications.hpp>
 #include <OpenHLX/Model/VolumeModel.hpp>
 #include <OpenHLX/Utilities/Assert.hpp>
 
+#import "AppDelegate.h"
 #import "ApplicationControllerDelegate.hpp"
 #import "CrossoverDetailViewController.h"
 #import "EqualizerBandsDetailViewController.h"
@@ -99,17 +101,23 @@ enum
     self.mVolumeSlider.minimumValue = static_cast<float>(VolumeModel::kLevelMin);
     self.mVolumeSlider.maximumValue = static_cast<float>(VolumeModel::kLevelMax);
 
+    self.navigationItem.rightBarButtonItem = [[UIBarButtonItem alloc] initWithTitle: NSLocalizedString(@"Fade", @"")
+                                                                              style: UIBarButtonItemStylePlain
+                                                                             target: self
+                                                                             action: @selector(onFadeButtonAction:)];
+
     return;
 }
 
 - (void) viewWillAppear: (BOOL)aAnimated
 {
+    AppDelegate *      lDelegate = [AppDelegate sharedDelegate];
     Status             lStatus;
 
 
     [super viewWillAppear: aAnimated];
 
-    lStatus = mApplicationController->SetDelegate(mApplicationControllerDelegate.get());
+    lStatus = [lDelegate stateChangeBus].SetDelegate(mApplicationControllerDelegate.get());
     nlREQUIRE_SUCCESS(lStatus, done);
 
 #if OPENHLX_INSTALLER
@@ -196,6 +204,8 @@ done:
 
 - (void)prepareForSegue: (UIStoryboardSegue *)aSegue sender: (id)aSender
 {
+    AppDelegate *lDelegate = [AppDelegate sharedDelegate];
+
     if ([aSender isKindOfClass: [UITableViewCell class]])
     {
         if ([[aSegue identifier] isEqual: @"Source Chooser Segue"])
@@ -207,7 +217,7 @@ done:
             [lSourceChooserViewController setApplicationController: mApplicationController
                                                          forZone: mZone];
 
-            lStatus = mApplicationController->SetDelegate(nullptr);
+            lStatus = [lDelegate stateChangeBus].SetDelegate(nullptr);
             nlREQUIRE_SUCCESS(lStatus, done);
         }
 #if OPENHLX_INSTALLER
@@ -220,7 +230,7 @@ done:
             [lSoundModeChooserViewController setApplicationController: mApplicationController
                                                             forZone: mZone];
 
-            lStatus = mApplicationController->SetDelegate(nullptr);
+            lStatus = [lDelegate stateChangeBus].SetDelegate(nullptr);
             nlREQUIRE_SUCCESS(lStatus, done);
         }
 #endif // OPENHLX_INSTALLER
@@ -237,7 +247,7 @@ done:
             [lEqualizerBandsDetailViewController setApplicationController: mApplicationController
                                                                 forZone: mZone];
 
-            lStatus = mApplicationController->SetDelegate(nullptr);
+            lStatus = [lDelegate stateChangeBus].SetDelegate(nullptr);
             nlREQUIRE_SUCCESS(lStatus, done);
         }
         else if ([[aSegue identifier] isEqual: @"Equalizer Preset Chooser Segue"])
@@ -249,7 +259,7 @@ done:
             [lEqualizerPresetChooserViewController setApplicationController: mApplicationController
                                                                   forZone: mZone];
 
-            lStatus = mApplicationController->SetDelegate(nullptr);
+            lStatus = [lDelegate stateChangeBus].SetDelegate(nullptr);
             nlREQUIRE_SUCCESS(lStatus, done);
         }
         else if ([[aSegue identifier] isEqual: @"Tone Detail Segue"])
@@ -261,7 +271,7 @@ done:
             [lToneDetailViewController setApplicationController: mApplicationController
                                                       forZone: mZone];
 
-            lStatus = mApplicationController->SetDelegate(nullptr);
+            lStatus = [lDelegate stateChangeBus].SetDelegate(nullptr);
             nlREQUIRE_SUCCESS(lStatus, done);
         }
         else if ([[aSegue identifier] isEqual: @"Highpass Crossover Detail Segue"])
@@ -274,7 +284,7 @@ done:
                                                            forZone: mZone
                                                         asHighpass: true];
 
-            lStatus = mApplicationController->SetDelegate(nullptr);
+            lStatus = [lDelegate stateChangeBus].SetDelegate(nullptr);
             nlREQUIRE_SUCCESS(lStatus, done);
         }
         else if ([[aSegue identifier] isEqual: @"Lowpass Crossover Detail Segue"])
@@ -287,7 +297,7 @@ done:
                                                            forZone: mZone
                                                         asHighpass: false];
 
-            lStatus = mApplicationController->SetDelegate(nullptr);
+            lStatus = [lDelegate stateChangeBus].SetDelegate(nullptr);
             nlREQUIRE_SUCCESS(lStatus, done);
         }
     }
@@ -340,13 +350,18 @@ done:
 #if OPENHLX_INSTALLER
     if (aSender == self.mBalanceDecreaseButton)
     {
-        ZoneModel::IdentifierType  lIdentifier;
-        Status                     lStatus;
+        AppDelegate *                       lDelegate = [AppDelegate sharedDelegate];
+        MutableApplicationControllerPointer lApplicationController = mApplicationController;
+        ZoneModel::IdentifierType           lIdentifier;
+        Status                              lStatus;
 
         lStatus = mZone->GetIdentifier(lIdentifier);
         nlREQUIRE_SUCCESS(lStatus, done);
 
-        lStatus = mApplicationController->ZoneIncreaseBalanceLeft(lIdentifier);
+        lStatus = [lDelegate commandPipeline].Enqueue(CommandPipeline::kKindZone,
+                                                      lIdentifier,
+                                                      CommandPipeline::kAnswerBalance,
+                                                      [lApplicationController, lIdentifier]() { return (lApplicationController->ZoneIncreaseBalanceLeft(lIdentifier)); });
         nlEXPECT(lStatus >= 0, done);
     }
 
@@ -368,14 +383,28 @@ done:
 #if OPENHLX_INSTALLER
     if (aSender == self.mBalanceSlider)
     {
-        const BalanceModel::BalanceType lBalance = static_cast<BalanceModel::BalanceType>(self.mBalanceSlider.value);
-        ZoneModel::IdentifierType       lIdentifier;
-        Status                          lStatus;
+        AppDelegate *                       lDelegate = [AppDelegate sharedDelegate];
+        MutableApplicationControllerPointer lApplicationController = mApplicationController;
+        const BalanceModel::BalanceType     lBalance = static_cast<BalanceModel::BalanceType>(self.mBalanceSlider.value);
+        BalanceModel::BalanceType           lModelBalance;
+        ZoneModel::IdentifierType           lIdentifier;
+        Status                              lStatus;
 
         lStatus = mZone->GetIdentifier(lIdentifier);
         nlREQUIRE_SUCCESS(lStatus, done);
 
-        lStatus = mApplicationController->ZoneSetBalance(lIdentifier, lBalance);
+        lStatus = mZone->GetBalance(lModelBalance);
+        nlREQUIRE_SUCCESS(lStatus, done);
+
+        // Slider value changes arrive far faster than the HLX can
+        // answer them; send only the latest.
+
+        lStatus = [lDelegate commandCoalescer].Submit(CommandCoalescer::Key(CommandCoalescer::kKindZone, lIdentifier, CommandCoalescer::kPropertyBalance),
+                                                       lBalance,
+                                                       lModelBalance,
+                                                       [lApplicationController, lIdentifier](const CommandCoalescer::ValueType &aBalance) {
+                                                           return (lApplicationController->ZoneSetBalance(lIdentifier, static_cast<BalanceModel::BalanceType>(aBalance)));
+                                                       });
         nlEXPECT(lStatus >= 0, done);
     }
 
@@ -384,6 +413,58 @@ done:
     return;
 }
 
+/**
+ *  @brief
+ *    This is the action handler for the volume fade button.
+ *
+ *  This prompts for the volume level to fade the zone to and the
+ *  number of seconds over which to do so.
+ *
+ *  @param[in]  aSender  The entity that triggered this action handler.
+ *
+ */
+- (IBAction) onFadeButtonAction: (id)aSender
+{
+    UIAlertController *           lAlertController;
+    __weak UIAlertController *    lWeakAlertController;
+
+
+    lAlertController = [UIAlertController alertControllerWithTitle: NSLocalizedString(@"Fade Volume", @"")
+                                          message: [NSString stringWithFormat: NSLocalizedString(@"Fade to a level from %d to %d over a number of seconds.", @""),
+                                                    VolumeModel::kLevelMin,
+                                                    VolumeModel::kLevelMax]
+                                          preferredStyle: UIAlertControllerStyleAlert];
+
+    lWeakAlertController = lAlertController;
+
+    [lAlertController addTextFieldWithConfigurationHandler: ^(UITextField * aTextField) {
+        aTextField.placeholder = NSLocalizedString(@"Level", @"");
+        aTextField.keyboardType = UIKeyboardTypeNumbersAndPunctuation;
+    }];
+
+    [lAlertController addTextFieldWithConfigurationHandler: ^(UITextField * aTextField) {
+        aTextField.placeholder = NSLocalizedString(@"Seconds", @"");
+        aTextField.keyboardType = UIKeyboardTypeDecimalPad;
+    }];
+
+    [lAlertController addAction: [UIAlertAction actionWithTitle: NSLocalizedString(@"Cancel", @"")
+                                                 style: UIAlertActionStyleCancel
+                                                 handler: nullptr]];
+
+    [lAlertController addAction: [UIAlertAction actionWithTitle: NSLocalizedString(@"Fade", @"")
+                                                 style: UIAlertActionStyleDefault
+                                                 handler: ^(UIAlertAction * aAction) {
+        NSArray<UITextField *> * lTextFields = [lWeakAlertController textFields];
+
+        [self fadeVolumeToLevel: [[lTextFields objectAtIndex: 0] text]
+                    overSeconds: [[lTextFields objectAtIndex: 1] text]];
+    }]];
+
+    [self presentViewController: lAlertController
+                       animated: true
+                     completion: nullptr];
+}
+
 /**
  *  @brief
  *    This is the action handler for the zone stereophonic channel
@@ -397,13 +478,18 @@ done:
 #if OPENHLX_INSTALLER
     if (aSender == self.mBalanceIncreaseButton)
     {
-        ZoneModel::IdentifierType  lIdentifier;
-        Status                     lStatus;
+        AppDelegate *                       lDelegate = [AppDelegate sharedDelegate];
+        MutableApplicationControllerPointer lApplicationController = mApplicationController;
+        ZoneModel::IdentifierType           lIdentifier;
+        Status                              lStatus;
 
         lStatus = mZone->GetIdentifier(lIdentifier);
         nlREQUIRE_SUCCESS(lStatus, done);
 
-        lStatus = mApplicationController->ZoneIncreaseBalanceRight(lIdentifier);
+        lStatus = [lDelegate commandPipeline].Enqueue(CommandPipeline::kKindZone,
+                                                      lIdentifier,
+                                                      CommandPipeline::kAnswerBalance,
+                                                      [lApplicationController, lIdentifier]() { return (lApplicationController->ZoneIncreaseBalanceRight(lIdentifier)); });
         nlEXPECT(lStatus >= 0, done);
     }
 
@@ -428,14 +514,22 @@ done:
 {
     if (aSender == self.mMuteSwitch)
     {
-        const VolumeModel::MuteType lMute = static_cast<VolumeModel::MuteType>(self.mMuteSwitch.on);
-        ZoneModel::IdentifierType   lIdentifier;
-        Status                      lStatus;
+        AppDelegate *                       lDelegate = [AppDelegate sharedDelegate];
+        MutableApplicationControllerPointer lApplicationController = mApplicationController;
+        const VolumeModel::MuteType         lMute = static_cast<VolumeModel::MuteType>(self.mMuteSwitch.on);
+        ZoneModel::IdentifierType           lIdentifier;
+        Status                              lStatus;
 
         lStatus = mZone->GetIdentifier(lIdentifier);
         nlREQUIRE_SUCCESS(lStatus, done);
 
-        lStatus = mApplicationController->ZoneSetMute(lIdentifier, lMute);
+        // A mute must not wait behind queued background queries.
+
+        lStatus = [lDelegate commandPipeline].Enqueue(CommandPipeline::kKindZone,
+                                                      lIdentifier,
+                                                      CommandPipeline::kAnswerMute,
+                                                      CommandScheduler::kLaneInteractive,
+                                                      [lApplicationController, lIdentifier, lMute]() { return (lApplicationController->ZoneSetMute(lIdentifier, lMute)); });
         nlREQUIRE(lStatus >= kStatus_Success, done);
     }
 
@@ -455,13 +549,22 @@ done:
 {
     if (aSender == self.mVolumeDecreaseButton)
     {
-        ZoneModel::IdentifierType   lIdentifier;
-        Status                      lStatus;
+        AppDelegate *                       lDelegate = [AppDelegate sharedDelegate];
+        MutableApplicationControllerPointer lApplicationController = mApplicationController;
+        ZoneModel::IdentifierType           lIdentifier;
+        Status                              lStatus;
 
         lStatus = mZone->GetIdentifier(lIdentifier);
         nlREQUIRE_SUCCESS(lStatus, done);
 
-        lStatus = mApplicationController->ZoneDecreaseVolume(lIdentifier);
+        // Any manual change takes over from a fade in progress.
+
+        [lDelegate volumeFader].Cancel(VolumeFader::kKindZone, lIdentifier);
+
+        lStatus = [lDelegate commandPipeline].Enqueue(CommandPipeline::kKindZone,
+                                                      lIdentifier,
+                                                      CommandPipeline::kAnswerVolume,
+                                                      [lApplicationController, lIdentifier]() { return (lApplicationController->ZoneDecreaseVolume(lIdentifier)); });
         nlEXPECT(lStatus >= 0, done);
     }
 
@@ -481,14 +584,32 @@ done:
 {
     if (aSender == self.mVolumeSlider)
     {
-        const VolumeModel::LevelType lVolume = static_cast<VolumeModel::LevelType>(self.mVolumeSlider.value);
-        ZoneModel::IdentifierType    lIdentifier;
-        Status                       lStatus;
+        AppDelegate *                       lDelegate = [AppDelegate sharedDelegate];
+        MutableApplicationControllerPointer lApplicationController = mApplicationController;
+        const VolumeModel::LevelType        lVolume = static_cast<VolumeModel::LevelType>(self.mVolumeSlider.value);
+        VolumeModel::LevelType              lModelVolume;
+        ZoneModel::IdentifierType           lIdentifier;
+        Status                              lStatus;
 
         lStatus = mZone->GetIdentifier(lIdentifier);
         nlREQUIRE_SUCCESS(lStatus, done);
 
-        lStatus = mApplicationController->ZoneSetVolume(lIdentifier, lVolume);
+        // Any manual change takes over from a fade in progress.
+
+        [lDelegate volumeFader].Cancel(VolumeFader::kKindZone, lIdentifier);
+
+        lStatus = mZone->GetVolume(lModelVolume);
+        nlREQUIRE_SUCCESS(lStatus, done);
+
+        // Slider value changes arrive far faster than the HLX can
+        // answer them; send only the latest.
+
+        lStatus = [lDelegate commandCoalescer].Submit(CommandCoalescer::Key(CommandCoalescer::kKindZone, lIdentifier, CommandCoalescer::kPropertyVolume),
+                                                       lVolume,
+                                                       lModelVolume,
+                                                       [lApplicationController, lIdentifier](const CommandCoalescer::ValueType &aVolume) {
+                                                           return (lApplicationController->ZoneSetVolume(lIdentifier, static_cast<VolumeModel::LevelType>(aVolume)));
+                                                       });
         nlEXPECT(lStatus >= 0, done);
     }
 
@@ -508,13 +629,22 @@ done:
 {
     if (aSender == self.mVolumeIncreaseButton)
     {
-        ZoneModel::IdentifierType  lIdentifier;
-        Status                     lStatus;
+        AppDelegate *                       lDelegate = [AppDelegate sharedDelegate];
+        MutableApplicationControllerPointer lApplicationController = mApplicationController;
+        ZoneModel::IdentifierType           lIdentifier;
+        Status                              lStatus;
 
         lStatus = mZone->GetIdentifier(lIdentifier);
         nlREQUIRE_SUCCESS(lStatus, done);
 
-        lStatus = mApplicationController->ZoneIncreaseVolume(lIdentifier);
+        // Any manual change takes over from a fade in progress.
+
+        [lDelegate volumeFader].Cancel(VolumeFader::kKindZone, lIdentifier);
+
+        lStatus = [lDelegate commandPipeline].Enqueue(CommandPipeline::kKindZone,
+                                                      lIdentifier,
+                                                      CommandPipeline::kAnswerVolume,
+                                                      [lApplicationController, lIdentifier]() { return (lApplicationController->ZoneIncreaseVolume(lIdentifier)); });
         nlEXPECT(lStatus >= 0, done);
     }
 
@@ -763,12 +893,98 @@ static bool shouldHideSection(const NSIndexPath *aIndexPath)
 - (void) setApplicationController: (MutableApplicationControllerPointer &)aApplicationController
                         forZone: (const HLX::Model::ZoneModel *)aZone
 {
+#if OPENHLX_INSTALLER
+    AppDelegate *              lDelegate = [AppDelegate sharedDelegate];
+    ZoneModel::IdentifierType  lZoneIdentifier;
+    Status                     lStatus;
+#endif // OPENHLX_INSTALLER
+
     mApplicationController = aApplicationController;
     mZone                = aZone;
+
+#if OPENHLX_INSTALLER
+    // In the staged refresh mode, the groups and zones view may have
+    // been presented before the installer-only zone properties
+    // (balance, sound mode, tone, equalizer bands, and crossovers)
+    // have arrived. Query this zone now, since this and the detail
+    // views reached from it are about to need them. This does not
+    // defer or skip anything in the refresh, which still fetches
+    // these for every zone, and the query may yet wait behind refresh
+    // requests the client controller has already sent.
+
+    nlEXPECT(![lDelegate refreshStageTracker].IsComplete(), done);
+
+    lStatus = mZone->GetIdentifier(lZoneIdentifier);
+    nlREQUIRE_SUCCESS(lStatus, done);
+
+    lStatus = mApplicationController->ZoneQuery(lZoneIdentifier);
+    nlREQUIRE_SUCCESS(lStatus, done);
+
+ done:
+    return;
+#endif // OPENHLX_INSTALLER
 }
 
 // MARK: Workers
 
+/**
+ *  @brief
+ *    Fade the zone volume from its current level to the specified
+ *    level over the specified number of seconds.
+ *
+ *  The current level is the one most recently submitted to the
+ *  command coalescer, if any, such that a fade started during or just
+ *  after a slider drag starts from where the slider was left.
+ *
+ *  @param[in]  aLevel    A pointer to the text of the volume level
+ *                        to fade to.
+ *  @param[in]  aSeconds  A pointer to the text of the number of
+ *                        seconds over which to fade.
+ *
+ */
+- (void) fadeVolumeToLevel: (NSString *)aLevel overSeconds: (NSString *)aSeconds
+{
+    AppDelegate *                       lDelegate = [AppDelegate sharedDelegate];
+    MutableApplicationControllerPointer lApplicationController = mApplicationController;
+    const NSInteger                     lTarget = [aLevel integerValue];
+    const double                        lSeconds = [aSeconds doubleValue];
+    ZoneModel::IdentifierType           lIdentifier;
+    VolumeModel::LevelType              lCurrent;
+    CommandCoalescer::ValueType         lCoalescedVolume;
+    Status                              lStatus;
+
+
+    nlEXPECT([aLevel length] > 0, done);
+    nlEXPECT((lTarget >= VolumeModel::kLevelMin) && (lTarget <= VolumeModel::kLevelMax), done);
+    nlEXPECT(lSeconds >= 0, done);
+
+    lStatus = mZone->GetIdentifier(lIdentifier);
+    nlREQUIRE_SUCCESS(lStatus, done);
+
+    lStatus = mZone->GetVolume(lCurrent);
+    nlREQUIRE_SUCCESS(lStatus, done);
+
+    lStatus = [lDelegate commandCoalescer].GetValue(CommandCoalescer::Key(CommandCoalescer::kKindZone, lIdentifier, CommandCoalescer::kPropertyVolume),
+                                                     lCoalescedVolume);
+    if (lStatus == kStatus_Success)
+    {
+        lCurrent = static_cast<VolumeModel::LevelType>(lCoalescedVolume);
+    }
+
+    lStatus = [lDelegate volumeFader].Start(VolumeFader::kKindZone,
+                                            lIdentifier,
+                                            lCurrent,
+                                            static_cast<VolumeModel::LevelType>(lTarget),
+                                            VolumeFader::Duration(static_cast<VolumeFader::Duration::rep>(lSeconds * 1000)),
+                                            [lApplicationController, lIdentifier](const VolumeFader::LevelType &aLevel) {
+                                                return (lApplicationController->ZoneSetVolume(lIdentifier, aLevel));
+                                            });
+    nlREQUIRE_SUCCESS(lStatus, done);
+
+ done:
+    return;
+}
+
 #if OPENHLX_INSTALLER
 - (void) refreshZoneBalance
 {
@@ -980,9 +1196,20 @@ static bool shouldHideSection(const NSIndexPath *aIndexPath)
     {
 
     case StateChange::kStateChangeType_SourceName:
-        // Refresh on any zone source name change
+        {
+            const StateChange::SourcesNameNotification &lSCN = static_cast<const StateChange::SourcesNameNotification &>(aStateChangeNotification);
+            SourceModel::IdentifierType lOurSourceIdentifier;
+            Status lStatus;
 
-        [self refreshZoneSourceName];
+            // Refresh only on a name change to the zone's own source.
+
+            lStatus = mZone->GetSource(lOurSourceIdentifier);
+            nlREQUIRE_SUCCESS(lStatus, done);
+
+            nlEXPECT(lSCN.GetIdentifier() == lOurSourceIdentifier, done);
+
+            [self refreshZoneSourceName];
+        }
         break;
 
 #if OPENHLX_INSTALLER
@@ -0,0 +1,878 @@
+/*
+ *    Copyright (c) 2026 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+
+/**
+ *  @file
+ *    This file implements a test that warm-start reconciliation
+ *    converges on the state of an HLX server.
+ *
+ *    The test connects to an HLX server, typically an instance of
+ *    _hlxlatencyd_ relaying to the openhlx _hlxsimd_ simulator, twice:
+ *    once as the app, once as another client making changes. As the
+ *    app, it queries every zone and saves the volume, mute, and
+ *    source of each as a snapshot. The other client then changes
+ *    some, leaving the snapshot stale, as a front panel or another
+ *    app might between sessions.
+ *
+ *    The app then warm starts from the snapshot and reconciles, as
+ *    the Open HLX refresh does, by querying each zone in turn and
+ *    applying everything the server sends, answers and unsolicited
+ *    changes alike, over the snapshot, while the other client makes
+ *    more changes. Once the reconciliation and any changes still in
+ *    flight have been applied, the result is checked against a fresh
+ *    query of every zone by the other client.
+ *
+ *    The test exits with failure if any property differs or if the
+ *    server does not answer in time.
+ *
+ *    The test models the reconciliation rather than running the app
+ *    code: its snapshot is its own, of zone volume, mute, and source
+ *    only, rather than the StateCacheController snapshot, and it
+ *    applies changes to its own model of the zones rather than to
+ *    the client controller model and the groups and zones table
+ *    view. Those are Objective-C and depend on UIKit and openhlx.
+ *    The test thus checks the protocol exchange that reconciliation
+ *    relies upon, that applying every answer and unsolicited change
+ *    in order converges, not the app's implementation of it.
+ *
+ *    Note that the test leaves the server zones changed; it is not
+ *    meant for HLX hardware in use.
+ *
+ *    The test depends only on POSIX and the C++ Standard Library and
+ *    may be built on Linux or macOS with:
+ *
+ *      % c++ -std=c++11 -O2 -o hlxconvergetest Tools/hlxconvergetest/hlxconvergetest.cpp
+ *
+ */
+
+#include <chrono>
+#include <map>
+#include <random>
+#include <string>
+#include <utility>
+
+#include <errno.h>
+#include <getopt.h>
+#include <netdb.h>
+#include <poll.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+
+namespace
+{
+
+typedef std::chrono::steady_clock  Clock;
+typedef std::chrono::milliseconds  Duration;
+
+/**
+ *  The test configuration, as established from the command line.
+ *
+ */
+struct Options
+{
+    std::string    mHost;
+    std::string    mPort;
+    unsigned long  mZones;
+    unsigned long  mSources;
+    unsigned long  mStale;
+    unsigned long  mDuring;
+    unsigned long  mSeed;
+    Duration       mSettle;
+    Duration       mTimeout;
+};
+
+/**
+ *  A zone property rendered by the groups and zones view.
+ *
+ */
+enum Property
+{
+    kPropertyVolume = 0,
+    kPropertyMute,
+    kPropertySource,
+
+    kPropertyMax
+};
+
+/**
+ *  The zone property values known to a client, by zone and property.
+ *
+ */
+typedef std::map<std::pair<unsigned int, Property>, int> State;
+
+/**
+ *  A connection to the server and the output received but not yet
+ *  framed.
+ *
+ */
+struct Connection
+{
+    int          mDescriptor;
+    std::string  mBuffer;
+};
+
+const char * const   kDefaultHost     = "localhost";
+const char * const   kDefaultPort     = "2323";
+
+// HLX hardware has twenty-four zones and eight sources.
+
+const unsigned long  kDefaultZones    = 24;
+const unsigned long  kDefaultSources  = 8;
+const unsigned long  kDefaultStale    = 16;
+const unsigned long  kDefaultDuring   = 16;
+const unsigned long  kDefaultSeed     = 1;
+const long           kDefaultSettleMs = 1000;
+
+// At a character at a time, a full zone query may take the better
+// part of a second; allow plenty more.
+
+const long           kDefaultTimeoutMs = 10000;
+
+const int            kVolumeMin = -80;
+const int            kVolumeMax = 0;
+
+const size_t         kReadBufferSize = 4096;
+
+Options              sOptions;
+
+// MARK: Logging
+
+void
+Log(const char *aFormat, ...)
+{
+    va_list lArguments;
+
+    va_start(lArguments, aFormat);
+    vfprintf(stderr, aFormat, lArguments);
+    va_end(lArguments);
+}
+
+long long
+Milliseconds(const Clock::duration &aDuration)
+{
+    return (static_cast<long long>(std::chrono::duration_cast<std::chrono::milliseconds>(aDuration).count()));
+}
+
+// MARK: Option Parsing
+
+void
+Usage(const char *aProgram, FILE *aStream)
+{
+    fprintf(aStream,
+            "Usage: %s [ options ]\n"
+            "\n"
+            "Test that warm-start reconciliation from a stale snapshot converges\n"
+            "on the state of an HLX server.\n"
+            "\n"
+            "The snapshot and zone model are the test's own, of zone volume,\n"
+            "mute, and source only; the app's state cache and groups and zones\n"
+            "view are not exercised.\n"
+            "\n"
+            " -c, --connect <host>[:<port>]\n"
+            "                             Connect to the specified HLX server\n"
+            "                             (default: %s:%s).\n"
+            " -d, --during <count>        Changes made during reconciliation\n"
+            "                             (default: %lu).\n"
+            " -h, --help                  Print this help and exit.\n"
+            " -r, --seed <seed>           Random seed (default: %lu).\n"
+            " -s, --sources <count>       Number of sources (default: %lu).\n"
+            " -S, --settle <ms>           Time to apply changes still in flight\n"
+            "                             after reconciliation (default: %ld ms).\n"
+            " -t, --stale <count>         Changes made after the snapshot\n"
+            "                             (default: %lu).\n"
+            " -T, --timeout <ms>          Time to wait for each answer (default:\n"
+            "                             %ld ms).\n"
+            " -z, --zones <count>         Number of zones (default: %lu).\n",
+            aProgram,
+            kDefaultHost,
+            kDefaultPort,
+            kDefaultDuring,
+            kDefaultSeed,
+            kDefaultSources,
+            kDefaultSettleMs,
+            kDefaultStale,
+            kDefaultTimeoutMs,
+            kDefaultZones);
+}
+
+bool
+ParseCount(const char *aString, const unsigned long &aMinimum, const unsigned long &aMaximum, unsigned long &aCount)
+{
+    char *  lEnd;
+    bool    lRetval;
+
+    aCount = strtoul(aString, &lEnd, 10);
+
+    lRetval = ((*aString != '\0') && (*lEnd == '\0') && (aCount >= aMinimum) && (aCount <= aMaximum));
+
+    return (lRetval);
+}
+
+bool
+ParseMilliseconds(const char *aString, Duration &aDuration)
+{
+    unsigned long  lMilliseconds;
+    bool           lRetval;
+
+    lRetval = ParseCount(aString, 0, 3600000, lMilliseconds);
+
+    if (lRetval)
+    {
+        aDuration = Duration(static_cast<Duration::rep>(lMilliseconds));
+    }
+
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Split a host and optional port, in the form "host", "host:port",
+ *    "[v6-address]", or "[v6-address]:port".
+ *
+ */
+void
+ParseHostAndPort(const char *aString, std::string &aHost, std::string &aPort)
+{
+    const std::string  lString(aString);
+    size_t             lColon;
+
+    if ((lString.size() > 0) && (lString[0] == '['))
+    {
+        const size_t lClose = lString.find(']');
+
+        aHost = lString.substr(1, lClose - 1);
+
+        if ((lClose != std::string::npos) && ((lClose + 1) < lString.size()) && (lString[lClose + 1] == ':'))
+        {
+            aPort = lString.substr(lClose + 2);
+        }
+    }
+    else if (((lColon = lString.rfind(':')) != std::string::npos) && (lString.find(':') == lColon))
+    {
+        aHost = lString.substr(0, lColon);
+        aPort = lString.substr(lColon + 1);
+    }
+    else
+    {
+        aHost = lString;
+    }
+}
+
+bool
+ParseOptions(int argc, char * const argv[])
+{
+    static const struct option sLongOptions[] =
+    {
+        { "connect",         required_argument, nullptr, 'c' },
+        { "during",          required_argument, nullptr, 'd' },
+        { "help",            no_argument,       nullptr, 'h' },
+        { "seed",            required_argument, nullptr, 'r' },
+        { "sources",         required_argument, nullptr, 's' },
+        { "settle",          required_argument, nullptr, 'S' },
+        { "stale",           required_argument, nullptr, 't' },
+        { "timeout",         required_argument, nullptr, 'T' },
+        { "zones",           required_argument, nullptr, 'z' },
+        { nullptr,           0,                 nullptr, 0   }
+    };
+    int   lOption;
+    bool  lRetval = true;
+
+    sOptions.mHost    = kDefaultHost;
+    sOptions.mPort    = kDefaultPort;
+    sOptions.mZones   = kDefaultZones;
+    sOptions.mSources = kDefaultSources;
+    sOptions.mStale   = kDefaultStale;
+    sOptions.mDuring  = kDefaultDuring;
+    sOptions.mSeed    = kDefaultSeed;
+    sOptions.mSettle  = Duration(kDefaultSettleMs);
+    sOptions.mTimeout = Duration(kDefaultTimeoutMs);
+
+    while (lRetval && ((lOption = getopt_long(argc, argv, "c:d:hr:s:S:t:T:z:", sLongOptions, nullptr)) != -1))
+    {
+        switch (lOption)
+        {
+
+        case 'c':
+            ParseHostAndPort(optarg, sOptions.mHost, sOptions.mPort);
+            break;
+
+        case 'd':
+            lRetval = ParseCount(optarg, 0, 100000, sOptions.mDuring);
+            break;
+
+        case 'h':
+            Usage(argv[0], stdout);
+            exit(EXIT_SUCCESS);
+            break;
+
+        case 'r':
+            lRetval = ParseCount(optarg, 0, 0xFFFFFFFF, sOptions.mSeed);
+            break;
+
+        case 's':
+            lRetval = ParseCount(optarg, 1, 255, sOptions.mSources);
+            break;
+
+        case 'S':
+            lRetval = ParseMilliseconds(optarg, sOptions.mSettle);
+            break;
+
+        case 't':
+            lRetval = ParseCount(optarg, 0, 100000, sOptions.mStale);
+            break;
+
+        case 'T':
+            lRetval = ParseMilliseconds(optarg, sOptions.mTimeout);
+            break;
+
+        case 'z':
+            lRetval = ParseCount(optarg, 1, 255, sOptions.mZones);
+            break;
+
+        default:
+            lRetval = false;
+            break;
+
+        }
+    }
+
+    lRetval = (lRetval && (optind == argc) && !sOptions.mHost.empty() && !sOptions.mPort.empty());
+
+    if (!lRetval)
+    {
+        Usage(argv[0], stderr);
+    }
+
+    return (lRetval);
+}
+
+// MARK: Sockets
+
+/**
+ *  @brief
+ *    Open a connection to the specified host and port.
+ *
+ *  @returns
+ *    True if connected; otherwise, false.
+ *
+ */
+bool
+Connect(const std::string &aHost, const std::string &aPort, Connection &aConnection)
+{
+    struct addrinfo   lHints;
+    struct addrinfo * lAddresses = nullptr;
+    struct addrinfo * lAddress;
+    int               lStatus;
+
+    aConnection.mDescriptor = -1;
+    aConnection.mBuffer.clear();
+
+    memset(&lHints, 0, sizeof (lHints));
+
+    lHints.ai_family   = AF_UNSPEC;
+    lHints.ai_socktype = SOCK_STREAM;
+
+    lStatus = getaddrinfo(aHost.c_str(), aPort.c_str(), &lHints, &lAddresses);
+
+    if (lStatus != 0)
+    {
+        Log("Could not resolve %s:%s: %s\n", aHost.c_str(), aPort.c_str(), gai_strerror(lStatus));
+    }
+
+    for (lAddress = lAddresses; (lStatus == 0) && (lAddress != nullptr) && (aConnection.mDescriptor == -1); lAddress = lAddress->ai_next)
+    {
+        aConnection.mDescriptor = socket(lAddress->ai_family, lAddress->ai_socktype, lAddress->ai_protocol);
+
+        if ((aConnection.mDescriptor != -1) && (connect(aConnection.mDescriptor, lAddress->ai_addr, lAddress->ai_addrlen) != 0))
+        {
+            close(aConnection.mDescriptor);
+
+            aConnection.mDescriptor = -1;
+        }
+    }
+
+    if ((lStatus == 0) && (aConnection.mDescriptor == -1))
+    {
+        Log("Could not connect to %s:%s: %s\n", aHost.c_str(), aPort.c_str(), strerror(errno));
+    }
+
+    if (lAddresses != nullptr)
+    {
+        freeaddrinfo(lAddresses);
+    }
+
+    return (aConnection.mDescriptor != -1);
+}
+
+/**
+ *  @brief
+ *    Send the specified, formatted, request frame.
+ *
+ *  @returns
+ *    True if all of the frame was written; otherwise, false.
+ *
+ */
+bool
+Send(const Connection &aConnection, const char *aFormat, ...)
+{
+    char     lFrame[64];
+    va_list  lArguments;
+    int      lLength;
+    ssize_t  lWritten = 0;
+    size_t   lOffset = 0;
+
+    va_start(lArguments, aFormat);
+    lLength = vsnprintf(lFrame, sizeof (lFrame), aFormat, lArguments);
+    va_end(lArguments);
+
+    while ((lLength > 0) && (lOffset < static_cast<size_t>(lLength)) && (lWritten >= 0))
+    {
+        lWritten = write(aConnection.mDescriptor, &lFrame[lOffset], static_cast<size_t>(lLength) - lOffset);
+
+        if (lWritten > 0)
+        {
+            lOffset += static_cast<size_t>(lWritten);
+        }
+        else if ((lWritten < 0) && (errno == EINTR))
+        {
+            lWritten = 0;
+        }
+    }
+
+    return ((lLength > 0) && (lOffset == static_cast<size_t>(lLength)));
+}
+
+/**
+ *  @brief
+ *    Receive the next response frame, "(...)", by the specified
+ *    deadline.
+ *
+ *  Anything outside of a frame, such as line endings, is
+ *  discarded. Quoted names within a frame may themselves contain
+ *  parentheses.
+ *
+ *  @returns
+ *    True if a frame was received; otherwise, false, on timeout,
+ *    error, or disconnection.
+ *
+ */
+bool
+Receive(Connection &aConnection, const Clock::time_point &aDeadline, std::string &aFrame)
+{
+    bool  lRetval = false;
+    bool  lDone = false;
+
+    while (!lDone)
+    {
+        const size_t  lOpen = aConnection.mBuffer.find('(');
+        bool          lQuoted = false;
+        size_t        lClose = std::string::npos;
+
+        for (size_t lIndex = lOpen; (lOpen != std::string::npos) && (lIndex < aConnection.mBuffer.size()) && (lClose == std::string::npos); lIndex++)
+        {
+            if (aConnection.mBuffer[lIndex] == '"')
+            {
+                lQuoted = !lQuoted;
+            }
+            else if ((aConnection.mBuffer[lIndex] == ')') && !lQuoted)
+            {
+                lClose = lIndex;
+            }
+        }
+
+        if (lClose != std::string::npos)
+        {
+            aFrame = aConnection.mBuffer.substr(lOpen, lClose - lOpen + 1);
+            aConnection.mBuffer.erase(0, lClose + 1);
+
+            lRetval = true;
+            lDone   = true;
+        }
+        else
+        {
+            const Clock::time_point  lNow = Clock::now();
+            struct pollfd            lDescriptor = { aConnection.mDescriptor, POLLIN, 0 };
+            char                     lBuffer[kReadBufferSize];
+            int                      lStatus;
+            ssize_t                  lRead;
+
+            lStatus = ((lNow < aDeadline) ? poll(&lDescriptor, 1, static_cast<int>(Milliseconds(aDeadline - lNow)) + 1) : 0);
+
+            if (lStatus > 0)
+            {
+                lRead = read(aConnection.mDescriptor, lBuffer, sizeof (lBuffer));
+
+                if (lRead > 0)
+                {
+                    aConnection.mBuffer.append(lBuffer, static_cast<size_t>(lRead));
+                }
+                else if ((lRead == 0) || (errno != EINTR))
+                {
+                    lDone = true;
+                }
+            }
+            else if ((lStatus == 0) || (errno != EINTR))
+            {
+                lDone = true;
+            }
+        }
+    }
+
+    return (lRetval);
+}
+
+// MARK: Protocol
+
+// Parse a response frame in the specified format, with exactly the
+// specified number of conversions, as the whole frame.
+
+bool
+Parse(const std::string &aFrame, const char *aFormat, const int &aConversions, unsigned int &aZone, int &aValue)
+{
+    int   lEnd = -1;
+    bool  lRetval;
+
+    if (aConversions == 1)
+    {
+        lRetval = ((sscanf(aFrame.c_str(), aFormat, &aZone, &lEnd) == 1));
+    }
+    else
+    {
+        lRetval = ((sscanf(aFrame.c_str(), aFormat, &aZone, &aValue, &lEnd) == 2));
+    }
+
+    lRetval = (lRetval && (lEnd == static_cast<int>(aFrame.size())));
+
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Apply the specified response frame, if it reports a zone
+ *    volume, mute, or source, to the specified state.
+ *
+ */
+void
+Apply(const std::string &aFrame, State &aState)
+{
+    unsigned int  lZone;
+    int           lValue;
+
+    if (Parse(aFrame, "(VO%uR%d)%n", 2, lZone, lValue))
+    {
+        aState[std::make_pair(lZone, kPropertyVolume)] = lValue;
+    }
+    else if (Parse(aFrame, "(VMO%u)%n", 1, lZone, lValue))
+    {
+        aState[std::make_pair(lZone, kPropertyMute)] = 1;
+    }
+    else if (Parse(aFrame, "(VUMO%u)%n", 1, lZone, lValue))
+    {
+        aState[std::make_pair(lZone, kPropertyMute)] = 0;
+    }
+    else if (Parse(aFrame, "(CO%uI%d)%n", 2, lZone, lValue))
+    {
+        aState[std::make_pair(lZone, kPropertySource)] = lValue;
+    }
+}
+
+/**
+ *  @brief
+ *    Query the specified zone, applying everything received until
+ *    the query is answered to the specified state.
+ *
+ *  @returns
+ *    True if the query was answered in time; otherwise, false.
+ *
+ */
+bool
+Query(Connection &aConnection, const unsigned int &aZone, State &aState)
+{
+    const Clock::time_point  lDeadline = Clock::now() + sOptions.mTimeout;
+    char                     lAnswer[32];
+    std::string              lFrame;
+    bool                     lRetval;
+
+    snprintf(lAnswer, sizeof (lAnswer), "(QO%u)", aZone);
+
+    lRetval = Send(aConnection, "[QO%u]", aZone);
+
+    while (lRetval && (lRetval = Receive(aConnection, lDeadline, lFrame)) && (lFrame != lAnswer))
+    {
+        Apply(lFrame, aState);
+    }
+
+    if (!lRetval)
+    {
+        Log("Zone %u query was not answered\n", aZone);
+    }
+
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Query every zone into the specified state.
+ *
+ */
+bool
+QueryAll(Connection &aConnection, State &aState)
+{
+    bool  lRetval = true;
+
+    for (unsigned int lZone = 1; lRetval && (lZone <= sOptions.mZones); lZone++)
+    {
+        lRetval = Query(aConnection, lZone, aState);
+    }
+
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Change a random property of a random zone to a random value,
+ *    waiting for the change to be answered.
+ *
+ *  @returns
+ *    True if the change was answered in time; otherwise, false.
+ *
+ */
+bool
+Change(Connection &aConnection, std::mt19937 &aGenerator)
+{
+    const Clock::time_point  lDeadline = Clock::now() + sOptions.mTimeout;
+    const unsigned int       lZone = std::uniform_int_distribution<unsigned int>(1, static_cast<unsigned int>(sOptions.mZones))(aGenerator);
+    const int                lProperty = std::uniform_int_distribution<int>(kPropertyVolume, kPropertyMax - 1)(aGenerator);
+    char                     lRequest[32];
+    char                     lAnswer[32];
+    std::string              lFrame;
+    bool                     lRetval;
+
+    if (lProperty == kPropertyVolume)
+    {
+        const int lVolume = std::uniform_int_distribution<int>(kVolumeMin, kVolumeMax)(aGenerator);
+
+        snprintf(lRequest, sizeof (lRequest), "[VO%uR%d]", lZone, lVolume);
+        snprintf(lAnswer,  sizeof (lAnswer),  "(VO%uR%d)", lZone, lVolume);
+    }
+    else if (lProperty == kPropertyMute)
+    {
+        const bool lMute = (std::uniform_int_distribution<int>(0, 1)(aGenerator) != 0);
+
+        snprintf(lRequest, sizeof (lRequest), "[V%sMO%u]", (lMute ? "" : "U"), lZone);
+        snprintf(lAnswer,  sizeof (lAnswer),  "(V%sMO%u)", (lMute ? "" : "U"), lZone);
+    }
+    else
+    {
+        const unsigned int lSource = std::uniform_int_distribution<unsigned int>(1, static_cast<unsigned int>(sOptions.mSources))(aGenerator);
+
+        snprintf(lRequest, sizeof (lRequest), "[CO%uI%u]", lZone, lSource);
+        snprintf(lAnswer,  sizeof (lAnswer),  "(CO%uI%u)", lZone, lSource);
+    }
+
+    lRetval = Send(aConnection, "%s", lRequest);
+
+    while (lRetval && (lRetval = Receive(aConnection, lDeadline, lFrame)) && (lFrame != lAnswer))
+    {
+        continue;
+    }
+
+    if (!lRetval)
+    {
+        Log("%s was not answered\n", lRequest);
+    }
+
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Apply everything received over the settle time to the specified
+ *    state.
+ *
+ */
+void
+Settle(Connection &aConnection, State &aState)
+{
+    const Clock::time_point  lDeadline = Clock::now() + sOptions.mSettle;
+    std::string              lFrame;
+
+    while (Receive(aConnection, lDeadline, lFrame))
+    {
+        Apply(lFrame, aState);
+    }
+}
+
+/**
+ *  @brief
+ *    Return the number of properties in the specified expected state
+ *    that differ, or are missing, in the specified actual state.
+ *
+ */
+size_t
+Compare(const State &aExpected, const State &aActual, const bool &aLog)
+{
+    size_t  lRetval = 0;
+
+    for (State::const_iterator lExpected = aExpected.begin(); lExpected != aExpected.end(); lExpected++)
+    {
+        const State::const_iterator lActual = aActual.find(lExpected->first);
+
+        if ((lActual == aActual.end()) || (lActual->second != lExpected->second))
+        {
+            if (aLog)
+            {
+                Log("Zone %u property %d is %d; expected %d\n",
+                    lExpected->first.first,
+                    lExpected->first.second,
+                    ((lActual == aActual.end()) ? -1 : lActual->second),
+                    lExpected->second);
+            }
+
+            lRetval++;
+        }
+    }
+
+    return (lRetval);
+}
+
+// MARK: Test
+
+/**
+ *  @brief
+ *    Snapshot, stale, warm start, and reconcile, as described above,
+ *    and check the result.
+ *
+ */
+bool
+Run(Connection &aApp, Connection &aOther)
+{
+    std::mt19937             lGenerator(static_cast<std::mt19937::result_type>(sOptions.mSeed));
+    State                    lSnapshot;
+    State                    lView;
+    State                    lTruth;
+    unsigned long            lDuring = 0;
+    size_t                   lStale;
+    size_t                   lDiffering;
+    Clock::time_point        lStart;
+    Clock::duration          lReconciled;
+    bool                     lRetval;
+
+    // Save a snapshot and leave it stale.
+
+    lRetval = QueryAll(aApp, lSnapshot);
+
+    for (unsigned long lChange = 0; lRetval && (lChange < sOptions.mStale); lChange++)
+    {
+        lRetval = Change(aOther, lGenerator);
+    }
+
+    // Let the app see, and discard, the notifications of the stale
+    // changes, as it would have while disconnected.
+
+    if (lRetval)
+    {
+        Settle(aApp, lTruth);
+
+        lTruth.clear();
+    }
+
+    // Warm start from the snapshot and reconcile, zone by zone, while
+    // the other client makes more changes.
+
+    lView  = lSnapshot;
+    lStart = Clock::now();
+
+    for (unsigned int lZone = 1; lRetval && (lZone <= sOptions.mZones); lZone++)
+    {
+        const unsigned long lDue = ((sOptions.mDuring * lZone) / sOptions.mZones);
+
+        for (; lRetval && (lDuring < lDue); lDuring++)
+        {
+            lRetval = Change(aOther, lGenerator);
+        }
+
+        lRetval = (lRetval && Query(aApp, lZone, lView));
+    }
+
+    lReconciled = (Clock::now() - lStart);
+
+    if (lRetval)
+    {
+        Settle(aApp, lView);
+
+        lRetval = QueryAll(aOther, lTruth);
+    }
+
+    if (lRetval)
+    {
+        lStale     = Compare(lTruth, lSnapshot, false);
+        lDiffering = Compare(lTruth, lView, true);
+
+        printf("%zu properties of %lu zones; %zu in the snapshot stale after %lu changes\n",
+               lTruth.size(),
+               sOptions.mZones,
+               lStale,
+               (sOptions.mStale + sOptions.mDuring));
+        printf("reconciled in %lld ms with %lu changes during; %zu differ\n",
+               Milliseconds(lReconciled),
+               sOptions.mDuring,
+               lDiffering);
+
+        lRetval = ((lTruth.size() == (sOptions.mZones * kPropertyMax)) && (lDiffering == 0));
+    }
+
+    return (lRetval);
+}
+
+}; // namespace
+
+int
+main(int argc, char * const argv[])
+{
+    Connection  lApp = { -1, std::string() };
+    Connection  lOther = { -1, std::string() };
+    int         lRetval = EXIT_FAILURE;
+
+    if (ParseOptions(argc, argv) &&
+        Connect(sOptions.mHost, sOptions.mPort, lApp) &&
+        Connect(sOptions.mHost, sOptions.mPort, lOther) &&
+        Run(lApp, lOther))
+    {
+        lRetval = EXIT_SUCCESS;
+    }
+
+    if (lApp.mDescriptor != -1)
+    {
+        close(lApp.mDescriptor);
+    }
+
+    if (lOther.mDescriptor != -1)
+    {
+        close(lOther.mDescriptor);
+    }
+
+    return (lRetval);
+}
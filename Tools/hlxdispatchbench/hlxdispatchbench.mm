@@ -0,0 +1,386 @@
+/*
+ *    Copyright (c) 2026 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *  @file
+ *    This file implements a microbenchmark for the dispatch of HLX
+ *    client controller delegations to Objective C delegate objects.
+ *
+ *    The app bridges client controller delegations to Objective C
+ *    objects with ApplicationControllerDelegate, which forwards each
+ *    one only where the object responds to the corresponding optional
+ *    protocol method. The benchmark pushes synthetic state change
+ *    notifications through a reduced copy of that bridge, asking
+ *    whether the object responds on each delegation as the bridge
+ *    once did, and through one resolving it once, when the object is
+ *    bound, as the bridge now does. It does so both for an object that
+ *    observes state changes and for one that does not and reports the
+ *    time per notification for each.
+ *
+ *    The bridge itself depends on openhlx, such that the benchmark
+ *    reproduces only its dispatch, with a notification standing in
+ *    for HLX::Client::StateChange::NotificationBasis.
+ *
+ *    The benchmark depends on POSIX, the C++ Standard Library, and the
+ *    Objective C runtime and Foundation and may be built, from the top
+ *    of the package, on macOS with:
+ *
+ *      % c++ -std=c++11 -O2 -fobjc-arc -o hlxdispatchbench Tools/hlxdispatchbench/hlxdispatchbench.mm -framework Foundation
+ *
+ */
+
+#include <algorithm>
+#include <chrono>
+
+#include <getopt.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <Foundation/Foundation.h>
+
+
+namespace
+{
+
+/**
+ *  A synthetic state change notification, standing in for a zone
+ *  volume change.
+ *
+ */
+struct Notification
+{
+    uint8_t  mIdentifier;
+    int8_t   mLevel;
+};
+
+};
+
+@protocol BenchmarkDelegate <NSObject>
+
+@optional
+
+- (void) stateDidChange: (const Notification &)aNotification;
+
+@end
+
+/**
+ *  A delegate object that observes state changes, as the group and
+ *  zone views do.
+ *
+ */
+@interface Observer : NSObject <BenchmarkDelegate>
+{
+@public
+    unsigned long  mCount;
+}
+
+- (void) stateDidChange: (const Notification &)aNotification;
+
+@end
+
+@implementation Observer
+
+- (void) stateDidChange: (const Notification &)aNotification
+{
+    mCount += static_cast<unsigned long>(aNotification.mIdentifier);
+}
+
+@end
+
+/**
+ *  A delegate object that does not observe state changes, as the
+ *  connect views do not.
+ *
+ */
+@interface Bystander : NSObject <BenchmarkDelegate>
+
+@end
+
+@implementation Bystander
+
+@end
+
+namespace
+{
+
+typedef std::chrono::steady_clock  Clock;
+typedef std::chrono::nanoseconds   Duration;
+
+/**
+ *  The base for each bridge, standing in for the client controller
+ *  delegate interface the bridge implements.
+ *
+ */
+class Bridge
+{
+public:
+    virtual ~Bridge(void) { }
+
+    virtual void StateDidChange(const Notification &aNotification) = 0;
+};
+
+/**
+ *  A bridge that asks whether its object responds on each delegation.
+ *
+ */
+class SelectorBridge :
+    public Bridge
+{
+public:
+    SelectorBridge(id<BenchmarkDelegate> aObject) :
+        mObject(aObject)
+    {
+        return;
+    }
+
+    void StateDidChange(const Notification &aNotification) final
+    {
+        const SEL lSelector = @selector(stateDidChange:);
+
+        if ([mObject respondsToSelector: lSelector])
+        {
+            [mObject stateDidChange: aNotification];
+        }
+    }
+
+private:
+    id<BenchmarkDelegate>  mObject;
+};
+
+/**
+ *  A bridge that resolves whether its object responds once, when the
+ *  object is bound.
+ *
+ */
+class CachedBridge :
+    public Bridge
+{
+public:
+    enum : uint32_t
+    {
+        kRespondsNone           = 0,
+        kRespondsStateDidChange = 1 << 0
+    };
+
+    CachedBridge(id<BenchmarkDelegate> aObject) :
+        mObject(aObject),
+        mResponds([aObject respondsToSelector: @selector(stateDidChange:)] ? kRespondsStateDidChange : kRespondsNone)
+    {
+        return;
+    }
+
+    void StateDidChange(const Notification &aNotification) final
+    {
+        if (mResponds & kRespondsStateDidChange)
+        {
+            [mObject stateDidChange: aNotification];
+        }
+    }
+
+private:
+    id<BenchmarkDelegate>  mObject;
+    uint32_t               mResponds;
+};
+
+/**
+ *  The benchmark configuration, as established from the command
+ *  line.
+ *
+ */
+struct Options
+{
+    unsigned long  mNotifications;
+    unsigned long  mPasses;
+};
+
+const unsigned long  kDefaultNotifications = 300000;
+const unsigned long  kDefaultPasses        = 5;
+
+Options              sOptions;
+
+// MARK: Option Parsing
+
+void
+Usage(const char *aProgram, FILE *aStream)
+{
+    fprintf(aStream,
+            "Usage: %s [ options ]\n"
+            "\n"
+            "Benchmark the dispatch of synthetic state change notifications\n"
+            "to Objective C delegate objects, asking whether the object\n"
+            "responds on each against resolving it once.\n"
+            "\n"
+            " -h, --help                    Print this help and exit.\n"
+            " -n, --notifications <count>   Number of notifications per pass\n"
+            "                               (default: %lu).\n"
+            " -p, --passes <count>          Number of passes, of which the fastest\n"
+            "                               is reported (default: %lu).\n",
+            aProgram,
+            kDefaultNotifications,
+            kDefaultPasses);
+}
+
+bool
+ParseCount(const char *aString, const unsigned long &aMinimum, const unsigned long &aMaximum, unsigned long &aCount)
+{
+    char *  lEnd;
+    bool    lRetval;
+
+    aCount = strtoul(aString, &lEnd, 10);
+
+    lRetval = ((*aString != '\0') && (*lEnd == '\0') && (aCount >= aMinimum) && (aCount <= aMaximum));
+
+    return (lRetval);
+}
+
+bool
+ParseOptions(int argc, char * const argv[])
+{
+    static const struct option sLongOptions[] =
+    {
+        { "help",          no_argument,       nullptr, 'h' },
+        { "notifications", required_argument, nullptr, 'n' },
+        { "passes",        required_argument, nullptr, 'p' },
+        { nullptr,         0,                 nullptr, 0   }
+    };
+    int   lOption;
+    bool  lRetval = true;
+
+    sOptions.mNotifications = kDefaultNotifications;
+    sOptions.mPasses        = kDefaultPasses;
+
+    while (lRetval && ((lOption = getopt_long(argc, argv, "hn:p:", sLongOptions, nullptr)) != -1))
+    {
+        switch (lOption)
+        {
+
+        case 'h':
+            Usage(argv[0], stdout);
+            exit(EXIT_SUCCESS);
+            break;
+
+        case 'n':
+            lRetval = ParseCount(optarg, 1, 1000000000, sOptions.mNotifications);
+            break;
+
+        case 'p':
+            lRetval = ParseCount(optarg, 1, 1000, sOptions.mPasses);
+            break;
+
+        default:
+            lRetval = false;
+            break;
+
+        }
+    }
+
+    lRetval = (lRetval && (optind == argc));
+
+    if (!lRetval)
+    {
+        Usage(argv[0], stderr);
+    }
+
+    return (lRetval);
+}
+
+// MARK: Benchmarking
+
+/**
+ *  Push the configured number of notifications through the bridge,
+ *  once for each pass, and return the time per notification of the
+ *  fastest pass.
+ *
+ */
+double
+Run(Bridge &aBridge)
+{
+    Notification  lNotification;
+    Duration      lFastest = Duration::max();
+
+    for (unsigned long lPass = 0; lPass < sOptions.mPasses; lPass++)
+    {
+        const Clock::time_point lStart = Clock::now();
+
+        for (unsigned long lCount = 0; lCount < sOptions.mNotifications; lCount++)
+        {
+            lNotification.mIdentifier = static_cast<uint8_t>(lCount % 24) + 1;
+            lNotification.mLevel      = -static_cast<int8_t>(lCount % 80);
+
+            aBridge.StateDidChange(lNotification);
+        }
+
+        lFastest = std::min(lFastest, std::chrono::duration_cast<Duration>(Clock::now() - lStart));
+    }
+
+    return (static_cast<double>(lFastest.count()) / static_cast<double>(sOptions.mNotifications));
+}
+
+void
+Report(const char *aObjectName, id<BenchmarkDelegate> aObject)
+{
+    SelectorBridge  lSelectorBridge(aObject);
+    CachedBridge    lCachedBridge(aObject);
+    double          lSelectorTime;
+    double          lCachedTime;
+
+    lSelectorTime = Run(lSelectorBridge);
+    lCachedTime   = Run(lCachedBridge);
+
+    printf("%-10s %14.2f %14.2f %9.2fx\n",
+           aObjectName,
+           lSelectorTime,
+           lCachedTime,
+           (lCachedTime > 0) ? (lSelectorTime / lCachedTime) : 0.0);
+}
+
+}; // namespace
+
+int
+main(int argc, char * const argv[])
+{
+    int lRetval = EXIT_FAILURE;
+
+    if (ParseOptions(argc, argv))
+    {
+        @autoreleasepool
+        {
+            Observer *   lObserver  = [[Observer alloc] init];
+            Bystander *  lBystander = [[Bystander alloc] init];
+
+            printf("%lu notifications, fastest of %lu passes, in ns per notification:\n\n",
+                   sOptions.mNotifications,
+                   sOptions.mPasses);
+
+            printf("%-10s %14s %14s %10s\n", "object", "per-selector", "cached", "speedup");
+
+            Report("observer", lObserver);
+            Report("bystander", lBystander);
+
+            // Keep the observer work live such that it is not
+            // optimized away.
+
+            printf("\n(observed %lu)\n", lObserver->mCount);
+        }
+
+        lRetval = EXIT_SUCCESS;
+    }
+
+    return (lRetval);
+}
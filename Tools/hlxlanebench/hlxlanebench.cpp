@@ -0,0 +1,433 @@
+/*
+ *    Copyright (c) 2026 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *  @file
+ *    This file implements a benchmark of the latency of interactive
+ *    HLX commands under a saturated background refresh.
+ *
+ *    The benchmark simulates an HLX peer that answers requests one at
+ *    a time, in the order issued, each taking its bytes on the wire at
+ *    a configurable per-character delay. Refresh zone queries are kept
+ *    queued back to back, as a long refresh or session resume does,
+ *    while interactive mutes arrive at random. Commands are issued
+ *    into a fixed window by the command scheduler, either with the
+ *    queries and mutes in their own lanes or, for comparison, both in
+ *    a single first-in, first-out lane.
+ *
+ *    For each, it reports the latency percentiles of the mutes, from
+ *    when each is enqueued to when it is answered, and the throughput
+ *    of the queries.
+ *
+ *    The benchmark depends only on POSIX and the C++ Standard Library
+ *    and may be built, from the top of the package, on Linux or macOS
+ *    with:
+ *
+ *      % c++ -std=c++11 -O2 -I Source -o hlxlanebench Tools/hlxlanebench/hlxlanebench.cpp Source/CommandScheduler.cpp
+ *
+ */
+
+#include <algorithm>
+#include <deque>
+#include <random>
+#include <vector>
+
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "CommandScheduler.hpp"
+
+
+namespace
+{
+
+/**
+ *  The benchmark configuration, as established from the command
+ *  line.
+ *
+ */
+struct Options
+{
+    unsigned long  mInteractive;
+    unsigned long  mRefresh;
+    unsigned long  mWindow;
+    unsigned long  mSeed;
+    double         mCharacterDelayMs;
+    double         mMeanIntervalMs;
+    unsigned long  mQueryBytes;
+    unsigned long  mMuteBytes;
+};
+
+/**
+ *  A simulated command: when it was enqueued, whether it is an
+ *  interactive mute or a background query, and its bytes on the
+ *  wire, request and response.
+ *
+ */
+struct Command
+{
+    double         mEnqueued;
+    bool           mIsInteractive;
+    unsigned long  mBytes;
+};
+
+/**
+ *  A command in flight and when the peer will have answered it.
+ *
+ */
+struct InFlight
+{
+    Command  mCommand;
+    double   mAnswered;
+};
+
+/**
+ *  The outcome of a run.
+ *
+ */
+struct Result
+{
+    std::vector<double>  mLatencies;
+    unsigned long        mQueries;
+    double               mElapsed;
+};
+
+const unsigned long  kDefaultInteractive      = 1000;
+const unsigned long  kDefaultRefresh          = 300;
+const unsigned long  kDefaultWindow           = 1;
+const unsigned long  kDefaultSeed             = 1;
+
+// The default per-character delay approximates the observed
+// character-at-a-time output rate of real HLX hardware.
+
+const double         kDefaultCharacterDelayMs = 1.0;
+const double         kDefaultMeanIntervalMs   = 2000.0;
+
+// A zone query, "[QO12]", is answered with a line for each zone
+// property, including, on installer builds, each equalizer band; a
+// mute, "[VMO12]", with a single "(VMO12)" line.
+
+const unsigned long  kDefaultQueryBytes       = 300;
+const unsigned long  kDefaultMuteBytes        = 16;
+
+Options              sOptions;
+
+// MARK: Option Parsing
+
+void
+Usage(const char *aProgram, FILE *aStream)
+{
+    fprintf(aStream,
+            "Usage: %s [ options ]\n"
+            "\n"
+            "Benchmark the latency of interactive HLX commands under a\n"
+            "saturated background refresh, with and without priority lanes.\n"
+            "\n"
+            " -b, --query-bytes <count>   Bytes on the wire of a refresh query\n"
+            "                             (default: %lu).\n"
+            " -c, --character-delay <ms>  Delay per character on the wire\n"
+            "                             (default: %.3f ms).\n"
+            " -h, --help                  Print this help and exit.\n"
+            " -i, --interactive <count>   Number of interactive mutes (default: %lu).\n"
+            " -m, --mean-interval <ms>    Mean interval between mutes (default: %.1f ms).\n"
+            " -r, --refresh <count>       Number of queries queued in each refresh\n"
+            "                             (default: %lu).\n"
+            " -s, --seed <seed>           Random seed (default: %lu).\n"
+            " -u, --mute-bytes <count>    Bytes on the wire of a mute (default: %lu).\n"
+            " -w, --window <count>        Commands in flight at once (default: %lu).\n",
+            aProgram,
+            kDefaultQueryBytes,
+            kDefaultCharacterDelayMs,
+            kDefaultInteractive,
+            kDefaultMeanIntervalMs,
+            kDefaultRefresh,
+            kDefaultSeed,
+            kDefaultMuteBytes,
+            kDefaultWindow);
+}
+
+bool
+ParseCount(const char *aString, const unsigned long &aMinimum, const unsigned long &aMaximum, unsigned long &aCount)
+{
+    char *  lEnd;
+    bool    lRetval;
+
+    aCount = strtoul(aString, &lEnd, 10);
+
+    lRetval = ((*aString != '\0') && (*lEnd == '\0') && (aCount >= aMinimum) && (aCount <= aMaximum));
+
+    return (lRetval);
+}
+
+bool
+ParseMilliseconds(const char *aString, double &aMilliseconds)
+{
+    char *  lEnd;
+    bool    lRetval;
+
+    aMilliseconds = strtod(aString, &lEnd);
+
+    lRetval = ((*aString != '\0') && (*lEnd == '\0') && (aMilliseconds >= 0));
+
+    return (lRetval);
+}
+
+bool
+ParseOptions(int argc, char * const argv[])
+{
+    static const struct option sLongOptions[] =
+    {
+        { "query-bytes",     required_argument, nullptr, 'b' },
+        { "character-delay", required_argument, nullptr, 'c' },
+        { "help",            no_argument,       nullptr, 'h' },
+        { "interactive",     required_argument, nullptr, 'i' },
+        { "mean-interval",   required_argument, nullptr, 'm' },
+        { "refresh",         required_argument, nullptr, 'r' },
+        { "seed",            required_argument, nullptr, 's' },
+        { "mute-bytes",      required_argument, nullptr, 'u' },
+        { "window",          required_argument, nullptr, 'w' },
+        { nullptr,           0,                 nullptr, 0   }
+    };
+    int   lOption;
+    bool  lRetval = true;
+
+    sOptions.mInteractive      = kDefaultInteractive;
+    sOptions.mRefresh          = kDefaultRefresh;
+    sOptions.mWindow           = kDefaultWindow;
+    sOptions.mSeed             = kDefaultSeed;
+    sOptions.mCharacterDelayMs = kDefaultCharacterDelayMs;
+    sOptions.mMeanIntervalMs   = kDefaultMeanIntervalMs;
+    sOptions.mQueryBytes       = kDefaultQueryBytes;
+    sOptions.mMuteBytes        = kDefaultMuteBytes;
+
+    while (lRetval && ((lOption = getopt_long(argc, argv, "b:c:hi:m:r:s:u:w:", sLongOptions, nullptr)) != -1))
+    {
+        switch (lOption)
+        {
+
+        case 'b':
+            lRetval = ParseCount(optarg, 1, 100000, sOptions.mQueryBytes);
+            break;
+
+        case 'c':
+            lRetval = ParseMilliseconds(optarg, sOptions.mCharacterDelayMs);
+            break;
+
+        case 'h':
+            Usage(argv[0], stdout);
+            exit(EXIT_SUCCESS);
+            break;
+
+        case 'i':
+            lRetval = ParseCount(optarg, 1, 10000000, sOptions.mInteractive);
+            break;
+
+        case 'm':
+            lRetval = (ParseMilliseconds(optarg, sOptions.mMeanIntervalMs) && (sOptions.mMeanIntervalMs > 0));
+            break;
+
+        case 'r':
+            lRetval = ParseCount(optarg, 1, 100000, sOptions.mRefresh);
+            break;
+
+        case 's':
+            lRetval = ParseCount(optarg, 0, 0xFFFFFFFF, sOptions.mSeed);
+            break;
+
+        case 'u':
+            lRetval = ParseCount(optarg, 1, 100000, sOptions.mMuteBytes);
+            break;
+
+        case 'w':
+            lRetval = ParseCount(optarg, 1, 64, sOptions.mWindow);
+            break;
+
+        default:
+            lRetval = false;
+            break;
+
+        }
+    }
+
+    lRetval = (lRetval && (optind == argc));
+
+    if (!lRetval)
+    {
+        Usage(argv[0], stderr);
+    }
+
+    return (lRetval);
+}
+
+// MARK: Simulation
+
+// Simulate the peer answering commands issued by the command
+// scheduler until every interactive mute has been answered. Where
+// lanes are not in use, mutes and queries share the user lane and so
+// are issued first-in, first-out.
+
+void
+Run(const bool &aUseLanes, Result &aResult)
+{
+    const CommandScheduler::Lane           lInteractiveLane = (aUseLanes ? CommandScheduler::kLaneInteractive : CommandScheduler::kLaneUser);
+    const CommandScheduler::Lane           lBackgroundLane  = (aUseLanes ? CommandScheduler::kLaneBackground : CommandScheduler::kLaneUser);
+    std::mt19937                           lGenerator(static_cast<std::mt19937::result_type>(sOptions.mSeed));
+    std::exponential_distribution<double>  lInterval(1.0 / sOptions.mMeanIntervalMs);
+    std::deque<Command>                    lPending[CommandScheduler::kLaneMax];
+    std::deque<InFlight>                   lInFlight;
+    double                                 lNow = 0;
+    double                                 lNextArrival = lInterval(lGenerator);
+    double                                 lPeerFree = 0;
+    unsigned long                          lArrived = 0;
+    unsigned long                          lQueriesPending = 0;
+    CommandScheduler::Lane                 lLane;
+
+    aResult.mLatencies.clear();
+    aResult.mQueries = 0;
+
+    while (aResult.mLatencies.size() < sOptions.mInteractive)
+    {
+        size_t  lCounts[CommandScheduler::kLaneMax];
+
+        // Keep the refresh saturated: queue another refresh as soon as
+        // the last of the prior one has been issued.
+
+        if (lQueriesPending == 0)
+        {
+            for (unsigned long lQuery = 0; lQuery < sOptions.mRefresh; lQuery++)
+            {
+                const Command lCommand = { lNow, false, sOptions.mQueryBytes };
+
+                lPending[lBackgroundLane].push_back(lCommand);
+            }
+
+            lQueriesPending = sOptions.mRefresh;
+        }
+
+        // Issue whatever the scheduler allows.
+
+        for (int lIndex = 0; lIndex < CommandScheduler::kLaneMax; lIndex++)
+        {
+            lCounts[lIndex] = lPending[lIndex].size();
+        }
+
+        while ((lLane = CommandScheduler::Select(lCounts, lInFlight.size(), sOptions.mWindow)) != CommandScheduler::kLaneMax)
+        {
+            InFlight lIssued;
+
+            lIssued.mCommand  = lPending[lLane].front();
+            lPeerFree         = std::max(lPeerFree, lNow) + (lIssued.mCommand.mBytes * sOptions.mCharacterDelayMs);
+            lIssued.mAnswered = lPeerFree;
+
+            if (!lIssued.mCommand.mIsInteractive)
+            {
+                lQueriesPending--;
+            }
+
+            lInFlight.push_back(lIssued);
+            lPending[lLane].pop_front();
+            lCounts[lLane]--;
+        }
+
+        // Advance to the next answer or mute, whichever is sooner.
+
+        if (!lInFlight.empty() && ((lArrived == sOptions.mInteractive) || (lInFlight.front().mAnswered <= lNextArrival)))
+        {
+            const InFlight lAnswered = lInFlight.front();
+
+            lInFlight.pop_front();
+
+            lNow = lAnswered.mAnswered;
+
+            if (lAnswered.mCommand.mIsInteractive)
+            {
+                aResult.mLatencies.push_back(lNow - lAnswered.mCommand.mEnqueued);
+            }
+            else
+            {
+                aResult.mQueries++;
+            }
+        }
+        else
+        {
+            const Command lCommand = { lNextArrival, true, sOptions.mMuteBytes };
+
+            lNow = lNextArrival;
+
+            lPending[lInteractiveLane].push_back(lCommand);
+
+            lArrived++;
+            lNextArrival = lNow + lInterval(lGenerator);
+        }
+    }
+
+    aResult.mElapsed = lNow;
+
+    std::sort(aResult.mLatencies.begin(), aResult.mLatencies.end());
+}
+
+double
+Percentile(const std::vector<double> &aSorted, const double &aPercentile)
+{
+    const size_t lIndex = static_cast<size_t>((aPercentile / 100.0) * (aSorted.size() - 1) + 0.5);
+
+    return (aSorted[lIndex]);
+}
+
+void
+Print(const char *aName, const Result &aResult)
+{
+    printf("  %-6s %9.1f %9.1f %9.1f %9.1f %9.1f %9.2f\n",
+           aName,
+           Percentile(aResult.mLatencies, 50),
+           Percentile(aResult.mLatencies, 90),
+           Percentile(aResult.mLatencies, 99),
+           Percentile(aResult.mLatencies, 99.9),
+           aResult.mLatencies.back(),
+           (aResult.mQueries * 1000.0) / aResult.mElapsed);
+}
+
+}; // namespace
+
+int
+main(int argc, char * const argv[])
+{
+    Result  lFifo;
+    Result  lLanes;
+    int     lRetval = EXIT_FAILURE;
+
+    if (ParseOptions(argc, argv))
+    {
+        Run(false, lFifo);
+        Run(true, lLanes);
+
+        printf("%lu mutes under refreshes of %lu queries, window %lu:\n",
+               sOptions.mInteractive,
+               sOptions.mRefresh,
+               sOptions.mWindow);
+        printf("  %-6s %9s %9s %9s %9s %9s %9s\n", "", "p50 ms", "p90 ms", "p99 ms", "p99.9 ms", "max ms", "query/s");
+
+        Print("fifo", lFifo);
+        Print("lanes", lLanes);
+
+        lRetval = EXIT_SUCCESS;
+    }
+
+    return (lRetval);
+}
@@ -0,0 +1,974 @@
+/*
+ *    Copyright (c) 2026 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *  @file
+ *    This file implements a latency-emulating HLX stand-in server.
+ *
+ *    The server listens for HLX telnet client connections and relays
+ *    each one, byte-for-byte, to an upstream HLX server: typically an
+ *    instance of the openhlx _hlxsimd_ simulator, which speaks the
+ *    protocol and state of real HLX hardware, but has none of its
+ *    timing. Output from the upstream server is paced back to the
+ *    client in one of two modes:
+ *
+ *      - character: one character at a time with a configurable
+ *        delay between characters, reproducing the
+ *        character-at-a-time behavior of real HLX hardware.
+ *
+ *      - line: buffered and released a complete line at a time after
+ *        a configurable delay, reproducing a line-buffered proxy such
+ *        as the openhlx _hlxproxyd_ in front of real HLX hardware.
+ *
+ *    On disconnection, each connection's byte counts, time to first
+ *    byte, and duration are logged such that a client connect and
+ *    refresh may be measured reproducibly under either mode.
+ *
+ *    The server depends only on POSIX and the C++ Standard Library
+ *    and may be built on Linux or macOS with:
+ *
+ *      % c++ -std=c++11 -O2 -o hlxlatencyd hlxlatencyd.cpp
+ *
+ */
+
+#include <chrono>
+#include <deque>
+#include <string>
+#include <vector>
+
+#include <errno.h>
+#include <getopt.h>
+#include <netdb.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+
+namespace
+{
+
+typedef std::chrono::steady_clock  Clock;
+typedef std::chrono::microseconds  Duration;
+
+/**
+ *  The upstream server output pacing mode.
+ *
+ */
+enum Mode
+{
+    kModeCharacter = 0, //!< Character-at-a-time, as real HLX hardware.
+    kModeLine           //!< Line-at-a-time, as a line-buffered proxy.
+};
+
+/**
+ *  The server configuration, as established from the command line.
+ *
+ */
+struct Options
+{
+    std::string  mListenHost;
+    std::string  mListenPort;
+    std::string  mUpstreamHost;
+    std::string  mUpstreamPort;
+    Mode         mMode;
+    Duration     mCharacterDelay;
+    Duration     mLineDelay;
+    Duration     mLineFlushDelay;
+    Duration     mConnectDelay;
+    bool         mVerbose;
+};
+
+/**
+ *  A chunk of upstream server output, pending release to the client
+ *  no earlier than its ready time.
+ *
+ */
+struct Chunk
+{
+    Clock::time_point  mReady;
+    std::string        mData;
+};
+
+/**
+ *  A relayed client connection.
+ *
+ */
+struct Connection
+{
+    int                  mClientDescriptor;
+    int                  mUpstreamDescriptor;
+    Clock::time_point    mAccepted;
+    Clock::time_point    mConnectReady;
+    Clock::time_point    mFirstByte;
+    bool                 mHaveFirstByte;
+    std::deque<Chunk>    mChunks;
+    std::string          mLine;
+    Clock::time_point    mLineFlush;
+    Clock::time_point    mNextCharacter;
+    size_t               mClientBytes;
+    size_t               mUpstreamBytes;
+    bool                 mUpstreamClosed;
+    bool                 mClosing;
+};
+
+typedef std::vector<Connection> Connections;
+
+const char * const kDefaultListenHost    = "localhost";
+const char * const kDefaultListenPort    = "2323";
+const char * const kDefaultUpstreamPort  = "23";
+
+// The default per-character delay approximates the observed
+// character-at-a-time output rate of real HLX hardware.
+
+const long         kDefaultCharacterDelayUs = 1000;
+const long         kDefaultLineDelayUs      = 0;
+const long         kDefaultLineFlushDelayUs = 20000;
+
+const size_t       kReadBufferSize = 4096;
+
+Options      sOptions;
+volatile sig_atomic_t sStop = 0;
+
+// MARK: Logging
+
+void
+Log(const char *aFormat, ...)
+{
+    va_list lArguments;
+
+    va_start(lArguments, aFormat);
+    vfprintf(stderr, aFormat, lArguments);
+    va_end(lArguments);
+}
+
+void
+Debug(const char *aFormat, ...)
+{
+    va_list lArguments;
+
+    if (sOptions.mVerbose)
+    {
+        va_start(lArguments, aFormat);
+        vfprintf(stderr, aFormat, lArguments);
+        va_end(lArguments);
+    }
+}
+
+long long
+Milliseconds(const Clock::duration &aDuration)
+{
+    return (static_cast<long long>(std::chrono::duration_cast<std::chrono::milliseconds>(aDuration).count()));
+}
+
+// MARK: Option Parsing
+
+void
+Usage(const char *aProgram, FILE *aStream)
+{
+    fprintf(aStream,
+            "Usage: %s [ options ] -u <host>[:<port>]\n"
+            "\n"
+            "Relay HLX telnet client connections to an upstream HLX server,\n"
+            "pacing upstream output to emulate HLX hardware latency.\n"
+            "\n"
+            " -c, --character-delay <ms>  Delay between characters in character\n"
+            "                             mode (default: %.3f ms).\n"
+            " -d, --connect-delay <ms>    Delay before connecting upstream for\n"
+            "                             each accepted client (default: 0 ms).\n"
+            " -f, --line-flush <ms>       Idle time after which a partial line\n"
+            "                             is released in line mode (default:\n"
+            "                             %.3f ms).\n"
+            " -h, --help                  Print this usage and exit.\n"
+            " -l, --listen <host>[:<port>]\n"
+            "                             Listen on the specified host and port\n"
+            "                             (default: %s:%s).\n"
+            " -L, --line-delay <ms>       Delay before each line is released in\n"
+            "                             line mode (default: %.3f ms).\n"
+            " -m, --mode <mode>           Pace upstream output a 'character' or\n"
+            "                             a 'line' at a time (default:\n"
+            "                             character).\n"
+            " -u, --upstream <host>[:<port>]\n"
+            "                             Relay to the specified upstream HLX\n"
+            "                             server (default port: %s).\n"
+            " -v, --verbose               Log connection events.\n",
+            aProgram,
+            kDefaultCharacterDelayUs / 1000.0,
+            kDefaultLineFlushDelayUs / 1000.0,
+            kDefaultListenHost,
+            kDefaultListenPort,
+            kDefaultLineDelayUs / 1000.0,
+            kDefaultUpstreamPort);
+}
+
+/**
+ *  @brief
+ *    Parse a, possibly fractional, millisecond delay.
+ *
+ *  @param[in]   aString    A pointer to a null-terminated C string
+ *                          containing the delay, in milliseconds.
+ *  @param[out]  aDuration  A reference to the duration to set.
+ *
+ *  @returns
+ *    True if the delay was valid; otherwise, false.
+ *
+ */
+bool
+ParseDelay(const char *aString, Duration &aDuration)
+{
+    char *  lEnd;
+    double  lMilliseconds;
+    bool    lRetval;
+
+    errno = 0;
+
+    lMilliseconds = strtod(aString, &lEnd);
+
+    lRetval = ((errno == 0) && (lEnd != aString) && (*lEnd == '\0') && (lMilliseconds >= 0));
+
+    if (lRetval)
+    {
+        aDuration = Duration(static_cast<Duration::rep>(lMilliseconds * 1000));
+    }
+
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Split a host and optional port, in the form "host", "host:port",
+ *    "[v6-address]", or "[v6-address]:port".
+ *
+ */
+void
+ParseHostAndPort(const char *aString, std::string &aHost, std::string &aPort)
+{
+    const std::string  lString(aString);
+    size_t             lColon;
+
+    if ((lString.size() > 0) && (lString[0] == '['))
+    {
+        const size_t lClose = lString.find(']');
+
+        aHost = lString.substr(1, lClose - 1);
+
+        if ((lClose != std::string::npos) && ((lClose + 1) < lString.size()) && (lString[lClose + 1] == ':'))
+        {
+            aPort = lString.substr(lClose + 2);
+        }
+    }
+    else if (((lColon = lString.rfind(':')) != std::string::npos) && (lString.find(':') == lColon))
+    {
+        aHost = lString.substr(0, lColon);
+        aPort = lString.substr(lColon + 1);
+    }
+    else
+    {
+        aHost = lString;
+    }
+}
+
+bool
+ParseOptions(int argc, char * const argv[])
+{
+    static const struct option sLongOptions[] =
+    {
+        { "character-delay", required_argument, nullptr, 'c' },
+        { "connect-delay",   required_argument, nullptr, 'd' },
+        { "help",            no_argument,       nullptr, 'h' },
+        { "line-delay",      required_argument, nullptr, 'L' },
+        { "line-flush",      required_argument, nullptr, 'f' },
+        { "listen",          required_argument, nullptr, 'l' },
+        { "mode",            required_argument, nullptr, 'm' },
+        { "upstream",        required_argument, nullptr, 'u' },
+        { "verbose",         no_argument,       nullptr, 'v' },
+        { nullptr,           0,                 nullptr, 0   }
+    };
+    int   lOption;
+    bool  lRetval = true;
+
+    sOptions.mListenHost     = kDefaultListenHost;
+    sOptions.mListenPort     = kDefaultListenPort;
+    sOptions.mUpstreamPort   = kDefaultUpstreamPort;
+    sOptions.mMode           = kModeCharacter;
+    sOptions.mCharacterDelay = Duration(kDefaultCharacterDelayUs);
+    sOptions.mLineDelay      = Duration(kDefaultLineDelayUs);
+    sOptions.mLineFlushDelay = Duration(kDefaultLineFlushDelayUs);
+    sOptions.mConnectDelay   = Duration(0);
+    sOptions.mVerbose        = false;
+
+    while (lRetval && ((lOption = getopt_long(argc, argv, "c:d:f:hl:L:m:u:v", sLongOptions, nullptr)) != -1))
+    {
+        switch (lOption)
+        {
+
+        case 'c':
+            lRetval = ParseDelay(optarg, sOptions.mCharacterDelay);
+            break;
+
+        case 'd':
+            lRetval = ParseDelay(optarg, sOptions.mConnectDelay);
+            break;
+
+        case 'f':
+            lRetval = ParseDelay(optarg, sOptions.mLineFlushDelay);
+            break;
+
+        case 'h':
+            Usage(argv[0], stdout);
+            exit(EXIT_SUCCESS);
+            break;
+
+        case 'l':
+            ParseHostAndPort(optarg, sOptions.mListenHost, sOptions.mListenPort);
+            break;
+
+        case 'L':
+            lRetval = ParseDelay(optarg, sOptions.mLineDelay);
+            break;
+
+        case 'm':
+            if (strcmp(optarg, "character") == 0)
+                sOptions.mMode = kModeCharacter;
+            else if (strcmp(optarg, "line") == 0)
+                sOptions.mMode = kModeLine;
+            else
+                lRetval = false;
+            break;
+
+        case 'u':
+            ParseHostAndPort(optarg, sOptions.mUpstreamHost, sOptions.mUpstreamPort);
+            break;
+
+        case 'v':
+            sOptions.mVerbose = true;
+            break;
+
+        default:
+            lRetval = false;
+            break;
+
+        }
+    }
+
+    lRetval = (lRetval && (optind == argc) && !sOptions.mUpstreamHost.empty());
+
+    if (!lRetval)
+    {
+        Usage(argv[0], stderr);
+    }
+
+    return (lRetval);
+}
+
+// MARK: Sockets
+
+/**
+ *  @brief
+ *    Open a listening socket bound to the specified host and port.
+ *
+ *  @returns
+ *    The socket descriptor on success; otherwise, -1.
+ *
+ */
+int
+Listen(const std::string &aHost, const std::string &aPort)
+{
+    struct addrinfo   lHints;
+    struct addrinfo * lAddresses = nullptr;
+    struct addrinfo * lAddress;
+    const int         lOn = 1;
+    int               lStatus;
+    int               lRetval = -1;
+
+    memset(&lHints, 0, sizeof (lHints));
+
+    lHints.ai_family   = AF_UNSPEC;
+    lHints.ai_socktype = SOCK_STREAM;
+    lHints.ai_flags    = AI_PASSIVE;
+
+    lStatus = getaddrinfo(aHost.c_str(), aPort.c_str(), &lHints, &lAddresses);
+
+    if (lStatus != 0)
+    {
+        Log("Could not resolve listen address %s:%s: %s\n", aHost.c_str(), aPort.c_str(), gai_strerror(lStatus));
+    }
+
+    for (lAddress = lAddresses; (lStatus == 0) && (lAddress != nullptr) && (lRetval == -1); lAddress = lAddress->ai_next)
+    {
+        lRetval = socket(lAddress->ai_family, lAddress->ai_socktype, lAddress->ai_protocol);
+
+        if (lRetval != -1)
+        {
+            setsockopt(lRetval, SOL_SOCKET, SO_REUSEADDR, &lOn, sizeof (lOn));
+
+            if ((bind(lRetval, lAddress->ai_addr, lAddress->ai_addrlen) != 0) || (listen(lRetval, SOMAXCONN) != 0))
+            {
+                Log("Could not listen on %s:%s: %s\n", aHost.c_str(), aPort.c_str(), strerror(errno));
+
+                close(lRetval);
+
+                lRetval = -1;
+            }
+        }
+    }
+
+    if (lAddresses != nullptr)
+    {
+        freeaddrinfo(lAddresses);
+    }
+
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Open a connection to the specified upstream host and port.
+ *
+ *  @returns
+ *    The socket descriptor on success; otherwise, -1.
+ *
+ */
+int
+Connect(const std::string &aHost, const std::string &aPort)
+{
+    struct addrinfo   lHints;
+    struct addrinfo * lAddresses = nullptr;
+    struct addrinfo * lAddress;
+    int               lStatus;
+    int               lRetval = -1;
+
+    memset(&lHints, 0, sizeof (lHints));
+
+    lHints.ai_family   = AF_UNSPEC;
+    lHints.ai_socktype = SOCK_STREAM;
+
+    lStatus = getaddrinfo(aHost.c_str(), aPort.c_str(), &lHints, &lAddresses);
+
+    if (lStatus != 0)
+    {
+        Log("Could not resolve upstream address %s:%s: %s\n", aHost.c_str(), aPort.c_str(), gai_strerror(lStatus));
+    }
+
+    for (lAddress = lAddresses; (lStatus == 0) && (lAddress != nullptr) && (lRetval == -1); lAddress = lAddress->ai_next)
+    {
+        lRetval = socket(lAddress->ai_family, lAddress->ai_socktype, lAddress->ai_protocol);
+
+        if ((lRetval != -1) && (connect(lRetval, lAddress->ai_addr, lAddress->ai_addrlen) != 0))
+        {
+            close(lRetval);
+
+            lRetval = -1;
+        }
+    }
+
+    if ((lStatus == 0) && (lRetval == -1))
+    {
+        Log("Could not connect to upstream %s:%s: %s\n", aHost.c_str(), aPort.c_str(), strerror(errno));
+    }
+
+    if (lAddresses != nullptr)
+    {
+        freeaddrinfo(lAddresses);
+    }
+
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Write all of the specified data to the specified descriptor.
+ *
+ *  @returns
+ *    True if all of the data were written; otherwise, false.
+ *
+ */
+bool
+WriteAll(const int &aDescriptor, const char *aData, size_t aSize)
+{
+    ssize_t  lWritten = 0;
+
+    while ((aSize > 0) && (lWritten >= 0))
+    {
+        lWritten = write(aDescriptor, aData, aSize);
+
+        if (lWritten > 0)
+        {
+            aData += lWritten;
+            aSize -= static_cast<size_t>(lWritten);
+        }
+        else if ((lWritten < 0) && (errno == EINTR))
+        {
+            lWritten = 0;
+        }
+    }
+
+    return (aSize == 0);
+}
+
+// MARK: Pacing
+
+/**
+ *  @brief
+ *    Accept output from the upstream server for pacing to the
+ *    client.
+ *
+ *  In character mode, output is queued for release a character at a
+ *  time. In line mode, each complete line is queued for release after
+ *  the line delay and any trailing partial line is held until it is
+ *  completed or it has been idle for the line flush delay.
+ *
+ */
+void
+UpstreamDidReceive(Connection &aConnection, const char *aData, const size_t &aSize, const Clock::time_point &aNow)
+{
+    size_t  lNewline;
+
+    if (sOptions.mMode == kModeCharacter)
+    {
+        if (aConnection.mChunks.empty())
+        {
+            aConnection.mChunks.push_back(Chunk());
+
+            aConnection.mNextCharacter = std::max(aConnection.mNextCharacter, aNow + sOptions.mCharacterDelay);
+        }
+
+        aConnection.mChunks.back().mData.append(aData, aSize);
+    }
+    else
+    {
+        aConnection.mLine.append(aData, aSize);
+
+        while ((lNewline = aConnection.mLine.find('\n')) != std::string::npos)
+        {
+            Chunk lChunk;
+
+            lChunk.mReady = aNow + sOptions.mLineDelay;
+            lChunk.mData  = aConnection.mLine.substr(0, lNewline + 1);
+
+            aConnection.mChunks.push_back(lChunk);
+
+            aConnection.mLine.erase(0, lNewline + 1);
+        }
+
+        aConnection.mLineFlush = aNow + sOptions.mLineFlushDelay;
+    }
+}
+
+/**
+ *  @brief
+ *    Release any paced output that is ready to the client.
+ *
+ *  @returns
+ *    True if the client could be written to; otherwise, false.
+ *
+ */
+bool
+ReleaseReady(Connection &aConnection, const Clock::time_point &aNow)
+{
+    bool  lRetval = true;
+
+    if (sOptions.mMode == kModeCharacter)
+    {
+        if (!aConnection.mChunks.empty() && (aNow >= aConnection.mNextCharacter))
+        {
+            std::string &  lData = aConnection.mChunks.front().mData;
+            size_t         lCount = 1;
+
+            // Catch up on any characters whose release time has
+            // passed while we were not scheduled, so the emulated
+            // rate holds even with delays finer than the poll
+            // resolution.
+
+            if (sOptions.mCharacterDelay.count() > 0)
+            {
+                lCount += static_cast<size_t>((aNow - aConnection.mNextCharacter) / sOptions.mCharacterDelay);
+            }
+            else
+            {
+                lCount = lData.size();
+            }
+
+            lCount = std::min(lCount, lData.size());
+
+            lRetval = WriteAll(aConnection.mClientDescriptor, lData.data(), lCount);
+
+            lData.erase(0, lCount);
+
+            aConnection.mNextCharacter += sOptions.mCharacterDelay * lCount;
+
+            if (lData.empty())
+            {
+                aConnection.mChunks.pop_front();
+            }
+        }
+    }
+    else
+    {
+        if (!aConnection.mLine.empty() && (aNow >= aConnection.mLineFlush))
+        {
+            Chunk lChunk;
+
+            lChunk.mReady = aNow + sOptions.mLineDelay;
+            lChunk.mData.swap(aConnection.mLine);
+
+            aConnection.mChunks.push_back(lChunk);
+        }
+
+        while (lRetval && !aConnection.mChunks.empty() && (aNow >= aConnection.mChunks.front().mReady))
+        {
+            const std::string &lData = aConnection.mChunks.front().mData;
+
+            lRetval = WriteAll(aConnection.mClientDescriptor, lData.data(), lData.size());
+
+            aConnection.mChunks.pop_front();
+        }
+    }
+
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Return the time at which the connection next needs attention,
+ *    or Clock::time_point::max() if it is waiting only on input.
+ *
+ */
+Clock::time_point
+GetDeadline(const Connection &aConnection)
+{
+    Clock::time_point  lRetval = Clock::time_point::max();
+
+    if (aConnection.mUpstreamDescriptor == -1)
+    {
+        lRetval = aConnection.mConnectReady;
+    }
+    else if (sOptions.mMode == kModeCharacter)
+    {
+        if (!aConnection.mChunks.empty())
+        {
+            lRetval = aConnection.mNextCharacter;
+        }
+    }
+    else
+    {
+        if (!aConnection.mChunks.empty())
+        {
+            lRetval = aConnection.mChunks.front().mReady;
+        }
+
+        if (!aConnection.mLine.empty())
+        {
+            lRetval = std::min(lRetval, aConnection.mLineFlush);
+        }
+    }
+
+    return (lRetval);
+}
+
+// MARK: Connections
+
+void
+Close(Connection &aConnection, const Clock::time_point &aNow)
+{
+    Log("Closed client %d: %zu bytes up, %zu bytes down, first byte %lld ms, duration %lld ms\n",
+        aConnection.mClientDescriptor,
+        aConnection.mClientBytes,
+        aConnection.mUpstreamBytes,
+        (aConnection.mHaveFirstByte ? Milliseconds(aConnection.mFirstByte - aConnection.mAccepted) : -1LL),
+        Milliseconds(aNow - aConnection.mAccepted));
+
+    close(aConnection.mClientDescriptor);
+
+    if (aConnection.mUpstreamDescriptor != -1)
+    {
+        close(aConnection.mUpstreamDescriptor);
+    }
+}
+
+void
+Accept(const int &aListenDescriptor, Connections &aConnections, const Clock::time_point &aNow)
+{
+    Connection  lConnection;
+
+    lConnection.mClientDescriptor = accept(aListenDescriptor, nullptr, nullptr);
+
+    if (lConnection.mClientDescriptor != -1)
+    {
+        lConnection.mUpstreamDescriptor = -1;
+        lConnection.mAccepted           = aNow;
+        lConnection.mConnectReady       = aNow + sOptions.mConnectDelay;
+        lConnection.mHaveFirstByte      = false;
+        lConnection.mLineFlush          = aNow;
+        lConnection.mNextCharacter      = aNow;
+        lConnection.mClientBytes        = 0;
+        lConnection.mUpstreamBytes      = 0;
+        lConnection.mUpstreamClosed     = false;
+        lConnection.mClosing            = false;
+
+        Debug("Accepted client %d\n", lConnection.mClientDescriptor);
+
+        aConnections.push_back(lConnection);
+    }
+}
+
+/**
+ *  @brief
+ *    Relay data from one descriptor of the connection.
+ *
+ *  Client input is relayed upstream immediately; upstream output is
+ *  handed to the pacer.
+ *
+ *  @returns
+ *    True if the connection remains open; otherwise, false.
+ *
+ */
+bool
+Relay(Connection &aConnection, const bool &aFromClient, const Clock::time_point &aNow)
+{
+    char     lBuffer[kReadBufferSize];
+    ssize_t  lRead;
+    bool     lRetval;
+
+    lRead = read((aFromClient ? aConnection.mClientDescriptor : aConnection.mUpstreamDescriptor),
+                 lBuffer,
+                 sizeof (lBuffer));
+
+    lRetval = ((lRead > 0) || ((lRead < 0) && (errno == EINTR)));
+
+    if (lRead > 0)
+    {
+        if (aFromClient)
+        {
+            aConnection.mClientBytes += static_cast<size_t>(lRead);
+
+            lRetval = WriteAll(aConnection.mUpstreamDescriptor, lBuffer, static_cast<size_t>(lRead));
+        }
+        else
+        {
+            if (!aConnection.mHaveFirstByte)
+            {
+                aConnection.mFirstByte     = aNow;
+                aConnection.mHaveFirstByte = true;
+            }
+
+            aConnection.mUpstreamBytes += static_cast<size_t>(lRead);
+
+            UpstreamDidReceive(aConnection, lBuffer, static_cast<size_t>(lRead), aNow);
+        }
+    }
+    else if (!lRetval)
+    {
+        Debug("Client %d %s closed\n", aConnection.mClientDescriptor, (aFromClient ? "client" : "upstream"));
+
+        // When the upstream server closes, keep the client open until
+        // all of the output already received has been paced out to
+        // it, flushing any partial line right away.
+
+        if (!aFromClient)
+        {
+            aConnection.mUpstreamClosed = true;
+            aConnection.mLineFlush      = aNow;
+
+            lRetval = true;
+        }
+    }
+
+    return (lRetval);
+}
+
+void
+HandleSignal(int aSignal)
+{
+    (void)aSignal;
+
+    sStop = 1;
+}
+
+/**
+ *  @brief
+ *    Run the server until interrupted.
+ *
+ */
+int
+Run(const int &aListenDescriptor)
+{
+    Connections                lConnections;
+    std::vector<struct pollfd> lDescriptors;
+    Clock::time_point          lNow;
+    Clock::time_point          lDeadline;
+    int                        lTimeout;
+    int                        lStatus;
+    size_t                     lIndex;
+    size_t                     lDescriptor;
+
+    while (!sStop)
+    {
+        lNow      = Clock::now();
+        lDeadline = Clock::time_point::max();
+
+        // Establish the poll set: the listen socket, then each
+        // connection's client and, once connected, upstream socket.
+
+        lDescriptors.clear();
+        lDescriptors.push_back({ aListenDescriptor, POLLIN, 0 });
+
+        for (const auto &lConnection : lConnections)
+        {
+            lDescriptors.push_back({ lConnection.mClientDescriptor, POLLIN, 0 });
+            lDescriptors.push_back({ (lConnection.mUpstreamClosed ? -1 : lConnection.mUpstreamDescriptor), POLLIN, 0 });
+
+            lDeadline = std::min(lDeadline, GetDeadline(lConnection));
+        }
+
+        if (lDeadline == Clock::time_point::max())
+        {
+            lTimeout = -1;
+        }
+        else
+        {
+            // Round up such that we never wake before the deadline and
+            // spin.
+
+            lTimeout = static_cast<int>(Milliseconds(std::max(Clock::duration::zero(), lDeadline - lNow))) + 1;
+        }
+
+        lStatus = poll(lDescriptors.data(), lDescriptors.size(), lTimeout);
+
+        if ((lStatus < 0) && (errno != EINTR))
+        {
+            Log("Could not poll: %s\n", strerror(errno));
+
+            sStop = 1;
+        }
+
+        lNow = Clock::now();
+
+        if ((lStatus > 0) && (lDescriptors[0].revents & POLLIN))
+        {
+            Accept(aListenDescriptor, lConnections, lNow);
+        }
+
+        for (lIndex = 0, lDescriptor = 1; (lStatus >= 0) && (lIndex < lConnections.size()); lIndex++, lDescriptor += 2)
+        {
+            Connection &lConnection = lConnections[lIndex];
+
+            // Connections accepted this pass have no poll entries yet.
+
+            if (lDescriptor >= lDescriptors.size())
+            {
+                break;
+            }
+
+            if ((lConnection.mUpstreamDescriptor == -1) && (lNow >= lConnection.mConnectReady))
+            {
+                lConnection.mUpstreamDescriptor = Connect(sOptions.mUpstreamHost, sOptions.mUpstreamPort);
+
+                lConnection.mClosing = (lConnection.mUpstreamDescriptor == -1);
+
+                if (!lConnection.mClosing)
+                {
+                    Debug("Client %d connected upstream in %lld ms\n",
+                          lConnection.mClientDescriptor,
+                          Milliseconds(Clock::now() - lConnection.mAccepted));
+                }
+            }
+
+            // Client input that arrives before the upstream connection
+            // is established is left unread until it is.
+
+            if (!lConnection.mClosing && (lConnection.mUpstreamDescriptor != -1) &&
+                (lDescriptors[lDescriptor].revents & (POLLIN | POLLHUP | POLLERR)))
+            {
+                lConnection.mClosing = !Relay(lConnection, true, lNow);
+            }
+
+            if (!lConnection.mClosing && (lDescriptors[lDescriptor + 1].fd != -1) &&
+                (lDescriptors[lDescriptor + 1].revents & (POLLIN | POLLHUP | POLLERR)))
+            {
+                lConnection.mClosing = !Relay(lConnection, false, lNow);
+            }
+
+            if (!lConnection.mClosing)
+            {
+                lConnection.mClosing = !ReleaseReady(lConnection, lNow);
+            }
+
+            if (lConnection.mUpstreamClosed && lConnection.mChunks.empty() && lConnection.mLine.empty())
+            {
+                lConnection.mClosing = true;
+            }
+        }
+
+        for (lIndex = lConnections.size(); lIndex > 0; lIndex--)
+        {
+            if (lConnections[lIndex - 1].mClosing)
+            {
+                Close(lConnections[lIndex - 1], lNow);
+
+                lConnections.erase(lConnections.begin() + static_cast<ssize_t>(lIndex - 1));
+            }
+        }
+    }
+
+    for (auto &lConnection : lConnections)
+    {
+        Close(lConnection, Clock::now());
+    }
+
+    return (EXIT_SUCCESS);
+}
+
+}; // namespace
+
+int
+main(int argc, char * const argv[])
+{
+    int  lListenDescriptor;
+    int  lRetval = EXIT_FAILURE;
+
+    if (ParseOptions(argc, argv))
+    {
+        signal(SIGPIPE, SIG_IGN);
+        signal(SIGINT, HandleSignal);
+        signal(SIGTERM, HandleSignal);
+
+        lListenDescriptor = Listen(sOptions.mListenHost, sOptions.mListenPort);
+
+        if (lListenDescriptor != -1)
+        {
+            Log("Relaying %s:%s to %s:%s in %s mode\n",
+                sOptions.mListenHost.c_str(),
+                sOptions.mListenPort.c_str(),
+                sOptions.mUpstreamHost.c_str(),
+                sOptions.mUpstreamPort.c_str(),
+                ((sOptions.mMode == kModeCharacter) ? "character" : "line"));
+
+            lRetval = Run(lListenDescriptor);
+
+            close(lListenDescriptor);
+        }
+    }
+
+    return (lRetval);
+}
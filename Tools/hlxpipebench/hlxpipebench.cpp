@@ -0,0 +1,714 @@
+/*
+ *    Copyright (c) 2026 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+
+/**
+ *  @file
+ *    This file implements a benchmark of refresh time through the
+ *    command pipeline at various pipeline depths.
+ *
+ *    For each depth, the benchmark connects to an HLX server,
+ *    typically an instance of _hlxlatencyd_ relaying to the openhlx
+ *    _hlxsimd_ simulator in either of its modes, and queries every
+ *    group and every zone through the command pipeline, as Open HLX
+ *    does when it resumes a session. Each query is issued to the
+ *    server as the pipeline allows it and is retired from the
+ *    pipeline at the end of its answer, which the benchmark, reading
+ *    the server's responses itself, sees. Open HLX, which sees only
+ *    the state changes its client controller reports, instead waits
+ *    for each answer to go quiet, so this is the least refresh time
+ *    for each depth.
+ *
+ *    For each depth, it reports the time until every query had been
+ *    answered in full, along with the pacing window and smoothed
+ *    round trip time the pipeline had settled on by then.
+ *
+ *    The benchmark depends on POSIX, the C++ Standard Library, and
+ *    _openhlx_. From the top of the package, with OPENHLX_CFLAGS
+ *    naming the same _openhlx_ header directories as the Xcode project
+ *    and OPENHLX_LIBS the _openhlx_ client, model, common, and
+ *    utilities libraries and _LogUtilities_ from an _openhlx_ build,
+ *    it may be built on Linux or macOS with:
+ *
+ *      % c++ -std=c++11 -O2 -I Source ${OPENHLX_CFLAGS} -o hlxpipebench Tools/hlxpipebench/hlxpipebench.cpp Source/CommandPipeline.cpp Source/CommandScheduler.cpp ${OPENHLX_LIBS}
+ *
+ */
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <ctype.h>
+#include <errno.h>
+#include <getopt.h>
+#include <netdb.h>
+#include <poll.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include "CommandPipeline.hpp"
+
+
+namespace
+{
+
+typedef CommandPipeline::Clock     Clock;
+typedef CommandPipeline::Duration  Duration;
+
+/**
+ *  The benchmark configuration, as established from the command
+ *  line.
+ *
+ */
+struct Options
+{
+    std::string          mHost;
+    std::string          mPort;
+    unsigned long        mGroups;
+    unsigned long        mZones;
+    std::vector<size_t>  mDepths;
+    Duration             mResponseTimeout;
+    Duration             mTimeout;
+};
+
+/**
+ *  A connection to the server and the output received but not yet
+ *  framed.
+ *
+ */
+struct Connection
+{
+    int          mDescriptor;
+    std::string  mBuffer;
+};
+
+/**
+ *  The outcome of a run.
+ *
+ */
+struct Result
+{
+    Clock::duration  mElapsed;
+    size_t           mWindow;
+    Duration         mRoundTripTime;
+    size_t           mMaximumInFlight;
+};
+
+const char * const   kDefaultHost              = "localhost";
+const char * const   kDefaultPort              = "2323";
+const char * const   kDefaultDepths            = "1,4,16";
+
+// HLX hardware has ten groups and twenty-four zones.
+
+const unsigned long  kDefaultGroups            = 10;
+const unsigned long  kDefaultZones             = 24;
+
+// The default response timeout is that with which Open HLX
+// initializes its pipeline.
+
+const long           kDefaultResponseTimeoutMs = 5000;
+const long           kDefaultTimeoutMs         = 60000;
+
+// The interval at which the pipeline is serviced while nothing
+// arrives, such that unanswered requests time out.
+
+const long           kServiceIntervalMs        = 50;
+
+const size_t         kReadBufferSize           = 4096;
+
+Options              sOptions;
+
+// MARK: Logging
+
+void
+Log(const char *aFormat, ...)
+{
+    va_list lArguments;
+
+    va_start(lArguments, aFormat);
+    vfprintf(stderr, aFormat, lArguments);
+    va_end(lArguments);
+}
+
+long long
+Milliseconds(const Clock::duration &aDuration)
+{
+    return (static_cast<long long>(std::chrono::duration_cast<std::chrono::milliseconds>(aDuration).count()));
+}
+
+// MARK: Option Parsing
+
+void
+Usage(const char *aProgram, FILE *aStream)
+{
+    fprintf(aStream,
+            "Usage: %s [ options ]\n"
+            "\n"
+            "Benchmark the time to query every HLX group and zone through the\n"
+            "command pipeline at various pipeline depths.\n"
+            "\n"
+            " -c, --connect <host>[:<port>]\n"
+            "                             Connect to the specified HLX server\n"
+            "                             (default: %s:%s).\n"
+            " -d, --depths <depth>[,...]  Pipeline depths to run at, from %zu to\n"
+            "                             %zu (default: %s).\n"
+            " -g, --groups <count>        Number of groups (default: %lu).\n"
+            " -h, --help                  Print this help and exit.\n"
+            " -r, --response-timeout <ms> Pipeline response timeout (default:\n"
+            "                             %ld ms).\n"
+            " -T, --timeout <ms>          Time to wait for each run (default:\n"
+            "                             %ld ms).\n"
+            " -z, --zones <count>         Number of zones (default: %lu).\n",
+            aProgram,
+            kDefaultHost,
+            kDefaultPort,
+            CommandPipeline::kDepthMinimum,
+            CommandPipeline::kDepthMaximum,
+            kDefaultDepths,
+            kDefaultGroups,
+            kDefaultResponseTimeoutMs,
+            kDefaultTimeoutMs,
+            kDefaultZones);
+}
+
+bool
+ParseCount(const char *aString, const unsigned long &aMinimum, const unsigned long &aMaximum, unsigned long &aCount)
+{
+    char *  lEnd;
+    bool    lRetval;
+
+    aCount = strtoul(aString, &lEnd, 10);
+
+    lRetval = ((*aString != '\0') && (*lEnd == '\0') && (aCount >= aMinimum) && (aCount <= aMaximum));
+
+    return (lRetval);
+}
+
+bool
+ParseMilliseconds(const char *aString, Duration &aDuration)
+{
+    unsigned long  lMilliseconds;
+    bool           lRetval;
+
+    lRetval = ParseCount(aString, 1, 3600000, lMilliseconds);
+
+    if (lRetval)
+    {
+        aDuration = Duration(static_cast<Duration::rep>(lMilliseconds));
+    }
+
+    return (lRetval);
+}
+
+bool
+ParseDepths(const char *aString, std::vector<size_t> &aDepths)
+{
+    const std::string  lString(aString);
+    size_t             lStart = 0;
+    size_t             lComma;
+    unsigned long      lDepth;
+    bool               lRetval = true;
+
+    aDepths.clear();
+
+    do
+    {
+        lComma  = lString.find(',', lStart);
+        lRetval = ParseCount(lString.substr(lStart, lComma - lStart).c_str(),
+                             CommandPipeline::kDepthMinimum,
+                             CommandPipeline::kDepthMaximum,
+                             lDepth);
+
+        if (lRetval)
+        {
+            aDepths.push_back(lDepth);
+        }
+
+        lStart = lComma + 1;
+    }
+    while (lRetval && (lComma != std::string::npos));
+
+    return (lRetval);
+}
+
+/**
+ *  @brief
+ *    Split a host and optional port, in the form "host", "host:port",
+ *    "[v6-address]", or "[v6-address]:port".
+ *
+ */
+void
+ParseHostAndPort(const char *aString, std::string &aHost, std::string &aPort)
+{
+    const std::string  lString(aString);
+    size_t             lColon;
+
+    if ((lString.size() > 0) && (lString[0] == '['))
+    {
+        const size_t lClose = lString.find(']');
+
+        aHost = lString.substr(1, lClose - 1);
+
+        if ((lClose != std::string::npos) && ((lClose + 1) < lString.size()) && (lString[lClose + 1] == ':'))
+        {
+            aPort = lString.substr(lClose + 2);
+        }
+    }
+    else if (((lColon = lString.rfind(':')) != std::string::npos) && (lString.find(':') == lColon))
+    {
+        aHost = lString.substr(0, lColon);
+        aPort = lString.substr(lColon + 1);
+    }
+    else
+    {
+        aHost = lString;
+    }
+}
+
+bool
+ParseOptions(int argc, char * const argv[])
+{
+    static const struct option sLongOptions[] =
+    {
+        { "connect",          required_argument, nullptr, 'c' },
+        { "depths",           required_argument, nullptr, 'd' },
+        { "groups",           required_argument, nullptr, 'g' },
+        { "help",             no_argument,       nullptr, 'h' },
+        { "response-timeout", required_argument, nullptr, 'r' },
+        { "timeout",          required_argument, nullptr, 'T' },
+        { "zones",            required_argument, nullptr, 'z' },
+        { nullptr,            0,                 nullptr, 0   }
+    };
+    int   lOption;
+    bool  lRetval = true;
+
+    sOptions.mHost            = kDefaultHost;
+    sOptions.mPort            = kDefaultPort;
+    sOptions.mGroups          = kDefaultGroups;
+    sOptions.mZones           = kDefaultZones;
+    sOptions.mResponseTimeout = Duration(kDefaultResponseTimeoutMs);
+    sOptions.mTimeout         = Duration(kDefaultTimeoutMs);
+
+    ParseDepths(kDefaultDepths, sOptions.mDepths);
+
+    while (lRetval && ((lOption = getopt_long(argc, argv, "c:d:g:hr:T:z:", sLongOptions, nullptr)) != -1))
+    {
+        switch (lOption)
+        {
+
+        case 'c':
+            ParseHostAndPort(optarg, sOptions.mHost, sOptions.mPort);
+            break;
+
+        case 'd':
+            lRetval = ParseDepths(optarg, sOptions.mDepths);
+            break;
+
+        case 'g':
+            lRetval = ParseCount(optarg, 0, 255, sOptions.mGroups);
+            break;
+
+        case 'h':
+            Usage(argv[0], stdout);
+            exit(EXIT_SUCCESS);
+            break;
+
+        case 'r':
+            lRetval = ParseMilliseconds(optarg, sOptions.mResponseTimeout);
+            break;
+
+        case 'T':
+            lRetval = ParseMilliseconds(optarg, sOptions.mTimeout);
+            break;
+
+        case 'z':
+            lRetval = ParseCount(optarg, 0, 255, sOptions.mZones);
+            break;
+
+        default:
+            lRetval = false;
+            break;
+
+        }
+    }
+
+    lRetval = (lRetval && (optind == argc) && !sOptions.mHost.empty() && !sOptions.mPort.empty());
+    lRetval = (lRetval && ((sOptions.mGroups + sOptions.mZones) > 0));
+
+    if (!lRetval)
+    {
+        Usage(argv[0], stderr);
+    }
+
+    return (lRetval);
+}
+
+// MARK: Sockets
+
+/**
+ *  @brief
+ *    Open a connection to the specified host and port.
+ *
+ *  @returns
+ *    True if connected; otherwise, false.
+ *
+ */
+bool
+Connect(const std::string &aHost, const std::string &aPort, Connection &aConnection)
+{
+    struct addrinfo   lHints;
+    struct addrinfo * lAddresses = nullptr;
+    struct addrinfo * lAddress;
+    int               lStatus;
+
+    aConnection.mDescriptor = -1;
+    aConnection.mBuffer.clear();
+
+    memset(&lHints, 0, sizeof (lHints));
+
+    lHints.ai_family   = AF_UNSPEC;
+    lHints.ai_socktype = SOCK_STREAM;
+
+    lStatus = getaddrinfo(aHost.c_str(), aPort.c_str(), &lHints, &lAddresses);
+
+    if (lStatus != 0)
+    {
+        Log("Could not resolve %s:%s: %s\n", aHost.c_str(), aPort.c_str(), gai_strerror(lStatus));
+    }
+
+    for (lAddress = lAddresses; (lStatus == 0) && (lAddress != nullptr) && (aConnection.mDescriptor == -1); lAddress = lAddress->ai_next)
+    {
+        aConnection.mDescriptor = socket(lAddress->ai_family, lAddress->ai_socktype, lAddress->ai_protocol);
+
+        if ((aConnection.mDescriptor != -1) && (connect(aConnection.mDescriptor, lAddress->ai_addr, lAddress->ai_addrlen) != 0))
+        {
+            close(aConnection.mDescriptor);
+
+            aConnection.mDescriptor = -1;
+        }
+    }
+
+    if ((lStatus == 0) && (aConnection.mDescriptor == -1))
+    {
+        Log("Could not connect to %s:%s: %s\n", aHost.c_str(), aPort.c_str(), strerror(errno));
+    }
+
+    if (lAddresses != nullptr)
+    {
+        freeaddrinfo(lAddresses);
+    }
+
+    return (aConnection.mDescriptor != -1);
+}
+
+/**
+ *  @brief
+ *    Send the specified, formatted, request frame.
+ *
+ *  @returns
+ *    True if all of the frame was written; otherwise, false.
+ *
+ */
+bool
+Send(const Connection &aConnection, const char *aFormat, ...)
+{
+    char     lFrame[64];
+    va_list  lArguments;
+    int      lLength;
+    ssize_t  lWritten = 0;
+    size_t   lOffset = 0;
+
+    va_start(lArguments, aFormat);
+    lLength = vsnprintf(lFrame, sizeof (lFrame), aFormat, lArguments);
+    va_end(lArguments);
+
+    while ((lLength > 0) && (lOffset < static_cast<size_t>(lLength)) && (lWritten >= 0))
+    {
+        lWritten = write(aConnection.mDescriptor, &lFrame[lOffset], static_cast<size_t>(lLength) - lOffset);
+
+        if (lWritten > 0)
+        {
+            lOffset += static_cast<size_t>(lWritten);
+        }
+        else if ((lWritten < 0) && (errno == EINTR))
+        {
+            lWritten = 0;
+        }
+    }
+
+    return ((lLength > 0) && (lOffset == static_cast<size_t>(lLength)));
+}
+
+/**
+ *  @brief
+ *    Receive the next response frame, "(...)", by the specified
+ *    deadline.
+ *
+ *  Anything outside of a frame, such as line endings, is
+ *  discarded. Quoted names within a frame may themselves contain
+ *  parentheses.
+ *
+ *  @param[out]  aClosed  Set to true if the connection was closed or
+ *                        failed.
+ *
+ *  @returns
+ *    True if a frame was received; otherwise, false.
+ *
+ */
+bool
+Receive(Connection &aConnection, const Clock::time_point &aDeadline, std::string &aFrame, bool &aClosed)
+{
+    bool  lRetval = false;
+    bool  lDone = false;
+
+    aClosed = false;
+
+    while (!lDone)
+    {
+        const size_t  lOpen = aConnection.mBuffer.find('(');
+        bool          lQuoted = false;
+        size_t        lClose = std::string::npos;
+
+        for (size_t lIndex = lOpen; (lOpen != std::string::npos) && (lIndex < aConnection.mBuffer.size()) && (lClose == std::string::npos); lIndex++)
+        {
+            if (aConnection.mBuffer[lIndex] == '"')
+            {
+                lQuoted = !lQuoted;
+            }
+            else if ((aConnection.mBuffer[lIndex] == ')') && !lQuoted)
+            {
+                lClose = lIndex;
+            }
+        }
+
+        if (lClose != std::string::npos)
+        {
+            aFrame = aConnection.mBuffer.substr(lOpen, lClose - lOpen + 1);
+            aConnection.mBuffer.erase(0, lClose + 1);
+
+            lRetval = true;
+            lDone   = true;
+        }
+        else
+        {
+            const Clock::time_point  lNow = Clock::now();
+            struct pollfd            lDescriptor = { aConnection.mDescriptor, POLLIN, 0 };
+            char                     lBuffer[kReadBufferSize];
+            int                      lStatus;
+            ssize_t                  lRead;
+
+            lStatus = ((lNow < aDeadline) ? poll(&lDescriptor, 1, static_cast<int>(Milliseconds(aDeadline - lNow)) + 1) : 0);
+
+            if (lStatus > 0)
+            {
+                lRead = read(aConnection.mDescriptor, lBuffer, sizeof (lBuffer));
+
+                if (lRead > 0)
+                {
+                    aConnection.mBuffer.append(lBuffer, static_cast<size_t>(lRead));
+                }
+                else if ((lRead == 0) || (errno != EINTR))
+                {
+                    aClosed = true;
+                    lDone   = true;
+                }
+            }
+            else if ((lStatus == 0) || (errno != EINTR))
+            {
+                aClosed = (lStatus != 0);
+                lDone   = true;
+            }
+        }
+    }
+
+    return (lRetval);
+}
+
+// MARK: Protocol
+
+/**
+ *  @brief
+ *    Return the group or zone a response frame is about and whether
+ *    it ends the answer to a query.
+ *
+ *  Group and zone responses name the entity with a "G" or "O",
+ *  respectively, followed by its identifier, after a command prefix
+ *  of other capital letters, such as "(VMO12)" or "(QG3)".
+ *
+ *  @returns
+ *    True if the frame is about a group or zone; otherwise, false.
+ *
+ */
+bool
+GetEntity(const std::string &aFrame, CommandPipeline::Kind &aKind, CommandPipeline::IdentifierType &aIdentifier, bool &aIsEnd)
+{
+    size_t  lIndex = 1;
+    bool    lRetval = false;
+
+    while ((lIndex + 1) < aFrame.size() && isupper(static_cast<unsigned char>(aFrame[lIndex])) && !lRetval)
+    {
+        if (((aFrame[lIndex] == 'G') || (aFrame[lIndex] == 'O')) && isdigit(static_cast<unsigned char>(aFrame[lIndex + 1])))
+        {
+            aKind       = ((aFrame[lIndex] == 'G') ? CommandPipeline::kKindGroup : CommandPipeline::kKindZone);
+            aIdentifier = static_cast<CommandPipeline::IdentifierType>(strtoul(&aFrame[lIndex + 1], nullptr, 10));
+            aIsEnd      = ((lIndex == 2) && (aFrame[1] == 'Q') && (aFrame[aFrame.size() - 1] == ')') && isdigit(static_cast<unsigned char>(aFrame[aFrame.size() - 2])));
+
+            lRetval     = true;
+        }
+
+        lIndex++;
+    }
+
+    return (lRetval);
+}
+
+// MARK: Benchmark
+
+// Query every group and every zone through a pipeline of the
+// specified depth until each has been answered in full.
+
+bool
+Run(const size_t &aDepth, Result &aResult)
+{
+    const unsigned long  lTotal = (sOptions.mGroups + sOptions.mZones);
+    Connection           lConnection = { -1, std::string() };
+    CommandPipeline      lPipeline;
+    Clock::time_point    lStart;
+    Clock::time_point    lDeadline;
+    unsigned long        lAnswered = 0;
+    HLX::Common::Status  lStatus;
+    bool                 lClosed = false;
+    bool                 lRetval;
+
+    lRetval = Connect(sOptions.mHost, sOptions.mPort, lConnection);
+
+    if (lRetval)
+    {
+        lStatus = lPipeline.Init(aDepth, sOptions.mResponseTimeout);
+        lRetval = (lStatus == HLX::Common::kStatus_Success);
+    }
+
+    aResult.mMaximumInFlight = 0;
+
+    lStart    = Clock::now();
+    lDeadline = lStart + sOptions.mTimeout;
+
+    for (unsigned long lEntity = 0; lRetval && (lEntity < lTotal); lEntity++)
+    {
+        const bool                             lIsGroup = (lEntity < sOptions.mGroups);
+        const CommandPipeline::IdentifierType  lIdentifier = static_cast<CommandPipeline::IdentifierType>(lIsGroup ? (lEntity + 1) : (lEntity - sOptions.mGroups + 1));
+        const Connection *                     lIssuing = &lConnection;
+
+        lStatus = lPipeline.Enqueue((lIsGroup ? CommandPipeline::kKindGroup : CommandPipeline::kKindZone),
+                                    lIdentifier,
+                                    CommandPipeline::kAnswerAll,
+                                    CommandScheduler::kLaneBackground,
+                                    CommandPipeline::kResponseQuery,
+                                    [lIssuing, lIsGroup, lIdentifier]() {
+                                        return (Send(*lIssuing, "[Q%c%u]", (lIsGroup ? 'G' : 'O'), lIdentifier) ? HLX::Common::kStatus_Success : -EIO);
+                                    });
+        lRetval = (lStatus == HLX::Common::kStatus_Success);
+    }
+
+    while (lRetval && (lAnswered < lTotal))
+    {
+        const Clock::time_point          lNow = Clock::now();
+        std::string                      lFrame;
+        CommandPipeline::Kind            lKind;
+        CommandPipeline::IdentifierType  lIdentifier;
+        bool                             lIsEnd = false;
+
+        aResult.mMaximumInFlight = std::max(aResult.mMaximumInFlight, lPipeline.GetInFlightCount());
+
+        if (Receive(lConnection, std::min(lDeadline, lNow + Duration(kServiceIntervalMs)), lFrame, lClosed))
+        {
+            if (GetEntity(lFrame, lKind, lIdentifier, lIsEnd) && lIsEnd)
+            {
+                lPipeline.DidCompleteResponse(lKind, lIdentifier);
+
+                lAnswered++;
+            }
+        }
+        else if (lClosed || (Clock::now() >= lDeadline))
+        {
+            Log("Depth %zu: %lu of %lu queries answered\n", aDepth, lAnswered, lTotal);
+
+            lRetval = false;
+        }
+        else
+        {
+            lPipeline.Service();
+        }
+    }
+
+    aResult.mElapsed       = (Clock::now() - lStart);
+    aResult.mWindow        = lPipeline.GetWindow();
+    aResult.mRoundTripTime = lPipeline.GetRoundTripTime();
+
+    if (lConnection.mDescriptor != -1)
+    {
+        close(lConnection.mDescriptor);
+    }
+
+    return (lRetval);
+}
+
+}; // namespace
+
+int
+main(int argc, char * const argv[])
+{
+    Result  lResult;
+    bool    lStatus = true;
+    int     lRetval = EXIT_FAILURE;
+
+    if (ParseOptions(argc, argv))
+    {
+        printf("%lu groups and %lu zones queried through %s:%s:\n",
+               sOptions.mGroups,
+               sOptions.mZones,
+               sOptions.mHost.c_str(),
+               sOptions.mPort.c_str());
+        printf("  %-6s %12s %9s %9s %9s %9s\n", "depth", "refresh ms", "query/s", "in flight", "window", "srtt ms");
+
+        for (size_t lIndex = 0; lStatus && (lIndex < sOptions.mDepths.size()); lIndex++)
+        {
+            lStatus = Run(sOptions.mDepths[lIndex], lResult);
+
+            if (lStatus)
+            {
+                printf("  %-6zu %12lld %9.1f %9zu %9zu %9lld\n",
+                       sOptions.mDepths[lIndex],
+                       Milliseconds(lResult.mElapsed),
+                       ((sOptions.mGroups + sOptions.mZones) * 1000.0) / std::max(Milliseconds(lResult.mElapsed), 1LL),
+                       lResult.mMaximumInFlight,
+                       lResult.mWindow,
+                       static_cast<long long>(lResult.mRoundTripTime.count()));
+            }
+        }
+
+        lRetval = (lStatus ? EXIT_SUCCESS : EXIT_FAILURE);
+    }
+
+    return (lRetval);
+}
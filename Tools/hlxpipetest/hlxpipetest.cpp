@@ -0,0 +1,394 @@
+/*
+ *    Copyright (c) 2026 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+
+/**
+ *  @file
+ *    This file implements a test that the command pipeline matches
+ *    each state change only to a request it answers.
+ *
+ *    Each case enqueues requests through a command pipeline whose
+ *    issuers send nothing, reports state changes to it as the client
+ *    controller would, and checks which requests remain in flight
+ *    and whether their round trip times were measured. Among them, a
+ *    query and a volume set on the same zone are put in flight
+ *    together, both where the query's answer reports a volume change
+ *    of its own and where it does not.
+ *
+ *    The test exits with failure if any case fails.
+ *
+ *    The test depends on POSIX, the C++ Standard Library, and
+ *    _openhlx_. From the top of the package, with OPENHLX_CFLAGS
+ *    naming the same _openhlx_ header directories as the Xcode project
+ *    and OPENHLX_LIBS the _openhlx_ client, model, common, and
+ *    utilities libraries and _LogUtilities_ from an _openhlx_ build,
+ *    it may be built on Linux or macOS with:
+ *
+ *      % c++ -std=c++11 -O2 -I Source ${OPENHLX_CFLAGS} -o hlxpipetest Tools/hlxpipetest/hlxpipetest.cpp Source/CommandPipeline.cpp Source/CommandScheduler.cpp ${OPENHLX_LIBS}
+ *
+ */
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "CommandPipeline.hpp"
+
+
+namespace
+{
+
+typedef CommandPipeline::Clock     Clock;
+typedef CommandPipeline::Duration  Duration;
+
+/**
+ *  A command pipeline under test and the names of the requests it
+ *  has issued, in order.
+ *
+ */
+struct Fixture
+{
+    CommandPipeline           mPipeline;
+    std::vector<std::string>  mIssued;
+};
+
+// The response timeout for each case. Before the pipeline has
+// measured a round trip time, requests not expected to be answered,
+// and queries that have gone quiet, are retired after the lesser of
+// this and one second.
+
+const Duration  kResponseTimeout(2000);
+const Duration  kQuietTimeout(1000);
+
+// Time enough, past a timeout, for it to have elapsed; and time
+// enough, before an answer, for a round trip to measure as nonzero.
+
+const Duration  kMargin(100);
+const Duration  kRoundTrip(20);
+
+// MARK: Logging
+
+void
+Log(const char *aFormat, ...)
+{
+    va_list lArguments;
+
+    va_start(lArguments, aFormat);
+    vfprintf(stderr, aFormat, lArguments);
+    va_end(lArguments);
+}
+
+bool
+Check(const char *aCase, const bool &aCondition, const char *aWhat)
+{
+    if (!aCondition)
+    {
+        Log("%s: expected %s\n", aCase, aWhat);
+    }
+
+    return (aCondition);
+}
+
+// MARK: Fixture
+
+bool
+Init(Fixture &aFixture, const size_t &aDepth, const Duration &aResponseTimeout)
+{
+    aFixture.mIssued.clear();
+
+    return (aFixture.mPipeline.Init(aDepth, aResponseTimeout) == HLX::Common::kStatus_Success);
+}
+
+CommandPipeline::Issuer
+MakeIssuer(Fixture &aFixture, const char *aName)
+{
+    std::vector<std::string> * const  lIssued = &aFixture.mIssued;
+    const std::string                 lName = aName;
+
+    return ([lIssued, lName]() { lIssued->push_back(lName); return (HLX::Common::kStatus_Success); });
+}
+
+bool
+EnqueueQuery(Fixture &aFixture, const CommandPipeline::IdentifierType &aZone, const char *aName)
+{
+    return (aFixture.mPipeline.Enqueue(CommandPipeline::kKindZone,
+                                       aZone,
+                                       CommandPipeline::kAnswerAll,
+                                       CommandScheduler::kLaneBackground,
+                                       CommandPipeline::kResponseQuery,
+                                       MakeIssuer(aFixture, aName)) == HLX::Common::kStatus_Success);
+}
+
+bool
+EnqueueSet(Fixture &aFixture, const CommandPipeline::IdentifierType &aZone, const CommandPipeline::Answers &aAnswers, const CommandScheduler::Lane &aLane, const char *aName)
+{
+    return (aFixture.mPipeline.Enqueue(CommandPipeline::kKindZone,
+                                       aZone,
+                                       aAnswers,
+                                       aLane,
+                                       MakeIssuer(aFixture, aName)) == HLX::Common::kStatus_Success);
+}
+
+void
+Answer(Fixture &aFixture, const CommandPipeline::IdentifierType &aZone, const CommandPipeline::Answers &aAnswer)
+{
+    aFixture.mPipeline.DidReceiveResponse(CommandPipeline::kKindZone, aZone, aAnswer);
+}
+
+void
+Wait(Fixture &aFixture, const Duration &aDuration)
+{
+    std::this_thread::sleep_for(aDuration);
+
+    aFixture.mPipeline.Service();
+}
+
+// MARK: Cases
+
+// A query and a volume set on the same zone in flight together,
+// where the query's answer reports a volume change of its own ahead
+// of the set's: the query takes the first, the set the second, and
+// neither is retired by the name and mute changes of the query.
+
+bool
+QueryAndSetBothChangeVolume(void)
+{
+    const char * const  lCase = "query and set both change volume";
+    Fixture             lFixture;
+    bool                lRetval;
+
+    lRetval = Init(lFixture, 2, kResponseTimeout);
+
+    lRetval = lRetval && EnqueueQuery(lFixture, 1, "query");
+    lRetval = lRetval && EnqueueSet(lFixture, 1, CommandPipeline::kAnswerVolume, CommandScheduler::kLaneInteractive, "set");
+    lRetval = lRetval && Check(lCase, lFixture.mPipeline.GetInFlightCount() == 2, "both in flight");
+
+    Answer(lFixture, 1, CommandPipeline::kAnswerName);
+    Answer(lFixture, 1, CommandPipeline::kAnswerVolume);
+    Answer(lFixture, 1, CommandPipeline::kAnswerMute);
+
+    lRetval = lRetval && Check(lCase, lFixture.mPipeline.GetInFlightCount() == 2, "both in flight after the query's answer");
+
+    Answer(lFixture, 1, CommandPipeline::kAnswerVolume);
+
+    lRetval = lRetval && Check(lCase, lFixture.mPipeline.GetInFlightCount() == 1, "the set retired by its answer");
+
+    // The set may not be timed, since the query ahead of it might have
+    // taken its answer.
+
+    lRetval = lRetval && Check(lCase, lFixture.mPipeline.GetRoundTripTime() == Duration::zero(), "no round trip time measured");
+
+    Wait(lFixture, kQuietTimeout + kMargin);
+
+    lRetval = lRetval && Check(lCase, lFixture.mPipeline.GetInFlightCount() == 0, "the query retired once quiet");
+
+    return (lRetval);
+}
+
+// A query and a volume set on the same zone in flight together,
+// where only the set changes the volume: the query takes the set's
+// answer, so the set is retired along with the query, once it goes
+// quiet, rather than timing out as though unanswered.
+
+bool
+QueryAndSetOnlySetChangesVolume(void)
+{
+    const char * const  lCase = "query and set, only set changes volume";
+    Fixture             lFixture;
+    bool                lRetval;
+
+    lRetval = Init(lFixture, 2, kResponseTimeout);
+
+    lRetval = lRetval && EnqueueQuery(lFixture, 1, "query");
+    lRetval = lRetval && EnqueueSet(lFixture, 1, CommandPipeline::kAnswerVolume, CommandScheduler::kLaneInteractive, "set");
+
+    Answer(lFixture, 1, CommandPipeline::kAnswerVolume);
+
+    lRetval = lRetval && Check(lCase, lFixture.mPipeline.GetInFlightCount() == 2, "both in flight");
+
+    Wait(lFixture, kQuietTimeout + kMargin);
+
+    lRetval = lRetval && Check(lCase, lFixture.mPipeline.GetInFlightCount() == 0, "both retired once the query went quiet, before the set's timeout");
+    lRetval = lRetval && Check(lCase, lFixture.mPipeline.GetRoundTripTime() == Duration::zero(), "no round trip time measured");
+
+    return (lRetval);
+}
+
+// Sets on the same zone are each retired only by a change of the
+// property they set; changes of other properties or other zones,
+// such as those made by another controller, retire nothing.
+
+bool
+SetsMatchOnlyTheirProperty(void)
+{
+    const char * const  lCase = "sets match only their property";
+    Fixture             lFixture;
+    bool                lRetval;
+
+    lRetval = Init(lFixture, 2, kResponseTimeout);
+
+    lRetval = lRetval && EnqueueSet(lFixture, 1, CommandPipeline::kAnswerVolume, CommandScheduler::kLaneInteractive, "volume");
+    lRetval = lRetval && EnqueueSet(lFixture, 1, CommandPipeline::kAnswerMute, CommandScheduler::kLaneInteractive, "mute");
+    lRetval = lRetval && Check(lCase, lFixture.mPipeline.GetInFlightCount() == 2, "both in flight");
+
+    std::this_thread::sleep_for(kRoundTrip);
+
+    Answer(lFixture, 1, CommandPipeline::kAnswerName);
+    Answer(lFixture, 1, CommandPipeline::kAnswerSource);
+    Answer(lFixture, 2, CommandPipeline::kAnswerMute);
+
+    lRetval = lRetval && Check(lCase, lFixture.mPipeline.GetInFlightCount() == 2, "both in flight after unrelated changes");
+
+    Answer(lFixture, 1, CommandPipeline::kAnswerMute);
+
+    lRetval = lRetval && Check(lCase, lFixture.mPipeline.GetInFlightCount() == 1, "the mute retired by its answer");
+    lRetval = lRetval && Check(lCase, lFixture.mPipeline.GetRoundTripTime() >= kRoundTrip, "the mute round trip time measured");
+
+    Answer(lFixture, 1, CommandPipeline::kAnswerVolume);
+
+    lRetval = lRetval && Check(lCase, lFixture.mPipeline.GetInFlightCount() == 0, "the volume retired by its answer");
+
+    return (lRetval);
+}
+
+// At a depth of one, nothing is issued while a query's answer is
+// still arriving, however many state changes it reports.
+
+bool
+DepthOneWaitsOnQuery(void)
+{
+    const char * const  lCase = "depth one waits on query";
+    Fixture             lFixture;
+    bool                lRetval;
+
+    lRetval = Init(lFixture, 1, kResponseTimeout);
+
+    lRetval = lRetval && EnqueueQuery(lFixture, 1, "query");
+    lRetval = lRetval && EnqueueSet(lFixture, 2, CommandPipeline::kAnswerVolume, CommandScheduler::kLaneUser, "set");
+
+    Answer(lFixture, 1, CommandPipeline::kAnswerName);
+    Answer(lFixture, 1, CommandPipeline::kAnswerSource);
+    Answer(lFixture, 1, CommandPipeline::kAnswerVolume);
+
+    lRetval = lRetval && Check(lCase, (lFixture.mIssued.size() == 1) && (lFixture.mPipeline.GetPendingCount() == 1), "the set still waiting");
+
+    Wait(lFixture, kQuietTimeout + kMargin);
+
+    lRetval = lRetval && Check(lCase, (lFixture.mIssued.size() == 2) && (lFixture.mIssued[1] == "set"), "the set issued once the query went quiet");
+
+    return (lRetval);
+}
+
+// A query whose end the caller sees is retired then, with its round
+// trip time measured.
+
+bool
+QueryCompletes(void)
+{
+    const char * const  lCase = "query completes";
+    Fixture             lFixture;
+    bool                lRetval;
+
+    lRetval = Init(lFixture, 2, kResponseTimeout);
+
+    lRetval = lRetval && EnqueueQuery(lFixture, 3, "query");
+
+    std::this_thread::sleep_for(kRoundTrip);
+
+    Answer(lFixture, 3, CommandPipeline::kAnswerVolume);
+
+    lFixture.mPipeline.DidCompleteResponse(CommandPipeline::kKindZone, 3);
+
+    lRetval = lRetval && Check(lCase, lFixture.mPipeline.GetInFlightCount() == 0, "the query retired");
+    lRetval = lRetval && Check(lCase, lFixture.mPipeline.GetRoundTripTime() >= kRoundTrip, "the query round trip time measured");
+
+    return (lRetval);
+}
+
+// After Karn, a set of a property for which a set timed out is not
+// timed, since the state change it is matched to may be the late
+// answer to the one that timed out; a set of another property is.
+
+bool
+TimedOutSetIsNotSampled(void)
+{
+    const char * const  lCase = "timed out set is not sampled";
+    const Duration      lResponseTimeout(100);
+    Fixture             lFixture;
+    bool                lRetval;
+
+    lRetval = Init(lFixture, 2, lResponseTimeout);
+
+    lRetval = lRetval && EnqueueSet(lFixture, 1, CommandPipeline::kAnswerVolume, CommandScheduler::kLaneUser, "volume");
+
+    Wait(lFixture, lResponseTimeout + kMargin);
+
+    lRetval = lRetval && Check(lCase, lFixture.mPipeline.GetInFlightCount() == 0, "the set timed out");
+
+    lRetval = lRetval && EnqueueSet(lFixture, 1, CommandPipeline::kAnswerVolume, CommandScheduler::kLaneUser, "volume again");
+
+    std::this_thread::sleep_for(kRoundTrip);
+
+    Answer(lFixture, 1, CommandPipeline::kAnswerVolume);
+
+    lRetval = lRetval && Check(lCase, lFixture.mPipeline.GetInFlightCount() == 0, "the second set retired");
+    lRetval = lRetval && Check(lCase, lFixture.mPipeline.GetRoundTripTime() == Duration::zero(), "no round trip time measured");
+
+    lRetval = lRetval && EnqueueSet(lFixture, 1, CommandPipeline::kAnswerMute, CommandScheduler::kLaneUser, "mute");
+
+    std::this_thread::sleep_for(kRoundTrip);
+
+    Answer(lFixture, 1, CommandPipeline::kAnswerMute);
+
+    lRetval = lRetval && Check(lCase, lFixture.mPipeline.GetRoundTripTime() >= kRoundTrip, "the mute round trip time measured");
+
+    return (lRetval);
+}
+
+}; // namespace
+
+int
+main(void)
+{
+    static bool (* const sCases[])(void) = {
+        QueryAndSetBothChangeVolume,
+        QueryAndSetOnlySetChangesVolume,
+        SetsMatchOnlyTheirProperty,
+        DepthOneWaitsOnQuery,
+        QueryCompletes,
+        TimedOutSetIsNotSampled
+    };
+    unsigned int  lFailed = 0;
+
+    for (const auto &lCase : sCases)
+    {
+        if (!lCase())
+        {
+            lFailed++;
+        }
+    }
+
+    printf("%zu cases; %u failed\n", (sizeof (sCases) / sizeof (sCases[0])), lFailed);
+
+    return ((lFailed == 0) ? EXIT_SUCCESS : EXIT_FAILURE);
+}
@@ -0,0 +1,543 @@
+/*
+ *    Copyright (c) 2026 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *  @file
+ *    This file implements a benchmark for the HLX command planner.
+ *
+ *    The benchmark generates random multi-zone changes against random
+ *    group memberships, of the sort applying a scene makes, and plans
+ *    each with the command planner. It reports the bytes on the wire,
+ *    and the time those take at a configurable per-character delay,
+ *    of the plans against those of an absolute set per changed zone
+ *    property, along with how long planning takes.
+ *
+ *    Each plan is also checked: it is executed against a model of the
+ *    zones and must leave every zone property at its target, touch no
+ *    zone not being changed, and cost what the planner said it would.
+ *    The benchmark exits with failure on any violation.
+ *
+ *    The benchmark depends only on POSIX and the C++ Standard Library
+ *    and may be built, from the top of the package, on Linux or macOS
+ *    with:
+ *
+ *      % c++ -std=c++11 -O2 -I Source -o hlxplanbench Tools/hlxplanbench/hlxplanbench.cpp Source/CommandPlanner.cpp
+ *
+ */
+
+#include <chrono>
+#include <map>
+#include <random>
+#include <set>
+#include <vector>
+
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "CommandPlanner.hpp"
+
+
+namespace
+{
+
+typedef std::chrono::steady_clock  Clock;
+typedef std::chrono::nanoseconds   Duration;
+
+/**
+ *  The benchmark configuration, as established from the command
+ *  line.
+ *
+ */
+struct Options
+{
+    unsigned long  mIterations;
+    unsigned long  mZones;
+    unsigned long  mGroups;
+    unsigned long  mSeed;
+    double         mCharacterDelayMs;
+    bool           mGroupEchoesZones;
+    bool           mVerbose;
+};
+
+/**
+ *  A model of the state of each zone, by property.
+ *
+ */
+typedef std::map<CommandPlanner::IdentifierType, std::vector<CommandPlanner::ValueType> > ZoneStates;
+
+const unsigned long  kDefaultIterations       = 10000;
+const unsigned long  kDefaultZones            = 24;
+const unsigned long  kDefaultGroups           = 10;
+const unsigned long  kDefaultSeed             = 1;
+
+// The default per-character delay approximates the observed
+// character-at-a-time output rate of real HLX hardware.
+
+const double         kDefaultCharacterDelayMs = 1.0;
+
+const int            kSourcesMax              = 8;
+
+Options              sOptions;
+
+// MARK: Option Parsing
+
+void
+Usage(const char *aProgram, FILE *aStream)
+{
+    fprintf(aStream,
+            "Usage: %s [ options ]\n"
+            "\n"
+            "Benchmark and check the HLX command planner against random\n"
+            "multi-zone changes.\n"
+            "\n"
+            " -c, --character-delay <ms>  Delay per character on the wire used to\n"
+            "                             estimate time (default: %.3f ms).\n"
+            " -g, --groups <count>        Number of groups (default: %lu).\n"
+            " -h, --help                  Print this help and exit.\n"
+            " -i, --iterations <count>    Number of changes to plan (default: %lu).\n"
+            " -n, --no-group-echo         Cost group commands without a response\n"
+            "                             for each of their zones.\n"
+            " -s, --seed <seed>           Random seed (default: %lu).\n"
+            " -v, --verbose               Print each plan.\n"
+            " -z, --zones <count>         Number of zones (default: %lu).\n",
+            aProgram,
+            kDefaultCharacterDelayMs,
+            kDefaultGroups,
+            kDefaultIterations,
+            kDefaultSeed,
+            kDefaultZones);
+}
+
+bool
+ParseCount(const char *aString, const unsigned long &aMinimum, const unsigned long &aMaximum, unsigned long &aCount)
+{
+    char *  lEnd;
+    bool    lRetval;
+
+    aCount = strtoul(aString, &lEnd, 10);
+
+    lRetval = ((*aString != '\0') && (*lEnd == '\0') && (aCount >= aMinimum) && (aCount <= aMaximum));
+
+    return (lRetval);
+}
+
+bool
+ParseOptions(int argc, char * const argv[])
+{
+    static const struct option sLongOptions[] =
+    {
+        { "character-delay", required_argument, nullptr, 'c' },
+        { "groups",          required_argument, nullptr, 'g' },
+        { "help",            no_argument,       nullptr, 'h' },
+        { "iterations",      required_argument, nullptr, 'i' },
+        { "no-group-echo",   no_argument,       nullptr, 'n' },
+        { "seed",            required_argument, nullptr, 's' },
+        { "verbose",         no_argument,       nullptr, 'v' },
+        { "zones",           required_argument, nullptr, 'z' },
+        { nullptr,           0,                 nullptr, 0   }
+    };
+    int   lOption;
+    char *lEnd;
+    bool  lRetval = true;
+
+    sOptions.mIterations       = kDefaultIterations;
+    sOptions.mZones            = kDefaultZones;
+    sOptions.mGroups           = kDefaultGroups;
+    sOptions.mSeed             = kDefaultSeed;
+    sOptions.mCharacterDelayMs = kDefaultCharacterDelayMs;
+    sOptions.mGroupEchoesZones = true;
+    sOptions.mVerbose          = false;
+
+    while (lRetval && ((lOption = getopt_long(argc, argv, "c:g:hi:ns:vz:", sLongOptions, nullptr)) != -1))
+    {
+        switch (lOption)
+        {
+
+        case 'c':
+            sOptions.mCharacterDelayMs = strtod(optarg, &lEnd);
+            lRetval = ((*optarg != '\0') && (*lEnd == '\0') && (sOptions.mCharacterDelayMs >= 0));
+            break;
+
+        case 'g':
+            lRetval = ParseCount(optarg, 0, 255, sOptions.mGroups);
+            break;
+
+        case 'h':
+            Usage(argv[0], stdout);
+            exit(EXIT_SUCCESS);
+            break;
+
+        case 'i':
+            lRetval = ParseCount(optarg, 1, 100000000, sOptions.mIterations);
+            break;
+
+        case 'n':
+            sOptions.mGroupEchoesZones = false;
+            break;
+
+        case 's':
+            lRetval = ParseCount(optarg, 0, 0xFFFFFFFF, sOptions.mSeed);
+            break;
+
+        case 'v':
+            sOptions.mVerbose = true;
+            break;
+
+        case 'z':
+            lRetval = ParseCount(optarg, 1, 255, sOptions.mZones);
+            break;
+
+        default:
+            lRetval = false;
+            break;
+
+        }
+    }
+
+    lRetval = (lRetval && (optind == argc));
+
+    if (!lRetval)
+    {
+        Usage(argv[0], stderr);
+    }
+
+    return (lRetval);
+}
+
+// MARK: Generation
+
+CommandPlanner::ValueType
+RandomValue(std::mt19937 &aGenerator, const CommandPlanner::Property &aProperty)
+{
+    CommandPlanner::ValueType  lRetval = 0;
+
+    switch (aProperty)
+    {
+
+    case CommandPlanner::kPropertyVolume:
+        lRetval = std::uniform_int_distribution<int>(-80, 0)(aGenerator);
+        break;
+
+    case CommandPlanner::kPropertyMute:
+        lRetval = std::uniform_int_distribution<int>(0, 1)(aGenerator);
+        break;
+
+    case CommandPlanner::kPropertySource:
+        lRetval = std::uniform_int_distribution<int>(1, kSourcesMax)(aGenerator);
+        break;
+
+    case CommandPlanner::kPropertyBass:
+    case CommandPlanner::kPropertyTreble:
+        lRetval = std::uniform_int_distribution<int>(-12, 12)(aGenerator);
+        break;
+
+    default:
+        break;
+
+    }
+
+    return (lRetval);
+}
+
+// Generate groups of two to six random zones each.
+
+void
+GenerateGroups(std::mt19937 &aGenerator, CommandPlanner::Groups &aGroups)
+{
+    std::uniform_int_distribution<int>  lSize(2, 6);
+    std::uniform_int_distribution<int>  lZone(1, static_cast<int>(sOptions.mZones));
+
+    aGroups.clear();
+
+    for (unsigned long lIdentifier = 1; lIdentifier <= sOptions.mGroups; lIdentifier++)
+    {
+        CommandPlanner::Group               lGroup;
+        std::set<CommandPlanner::IdentifierType>  lZones;
+        const size_t                        lCount = std::min(static_cast<size_t>(lSize(aGenerator)), static_cast<size_t>(sOptions.mZones));
+
+        while (lZones.size() < lCount)
+        {
+            lZones.insert(static_cast<CommandPlanner::IdentifierType>(lZone(aGenerator)));
+        }
+
+        lGroup.mIdentifier = static_cast<CommandPlanner::IdentifierType>(lIdentifier);
+        lGroup.mZones.assign(lZones.begin(), lZones.end());
+
+        aGroups.push_back(lGroup);
+    }
+}
+
+// Generate the current state of every zone and a change for each
+// property of each zone, a mix of unchanged, one step, arbitrary,
+// and, for the zones of some groups, a shared target.
+
+void
+GenerateChanges(std::mt19937 &aGenerator, const CommandPlanner::Groups &aGroups, ZoneStates &aStates, CommandPlanner::Changes &aChanges)
+{
+    std::uniform_int_distribution<int>          lKind(0, 9);
+    std::map<CommandPlanner::IdentifierType, std::vector<bool> > lShared;
+
+    aStates.clear();
+    aChanges.clear();
+
+    for (unsigned long lZone = 1; lZone <= sOptions.mZones; lZone++)
+    {
+        std::vector<CommandPlanner::ValueType> &lState = aStates[static_cast<CommandPlanner::IdentifierType>(lZone)];
+
+        for (int lProperty = 0; lProperty < CommandPlanner::kPropertyMax; lProperty++)
+        {
+            lState.push_back(RandomValue(aGenerator, static_cast<CommandPlanner::Property>(lProperty)));
+        }
+    }
+
+    for (int lProperty = 0; lProperty < CommandPlanner::kPropertyMax; lProperty++)
+    {
+        std::map<CommandPlanner::IdentifierType, CommandPlanner::ValueType>  lTargets;
+        CommandPlanner::Groups::const_iterator                               lGroup;
+        ZoneStates::const_iterator                                           lState;
+
+        // Some groups have all of their zones changed to one target.
+
+        for (lGroup = aGroups.begin(); lGroup != aGroups.end(); lGroup++)
+        {
+            if (lKind(aGenerator) < 3)
+            {
+                const CommandPlanner::ValueType lTarget = RandomValue(aGenerator, static_cast<CommandPlanner::Property>(lProperty));
+
+                for (size_t lZone = 0; lZone < lGroup->mZones.size(); lZone++)
+                {
+                    lTargets[lGroup->mZones[lZone]] = lTarget;
+                }
+            }
+        }
+
+        for (lState = aStates.begin(); lState != aStates.end(); lState++)
+        {
+            CommandPlanner::Change  lChange;
+            const int               lDraw = lKind(aGenerator);
+
+            lChange.mZone       = lState->first;
+            lChange.mProperty   = static_cast<CommandPlanner::Property>(lProperty);
+            lChange.mHasCurrent = true;
+            lChange.mCurrent    = lState->second[lProperty];
+
+            if (lTargets.count(lState->first) != 0)
+                lChange.mTarget = lTargets[lState->first];
+            else if (lDraw < 4)
+                lChange.mTarget = lChange.mCurrent;
+            else if ((lDraw < 7) && CommandPlanner::IsRelative(lChange.mProperty))
+                lChange.mTarget = lChange.mCurrent + ((lChange.mCurrent < 0) ? 1 : -1);
+            else
+                lChange.mTarget = RandomValue(aGenerator, lChange.mProperty);
+
+            aChanges.push_back(lChange);
+        }
+    }
+}
+
+// MARK: Checking
+
+// Execute the plan against the zone model and check that it leaves
+// every zone property at its target, touches no other zone, and costs
+// what the planner said.
+
+bool
+Check(const CommandPlanner &aPlanner,
+      const CommandPlanner::Groups &aGroups,
+      const CommandPlanner::Changes &aChanges,
+      const CommandPlanner::Commands &aCommands,
+      const size_t &aCost,
+      ZoneStates &aStates)
+{
+    const CommandPlanner::Identifiers                                     lNoZones;
+    std::map<CommandPlanner::IdentifierType, const CommandPlanner::Group *>  lGroups;
+    std::set<std::pair<CommandPlanner::IdentifierType, int> >             lChanging;
+    CommandPlanner::Commands::const_iterator                              lCommand;
+    CommandPlanner::Changes::const_iterator                               lChange;
+    size_t                                                                lCost = 0;
+    bool                                                                  lRetval = true;
+
+    for (size_t lGroup = 0; lGroup < aGroups.size(); lGroup++)
+    {
+        lGroups[aGroups[lGroup].mIdentifier] = &aGroups[lGroup];
+    }
+
+    for (lChange = aChanges.begin(); lChange != aChanges.end(); lChange++)
+    {
+        lChanging.insert(std::make_pair(lChange->mZone, static_cast<int>(lChange->mProperty)));
+    }
+
+    for (lCommand = aCommands.begin(); lRetval && (lCommand != aCommands.end()); lCommand++)
+    {
+        CommandPlanner::Identifiers  lZones;
+
+        if (lCommand->mKind == CommandPlanner::kKindGroup)
+        {
+            lZones = lGroups[lCommand->mIdentifier]->mZones;
+
+            lCost += aPlanner.GetCostModel().GetCost(lCommand->mKind, lCommand->mIdentifier, lCommand->mProperty, lCommand->mEncoding, lCommand->mValue, lZones);
+        }
+        else
+        {
+            lZones.push_back(lCommand->mIdentifier);
+
+            lCost += aPlanner.GetCostModel().GetCost(lCommand->mKind, lCommand->mIdentifier, lCommand->mProperty, lCommand->mEncoding, lCommand->mValue, lNoZones);
+        }
+
+        for (size_t lZone = 0; lRetval && (lZone < lZones.size()); lZone++)
+        {
+            CommandPlanner::ValueType &lValue = aStates[lZones[lZone]][lCommand->mProperty];
+
+            if (lChanging.count(std::make_pair(lZones[lZone], static_cast<int>(lCommand->mProperty))) == 0)
+            {
+                fprintf(stderr, "Zone %u property %d was not to be changed\n", lZones[lZone], lCommand->mProperty);
+                lRetval = false;
+            }
+
+            if (lCommand->mEncoding == CommandPlanner::kEncodingIncrease)
+                lValue++;
+            else if (lCommand->mEncoding == CommandPlanner::kEncodingDecrease)
+                lValue--;
+            else
+                lValue = lCommand->mValue;
+
+            if (lValue != lCommand->mValue)
+            {
+                fprintf(stderr, "Zone %u property %d stepped to %d rather than %d\n", lZones[lZone], lCommand->mProperty, lValue, lCommand->mValue);
+                lRetval = false;
+            }
+        }
+    }
+
+    for (lChange = aChanges.begin(); lRetval && (lChange != aChanges.end()); lChange++)
+    {
+        if (aStates[lChange->mZone][lChange->mProperty] != lChange->mTarget)
+        {
+            fprintf(stderr, "Zone %u property %d ended at %d rather than %d\n", lChange->mZone, lChange->mProperty, aStates[lChange->mZone][lChange->mProperty], lChange->mTarget);
+            lRetval = false;
+        }
+    }
+
+    if (lRetval && (lCost != aCost))
+    {
+        fprintf(stderr, "Plan cost %zu rather than the %zu planned\n", lCost, aCost);
+        lRetval = false;
+    }
+
+    return (lRetval);
+}
+
+void
+Print(const CommandPlanner::Commands &aCommands)
+{
+    static const char * const  sProperties[] = { "volume", "mute", "source", "bass", "treble" };
+    static const char * const  sEncodings[]  = { "set", "increase", "decrease" };
+    CommandPlanner::Commands::const_iterator  lCommand;
+
+    for (lCommand = aCommands.begin(); lCommand != aCommands.end(); lCommand++)
+    {
+        printf("  %s %u %s %s to %d (%zu bytes)\n",
+               ((lCommand->mKind == CommandPlanner::kKindGroup) ? "group" : "zone"),
+               lCommand->mIdentifier,
+               sProperties[lCommand->mProperty],
+               sEncodings[lCommand->mEncoding],
+               lCommand->mValue,
+               lCommand->mCost);
+    }
+}
+
+}; // namespace
+
+int
+main(int argc, char * const argv[])
+{
+    CommandPlanner::CostModel  lCostModel;
+    CommandPlanner             lPlanner;
+    std::mt19937               lGenerator;
+    CommandPlanner::Groups     lGroups;
+    CommandPlanner::Changes    lChanges;
+    CommandPlanner::Commands   lCommands;
+    ZoneStates                 lStates;
+    unsigned long long         lAbsoluteBytes = 0;
+    unsigned long long         lPlannedBytes = 0;
+    unsigned long long         lPlannedCommands = 0;
+    Duration                   lPlanning(0);
+    int                        lRetval = EXIT_FAILURE;
+
+    if (ParseOptions(argc, argv))
+    {
+        lGenerator.seed(static_cast<std::mt19937::result_type>(sOptions.mSeed));
+
+        lCostModel.Init(CommandPlanner::CostModel::kResponseTerminatorLengthDefault, sOptions.mGroupEchoesZones);
+        lPlanner.Init(lCostModel);
+
+        lRetval = EXIT_SUCCESS;
+
+        for (unsigned long lIteration = 0; (lRetval == EXIT_SUCCESS) && (lIteration < sOptions.mIterations); lIteration++)
+        {
+            Clock::time_point  lStart;
+            size_t             lCost;
+
+            GenerateGroups(lGenerator, lGroups);
+            GenerateChanges(lGenerator, lGroups, lStates, lChanges);
+
+            lStart = Clock::now();
+
+            lCost = lPlanner.Plan(lChanges, lGroups, lCommands);
+
+            lPlanning += std::chrono::duration_cast<Duration>(Clock::now() - lStart);
+
+            lAbsoluteBytes   += lPlanner.GetAbsoluteCost(lChanges);
+            lPlannedBytes    += lCost;
+            lPlannedCommands += lCommands.size();
+
+            if (sOptions.mVerbose)
+            {
+                printf("Iteration %lu: %zu bytes\n", lIteration, lCost);
+                Print(lCommands);
+            }
+
+            if (!Check(lPlanner, lGroups, lChanges, lCommands, lCost, lStates))
+            {
+                fprintf(stderr, "Iteration %lu failed its check\n", lIteration);
+                lRetval = EXIT_FAILURE;
+            }
+        }
+
+        if (lRetval == EXIT_SUCCESS)
+        {
+            const double lIterations = static_cast<double>(sOptions.mIterations);
+
+            printf("%lu iterations of %lu zones and %lu groups:\n", sOptions.mIterations, sOptions.mZones, sOptions.mGroups);
+            printf("  absolute: %10.1f bytes, %8.1f ms per change\n",
+                   lAbsoluteBytes / lIterations,
+                   (lAbsoluteBytes * sOptions.mCharacterDelayMs) / lIterations);
+            printf("  planned:  %10.1f bytes, %8.1f ms per change, %.1f commands\n",
+                   lPlannedBytes / lIterations,
+                   (lPlannedBytes * sOptions.mCharacterDelayMs) / lIterations,
+                   lPlannedCommands / lIterations);
+            printf("  saving:   %10.1f%%\n",
+                   ((lAbsoluteBytes > 0) ? (100.0 * (lAbsoluteBytes - lPlannedBytes) / lAbsoluteBytes) : 0.0));
+            printf("  planning: %10.1f us per change\n",
+                   (std::chrono::duration<double, std::micro>(lPlanning).count() / lIterations));
+        }
+    }
+
+    return (lRetval);
+}
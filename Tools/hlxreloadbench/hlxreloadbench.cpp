@@ -0,0 +1,637 @@
+/*
+ *    Copyright (c) 2026 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *  @file
+ *    This file implements a benchmark for the table view row reload
+ *    coalescer.
+ *
+ *    The benchmark replays streams of HLX client controller state
+ *    change notifications, each divided into the run loop turns they
+ *    arrived in, through the row reload coalescer, taking the dirty
+ *    rows at the end of each turn as the group and zone list view
+ *    does. It reports, for each stream, the notifications against the
+ *    reloads and rows those call for with and without coalescing,
+ *    along with how long coalescing takes.
+ *
+ *    A stream may be read from a file recorded from a session, in
+ *    which each line names a notification by the kind of entity it
+ *    is for, 'g' for a group, 's' for a source, or 'z' for a zone,
+ *    followed by its identifier, or by '*' for one that affects every
+ *    row; a line of '-' ends a run loop turn; and a line starting with
+ *    '#' is a comment. For example:
+ *
+ *      # A group volume change to a group of two zones.
+ *      g 1
+ *      z 3
+ *      z 4
+ *      -
+ *
+ *    Otherwise, it replays streams typical of a refresh, of dragging
+ *    a group volume slider, and of dragging a zone volume slider.
+ *
+ *    Each batch taken is also checked: it must hold each row marked
+ *    during its turn exactly once, in order. The benchmark exits with
+ *    failure on any violation.
+ *
+ *    The benchmark depends only on POSIX and the C++ Standard Library
+ *    and may be built, from the top of the package, on Linux or macOS
+ *    with:
+ *
+ *      % c++ -std=c++11 -O2 -I Source -o hlxreloadbench Tools/hlxreloadbench/hlxreloadbench.cpp Source/RowReloadCoalescer.cpp
+ *
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "RowReloadCoalescer.hpp"
+
+
+namespace
+{
+
+typedef std::chrono::steady_clock  Clock;
+typedef std::chrono::nanoseconds   Duration;
+
+/**
+ *  A recorded notification: the kind and identifier of the entity it
+ *  is for or, where it affects every row, kKindMax.
+ *
+ */
+struct Notification
+{
+    RowReloadCoalescer::Kind            mKind;
+    RowReloadCoalescer::IdentifierType  mIdentifier;
+};
+
+/**
+ *  The notifications that arrived in one run loop turn.
+ *
+ */
+typedef std::vector<Notification>  Turn;
+
+/**
+ *  A named stream of run loop turns.
+ *
+ */
+struct Stream
+{
+    std::string        mName;
+    std::vector<Turn>  mTurns;
+};
+
+/**
+ *  The benchmark configuration, as established from the command
+ *  line.
+ *
+ */
+struct Options
+{
+    const char *   mFile;
+    unsigned long  mIterations;
+    unsigned long  mZones;
+    unsigned long  mGroupZones;
+    unsigned long  mPerTurn;
+    unsigned long  mSteps;
+};
+
+const unsigned long  kDefaultIterations = 1000;
+const unsigned long  kDefaultZones      = 24;
+const unsigned long  kDefaultGroupZones = 8;
+const unsigned long  kDefaultSteps      = 100;
+
+// A refresh reports about this many properties in each read of the
+// peer connection, each of which is parsed in a single run loop turn.
+
+const unsigned long  kDefaultPerTurn    = 32;
+
+// The group, zone, and source properties a refresh reports for each:
+// name, source, volume, and mute for groups and zones and name for
+// sources.
+
+const unsigned long  kPropertiesPerZone   = 4;
+const unsigned long  kPropertiesPerGroup  = 4;
+const unsigned long  kGroups              = 10;
+const unsigned long  kSources             = 8;
+
+Options              sOptions;
+
+// MARK: Option Parsing
+
+void
+Usage(const char *aProgram, FILE *aStream)
+{
+    fprintf(aStream,
+            "Usage: %s [ options ]\n"
+            "\n"
+            "Benchmark and check the table view row reload coalescer against\n"
+            "recorded or typical streams of state change notifications.\n"
+            "\n"
+            " -f, --file <path>           Replay the recorded stream in <path> rather\n"
+            "                             than the typical streams.\n"
+            " -g, --group-zones <count>   Number of zones in the group whose volume\n"
+            "                             slider is dragged (default: %lu).\n"
+            " -h, --help                  Print this help and exit.\n"
+            " -i, --iterations <count>    Number of times each stream is replayed to\n"
+            "                             time it (default: %lu).\n"
+            " -p, --per-turn <count>      Number of refresh notifications in each run\n"
+            "                             loop turn (default: %lu).\n"
+            " -s, --steps <count>         Number of slider steps dragged (default: %lu).\n"
+            " -z, --zones <count>         Number of zones (default: %lu).\n",
+            aProgram,
+            kDefaultGroupZones,
+            kDefaultIterations,
+            kDefaultPerTurn,
+            kDefaultSteps,
+            kDefaultZones);
+}
+
+bool
+ParseCount(const char *aString, const unsigned long &aMinimum, const unsigned long &aMaximum, unsigned long &aCount)
+{
+    char *  lEnd;
+    bool    lRetval;
+
+    aCount = strtoul(aString, &lEnd, 10);
+
+    lRetval = ((*aString != '\0') && (*lEnd == '\0') && (aCount >= aMinimum) && (aCount <= aMaximum));
+
+    return (lRetval);
+}
+
+bool
+ParseOptions(int argc, char * const argv[])
+{
+    static const struct option sLongOptions[] =
+    {
+        { "file",        required_argument, nullptr, 'f' },
+        { "group-zones", required_argument, nullptr, 'g' },
+        { "help",        no_argument,       nullptr, 'h' },
+        { "iterations",  required_argument, nullptr, 'i' },
+        { "per-turn",    required_argument, nullptr, 'p' },
+        { "steps",       required_argument, nullptr, 's' },
+        { "zones",       required_argument, nullptr, 'z' },
+        { nullptr,       0,                 nullptr, 0   }
+    };
+    int   lOption;
+    bool  lRetval = true;
+
+    sOptions.mFile       = nullptr;
+    sOptions.mIterations = kDefaultIterations;
+    sOptions.mZones      = kDefaultZones;
+    sOptions.mGroupZones = kDefaultGroupZones;
+    sOptions.mPerTurn    = kDefaultPerTurn;
+    sOptions.mSteps      = kDefaultSteps;
+
+    while (lRetval && ((lOption = getopt_long(argc, argv, "f:g:hi:p:s:z:", sLongOptions, nullptr)) != -1))
+    {
+        switch (lOption)
+        {
+
+        case 'f':
+            sOptions.mFile = optarg;
+            break;
+
+        case 'g':
+            lRetval = ParseCount(optarg, 1, 255, sOptions.mGroupZones);
+            break;
+
+        case 'h':
+            Usage(argv[0], stdout);
+            exit(EXIT_SUCCESS);
+            break;
+
+        case 'i':
+            lRetval = ParseCount(optarg, 1, 100000000, sOptions.mIterations);
+            break;
+
+        case 'p':
+            lRetval = ParseCount(optarg, 1, 100000, sOptions.mPerTurn);
+            break;
+
+        case 's':
+            lRetval = ParseCount(optarg, 1, 100000, sOptions.mSteps);
+            break;
+
+        case 'z':
+            lRetval = ParseCount(optarg, 1, 255, sOptions.mZones);
+            break;
+
+        default:
+            lRetval = false;
+            break;
+
+        }
+    }
+
+    lRetval = (lRetval && (optind == argc) && (sOptions.mGroupZones <= sOptions.mZones));
+
+    if (!lRetval)
+    {
+        Usage(argv[0], stderr);
+    }
+
+    return (lRetval);
+}
+
+// MARK: Streams
+
+bool
+ReadStream(const char *aPath, Stream &aStream)
+{
+    FILE *         lFile;
+    char           lLine[128];
+    unsigned long  lLineNumber = 0;
+    Turn           lTurn;
+    bool           lRetval = true;
+
+    lFile = fopen(aPath, "r");
+
+    if (lFile == nullptr)
+    {
+        fprintf(stderr, "Could not open \"%s\".\n", aPath);
+        return (false);
+    }
+
+    aStream.mName = aPath;
+    aStream.mTurns.clear();
+
+    while (lRetval && (fgets(lLine, sizeof (lLine), lFile) != nullptr))
+    {
+        char           lKind;
+        unsigned long  lIdentifier;
+        Notification   lNotification;
+
+        lLineNumber++;
+
+        lLine[strcspn(lLine, "\r\n")] = '\0';
+
+        if ((lLine[0] == '\0') || (lLine[0] == '#'))
+        {
+            continue;
+        }
+        else if (strcmp(lLine, "-") == 0)
+        {
+            if (!lTurn.empty())
+            {
+                aStream.mTurns.push_back(lTurn);
+                lTurn.clear();
+            }
+        }
+        else if (strcmp(lLine, "*") == 0)
+        {
+            lNotification.mKind       = RowReloadCoalescer::kKindMax;
+            lNotification.mIdentifier = 0;
+
+            lTurn.push_back(lNotification);
+        }
+        else if ((sscanf(lLine, "%c %lu", &lKind, &lIdentifier) == 2) &&
+                 (strchr("gsz", lKind) != nullptr) &&
+                 (lIdentifier <= 255))
+        {
+            lNotification.mKind       = ((lKind == 'g') ? RowReloadCoalescer::kKindGroup  :
+                                         (lKind == 's') ? RowReloadCoalescer::kKindSource :
+                                                          RowReloadCoalescer::kKindZone);
+            lNotification.mIdentifier = static_cast<RowReloadCoalescer::IdentifierType>(lIdentifier);
+
+            lTurn.push_back(lNotification);
+        }
+        else
+        {
+            fprintf(stderr, "%s:%lu: Could not parse \"%s\".\n", aPath, lLineNumber, lLine);
+            lRetval = false;
+        }
+    }
+
+    if (!lTurn.empty())
+    {
+        aStream.mTurns.push_back(lTurn);
+    }
+
+    fclose(lFile);
+
+    return (lRetval);
+}
+
+/**
+ *  Generate a refresh: each property of each group, source, and zone,
+ *  in the order the client controller queries them, arriving the
+ *  configured number to a run loop turn.
+ *
+ */
+void
+GenerateRefresh(Stream &aStream)
+{
+    Turn lAll;
+
+    for (unsigned long lGroup = 1; lGroup <= kGroups; lGroup++)
+    {
+        for (unsigned long lProperty = 0; lProperty < kPropertiesPerGroup; lProperty++)
+        {
+            lAll.push_back({ RowReloadCoalescer::kKindGroup, static_cast<RowReloadCoalescer::IdentifierType>(lGroup) });
+        }
+    }
+
+    for (unsigned long lSource = 1; lSource <= kSources; lSource++)
+    {
+        lAll.push_back({ RowReloadCoalescer::kKindMax, 0 });
+    }
+
+    for (unsigned long lZone = 1; lZone <= sOptions.mZones; lZone++)
+    {
+        for (unsigned long lProperty = 0; lProperty < kPropertiesPerZone; lProperty++)
+        {
+            lAll.push_back({ RowReloadCoalescer::kKindZone, static_cast<RowReloadCoalescer::IdentifierType>(lZone) });
+        }
+    }
+
+    aStream.mName = "refresh";
+    aStream.mTurns.clear();
+
+    for (size_t lFirst = 0; lFirst < lAll.size(); lFirst += sOptions.mPerTurn)
+    {
+        const size_t lLast = std::min(lAll.size(), lFirst + sOptions.mPerTurn);
+
+        aStream.mTurns.push_back(Turn(lAll.begin() + lFirst, lAll.begin() + lLast));
+    }
+}
+
+/**
+ *  Generate a group volume slider drag: each step reports the group
+ *  volume and that of each zone in the group in a single run loop
+ *  turn.
+ *
+ */
+void
+GenerateGroupSlider(Stream &aStream)
+{
+    aStream.mName = "group-slider";
+    aStream.mTurns.clear();
+
+    for (unsigned long lStep = 0; lStep < sOptions.mSteps; lStep++)
+    {
+        Turn lTurn;
+
+        lTurn.push_back({ RowReloadCoalescer::kKindGroup, 1 });
+
+        for (unsigned long lZone = 1; lZone <= sOptions.mGroupZones; lZone++)
+        {
+            lTurn.push_back({ RowReloadCoalescer::kKindZone, static_cast<RowReloadCoalescer::IdentifierType>(lZone) });
+        }
+
+        aStream.mTurns.push_back(lTurn);
+    }
+}
+
+/**
+ *  Generate a zone volume slider drag: each step reports only the
+ *  zone volume, in its own run loop turn, such that there is nothing
+ *  to coalesce.
+ *
+ */
+void
+GenerateZoneSlider(Stream &aStream)
+{
+    aStream.mName = "zone-slider";
+    aStream.mTurns.clear();
+
+    for (unsigned long lStep = 0; lStep < sOptions.mSteps; lStep++)
+    {
+        aStream.mTurns.push_back(Turn(1, { RowReloadCoalescer::kKindZone, 1 }));
+    }
+}
+
+// MARK: Replay
+
+/**
+ *  Replay a turn of notifications through the coalescer, as the
+ *  group and zone list view does, returning whether a reload was
+ *  scheduled.
+ *
+ */
+bool
+Replay(RowReloadCoalescer &aCoalescer, const Turn &aTurn)
+{
+    bool lScheduled = false;
+
+    for (const Notification &lNotification : aTurn)
+    {
+        const bool lFirst = ((lNotification.mKind == RowReloadCoalescer::kKindMax) ?
+                             aCoalescer.MarkAll() :
+                             aCoalescer.Mark(lNotification.mKind, lNotification.mIdentifier));
+
+        lScheduled = (lScheduled || lFirst);
+    }
+
+    return (lScheduled);
+}
+
+/**
+ *  Check that a batch holds each row marked during a turn exactly
+ *  once, in order.
+ *
+ */
+bool
+Check(const Turn &aTurn, const RowReloadCoalescer::Batch &aBatch)
+{
+    std::set<RowReloadCoalescer::IdentifierType>  lExpected[RowReloadCoalescer::kKindMax];
+    bool                                          lAll = false;
+    bool                                          lRetval;
+
+    for (const Notification &lNotification : aTurn)
+    {
+        if (lNotification.mKind == RowReloadCoalescer::kKindMax)
+        {
+            lAll = true;
+        }
+        else
+        {
+            lExpected[lNotification.mKind].insert(lNotification.mIdentifier);
+        }
+    }
+
+    lRetval = (aBatch.mAll == lAll);
+
+    for (size_t lKind = 0; lRetval && (lKind < RowReloadCoalescer::kKindMax); lKind++)
+    {
+        const RowReloadCoalescer::Identifiers &lIdentifiers = aBatch.mIdentifiers[lKind];
+
+        if (lAll)
+        {
+            lRetval = lIdentifiers.empty();
+        }
+        else
+        {
+            lRetval = ((lIdentifiers.size() == lExpected[lKind].size()) &&
+                       std::equal(lIdentifiers.begin(), lIdentifiers.end(), lExpected[lKind].begin()));
+        }
+    }
+
+    return (lRetval);
+}
+
+bool
+Run(const Stream &aStream)
+{
+    RowReloadCoalescer           lCoalescer;
+    RowReloadCoalescer::Batch    lBatch;
+    unsigned long long           lNotifications = 0;
+    unsigned long long           lRows = 0;
+    unsigned long long           lAllRows = 0;
+    Duration                     lElapsed;
+    Clock::time_point            lStart;
+    bool                         lRetval = true;
+
+    // Check and count one replay of the stream.
+
+    for (size_t lTurn = 0; lRetval && (lTurn < aStream.mTurns.size()); lTurn++)
+    {
+        lNotifications += aStream.mTurns[lTurn].size();
+
+        if (Replay(lCoalescer, aStream.mTurns[lTurn]))
+        {
+            lCoalescer.Take(lBatch);
+
+            lRetval = Check(aStream.mTurns[lTurn], lBatch);
+
+            if (!lRetval)
+            {
+                fprintf(stderr, "%s: turn %zu: batch does not match the rows marked.\n", aStream.mName.c_str(), lTurn);
+            }
+        }
+    }
+
+    if (lRetval)
+    {
+        const RowReloadCoalescer::Counters &lCounters = lCoalescer.GetCounters();
+
+        lRetval = (lCounters.mNotifications == lNotifications);
+
+        if (!lRetval)
+        {
+            fprintf(stderr, "%s: counted %llu notifications of %llu.\n",
+                    aStream.mName.c_str(),
+                    static_cast<unsigned long long>(lCounters.mNotifications),
+                    lNotifications);
+        }
+
+        lRows    = lCounters.mRows;
+        lAllRows = lCounters.mAllRows;
+    }
+
+    // Time the configured number of replays.
+
+    if (lRetval)
+    {
+        const RowReloadCoalescer::Counters lCounters = lCoalescer.GetCounters();
+
+        lStart = Clock::now();
+
+        for (unsigned long lIteration = 0; lIteration < sOptions.mIterations; lIteration++)
+        {
+            for (const Turn &lTurn : aStream.mTurns)
+            {
+                if (Replay(lCoalescer, lTurn))
+                {
+                    lCoalescer.Take(lBatch);
+                }
+            }
+        }
+
+        lElapsed = std::chrono::duration_cast<Duration>(Clock::now() - lStart);
+
+        printf("%-14s %8llu %8llu %8llu %8llu %7llu %8.1fx %9.1f\n",
+               aStream.mName.c_str(),
+               lNotifications,
+               static_cast<unsigned long long>(aStream.mTurns.size()),
+               lNotifications,
+               static_cast<unsigned long long>(lCounters.mReloads),
+               lRows,
+               (lCounters.mReloads > 0) ? (static_cast<double>(lNotifications) / static_cast<double>(lCounters.mReloads)) : 0.0,
+               static_cast<double>(lElapsed.count()) / static_cast<double>(lNotifications * sOptions.mIterations));
+
+        if (lAllRows > 0)
+        {
+            printf("%-14s %llu reload(s) of all rows\n", "", lAllRows);
+        }
+    }
+
+    return (lRetval);
+}
+
+}; // namespace
+
+int
+main(int argc, char * const argv[])
+{
+    std::vector<Stream>  lStreams;
+    Stream               lStream;
+    int                  lRetval = EXIT_FAILURE;
+
+    if (ParseOptions(argc, argv))
+    {
+        if (sOptions.mFile != nullptr)
+        {
+            if (!ReadStream(sOptions.mFile, lStream))
+            {
+                goto done;
+            }
+
+            lStreams.push_back(lStream);
+        }
+        else
+        {
+            GenerateRefresh(lStream);
+            lStreams.push_back(lStream);
+
+            GenerateGroupSlider(lStream);
+            lStreams.push_back(lStream);
+
+            GenerateZoneSlider(lStream);
+            lStreams.push_back(lStream);
+        }
+
+        printf("%-14s %8s %8s %8s %8s %7s %9s %9s\n",
+               "", "notes", "turns", "reloads", "reloads", "rows", "", "ns/note");
+        printf("%-14s %8s %8s %8s %8s %7s %9s %9s\n",
+               "stream", "", "", "(each)", "(coal.)", "(coal.)", "saving", "(coal.)");
+
+        lRetval = EXIT_SUCCESS;
+
+        for (const Stream &lCurrent : lStreams)
+        {
+            if (!Run(lCurrent))
+            {
+                lRetval = EXIT_FAILURE;
+            }
+        }
+    }
+
+ done:
+    return (lRetval);
+}
@@ -0,0 +1,601 @@
+/*
+ *    Copyright (c) 2026 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+/**
+ *  @file
+ *    This file implements a tool for replaying, off of the target and
+ *    without hardware, a log of recorded HLX client controller
+ *    sessions.
+ *
+ *    Sessions are recorded on the target, when enabled in Settings,
+ *    to "Sessions.hlxlog" in the app documents, from where they may
+ *    be retrieved from the device.
+ *
+ *    The tool either dumps each event of the log or replays the log
+ *    into a model of the group and zone list view: its row reload
+ *    coalescer and source row index, driven exactly as the view
+ *    drives them. State changes recorded within a short window of
+ *    one another are taken to have arrived within the same run loop
+ *    turn, at the end of which the dirty rows are taken for reload.
+ *    It reports the reloads and rows the recorded traffic called for,
+ *    with and without coalescing, and the time to replay each event,
+ *    both decoding it alone and decoding it into the model.
+ *
+ *    The tool depends only on POSIX and the C++ Standard Library and
+ *    may be built, from the top of the package, on Linux or macOS
+ *    with:
+ *
+ *      % c++ -std=c++11 -O2 -I Source -o hlxreplay Tools/hlxreplay/hlxreplay.cpp Source/SessionLog.cpp Source/SessionReplayer.cpp Source/RowReloadCoalescer.cpp Source/SourceRowIndex.cpp
+ *
+ */
+
+#include <chrono>
+
+#include <errno.h>
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "RowReloadCoalescer.hpp"
+#include "SessionLog.hpp"
+#include "SessionReplayer.hpp"
+#include "SourceRowIndex.hpp"
+
+
+namespace
+{
+
+typedef std::chrono::steady_clock  Clock;
+typedef std::chrono::nanoseconds   Duration;
+
+/**
+ *  The tool configuration, as established from the command line.
+ *
+ */
+struct Options
+{
+    const char *   mPath;
+    bool           mDump;
+    bool           mGroups;
+    bool           mRecorded;
+    double         mSpeed;
+    unsigned long  mIterations;
+    unsigned long  mWindowUs;
+};
+
+const unsigned long  kDefaultIterations = 100;
+
+// Each read from the peer connection is parsed, and its state changes
+// delivered, within a single run loop turn, in far less time than
+// this.
+
+const unsigned long  kDefaultWindowUs   = 1000;
+
+Options              sOptions;
+
+/**
+ *  @brief
+ *    A replay delegate that models the group and zone list view.
+ *
+ *  State changes mark rows dirty, and maintain the source row index,
+ *  as the view does; the end of each run loop turn takes the dirty
+ *  rows, as the view's reload does. Alongside, it counts the reloads
+ *  the view would issue, were it to reload a row for each state
+ *  change and every row for each source rename.
+ *
+ */
+class ListModel :
+    public SessionReplayer::Delegate
+{
+public:
+    struct Counters
+    {
+        uint64_t  mStateChanges;
+        uint64_t  mTurns;
+        uint64_t  mUncoalescedReloads;
+        uint64_t  mUncoalescedAllRows;
+        uint64_t  mRefreshes;
+    };
+
+public:
+    ListModel(const bool &aGroups, const SessionLog::Duration &aWindow) :
+        mGroups(aGroups),
+        mWindow(aWindow),
+        mLast(0),
+        mInTurn(false),
+        mCoalescer(),
+        mIndex(),
+        mBatch(),
+        mCounters()
+    {
+        memset(&mCounters, 0, sizeof (mCounters));
+    }
+
+    void Finish(void)
+    {
+        EndTurn();
+    }
+
+    const Counters &GetCounters(void) const
+    {
+        return (mCounters);
+    }
+
+    const RowReloadCoalescer::Counters &GetCoalescerCounters(void) const
+    {
+        return (mCoalescer.GetCounters());
+    }
+
+    void SessionDidStart(void) final
+    {
+        EndTurn();
+
+        mIndex.Clear();
+
+        mLast = SessionLog::Duration(0);
+    }
+
+    void ControllerDidRefresh(void) final
+    {
+        // The view reloads every row and reindexes every source once
+        // a refresh completes; any rows still dirty are moot.
+
+        EndTurn();
+
+        mCoalescer.Clear();
+
+        mCounters.mRefreshes++;
+    }
+
+    void ControllerStateDidChange(const SessionLog::Event &aEvent) final
+    {
+        const RowReloadCoalescer::Kind  lKind = (mGroups ? RowReloadCoalescer::kKindGroup : RowReloadCoalescer::kKindZone);
+        const SessionLog::ValueType     lIdentifier = (aEvent.mValues.empty() ? 0 : aEvent.mValues[0]);
+        bool                            lRow = false;
+
+        if ((aEvent.mTime - mLast) > mWindow)
+        {
+            EndTurn();
+        }
+
+        mLast = aEvent.mTime;
+        mInTurn = true;
+
+        mCounters.mStateChanges++;
+
+        switch (aEvent.mStateChange)
+        {
+
+        case SessionLog::kStateChangeGroupSource:
+            // A group with more than one source renders none.
+
+            mIndex.SetSource(SourceRowIndex::kKindGroup,
+                             static_cast<SourceRowIndex::IdentifierType>(lIdentifier),
+                             static_cast<SourceRowIndex::IdentifierType>((aEvent.mValues.size() == 2) ? aEvent.mValues[1] : SourceRowIndex::kSourceNone));
+
+            // Fall through
+
+        case SessionLog::kStateChangeGroupMute:
+        case SessionLog::kStateChangeGroupName:
+        case SessionLog::kStateChangeGroupVolume:
+            lRow = mGroups;
+            break;
+
+        case SessionLog::kStateChangeSourceName:
+            {
+                const SourceRowIndex::Identifiers &lRows = mIndex.GetRows((mGroups ? SourceRowIndex::kKindGroup : SourceRowIndex::kKindZone),
+                                                                          static_cast<SourceRowIndex::IdentifierType>(lIdentifier));
+
+                for (const SourceRowIndex::IdentifierType &lRowIdentifier : lRows)
+                {
+                    mCoalescer.Mark(lKind, lRowIdentifier);
+                }
+
+                mCounters.mUncoalescedAllRows++;
+            }
+            break;
+
+        case SessionLog::kStateChangeZoneSource:
+            mIndex.SetSource(SourceRowIndex::kKindZone,
+                             static_cast<SourceRowIndex::IdentifierType>(lIdentifier),
+                             static_cast<SourceRowIndex::IdentifierType>((aEvent.mValues.size() == 2) ? aEvent.mValues[1] : SourceRowIndex::kSourceNone));
+
+            // Fall through
+
+        case SessionLog::kStateChangeZoneMute:
+        case SessionLog::kStateChangeZoneName:
+        case SessionLog::kStateChangeZoneVolume:
+            lRow = !mGroups;
+            break;
+
+        default:
+            break;
+
+        }
+
+        if (lRow)
+        {
+            mCoalescer.Mark(lKind, static_cast<RowReloadCoalescer::IdentifierType>(lIdentifier));
+
+            mCounters.mUncoalescedReloads++;
+        }
+    }
+
+private:
+    void EndTurn(void)
+    {
+        if (!mInTurn)
+        {
+            return;
+        }
+
+        if (mCoalescer.IsPending())
+        {
+            mCoalescer.Take(mBatch);
+        }
+
+        mInTurn = false;
+
+        mCounters.mTurns++;
+    }
+
+private:
+    const bool                 mGroups;
+    const SessionLog::Duration mWindow;
+    SessionLog::Duration       mLast;
+    bool                       mInTurn;
+    RowReloadCoalescer         mCoalescer;
+    SourceRowIndex             mIndex;
+    RowReloadCoalescer::Batch  mBatch;
+    Counters                   mCounters;
+};
+
+// MARK: Option Parsing
+
+void
+Usage(const char *aProgram, FILE *aStream)
+{
+    fprintf(aStream,
+            "Usage: %s [ options ] <log>\n"
+            "\n"
+            "Replay a log of recorded HLX client controller sessions into a model\n"
+            "of the group and zone list view, or dump it.\n"
+            "\n"
+            " -d, --dump                  Print each event rather than replaying.\n"
+            " -g, --groups                Model the list showing groups rather than\n"
+            "                             zones.\n"
+            " -h, --help                  Print this help and exit.\n"
+            " -i, --iterations <count>    Number of times the log is replayed to time\n"
+            "                             it (default: %lu).\n"
+            " -r, --recorded              Replay once, at the pace recorded, rather\n"
+            "                             than as fast as possible.\n"
+            " -s, --speed <factor>        Factor by which to speed up a replay at the\n"
+            "                             pace recorded (default: 1).\n"
+            " -w, --window <us>           Time, in microseconds, within which state\n"
+            "                             changes are taken to arrive in the same run\n"
+            "                             loop turn (default: %lu).\n",
+            aProgram,
+            kDefaultIterations,
+            kDefaultWindowUs);
+}
+
+bool
+ParseCount(const char *aString, const unsigned long &aMinimum, const unsigned long &aMaximum, unsigned long &aCount)
+{
+    char *  lEnd;
+    bool    lRetval;
+
+    aCount = strtoul(aString, &lEnd, 10);
+
+    lRetval = ((*aString != '\0') && (*lEnd == '\0') && (aCount >= aMinimum) && (aCount <= aMaximum));
+
+    return (lRetval);
+}
+
+bool
+ParseFactor(const char *aString, double &aFactor)
+{
+    char *  lEnd;
+    bool    lRetval;
+
+    aFactor = strtod(aString, &lEnd);
+
+    lRetval = ((*aString != '\0') && (*lEnd == '\0') && (aFactor > 0.0));
+
+    return (lRetval);
+}
+
+bool
+ParseOptions(int argc, char * const argv[])
+{
+    static const struct option sLongOptions[] =
+    {
+        { "dump",       no_argument,       nullptr, 'd' },
+        { "groups",     no_argument,       nullptr, 'g' },
+        { "help",       no_argument,       nullptr, 'h' },
+        { "iterations", required_argument, nullptr, 'i' },
+        { "recorded",   no_argument,       nullptr, 'r' },
+        { "speed",      required_argument, nullptr, 's' },
+        { "window",     required_argument, nullptr, 'w' },
+        { nullptr,      0,                 nullptr, 0   }
+    };
+    int   lOption;
+    bool  lRetval = true;
+
+    sOptions.mPath       = nullptr;
+    sOptions.mDump       = false;
+    sOptions.mGroups     = false;
+    sOptions.mRecorded   = false;
+    sOptions.mSpeed      = 1.0;
+    sOptions.mIterations = kDefaultIterations;
+    sOptions.mWindowUs   = kDefaultWindowUs;
+
+    while (lRetval && ((lOption = getopt_long(argc, argv, "dghi:rs:w:", sLongOptions, nullptr)) != -1))
+    {
+        switch (lOption)
+        {
+
+        case 'd':
+            sOptions.mDump = true;
+            break;
+
+        case 'g':
+            sOptions.mGroups = true;
+            break;
+
+        case 'h':
+            Usage(argv[0], stdout);
+            exit(EXIT_SUCCESS);
+            break;
+
+        case 'i':
+            lRetval = ParseCount(optarg, 1, 1000000, sOptions.mIterations);
+            break;
+
+        case 'r':
+            sOptions.mRecorded = true;
+            break;
+
+        case 's':
+            lRetval = ParseFactor(optarg, sOptions.mSpeed);
+            break;
+
+        case 'w':
+            lRetval = ParseCount(optarg, 0, 60000000, sOptions.mWindowUs);
+            break;
+
+        default:
+            lRetval = false;
+            break;
+
+        }
+    }
+
+    lRetval = (lRetval && (optind == (argc - 1)));
+
+    if (lRetval)
+    {
+        sOptions.mPath = argv[optind];
+    }
+    else
+    {
+        Usage(argv[0], stderr);
+    }
+
+    return (lRetval);
+}
+
+// MARK: Dump
+
+/**
+ *  Print the specified event on a line of its own.
+ *
+ */
+void
+Print(const SessionLog::Event &aEvent)
+{
+    printf("%10.6f %-16s",
+           static_cast<double>(aEvent.mTime.count()) / 1e6,
+           SessionLog::GetTypeName(aEvent.mType));
+
+    if (aEvent.mType == SessionLog::kTypeStateDidChange)
+    {
+        printf(" %-21s", SessionLog::GetStateChangeName(aEvent.mStateChange));
+    }
+
+    for (const SessionLog::ValueType &lValue : aEvent.mValues)
+    {
+        printf(" %d", lValue);
+    }
+
+    for (const std::string &lString : aEvent.mStrings)
+    {
+        printf(" \"%s\"", lString.c_str());
+    }
+
+    printf("\n");
+}
+
+// MARK: Replay
+
+/**
+ *  Replay the log once into the specified delegate.
+ *
+ */
+int
+Replay(const SessionReplayer::Pace &aPace, SessionReplayer::Delegate &aDelegate, SessionReplayer::Counters &aCounters)
+{
+    SessionLog::Reader  lReader;
+    SessionReplayer     lReplayer;
+    int                 lRetval;
+
+    lRetval = lReader.Open(sOptions.mPath);
+
+    if (lRetval != 0)
+    {
+        fprintf(stderr, "Could not open \"%s\": %s.\n", sOptions.mPath, strerror(-lRetval));
+        goto done;
+    }
+
+    lRetval = lReplayer.Init(aPace, sOptions.mSpeed);
+
+    if (lRetval != 0)
+    {
+        goto done;
+    }
+
+    lRetval = lReplayer.Replay(lReader, aDelegate);
+
+    if (lRetval != 0)
+    {
+        fprintf(stderr, "Could not replay \"%s\": %s.\n", sOptions.mPath, strerror(-lRetval));
+        goto done;
+    }
+
+    aCounters = lReplayer.GetCounters();
+
+ done:
+    return (lRetval);
+}
+
+/**
+ *  Replay the log, as fast as possible, the configured number of
+ *  times into new instances of the delegate type, returning the time
+ *  taken per event.
+ *
+ */
+template <typename T, typename... Arguments>
+bool
+Time(double &aNsPerEvent, Arguments... aArguments)
+{
+    SessionReplayer::Counters  lCounters;
+    Clock::time_point          lStart;
+    Duration                   lElapsed;
+    bool                       lRetval = true;
+
+    lStart = Clock::now();
+
+    for (unsigned long lIteration = 0; lRetval && (lIteration < sOptions.mIterations); lIteration++)
+    {
+        T lDelegate(aArguments...);
+
+        lRetval = (Replay(SessionReplayer::kPaceFastest, lDelegate, lCounters) == 0);
+    }
+
+    lElapsed = std::chrono::duration_cast<Duration>(Clock::now() - lStart);
+
+    aNsPerEvent = ((lCounters.mEvents > 0) ?
+                   (static_cast<double>(lElapsed.count()) / static_cast<double>(lCounters.mEvents * sOptions.mIterations)) :
+                   0.0);
+
+    return (lRetval);
+}
+
+}; // namespace
+
+int
+main(int argc, char * const argv[])
+{
+    SessionReplayer::Counters  lCounters;
+    int                        lRetval = EXIT_FAILURE;
+
+    if (!ParseOptions(argc, argv))
+    {
+        goto done;
+    }
+
+    if (sOptions.mDump)
+    {
+        SessionLog::Reader  lReader;
+        SessionLog::Event   lEvent;
+        int                 lStatus;
+
+        lStatus = lReader.Open(sOptions.mPath);
+
+        if (lStatus != 0)
+        {
+            fprintf(stderr, "Could not open \"%s\": %s.\n", sOptions.mPath, strerror(-lStatus));
+            goto done;
+        }
+
+        while ((lStatus = lReader.Read(lEvent)) == 0)
+        {
+            Print(lEvent);
+        }
+
+        if ((lStatus != -ENOENT) && (lStatus != -EAGAIN))
+        {
+            fprintf(stderr, "Could not read \"%s\": %s.\n", sOptions.mPath, strerror(-lStatus));
+            goto done;
+        }
+    }
+    else
+    {
+        const SessionLog::Duration  lWindow(static_cast<SessionLog::Duration::rep>(sOptions.mWindowUs));
+        ListModel                   lModel(sOptions.mGroups, lWindow);
+        double                      lDecodeNs = 0.0;
+        double                      lModelNs = 0.0;
+
+        if (Replay((sOptions.mRecorded ? SessionReplayer::kPaceRecorded : SessionReplayer::kPaceFastest), lModel, lCounters) != 0)
+        {
+            goto done;
+        }
+
+        lModel.Finish();
+
+        {
+            const ListModel::Counters &           lList = lModel.GetCounters();
+            const RowReloadCoalescer::Counters &  lCoalescer = lModel.GetCoalescerCounters();
+
+            printf("sessions %llu, events %llu, skipped %llu\n",
+                   static_cast<unsigned long long>(lCounters.mSessions),
+                   static_cast<unsigned long long>(lCounters.mEvents),
+                   static_cast<unsigned long long>(lCounters.mSkipped));
+            printf("%s list: %llu state change(s) in %llu run loop turn(s), %llu refresh(es)\n",
+                   (sOptions.mGroups ? "group" : "zone"),
+                   static_cast<unsigned long long>(lList.mStateChanges),
+                   static_cast<unsigned long long>(lList.mTurns),
+                   static_cast<unsigned long long>(lList.mRefreshes));
+            printf("  each:      %llu row reload(s), %llu reload(s) of all rows\n",
+                   static_cast<unsigned long long>(lList.mUncoalescedReloads),
+                   static_cast<unsigned long long>(lList.mUncoalescedAllRows));
+            printf("  coalesced: %llu reload(s) of %llu row(s), %llu reload(s) of all rows\n",
+                   static_cast<unsigned long long>(lCoalescer.mReloads),
+                   static_cast<unsigned long long>(lCoalescer.mRows),
+                   static_cast<unsigned long long>(lCoalescer.mAllRows));
+        }
+
+        if (!sOptions.mRecorded)
+        {
+            if (!Time<SessionReplayer::Delegate>(lDecodeNs) ||
+                !Time<ListModel>(lModelNs, sOptions.mGroups, lWindow))
+            {
+                goto done;
+            }
+
+            printf("time: %.1f ns/event decoding alone, %.1f ns/event decoding into the list model\n",
+                   lDecodeNs, lModelNs);
+        }
+    }
+
+    lRetval = EXIT_SUCCESS;
+
+ done:
+    return (lRetval);
+}
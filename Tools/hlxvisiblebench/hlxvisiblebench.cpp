@@ -0,0 +1,480 @@
+/*
+ *    Copyright (c) 2026 Grant Erickson
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing,
+ *    software distributed under the License is distributed on an "AS
+ *    IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ *    express or implied.  See the License for the specific language
+ *    governing permissions and limitations under the License.
+ *
+ */
+
+
+/**
+ *  @file
+ *    This file implements a benchmark of how long the group and zone
+ *    list takes to fill in its visible rows during a refresh.
+ *
+ *    The benchmark simulates an HLX peer that answers queries one at
+ *    a time, in the order issued, each taking its bytes on the wire
+ *    at a configurable per-character delay. The library refresh
+ *    queries every group, and then every zone, one after another, as
+ *    the _openhlx_ library does. Alongside it, as the group and zone
+ *    list does, the refresh query scheduler may keep a window of
+ *    queries for the visible rows in flight, completing, rather than
+ *    querying, any the library refresh answers first.
+ *
+ *    For each, with and without the scheduler, it reports how long
+ *    until every visible row had arrived and how long until the
+ *    refresh was complete.
+ *
+ *    The benchmark depends on POSIX, the C++ Standard Library, and
+ *    the _openhlx_ headers. From the top of the package, with
+ *    OPENHLX_CFLAGS naming the same _openhlx_ header directories as
+ *    the Xcode project, it may be built on Linux or macOS with:
+ *
+ *      % c++ -std=c++11 -O2 -I Source ${OPENHLX_CFLAGS} -o hlxvisiblebench Tools/hlxvisiblebench/hlxvisiblebench.cpp Source/RefreshQueryScheduler.cpp
+ *
+ */
+
+#include <deque>
+#include <vector>
+
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "RefreshQueryScheduler.hpp"
+
+
+namespace
+{
+
+/**
+ *  The benchmark configuration, as established from the command
+ *  line.
+ *
+ */
+struct Options
+{
+    unsigned long                  mGroups;
+    unsigned long                  mZones;
+    RefreshQueryScheduler::Kind    mShown;
+    unsigned long                  mFirst;
+    unsigned long                  mLast;
+    unsigned long                  mWindow;
+    double                         mCharacterDelayMs;
+    unsigned long                  mQueryBytes;
+};
+
+/**
+ *  A simulated query: the group or zone it is for and whether the
+ *  library refresh, rather than the scheduler, issued it.
+ *
+ */
+struct Query
+{
+    RefreshQueryScheduler::Query   mQuery;
+    bool                           mFromRefresh;
+};
+
+/**
+ *  The outcome of a run.
+ *
+ */
+struct Result
+{
+    double         mVisible;
+    double         mComplete;
+    unsigned long  mQueries;
+};
+
+// HLX hardware has ten groups and twenty-four zones; a phone, in
+// portrait, shows about eight rows at once.
+
+const unsigned long  kDefaultGroups           = 10;
+const unsigned long  kDefaultZones            = 24;
+const unsigned long  kDefaultFirst            = 1;
+const unsigned long  kDefaultLast             = 8;
+const unsigned long  kDefaultWindow           = 4;
+
+// The default per-character delay approximates the observed
+// character-at-a-time output rate of real HLX hardware.
+
+const double         kDefaultCharacterDelayMs = 1.0;
+
+// A zone query, "[QO12]", is answered with a line for each zone
+// property, including, on installer builds, each equalizer band.
+
+const unsigned long  kDefaultQueryBytes       = 300;
+
+Options              sOptions;
+
+// MARK: Option Parsing
+
+void
+Usage(const char *aProgram, FILE *aStream)
+{
+    fprintf(aStream,
+            "Usage: %s [ options ]\n"
+            "\n"
+            "Benchmark how long the visible group or zone rows take to arrive\n"
+            "during a refresh, with and without the refresh query scheduler.\n"
+            "\n"
+            " -b, --query-bytes <count>   Bytes on the wire of a query (default: %lu).\n"
+            " -c, --character-delay <ms>  Delay per character on the wire\n"
+            "                             (default: %.3f ms).\n"
+            " -f, --first <row>           First visible row (default: %lu).\n"
+            " -g, --groups <count>        Number of groups (default: %lu).\n"
+            " -h, --help                  Print this help and exit.\n"
+            " -k, --shown <groups|zones>  Which the list shows (default: zones).\n"
+            " -l, --last <row>            Last visible row (default: %lu).\n"
+            " -w, --window <count>        Scheduler queries in flight at once\n"
+            "                             (default: %lu).\n"
+            " -z, --zones <count>         Number of zones (default: %lu).\n",
+            aProgram,
+            kDefaultQueryBytes,
+            kDefaultCharacterDelayMs,
+            kDefaultFirst,
+            kDefaultGroups,
+            kDefaultLast,
+            kDefaultWindow,
+            kDefaultZones);
+}
+
+bool
+ParseCount(const char *aString, const unsigned long &aMinimum, const unsigned long &aMaximum, unsigned long &aCount)
+{
+    char *  lEnd;
+    bool    lRetval;
+
+    aCount = strtoul(aString, &lEnd, 10);
+
+    lRetval = ((*aString != '\0') && (*lEnd == '\0') && (aCount >= aMinimum) && (aCount <= aMaximum));
+
+    return (lRetval);
+}
+
+bool
+ParseMilliseconds(const char *aString, double &aMilliseconds)
+{
+    char *  lEnd;
+    bool    lRetval;
+
+    aMilliseconds = strtod(aString, &lEnd);
+
+    lRetval = ((*aString != '\0') && (*lEnd == '\0') && (aMilliseconds >= 0));
+
+    return (lRetval);
+}
+
+bool
+ParseKind(const char *aString, RefreshQueryScheduler::Kind &aKind)
+{
+    bool  lRetval = true;
+
+    if (strcmp(aString, "groups") == 0)
+    {
+        aKind = RefreshQueryScheduler::kKindGroup;
+    }
+    else if (strcmp(aString, "zones") == 0)
+    {
+        aKind = RefreshQueryScheduler::kKindZone;
+    }
+    else
+    {
+        lRetval = false;
+    }
+
+    return (lRetval);
+}
+
+bool
+ParseOptions(int argc, char * const argv[])
+{
+    static const struct option sLongOptions[] =
+    {
+        { "query-bytes",     required_argument, nullptr, 'b' },
+        { "character-delay", required_argument, nullptr, 'c' },
+        { "first",           required_argument, nullptr, 'f' },
+        { "groups",          required_argument, nullptr, 'g' },
+        { "help",            no_argument,       nullptr, 'h' },
+        { "shown",           required_argument, nullptr, 'k' },
+        { "last",            required_argument, nullptr, 'l' },
+        { "window",          required_argument, nullptr, 'w' },
+        { "zones",           required_argument, nullptr, 'z' },
+        { nullptr,           0,                 nullptr, 0   }
+    };
+    int   lOption;
+    bool  lRetval = true;
+
+    sOptions.mGroups           = kDefaultGroups;
+    sOptions.mZones            = kDefaultZones;
+    sOptions.mShown            = RefreshQueryScheduler::kKindZone;
+    sOptions.mFirst            = kDefaultFirst;
+    sOptions.mLast             = kDefaultLast;
+    sOptions.mWindow           = kDefaultWindow;
+    sOptions.mCharacterDelayMs = kDefaultCharacterDelayMs;
+    sOptions.mQueryBytes       = kDefaultQueryBytes;
+
+    while (lRetval && ((lOption = getopt_long(argc, argv, "b:c:f:g:hk:l:w:z:", sLongOptions, nullptr)) != -1))
+    {
+        switch (lOption)
+        {
+
+        case 'b':
+            lRetval = ParseCount(optarg, 1, 100000, sOptions.mQueryBytes);
+            break;
+
+        case 'c':
+            lRetval = ParseMilliseconds(optarg, sOptions.mCharacterDelayMs);
+            break;
+
+        case 'f':
+            lRetval = ParseCount(optarg, 1, 255, sOptions.mFirst);
+            break;
+
+        case 'g':
+            lRetval = ParseCount(optarg, 1, 255, sOptions.mGroups);
+            break;
+
+        case 'h':
+            Usage(argv[0], stdout);
+            exit(EXIT_SUCCESS);
+            break;
+
+        case 'k':
+            lRetval = ParseKind(optarg, sOptions.mShown);
+            break;
+
+        case 'l':
+            lRetval = ParseCount(optarg, 1, 255, sOptions.mLast);
+            break;
+
+        case 'w':
+            lRetval = ParseCount(optarg, 1, 64, sOptions.mWindow);
+            break;
+
+        case 'z':
+            lRetval = ParseCount(optarg, 1, 255, sOptions.mZones);
+            break;
+
+        default:
+            lRetval = false;
+            break;
+
+        }
+    }
+
+    lRetval = (lRetval && (optind == argc));
+
+    if (lRetval)
+    {
+        const unsigned long lShownCount = ((sOptions.mShown == RefreshQueryScheduler::kKindGroup) ? sOptions.mGroups : sOptions.mZones);
+
+        lRetval = ((sOptions.mFirst <= sOptions.mLast) && (sOptions.mLast <= lShownCount));
+    }
+
+    if (!lRetval)
+    {
+        Usage(argv[0], stderr);
+    }
+
+    return (lRetval);
+}
+
+// MARK: Simulation
+
+// Return the library refresh query at the specified position: every
+// group, in order, and then every zone.
+
+RefreshQueryScheduler::Query
+GetRefreshQuery(const unsigned long &aPosition)
+{
+    RefreshQueryScheduler::Query lRetval;
+
+    if (aPosition < sOptions.mGroups)
+    {
+        lRetval.mKind       = RefreshQueryScheduler::kKindGroup;
+        lRetval.mIdentifier = static_cast<RefreshQueryScheduler::IdentifierType>(aPosition + 1);
+    }
+    else
+    {
+        lRetval.mKind       = RefreshQueryScheduler::kKindZone;
+        lRetval.mIdentifier = static_cast<RefreshQueryScheduler::IdentifierType>(aPosition - sOptions.mGroups + 1);
+    }
+
+    return (lRetval);
+}
+
+// Simulate the peer answering the library refresh, one query at a
+// time, and, where the scheduler is in use, the scheduler's window of
+// queries, first-in, first-out, until the library refresh is
+// complete.
+
+bool
+Run(const bool &aUseScheduler, Result &aResult)
+{
+    const double                     lQueryMs = (sOptions.mQueryBytes * sOptions.mCharacterDelayMs);
+    const unsigned long              lTotal   = (sOptions.mGroups + sOptions.mZones);
+    const unsigned long              lVisible = (sOptions.mLast - sOptions.mFirst + 1);
+    RefreshQueryScheduler            lScheduler;
+    std::vector<bool>                lArrived[RefreshQueryScheduler::kKindMax];
+    std::deque<Query>                lPeer;
+    double                           lNow = 0;
+    unsigned long                    lRefreshNext = 0;
+    unsigned long                    lVisibleArrived = 0;
+    size_t                           lInFlight = 0;
+    bool                             lRefreshWaiting = false;
+    HLX::Common::Status              lStatus;
+    bool                             lRetval = true;
+
+    lArrived[RefreshQueryScheduler::kKindGroup].resize(sOptions.mGroups + 1, false);
+    lArrived[RefreshQueryScheduler::kKindZone].resize(sOptions.mZones + 1, false);
+
+    aResult.mVisible  = 0;
+    aResult.mQueries  = 0;
+
+    if (aUseScheduler)
+    {
+        lStatus = lScheduler.Init(static_cast<RefreshQueryScheduler::IdentifierType>(sOptions.mGroups),
+                                  static_cast<RefreshQueryScheduler::IdentifierType>(sOptions.mZones));
+        lRetval = (lRetval && (lStatus == HLX::Common::kStatus_Success));
+
+        lStatus = lScheduler.SetShown(sOptions.mShown);
+        lRetval = (lRetval && (lStatus == HLX::Common::kStatus_Success));
+
+        lStatus = lScheduler.SetVisible(sOptions.mShown,
+                                        static_cast<RefreshQueryScheduler::IdentifierType>(sOptions.mFirst),
+                                        static_cast<RefreshQueryScheduler::IdentifierType>(sOptions.mLast));
+        lRetval = (lRetval && (lStatus == HLX::Common::kStatus_Success));
+    }
+
+    while (lRetval && (lRefreshNext < lTotal))
+    {
+        RefreshQueryScheduler::Query  lQuery;
+        Query                         lAnswered;
+
+        // The library refresh keeps one query of its own in flight.
+
+        if (!lRefreshWaiting)
+        {
+            const Query lIssued = { GetRefreshQuery(lRefreshNext), true };
+
+            lPeer.push_back(lIssued);
+
+            lRefreshWaiting = true;
+        }
+
+        // Fill the scheduler's window, completing, rather than
+        // issuing, the queries for rows that have already arrived.
+
+        while (aUseScheduler && (lInFlight < sOptions.mWindow) && (lScheduler.Pop(RefreshQueryScheduler::kPriorityVisible, lQuery) == HLX::Common::kStatus_Success))
+        {
+            if (lArrived[lQuery.mKind][lQuery.mIdentifier])
+            {
+                lScheduler.Complete(lQuery.mKind, lQuery.mIdentifier);
+            }
+            else
+            {
+                const Query lIssued = { lQuery, false };
+
+                lPeer.push_back(lIssued);
+
+                lInFlight++;
+            }
+        }
+
+        // Advance to the next answer.
+
+        lAnswered = lPeer.front();
+        lPeer.pop_front();
+
+        lNow += lQueryMs;
+
+        aResult.mQueries++;
+
+        if (!lArrived[lAnswered.mQuery.mKind][lAnswered.mQuery.mIdentifier])
+        {
+            lArrived[lAnswered.mQuery.mKind][lAnswered.mQuery.mIdentifier] = true;
+
+            if ((lAnswered.mQuery.mKind == sOptions.mShown) &&
+                (lAnswered.mQuery.mIdentifier >= sOptions.mFirst) &&
+                (lAnswered.mQuery.mIdentifier <= sOptions.mLast))
+            {
+                lVisibleArrived++;
+
+                if (lVisibleArrived == lVisible)
+                {
+                    aResult.mVisible = lNow;
+                }
+            }
+        }
+
+        if (aUseScheduler)
+        {
+            lScheduler.Complete(lAnswered.mQuery.mKind, lAnswered.mQuery.mIdentifier);
+        }
+
+        if (lAnswered.mFromRefresh)
+        {
+            lRefreshWaiting = false;
+            lRefreshNext++;
+        }
+        else
+        {
+            lInFlight--;
+        }
+    }
+
+    aResult.mComplete = lNow;
+
+    return (lRetval);
+}
+
+void
+Print(const char *aName, const Result &aResult)
+{
+    printf("  %-10s %12.1f %12.1f %9lu\n",
+           aName,
+           aResult.mVisible,
+           aResult.mComplete,
+           aResult.mQueries);
+}
+
+}; // namespace
+
+int
+main(int argc, char * const argv[])
+{
+    Result  lRefresh;
+    Result  lScheduled;
+    int     lRetval = EXIT_FAILURE;
+
+    if (ParseOptions(argc, argv) && Run(false, lRefresh) && Run(true, lScheduled))
+    {
+        printf("%s %lu-%lu visible of %lu groups and %lu zones, window %lu:\n",
+               ((sOptions.mShown == RefreshQueryScheduler::kKindGroup) ? "groups" : "zones"),
+               sOptions.mFirst,
+               sOptions.mLast,
+               sOptions.mGroups,
+               sOptions.mZones,
+               sOptions.mWindow);
+        printf("  %-10s %12s %12s %9s\n", "", "visible ms", "complete ms", "queries");
+
+        Print("refresh", lRefresh);
+        Print("scheduled", lScheduled);
+
+        lRetval = EXIT_SUCCESS;
+    }
+
+    return (lRetval);
+}